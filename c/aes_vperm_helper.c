@@ -0,0 +1,140 @@
+/* $Id$ */
+/*
+ * AES round with SSSE3 only (no AES-NI, no tables). This code is meant
+ * to be included by the implementations of AES-based hash functions,
+ * for their vector code paths; it provides functions with the same
+ * semantics as the AES-NI intrinsics, which are selected at runtime
+ * when the processor has SSSE3 but not AES-NI (e.g. virtual machines
+ * which mask AES-NI).
+ *
+ * The S-box uses the vector-permute decomposition of M. Hamburg
+ * ("Accelerating AES with Vector Permute Instructions", CHES 2009):
+ * a byte is mapped, through a linear change of basis computed with
+ * one 16-entry lookup per nibble, to a representation over GF(2^4)
+ * where the inversion takes five nibble lookups; the output basis
+ * change, together with the S-box affine map, is again two nibble
+ * lookups. All lookups are pshufb on constant registers, so the code
+ * is constant-time and uses no memory tables. Since the output
+ * lookups are linear, a second pair of tables yields twice the S-box
+ * output at the same cost, which gives MixColumns with byte shuffles
+ * and XORs only.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+
+#include <immintrin.h>
+
+#define VP_C(hi, lo)   _mm_set_epi64x( \
+		(long long)SPH_C64(hi), (long long)SPH_C64(lo))
+
+/*
+ * Input basis change (low and high nibble), inversion tables (1/x and
+ * a/x in the tower field; entry 0 is 0x80 so that the next lookup
+ * yields 0), and output tables for S(x) + 0x63 and 2 * (S(x) + 0x63).
+ */
+#define VP_IPT_LO   VP_C(0xCABAE09052227808, 0xC2B2E8985A2A7000)
+#define VP_IPT_HI   VP_C(0xCD80B1FCB0FDCC81, 0x4C01307D317C4D00)
+#define VP_INV      VP_C(0x040703090A0B0C02, 0x0E05060F0D080180)
+#define VP_INVA     VP_C(0x030D0E0C02050809, 0x01040A060F0B0780)
+#define VP_SBOU     VP_C(0x15AABF7AC502A878, 0xD0D26D176FBDC700)
+#define VP_SBOT     VP_C(0x8E1E90D1412B35FA, 0xCFE474A55FBB6A00)
+#define VP_SB2U     VP_C(0x2A4F65F491044BF0, 0xBBBFDA2EDE619500)
+#define VP_SB2T     VP_C(0x073C3BB982566AEF, 0x85D3E851BE6DD400)
+
+/*
+ * Compute S(x) + 0x63 on all bytes of x; if x2 is not NULL, then
+ * *x2 receives twice that value (in GF(2^8)).
+ */
+SPH_TARGET("ssse3") static inline __m128i
+aes_vperm_sub(__m128i x, __m128i *x2)
+{
+	__m128i m, i, k, j, ak, iak, jak, io, jo;
+
+	m = _mm_set1_epi8(0x0F);
+	i = _mm_and_si128(_mm_srli_epi16(x, 4), m);
+	k = _mm_and_si128(x, m);
+	x = _mm_xor_si128(_mm_shuffle_epi8(VP_IPT_LO, k),
+		_mm_shuffle_epi8(VP_IPT_HI, i));
+	i = _mm_and_si128(_mm_srli_epi16(x, 4), m);
+	k = _mm_and_si128(x, m);
+	ak = _mm_shuffle_epi8(VP_INVA, k);
+	j = _mm_xor_si128(i, k);
+	iak = _mm_xor_si128(_mm_shuffle_epi8(VP_INV, i), ak);
+	jak = _mm_xor_si128(_mm_shuffle_epi8(VP_INV, j), ak);
+	io = _mm_xor_si128(_mm_shuffle_epi8(VP_INV, iak), j);
+	jo = _mm_xor_si128(_mm_shuffle_epi8(VP_INV, jak), i);
+	if (x2 != 0)
+		*x2 = _mm_xor_si128(_mm_shuffle_epi8(VP_SB2U, io),
+			_mm_shuffle_epi8(VP_SB2T, jo));
+	return _mm_xor_si128(_mm_shuffle_epi8(VP_SBOU, io),
+		_mm_shuffle_epi8(VP_SBOT, jo));
+}
+
+/*
+ * SubBytes alone (no ShiftRows).
+ */
+SPH_TARGET("ssse3") static inline __m128i
+aes_vperm_subbytes(__m128i x)
+{
+	return _mm_xor_si128(aes_vperm_sub(x, 0), _mm_set1_epi8(0x63));
+}
+
+/*
+ * Same as _mm_aesenc_si128(): SubBytes, ShiftRows, MixColumns, then
+ * XOR with the round key. ShiftRows is merged into the four byte
+ * shuffles which compute MixColumns; the 0x63 constant goes through
+ * MixColumns unchanged and is added with the key.
+ */
+SPH_TARGET("ssse3") static inline __m128i
+aes_vperm_enc(__m128i x, __m128i key)
+{
+	__m128i s, d;
+
+	s = aes_vperm_sub(x, &d);
+	return _mm_xor_si128(
+		_mm_xor_si128(
+			_mm_shuffle_epi8(d, _mm_setr_epi8(
+				0, 5, 10, 15, 4, 9, 14, 3,
+				8, 13, 2, 7, 12, 1, 6, 11)),
+			_mm_shuffle_epi8(_mm_xor_si128(d, s), _mm_setr_epi8(
+				5, 10, 15, 0, 9, 14, 3, 4,
+				13, 2, 7, 8, 1, 6, 11, 12))),
+		_mm_xor_si128(
+			_mm_xor_si128(
+				_mm_shuffle_epi8(s, _mm_setr_epi8(
+					10, 15, 0, 5, 14, 3, 4, 9,
+					2, 7, 8, 13, 6, 11, 12, 1)),
+				_mm_shuffle_epi8(s, _mm_setr_epi8(
+					15, 0, 5, 10, 3, 4, 9, 14,
+					7, 8, 13, 2, 11, 12, 1, 6))),
+			_mm_xor_si128(key, _mm_set1_epi8(0x63))));
+}
+
+#endif
@@ -0,0 +1,272 @@
+/* $Id$ */
+/*
+ * Batched hashing of independent messages.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sph_batch.h"
+
+#if SPH_64
+
+#include "sph_blake.h"
+#include "sph_bmw.h"
+#include "sph_cubehash.h"
+#include "sph_echo.h"
+#include "sph_fugue.h"
+#include "sph_gost.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_haval.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_luffa.h"
+#include "sph_md2.h"
+#include "sph_md4.h"
+#include "sph_md5.h"
+#include "sph_panama.h"
+#include "sph_radiogatun.h"
+#include "sph_ripemd.h"
+#include "sph_sha0.h"
+#include "sph_sha1.h"
+#include "sph_sha2.h"
+#include "sph_shabal.h"
+#include "sph_shavite.h"
+#include "sph_simd.h"
+#include "sph_skein.h"
+#include "sph_tiger.h"
+#include "sph_whirlpool.h"
+
+/*
+ * Maximum number of messages which are reordered at once; the working
+ * arrays then use about 7 kB of stack on 64-bit systems. Groups of
+ * similar lengths are formed within each such slice only.
+ */
+#define HASH_BATCH   256
+
+typedef void (*batch_multi_fun)(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+#define BATCH_ALG(name, size, multi)   { \
+		&sph_ ## name ## _oneshot, multi, size \
+	}
+
+/*
+ * Implementations, indexed by SPH_HASH_* identifier. Algorithms
+ * without a multi-message function are processed one message at a
+ * time.
+ */
+static const struct {
+	void (*oneshot)(const void *data, size_t len, void *dst);
+	batch_multi_fun multi;
+	size_t size;
+} hash_algs[SPH_HASH_NUM] = {
+	BATCH_ALG(md2, 16, 0),
+	BATCH_ALG(md4, 16, 0),
+	BATCH_ALG(md5, 16, &sph_md5_multi),
+	BATCH_ALG(panama, 32, 0),
+	BATCH_ALG(radiogatun32, 32, 0),
+	BATCH_ALG(radiogatun64, 32, 0),
+	BATCH_ALG(ripemd, 16, 0),
+	BATCH_ALG(ripemd128, 16, 0),
+	BATCH_ALG(ripemd160, 20, &sph_ripemd160_multi),
+	BATCH_ALG(sha0, 20, 0),
+	BATCH_ALG(sha1, 20, &sph_sha1_multi),
+	BATCH_ALG(sha224, 28, &sph_sha224_multi),
+	BATCH_ALG(sha256, 32, &sph_sha256_multi),
+	BATCH_ALG(sha384, 48, &sph_sha384_multi),
+	BATCH_ALG(sha512, 64, &sph_sha512_multi),
+	BATCH_ALG(tiger, 24, 0),
+	BATCH_ALG(tiger2, 24, 0),
+	BATCH_ALG(whirlpool, 64, &sph_whirlpool_multi),
+	BATCH_ALG(whirlpool0, 64, &sph_whirlpool0_multi),
+	BATCH_ALG(whirlpool1, 64, &sph_whirlpool1_multi),
+	BATCH_ALG(gost, 32, 0),
+	BATCH_ALG(gost256, 32, 0),
+	BATCH_ALG(gost512, 64, 0),
+	BATCH_ALG(haval128_3, 16, 0),
+	BATCH_ALG(haval128_4, 16, 0),
+	BATCH_ALG(haval128_5, 16, 0),
+	BATCH_ALG(haval160_3, 20, 0),
+	BATCH_ALG(haval160_4, 20, 0),
+	BATCH_ALG(haval160_5, 20, 0),
+	BATCH_ALG(haval192_3, 24, 0),
+	BATCH_ALG(haval192_4, 24, 0),
+	BATCH_ALG(haval192_5, 24, 0),
+	BATCH_ALG(haval224_3, 28, 0),
+	BATCH_ALG(haval224_4, 28, 0),
+	BATCH_ALG(haval224_5, 28, 0),
+	BATCH_ALG(haval256_3, 32, 0),
+	BATCH_ALG(haval256_4, 32, 0),
+	BATCH_ALG(haval256_5, 32, 0),
+	BATCH_ALG(blake224, 28, 0),
+	BATCH_ALG(blake256, 32, 0),
+	BATCH_ALG(blake384, 48, 0),
+	BATCH_ALG(blake512, 64, 0),
+	BATCH_ALG(bmw224, 28, &sph_bmw224_multi),
+	BATCH_ALG(bmw256, 32, &sph_bmw256_multi),
+	BATCH_ALG(bmw384, 48, &sph_bmw384_multi),
+	BATCH_ALG(bmw512, 64, &sph_bmw512_multi),
+	BATCH_ALG(cubehash224, 28, &sph_cubehash224_multi),
+	BATCH_ALG(cubehash256, 32, &sph_cubehash256_multi),
+	BATCH_ALG(cubehash384, 48, &sph_cubehash384_multi),
+	BATCH_ALG(cubehash512, 64, &sph_cubehash512_multi),
+	BATCH_ALG(echo224, 28, 0),
+	BATCH_ALG(echo256, 32, 0),
+	BATCH_ALG(echo384, 48, &sph_echo384_multi),
+	BATCH_ALG(echo512, 64, &sph_echo512_multi),
+	BATCH_ALG(fugue224, 28, 0),
+	BATCH_ALG(fugue256, 32, 0),
+	BATCH_ALG(fugue384, 48, 0),
+	BATCH_ALG(fugue512, 64, 0),
+	BATCH_ALG(groestl224, 28, 0),
+	BATCH_ALG(groestl256, 32, 0),
+	BATCH_ALG(groestl384, 48, &sph_groestl384_multi),
+	BATCH_ALG(groestl512, 64, &sph_groestl512_multi),
+	BATCH_ALG(hamsi224, 28, &sph_hamsi224_multi),
+	BATCH_ALG(hamsi256, 32, &sph_hamsi256_multi),
+	BATCH_ALG(hamsi384, 48, &sph_hamsi384_multi),
+	BATCH_ALG(hamsi512, 64, &sph_hamsi512_multi),
+	BATCH_ALG(jh224, 28, 0),
+	BATCH_ALG(jh256, 32, 0),
+	BATCH_ALG(jh384, 48, 0),
+	BATCH_ALG(jh512, 64, 0),
+	BATCH_ALG(keccak224, 28, 0),
+	BATCH_ALG(keccak256, 32, 0),
+	BATCH_ALG(keccak384, 48, 0),
+	BATCH_ALG(keccak512, 64, 0),
+	BATCH_ALG(luffa224, 28, &sph_luffa224_multi),
+	BATCH_ALG(luffa256, 32, &sph_luffa256_multi),
+	BATCH_ALG(luffa384, 48, &sph_luffa384_multi),
+	BATCH_ALG(luffa512, 64, &sph_luffa512_multi),
+	BATCH_ALG(shabal192, 24, &sph_shabal192_multi),
+	BATCH_ALG(shabal224, 28, &sph_shabal224_multi),
+	BATCH_ALG(shabal256, 32, &sph_shabal256_multi),
+	BATCH_ALG(shabal384, 48, &sph_shabal384_multi),
+	BATCH_ALG(shabal512, 64, &sph_shabal512_multi),
+	BATCH_ALG(shavite224, 28, 0),
+	BATCH_ALG(shavite256, 32, 0),
+	BATCH_ALG(shavite384, 48, &sph_shavite384_multi),
+	BATCH_ALG(shavite512, 64, &sph_shavite512_multi),
+	BATCH_ALG(simd224, 28, 0),
+	BATCH_ALG(simd256, 32, 0),
+	BATCH_ALG(simd384, 48, 0),
+	BATCH_ALG(simd512, 64, 0),
+	BATCH_ALG(skein224, 28, 0),
+	BATCH_ALG(skein256, 32, 0),
+	BATCH_ALG(skein384, 48, 0),
+	BATCH_ALG(skein512, 64, 0)
+};
+
+/* see sph_batch.h */
+size_t
+sph_hash_size(unsigned alg)
+{
+	if (alg >= SPH_HASH_NUM)
+		return 0;
+	return hash_algs[alg].size;
+}
+
+/*
+ * Number of length classes for the reordering. Messages are classified
+ * by their number of full 64-byte blocks; longer messages all go into
+ * the last class, where the length differences matter less.
+ */
+#define HASH_CLASSES   64
+
+/*
+ * Hand up to HASH_BATCH messages over to a multi-message function,
+ * sorted by length class (counting sort, stable), so that consecutive
+ * lanes run for the same number of blocks. A comparison sort costs more
+ * than what it saves on short messages.
+ */
+static void
+batch_sorted(batch_multi_fun multi, const void *const *data,
+	const size_t *len, void *const *dst, size_t num)
+{
+	const void *in[HASH_BATCH];
+	void *out[HASH_BATCH];
+	size_t ilen[HASH_BATCH];
+	size_t start[HASH_CLASSES + 1];
+	unsigned char cl[HASH_BATCH];
+	size_t u;
+	unsigned c;
+
+	memset(start, 0, sizeof start);
+	for (u = 0; u < num; u ++) {
+		size_t k;
+
+		k = len[u] >> 6;
+		c = k < HASH_CLASSES ? (unsigned)k : HASH_CLASSES - 1;
+		cl[u] = (unsigned char)c;
+		start[c + 1] ++;
+	}
+	if (start[cl[0] + 1] == num) {
+		multi(data, len, dst, num);
+		return;
+	}
+	for (c = 0; c < HASH_CLASSES; c ++)
+		start[c + 1] += start[c];
+	for (u = 0; u < num; u ++) {
+		size_t j;
+
+		j = start[cl[u]] ++;
+		in[j] = data[u];
+		ilen[j] = len[u];
+		out[j] = dst[u];
+	}
+	multi(in, ilen, out, num);
+}
+
+/* see sph_batch.h */
+void
+sph_hash_batch(unsigned alg, const void *const *data,
+	const size_t *len, void *const *dst, size_t num)
+{
+	size_t u;
+
+	if (alg >= SPH_HASH_NUM)
+		return;
+	if (hash_algs[alg].multi == 0) {
+		for (u = 0; u < num; u ++)
+			hash_algs[alg].oneshot(data[u], len[u], dst[u]);
+		return;
+	}
+	for (u = 0; u < num; u += HASH_BATCH) {
+		size_t n;
+
+		n = num - u;
+		if (n > HASH_BATCH)
+			n = HASH_BATCH;
+		batch_sorted(hash_algs[alg].multi,
+			data + u, len + u, dst + u, n);
+	}
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include <limits.h>
 
 #include "sph_blake.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_BLAKE
 #define SPH_SMALL_FOOTPRINT_BLAKE   1
@@ -796,14 +797,13 @@ blake32_init(sph_blake_small_context *sc,
 static void
 blake32(sph_blake_small_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE32
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -816,7 +816,12 @@ blake32(sph_blake_small_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
@@ -824,6 +829,7 @@ blake32(sph_blake_small_context *sc, const void *data, size_t len)
 			if ((T0 = SPH_T32(T0 + 512)) < 512)
 				T1 = SPH_T32(T1 + 1);
 			COMPRESS32;
+			SPH_STATS_BLOCKS(SPH_STATS_BLAKE, 1);
 			ptr = 0;
 		}
 	}
@@ -884,6 +890,65 @@ blake32_close(sph_blake_small_context *sc,
 		sph_enc32be(out + (k << 2), sc->H[k]);
 }
 
+/*
+ * Hash a complete message. If it fits in one block along with its
+ * padding (at most 55 bytes), that block is built on the stack and
+ * compressed directly, without a context.
+ */
+static void
+blake32_oneshot(const sph_u32 *iv,
+	const void *data, size_t len, void *dst, size_t out_size_w32)
+{
+	union {
+		unsigned char buf[64];
+		sph_u32 dummy;
+	} u;
+	const unsigned char *buf;
+	unsigned char *out;
+	DECL_STATE32
+
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
+	if (len > 55) {
+		sph_blake_small_context sc;
+
+		blake32_init(&sc, iv, salt_zero_small);
+		blake32(&sc, data, len);
+		blake32_close(&sc, 0, 0, dst, out_size_w32);
+		return;
+	}
+	memcpy(u.buf, data, len);
+	u.buf[len] = 0x80;
+	memset(u.buf + len + 1, 0, 55 - len);
+	if (out_size_w32 == 8)
+		u.buf[55] |= 1;
+	sph_enc32be_aligned(u.buf + 56, 0);
+	sph_enc32be_aligned(u.buf + 60, (sph_u32)len << 3);
+	H0 = iv[0];
+	H1 = iv[1];
+	H2 = iv[2];
+	H3 = iv[3];
+	H4 = iv[4];
+	H5 = iv[5];
+	H6 = iv[6];
+	H7 = iv[7];
+	S0 = S1 = S2 = S3 = 0;
+	T0 = (sph_u32)len << 3;
+	T1 = 0;
+	buf = u.buf;
+	COMPRESS32;
+	SPH_STATS_BLOCKS(SPH_STATS_BLAKE, 1);
+	out = dst;
+	sph_enc32be(out +  0, H0);
+	sph_enc32be(out +  4, H1);
+	sph_enc32be(out +  8, H2);
+	sph_enc32be(out + 12, H3);
+	sph_enc32be(out + 16, H4);
+	sph_enc32be(out + 20, H5);
+	sph_enc32be(out + 24, H6);
+	if (out_size_w32 == 8)
+		sph_enc32be(out + 28, H7);
+}
+
 #if SPH_64
 
 static const sph_u64 salt_zero_big[4] = { 0, 0, 0, 0 };
@@ -901,14 +966,13 @@ blake64_init(sph_blake_big_context *sc,
 static void
 blake64(sph_blake_big_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE64
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -921,7 +985,12 @@ blake64(sph_blake_big_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
@@ -929,6 +998,7 @@ blake64(sph_blake_big_context *sc, const void *data, size_t len)
 			if ((T0 = SPH_T64(T0 + 1024)) < 1024)
 				T1 = SPH_T64(T1 + 1);
 			COMPRESS64;
+			SPH_STATS_BLOCKS(SPH_STATS_BLAKE, 1);
 			ptr = 0;
 		}
 	}
@@ -989,6 +1059,65 @@ blake64_close(sph_blake_big_context *sc,
 		sph_enc64be(out + (k << 3), sc->H[k]);
 }
 
+/*
+ * Hash a complete message; as blake32_oneshot(), with a single
+ * compression for messages of at most 111 bytes.
+ */
+static void
+blake64_oneshot(const sph_u64 *iv,
+	const void *data, size_t len, void *dst, size_t out_size_w64)
+{
+	union {
+		unsigned char buf[128];
+		sph_u64 dummy;
+	} u;
+	const unsigned char *buf;
+	unsigned char *out;
+	DECL_STATE64
+
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
+	if (len > 111) {
+		sph_blake_big_context sc;
+
+		blake64_init(&sc, iv, salt_zero_big);
+		blake64(&sc, data, len);
+		blake64_close(&sc, 0, 0, dst, out_size_w64);
+		return;
+	}
+	memcpy(u.buf, data, len);
+	u.buf[len] = 0x80;
+	memset(u.buf + len + 1, 0, 111 - len);
+	if (out_size_w64 == 8)
+		u.buf[111] |= 1;
+	sph_enc64be_aligned(u.buf + 112, 0);
+	sph_enc64be_aligned(u.buf + 120, (sph_u64)len << 3);
+	H0 = iv[0];
+	H1 = iv[1];
+	H2 = iv[2];
+	H3 = iv[3];
+	H4 = iv[4];
+	H5 = iv[5];
+	H6 = iv[6];
+	H7 = iv[7];
+	S0 = S1 = S2 = S3 = 0;
+	T0 = (sph_u64)len << 3;
+	T1 = 0;
+	buf = u.buf;
+	COMPRESS64;
+	SPH_STATS_BLOCKS(SPH_STATS_BLAKE, 1);
+	out = dst;
+	sph_enc64be(out +  0, H0);
+	sph_enc64be(out +  8, H1);
+	sph_enc64be(out + 16, H2);
+	sph_enc64be(out + 24, H3);
+	sph_enc64be(out + 32, H4);
+	sph_enc64be(out + 40, H5);
+	if (out_size_w64 == 8) {
+		sph_enc64be(out + 48, H6);
+		sph_enc64be(out + 56, H7);
+	}
+}
+
 #endif
 
 /* see sph_blake.h */
@@ -1002,9 +1131,17 @@ sph_blake224_init(void *cc)
 void
 sph_blake224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
 	blake32(cc, data, len);
 }
 
+/* see sph_blake.h */
+void
+sph_blake224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_blake224, cc, iov, n);
+}
+
 /* see sph_blake.h */
 void
 sph_blake224_close(void *cc, void *dst)
@@ -1020,6 +1157,13 @@ sph_blake224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_blake224_init(cc);
 }
 
+/* see sph_blake.h */
+void
+sph_blake224_oneshot(const void *data, size_t len, void *dst)
+{
+	blake32_oneshot(IV224, data, len, dst, 7);
+}
+
 /* see sph_blake.h */
 void
 sph_blake256_init(void *cc)
@@ -1031,9 +1175,17 @@ sph_blake256_init(void *cc)
 void
 sph_blake256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
 	blake32(cc, data, len);
 }
 
+/* see sph_blake.h */
+void
+sph_blake256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_blake256, cc, iov, n);
+}
+
 /* see sph_blake.h */
 void
 sph_blake256_close(void *cc, void *dst)
@@ -1049,6 +1201,13 @@ sph_blake256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_blake256_init(cc);
 }
 
+/* see sph_blake.h */
+void
+sph_blake256_oneshot(const void *data, size_t len, void *dst)
+{
+	blake32_oneshot(IV256, data, len, dst, 8);
+}
+
 #if SPH_64
 
 /* see sph_blake.h */
@@ -1062,9 +1221,17 @@ sph_blake384_init(void *cc)
 void
 sph_blake384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
 	blake64(cc, data, len);
 }
 
+/* see sph_blake.h */
+void
+sph_blake384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_blake384, cc, iov, n);
+}
+
 /* see sph_blake.h */
 void
 sph_blake384_close(void *cc, void *dst)
@@ -1080,6 +1247,13 @@ sph_blake384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_blake384_init(cc);
 }
 
+/* see sph_blake.h */
+void
+sph_blake384_oneshot(const void *data, size_t len, void *dst)
+{
+	blake64_oneshot(IV384, data, len, dst, 6);
+}
+
 /* see sph_blake.h */
 void
 sph_blake512_init(void *cc)
@@ -1091,9 +1265,17 @@ sph_blake512_init(void *cc)
 void
 sph_blake512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BLAKE, len);
 	blake64(cc, data, len);
 }
 
+/* see sph_blake.h */
+void
+sph_blake512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_blake512, cc, iov, n);
+}
+
 /* see sph_blake.h */
 void
 sph_blake512_close(void *cc, void *dst)
@@ -1109,4 +1291,11 @@ sph_blake512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_blake512_init(cc);
 }
 
+/* see sph_blake.h */
+void
+sph_blake512_oneshot(const void *data, size_t len, void *dst)
+{
+	blake64_oneshot(IV512, data, len, dst, 8);
+}
+
 #endif
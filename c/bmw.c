@@ -35,6 +35,8 @@
 #include <limits.h>
 
 #include "sph_bmw.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_BMW
 #define SPH_SMALL_FOOTPRINT_BMW   1
@@ -623,7 +625,7 @@ bmw32_init(sph_bmw_small_context *sc, const sph_u32 *iv)
 static void
 bmw32(sph_bmw_small_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	sph_u32 htmp[16];
 	sph_u32 *h1, *h2;
@@ -640,7 +642,6 @@ bmw32(sph_bmw_small_context *sc, const void *data, size_t len)
 		sc->bit_count_high ++;
 	sc->bit_count_high += len >> 29;
 #endif
-	buf = sc->buf;
 	ptr = sc->ptr;
 	h1 = sc->H;
 	h2 = htmp;
@@ -650,7 +651,12 @@ bmw32(sph_bmw_small_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		ptr += clen;
@@ -658,6 +664,7 @@ bmw32(sph_bmw_small_context *sc, const void *data, size_t len)
 			sph_u32 *ht;
 
 			compress_small(buf, h1, h2);
+			SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 			ht = h1;
 			h1 = h2;
 			h2 = ht;
@@ -686,6 +693,7 @@ bmw32_close(sph_bmw_small_context *sc, unsigned ub, unsigned n,
 	if (ptr > (sizeof sc->buf) - 8) {
 		memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 		compress_small(buf, h, h1);
+		SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 		ptr = 0;
 		h = h1;
 	}
@@ -700,9 +708,11 @@ bmw32_close(sph_bmw_small_context *sc, unsigned ub, unsigned n,
 		SPH_T32(sc->bit_count_high));
 #endif
 	compress_small(buf, h, h2);
+	SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 	for (u = 0; u < 16; u ++)
 		sph_enc32le_aligned(buf + 4 * u, h2[u]);
 	compress_small(buf, final_s, h1);
+	SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 	out = dst;
 	for (u = 0, v = 16 - out_size_w32; u < out_size_w32; u ++, v ++)
 		sph_enc32le(out + 4 * u, h1[v]);
@@ -769,13 +779,12 @@ bmw64_init(sph_bmw_big_context *sc, const sph_u64 *iv)
 static void
 bmw64(sph_bmw_big_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	sph_u64 htmp[16];
 	sph_u64 *h1, *h2;
 
 	sc->bit_count += (sph_u64)len << 3;
-	buf = sc->buf;
 	ptr = sc->ptr;
 	h1 = sc->H;
 	h2 = htmp;
@@ -785,7 +794,12 @@ bmw64(sph_bmw_big_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		ptr += clen;
@@ -793,6 +807,7 @@ bmw64(sph_bmw_big_context *sc, const void *data, size_t len)
 			sph_u64 *ht;
 
 			compress_big(buf, h1, h2);
+			SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 			ht = h1;
 			h1 = h2;
 			h2 = ht;
@@ -821,6 +836,7 @@ bmw64_close(sph_bmw_big_context *sc, unsigned ub, unsigned n,
 	if (ptr > (sizeof sc->buf) - 8) {
 		memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 		compress_big(buf, h, h1);
+		SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 		ptr = 0;
 		h = h1;
 	}
@@ -828,9 +844,11 @@ bmw64_close(sph_bmw_big_context *sc, unsigned ub, unsigned n,
 	sph_enc64le_aligned(buf + (sizeof sc->buf) - 8,
 		SPH_T64(sc->bit_count + n));
 	compress_big(buf, h, h2);
+	SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 	for (u = 0; u < 16; u ++)
 		sph_enc64le_aligned(buf + 8 * u, h2[u]);
 	compress_big(buf, final_b, h1);
+	SPH_STATS_BLOCKS(SPH_STATS_BMW, 1);
 	out = dst;
 	for (u = 0, v = 16 - out_size_w64; u < out_size_w64; u ++, v ++)
 		sph_enc64le(out + 8 * u, h1[v]);
@@ -838,6 +856,394 @@ bmw64_close(sph_bmw_big_context *sc, unsigned ub, unsigned n,
 
 #endif
 
+/*
+ * Multi-lane BMW: several independent messages are hashed in parallel,
+ * one per vector lane. The FOLD macro only applies C operators to its
+ * operands, so with the GCC vector extensions it operates on vectors
+ * of lanes unchanged. The first half of the expansion is rewritten
+ * here because its SPH_SMALL_FOOTPRINT_BMW variant uses a scalar
+ * temporary array.
+ *
+ * A "run" function loads the lane states from hs[], processes nb
+ * blocks per lane (block i of lane l is at p[l] + i * block_size),
+ * optionally applies the final compression, and stores back the
+ * states. The generic driver takes care of grouping messages, building
+ * the padding blocks and completing ragged lanes with the scalar code.
+ */
+
+#if SPH_X86_SIMD
+
+#define MAKE_Qva(sf0, sf1, sf2, sf3, sf4, wf)   do { \
+		qt[ 0] = sf0(wf ## 0 ) + H( 1); \
+		qt[ 1] = sf1(wf ## 1 ) + H( 2); \
+		qt[ 2] = sf2(wf ## 2 ) + H( 3); \
+		qt[ 3] = sf3(wf ## 3 ) + H( 4); \
+		qt[ 4] = sf4(wf ## 4 ) + H( 5); \
+		qt[ 5] = sf0(wf ## 5 ) + H( 6); \
+		qt[ 6] = sf1(wf ## 6 ) + H( 7); \
+		qt[ 7] = sf2(wf ## 7 ) + H( 8); \
+		qt[ 8] = sf3(wf ## 8 ) + H( 9); \
+		qt[ 9] = sf4(wf ## 9 ) + H(10); \
+		qt[10] = sf0(wf ## 10) + H(11); \
+		qt[11] = sf1(wf ## 11) + H(12); \
+		qt[12] = sf2(wf ## 12) + H(13); \
+		qt[13] = sf3(wf ## 13) + H(14); \
+		qt[14] = sf4(wf ## 14) + H(15); \
+		qt[15] = sf0(wf ## 15) + H( 0); \
+	} while (0)
+
+#define MAKE_Qvs   do { \
+		MAKE_Qva(ss0, ss1, ss2, ss3, ss4, Ws); \
+		MAKE_Qbs; \
+	} while (0)
+
+#define DECL_BMW32_LANES(lanes, vtype, target) \
+SPH_TARGET(target) static void \
+compress_small_x ## lanes(const vtype *m, const vtype *h, vtype *dh) \
+{ \
+	FOLD(vtype, MAKE_Qvs, SPH_T32, SPH_ROTL32, M, Qs, dH); \
+} \
+ \
+SPH_TARGET(target) static void \
+bmw32_run_x ## lanes(const unsigned char *const *p, size_t nb, \
+	sph_u32 (*hs)[16], int fin) \
+{ \
+	vtype m[16], h1[16], h2[16], *h, *g, *t, z = { 0 }; \
+	size_t off; \
+	unsigned u, l; \
+ \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			h1[u][l] = hs[l][u]; \
+	h = h1; \
+	g = h2; \
+	for (off = 0; nb -- > 0; off += 64) { \
+		for (u = 0; u < 16; u ++) \
+			for (l = 0; l < lanes; l ++) \
+				m[u][l] = sph_dec32le(p[l] + off + 4 * u); \
+		compress_small_x ## lanes(m, h, g); \
+		t = h; \
+		h = g; \
+		g = t; \
+	} \
+	if (fin) { \
+		for (u = 0; u < 16; u ++) \
+			m[u] = z + final_s[u]; \
+		compress_small_x ## lanes(h, m, g); \
+		h = g; \
+	} \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			hs[l][u] = h[u][l]; \
+}
+
+#define M(x)    (m[x])
+#define H(x)    (h[x])
+#define dH(x)   (dh[x])
+
+DECL_BMW32_LANES(4, sph_v32x4, "sse2")
+DECL_BMW32_LANES(8, sph_v32x8, "avx2")
+
+#if SPH_64
+
+#define MAKE_Qvb   do { \
+		MAKE_Qva(sb0, sb1, sb2, sb3, sb4, Wb); \
+		MAKE_Qbb; \
+	} while (0)
+
+#define DECL_BMW64_LANES(lanes, vtype, target) \
+SPH_TARGET(target) static void \
+compress_big_x ## lanes(const vtype *m, const vtype *h, vtype *dh) \
+{ \
+	FOLD(vtype, MAKE_Qvb, SPH_T64, SPH_ROTL64, M, Qb, dH); \
+} \
+ \
+SPH_TARGET(target) static void \
+bmw64_run_x ## lanes(const unsigned char *const *p, size_t nb, \
+	sph_u64 (*hs)[16], int fin) \
+{ \
+	vtype m[16], h1[16], h2[16], *h, *g, *t, z = { 0 }; \
+	size_t off; \
+	unsigned u, l; \
+ \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			h1[u][l] = hs[l][u]; \
+	h = h1; \
+	g = h2; \
+	for (off = 0; nb -- > 0; off += 128) { \
+		for (u = 0; u < 16; u ++) \
+			for (l = 0; l < lanes; l ++) \
+				m[u][l] = sph_dec64le(p[l] + off + 8 * u); \
+		compress_big_x ## lanes(m, h, g); \
+		t = h; \
+		h = g; \
+		g = t; \
+	} \
+	if (fin) { \
+		for (u = 0; u < 16; u ++) \
+			m[u] = z + final_b[u]; \
+		compress_big_x ## lanes(h, m, g); \
+		h = g; \
+	} \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			hs[l][u] = h[u][l]; \
+}
+
+DECL_BMW64_LANES(2, sph_v64x2, "sse2")
+DECL_BMW64_LANES(4, sph_v64x4, "avx2")
+
+#endif
+
+#undef M
+#undef H
+#undef dH
+
+#define MULTI_MAX_LANES   8
+
+/*
+ * Build the padding block(s) for a message of 'len' bytes, whose last
+ * 'rem' bytes (less than a block) are at 'src'; the block size is
+ * 'bs' bytes, and the bit length is encoded over 8 bytes
+ * (little-endian). Returned value is the number of blocks (1 or 2).
+ */
+static size_t
+bmw_pad(unsigned char *dst, const unsigned char *src, size_t rem,
+	size_t len, size_t bs)
+{
+	size_t tl;
+
+	tl = (rem + 9 > bs) ? (bs << 1) : bs;
+	memcpy(dst, src, rem);
+	dst[rem] = 0x80;
+	memset(dst + rem + 1, 0, tl - 9 - rem);
+	sph_enc32le(dst + tl - 8, SPH_T32((sph_u32)len << 3));
+	sph_enc32le(dst + tl - 4, SPH_T32((sph_u32)(len >> 29)));
+	return tl / bs;
+}
+
+#endif
+
+static void
+bmw32_multi(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, const sph_u32 *iv, size_t out_size_w32)
+{
+	size_t lanes, k;
+#if SPH_X86_SIMD
+	void (*run)(const unsigned char *const *p, size_t nb,
+		sph_u32 (*hs)[16], int fin);
+	unsigned f;
+
+	f = sph_cpu_features();
+	if (f & SPH_CPU_AVX2) {
+		run = bmw32_run_x8;
+		lanes = 8;
+	} else if (f & SPH_CPU_SSE2) {
+		run = bmw32_run_x4;
+		lanes = 4;
+	} else {
+		run = 0;
+		lanes = 1;
+	}
+#else
+	lanes = 1;
+#endif
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_BMW, len[k]);
+	while (num > 0) {
+		size_t n, u;
+
+		n = num < lanes ? num : lanes;
+#if SPH_X86_SIMD
+		if (n > 1) {
+			const unsigned char *p[MULTI_MAX_LANES];
+			sph_u32 hs[MULTI_MAX_LANES][16];
+			unsigned char tail[MULTI_MAX_LANES][128];
+			size_t nb, rem;
+			int same;
+
+			nb = len[0] >> 6;
+			same = 1;
+			for (u = 1; u < n; u ++) {
+				if ((len[u] >> 6) < nb)
+					nb = len[u] >> 6;
+				if (len[u] != len[0])
+					same = 0;
+			}
+			for (u = 0; u < lanes; u ++) {
+				p[u] = data[u < n ? u : 0];
+				memcpy(hs[u], iv, sizeof hs[u]);
+			}
+			run(p, nb, hs, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_BMW, nb * n);
+			if (same) {
+				size_t tb = 0, v;
+
+				rem = len[0] - (nb << 6);
+				for (u = 0; u < lanes; u ++) {
+					tb = bmw_pad(tail[u], p[u] + (nb << 6),
+						rem, len[0], 64);
+					p[u] = tail[u];
+				}
+				run(p, tb, hs, 1);
+				SPH_STATS_BLOCKS(SPH_STATS_BMW, (tb + 1) * n);
+				for (u = 0; u < n; u ++) {
+					unsigned char *out;
+
+					out = dst[u];
+					for (v = 0; v < out_size_w32; v ++)
+						sph_enc32le(out + 4 * v, hs[u]
+							[16 - out_size_w32 + v]);
+				}
+			} else {
+				for (u = 0; u < n; u ++) {
+					sph_bmw_small_context sc;
+
+					bmw32_init(&sc, hs[u]);
+#if SPH_64
+					sc.bit_count = (sph_u64)nb << 9;
+#else
+					sc.bit_count_low =
+						SPH_T32((sph_u32)nb << 9);
+					sc.bit_count_high =
+						(sph_u32)(nb >> 23);
+#endif
+					bmw32(&sc, p[u] + (nb << 6),
+						len[u] - (nb << 6));
+					bmw32_close(&sc, 0, 0,
+						dst[u], out_size_w32);
+				}
+			}
+			data += n;
+			len += n;
+			dst += n;
+			num -= n;
+			continue;
+		}
+#endif
+		for (u = 0; u < n; u ++) {
+			sph_bmw_small_context sc;
+
+			bmw32_init(&sc, iv);
+			bmw32(&sc, data[u], len[u]);
+			bmw32_close(&sc, 0, 0, dst[u], out_size_w32);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+}
+
+#if SPH_64
+
+static void
+bmw64_multi(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, const sph_u64 *iv, size_t out_size_w64)
+{
+	size_t lanes, k;
+#if SPH_X86_SIMD
+	void (*run)(const unsigned char *const *p, size_t nb,
+		sph_u64 (*hs)[16], int fin);
+	unsigned f;
+
+	f = sph_cpu_features();
+	if (f & SPH_CPU_AVX2) {
+		run = bmw64_run_x4;
+		lanes = 4;
+	} else if (f & SPH_CPU_SSE2) {
+		run = bmw64_run_x2;
+		lanes = 2;
+	} else {
+		run = 0;
+		lanes = 1;
+	}
+#else
+	lanes = 1;
+#endif
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_BMW, len[k]);
+	while (num > 0) {
+		size_t n, u;
+
+		n = num < lanes ? num : lanes;
+#if SPH_X86_SIMD
+		if (n > 1) {
+			const unsigned char *p[MULTI_MAX_LANES];
+			sph_u64 hs[MULTI_MAX_LANES][16];
+			unsigned char tail[MULTI_MAX_LANES][256];
+			size_t nb, rem;
+			int same;
+
+			nb = len[0] >> 7;
+			same = 1;
+			for (u = 1; u < n; u ++) {
+				if ((len[u] >> 7) < nb)
+					nb = len[u] >> 7;
+				if (len[u] != len[0])
+					same = 0;
+			}
+			for (u = 0; u < lanes; u ++) {
+				p[u] = data[u < n ? u : 0];
+				memcpy(hs[u], iv, sizeof hs[u]);
+			}
+			run(p, nb, hs, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_BMW, nb * n);
+			if (same) {
+				size_t tb = 0, v;
+
+				rem = len[0] - (nb << 7);
+				for (u = 0; u < lanes; u ++) {
+					tb = bmw_pad(tail[u], p[u] + (nb << 7),
+						rem, len[0], 128);
+					p[u] = tail[u];
+				}
+				run(p, tb, hs, 1);
+				SPH_STATS_BLOCKS(SPH_STATS_BMW, (tb + 1) * n);
+				for (u = 0; u < n; u ++) {
+					unsigned char *out;
+
+					out = dst[u];
+					for (v = 0; v < out_size_w64; v ++)
+						sph_enc64le(out + 8 * v, hs[u]
+							[16 - out_size_w64 + v]);
+				}
+			} else {
+				for (u = 0; u < n; u ++) {
+					sph_bmw_big_context sc;
+
+					bmw64_init(&sc, hs[u]);
+					sc.bit_count = (sph_u64)nb << 10;
+					bmw64(&sc, p[u] + (nb << 7),
+						len[u] - (nb << 7));
+					bmw64_close(&sc, 0, 0,
+						dst[u], out_size_w64);
+				}
+			}
+			data += n;
+			len += n;
+			dst += n;
+			num -= n;
+			continue;
+		}
+#endif
+		for (u = 0; u < n; u ++) {
+			sph_bmw_big_context sc;
+
+			bmw64_init(&sc, iv);
+			bmw64(&sc, data[u], len[u]);
+			bmw64_close(&sc, 0, 0, dst[u], out_size_w64);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+}
+
+#endif
+
 /* see sph_bmw.h */
 void
 sph_bmw224_init(void *cc)
@@ -849,9 +1255,17 @@ sph_bmw224_init(void *cc)
 void
 sph_bmw224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BMW, len);
 	bmw32(cc, data, len);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_bmw224, cc, iov, n);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw224_close(void *cc, void *dst)
@@ -859,6 +1273,13 @@ sph_bmw224_close(void *cc, void *dst)
 	sph_bmw224_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(bmw224, data, len, dst);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -867,6 +1288,14 @@ sph_bmw224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_bmw224_init(cc);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	bmw32_multi(data, len, dst, num, IV224, 7);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw256_init(void *cc)
@@ -878,9 +1307,17 @@ sph_bmw256_init(void *cc)
 void
 sph_bmw256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BMW, len);
 	bmw32(cc, data, len);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_bmw256, cc, iov, n);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw256_close(void *cc, void *dst)
@@ -888,6 +1325,13 @@ sph_bmw256_close(void *cc, void *dst)
 	sph_bmw256_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(bmw256, data, len, dst);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -896,6 +1340,14 @@ sph_bmw256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_bmw256_init(cc);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	bmw32_multi(data, len, dst, num, IV256, 8);
+}
+
 #if SPH_64
 
 /* see sph_bmw.h */
@@ -909,9 +1361,17 @@ sph_bmw384_init(void *cc)
 void
 sph_bmw384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BMW, len);
 	bmw64(cc, data, len);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_bmw384, cc, iov, n);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw384_close(void *cc, void *dst)
@@ -919,6 +1379,13 @@ sph_bmw384_close(void *cc, void *dst)
 	sph_bmw384_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(bmw384, data, len, dst);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -927,6 +1394,14 @@ sph_bmw384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_bmw384_init(cc);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	bmw64_multi(data, len, dst, num, IV384, 6);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw512_init(void *cc)
@@ -938,9 +1413,17 @@ sph_bmw512_init(void *cc)
 void
 sph_bmw512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_BMW, len);
 	bmw64(cc, data, len);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_bmw512, cc, iov, n);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw512_close(void *cc, void *dst)
@@ -948,6 +1431,13 @@ sph_bmw512_close(void *cc, void *dst)
 	sph_bmw512_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(bmw512, data, len, dst);
+}
+
 /* see sph_bmw.h */
 void
 sph_bmw512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -956,4 +1446,12 @@ sph_bmw512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_bmw512_init(cc);
 }
 
+/* see sph_bmw.h */
+void
+sph_bmw512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	bmw64_multi(data, len, dst, num, IV512, 8);
+}
+
 #endif
@@ -0,0 +1,262 @@
+/* $Id$ */
+/*
+ * Chained hashing with a per-message order of algorithms.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sph_chain.h"
+
+#if SPH_64
+
+#include "sph_blake.h"
+#include "sph_bmw.h"
+#include "sph_cubehash.h"
+#include "sph_echo.h"
+#include "sph_fugue.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_luffa.h"
+#include "sph_shabal.h"
+#include "sph_shavite.h"
+#include "sph_simd.h"
+#include "sph_skein.h"
+#include "sph_sha2.h"
+#include "sph_whirlpool.h"
+
+/*
+ * Number of chains which are regrouped together. At each step, the
+ * messages of a batch are split into (at most) SPH_CHAIN_NUM groups;
+ * with 256 messages and uniformly distributed orders, a group holds
+ * 16 messages on average, which fills the widest multi-message code.
+ * The working buffers then use 32 kB of stack.
+ */
+#define CHAIN_BATCH   256
+
+typedef void (*chain_multi_fun)(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+#define CHAIN_ALG(name, multi)   { \
+		&sph_ ## name ## _init, &sph_ ## name, \
+		&sph_ ## name ## _close, multi \
+	}
+
+/*
+ * Implementations, indexed by SPH_CHAIN_* identifier. Algorithms
+ * without a multi-message function are processed one message at a
+ * time, with a context.
+ */
+static const struct {
+	void (*init)(void *cc);
+	void (*update)(void *cc, const void *data, size_t len);
+	void (*close)(void *cc, void *dst);
+	chain_multi_fun multi;
+} chain_algs[SPH_CHAIN_NUM] = {
+	CHAIN_ALG(blake512, 0),
+	CHAIN_ALG(bmw512, &sph_bmw512_multi),
+	CHAIN_ALG(groestl512, &sph_groestl512_multi),
+	CHAIN_ALG(jh512, 0),
+	CHAIN_ALG(keccak512, 0),
+	CHAIN_ALG(skein512, 0),
+	CHAIN_ALG(luffa512, &sph_luffa512_multi),
+	CHAIN_ALG(cubehash512, &sph_cubehash512_multi),
+	CHAIN_ALG(shavite512, &sph_shavite512_multi),
+	CHAIN_ALG(simd512, 0),
+	CHAIN_ALG(echo512, &sph_echo512_multi),
+	CHAIN_ALG(hamsi512, &sph_hamsi512_multi),
+	CHAIN_ALG(fugue512, 0),
+	CHAIN_ALG(shabal512, &sph_shabal512_multi),
+	CHAIN_ALG(whirlpool, &sph_whirlpool_multi),
+	CHAIN_ALG(sha512, &sph_sha512_multi)
+};
+
+typedef union {
+	sph_blake512_context blake;
+	sph_bmw512_context bmw;
+	sph_groestl512_context groestl;
+	sph_jh512_context jh;
+	sph_keccak512_context keccak;
+	sph_skein512_context skein;
+	sph_luffa512_context luffa;
+	sph_cubehash512_context cubehash;
+	sph_shavite512_context shavite;
+	sph_simd512_context simd;
+	sph_echo512_context echo;
+	sph_hamsi512_context hamsi;
+	sph_fugue512_context fugue;
+	sph_shabal512_context shabal;
+	sph_whirlpool_context whirlpool;
+	sph_sha512_context sha512;
+} chain_context;
+
+static void
+chain_one(unsigned id, const void *data, size_t len, void *dst)
+{
+	chain_context cc;
+
+	chain_algs[id].init(&cc);
+	chain_algs[id].update(&cc, data, len);
+	chain_algs[id].close(&cc, dst);
+}
+
+/*
+ * Check that the n bytes of order are valid algorithm identifiers.
+ */
+static int
+chain_check(const unsigned char *order, size_t n)
+{
+	size_t u;
+
+	for (u = 0; u < n; u ++)
+		if (order[u] >= SPH_CHAIN_NUM)
+			return 0;
+	return 1;
+}
+
+/* see sph_chain.h */
+int
+sph_chain(const void *data, size_t len, void *dst,
+	const unsigned char *order, size_t steps)
+{
+	unsigned char buf[2][64];
+	size_t s;
+
+	if (!chain_check(order, steps))
+		return 0;
+	if (steps == 0)
+		return 1;
+	chain_one(order[0], data, len, buf[0]);
+	for (s = 1; s < steps; s ++)
+		chain_one(order[s], buf[(s - 1) & 1], 64, buf[s & 1]);
+	memcpy(dst, buf[(steps - 1) & 1], 64);
+	return 1;
+}
+
+/*
+ * Process up to CHAIN_BATCH chains. Step s reads the outputs of step
+ * s-1 from buf[(s - 1) & 1] and writes into buf[s & 1]. At each step,
+ * the lanes are sorted by algorithm (counting sort, stable), so that
+ * each group occupies a contiguous range of the in/ilen/out arrays,
+ * which is then handed over to the algorithm as one batch. The order
+ * bytes have been checked by the caller.
+ */
+static void
+chain_batch(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, const unsigned char *order, size_t steps,
+	sph_chain_stats *stats)
+{
+	union {
+		unsigned char b[2][CHAIN_BATCH][64];
+		sph_u64 dummy;
+	} buf;
+	const void *in[CHAIN_BATCH];
+	void *out[CHAIN_BATCH];
+	size_t ilen[CHAIN_BATCH];
+	size_t start[SPH_CHAIN_NUM + 1];
+	size_t s, u;
+	unsigned a;
+
+	for (s = 0; s < steps; s ++) {
+		unsigned char (*src)[64], (*tmp)[64];
+
+		src = buf.b[(s - 1) & 1];
+		tmp = buf.b[s & 1];
+		memset(start, 0, sizeof start);
+		for (u = 0; u < num; u ++)
+			start[order[u * steps + s] + 1] ++;
+		for (a = 0; a < SPH_CHAIN_NUM; a ++)
+			start[a + 1] += start[a];
+		for (u = 0; u < num; u ++) {
+			size_t j;
+
+			j = start[order[u * steps + s]] ++;
+			if (s == 0) {
+				in[j] = data[u];
+				ilen[j] = len[u];
+			} else {
+				in[j] = src[u];
+				ilen[j] = 64;
+			}
+			out[j] = tmp[u];
+		}
+
+		/*
+		 * start[a] is now the end of group a, i.e. the start of
+		 * group a+1.
+		 */
+		for (a = 0, u = 0; a < SPH_CHAIN_NUM; u = start[a ++]) {
+			size_t n, j;
+
+			n = start[a] - u;
+			if (n == 0)
+				continue;
+			if (stats != NULL) {
+				stats->calls[a] ++;
+				stats->lanes[a] += n;
+			}
+			if (chain_algs[a].multi != 0) {
+				chain_algs[a].multi(in + u, ilen + u,
+					out + u, n);
+			} else {
+				for (j = u; j < u + n; j ++)
+					chain_one(a, in[j], ilen[j], out[j]);
+			}
+		}
+	}
+	if (steps > 0) {
+		for (u = 0; u < num; u ++)
+			memcpy(dst[u], buf.b[(steps - 1) & 1][u], 64);
+	}
+}
+
+/* see sph_chain.h */
+int
+sph_chain_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num,
+	const unsigned char *order, size_t steps, sph_chain_stats *stats)
+{
+	size_t u;
+
+	if (!chain_check(order, num * steps))
+		return 0;
+	for (u = 0; u < num; u += CHAIN_BATCH) {
+		size_t n;
+
+		n = num - u;
+		if (n > CHAIN_BATCH)
+			n = CHAIN_BATCH;
+		chain_batch(data + u, len + u, dst + u, n,
+			order + u * steps, steps, stats);
+	}
+	return 1;
+}
+
+#endif
@@ -0,0 +1,118 @@
+/* $Id$ */
+/*
+ * Runtime CPU feature detection.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+#include <cpuid.h>
+#endif
+
+/*
+ * Detected features, plus bit 31 once detection has been performed.
+ * Detection is idempotent, so concurrent first calls from several
+ * threads merely compute the same value twice.
+ */
+#define FEATURES_DONE   0x80000000U
+
+static volatile unsigned detected = 0;
+static volatile unsigned allowed = ~0U;
+
+#if SPH_X86_SIMD
+
+static unsigned
+detect(void)
+{
+	unsigned a, b, c, d, max, f;
+	unsigned xcr0;
+
+	f = 0;
+	max = __get_cpuid_max(0, 0);
+	if (max < 1)
+		return 0;
+	__cpuid(1, a, b, c, d);
+	if (d & (1U << 26))
+		f |= SPH_CPU_SSE2;
+	if (c & (1U << 9))
+		f |= SPH_CPU_SSSE3;
+	if (c & (1U << 19))
+		f |= SPH_CPU_SSE41;
+	if (c & (1U << 25))
+		f |= SPH_CPU_AESNI;
+
+	/*
+	 * The wide registers are usable only if the operating system
+	 * saves them on context switches (OSXSAVE, then XCR0).
+	 */
+	if (!(c & (1U << 27)) || !(c & (1U << 28)) || max < 7)
+		return f;
+	__asm__ __volatile__ ("xgetbv" : "=a" (xcr0), "=d" (d) : "c" (0));
+	if ((xcr0 & 0x06) != 0x06)
+		return f;
+	__cpuid_count(7, 0, a, b, c, d);
+	if (b & (1U << 5))
+		f |= SPH_CPU_AVX2;
+	if ((b & (1U << 16)) && (b & (1U << 30)) && (b & (1U << 31))
+		&& (xcr0 & 0xE0) == 0xE0)
+		f |= SPH_CPU_AVX512;
+	if ((f & SPH_CPU_AVX2) && (f & SPH_CPU_AESNI) && (c & (1U << 9)))
+		f |= SPH_CPU_VAES;
+	return f;
+}
+
+#else
+
+static unsigned
+detect(void)
+{
+	return 0;
+}
+
+#endif
+
+/* see sph_cpu.h */
+unsigned
+sph_cpu_features(void)
+{
+	unsigned f;
+
+	f = detected;
+	if (!(f & FEATURES_DONE)) {
+		f = detect() | FEATURES_DONE;
+		detected = f;
+	}
+	return f & allowed & ~FEATURES_DONE;
+}
+
+/* see sph_cpu.h */
+void
+sph_cpu_set_mask(unsigned mask)
+{
+	allowed = mask;
+}
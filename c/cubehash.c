@@ -35,6 +35,12 @@
 #include <limits.h>
 
 #include "sph_cubehash.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+#include <immintrin.h>
+#endif
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_CUBEHASH
 #define SPH_SMALL_FOOTPRINT_CUBEHASH   1
@@ -128,6 +134,326 @@ static const sph_u32 IV512[] = {
 	SPH_C32(0x7795D246), SPH_C32(0xD43E3B44)
 };
 
+#if SPH_X86_SIMD
+
+/*
+ * Vector implementation. The state words are numbered with five bits
+ * (i, j, k, l, m) from most to least significant. With 256-bit
+ * registers, y0..y3 hold words 0-7, 8-15, 16-23 and 24-31: the
+ * register index is (i, j) and the lane index is (k, l, m). The four
+ * swaps of the round are then:
+ *
+ *   swap on j, for i = 0:  exchange y0 and y1 (free)
+ *   swap on l, for i = 1:  pshufd, within 128-bit lanes
+ *   swap on k, for i = 0:  exchange of the 128-bit halves
+ *   swap on m, for i = 1:  pshufd, within 128-bit lanes
+ *
+ * With 128-bit registers (x0..x7), both swaps on the first half are
+ * exchanges of registers. With 512-bit registers (z0 and z1, one for
+ * each value of i), both are permutations of 128-bit blocks.
+ *
+ * A "run" function processes nb blocks for each message (state at
+ * st[m], data at p[m]); if fin is non-zero, it then performs the
+ * final rounds.
+ */
+
+typedef void (*cubehash_run_fn)(sph_u32 *const *st,
+	const unsigned char *const *p, size_t nb, int fin);
+
+#define XROL(x, n)   _mm_or_si128(_mm_slli_epi32(x, n), \
+                     _mm_srli_epi32(x, 32 - (n)))
+
+#define ROUND_X   do { \
+		__m128i t0, t1; \
+		x4 = _mm_add_epi32(x0, x4); \
+		x5 = _mm_add_epi32(x1, x5); \
+		x6 = _mm_add_epi32(x2, x6); \
+		x7 = _mm_add_epi32(x3, x7); \
+		t0 = XROL(x0, 7); \
+		t1 = XROL(x1, 7); \
+		x0 = _mm_xor_si128(XROL(x2, 7), x4); \
+		x1 = _mm_xor_si128(XROL(x3, 7), x5); \
+		x2 = _mm_xor_si128(t0, x6); \
+		x3 = _mm_xor_si128(t1, x7); \
+		x4 = _mm_shuffle_epi32(x4, 0x4E); \
+		x5 = _mm_shuffle_epi32(x5, 0x4E); \
+		x6 = _mm_shuffle_epi32(x6, 0x4E); \
+		x7 = _mm_shuffle_epi32(x7, 0x4E); \
+		x4 = _mm_add_epi32(x0, x4); \
+		x5 = _mm_add_epi32(x1, x5); \
+		x6 = _mm_add_epi32(x2, x6); \
+		x7 = _mm_add_epi32(x3, x7); \
+		t0 = XROL(x0, 11); \
+		t1 = XROL(x2, 11); \
+		x0 = _mm_xor_si128(XROL(x1, 11), x4); \
+		x1 = _mm_xor_si128(t0, x5); \
+		x2 = _mm_xor_si128(XROL(x3, 11), x6); \
+		x3 = _mm_xor_si128(t1, x7); \
+		x4 = _mm_shuffle_epi32(x4, 0xB1); \
+		x5 = _mm_shuffle_epi32(x5, 0xB1); \
+		x6 = _mm_shuffle_epi32(x6, 0xB1); \
+		x7 = _mm_shuffle_epi32(x7, 0xB1); \
+	} while (0)
+
+SPH_TARGET("sse2") static void
+cubehash_run_sse2(sph_u32 *const *st, const unsigned char *const *p,
+	size_t nb, int fin)
+{
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7;
+	const unsigned char *buf;
+	int r;
+
+	x0 = _mm_loadu_si128((const __m128i *)(st[0] +  0));
+	x1 = _mm_loadu_si128((const __m128i *)(st[0] +  4));
+	x2 = _mm_loadu_si128((const __m128i *)(st[0] +  8));
+	x3 = _mm_loadu_si128((const __m128i *)(st[0] + 12));
+	x4 = _mm_loadu_si128((const __m128i *)(st[0] + 16));
+	x5 = _mm_loadu_si128((const __m128i *)(st[0] + 20));
+	x6 = _mm_loadu_si128((const __m128i *)(st[0] + 24));
+	x7 = _mm_loadu_si128((const __m128i *)(st[0] + 28));
+	for (buf = p[0]; nb > 0; nb --, buf += 32) {
+		x0 = _mm_xor_si128(x0,
+			_mm_loadu_si128((const __m128i *)(buf +  0)));
+		x1 = _mm_xor_si128(x1,
+			_mm_loadu_si128((const __m128i *)(buf + 16)));
+		for (r = 0; r < 16; r ++)
+			ROUND_X;
+	}
+	if (fin) {
+		x7 = _mm_xor_si128(x7, _mm_set_epi32(1, 0, 0, 0));
+		for (r = 0; r < 160; r ++)
+			ROUND_X;
+	}
+	_mm_storeu_si128((__m128i *)(st[0] +  0), x0);
+	_mm_storeu_si128((__m128i *)(st[0] +  4), x1);
+	_mm_storeu_si128((__m128i *)(st[0] +  8), x2);
+	_mm_storeu_si128((__m128i *)(st[0] + 12), x3);
+	_mm_storeu_si128((__m128i *)(st[0] + 16), x4);
+	_mm_storeu_si128((__m128i *)(st[0] + 20), x5);
+	_mm_storeu_si128((__m128i *)(st[0] + 24), x6);
+	_mm_storeu_si128((__m128i *)(st[0] + 28), x7);
+}
+
+#undef ROUND_X
+#undef XROL
+
+#define ROUND_Y(y0, y1, y2, y3)   do { \
+		__m256i t; \
+		y2 = _mm256_add_epi32(y0, y2); \
+		y3 = _mm256_add_epi32(y1, y3); \
+		t = YROL(y0, 7); \
+		y0 = _mm256_xor_si256(YROL(y1, 7), y2); \
+		y1 = _mm256_xor_si256(t, y3); \
+		y2 = _mm256_shuffle_epi32(y2, 0x4E); \
+		y3 = _mm256_shuffle_epi32(y3, 0x4E); \
+		y2 = _mm256_add_epi32(y0, y2); \
+		y3 = _mm256_add_epi32(y1, y3); \
+		y0 = _mm256_xor_si256( \
+			_mm256_permute4x64_epi64(YROL(y0, 11), 0x4E), y2); \
+		y1 = _mm256_xor_si256( \
+			_mm256_permute4x64_epi64(YROL(y1, 11), 0x4E), y3); \
+		y2 = _mm256_shuffle_epi32(y2, 0xB1); \
+		y3 = _mm256_shuffle_epi32(y3, 0xB1); \
+	} while (0)
+
+#define LOAD_Y(s, y0, y1, y2, y3)   do { \
+		y0 = _mm256_loadu_si256((const __m256i *)((s) +  0)); \
+		y1 = _mm256_loadu_si256((const __m256i *)((s) +  8)); \
+		y2 = _mm256_loadu_si256((const __m256i *)((s) + 16)); \
+		y3 = _mm256_loadu_si256((const __m256i *)((s) + 24)); \
+	} while (0)
+
+#define STORE_Y(s, y0, y1, y2, y3)   do { \
+		_mm256_storeu_si256((__m256i *)((s) +  0), y0); \
+		_mm256_storeu_si256((__m256i *)((s) +  8), y1); \
+		_mm256_storeu_si256((__m256i *)((s) + 16), y2); \
+		_mm256_storeu_si256((__m256i *)((s) + 24), y3); \
+	} while (0)
+
+#define INPUT_Y(y0, q)   do { \
+		y0 = _mm256_xor_si256(y0, \
+			_mm256_loadu_si256((const __m256i *)(q))); \
+	} while (0)
+
+#define FIN_Y(y3)   do { \
+		y3 = _mm256_xor_si256(y3, \
+			_mm256_set_epi32(1, 0, 0, 0, 0, 0, 0, 0)); \
+	} while (0)
+
+/*
+ * The single-message kernel is a chain of dependent instructions;
+ * when hashing two messages, their rounds are interleaved.
+ */
+#define DECL_CUBEHASH_RUN_Y(name, target) \
+SPH_TARGET(target) static void \
+name(sph_u32 *const *st, const unsigned char *const *p, size_t nb, int fin) \
+{ \
+	__m256i a0, a1, a2, a3; \
+	size_t off; \
+	int r; \
+ \
+	LOAD_Y(st[0], a0, a1, a2, a3); \
+	for (off = 0; nb > 0; nb --, off += 32) { \
+		INPUT_Y(a0, p[0] + off); \
+		for (r = 0; r < 16; r ++) \
+			ROUND_Y(a0, a1, a2, a3); \
+	} \
+	if (fin) { \
+		FIN_Y(a3); \
+		for (r = 0; r < 160; r ++) \
+			ROUND_Y(a0, a1, a2, a3); \
+	} \
+	STORE_Y(st[0], a0, a1, a2, a3); \
+} \
+ \
+SPH_TARGET(target) static void \
+name ## x2(sph_u32 *const *st, const unsigned char *const *p, \
+	size_t nb, int fin) \
+{ \
+	__m256i a0, a1, a2, a3, b0, b1, b2, b3; \
+	size_t off; \
+	int r; \
+ \
+	LOAD_Y(st[0], a0, a1, a2, a3); \
+	LOAD_Y(st[1], b0, b1, b2, b3); \
+	for (off = 0; nb > 0; nb --, off += 32) { \
+		INPUT_Y(a0, p[0] + off); \
+		INPUT_Y(b0, p[1] + off); \
+		for (r = 0; r < 16; r ++) { \
+			ROUND_Y(a0, a1, a2, a3); \
+			ROUND_Y(b0, b1, b2, b3); \
+		} \
+	} \
+	if (fin) { \
+		FIN_Y(a3); \
+		FIN_Y(b3); \
+		for (r = 0; r < 160; r ++) { \
+			ROUND_Y(a0, a1, a2, a3); \
+			ROUND_Y(b0, b1, b2, b3); \
+		} \
+	} \
+	STORE_Y(st[0], a0, a1, a2, a3); \
+	STORE_Y(st[1], b0, b1, b2, b3); \
+}
+
+#define YROL(x, n)   _mm256_or_si256(_mm256_slli_epi32(x, n), \
+                     _mm256_srli_epi32(x, 32 - (n)))
+DECL_CUBEHASH_RUN_Y(cubehash_run_avx2, "avx2")
+#undef YROL
+
+#if SPH_X86_AVX512
+
+#define CUBEHASH_AVX512   "avx2,avx512f,avx512vl"
+
+#define YROL(x, n)   _mm256_rol_epi32(x, n)
+DECL_CUBEHASH_RUN_Y(cubehash_run_avx512, CUBEHASH_AVX512)
+#undef YROL
+
+/*
+ * With 512-bit registers, one message is two registers (z0 for the
+ * words with i = 0, z1 for i = 1); the four-message kernel interleaves
+ * the rounds of four independent states.
+ */
+
+#define ROUND_Z(z0, z1)   do { \
+		z1 = _mm512_add_epi32(z0, z1); \
+		z0 = _mm512_rol_epi32(z0, 7); \
+		z0 = _mm512_xor_si512(_mm512_shuffle_i64x2(z0, z0, 0x4E), z1); \
+		z1 = _mm512_shuffle_epi32(z1, (_MM_PERM_ENUM)0x4E); \
+		z1 = _mm512_add_epi32(z0, z1); \
+		z0 = _mm512_rol_epi32(z0, 11); \
+		z0 = _mm512_xor_si512(_mm512_shuffle_i64x2(z0, z0, 0xB1), z1); \
+		z1 = _mm512_shuffle_epi32(z1, (_MM_PERM_ENUM)0xB1); \
+	} while (0)
+
+#define LOAD_Z(s, z0, z1)   do { \
+		z0 = _mm512_loadu_si512((const void *)((s) +  0)); \
+		z1 = _mm512_loadu_si512((const void *)((s) + 16)); \
+	} while (0)
+
+#define STORE_Z(s, z0, z1)   do { \
+		_mm512_storeu_si512((void *)((s) +  0), z0); \
+		_mm512_storeu_si512((void *)((s) + 16), z1); \
+	} while (0)
+
+#define INPUT_Z(z0, q)   do { \
+		z0 = _mm512_xor_si512(z0, _mm512_inserti64x4( \
+			_mm512_setzero_si512(), \
+			_mm256_loadu_si256((const __m256i *)(q)), 0)); \
+	} while (0)
+
+#define FIN_Z(z1)   do { \
+		z1 = _mm512_xor_si512(z1, _mm512_set_epi32(1, 0, 0, 0, \
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)); \
+	} while (0)
+
+SPH_TARGET(CUBEHASH_AVX512) static void
+cubehash_run_avx512x4(sph_u32 *const *st, const unsigned char *const *p,
+	size_t nb, int fin)
+{
+	__m512i a0, a1, b0, b1, c0, c1, d0, d1;
+	size_t off;
+	int r;
+
+	LOAD_Z(st[0], a0, a1);
+	LOAD_Z(st[1], b0, b1);
+	LOAD_Z(st[2], c0, c1);
+	LOAD_Z(st[3], d0, d1);
+	for (off = 0; nb > 0; nb --, off += 32) {
+		INPUT_Z(a0, p[0] + off);
+		INPUT_Z(b0, p[1] + off);
+		INPUT_Z(c0, p[2] + off);
+		INPUT_Z(d0, p[3] + off);
+		for (r = 0; r < 16; r ++) {
+			ROUND_Z(a0, a1);
+			ROUND_Z(b0, b1);
+			ROUND_Z(c0, c1);
+			ROUND_Z(d0, d1);
+		}
+	}
+	if (fin) {
+		FIN_Z(a1);
+		FIN_Z(b1);
+		FIN_Z(c1);
+		FIN_Z(d1);
+		for (r = 0; r < 160; r ++) {
+			ROUND_Z(a0, a1);
+			ROUND_Z(b0, b1);
+			ROUND_Z(c0, c1);
+			ROUND_Z(d0, d1);
+		}
+	}
+	STORE_Z(st[0], a0, a1);
+	STORE_Z(st[1], b0, b1);
+	STORE_Z(st[2], c0, c1);
+	STORE_Z(st[3], d0, d1);
+}
+
+#endif
+
+/*
+ * Get the single-message kernel, or 0 if the portable code must be
+ * used.
+ */
+static cubehash_run_fn
+cubehash_select(void)
+{
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512)
+		return cubehash_run_avx512;
+#endif
+	if (f & SPH_CPU_AVX2)
+		return cubehash_run_avx2;
+	if (f & SPH_CPU_SSE2)
+		return cubehash_run_sse2;
+	return 0;
+}
+
+#endif
+
 #define T32      SPH_T32
 #define ROTL32   SPH_ROTL32
 
@@ -538,19 +864,53 @@ cubehash_init(sph_cubehash_context *sc, const sph_u32 *iv)
 static void
 cubehash_core(sph_cubehash_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
+#if SPH_X86_SIMD
+	cubehash_run_fn run;
+#endif
 	DECL_STATE
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
 	}
 
+#if SPH_X86_SIMD
+	run = cubehash_select();
+	if (run != 0) {
+		sph_u32 *st;
+		const unsigned char *q;
+		size_t nb;
+
+		/*
+		 * Complete the buffered block, then hash full blocks
+		 * directly from the input.
+		 */
+		st = sc->state;
+		if (ptr > 0) {
+			memcpy(sc->buf + ptr, data, (sizeof sc->buf) - ptr);
+			data = (const unsigned char *)data
+				+ (sizeof sc->buf) - ptr;
+			len -= (sizeof sc->buf) - ptr;
+			q = sc->buf;
+			run(&st, &q, 1, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, 1);
+		}
+		nb = len >> 5;
+		q = data;
+		if (nb > 0) {
+			run(&st, &q, nb, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, nb);
+		}
+		memcpy(sc->buf, q + (nb << 5), len & 31);
+		sc->ptr = len & 31;
+		return;
+	}
+#endif
 	READ_STATE(sc);
 	while (len > 0) {
 		size_t clen;
@@ -558,13 +918,19 @@ cubehash_core(sph_cubehash_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			INPUT_BLOCK;
 			SIXTEEN_ROUNDS;
+			SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, 1);
 			ptr = 0;
 		}
 	}
@@ -580,6 +946,9 @@ cubehash_close(sph_cubehash_context *sc, unsigned ub, unsigned n,
 	size_t ptr;
 	unsigned z;
 	int i;
+#if SPH_X86_SIMD
+	cubehash_run_fn run;
+#endif
 	DECL_STATE
 
 	buf = sc->buf;
@@ -587,19 +956,122 @@ cubehash_close(sph_cubehash_context *sc, unsigned ub, unsigned n,
 	z = 0x80 >> n;
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
-	READ_STATE(sc);
-	INPUT_BLOCK;
-	for (i = 0; i < 11; i ++) {
-		SIXTEEN_ROUNDS;
-		if (i == 0)
-			xv ^= SPH_C32(1);
+	SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, 1);
+#if SPH_X86_SIMD
+	run = cubehash_select();
+	if (run != 0) {
+		sph_u32 *st;
+		const unsigned char *q;
+
+		st = sc->state;
+		q = buf;
+		run(&st, &q, 1, 1);
+	} else
+#endif
+	{
+		READ_STATE(sc);
+		INPUT_BLOCK;
+		for (i = 0; i < 11; i ++) {
+			SIXTEEN_ROUNDS;
+			if (i == 0)
+				xv ^= SPH_C32(1);
+		}
+		WRITE_STATE(sc);
 	}
-	WRITE_STATE(sc);
 	out = dst;
 	for (z = 0; z < out_size_w32; z ++)
 		sph_enc32le(out + (z << 2), sc->state[z]);
 }
 
+#define MULTI_MAX_LANES   4
+
+static void
+cubehash_multi(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, const sph_u32 *iv, size_t out_size_w32)
+{
+	size_t k;
+#if SPH_X86_SIMD
+	unsigned f;
+#endif
+
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_CUBEHASH, len[k]);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	while (num >= 2 && (f & SPH_CPU_AVX2) != 0) {
+		cubehash_run_fn run;
+		sph_u32 st[MULTI_MAX_LANES][32], *sp[MULTI_MAX_LANES];
+		const unsigned char *p[MULTI_MAX_LANES];
+		unsigned char tail[MULTI_MAX_LANES][32];
+		size_t n, u, v, nb, rem;
+		int same;
+
+#if SPH_X86_AVX512
+		if ((f & SPH_CPU_AVX512) && num >= 4) {
+			run = cubehash_run_avx512x4;
+			n = 4;
+		} else if (f & SPH_CPU_AVX512) {
+			run = cubehash_run_avx512x2;
+			n = 2;
+		} else
+#endif
+		{
+			run = cubehash_run_avx2x2;
+			n = 2;
+		}
+		nb = len[0] >> 5;
+		same = 1;
+		for (u = 0; u < n; u ++) {
+			if ((len[u] >> 5) < nb)
+				nb = len[u] >> 5;
+			if (len[u] != len[0])
+				same = 0;
+			memcpy(st[u], iv, sizeof st[u]);
+			sp[u] = st[u];
+			p[u] = data[u];
+		}
+		run(sp, p, nb, 0);
+		SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, nb * n);
+		if (same) {
+			rem = len[0] - (nb << 5);
+			for (u = 0; u < n; u ++) {
+				memcpy(tail[u], p[u] + (nb << 5), rem);
+				tail[u][rem] = 0x80;
+				memset(tail[u] + rem + 1, 0, 31 - rem);
+				p[u] = tail[u];
+			}
+			run(sp, p, 1, 1);
+			SPH_STATS_BLOCKS(SPH_STATS_CUBEHASH, n);
+			for (u = 0; u < n; u ++)
+				for (v = 0; v < out_size_w32; v ++)
+					sph_enc32le((unsigned char *)dst[u]
+						+ (v << 2), st[u][v]);
+		} else {
+			for (u = 0; u < n; u ++) {
+				sph_cubehash_context sc;
+
+				memcpy(sc.state, st[u], sizeof sc.state);
+				sc.ptr = 0;
+				cubehash_core(&sc, p[u] + (nb << 5),
+					len[u] - (nb << 5));
+				cubehash_close(&sc, 0, 0, dst[u], out_size_w32);
+			}
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+#endif
+	for (; num > 0; data ++, len ++, dst ++, num --) {
+		sph_cubehash_context sc;
+
+		cubehash_init(&sc, iv);
+		cubehash_core(&sc, *data, *len);
+		cubehash_close(&sc, 0, 0, *dst, out_size_w32);
+	}
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash224_init(void *cc)
@@ -611,9 +1083,17 @@ sph_cubehash224_init(void *cc)
 void
 sph_cubehash224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_CUBEHASH, len);
 	cubehash_core(cc, data, len);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_cubehash224, cc, iov, n);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash224_close(void *cc, void *dst)
@@ -621,6 +1101,13 @@ sph_cubehash224_close(void *cc, void *dst)
 	sph_cubehash224_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(cubehash224, data, len, dst);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -629,6 +1116,14 @@ sph_cubehash224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_cubehash224_init(cc);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	cubehash_multi(data, len, dst, num, IV224, 7);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash256_init(void *cc)
@@ -640,9 +1135,17 @@ sph_cubehash256_init(void *cc)
 void
 sph_cubehash256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_CUBEHASH, len);
 	cubehash_core(cc, data, len);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_cubehash256, cc, iov, n);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash256_close(void *cc, void *dst)
@@ -650,6 +1153,13 @@ sph_cubehash256_close(void *cc, void *dst)
 	sph_cubehash256_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(cubehash256, data, len, dst);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -658,6 +1168,14 @@ sph_cubehash256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_cubehash256_init(cc);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	cubehash_multi(data, len, dst, num, IV256, 8);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash384_init(void *cc)
@@ -669,9 +1187,17 @@ sph_cubehash384_init(void *cc)
 void
 sph_cubehash384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_CUBEHASH, len);
 	cubehash_core(cc, data, len);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_cubehash384, cc, iov, n);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash384_close(void *cc, void *dst)
@@ -679,6 +1205,13 @@ sph_cubehash384_close(void *cc, void *dst)
 	sph_cubehash384_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(cubehash384, data, len, dst);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -687,6 +1220,14 @@ sph_cubehash384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_cubehash384_init(cc);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	cubehash_multi(data, len, dst, num, IV384, 12);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash512_init(void *cc)
@@ -698,9 +1239,17 @@ sph_cubehash512_init(void *cc)
 void
 sph_cubehash512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_CUBEHASH, len);
 	cubehash_core(cc, data, len);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_cubehash512, cc, iov, n);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash512_close(void *cc, void *dst)
@@ -708,6 +1257,13 @@ sph_cubehash512_close(void *cc, void *dst)
 	sph_cubehash512_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_cubehash.h */
+void
+sph_cubehash512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(cubehash512, data, len, dst);
+}
+
 /* see sph_cubehash.h */
 void
 sph_cubehash512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -715,3 +1271,11 @@ sph_cubehash512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	cubehash_close(cc, ub, n, dst, 16);
 	sph_cubehash512_init(cc);
 }
+
+/* see sph_cubehash.h */
+void
+sph_cubehash512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	cubehash_multi(data, len, dst, num, IV512, 16);
+}
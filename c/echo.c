@@ -35,6 +35,8 @@
 #include <limits.h>
 
 #include "sph_echo.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_ECHO
 #define SPH_SMALL_FOOTPRINT_ECHO   1
@@ -68,6 +70,8 @@
 
 #define AES_BIG_ENDIAN   0
 #include "aes_helper.c"
+#include "aes_vperm_helper.c"
+#include "vaes_helper.c"
 
 #if SPH_ECHO_64
 
@@ -82,9 +86,9 @@
 		memcpy(W, sc->u.Vb, 8 * sizeof(sph_u64)); \
 		for (u = 0; u < 12; u ++) { \
 			W[u + 4][0] = sph_dec64le_aligned( \
-				sc->buf + 16 * u); \
+				buf + 16 * u); \
 			W[u + 4][1] = sph_dec64le_aligned( \
-				sc->buf + 16 * u + 8); \
+				buf + 16 * u + 8); \
 		} \
 	} while (0)
 
@@ -93,9 +97,9 @@
 		memcpy(W, sc->u.Vb, 16 * sizeof(sph_u64)); \
 		for (u = 0; u < 8; u ++) { \
 			W[u + 8][0] = sph_dec64le_aligned( \
-				sc->buf + 16 * u); \
+				buf + 16 * u); \
 			W[u + 8][1] = sph_dec64le_aligned( \
-				sc->buf + 16 * u + 8); \
+				buf + 16 * u + 8); \
 		} \
 	} while (0)
 
@@ -294,9 +298,9 @@ mix_column(sph_u64 W[16][2], int ia, int ib, int ic, int id)
 		sph_u64 *VV = &sc->u.Vb[0][0]; \
 		sph_u64 *WW = &W[0][0]; \
 		for (u = 0; u < 8; u ++) { \
-			VV[u] ^= sph_dec64le_aligned(sc->buf + (u * 8)) \
-				^ sph_dec64le_aligned(sc->buf + (u * 8) + 64) \
-				^ sph_dec64le_aligned(sc->buf + (u * 8) + 128) \
+			VV[u] ^= sph_dec64le_aligned(buf + (u * 8)) \
+				^ sph_dec64le_aligned(buf + (u * 8) + 64) \
+				^ sph_dec64le_aligned(buf + (u * 8) + 128) \
 				^ WW[u] ^ WW[u + 8] \
 				^ WW[u + 16] ^ WW[u + 24]; \
 		} \
@@ -307,7 +311,7 @@ mix_column(sph_u64 W[16][2], int ia, int ib, int ic, int id)
 		sph_u64 *VV = &sc->u.Vb[0][0]; \
 		sph_u64 *WW = &W[0][0]; \
 		for (u = 0; u < 16; u ++) { \
-			VV[u] ^= sph_dec64le_aligned(sc->buf + (u * 8)) \
+			VV[u] ^= sph_dec64le_aligned(buf + (u * 8)) \
 				^ WW[u] ^ WW[u + 16]; \
 		} \
 	} while (0)
@@ -351,13 +355,13 @@ mix_column(sph_u64 W[16][2], int ia, int ib, int ic, int id)
 		memcpy(W, sc->u.Vs, 16 * sizeof(sph_u32)); \
 		for (u = 0; u < 12; u ++) { \
 			W[u + 4][0] = sph_dec32le_aligned( \
-				sc->buf + 16 * u); \
+				buf + 16 * u); \
 			W[u + 4][1] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 4); \
+				buf + 16 * u + 4); \
 			W[u + 4][2] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 8); \
+				buf + 16 * u + 8); \
 			W[u + 4][3] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 12); \
+				buf + 16 * u + 12); \
 		} \
 	} while (0)
 
@@ -366,13 +370,13 @@ mix_column(sph_u64 W[16][2], int ia, int ib, int ic, int id)
 		memcpy(W, sc->u.Vs, 32 * sizeof(sph_u32)); \
 		for (u = 0; u < 8; u ++) { \
 			W[u + 8][0] = sph_dec32le_aligned( \
-				sc->buf + 16 * u); \
+				buf + 16 * u); \
 			W[u + 8][1] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 4); \
+				buf + 16 * u + 4); \
 			W[u + 8][2] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 8); \
+				buf + 16 * u + 8); \
 			W[u + 8][3] = sph_dec32le_aligned( \
-				sc->buf + 16 * u + 12); \
+				buf + 16 * u + 12); \
 		} \
 	} while (0)
 
@@ -584,9 +588,9 @@ mix_column(sph_u32 W[16][4], int ia, int ib, int ic, int id)
 		sph_u32 *VV = &sc->u.Vs[0][0]; \
 		sph_u32 *WW = &W[0][0]; \
 		for (u = 0; u < 16; u ++) { \
-			VV[u] ^= sph_dec32le_aligned(sc->buf + (u * 4)) \
-				^ sph_dec32le_aligned(sc->buf + (u * 4) + 64) \
-				^ sph_dec32le_aligned(sc->buf + (u * 4) + 128) \
+			VV[u] ^= sph_dec32le_aligned(buf + (u * 4)) \
+				^ sph_dec32le_aligned(buf + (u * 4) + 64) \
+				^ sph_dec32le_aligned(buf + (u * 4) + 128) \
 				^ WW[u] ^ WW[u + 16] \
 				^ WW[u + 32] ^ WW[u + 48]; \
 		} \
@@ -597,7 +601,7 @@ mix_column(sph_u32 W[16][4], int ia, int ib, int ic, int id)
 		sph_u32 *VV = &sc->u.Vs[0][0]; \
 		sph_u32 *WW = &W[0][0]; \
 		for (u = 0; u < 32; u ++) { \
-			VV[u] ^= sph_dec32le_aligned(sc->buf + (u * 4)) \
+			VV[u] ^= sph_dec32le_aligned(buf + (u * 4)) \
 				^ WW[u] ^ WW[u + 32]; \
 		} \
 	} while (0)
@@ -707,18 +711,152 @@ echo_big_init(sph_echo_big_context *sc, unsigned out_len)
 	sc->C0 = sc->C1 = sc->C2 = sc->C3 = 0;
 }
 
+#if SPH_X86_SIMD
+
+/*
+ * Vector implementation: each of the sixteen 128-bit words is an AES
+ * state, and the two AES rounds of BIG.SubWords are two aesenc (or
+ * their SSSE3 equivalent, when AES-NI is not available). BIG.ShiftRows
+ * is merged into BIG.MixColumns, which reads word (c + r) mod 4 of row
+ * r for output column c. The salt is zero, and the key is the 128-bit
+ * counter, incremented with a 64-bit addition; a carry into the upper
+ * half can only happen if the lower half is close to 2^64, in which
+ * case the key is rebuilt from the four 32-bit words for each word.
+ *
+ * V is the chaining value (4 or 8 words), updated in place; buf is the
+ * message block (12 or 8 words).
+ */
+typedef void (*echo_compress_fn)(void *V, const unsigned char *buf,
+	sph_u32 C0, sph_u32 C1, sph_u32 C2, sph_u32 C3, int big);
+
+#define ECHO_XTIME(x)   _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128( \
+		_mm_cmplt_epi8(x, _mm_setzero_si128()), _mm_set1_epi8(0x1B)))
+
+#define DECL_ECHO_COMPRESS(name, target, aesenc) \
+SPH_TARGET(target) static void \
+name(void *V, const unsigned char *buf, \
+	sph_u32 C0, sph_u32 C1, sph_u32 C2, sph_u32 C3, int big) \
+{ \
+	__m128i W[16], T[16], key, one, zero; \
+	__m128i *vp; \
+	const __m128i *bp; \
+	int nv, r, n, slow; \
+ \
+	vp = (__m128i *)V; \
+	bp = (const __m128i *)buf; \
+	nv = big ? 8 : 4; \
+	for (n = 0; n < nv; n ++) \
+		W[n] = _mm_loadu_si128(vp + n); \
+	for (n = nv; n < 16; n ++) \
+		W[n] = _mm_loadu_si128(bp + n - nv); \
+	slow = C1 == 0xFFFFFFFF && C0 >= 0xFFFFFFFF - 160; \
+	key = _mm_set_epi32((int)C3, (int)C2, (int)C1, (int)C0); \
+	one = _mm_set_epi32(0, 0, 0, 1); \
+	zero = _mm_setzero_si128(); \
+	for (r = big ? 10 : 8; r > 0; r --) { \
+		for (n = 0; n < 16; n ++) { \
+			W[n] = aesenc(aesenc(W[n], key), zero); \
+			if (slow) { \
+				if ((C0 = SPH_T32(C0 + 1)) == 0) { \
+					if ((C1 = SPH_T32(C1 + 1)) == 0) \
+						if ((C2 = SPH_T32(C2 + 1)) \
+							== 0) \
+							C3 = SPH_T32(C3 + 1); \
+				} \
+				key = _mm_set_epi32((int)C3, (int)C2, \
+					(int)C1, (int)C0); \
+			} else { \
+				key = _mm_add_epi64(key, one); \
+			} \
+		} \
+		for (n = 0; n < 16; n += 4) { \
+			__m128i a, b, c, d, ab, bc, cd, abx, bcx, cdx; \
+ \
+			a = W[n]; \
+			b = W[(n + 5) & 15]; \
+			c = W[(n + 10) & 15]; \
+			d = W[(n + 15) & 15]; \
+			ab = _mm_xor_si128(a, b); \
+			bc = _mm_xor_si128(b, c); \
+			cd = _mm_xor_si128(c, d); \
+			abx = ECHO_XTIME(ab); \
+			bcx = ECHO_XTIME(bc); \
+			cdx = ECHO_XTIME(cd); \
+			T[n + 0] = _mm_xor_si128(abx, _mm_xor_si128(bc, d)); \
+			T[n + 1] = _mm_xor_si128(bcx, _mm_xor_si128(a, cd)); \
+			T[n + 2] = _mm_xor_si128(cdx, _mm_xor_si128(ab, d)); \
+			T[n + 3] = _mm_xor_si128(_mm_xor_si128(abx, bcx), \
+				_mm_xor_si128(_mm_xor_si128(cdx, ab), c)); \
+		} \
+		for (n = 0; n < 16; n ++) \
+			W[n] = T[n]; \
+	} \
+	if (big) { \
+		for (n = 0; n < 8; n ++) \
+			_mm_storeu_si128(vp + n, _mm_xor_si128( \
+				_mm_loadu_si128(vp + n), \
+				_mm_xor_si128(_mm_loadu_si128(bp + n), \
+				_mm_xor_si128(W[n], W[n + 8])))); \
+	} else { \
+		for (n = 0; n < 4; n ++) \
+			_mm_storeu_si128(vp + n, _mm_xor_si128( \
+				_mm_xor_si128(_mm_loadu_si128(vp + n), \
+				_mm_xor_si128(_mm_loadu_si128(bp + n), \
+				_mm_xor_si128(_mm_loadu_si128(bp + n + 4), \
+				_mm_loadu_si128(bp + n + 8)))), \
+				_mm_xor_si128(_mm_xor_si128(W[n], W[n + 4]), \
+				_mm_xor_si128(W[n + 8], W[n + 12])))); \
+	} \
+}
+
+DECL_ECHO_COMPRESS(echo_compress_aes, "ssse3,aes", _mm_aesenc_si128)
+DECL_ECHO_COMPRESS(echo_compress_vperm, "ssse3", aes_vperm_enc)
+
+static echo_compress_fn
+echo_select(void)
+{
+	unsigned f;
+
+	f = sph_cpu_features();
+	if (!(f & SPH_CPU_SSSE3))
+		return 0;
+	if (f & SPH_CPU_AESNI)
+		return &echo_compress_aes;
+	return &echo_compress_vperm;
+}
+
+#endif
+
 static void
-echo_small_compress(sph_echo_small_context *sc)
+echo_small_compress(sph_echo_small_context *sc, const unsigned char *buf)
 {
 	DECL_STATE_SMALL
+#if SPH_X86_SIMD
+	echo_compress_fn f;
+
+	f = echo_select();
+	if (f != 0) {
+		f(&sc->u, buf, sc->C0, sc->C1, sc->C2, sc->C3, 0);
+		return;
+	}
+#endif
 
 	COMPRESS_SMALL(sc);
 }
 
 static void
-echo_big_compress(sph_echo_big_context *sc)
+echo_big_compress(sph_echo_big_context *sc, const unsigned char *buf)
 {
 	DECL_STATE_BIG
+#if SPH_X86_SIMD
+	echo_compress_fn f;
+
+	f = echo_select();
+	if (f != 0) {
+		f(&sc->u, buf, sc->C0, sc->C1, sc->C2, sc->C3, 1);
+		return;
+	}
+#endif
 
 	COMPRESS_BIG(sc);
 }
@@ -727,13 +865,12 @@ static void
 echo_small_core(sph_echo_small_context *sc,
 	const unsigned char *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -745,13 +882,19 @@ echo_small_core(sph_echo_small_context *sc,
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data += clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			INCR_COUNTER(sc, 1536);
-			echo_small_compress(sc);
+			echo_small_compress(sc, buf);
+			SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 			ptr = 0;
 		}
 	}
@@ -762,13 +905,12 @@ static void
 echo_big_core(sph_echo_big_context *sc,
 	const unsigned char *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -780,13 +922,19 @@ echo_big_core(sph_echo_big_context *sc,
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data += clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			INCR_COUNTER(sc, 1024);
-			echo_big_compress(sc);
+			echo_big_compress(sc, buf);
+			SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 			ptr = 0;
 		}
 	}
@@ -834,13 +982,15 @@ echo_small_close(sph_echo_small_context *sc, unsigned ub, unsigned n,
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	if (ptr > ((sizeof sc->buf) - 18)) {
-		echo_small_compress(sc);
+		echo_small_compress(sc, sc->buf);
+		SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 		sc->C0 = sc->C1 = sc->C2 = sc->C3 = 0;
 		memset(buf, 0, sizeof sc->buf);
 	}
 	sph_enc16le(buf + (sizeof sc->buf) - 18, out_size_w32 << 5);
 	memcpy(buf + (sizeof sc->buf) - 16, u.tmp, 16);
-	echo_small_compress(sc);
+	echo_small_compress(sc, sc->buf);
+	SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 #if SPH_ECHO_64
 	for (VV = &sc->u.Vb[0][0], k = 0; k < ((out_size_w32 + 1) >> 1); k ++)
 		sph_enc64le_aligned(u.tmp + (k << 3), VV[k]);
@@ -893,13 +1043,15 @@ echo_big_close(sph_echo_big_context *sc, unsigned ub, unsigned n,
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	if (ptr > ((sizeof sc->buf) - 18)) {
-		echo_big_compress(sc);
+		echo_big_compress(sc, sc->buf);
+		SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 		sc->C0 = sc->C1 = sc->C2 = sc->C3 = 0;
 		memset(buf, 0, sizeof sc->buf);
 	}
 	sph_enc16le(buf + (sizeof sc->buf) - 18, out_size_w32 << 5);
 	memcpy(buf + (sizeof sc->buf) - 16, u.tmp, 16);
-	echo_big_compress(sc);
+	echo_big_compress(sc, sc->buf);
+	SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
 #if SPH_ECHO_64
 	for (VV = &sc->u.Vb[0][0], k = 0; k < ((out_size_w32 + 1) >> 1); k ++)
 		sph_enc64le_aligned(u.tmp + (k << 3), VV[k]);
@@ -911,6 +1063,247 @@ echo_big_close(sph_echo_big_context *sc, unsigned ub, unsigned n,
 	echo_big_init(sc, out_size_w32 << 5);
 }
 
+/*
+ * Multi-message ECHO-384/512. The padded final blocks of each message
+ * are built beforehand, so that all blocks can be processed in the
+ * same way; with VAES, the blocks common to a group of messages are
+ * processed with one message per 128-bit lane (2 or 4 lanes), and the
+ * remaining blocks of the longer messages are then processed one by
+ * one.
+ */
+
+#if SPH_X86_SIMD
+
+/*
+ * Set C[] to the 128-bit encoding of a length of "len" bytes, in bits.
+ */
+static void
+echo_bitlen(sph_u32 *C, size_t len)
+{
+	C[0] = SPH_T32((sph_u32)len << 3);
+	C[1] = SPH_T32((sph_u32)(len >> 29));
+	C[2] = SPH_T32((sph_u32)(len >> 31 >> 30));
+	C[3] = 0;
+}
+
+/*
+ * Build the padded final block(s) of a message of "len" bytes at
+ * "data" into "tail" (which must have room for two blocks). Returned
+ * value is the number of final blocks (1 or 2).
+ */
+static size_t
+echo_big_tail(unsigned char *tail, const unsigned char *data, size_t len,
+	unsigned out_size_w32)
+{
+	size_t rem, tlen;
+	sph_u32 C[4];
+
+	rem = len & 127;
+	tlen = rem < 110 ? 128 : 256;
+	memcpy(tail, data + len - rem, rem);
+	tail[rem] = 0x80;
+	memset(tail + rem + 1, 0, tlen - rem - 1);
+	sph_enc16le(tail + tlen - 18, out_size_w32 << 5);
+	echo_bitlen(C, len);
+	sph_enc32le(tail + tlen - 16, C[0]);
+	sph_enc32le(tail + tlen - 12, C[1]);
+	sph_enc32le(tail + tlen - 8, C[2]);
+	sph_enc32le(tail + tlen - 4, C[3]);
+	return tlen >> 7;
+}
+
+/*
+ * Get the counter for block "i" of a message of "len" bytes, which
+ * has "nb" full blocks: the number of message bits up to the end of
+ * the block, or zero for a final block with no message bit.
+ */
+static void
+echo_big_counter(sph_u32 *C, size_t len, size_t nb, size_t i)
+{
+	if (i < nb)
+		echo_bitlen(C, (i + 1) << 7);
+	else if (i == nb && (len & 127) != 0)
+		echo_bitlen(C, len);
+	else
+		C[0] = C[1] = C[2] = C[3] = 0;
+}
+
+/*
+ * VAES engine: one block for each lane. st[i] is the chaining value of
+ * lane i (128 bytes, updated), blk[i] its message block and ctr[i] its
+ * counter (16 bytes). The counter is incremented with a 64-bit
+ * addition: for a message held in memory, it never comes within 160
+ * of 2^64, so that there is no carry into the upper half.
+ */
+typedef void (*echo_big_run_fn)(unsigned char *const *st,
+	const unsigned char *const *blk, const unsigned char *const *ctr);
+
+#define DECL_ECHO_BIG_X(name, VX) \
+SPH_TARGET(VX ## _TARGET) static void \
+name(unsigned char *const *st, const unsigned char *const *blk, \
+	const unsigned char *const *ctr) \
+{ \
+	VX ## _T W[16], T[16], key, one, zero; \
+	int r, n; \
+ \
+	for (n = 0; n < 8; n ++) \
+		W[n] = VX ## _LOAD(st, n << 4); \
+	for (n = 8; n < 16; n ++) \
+		W[n] = VX ## _LOAD(blk, (n - 8) << 4); \
+	key = VX ## _LOAD(ctr, 0); \
+	one = VX ## _BCAST(_mm_set_epi32(0, 0, 0, 1)); \
+	zero = VX ## _ZERO; \
+	for (r = 0; r < 10; r ++) { \
+		for (n = 0; n < 16; n ++) { \
+			W[n] = VX ## _AESENC(VX ## _AESENC(W[n], key), zero); \
+			key = VX ## _ADD64(key, one); \
+		} \
+		for (n = 0; n < 16; n += 4) { \
+			VX ## _T a, b, c, d, ab, bc, cd, abx, bcx, cdx; \
+ \
+			a = W[n]; \
+			b = W[(n + 5) & 15]; \
+			c = W[(n + 10) & 15]; \
+			d = W[(n + 15) & 15]; \
+			ab = VX ## _XOR(a, b); \
+			bc = VX ## _XOR(b, c); \
+			cd = VX ## _XOR(c, d); \
+			abx = VX ## _XTIME(ab); \
+			bcx = VX ## _XTIME(bc); \
+			cdx = VX ## _XTIME(cd); \
+			T[n + 0] = VX ## _XOR(abx, VX ## _XOR(bc, d)); \
+			T[n + 1] = VX ## _XOR(bcx, VX ## _XOR(a, cd)); \
+			T[n + 2] = VX ## _XOR(cdx, VX ## _XOR(ab, d)); \
+			T[n + 3] = VX ## _XOR(VX ## _XOR(abx, bcx), \
+				VX ## _XOR(VX ## _XOR(cdx, ab), c)); \
+		} \
+		for (n = 0; n < 16; n ++) \
+			W[n] = T[n]; \
+	} \
+	for (n = 0; n < 8; n ++) \
+		VX ## _STORE(st, n << 4, VX ## _XOR( \
+			VX ## _XOR(VX ## _LOAD(st, n << 4), \
+			VX ## _LOAD(blk, n << 4)), \
+			VX ## _XOR(W[n], W[n + 8]))); \
+}
+
+DECL_ECHO_BIG_X(echo_big_run_x2, VX2)
+#if SPH_X86_AVX512
+DECL_ECHO_BIG_X(echo_big_run_x4, VX4)
+#endif
+
+#endif
+
+static void
+echo_big_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, unsigned out_size_w32)
+{
+	size_t k;
+#if SPH_X86_SIMD
+	echo_big_run_fn run;
+	size_t lanes;
+	unsigned f;
+#endif
+
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_ECHO, len[k]);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	run = 0;
+	lanes = 1;
+#if SPH_X86_AVX512
+	if ((f & (SPH_CPU_AVX512 | SPH_CPU_VAES))
+		== (SPH_CPU_AVX512 | SPH_CPU_VAES))
+	{
+		run = &echo_big_run_x4;
+		lanes = 4;
+	} else
+#endif
+	if (f & SPH_CPU_VAES) {
+		run = &echo_big_run_x2;
+		lanes = 2;
+	}
+	while (run != 0 && num >= 2) {
+		unsigned char st[VX_MAX_LANES][128];
+		unsigned char tail[VX_MAX_LANES][256];
+		unsigned char ctr[VX_MAX_LANES][16];
+		unsigned char *sp[VX_MAX_LANES];
+		const unsigned char *d[VX_MAX_LANES];
+		const unsigned char *bp[VX_MAX_LANES], *cp[VX_MAX_LANES];
+		size_t ln[VX_MAX_LANES], nb[VX_MAX_LANES], nt[VX_MAX_LANES];
+		size_t n, u, i, c;
+		sph_u32 C[4];
+
+		/*
+		 * With fewer messages than lanes, the extra lanes hash
+		 * the first message again.
+		 */
+		n = num < lanes ? num : lanes;
+		c = (size_t)-1;
+		for (u = 0; u < lanes; u ++) {
+			d[u] = data[u < n ? u : 0];
+			ln[u] = len[u < n ? u : 0];
+			nb[u] = ln[u] >> 7;
+			nt[u] = nb[u] + echo_big_tail(tail[u],
+				d[u], ln[u], out_size_w32);
+			if (nt[u] < c)
+				c = nt[u];
+			memset(st[u], 0, sizeof st[u]);
+			for (i = 0; i < 128; i += 16)
+				sph_enc16le(st[u] + i, out_size_w32 << 5);
+			sp[u] = st[u];
+			cp[u] = ctr[u];
+		}
+		for (i = 0; i < c; i ++) {
+			for (u = 0; u < lanes; u ++) {
+				bp[u] = i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7);
+				echo_big_counter(C, ln[u], nb[u], i);
+				sph_enc32le(ctr[u], C[0]);
+				sph_enc32le(ctr[u] + 4, C[1]);
+				sph_enc32le(ctr[u] + 8, C[2]);
+				sph_enc32le(ctr[u] + 12, C[3]);
+			}
+			run(sp, bp, cp);
+			SPH_STATS_BLOCKS(SPH_STATS_ECHO, n);
+		}
+		for (u = 0; u < n; u ++) {
+			sph_echo_big_context sc;
+
+			for (i = c; i < nt[u]; i ++) {
+				memcpy(&sc.u, st[u], sizeof st[u]);
+				memcpy(sc.buf, i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7), 128);
+				echo_big_counter(C, ln[u], nb[u], i);
+				sc.C0 = C[0];
+				sc.C1 = C[1];
+				sc.C2 = C[2];
+				sc.C3 = C[3];
+				echo_big_compress(&sc, sc.buf);
+				SPH_STATS_BLOCKS(SPH_STATS_ECHO, 1);
+				memcpy(st[u], &sc.u, sizeof st[u]);
+			}
+			memcpy(dst[u], st[u], out_size_w32 << 2);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+#endif
+	while (num > 0) {
+		sph_echo_big_context sc;
+
+		echo_big_init(&sc, out_size_w32 << 5);
+		echo_big_core(&sc, data[0], len[0]);
+		echo_big_close(&sc, 0, 0, dst[0], out_size_w32);
+		data ++;
+		len ++;
+		dst ++;
+		num --;
+	}
+}
+
 /* see sph_echo.h */
 void
 sph_echo224_init(void *cc)
@@ -922,9 +1315,17 @@ sph_echo224_init(void *cc)
 void
 sph_echo224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_ECHO, len);
 	echo_small_core(cc, data, len);
 }
 
+/* see sph_echo.h */
+void
+sph_echo224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_echo224, cc, iov, n);
+}
+
 /* see sph_echo.h */
 void
 sph_echo224_close(void *cc, void *dst)
@@ -932,6 +1333,13 @@ sph_echo224_close(void *cc, void *dst)
 	echo_small_close(cc, 0, 0, dst, 7);
 }
 
+/* see sph_echo.h */
+void
+sph_echo224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(echo224, data, len, dst);
+}
+
 /* see sph_echo.h */
 void
 sph_echo224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -950,9 +1358,17 @@ sph_echo256_init(void *cc)
 void
 sph_echo256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_ECHO, len);
 	echo_small_core(cc, data, len);
 }
 
+/* see sph_echo.h */
+void
+sph_echo256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_echo256, cc, iov, n);
+}
+
 /* see sph_echo.h */
 void
 sph_echo256_close(void *cc, void *dst)
@@ -960,6 +1376,13 @@ sph_echo256_close(void *cc, void *dst)
 	echo_small_close(cc, 0, 0, dst, 8);
 }
 
+/* see sph_echo.h */
+void
+sph_echo256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(echo256, data, len, dst);
+}
+
 /* see sph_echo.h */
 void
 sph_echo256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -978,9 +1401,17 @@ sph_echo384_init(void *cc)
 void
 sph_echo384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_ECHO, len);
 	echo_big_core(cc, data, len);
 }
 
+/* see sph_echo.h */
+void
+sph_echo384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_echo384, cc, iov, n);
+}
+
 /* see sph_echo.h */
 void
 sph_echo384_close(void *cc, void *dst)
@@ -988,6 +1419,13 @@ sph_echo384_close(void *cc, void *dst)
 	echo_big_close(cc, 0, 0, dst, 12);
 }
 
+/* see sph_echo.h */
+void
+sph_echo384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(echo384, data, len, dst);
+}
+
 /* see sph_echo.h */
 void
 sph_echo384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -995,6 +1433,14 @@ sph_echo384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	echo_big_close(cc, ub, n, dst, 12);
 }
 
+/* see sph_echo.h */
+void
+sph_echo384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	echo_big_multi(data, len, dst, num, 12);
+}
+
 /* see sph_echo.h */
 void
 sph_echo512_init(void *cc)
@@ -1006,9 +1452,17 @@ sph_echo512_init(void *cc)
 void
 sph_echo512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_ECHO, len);
 	echo_big_core(cc, data, len);
 }
 
+/* see sph_echo.h */
+void
+sph_echo512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_echo512, cc, iov, n);
+}
+
 /* see sph_echo.h */
 void
 sph_echo512_close(void *cc, void *dst)
@@ -1016,9 +1470,24 @@ sph_echo512_close(void *cc, void *dst)
 	echo_big_close(cc, 0, 0, dst, 16);
 }
 
+/* see sph_echo.h */
+void
+sph_echo512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(echo512, data, len, dst);
+}
+
 /* see sph_echo.h */
 void
 sph_echo512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
 	echo_big_close(cc, ub, n, dst, 16);
 }
+
+/* see sph_echo.h */
+void
+sph_echo512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	echo_big_multi(data, len, dst, num, 16);
+}
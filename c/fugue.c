@@ -34,6 +34,13 @@
 #include <string.h>
 
 #include "sph_fugue.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+#include <immintrin.h>
+#include "aes_vperm_helper.c"
+#endif
 
 #ifdef _MSC_VER
 #pragma warning (disable: 4146)
@@ -760,6 +767,8 @@ fugue_init(sph_fugue_context *sc, size_t z_len,
 	sph_u32 p; \
 	unsigned plen, rshift; \
 	INCR_COUNTER; \
+	SPH_STATS_BLOCKS(SPH_STATS_FUGUE, \
+		((sc->partial_len + len) >> 2) - (sc->partial_len >> 2)); \
 	p = sc->partial; \
 	plen = sc->partial_len; \
 	if (plen < 4) { \
@@ -801,11 +810,597 @@ fugue_init(sph_fugue_context *sc, size_t z_len,
 	data = (const unsigned char *)data + 4; \
 	len -= 4
 
+#if SPH_X86_SIMD
+
+/*
+ * The unrolled loops of the vector code below are written as macros,
+ * where a "fall through" comment does not survive; the attribute
+ * keeps -Wimplicit-fallthrough quiet.
+ */
+#if defined __GNUC__ && __GNUC__ >= 7
+#define FALL_THROUGH   __attribute__((fallthrough))
+#else
+#define FALL_THROUGH   do { } while (0)
+#endif
+
+/*
+ * Vector implementation (SSSE3 and AES-NI). A column is a 32-bit lane
+ * (big-endian, so row 0 is the most significant byte). SMIX computes
+ * the S-box on the four columns with FV_SBOX, i.e. aesenclast (the
+ * ShiftRows step is undone beforehand with a byte shuffle) or, without
+ * AES-NI, the SSSE3 S-box from aes_vperm_helper.c. The super-mix matrix is
+ * then split into:
+ *
+ *  - the column mix with the circulant matrix (1 4 7 1), computed on
+ *    all columns at once from byte-rotated copies;
+ *  - for row i, the sum s_i of the three bytes out of the diagonal,
+ *    which is added to output column k with factor 1, 1, 7 or 4
+ *    (depending on k only);
+ *  - a final byte shuffle which moves the column mix outputs to their
+ *    place (output byte (i, k) comes from column i + k).
+ */
+
+#define FV_XTIME(x)   _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128( \
+		_mm_cmplt_epi8(x, _mm_setzero_si128()), _mm_set1_epi8(0x1B)))
+
+#define FV_SBOX_AES(x)   _mm_aesenclast_si128(_mm_shuffle_epi8(x, \
+		_mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, \
+		8, 5, 2, 15, 12, 9, 6, 3)), _mm_setzero_si128())
+
+#define SMIX_X(x)   do { \
+		__m128i v, r1, r2, c, s, y2, y4; \
+		v = FV_SBOX(x); \
+		r1 = _mm_shuffle_epi8(v, _mm_setr_epi8( \
+			3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14)); \
+		r2 = _mm_shuffle_epi8(v, _mm_setr_epi8( \
+			2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)); \
+		c = FV_XTIME(_mm_xor_si128(r1, r2)); \
+		c = FV_XTIME(_mm_xor_si128(c, r2)); \
+		c = _mm_xor_si128(_mm_xor_si128(c, v), \
+			_mm_xor_si128(r2, _mm_shuffle_epi8(v, _mm_setr_epi8( \
+			1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12)))); \
+		s = _mm_xor_si128(v, _mm_shuffle_epi32(v, 0x4E)); \
+		s = _mm_xor_si128(s, _mm_shuffle_epi32(s, 0xB1)); \
+		s = _mm_xor_si128(s, _mm_shuffle_epi8(v, _mm_setr_epi8( \
+			12, 9, 6, 3, 12, 9, 6, 3, 12, 9, 6, 3, 12, 9, 6, 3))); \
+		y2 = FV_XTIME(_mm_and_si128(s, _mm_setr_epi32(0, 0, -1, -1))); \
+		y4 = FV_XTIME(y2); \
+		s = _mm_xor_si128( \
+			_mm_xor_si128(s, _mm_and_si128(s, \
+				_mm_setr_epi32(0, 0, 0, -1))), \
+			_mm_xor_si128(y4, _mm_and_si128(y2, \
+				_mm_setr_epi32(0, 0, -1, 0)))); \
+		x = _mm_xor_si128(s, _mm_shuffle_epi8(c, _mm_setr_epi8( \
+			12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15))); \
+	} while (0)
+
+/*
+ * In the core functions, the state is held in 10 (Fugue-224/256) or
+ * 12 (Fugue-384/512) registers, each containing three consecutive
+ * columns (the fourth lane is kept at zero). Register k contains the
+ * columns 3k to 3k+2 of the state array; the state rotation at each
+ * sub-round thus amounts to a renaming of the registers, exactly as
+ * in the portable code.
+ *
+ * FV_L1(x) moves lane 0 of x into lane 1 (other lanes are cleared).
+ */
+
+#define FV_L1(x)   _mm_srli_si128(_mm_slli_si128(x, 12), 8)
+
+#define FV_M12   _mm_setr_epi32(0, -1, -1, 0)
+#define FV_M012  _mm_setr_epi32(-1, -1, -1, 0)
+
+/*
+ * One sub-round (CMIX then SMIX). a0, a1 and a2 contain the columns
+ * 0 to 8, ax the columns 15 to 17 (30 columns) or 18 to 20 (36 columns).
+ * The SMIX output is left in y.
+ */
+#define SUB_X(a0, a1, a2, ax)   do { \
+		__m128i z; \
+		z = _mm_xor_si128(_mm_srli_si128(a1, 4), \
+			_mm_srli_si128(_mm_slli_si128(a2, 12), 4)); \
+		ax = _mm_xor_si128(ax, z); \
+		y = _mm_xor_si128(_mm_xor_si128(a0, z), _mm_slli_si128(a1, 12)); \
+		SMIX_X(y); \
+		a0 = _mm_and_si128(y, FV_M012); \
+		a1 = _mm_or_si128(_mm_and_si128(a1, FV_M12), \
+			_mm_srli_si128(y, 12)); \
+	} while (0)
+
+/*
+ * A sub-round which follows another sub-round: the columns 3 to 6 are
+ * the previous SMIX output, which is used directly (this shortens the
+ * dependency chain from one SMIX to the next).
+ */
+#define SUBN_X(a0, a1, ax)   do { \
+		__m128i t; \
+		t = _mm_shuffle_epi32(y, 0x39); \
+		ax = _mm_xor_si128(ax, _mm_and_si128(t, FV_M012)); \
+		y = _mm_xor_si128(a0, t); \
+		SMIX_X(y); \
+		a0 = _mm_and_si128(y, FV_M012); \
+		a1 = _mm_or_si128(_mm_and_si128(a1, FV_M12), \
+			_mm_srli_si128(y, 12)); \
+	} while (0)
+
+#define TIX2_X(a0, a2, a3, a8)   do { \
+		__m128i q = _mm_cvtsi32_si128((int)p); \
+		a3 = _mm_xor_si128(a3, FV_L1(a0)); \
+		a0 = _mm_or_si128(_mm_and_si128(a0, FV_M12), q); \
+		a2 = _mm_xor_si128(a2, _mm_slli_si128(q, 8)); \
+		a0 = _mm_xor_si128(a0, FV_L1(a8)); \
+	} while (0)
+
+#define TIX3_X(a0, a1, a2, a5, a9, a10)   do { \
+		__m128i q = _mm_cvtsi32_si128((int)p); \
+		a5 = _mm_xor_si128(a5, FV_L1(a0)); \
+		a0 = _mm_or_si128(_mm_and_si128(a0, FV_M12), q); \
+		a2 = _mm_xor_si128(a2, _mm_slli_si128(q, 8)); \
+		a0 = _mm_xor_si128(a0, FV_L1(a9)); \
+		a1 = _mm_xor_si128(a1, FV_L1(a10)); \
+	} while (0)
+
+#define TIX4_X(a0, a1, a2, a7, a8, a9, a10)   do { \
+		__m128i q = _mm_cvtsi32_si128((int)p); \
+		a7 = _mm_xor_si128(a7, FV_L1(a0)); \
+		a0 = _mm_or_si128(_mm_and_si128(a0, FV_M12), q); \
+		a2 = _mm_xor_si128(a2, _mm_slli_si128(q, 8)); \
+		a0 = _mm_xor_si128(a0, FV_L1(a8)); \
+		a1 = _mm_xor_si128(a1, FV_L1(a9)); \
+		a2 = _mm_xor_si128(a2, FV_L1(a10)); \
+	} while (0)
+
+#define WORD2_X(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9)   do { \
+		__m128i y; \
+		TIX2_X(a0, a2, a3, a8); \
+		SUB_X(a9, a0, a1, a4); \
+		SUBN_X(a8, a9, a3); \
+	} while (0)
+
+#define WORD3_X(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		__m128i y; \
+		TIX3_X(a0, a1, a2, a5, a9, a10); \
+		SUB_X(a11, a0, a1, a5); \
+		SUBN_X(a10, a11, a4); \
+		SUBN_X(a9, a10, a3); \
+	} while (0)
+
+#define WORD4_X(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		__m128i y; \
+		TIX4_X(a0, a1, a2, a7, a8, a9, a10); \
+		SUB_X(a11, a0, a1, a5); \
+		SUBN_X(a10, a11, a4); \
+		SUBN_X(a9, a10, a3); \
+		SUBN_X(a8, a9, a2); \
+	} while (0)
+
+/*
+ * Load and store the state from and to an array of ns columns (30 or
+ * 36), with registers x0 to x9 or x11. The last register is accessed
+ * without going beyond the end of the array.
+ */
+#define LOAD_X(S, k)   (x ## k = _mm_and_si128( \
+		_mm_loadu_si128((const __m128i *)((S) + 3 * k)), FV_M012))
+
+#define LOAD_LAST_X(S, k, ns)   (x ## k = _mm_srli_si128( \
+		_mm_loadu_si128((const __m128i *)((S) + (ns) - 4)), 4))
+
+#define STORE_X(S, k, a)   _mm_storeu_si128((__m128i *)((S) + 3 * k), a)
+
+#define STORE_LAST_X(S, k, ns, a)   do { \
+		_mm_storel_epi64((__m128i *)((S) + (ns) - 3), a); \
+		(S)[(ns) - 1] = (sph_u32)_mm_cvtsi128_si32( \
+			_mm_srli_si128(a, 8)); \
+	} while (0)
+
+#define LOAD_SMALL_X(S)   do { \
+		LOAD_X(S, 0); LOAD_X(S, 1); LOAD_X(S, 2); LOAD_X(S, 3); \
+		LOAD_X(S, 4); LOAD_X(S, 5); LOAD_X(S, 6); LOAD_X(S, 7); \
+		LOAD_X(S, 8); LOAD_LAST_X(S, 9, 30); \
+	} while (0)
+
+#define STORE_SMALL_X(S)   do { \
+		STORE_X(S, 0, x0); STORE_X(S, 1, x1); STORE_X(S, 2, x2); \
+		STORE_X(S, 3, x3); STORE_X(S, 4, x4); STORE_X(S, 5, x5); \
+		STORE_X(S, 6, x6); STORE_X(S, 7, x7); STORE_X(S, 8, x8); \
+		STORE_LAST_X(S, 9, 30, x9); \
+	} while (0)
+
+#define LOAD_BIG_X(S)   do { \
+		LOAD_X(S, 0); LOAD_X(S, 1); LOAD_X(S, 2); LOAD_X(S, 3); \
+		LOAD_X(S, 4); LOAD_X(S, 5); LOAD_X(S, 6); LOAD_X(S, 7); \
+		LOAD_X(S, 8); LOAD_X(S, 9); LOAD_X(S, 10); \
+		LOAD_LAST_X(S, 11, 36); \
+	} while (0)
+
+/*
+ * Column 3k of the big state is stored from register ak.
+ */
+#define STORE_BIG_X(S, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		STORE_X(S, 0, a0); STORE_X(S, 1, a1); STORE_X(S, 2, a2); \
+		STORE_X(S, 3, a3); STORE_X(S, 4, a4); STORE_X(S, 5, a5); \
+		STORE_X(S, 6, a6); STORE_X(S, 7, a7); STORE_X(S, 8, a8); \
+		STORE_X(S, 9, a9); STORE_X(S, 10, a10); \
+		STORE_LAST_X(S, 11, 36, a11); \
+	} while (0)
+
+/*
+ * The core functions are called after CORE_ENTRY: p contains the first
+ * input word, and len is the remaining input length (at least 1).
+ */
+typedef void (*fugue_run_fn)(sph_fugue_context *sc, sph_u32 p,
+	const void *data, size_t len);
+
+#define DECL_FUGUE2_RUN(name, target) \
+SPH_TARGET(target) static void \
+name(sph_fugue_context *sc, sph_u32 p, const void *data, size_t len) \
+{ \
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9; \
+	unsigned rshift; \
+ \
+	LOAD_SMALL_X(sc->S); \
+	rshift = sc->round_shift; \
+	switch (rshift) { \
+		for (;;) { \
+		case 0: \
+			WORD2_X(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9); \
+			NEXT(1); \
+			FALL_THROUGH; \
+		case 1: \
+			WORD2_X(x8, x9, x0, x1, x2, x3, x4, x5, x6, x7); \
+			NEXT(2); \
+			FALL_THROUGH; \
+		case 2: \
+			WORD2_X(x6, x7, x8, x9, x0, x1, x2, x3, x4, x5); \
+			NEXT(3); \
+			FALL_THROUGH; \
+		case 3: \
+			WORD2_X(x4, x5, x6, x7, x8, x9, x0, x1, x2, x3); \
+			NEXT(4); \
+			FALL_THROUGH; \
+		case 4: \
+			WORD2_X(x2, x3, x4, x5, x6, x7, x8, x9, x0, x1); \
+			NEXT(0); \
+		} \
+	} \
+	CORE_EXIT \
+	STORE_SMALL_X(sc->S); \
+}
+
+#define DECL_FUGUE_BIG_RUN(name, target, BODY) \
+SPH_TARGET(target) static void \
+name(sph_fugue_context *sc, sph_u32 p, const void *data, size_t len) \
+{ \
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11; \
+	unsigned rshift; \
+ \
+	LOAD_BIG_X(sc->S); \
+	rshift = sc->round_shift; \
+	switch (rshift) { \
+		for (;;) { \
+			BODY \
+		} \
+	} \
+	CORE_EXIT \
+	STORE_BIG_X(sc->S, x0, x1, x2, x3, x4, x5, \
+		x6, x7, x8, x9, x10, x11); \
+}
+
+#define FUGUE3_BODY_X \
+	case 0: \
+		WORD3_X(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11); \
+		NEXT(1); \
+		FALL_THROUGH; \
+	case 1: \
+		WORD3_X(x9, x10, x11, x0, x1, x2, x3, x4, x5, x6, x7, x8); \
+		NEXT(2); \
+		FALL_THROUGH; \
+	case 2: \
+		WORD3_X(x6, x7, x8, x9, x10, x11, x0, x1, x2, x3, x4, x5); \
+		NEXT(3); \
+		FALL_THROUGH; \
+	case 3: \
+		WORD3_X(x3, x4, x5, x6, x7, x8, x9, x10, x11, x0, x1, x2); \
+		NEXT(0);
+
+#define FUGUE4_BODY_X \
+	case 0: \
+		WORD4_X(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11); \
+		NEXT(1); \
+		FALL_THROUGH; \
+	case 1: \
+		WORD4_X(x8, x9, x10, x11, x0, x1, x2, x3, x4, x5, x6, x7); \
+		NEXT(2); \
+		FALL_THROUGH; \
+	case 2: \
+		WORD4_X(x4, x5, x6, x7, x8, x9, x10, x11, x0, x1, x2, x3); \
+		NEXT(0);
+
+/*
+ * Final rounds. The first rounds are sub-rounds without input; for
+ * the second part, the rotations by 15 and 14 (Fugue-224/256), 12, 12
+ * and 11 (Fugue-384), or 9, 9, 9 and 8 (Fugue-512) columns amount to
+ * a full register renaming followed by a rotation by one column,
+ * which realigns all registers (FV_ROL1).
+ */
+typedef void (*fugue_final_fn)(sph_u32 *S);
+
+#define FV_L0(x)   _mm_and_si128(x, _mm_setr_epi32(-1, 0, 0, 0))
+
+#define FV_ROL1(a, b)   (a = _mm_or_si128(_mm_srli_si128(a, 4), \
+		_mm_srli_si128(_mm_slli_si128(b, 12), 4)))
+
+/*
+ * SMIX on columns 0 to 3 (a0 and the first column of a1).
+ */
+#define SMIX01_X(a0, a1)   do { \
+		y = _mm_xor_si128(a0, _mm_slli_si128(a1, 12)); \
+		SMIX_X(y); \
+		a0 = _mm_and_si128(y, FV_M012); \
+		a1 = _mm_or_si128(_mm_and_si128(a1, FV_M12), \
+			_mm_srli_si128(y, 12)); \
+	} while (0)
+
+#define DECL_FUGUE2_FINAL(name, target) \
+SPH_TARGET(target) static void \
+name(sph_u32 *S) \
+{ \
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, y, t; \
+	int i; \
+ \
+	LOAD_SMALL_X(S); \
+	SUB_X(x9, x0, x1, x4); \
+	SUBN_X(x8, x9, x3); \
+	SUBN_X(x7, x8, x2); \
+	SUBN_X(x6, x7, x1); \
+	SUBN_X(x5, x6, x0); \
+	SUBN_X(x4, x5, x9); \
+	SUBN_X(x3, x4, x8); \
+	SUBN_X(x2, x3, x7); \
+	SUBN_X(x1, x2, x6); \
+	SUBN_X(x0, x1, x5); \
+	for (i = 0; i < 13; i ++) { \
+		x1 = _mm_xor_si128(x1, FV_L1(x0)); \
+		x5 = _mm_xor_si128(x5, FV_L0(x0)); \
+		SMIX01_X(x5, x6); \
+		x6 = _mm_xor_si128(x6, FV_L1(x5)); \
+		x0 = _mm_xor_si128(x0, FV_L1(x5)); \
+		t = x0; \
+		FV_ROL1(x0, x1); FV_ROL1(x1, x2); FV_ROL1(x2, x3); \
+		FV_ROL1(x3, x4); FV_ROL1(x4, x5); FV_ROL1(x5, x6); \
+		FV_ROL1(x6, x7); FV_ROL1(x7, x8); FV_ROL1(x8, x9); \
+		FV_ROL1(x9, t); \
+		SMIX01_X(x0, x1); \
+	} \
+	STORE_SMALL_X(S); \
+}
+
+/*
+ * Sub-rounds without input on the big state: FINAL_CYCLE_X runs the
+ * eleven sub-rounds which follow a SUB_X(x11, x0, x1, x5), and brings
+ * back column 0 into x0.
+ */
+#define FINAL_CYCLE_X   do { \
+		SUBN_X(x10, x11, x4); \
+		SUBN_X(x9, x10, x3); \
+		SUBN_X(x8, x9, x2); \
+		SUBN_X(x7, x8, x1); \
+		SUBN_X(x6, x7, x0); \
+		SUBN_X(x5, x6, x11); \
+		SUBN_X(x4, x5, x10); \
+		SUBN_X(x3, x4, x9); \
+		SUBN_X(x2, x3, x8); \
+		SUBN_X(x1, x2, x7); \
+		SUBN_X(x0, x1, x6); \
+	} while (0)
+
+#define FV_ROL1_BIG(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		t = a0; \
+		FV_ROL1(a0, a1); FV_ROL1(a1, a2); FV_ROL1(a2, a3); \
+		FV_ROL1(a3, a4); FV_ROL1(a4, a5); FV_ROL1(a5, a6); \
+		FV_ROL1(a6, a7); FV_ROL1(a7, a8); FV_ROL1(a8, a9); \
+		FV_ROL1(a9, a10); FV_ROL1(a10, a11); FV_ROL1(a11, t); \
+	} while (0)
+
+#define FINAL3_X(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		for (i = 0; i < 13; i ++) { \
+			a1 = _mm_xor_si128(a1, FV_L1(a0)); \
+			a4 = _mm_xor_si128(a4, FV_L0(a0)); \
+			a8 = _mm_xor_si128(a8, FV_L0(a0)); \
+			SMIX01_X(a8, a9); \
+			a9 = _mm_xor_si128(a9, FV_L1(a8)); \
+			a0 = _mm_xor_si128(a0, FV_L1(a8)); \
+			a4 = _mm_xor_si128(a4, FV_L0(a8)); \
+			SMIX01_X(a4, a5); \
+			a5 = _mm_xor_si128(a5, FV_L1(a4)); \
+			a8 = _mm_xor_si128(a8, FV_L1(a4)); \
+			a0 = _mm_xor_si128(a0, FV_L1(a4)); \
+			FV_ROL1_BIG(a0, a1, a2, a3, a4, a5, \
+				a6, a7, a8, a9, a10, a11); \
+			SMIX01_X(a0, a1); \
+		} \
+	} while (0)
+
+#define FINAL4_X(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+	do { \
+		for (i = 0; i < 13; i ++) { \
+			a1 = _mm_xor_si128(a1, FV_L1(a0)); \
+			a3 = _mm_xor_si128(a3, FV_L0(a0)); \
+			a6 = _mm_xor_si128(a6, FV_L0(a0)); \
+			a9 = _mm_xor_si128(a9, FV_L0(a0)); \
+			SMIX01_X(a9, a10); \
+			a10 = _mm_xor_si128(a10, FV_L1(a9)); \
+			a0 = _mm_xor_si128(a0, FV_L1(a9)); \
+			a3 = _mm_xor_si128(a3, FV_L0(a9)); \
+			a6 = _mm_xor_si128(a6, FV_L0(a9)); \
+			SMIX01_X(a6, a7); \
+			a7 = _mm_xor_si128(a7, FV_L1(a6)); \
+			a9 = _mm_xor_si128(a9, FV_L1(a6)); \
+			a0 = _mm_xor_si128(a0, FV_L1(a6)); \
+			a3 = _mm_xor_si128(a3, FV_L0(a6)); \
+			SMIX01_X(a3, a4); \
+			a4 = _mm_xor_si128(a4, FV_L1(a3)); \
+			a6 = _mm_xor_si128(a6, FV_L1(a3)); \
+			a9 = _mm_xor_si128(a9, FV_L1(a3)); \
+			a0 = _mm_xor_si128(a0, FV_L1(a3)); \
+			FV_ROL1_BIG(a0, a1, a2, a3, a4, a5, \
+				a6, a7, a8, a9, a10, a11); \
+			SMIX01_X(a0, a1); \
+		} \
+	} while (0)
+
+#define DECL_FUGUE3_FINAL(name, target) \
+SPH_TARGET(target) static void \
+name(sph_u32 *S) \
+{ \
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, y, t; \
+	int i; \
+ \
+	LOAD_BIG_X(S); \
+	SUB_X(x11, x0, x1, x5); \
+	FINAL_CYCLE_X; \
+	SUBN_X(x11, x0, x5); \
+	SUBN_X(x10, x11, x4); \
+	SUBN_X(x9, x10, x3); \
+	SUBN_X(x8, x9, x2); \
+	SUBN_X(x7, x8, x1); \
+	SUBN_X(x6, x7, x0); \
+	FINAL3_X(x6, x7, x8, x9, x10, x11, x0, x1, x2, x3, x4, x5); \
+	STORE_BIG_X(S, x6, x7, x8, x9, x10, x11, x0, x1, x2, x3, x4, x5); \
+}
+
+#define DECL_FUGUE4_FINAL(name, target) \
+SPH_TARGET(target) static void \
+name(sph_u32 *S) \
+{ \
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, y, t; \
+	int i; \
+ \
+	LOAD_BIG_X(S); \
+	SUB_X(x11, x0, x1, x5); \
+	FINAL_CYCLE_X; \
+	SUBN_X(x11, x0, x5); \
+	FINAL_CYCLE_X; \
+	SUBN_X(x11, x0, x5); \
+	SUBN_X(x10, x11, x4); \
+	SUBN_X(x9, x10, x3); \
+	SUBN_X(x8, x9, x2); \
+	SUBN_X(x7, x8, x1); \
+	SUBN_X(x6, x7, x0); \
+	SUBN_X(x5, x6, x11); \
+	SUBN_X(x4, x5, x10); \
+	FINAL4_X(x4, x5, x6, x7, x8, x9, x10, x11, x0, x1, x2, x3); \
+	STORE_BIG_X(S, x4, x5, x6, x7, x8, x9, x10, x11, x0, x1, x2, x3); \
+}
+
+typedef struct {
+	fugue_run_fn run;
+	fugue_final_fn final;
+} fugue_impl;
+
+#define FUGUE_AES     "ssse3,aes"
+#define FUGUE_VPERM   "ssse3"
+
+#define FV_SBOX   FV_SBOX_AES
+
+DECL_FUGUE2_RUN(fugue2_run_aes, FUGUE_AES)
+DECL_FUGUE_BIG_RUN(fugue3_run_aes, FUGUE_AES, FUGUE3_BODY_X)
+DECL_FUGUE_BIG_RUN(fugue4_run_aes, FUGUE_AES, FUGUE4_BODY_X)
+DECL_FUGUE2_FINAL(fugue2_final_aes, FUGUE_AES)
+DECL_FUGUE3_FINAL(fugue3_final_aes, FUGUE_AES)
+DECL_FUGUE4_FINAL(fugue4_final_aes, FUGUE_AES)
+
+#if SPH_X86_AVX512
+
+/*
+ * With AVX-512VL, the sixteen extra registers remove all spills.
+ */
+#define FUGUE_AVX512  "ssse3,aes,avx2,avx512f,avx512vl"
+
+DECL_FUGUE2_RUN(fugue2_run_avx512, FUGUE_AVX512)
+DECL_FUGUE_BIG_RUN(fugue3_run_avx512, FUGUE_AVX512, FUGUE3_BODY_X)
+DECL_FUGUE_BIG_RUN(fugue4_run_avx512, FUGUE_AVX512, FUGUE4_BODY_X)
+DECL_FUGUE2_FINAL(fugue2_final_avx512, FUGUE_AVX512)
+DECL_FUGUE3_FINAL(fugue3_final_avx512, FUGUE_AVX512)
+DECL_FUGUE4_FINAL(fugue4_final_avx512, FUGUE_AVX512)
+
+#endif
+
+/*
+ * Without AES-NI, the S-box is computed with byte shuffles only. This
+ * is constant-time and uses no memory tables; the portable code may be
+ * faster on long messages, when its tables stay in L1 cache.
+ */
+#undef FV_SBOX
+#define FV_SBOX   aes_vperm_subbytes
+
+DECL_FUGUE2_RUN(fugue2_run_vperm, FUGUE_VPERM)
+DECL_FUGUE_BIG_RUN(fugue3_run_vperm, FUGUE_VPERM, FUGUE3_BODY_X)
+DECL_FUGUE_BIG_RUN(fugue4_run_vperm, FUGUE_VPERM, FUGUE4_BODY_X)
+DECL_FUGUE2_FINAL(fugue2_final_vperm, FUGUE_VPERM)
+DECL_FUGUE3_FINAL(fugue3_final_vperm, FUGUE_VPERM)
+DECL_FUGUE4_FINAL(fugue4_final_vperm, FUGUE_VPERM)
+
+/*
+ * Get the vector implementation for Fugue-224/256 (v = 0), Fugue-384
+ * (v = 1) or Fugue-512 (v = 2), or 0 if the portable code must be used.
+ */
+static const fugue_impl *
+fugue_select(int v)
+{
+	static const fugue_impl impl_aes[] = {
+		{ fugue2_run_aes, fugue2_final_aes },
+		{ fugue3_run_aes, fugue3_final_aes },
+		{ fugue4_run_aes, fugue4_final_aes }
+	};
+#if SPH_X86_AVX512
+	static const fugue_impl impl_avx512[] = {
+		{ fugue2_run_avx512, fugue2_final_avx512 },
+		{ fugue3_run_avx512, fugue3_final_avx512 },
+		{ fugue4_run_avx512, fugue4_final_avx512 }
+	};
+#endif
+	static const fugue_impl impl_vperm[] = {
+		{ fugue2_run_vperm, fugue2_final_vperm },
+		{ fugue3_run_vperm, fugue3_final_vperm },
+		{ fugue4_run_vperm, fugue4_final_vperm }
+	};
+	unsigned f;
+
+	f = sph_cpu_features();
+	if (!(f & SPH_CPU_SSSE3))
+		return 0;
+	if (!(f & SPH_CPU_AESNI))
+		return &impl_vperm[v];
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512)
+		return &impl_avx512[v];
+#endif
+	return &impl_aes[v];
+}
+
+#endif
+
 static void
 fugue2_core(sph_fugue_context *sc, const void *data, size_t len)
 {
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 	DECL_STATE_SMALL
 	CORE_ENTRY
+#if SPH_X86_SIMD
+	impl = fugue_select(0);
+	if (impl != 0) {
+		impl->run(sc, p, data, len);
+		return;
+	}
+#endif
 	READ_STATE_SMALL(sc);
 	rshift = sc->round_shift;
 	switch (rshift) {
@@ -865,8 +1460,18 @@ fugue2_core(sph_fugue_context *sc, const void *data, size_t len)
 static void
 fugue3_core(sph_fugue_context *sc, const void *data, size_t len)
 {
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 	DECL_STATE_BIG
 	CORE_ENTRY
+#if SPH_X86_SIMD
+	impl = fugue_select(1);
+	if (impl != 0) {
+		impl->run(sc, p, data, len);
+		return;
+	}
+#endif
 	READ_STATE_BIG(sc);
 	rshift = sc->round_shift;
 	switch (rshift) {
@@ -925,8 +1530,18 @@ fugue3_core(sph_fugue_context *sc, const void *data, size_t len)
 static void
 fugue4_core(sph_fugue_context *sc, const void *data, size_t len)
 {
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 	DECL_STATE_BIG
 	CORE_ENTRY
+#if SPH_X86_SIMD
+	impl = fugue_select(2);
+	if (impl != 0) {
+		impl->run(sc, p, data, len);
+		return;
+	}
+#endif
 	READ_STATE_BIG(sc);
 	rshift = sc->round_shift;
 	switch (rshift) {
@@ -1027,22 +1642,33 @@ fugue2_close(sph_fugue_context *sc, unsigned ub, unsigned n,
 	void *dst, size_t out_size_w32)
 {
 	int i;
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 
 	CLOSE_ENTRY(30, 6, fugue2_core)
-	for (i = 0; i < 10; i ++) {
-		ROR(3, 30);
-		CMIX30(S[0], S[1], S[2], S[4], S[5], S[6], S[15], S[16], S[17]);
-		SMIX(S[0], S[1], S[2], S[3]);
-	}
-	for (i = 0; i < 13; i ++) {
-		S[4] ^= S[0];
-		S[15] ^= S[0];
-		ROR(15, 30);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[16] ^= S[0];
-		ROR(14, 30);
-		SMIX(S[0], S[1], S[2], S[3]);
+#if SPH_X86_SIMD
+	impl = fugue_select(0);
+	if (impl != 0) {
+		impl->final(S);
+	} else
+#endif
+	{
+		for (i = 0; i < 10; i ++) {
+			ROR(3, 30);
+			CMIX30(S[0], S[1], S[2], S[4], S[5], S[6], S[15], S[16], S[17]);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
+		for (i = 0; i < 13; i ++) {
+			S[4] ^= S[0];
+			S[15] ^= S[0];
+			ROR(15, 30);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[16] ^= S[0];
+			ROR(14, 30);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
 	}
 	S[4] ^= S[0];
 	S[15] ^= S[0];
@@ -1066,29 +1692,40 @@ static void
 fugue3_close(sph_fugue_context *sc, unsigned ub, unsigned n, void *dst)
 {
 	int i;
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 
 	CLOSE_ENTRY(36, 9, fugue3_core)
-	for (i = 0; i < 18; i ++) {
-		ROR(3, 36);
-		CMIX36(S[0], S[1], S[2], S[4], S[5], S[6], S[18], S[19], S[20]);
-		SMIX(S[0], S[1], S[2], S[3]);
-	}
-	for (i = 0; i < 13; i ++) {
-		S[4] ^= S[0];
-		S[12] ^= S[0];
-		S[24] ^= S[0];
-		ROR(12, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[13] ^= S[0];
-		S[24] ^= S[0];
-		ROR(12, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[13] ^= S[0];
-		S[25] ^= S[0];
-		ROR(11, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
+#if SPH_X86_SIMD
+	impl = fugue_select(1);
+	if (impl != 0) {
+		impl->final(S);
+	} else
+#endif
+	{
+		for (i = 0; i < 18; i ++) {
+			ROR(3, 36);
+			CMIX36(S[0], S[1], S[2], S[4], S[5], S[6], S[18], S[19], S[20]);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
+		for (i = 0; i < 13; i ++) {
+			S[4] ^= S[0];
+			S[12] ^= S[0];
+			S[24] ^= S[0];
+			ROR(12, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[13] ^= S[0];
+			S[24] ^= S[0];
+			ROR(12, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[13] ^= S[0];
+			S[25] ^= S[0];
+			ROR(11, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
 	}
 	S[4] ^= S[0];
 	S[12] ^= S[0];
@@ -1113,38 +1750,49 @@ static void
 fugue4_close(sph_fugue_context *sc, unsigned ub, unsigned n, void *dst)
 {
 	int i;
+#if SPH_X86_SIMD
+	const fugue_impl *impl;
+#endif
 
 	CLOSE_ENTRY(36, 12, fugue4_core)
-	for (i = 0; i < 32; i ++) {
-		ROR(3, 36);
-		CMIX36(S[0], S[1], S[2], S[4], S[5], S[6], S[18], S[19], S[20]);
-		SMIX(S[0], S[1], S[2], S[3]);
-	}
-	for (i = 0; i < 13; i ++) {
-		S[4] ^= S[0];
-		S[9] ^= S[0];
-		S[18] ^= S[0];
-		S[27] ^= S[0];
-		ROR(9, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[10] ^= S[0];
-		S[18] ^= S[0];
-		S[27] ^= S[0];
-		ROR(9, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[10] ^= S[0];
-		S[19] ^= S[0];
-		S[27] ^= S[0];
-		ROR(9, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
-		S[4] ^= S[0];
-		S[10] ^= S[0];
-		S[19] ^= S[0];
-		S[28] ^= S[0];
-		ROR(8, 36);
-		SMIX(S[0], S[1], S[2], S[3]);
+#if SPH_X86_SIMD
+	impl = fugue_select(2);
+	if (impl != 0) {
+		impl->final(S);
+	} else
+#endif
+	{
+		for (i = 0; i < 32; i ++) {
+			ROR(3, 36);
+			CMIX36(S[0], S[1], S[2], S[4], S[5], S[6], S[18], S[19], S[20]);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
+		for (i = 0; i < 13; i ++) {
+			S[4] ^= S[0];
+			S[9] ^= S[0];
+			S[18] ^= S[0];
+			S[27] ^= S[0];
+			ROR(9, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[10] ^= S[0];
+			S[18] ^= S[0];
+			S[27] ^= S[0];
+			ROR(9, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[10] ^= S[0];
+			S[19] ^= S[0];
+			S[27] ^= S[0];
+			ROR(9, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+			S[4] ^= S[0];
+			S[10] ^= S[0];
+			S[19] ^= S[0];
+			S[28] ^= S[0];
+			ROR(8, 36);
+			SMIX(S[0], S[1], S[2], S[3]);
+		}
 	}
 	S[4] ^= S[0];
 	S[9] ^= S[0];
@@ -1181,9 +1829,17 @@ sph_fugue224_init(void *cc)
 void
 sph_fugue224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_FUGUE, len);
 	fugue2_core(cc, data, len);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_fugue224, cc, iov, n);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue224_close(void *cc, void *dst)
@@ -1191,6 +1847,13 @@ sph_fugue224_close(void *cc, void *dst)
 	fugue2_close(cc, 0, 0, dst, 7);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(fugue224, data, len, dst);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1209,9 +1872,17 @@ sph_fugue256_init(void *cc)
 void
 sph_fugue256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_FUGUE, len);
 	fugue2_core(cc, data, len);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_fugue256, cc, iov, n);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue256_close(void *cc, void *dst)
@@ -1219,6 +1890,13 @@ sph_fugue256_close(void *cc, void *dst)
 	fugue2_close(cc, 0, 0, dst, 8);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(fugue256, data, len, dst);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1237,9 +1915,17 @@ sph_fugue384_init(void *cc)
 void
 sph_fugue384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_FUGUE, len);
 	fugue3_core(cc, data, len);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_fugue384, cc, iov, n);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue384_close(void *cc, void *dst)
@@ -1247,6 +1933,13 @@ sph_fugue384_close(void *cc, void *dst)
 	fugue3_close(cc, 0, 0, dst);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(fugue384, data, len, dst);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1265,9 +1958,17 @@ sph_fugue512_init(void *cc)
 void
 sph_fugue512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_FUGUE, len);
 	fugue4_core(cc, data, len);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_fugue512, cc, iov, n);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue512_close(void *cc, void *dst)
@@ -1275,6 +1976,13 @@ sph_fugue512_close(void *cc, void *dst)
 	fugue4_close(cc, 0, 0, dst);
 }
 
+/* see sph_fugue.h */
+void
+sph_fugue512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(fugue512, data, len, dst);
+}
+
 /* see sph_fugue.h */
 void
 sph_fugue512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
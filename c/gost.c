@@ -1,6 +1,7 @@
 /* GOST R 34.11-94 implementation */
 #include <string.h>
 #include "sph_gost.h"
+#include "sph_stats.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable: 4146)
@@ -58,6 +59,8 @@ static void gost_compress(sph_gost_context *sc, const unsigned char *data) {
     unsigned int state[8];
     int i, j;
 
+    SPH_STATS_BLOCKS(SPH_STATS_GOST, 1);
+
     /* Load block */
     for (i = 0; i < 8; i++) {
         block[i] =
@@ -107,7 +110,7 @@ static void gost_compress(sph_gost_context *sc, const unsigned char *data) {
 }
 
 /* Process data */
-void sph_gost(void *cc, const void *data, size_t len) {
+static void gost_update(void *cc, const void *data, size_t len) {
     sph_gost_context *sc = (sph_gost_context *)cc;
     const unsigned char *ptr = (const unsigned char *)data;
     size_t fill;
@@ -140,6 +143,16 @@ void sph_gost(void *cc, const void *data, size_t len) {
     }
 }
 
+void sph_gost(void *cc, const void *data, size_t len) {
+    SPH_STATS_INPUT(SPH_STATS_GOST, len);
+    gost_update(cc, data, len);
+}
+
+/* Process scattered data */
+void sph_gost_updatev(void *cc, const sph_iovec *iov, int n) {
+    SPH_UPDATEV(sph_gost, cc, iov, n);
+}
+
 /* Finalize hash */
 void sph_gost_close(void *cc, void *dst) {
     sph_gost_context *sc = (sph_gost_context *)cc;
@@ -150,9 +163,9 @@ void sph_gost_close(void *cc, void *dst) {
     pad[0] = 0x80;
 
     if (sc->buf_ptr > 0) {
-        sph_gost(cc, pad, 32 - sc->buf_ptr);
+        gost_update(cc, pad, 32 - sc->buf_ptr);
     } else {
-        sph_gost(cc, pad, 32);
+        gost_update(cc, pad, 32);
     }
 
     /* Append length */
@@ -181,22 +194,7 @@ void sph_gost_close(void *cc, void *dst) {
     }
 }
 
-/* ================ FUNZIONI DI COMPATIBILITÀ PER RAVENCOIN ================ */
-
-/*
- * Queste funzioni sono wrapper per mantenere la compatibilità con il codice
- * esistente di Ravencoin che si aspetta le funzioni sph_gost512_*.
- * Sono funzionalmente identiche alle funzioni GOST standard.
- */
-
-void sph_gost512_init(void *cc) {
-    sph_gost_init(cc);
-}
-
-void sph_gost512(void *cc, const void *data, size_t len) {
-    sph_gost(cc, data, len);
-}
-
-void sph_gost512_close(void *cc, void *dst) {
-    sph_gost_close(cc, dst);
+/* Hash a complete message */
+void sph_gost_oneshot(const void *data, size_t len, void *dst) {
+    SPH_ONESHOT(gost, data, len, dst);
 }
@@ -34,6 +34,8 @@
 #include <string.h>
 
 #include "sph_groestl.h"
+#include "sph_stats.h"
+#include "vaes_helper.c"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_GROESTL
 #define SPH_SMALL_FOOTPRINT_GROESTL   1
@@ -2766,14 +2768,13 @@ groestl_small_init(sph_groestl_small_context *sc, unsigned out_size)
 static void
 groestl_small_core(sph_groestl_small_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE_SMALL
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -2786,12 +2787,18 @@ groestl_small_core(sph_groestl_small_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			COMPRESS_SMALL;
+			SPH_STATS_BLOCKS(SPH_STATS_GROESTL, 1);
 #if SPH_64
 			sc->count ++;
 #else
@@ -2809,7 +2816,6 @@ static void
 groestl_small_close(sph_groestl_small_context *sc,
 	unsigned ub, unsigned n, void *dst, size_t out_len)
 {
-	unsigned char *buf;
 	unsigned char pad[72];
 	size_t u, ptr, pad_len;
 #if SPH_64
@@ -2820,7 +2826,6 @@ groestl_small_close(sph_groestl_small_context *sc,
 	unsigned z;
 	DECL_STATE_SMALL
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	z = 0x80 >> n;
 	pad[0] = ((ub & -z) | z) & 0xFF;
@@ -2902,14 +2907,13 @@ groestl_big_init(sph_groestl_big_context *sc, unsigned out_size)
 static void
 groestl_big_core(sph_groestl_big_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE_BIG
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -2922,12 +2926,18 @@ groestl_big_core(sph_groestl_big_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			COMPRESS_BIG;
+			SPH_STATS_BLOCKS(SPH_STATS_GROESTL, 1);
 #if SPH_64
 			sc->count ++;
 #else
@@ -2945,7 +2955,6 @@ static void
 groestl_big_close(sph_groestl_big_context *sc,
 	unsigned ub, unsigned n, void *dst, size_t out_len)
 {
-	unsigned char *buf;
 	unsigned char pad[136];
 	size_t ptr, pad_len, u;
 #if SPH_64
@@ -2956,7 +2965,6 @@ groestl_big_close(sph_groestl_big_context *sc,
 	unsigned z;
 	DECL_STATE_BIG
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	z = 0x80 >> n;
 	pad[0] = ((ub & -z) | z) & 0xFF;
@@ -3002,6 +3010,298 @@ groestl_big_close(sph_groestl_big_context *sc,
 	groestl_big_init(sc, (unsigned)out_len << 3);
 }
 
+/*
+ * Multi-message Groestl-384/512. The padded final blocks of each
+ * message are built beforehand, so that all blocks can be processed
+ * in the same way; with VAES, the blocks common to a group of messages
+ * are processed with one message per 128-bit lane (2 or 4 lanes), and
+ * the remaining blocks of the longer messages are then processed one
+ * by one.
+ */
+
+#if SPH_X86_SIMD
+
+/*
+ * Build the padded final block(s) of a message of "len" bytes at
+ * "data" into "tail" (which must have room for two blocks). Returned
+ * value is the number of final blocks (1 or 2).
+ */
+static size_t
+groestl_big_tail(unsigned char *tail, const unsigned char *data, size_t len)
+{
+	size_t rem, tlen, count;
+
+	rem = len & 127;
+	tlen = rem < 120 ? 128 : 256;
+	memcpy(tail, data + len - rem, rem);
+	tail[rem] = 0x80;
+	memset(tail + rem + 1, 0, tlen - rem - 1);
+	count = (len >> 7) + (tlen >> 7);
+	sph_enc32be(tail + tlen - 8, SPH_T32((sph_u32)(count >> 16 >> 16)));
+	sph_enc32be(tail + tlen - 4, SPH_T32((sph_u32)count));
+	return tlen >> 7;
+}
+
+/*
+ * VAES engine. Each register holds one row of the state (the 16 bytes
+ * are the 16 columns); the chaining values and message blocks are
+ * transposed on input and output, with a byte shuffle (which gathers
+ * the bytes of each row within pairs of columns) then an 8x8 transpose
+ * of 16-bit elements.
+ *
+ * SubBytes is aesenclast with a zero key, and ShiftBytes is merged
+ * into the byte shuffle which undoes the AES ShiftRows beforehand
+ * (groestl_vshift[], for P then for Q). MixBytes multiplies the
+ * columns by circ(2, 2, 3, 4, 5, 3, 5, 7): output row i is
+ * S1 + 2 * (S2 + 2 * S4), where S1, S2 and S4 are the sums of the
+ * input rows i + k whose coefficient b[k] has bit 0, 1 or 2 set.
+ */
+static const unsigned char groestl_vshift[16][16] = {
+	{  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+	{  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+	{  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+	{  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+	{  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+	{  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+	{  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+	{ 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+	{  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+	{  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+	{  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+	{ 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+	{  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+	{  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+	{  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+	{  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 }
+};
+
+/*
+ * Round constants (without the round number): row 0 for P, row 7
+ * for Q (the other rows of Q get 0xFF).
+ */
+static const unsigned char groestl_vrc[2][16] = {
+	{ 0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+	  0x80, 0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0xE0, 0xF0 },
+	{ 0xFF, 0xEF, 0xDF, 0xCF, 0xBF, 0xAF, 0x9F, 0x8F,
+	  0x7F, 0x6F, 0x5F, 0x4F, 0x3F, 0x2F, 0x1F, 0x0F }
+};
+
+typedef void (*groestl_big_run_fn)(unsigned char *const *st,
+	const unsigned char *const *blk, int fin);
+
+#define GROESTL_TRANSPOSE_X(VX, x)   do { \
+		VX ## _T ta[8], tb[8]; \
+		int k; \
+		for (k = 0; k < 8; k += 2) { \
+			ta[k] = VX ## _UNPACKLO16(x[k], x[k + 1]); \
+			ta[k + 1] = VX ## _UNPACKHI16(x[k], x[k + 1]); \
+		} \
+		for (k = 0; k < 8; k += 4) { \
+			tb[k + 0] = VX ## _UNPACKLO32(ta[k], ta[k + 2]); \
+			tb[k + 1] = VX ## _UNPACKHI32(ta[k], ta[k + 2]); \
+			tb[k + 2] = VX ## _UNPACKLO32(ta[k + 1], ta[k + 3]); \
+			tb[k + 3] = VX ## _UNPACKHI32(ta[k + 1], ta[k + 3]); \
+		} \
+		for (k = 0; k < 4; k ++) { \
+			x[2 * k] = VX ## _UNPACKLO64(tb[k], tb[k + 4]); \
+			x[2 * k + 1] = VX ## _UNPACKHI64(tb[k], tb[k + 4]); \
+		} \
+	} while (0)
+
+#define GROESTL_LOAD_X(VX, x, p)   do { \
+		VX ## _T cr; \
+		int j; \
+		cr = VX ## _BCAST(_mm_setr_epi8( \
+			0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15)); \
+		for (j = 0; j < 8; j ++) \
+			x[j] = VX ## _SHUF8(VX ## _LOAD(p, j << 4), cr); \
+		GROESTL_TRANSPOSE_X(VX, x); \
+	} while (0)
+
+#define GROESTL_STORE_X(VX, x, p)   do { \
+		VX ## _T rc; \
+		int j; \
+		rc = VX ## _BCAST(_mm_setr_epi8( \
+			0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15)); \
+		GROESTL_TRANSPOSE_X(VX, x); \
+		for (j = 0; j < 8; j ++) \
+			VX ## _STORE(p, j << 4, VX ## _SHUF8(x[j], rc)); \
+	} while (0)
+
+#define DECL_GROESTL_BIG_X(name, VX) \
+SPH_TARGET(VX ## _TARGET) static inline void \
+name ## _perm(VX ## _T *x, int q) \
+{ \
+	VX ## _T sh[8], y[8], rc, ones, zero; \
+	int r, i; \
+ \
+	for (i = 0; i < 8; i ++) \
+		sh[i] = VX ## _BCAST(_mm_loadu_si128( \
+			(const __m128i *)groestl_vshift[(q << 3) + i])); \
+	rc = VX ## _BCAST(_mm_loadu_si128((const __m128i *)groestl_vrc[q])); \
+	ones = VX ## _ONES; \
+	zero = VX ## _ZERO; \
+	for (r = 0; r < 14; r ++) { \
+		if (q) { \
+			for (i = 0; i < 7; i ++) \
+				x[i] = VX ## _XOR(x[i], ones); \
+			x[7] = VX ## _XOR(x[7], \
+				VX ## _XOR(rc, VX ## _SET1_8(r))); \
+		} else { \
+			x[0] = VX ## _XOR(x[0], \
+				VX ## _XOR(rc, VX ## _SET1_8(r))); \
+		} \
+		for (i = 0; i < 8; i ++) \
+			x[i] = VX ## _AESENCLAST( \
+				VX ## _SHUF8(x[i], sh[i]), zero); \
+		for (i = 0; i < 8; i ++) { \
+			VX ## _T s1, s2, s4; \
+ \
+			s1 = VX ## _XOR(VX ## _XOR(x[(i + 2) & 7], \
+				x[(i + 4) & 7]), VX ## _XOR(x[(i + 5) & 7], \
+				VX ## _XOR(x[(i + 6) & 7], x[(i + 7) & 7]))); \
+			s2 = VX ## _XOR(VX ## _XOR(x[i], x[(i + 1) & 7]), \
+				VX ## _XOR(x[(i + 2) & 7], \
+				VX ## _XOR(x[(i + 5) & 7], x[(i + 7) & 7]))); \
+			s4 = VX ## _XOR(VX ## _XOR(x[(i + 3) & 7], \
+				x[(i + 4) & 7]), VX ## _XOR(x[(i + 6) & 7], \
+				x[(i + 7) & 7])); \
+			y[i] = VX ## _XOR(s1, VX ## _XTIME( \
+				VX ## _XOR(s2, VX ## _XTIME(s4)))); \
+		} \
+		for (i = 0; i < 8; i ++) \
+			x[i] = y[i]; \
+	} \
+} \
+ \
+SPH_TARGET(VX ## _TARGET) static void \
+name(unsigned char *const *st, const unsigned char *const *blk, int fin) \
+{ \
+	VX ## _T h[8], g[8], m[8]; \
+	int i; \
+ \
+	GROESTL_LOAD_X(VX, h, st); \
+	if (fin) { \
+		for (i = 0; i < 8; i ++) \
+			g[i] = h[i]; \
+		name ## _perm(g, 0); \
+		for (i = 0; i < 8; i ++) \
+			h[i] = VX ## _XOR(h[i], g[i]); \
+	} else { \
+		GROESTL_LOAD_X(VX, m, blk); \
+		for (i = 0; i < 8; i ++) \
+			g[i] = VX ## _XOR(h[i], m[i]); \
+		name ## _perm(g, 0); \
+		name ## _perm(m, 1); \
+		for (i = 0; i < 8; i ++) \
+			h[i] = VX ## _XOR(h[i], VX ## _XOR(g[i], m[i])); \
+	} \
+	GROESTL_STORE_X(VX, h, st); \
+}
+
+DECL_GROESTL_BIG_X(groestl_big_run_x2, VX2)
+#if SPH_X86_AVX512
+DECL_GROESTL_BIG_X(groestl_big_run_x4, VX4)
+#endif
+
+#endif
+
+static void
+groestl_big_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, size_t out_len)
+{
+	size_t k;
+#if SPH_X86_SIMD
+	groestl_big_run_fn run;
+	size_t lanes;
+	unsigned f;
+#endif
+
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_GROESTL, len[k]);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	run = 0;
+	lanes = 1;
+#if SPH_X86_AVX512
+	if ((f & (SPH_CPU_AVX512 | SPH_CPU_VAES))
+		== (SPH_CPU_AVX512 | SPH_CPU_VAES))
+	{
+		run = &groestl_big_run_x4;
+		lanes = 4;
+	} else
+#endif
+	if (f & SPH_CPU_VAES) {
+		run = &groestl_big_run_x2;
+		lanes = 2;
+	}
+	while (run != 0 && num >= 2) {
+		unsigned char st[VX_MAX_LANES][128];
+		unsigned char tail[VX_MAX_LANES][256];
+		unsigned char *sp[VX_MAX_LANES];
+		const unsigned char *d[VX_MAX_LANES];
+		const unsigned char *bp[VX_MAX_LANES];
+		size_t nb[VX_MAX_LANES], nt[VX_MAX_LANES];
+		size_t n, u, i, c;
+
+		/*
+		 * With fewer messages than lanes, the extra lanes hash
+		 * the first message again.
+		 */
+		n = num < lanes ? num : lanes;
+		c = (size_t)-1;
+		for (u = 0; u < lanes; u ++) {
+			d[u] = data[u < n ? u : 0];
+			nb[u] = len[u < n ? u : 0] >> 7;
+			nt[u] = nb[u] + groestl_big_tail(tail[u],
+				d[u], len[u < n ? u : 0]);
+			if (nt[u] < c)
+				c = nt[u];
+			memset(st[u], 0, sizeof st[u]);
+			st[u][126] = (unsigned char)(out_len >> 5);
+			st[u][127] = (unsigned char)(out_len << 3);
+			sp[u] = st[u];
+		}
+		for (i = 0; i < c; i ++) {
+			for (u = 0; u < lanes; u ++)
+				bp[u] = i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7);
+			run(sp, bp, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_GROESTL, n);
+		}
+		for (u = 0; u < n; u ++) {
+			sph_groestl_big_context sc;
+
+			for (i = c; i < nt[u]; i ++) {
+				memcpy(&sc.state, st[u], sizeof st[u]);
+				sc.ptr = 0;
+				groestl_big_core(&sc, i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7), 128);
+				memcpy(st[u], &sc.state, sizeof st[u]);
+			}
+		}
+		run(sp, bp, 1);
+		for (u = 0; u < n; u ++)
+			memcpy(dst[u], st[u] + 128 - out_len, out_len);
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+#endif
+	while (num > 0) {
+		sph_groestl_big_context sc;
+
+		groestl_big_init(&sc, (unsigned)out_len << 3);
+		groestl_big_core(&sc, data[0], len[0]);
+		groestl_big_close(&sc, 0, 0, dst[0], out_len);
+		data ++;
+		len ++;
+		dst ++;
+		num --;
+	}
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl224_init(void *cc)
@@ -3013,9 +3313,17 @@ sph_groestl224_init(void *cc)
 void
 sph_groestl224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_GROESTL, len);
 	groestl_small_core(cc, data, len);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_groestl224, cc, iov, n);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl224_close(void *cc, void *dst)
@@ -3023,6 +3331,13 @@ sph_groestl224_close(void *cc, void *dst)
 	groestl_small_close(cc, 0, 0, dst, 28);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(groestl224, data, len, dst);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -3041,9 +3356,17 @@ sph_groestl256_init(void *cc)
 void
 sph_groestl256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_GROESTL, len);
 	groestl_small_core(cc, data, len);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_groestl256, cc, iov, n);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl256_close(void *cc, void *dst)
@@ -3051,6 +3374,13 @@ sph_groestl256_close(void *cc, void *dst)
 	groestl_small_close(cc, 0, 0, dst, 32);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(groestl256, data, len, dst);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -3069,9 +3399,17 @@ sph_groestl384_init(void *cc)
 void
 sph_groestl384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_GROESTL, len);
 	groestl_big_core(cc, data, len);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_groestl384, cc, iov, n);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl384_close(void *cc, void *dst)
@@ -3079,6 +3417,13 @@ sph_groestl384_close(void *cc, void *dst)
 	groestl_big_close(cc, 0, 0, dst, 48);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(groestl384, data, len, dst);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -3086,6 +3431,14 @@ sph_groestl384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	groestl_big_close(cc, ub, n, dst, 48);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	groestl_big_multi(data, len, dst, num, 48);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl512_init(void *cc)
@@ -3097,9 +3450,17 @@ sph_groestl512_init(void *cc)
 void
 sph_groestl512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_GROESTL, len);
 	groestl_big_core(cc, data, len);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_groestl512, cc, iov, n);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl512_close(void *cc, void *dst)
@@ -3107,9 +3468,24 @@ sph_groestl512_close(void *cc, void *dst)
 	groestl_big_close(cc, 0, 0, dst, 64);
 }
 
+/* see sph_groestl.h */
+void
+sph_groestl512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(groestl512, data, len, dst);
+}
+
 /* see sph_groestl.h */
 void
 sph_groestl512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
 	groestl_big_close(cc, ub, n, dst, 64);
 }
+
+/* see sph_groestl.h */
+void
+sph_groestl512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	groestl_big_multi(data, len, dst, num, 64);
+}
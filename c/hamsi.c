@@ -34,6 +34,12 @@
 #include <string.h>
 
 #include "sph_hamsi.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+#include <immintrin.h>
+#endif
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_HAMSI
 #define SPH_SMALL_FOOTPRINT_HAMSI   1
@@ -108,6 +114,14 @@
 #pragma warning (disable: 4146)
 #endif
 
+/*
+ * The vector code needs the generator rows (the one-bit expansion
+ * tables), whatever the expansion level of the portable code.
+ */
+#if SPH_X86_SIMD
+#define HAMSI_GENERATOR_ROWS   1
+#endif
+
 #include "hamsi_helper.c"
 
 static const sph_u32 IV224[] = {
@@ -180,6 +194,373 @@ static const sph_u32 alpha_f[] = {
 	SPH_C32(0xcaf9f9c0), SPH_C32(0x0ff0639c)
 };
 
+#if SPH_X86_SIMD
+
+/*
+ * Vector implementation. The message expansion does not use the
+ * multi-bit lookup tables: each message bit is turned into an all-zeros or
+ * all-ones mask (by shifting it into the sign bit, then with an
+ * arithmetic right shift), and the mask selects the corresponding row
+ * of the generator matrix (T256 or T512, which are read sequentially
+ * and entirely, regardless of the data). This avoids data-dependent
+ * memory accesses altogether.
+ *
+ * The state words are held in rows, with row i containing the
+ * s(4i)..s(4i+3) words for Hamsi-224/256 (128-bit registers), and the
+ * s(8i)..s(8i+7) words for Hamsi-384/512 (256-bit registers), so that
+ * the S-box applies to columns. The L transforms apply to diagonals
+ * (lanes are rotated so that they become columns, then rotated back);
+ * the four extra L transforms of Hamsi-384/512 operate on 128-bit
+ * registers, after a regrouping of the involved words.
+ *
+ * A "run" function processes num blocks; if fin is non-zero, the
+ * blocks are processed with the final permutation instead of the
+ * normal one.
+ */
+
+typedef void (*hamsi_run_fn)(sph_u32 *h, const unsigned char *buf,
+	size_t num, int fin);
+
+#define SBOX_V(a, b, c, d, and, or, xor, not)   do { \
+		t = (a); \
+		(a) = and(a, c); \
+		(a) = xor(a, d); \
+		(c) = xor(c, b); \
+		(c) = xor(c, a); \
+		(d) = or(d, t); \
+		(d) = xor(d, b); \
+		t = xor(t, c); \
+		(b) = (d); \
+		(d) = or(d, t); \
+		(d) = xor(d, a); \
+		(a) = and(a, b); \
+		t = xor(t, a); \
+		(b) = xor(b, d); \
+		(b) = xor(b, t); \
+		(a) = (c); \
+		(c) = (b); \
+		(b) = (d); \
+		(d) = not(t); \
+	} while (0)
+
+#define L_V(a, b, c, d, rol, sll, xor)   do { \
+		(a) = rol(a, 13); \
+		(c) = rol(c, 3); \
+		(b) = xor(b, xor(a, c)); \
+		(d) = xor(d, xor(c, sll(a, 3))); \
+		(b) = rol(b, 1); \
+		(d) = rol(d, 7); \
+		(a) = xor(a, xor(b, d)); \
+		(c) = xor(c, xor(d, sll(b, 7))); \
+		(a) = rol(a, 5); \
+		(c) = rol(c, 22); \
+	} while (0)
+
+#define XNOT(x)   _mm_xor_si128(x, _mm_set1_epi32(-1))
+#define YNOT(x)   _mm256_xor_si256(x, _mm256_set1_epi32(-1))
+
+#define SBOX_X(a, b, c, d)   SBOX_V(a, b, c, d, \
+	_mm_and_si128, _mm_or_si128, _mm_xor_si128, XNOT)
+#define SBOX_Y(a, b, c, d)   SBOX_V(a, b, c, d, \
+	_mm256_and_si256, _mm256_or_si256, _mm256_xor_si256, YNOT)
+#define L_X(a, b, c, d)   L_V(a, b, c, d, XROL, _mm_slli_epi32, _mm_xor_si128)
+#define L_Y(a, b, c, d)   L_V(a, b, c, d, \
+	YROL, _mm256_slli_epi32, _mm256_xor_si256)
+
+#define XLD(p)   _mm_loadu_si128((const __m128i *)(p))
+#define YLD(p)   _mm256_loadu_si256((const __m256i *)(p))
+
+#define YPERM(x, i0, i1, i2, i3, i4, i5, i6, i7) \
+	_mm256_permutevar8x32_epi32(x, \
+		_mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7))
+
+#define ROUND_SMALL_X(rc, alpha)   do { \
+		r0 = _mm_xor_si128(r0, _mm_xor_si128(XLD(alpha), \
+			_mm_setr_epi32(0, (rc), 0, 0))); \
+		r1 = _mm_xor_si128(r1, XLD((alpha) + 0x08)); \
+		r2 = _mm_xor_si128(r2, XLD((alpha) + 0x10)); \
+		r3 = _mm_xor_si128(r3, XLD((alpha) + 0x18)); \
+		SBOX_X(r0, r1, r2, r3); \
+		r1 = _mm_shuffle_epi32(r1, 0x39); \
+		r2 = _mm_shuffle_epi32(r2, 0x4E); \
+		r3 = _mm_shuffle_epi32(r3, 0x93); \
+		L_X(r0, r1, r2, r3); \
+		r1 = _mm_shuffle_epi32(r1, 0x93); \
+		r2 = _mm_shuffle_epi32(r2, 0x4E); \
+		r3 = _mm_shuffle_epi32(r3, 0x39); \
+	} while (0)
+
+/*
+ * The extra L transforms of Hamsi-384/512 use the words 0, 2, 5 and 7
+ * of rows 0 and 2, and the words 1, 3, 4 and 6 of rows 1 and 3. Rows
+ * are blended pairwise so that each involved word keeps its lane,
+ * then the four L operands are gathered into 128-bit registers.
+ */
+#define ROUND_BIG_Y(rc, alpha)   do { \
+		__m256i y01, z01, y23, z23, ac, bd; \
+		__m128i xa, xb, xc, xd; \
+		r0 = _mm256_xor_si256(r0, _mm256_xor_si256(YLD(alpha), \
+			_mm256_setr_epi32(0, (rc), 0, 0, 0, 0, 0, 0))); \
+		r1 = _mm256_xor_si256(r1, YLD((alpha) + 0x08)); \
+		r2 = _mm256_xor_si256(r2, YLD((alpha) + 0x10)); \
+		r3 = _mm256_xor_si256(r3, YLD((alpha) + 0x18)); \
+		SBOX_Y(r0, r1, r2, r3); \
+		r1 = YPERM(r1, 1, 2, 3, 4, 5, 6, 7, 0); \
+		r2 = YPERM(r2, 2, 3, 4, 5, 6, 7, 0, 1); \
+		r3 = YPERM(r3, 3, 4, 5, 6, 7, 0, 1, 2); \
+		L_Y(r0, r1, r2, r3); \
+		r1 = YPERM(r1, 7, 0, 1, 2, 3, 4, 5, 6); \
+		r2 = YPERM(r2, 6, 7, 0, 1, 2, 3, 4, 5); \
+		r3 = YPERM(r3, 5, 6, 7, 0, 1, 2, 3, 4); \
+		y01 = _mm256_blend_epi32(r0, r1, 0x5A); \
+		z01 = _mm256_blend_epi32(r1, r0, 0x5A); \
+		y23 = _mm256_blend_epi32(r2, r3, 0x96); \
+		z23 = _mm256_blend_epi32(r3, r2, 0x96); \
+		y01 = YPERM(y01, 0, 1, 2, 3, 5, 4, 7, 6); \
+		y23 = YPERM(y23, 0, 1, 3, 2, 5, 4, 6, 7); \
+		ac = _mm256_unpacklo_epi64(y01, y23); \
+		bd = _mm256_unpackhi_epi64(y01, y23); \
+		xa = _mm256_castsi256_si128(ac); \
+		xb = _mm256_castsi256_si128(bd); \
+		xc = _mm256_extracti128_si256(ac, 1); \
+		xd = _mm256_extracti128_si256(bd, 1); \
+		L_X(xa, xb, xc, xd); \
+		ac = _mm256_inserti128_si256(_mm256_castsi128_si256(xa), xc, 1); \
+		bd = _mm256_inserti128_si256(_mm256_castsi128_si256(xb), xd, 1); \
+		y01 = _mm256_unpacklo_epi64(ac, bd); \
+		y23 = _mm256_unpackhi_epi64(ac, bd); \
+		y01 = YPERM(y01, 0, 1, 2, 3, 5, 4, 7, 6); \
+		y23 = YPERM(y23, 0, 1, 3, 2, 5, 4, 6, 7); \
+		r0 = _mm256_blend_epi32(y01, z01, 0x5A); \
+		r1 = _mm256_blend_epi32(z01, y01, 0x5A); \
+		r2 = _mm256_blend_epi32(y23, z23, 0x96); \
+		r3 = _mm256_blend_epi32(z23, y23, 0x96); \
+	} while (0)
+
+/*
+ * One step of the expansion: the sign bit of w selects the generator
+ * row k. EXPAND8_* handle rows k+7 down to k.
+ */
+#define EXPAND_SMALL_X(k)   do { \
+		t = _mm_srai_epi32(w, 31); \
+		w = _mm_slli_epi32(w, 1); \
+		m0 = _mm_xor_si128(m0, _mm_and_si128(t, XLD(T256[k]))); \
+		m1 = _mm_xor_si128(m1, _mm_and_si128(t, XLD(T256[k] + 4))); \
+	} while (0)
+
+#define EXPAND_SMALL_Y(k)   do { \
+		yt = _mm256_srai_epi32(yw, 31); \
+		yw = _mm256_slli_epi32(yw, 1); \
+		ym = _mm256_xor_si256(ym, _mm256_and_si256(yt, YLD(T256[k]))); \
+	} while (0)
+
+#define EXPAND_BIG_Y(k)   do { \
+		t = _mm256_srai_epi32(w, 31); \
+		w = _mm256_slli_epi32(w, 1); \
+		m0 = _mm256_xor_si256(m0, _mm256_and_si256(t, YLD(T512[k]))); \
+		m1 = _mm256_xor_si256(m1, \
+			_mm256_and_si256(t, YLD(T512[k] + 8))); \
+	} while (0)
+
+#define EXPAND8(e, k)   do { \
+		e((k) + 7); \
+		e((k) + 6); \
+		e((k) + 5); \
+		e((k) + 4); \
+		e((k) + 3); \
+		e((k) + 2); \
+		e((k) + 1); \
+		e((k) + 0); \
+	} while (0)
+
+#define EXPAND8_SMALL_X(k)   EXPAND8(EXPAND_SMALL_X, k)
+#define EXPAND8_SMALL_Y(k)   EXPAND8(EXPAND_SMALL_Y, k)
+#define EXPAND8_BIG_Y(k)     EXPAND8(EXPAND_BIG_Y, k)
+
+/*
+ * Expansion of the message word at p into m0 and m1, with 128-bit
+ * registers only, or with a 256-bit register.
+ */
+#define INPUT_SMALL_X(p)   do { \
+		__m128i w; \
+ \
+		w = _mm_set1_epi32((int)sph_dec32le(p)); \
+		m0 = _mm_setzero_si128(); \
+		m1 = _mm_setzero_si128(); \
+		EXPAND8_SMALL_X(24); \
+		EXPAND8_SMALL_X(16); \
+		EXPAND8_SMALL_X(8); \
+		EXPAND8_SMALL_X(0); \
+	} while (0)
+
+#define INPUT_SMALL_Y(p)   do { \
+		__m256i yw, yt, ym; \
+ \
+		yw = _mm256_set1_epi32((int)sph_dec32le(p)); \
+		ym = _mm256_setzero_si256(); \
+		EXPAND8_SMALL_Y(24); \
+		EXPAND8_SMALL_Y(16); \
+		EXPAND8_SMALL_Y(8); \
+		EXPAND8_SMALL_Y(0); \
+		m0 = _mm256_castsi256_si128(ym); \
+		m1 = _mm256_extracti128_si256(ym, 1); \
+	} while (0)
+
+/*
+ * In the message registers, words are in the natural order; they are
+ * interleaved with the chaining value words to make the rows:
+ *   Hamsi-224/256:  (m0 m1 c0 c1) (c2 c3 m2 m3) (m4 m5 c4 c5) ...
+ *   Hamsi-384/512:  (m0 m1 c0 c1 m2 m3 c2 c3) (c4 c5 m4 m5 c6 c7 m6 m7) ...
+ * The bits of each 32-bit input word are consumed from the top (row
+ * 31) down; bit 8*u+v of the little-endian word is bit v of byte u,
+ * which selects row 8*u+v.
+ */
+#define DECL_HAMSI_SMALL_RUN(name, target, INPUT) \
+SPH_TARGET(target) static void \
+name(sph_u32 *h, const unsigned char *buf, size_t num, int fin) \
+{ \
+	__m128i h0, h1, r0, r1, r2, r3, m0, m1, t; \
+	int k; \
+ \
+	h0 = XLD(h); \
+	h1 = XLD(h + 4); \
+	while (num -- > 0) { \
+		INPUT(buf); \
+		r0 = _mm_unpacklo_epi64(m0, h0); \
+		r1 = _mm_unpackhi_epi64(h0, m0); \
+		r2 = _mm_unpacklo_epi64(m1, h1); \
+		r3 = _mm_unpackhi_epi64(h1, m1); \
+		if (fin) { \
+			for (k = 0; k < 6; k ++) \
+				ROUND_SMALL_X(k, alpha_f); \
+		} else { \
+			ROUND_SMALL_X(0, alpha_n); \
+			ROUND_SMALL_X(1, alpha_n); \
+			ROUND_SMALL_X(2, alpha_n); \
+		} \
+		h0 = _mm_xor_si128(h0, r0); \
+		h1 = _mm_xor_si128(h1, r2); \
+		buf += 4; \
+	} \
+	_mm_storeu_si128((__m128i *)h, h0); \
+	_mm_storeu_si128((__m128i *)(h + 4), h1); \
+}
+
+#define DECL_HAMSI_BIG_RUN(name, target) \
+SPH_TARGET(target) static void \
+name(sph_u32 *h, const unsigned char *buf, size_t num, int fin) \
+{ \
+	__m256i h0, h1, r0, r1, r2, r3, m0, m1, w, t; \
+	int k; \
+ \
+	h0 = YLD(h); \
+	h1 = YLD(h + 8); \
+	while (num -- > 0) { \
+		m0 = _mm256_setzero_si256(); \
+		m1 = _mm256_setzero_si256(); \
+		w = _mm256_set1_epi32((int)sph_dec32le(buf)); \
+		EXPAND8_BIG_Y(24); \
+		EXPAND8_BIG_Y(16); \
+		EXPAND8_BIG_Y(8); \
+		EXPAND8_BIG_Y(0); \
+		w = _mm256_set1_epi32((int)sph_dec32le(buf + 4)); \
+		EXPAND8_BIG_Y(56); \
+		EXPAND8_BIG_Y(48); \
+		EXPAND8_BIG_Y(40); \
+		EXPAND8_BIG_Y(32); \
+		w = _mm256_permute4x64_epi64(m0, 0xD8); \
+		t = _mm256_permute4x64_epi64(h0, 0xD8); \
+		r0 = _mm256_unpacklo_epi64(w, t); \
+		r1 = _mm256_unpackhi_epi64(t, w); \
+		w = _mm256_permute4x64_epi64(m1, 0xD8); \
+		t = _mm256_permute4x64_epi64(h1, 0xD8); \
+		r2 = _mm256_unpacklo_epi64(w, t); \
+		r3 = _mm256_unpackhi_epi64(t, w); \
+		if (fin) { \
+			for (k = 0; k < 12; k ++) \
+				ROUND_BIG_Y(k, alpha_f); \
+		} else { \
+			ROUND_BIG_Y(0, alpha_n); \
+			ROUND_BIG_Y(1, alpha_n); \
+			ROUND_BIG_Y(2, alpha_n); \
+			ROUND_BIG_Y(3, alpha_n); \
+			ROUND_BIG_Y(4, alpha_n); \
+			ROUND_BIG_Y(5, alpha_n); \
+		} \
+		h0 = _mm256_xor_si256(h0, r0); \
+		h1 = _mm256_xor_si256(h1, r2); \
+		buf += 8; \
+	} \
+	_mm256_storeu_si256((__m256i *)h, h0); \
+	_mm256_storeu_si256((__m256i *)(h + 8), h1); \
+}
+
+#define XROL(x, n)   _mm_or_si128(_mm_slli_epi32(x, n), \
+                     _mm_srli_epi32(x, 32 - (n)))
+#define YROL(x, n)   _mm256_or_si256(_mm256_slli_epi32(x, n), \
+                     _mm256_srli_epi32(x, 32 - (n)))
+
+DECL_HAMSI_SMALL_RUN(hamsi_small_run_sse2, "sse2", INPUT_SMALL_X)
+DECL_HAMSI_SMALL_RUN(hamsi_small_run_avx2, "avx2", INPUT_SMALL_Y)
+DECL_HAMSI_BIG_RUN(hamsi_big_run_avx2, "avx2")
+
+#undef XROL
+#undef YROL
+
+#if SPH_X86_AVX512
+
+#define HAMSI_AVX512   "avx2,avx512f,avx512vl"
+
+#define XROL(x, n)   _mm_rol_epi32(x, n)
+#define YROL(x, n)   _mm256_rol_epi32(x, n)
+
+DECL_HAMSI_SMALL_RUN(hamsi_small_run_avx512, HAMSI_AVX512, \
+	INPUT_SMALL_Y)
+DECL_HAMSI_BIG_RUN(hamsi_big_run_avx512, HAMSI_AVX512)
+
+#undef XROL
+#undef YROL
+
+#endif
+
+/*
+ * Get the single-message kernels, or 0 if the portable code must be
+ * used.
+ */
+static hamsi_run_fn
+hamsi_small_select(void)
+{
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512)
+		return hamsi_small_run_avx512;
+#endif
+	if (f & SPH_CPU_AVX2)
+		return hamsi_small_run_avx2;
+	if (f & SPH_CPU_SSE2)
+		return hamsi_small_run_sse2;
+	return 0;
+}
+
+static hamsi_run_fn
+hamsi_big_select(void)
+{
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512)
+		return hamsi_big_run_avx512;
+#endif
+	if (f & SPH_CPU_AVX2)
+		return hamsi_big_run_avx2;
+	return 0;
+}
+
+#endif
+
 #define DECL_STATE_SMALL \
 	sph_u32 c0, c1, c2, c3, c4, c5, c6, c7;
 
@@ -319,6 +700,9 @@ hamsi_small(sph_hamsi_small_context *sc, const unsigned char *buf, size_t num)
 #if !SPH_64
 	sph_u32 tmp;
 #endif
+#if SPH_X86_SIMD
+	hamsi_run_fn run;
+#endif
 
 #if SPH_64
 	sc->count += (sph_u64)num << 5;
@@ -328,6 +712,14 @@ hamsi_small(sph_hamsi_small_context *sc, const unsigned char *buf, size_t num)
 	sc->count_high += (sph_u32)((num >> 13) >> 14);
 	if (sc->count_low < tmp)
 		sc->count_high ++;
+#endif
+	SPH_STATS_BLOCKS(SPH_STATS_HAMSI, num);
+#if SPH_X86_SIMD
+	run = hamsi_small_select();
+	if (run != 0) {
+		run(sc->h, buf, num, 0);
+		return;
+	}
 #endif
 	READ_STATE_SMALL(sc);
 	while (num -- > 0) {
@@ -347,6 +739,15 @@ hamsi_small_final(sph_hamsi_small_context *sc, const unsigned char *buf)
 	sph_u32 m0, m1, m2, m3, m4, m5, m6, m7;
 	DECL_STATE_SMALL
 
+#if SPH_X86_SIMD
+	hamsi_run_fn run;
+
+	run = hamsi_small_select();
+	if (run != 0) {
+		run(sc->h, buf, 1, 1);
+		return;
+	}
+#endif
 	READ_STATE_SMALL(sc);
 	INPUT_SMALL;
 	PF_SMALL;
@@ -416,6 +817,7 @@ hamsi_small_close(sph_hamsi_small_context *sc,
 		pad[ptr ++] = 0;
 	hamsi_small(sc, pad, 2);
 	hamsi_small_final(sc, pad + 8);
+	SPH_STATS_BLOCKS(SPH_STATS_HAMSI, 1);
 	out = dst;
 	for (u = 0; u < out_size_w32; u ++)
 		sph_enc32be(out + (u << 2), sc->h[u]);
@@ -620,6 +1022,9 @@ hamsi_big(sph_hamsi_big_context *sc, const unsigned char *buf, size_t num)
 #if !SPH_64
 	sph_u32 tmp;
 #endif
+#if SPH_X86_SIMD
+	hamsi_run_fn run;
+#endif
 
 #if SPH_64
 	sc->count += (sph_u64)num << 6;
@@ -629,6 +1034,14 @@ hamsi_big(sph_hamsi_big_context *sc, const unsigned char *buf, size_t num)
 	sc->count_high += (sph_u32)((num >> 13) >> 13);
 	if (sc->count_low < tmp)
 		sc->count_high ++;
+#endif
+	SPH_STATS_BLOCKS(SPH_STATS_HAMSI, num);
+#if SPH_X86_SIMD
+	run = hamsi_big_select();
+	if (run != 0) {
+		run(sc->h, buf, num, 0);
+		return;
+	}
 #endif
 	READ_STATE_BIG(sc);
 	while (num -- > 0) {
@@ -650,6 +1063,15 @@ hamsi_big_final(sph_hamsi_big_context *sc, const unsigned char *buf)
 	sph_u32 m8, m9, mA, mB, mC, mD, mE, mF;
 	DECL_STATE_BIG
 
+#if SPH_X86_SIMD
+	hamsi_run_fn run;
+
+	run = hamsi_big_select();
+	if (run != 0) {
+		run(sc->h, buf, 1, 1);
+		return;
+	}
+#endif
 	READ_STATE_BIG(sc);
 	INPUT_BIG;
 	PF_BIG;
@@ -696,14 +1118,39 @@ hamsi_big_core(sph_hamsi_big_context *sc, const void *data, size_t len)
 	sc->partial_len = len;
 }
 
+static void
+hamsi_big_out(const sph_u32 *h, void *dst, size_t out_size_w32)
+{
+	unsigned char *out;
+	size_t u;
+
+	out = dst;
+	if (out_size_w32 == 12) {
+		sph_enc32be(out +  0, h[ 0]);
+		sph_enc32be(out +  4, h[ 1]);
+		sph_enc32be(out +  8, h[ 3]);
+		sph_enc32be(out + 12, h[ 4]);
+		sph_enc32be(out + 16, h[ 5]);
+		sph_enc32be(out + 20, h[ 6]);
+		sph_enc32be(out + 24, h[ 8]);
+		sph_enc32be(out + 28, h[ 9]);
+		sph_enc32be(out + 32, h[10]);
+		sph_enc32be(out + 36, h[12]);
+		sph_enc32be(out + 40, h[13]);
+		sph_enc32be(out + 44, h[15]);
+	} else {
+		for (u = 0; u < 16; u ++)
+			sph_enc32be(out + (u << 2), h[u]);
+	}
+}
+
 static void
 hamsi_big_close(sph_hamsi_big_context *sc,
 	unsigned ub, unsigned n, void *dst, size_t out_size_w32)
 {
 	unsigned char pad[8];
-	size_t ptr, u;
+	size_t ptr;
 	unsigned z;
-	unsigned char *out;
 
 	ptr = sc->partial_len;
 #if SPH_64
@@ -718,23 +1165,453 @@ hamsi_big_close(sph_hamsi_big_context *sc,
 		sc->partial[ptr ++] = 0;
 	hamsi_big(sc, sc->partial, 1);
 	hamsi_big_final(sc, pad);
-	out = dst;
-	if (out_size_w32 == 12) {
-		sph_enc32be(out +  0, sc->h[ 0]);
-		sph_enc32be(out +  4, sc->h[ 1]);
-		sph_enc32be(out +  8, sc->h[ 3]);
-		sph_enc32be(out + 12, sc->h[ 4]);
-		sph_enc32be(out + 16, sc->h[ 5]);
-		sph_enc32be(out + 20, sc->h[ 6]);
-		sph_enc32be(out + 24, sc->h[ 8]);
-		sph_enc32be(out + 28, sc->h[ 9]);
-		sph_enc32be(out + 32, sc->h[10]);
-		sph_enc32be(out + 36, sc->h[12]);
-		sph_enc32be(out + 40, sc->h[13]);
-		sph_enc32be(out + 44, sc->h[15]);
+	SPH_STATS_BLOCKS(SPH_STATS_HAMSI, 1);
+	hamsi_big_out(sc->h, dst, out_size_w32);
+}
+
+/*
+ * Multi-message Hamsi: several independent messages are hashed in
+ * parallel, one per vector lane. The round macros only apply C
+ * operators, so with the GCC vector extensions they operate on vectors
+ * of lanes unchanged; only SBOX must be redefined, so that its
+ * temporary has the vector type. The expansion is the same as in the
+ * single-message vector code, except that each lane has its own masks.
+ *
+ * A "run" function loads the lane states from hs[], processes nb
+ * blocks per lane (block i of lane l is at p[l] + i * block_size),
+ * with the final permutation if fin is non-zero, and stores back the
+ * states. The generic driver takes care of grouping messages, building
+ * the padding blocks and completing ragged lanes with the scalar code.
+ */
+
+#if SPH_X86_SIMD
+
+#define VAND(x, y)   ((x) & (y))
+#define VOR(x, y)    ((x) | (y))
+#define VXOR(x, y)   ((x) ^ (y))
+#define VNOT(x)      (~(x))
+
+#undef SBOX
+#define SBOX(a, b, c, d)   SBOX_V(a, b, c, d, VAND, VOR, VXOR, VNOT)
+
+/*
+ * The expansion loops are deliberately not unrolled: each generator
+ * word is then broadcast from memory, instead of being rebuilt from an
+ * immediate value.
+ */
+#define VEXPAND_SMALL(rows)   do { \
+		const sph_u32 *g; \
+		int k; \
+ \
+		for (k = 31; k >= 0; k --) { \
+			g = (rows)[k]; \
+			t = z - (w >> 31); \
+			w <<= 1; \
+			m0 ^= t & g[0]; \
+			m1 ^= t & g[1]; \
+			m2 ^= t & g[2]; \
+			m3 ^= t & g[3]; \
+			m4 ^= t & g[4]; \
+			m5 ^= t & g[5]; \
+			m6 ^= t & g[6]; \
+			m7 ^= t & g[7]; \
+		} \
+	} while (0)
+
+#define VEXPAND_BIG(rows)   do { \
+		const sph_u32 *g; \
+		int k; \
+ \
+		for (k = 31; k >= 0; k --) { \
+			g = (rows)[k]; \
+			t = z - (w >> 31); \
+			w <<= 1; \
+			m0 ^= t & g[0x0]; \
+			m1 ^= t & g[0x1]; \
+			m2 ^= t & g[0x2]; \
+			m3 ^= t & g[0x3]; \
+			m4 ^= t & g[0x4]; \
+			m5 ^= t & g[0x5]; \
+			m6 ^= t & g[0x6]; \
+			m7 ^= t & g[0x7]; \
+			m8 ^= t & g[0x8]; \
+			m9 ^= t & g[0x9]; \
+			mA ^= t & g[0xA]; \
+			mB ^= t & g[0xB]; \
+			mC ^= t & g[0xC]; \
+			mD ^= t & g[0xD]; \
+			mE ^= t & g[0xE]; \
+			mF ^= t & g[0xF]; \
+		} \
+	} while (0)
+
+#define DECL_HAMSI_SMALL_LANES(lanes, vtype, target) \
+SPH_TARGET(target) static void \
+hamsi_small_run_x ## lanes(const unsigned char *const *p, size_t nb, \
+	sph_u32 (*hs)[8], int fin) \
+{ \
+	vtype c0, c1, c2, c3, c4, c5, c6, c7; \
+	vtype m0, m1, m2, m3, m4, m5, m6, m7; \
+	vtype h[8], w, t, z = { 0 }; \
+	size_t off; \
+	unsigned u, l; \
+ \
+	for (u = 0; u < 8; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			h[u][l] = hs[l][u]; \
+	for (off = 0; nb -- > 0; off += 4) { \
+		for (l = 0; l < lanes; l ++) \
+			w[l] = sph_dec32le(p[l] + off); \
+		m0 = m1 = m2 = m3 = m4 = m5 = m6 = m7 = z; \
+		VEXPAND_SMALL(T256); \
+		c0 = h[0]; \
+		c1 = h[1]; \
+		c2 = h[2]; \
+		c3 = h[3]; \
+		c4 = h[4]; \
+		c5 = h[5]; \
+		c6 = h[6]; \
+		c7 = h[7]; \
+		if (fin) \
+			PF_SMALL; \
+		else \
+			P_SMALL; \
+		h[0] ^= s0; \
+		h[1] ^= s1; \
+		h[2] ^= s2; \
+		h[3] ^= s3; \
+		h[4] ^= s8; \
+		h[5] ^= s9; \
+		h[6] ^= sA; \
+		h[7] ^= sB; \
+	} \
+	for (u = 0; u < 8; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			hs[l][u] = h[u][l]; \
+}
+
+#define DECL_HAMSI_BIG_LANES(lanes, vtype, target) \
+SPH_TARGET(target) static void \
+hamsi_big_run_x ## lanes(const unsigned char *const *p, size_t nb, \
+	sph_u32 (*hs)[16], int fin) \
+{ \
+	vtype c0, c1, c2, c3, c4, c5, c6, c7; \
+	vtype c8, c9, cA, cB, cC, cD, cE, cF; \
+	vtype m0, m1, m2, m3, m4, m5, m6, m7; \
+	vtype m8, m9, mA, mB, mC, mD, mE, mF; \
+	vtype h[16], w, t, z = { 0 }; \
+	size_t off; \
+	unsigned u, l; \
+ \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			h[u][l] = hs[l][u]; \
+	for (off = 0; nb -- > 0; off += 8) { \
+		m0 = m1 = m2 = m3 = m4 = m5 = m6 = m7 = z; \
+		m8 = m9 = mA = mB = mC = mD = mE = mF = z; \
+		for (l = 0; l < lanes; l ++) \
+			w[l] = sph_dec32le(p[l] + off); \
+		VEXPAND_BIG(T512); \
+		for (l = 0; l < lanes; l ++) \
+			w[l] = sph_dec32le(p[l] + off + 4); \
+		VEXPAND_BIG(T512 + 32); \
+		c0 = h[0x0]; \
+		c1 = h[0x1]; \
+		c2 = h[0x2]; \
+		c3 = h[0x3]; \
+		c4 = h[0x4]; \
+		c5 = h[0x5]; \
+		c6 = h[0x6]; \
+		c7 = h[0x7]; \
+		c8 = h[0x8]; \
+		c9 = h[0x9]; \
+		cA = h[0xA]; \
+		cB = h[0xB]; \
+		cC = h[0xC]; \
+		cD = h[0xD]; \
+		cE = h[0xE]; \
+		cF = h[0xF]; \
+		if (fin) \
+			PF_BIG; \
+		else \
+			P_BIG; \
+		h[0x0] ^= s00; \
+		h[0x1] ^= s01; \
+		h[0x2] ^= s02; \
+		h[0x3] ^= s03; \
+		h[0x4] ^= s04; \
+		h[0x5] ^= s05; \
+		h[0x6] ^= s06; \
+		h[0x7] ^= s07; \
+		h[0x8] ^= s10; \
+		h[0x9] ^= s11; \
+		h[0xA] ^= s12; \
+		h[0xB] ^= s13; \
+		h[0xC] ^= s14; \
+		h[0xD] ^= s15; \
+		h[0xE] ^= s16; \
+		h[0xF] ^= s17; \
+	} \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			hs[l][u] = h[u][l]; \
+}
+
+DECL_HAMSI_SMALL_LANES(4, sph_v32x4, "sse2")
+DECL_HAMSI_SMALL_LANES(8, sph_v32x8, "avx2")
+DECL_HAMSI_BIG_LANES(4, sph_v32x4, "sse2")
+DECL_HAMSI_BIG_LANES(8, sph_v32x8, "avx2")
+
+#if SPH_X86_AVX512
+DECL_HAMSI_SMALL_LANES(16, sph_v32x16, HAMSI_AVX512 ",avx512f")
+DECL_HAMSI_BIG_LANES(16, sph_v32x16, HAMSI_AVX512 ",avx512f")
+#endif
+
+#define MULTI_MAX_LANES   16
+
+/*
+ * Build the padding for a message of 'len' bytes whose last 'rem'
+ * bytes (less than a block of 'bs' bytes) are at 'src': one block with
+ * the final bits, then the 64-bit length (big-endian).
+ */
+static void
+hamsi_pad(unsigned char *dst, const unsigned char *src, size_t rem,
+	size_t len, size_t bs)
+{
+	memcpy(dst, src, rem);
+	dst[rem] = 0x80;
+	memset(dst + rem + 1, 0, bs - 1 - rem);
+	sph_enc32be(dst + bs, (sph_u32)(len >> 29));
+	sph_enc32be(dst + bs + 4, SPH_T32((sph_u32)len << 3));
+}
+
+#endif
+
+static void
+hamsi_small_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, const sph_u32 *iv, size_t out_size_w32)
+{
+	size_t lanes, k;
+#if SPH_X86_SIMD
+	void (*run)(const unsigned char *const *p, size_t nb,
+		sph_u32 (*hs)[8], int fin);
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		run = hamsi_small_run_x16;
+		lanes = 16;
+	} else
+#endif
+	if (f & SPH_CPU_AVX2) {
+		run = hamsi_small_run_x8;
+		lanes = 8;
+	} else if (f & SPH_CPU_SSE2) {
+		run = hamsi_small_run_x4;
+		lanes = 4;
 	} else {
-		for (u = 0; u < 16; u ++)
-			sph_enc32be(out + (u << 2), sc->h[u]);
+		run = 0;
+		lanes = 1;
+	}
+#else
+	lanes = 1;
+#endif
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_HAMSI, len[k]);
+	while (num > 0) {
+		size_t n, u;
+
+		n = num < lanes ? num : lanes;
+#if SPH_X86_SIMD
+		if (n > 1) {
+			const unsigned char *p[MULTI_MAX_LANES];
+			sph_u32 hs[MULTI_MAX_LANES][8];
+			unsigned char tail[MULTI_MAX_LANES][12];
+			size_t nb, v;
+			int same;
+
+			nb = len[0] >> 2;
+			same = 1;
+			for (u = 1; u < n; u ++) {
+				if ((len[u] >> 2) < nb)
+					nb = len[u] >> 2;
+				if (len[u] != len[0])
+					same = 0;
+			}
+			for (u = 0; u < lanes; u ++) {
+				p[u] = data[u < n ? u : 0];
+				memcpy(hs[u], iv, sizeof hs[u]);
+			}
+			run(p, nb, hs, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_HAMSI, nb * n);
+			if (same) {
+				for (u = 0; u < lanes; u ++) {
+					hamsi_pad(tail[u], p[u] + (nb << 2),
+						len[0] & 3, len[0], 4);
+					p[u] = tail[u];
+				}
+				run(p, 2, hs, 0);
+				SPH_STATS_BLOCKS(SPH_STATS_HAMSI, 2 * n);
+				for (u = 0; u < lanes; u ++)
+					p[u] += 8;
+				run(p, 1, hs, 1);
+				SPH_STATS_BLOCKS(SPH_STATS_HAMSI, n);
+				for (u = 0; u < n; u ++) {
+					unsigned char *out;
+
+					out = dst[u];
+					for (v = 0; v < out_size_w32; v ++)
+						sph_enc32be(out + (v << 2),
+							hs[u][v]);
+				}
+			} else {
+				for (u = 0; u < n; u ++) {
+					sph_hamsi_small_context sc;
+
+					hamsi_small_init(&sc, hs[u]);
+#if SPH_64
+					sc.count = (sph_u64)nb << 5;
+#else
+					sc.count_low =
+						SPH_T32((sph_u32)nb << 5);
+					sc.count_high = (sph_u32)(nb >> 27);
+#endif
+					hamsi_small_core(&sc, p[u] + (nb << 2),
+						len[u] - (nb << 2));
+					hamsi_small_close(&sc, 0, 0,
+						dst[u], out_size_w32);
+				}
+			}
+			data += n;
+			len += n;
+			dst += n;
+			num -= n;
+			continue;
+		}
+#endif
+		for (u = 0; u < n; u ++) {
+			sph_hamsi_small_context sc;
+
+			hamsi_small_init(&sc, iv);
+			hamsi_small_core(&sc, data[u], len[u]);
+			hamsi_small_close(&sc, 0, 0, dst[u], out_size_w32);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+}
+
+static void
+hamsi_big_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, const sph_u32 *iv, size_t out_size_w32)
+{
+	size_t lanes, k;
+#if SPH_X86_SIMD
+	void (*run)(const unsigned char *const *p, size_t nb,
+		sph_u32 (*hs)[16], int fin);
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		run = hamsi_big_run_x16;
+		lanes = 16;
+	} else
+#endif
+	if (f & SPH_CPU_AVX2) {
+		run = hamsi_big_run_x8;
+		lanes = 8;
+	} else if (f & SPH_CPU_SSE2) {
+		run = hamsi_big_run_x4;
+		lanes = 4;
+	} else {
+		run = 0;
+		lanes = 1;
+	}
+#else
+	lanes = 1;
+#endif
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_HAMSI, len[k]);
+	while (num > 0) {
+		size_t n, u;
+
+		n = num < lanes ? num : lanes;
+#if SPH_X86_SIMD
+		if (n > 1) {
+			const unsigned char *p[MULTI_MAX_LANES];
+			sph_u32 hs[MULTI_MAX_LANES][16];
+			unsigned char tail[MULTI_MAX_LANES][16];
+			size_t nb;
+			int same;
+
+			nb = len[0] >> 3;
+			same = 1;
+			for (u = 1; u < n; u ++) {
+				if ((len[u] >> 3) < nb)
+					nb = len[u] >> 3;
+				if (len[u] != len[0])
+					same = 0;
+			}
+			for (u = 0; u < lanes; u ++) {
+				p[u] = data[u < n ? u : 0];
+				memcpy(hs[u], iv, sizeof hs[u]);
+			}
+			run(p, nb, hs, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_HAMSI, nb * n);
+			if (same) {
+				for (u = 0; u < lanes; u ++) {
+					hamsi_pad(tail[u], p[u] + (nb << 3),
+						len[0] & 7, len[0], 8);
+					p[u] = tail[u];
+				}
+				run(p, 1, hs, 0);
+				SPH_STATS_BLOCKS(SPH_STATS_HAMSI, n);
+				for (u = 0; u < lanes; u ++)
+					p[u] += 8;
+				run(p, 1, hs, 1);
+				SPH_STATS_BLOCKS(SPH_STATS_HAMSI, n);
+				for (u = 0; u < n; u ++)
+					hamsi_big_out(hs[u], dst[u], out_size_w32);
+			} else {
+				for (u = 0; u < n; u ++) {
+					sph_hamsi_big_context sc;
+
+					hamsi_big_init(&sc, hs[u]);
+#if SPH_64
+					sc.count = (sph_u64)nb << 6;
+#else
+					sc.count_low =
+						SPH_T32((sph_u32)nb << 6);
+					sc.count_high = (sph_u32)(nb >> 26);
+#endif
+					hamsi_big_core(&sc, p[u] + (nb << 3),
+						len[u] - (nb << 3));
+					hamsi_big_close(&sc, 0, 0,
+						dst[u], out_size_w32);
+				}
+			}
+			data += n;
+			len += n;
+			dst += n;
+			num -= n;
+			continue;
+		}
+#endif
+		for (u = 0; u < n; u ++) {
+			sph_hamsi_big_context sc;
+
+			hamsi_big_init(&sc, iv);
+			hamsi_big_core(&sc, data[u], len[u]);
+			hamsi_big_close(&sc, 0, 0, dst[u], out_size_w32);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
 	}
 }
 
@@ -749,9 +1626,17 @@ sph_hamsi224_init(void *cc)
 void
 sph_hamsi224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_HAMSI, len);
 	hamsi_small_core(cc, data, len);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_hamsi224, cc, iov, n);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi224_close(void *cc, void *dst)
@@ -760,6 +1645,13 @@ sph_hamsi224_close(void *cc, void *dst)
 	hamsi_small_init(cc, IV224);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(hamsi224, data, len, dst);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -768,6 +1660,14 @@ sph_hamsi224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	hamsi_small_init(cc, IV224);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	hamsi_small_multi(data, len, dst, num, IV224, 7);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi256_init(void *cc)
@@ -779,9 +1679,17 @@ sph_hamsi256_init(void *cc)
 void
 sph_hamsi256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_HAMSI, len);
 	hamsi_small_core(cc, data, len);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_hamsi256, cc, iov, n);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi256_close(void *cc, void *dst)
@@ -790,6 +1698,13 @@ sph_hamsi256_close(void *cc, void *dst)
 	hamsi_small_init(cc, IV256);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(hamsi256, data, len, dst);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -798,6 +1713,14 @@ sph_hamsi256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	hamsi_small_init(cc, IV256);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	hamsi_small_multi(data, len, dst, num, IV256, 8);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi384_init(void *cc)
@@ -809,9 +1732,17 @@ sph_hamsi384_init(void *cc)
 void
 sph_hamsi384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_HAMSI, len);
 	hamsi_big_core(cc, data, len);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_hamsi384, cc, iov, n);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi384_close(void *cc, void *dst)
@@ -820,6 +1751,13 @@ sph_hamsi384_close(void *cc, void *dst)
 	hamsi_big_init(cc, IV384);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(hamsi384, data, len, dst);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -828,6 +1766,14 @@ sph_hamsi384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	hamsi_big_init(cc, IV384);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	hamsi_big_multi(data, len, dst, num, IV384, 12);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi512_init(void *cc)
@@ -839,9 +1785,17 @@ sph_hamsi512_init(void *cc)
 void
 sph_hamsi512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_HAMSI, len);
 	hamsi_big_core(cc, data, len);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_hamsi512, cc, iov, n);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi512_close(void *cc, void *dst)
@@ -850,6 +1804,13 @@ sph_hamsi512_close(void *cc, void *dst)
 	hamsi_big_init(cc, IV512);
 }
 
+/* see sph_hamsi.h */
+void
+sph_hamsi512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(hamsi512, data, len, dst);
+}
+
 /* see sph_hamsi.h */
 void
 sph_hamsi512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -857,3 +1818,11 @@ sph_hamsi512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	hamsi_big_close(cc, ub, n, dst, 16);
 	hamsi_big_init(cc, IV512);
 }
+
+/* see sph_hamsi.h */
+void
+sph_hamsi512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	hamsi_big_multi(data, len, dst, num, IV512, 16);
+}
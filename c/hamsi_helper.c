@@ -4,6 +4,10 @@
  * automatically generated and includes precomputed tables for
  * expansion code which handles 2 to 8 bits at a time.
  *
+ * The one-bit tables (T256 and T512, which are the rows of the generator
+ * matrices of the linear codes) are also compiled in when hamsi.c
+ * defines HAMSI_GENERATOR_ROWS, since the vector code uses them.
+ *
  * This file is included from hamsi.c, and is not meant to be compiled
  * independently.
  *
@@ -35,7 +39,7 @@
  * @author   Thomas Pornin <thomas.pornin@cryptolog.com>
  */
 
-#if SPH_HAMSI_EXPAND_SMALL == 1
+#if SPH_HAMSI_EXPAND_SMALL == 1 || HAMSI_GENERATOR_ROWS
 
 /* Note: this table lists bits within each byte from least
    siginificant to most significant. */
@@ -138,6 +142,10 @@ static const sph_u32 T256[32][8] = {
 	  SPH_C32(0x6019107f), SPH_C32(0xe051606e) }
 };
 
+#endif
+
+#if SPH_HAMSI_EXPAND_SMALL == 1
+
 #define INPUT_SMALL   do { \
 		const sph_u32 *tp = &T256[0][0]; \
 		unsigned u, v; \
@@ -7979,7 +7987,7 @@ static const sph_u32 T256_24[256][8] = {
 
 #endif
 
-#if SPH_HAMSI_EXPAND_BIG == 1
+#if SPH_HAMSI_EXPAND_BIG == 1 || HAMSI_GENERATOR_ROWS
 
 /* Note: this table lists bits within each byte from least
    siginificant to most significant. */
@@ -8370,6 +8378,10 @@ static const sph_u32 T512[64][16] = {
 	  SPH_C32(0xe7e00a94) }
 };
 
+#endif
+
+#if SPH_HAMSI_EXPAND_BIG == 1
+
 #define INPUT_BIG   do { \
 		const sph_u32 *tp = &T512[0][0]; \
 		unsigned u, v; \
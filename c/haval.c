@@ -40,6 +40,7 @@
 #include <string.h>
 
 #include "sph_haval.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_HAVAL
 #define SPH_SMALL_FOOTPRINT_HAVAL   1
@@ -884,16 +885,31 @@ sph_haval ## xxx ## _ ## y ## _init(void *cc) \
 void \
 sph_haval ## xxx ## _ ## y (void *cc, const void *data, size_t len) \
 { \
+	SPH_STATS_INPUT(SPH_STATS_HAVAL, len); \
 	haval ## y(cc, data, len); \
 } \
  \
 void \
+sph_haval ## xxx ## _ ## y ## _updatev( \
+	void *cc, const sph_iovec *iov, int n) \
+{ \
+	SPH_UPDATEV(sph_haval ## xxx ## _ ## y, cc, iov, n); \
+} \
+ \
+void \
 sph_haval ## xxx ## _ ## y ## _close(void *cc, void *dst) \
 { \
 	haval ## y ## _close(cc, 0, 0, dst); \
 } \
  \
 void \
+sph_haval ## xxx ## _ ## y ## _oneshot( \
+	const void *data, size_t len, void *dst) \
+{ \
+	SPH_ONESHOT(haval ## xxx ## _ ## y, data, len, dst); \
+} \
+ \
+void \
 sph_haval ## xxx ## _ ## y ## addbits_and_close( \
 	void *cc, unsigned ub, unsigned n, void *dst) \
 { \
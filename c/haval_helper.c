@@ -71,6 +71,7 @@ SPH_XCAT(haval, PASSES)
 
 			RSTATE;
 			SPH_XCAT(CORE, PASSES)(INW);
+			SPH_STATS_BLOCKS(SPH_STATS_HAVAL, 1);
 			WSTATE;
 			current = 0;
 		}
@@ -121,6 +122,7 @@ SPH_XCAT(haval, PASSES)(sph_haval_context *sc, const void *data, size_t len)
 	}
 #endif
 	orig_len = len;
+	SPH_STATS_BLOCKS(SPH_STATS_HAVAL, len >> 7);
 	RSTATE;
 	while (len >= 128U) {
 		IN_PREPARE(data);
@@ -169,6 +171,7 @@ SPH_XCAT(SPH_XCAT(haval, PASSES), _close)(sph_haval_context *sc,
 			IN_PREPARE(sc->buf);
 
 			SPH_XCAT(CORE, PASSES)(INW);
+			SPH_STATS_BLOCKS(SPH_STATS_HAVAL, 1);
 		} while (0);
 		current = 0;
 	}
@@ -186,6 +189,7 @@ SPH_XCAT(SPH_XCAT(haval, PASSES), _close)(sph_haval_context *sc,
 		IN_PREPARE(sc->buf);
 
 		SPH_XCAT(CORE, PASSES)(INW);
+		SPH_STATS_BLOCKS(SPH_STATS_HAVAL, 1);
 	} while (0);
 
 	WSTATE;
@@ -0,0 +1,296 @@
+/* $Id$ */
+/*
+ * HMAC with precomputed key states.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sph_hmac.h"
+
+#if SPH_64
+
+/*
+ * Maximum HMAC block length (ECHO-224/256) and number of lanes of the
+ * multi-message code.
+ */
+#define HMAC_MAX_BLOCK   192
+#define HMAC_MAX_LANES    16
+
+typedef struct {
+	void (*init)(void *cc);
+	void (*update)(void *cc, const void *data, size_t len);
+	void (*close)(void *cc, void *dst);
+	size_t cc_size, block;
+	unsigned (*lanes)(void);
+	void (*blocks)(void *const *cc, const void *const *data,
+		size_t nb, size_t num);
+} hmac_alg;
+
+#define HMAC_ALG(name, block)   HMAC_ALG_MULTI(name, block, 0, 0)
+
+#define HMAC_ALG_MULTI(name, block, lanes, blocks)   { \
+		&sph_ ## name ## _init, &sph_ ## name, \
+		&sph_ ## name ## _close, sizeof(sph_ ## name ## _context), \
+		block, lanes, blocks \
+	}
+
+#define HMAC_ALG_MD(name, block)   HMAC_ALG_MULTI(name, block, \
+		&sph_ ## name ## _multi_lanes, &sph_ ## name ## _blocks_multi)
+
+/*
+ * Implementations, indexed by SPH_HASH_* identifier, with the HMAC
+ * block length (see sph_hmac_block() for the exceptions to the block
+ * length of the compression function).
+ */
+static const hmac_alg hmac_algs[SPH_HASH_NUM] = {
+	HMAC_ALG(md2, 16),
+	HMAC_ALG(md4, 64),
+	HMAC_ALG_MD(md5, 64),
+	HMAC_ALG(panama, 32),
+	HMAC_ALG(radiogatun32, 64),
+	HMAC_ALG(radiogatun64, 64),
+	HMAC_ALG(ripemd, 64),
+	HMAC_ALG(ripemd128, 64),
+	HMAC_ALG_MD(ripemd160, 64),
+	HMAC_ALG(sha0, 64),
+	HMAC_ALG_MD(sha1, 64),
+	HMAC_ALG_MD(sha224, 64),
+	HMAC_ALG_MD(sha256, 64),
+	HMAC_ALG_MD(sha384, 128),
+	HMAC_ALG_MD(sha512, 128),
+	HMAC_ALG(tiger, 64),
+	HMAC_ALG(tiger2, 64),
+	HMAC_ALG(whirlpool, 64),
+	HMAC_ALG(whirlpool0, 64),
+	HMAC_ALG(whirlpool1, 64),
+	HMAC_ALG(gost, 32),
+	HMAC_ALG(gost256, 64),
+	HMAC_ALG(gost512, 64),
+	HMAC_ALG(haval128_3, 128),
+	HMAC_ALG(haval128_4, 128),
+	HMAC_ALG(haval128_5, 128),
+	HMAC_ALG(haval160_3, 128),
+	HMAC_ALG(haval160_4, 128),
+	HMAC_ALG(haval160_5, 128),
+	HMAC_ALG(haval192_3, 128),
+	HMAC_ALG(haval192_4, 128),
+	HMAC_ALG(haval192_5, 128),
+	HMAC_ALG(haval224_3, 128),
+	HMAC_ALG(haval224_4, 128),
+	HMAC_ALG(haval224_5, 128),
+	HMAC_ALG(haval256_3, 128),
+	HMAC_ALG(haval256_4, 128),
+	HMAC_ALG(haval256_5, 128),
+	HMAC_ALG(blake224, 64),
+	HMAC_ALG(blake256, 64),
+	HMAC_ALG(blake384, 128),
+	HMAC_ALG(blake512, 128),
+	HMAC_ALG(bmw224, 64),
+	HMAC_ALG(bmw256, 64),
+	HMAC_ALG(bmw384, 128),
+	HMAC_ALG(bmw512, 128),
+	HMAC_ALG(cubehash224, 64),
+	HMAC_ALG(cubehash256, 64),
+	HMAC_ALG(cubehash384, 64),
+	HMAC_ALG(cubehash512, 64),
+	HMAC_ALG(echo224, 192),
+	HMAC_ALG(echo256, 192),
+	HMAC_ALG(echo384, 128),
+	HMAC_ALG(echo512, 128),
+	HMAC_ALG(fugue224, 64),
+	HMAC_ALG(fugue256, 64),
+	HMAC_ALG(fugue384, 64),
+	HMAC_ALG(fugue512, 64),
+	HMAC_ALG(groestl224, 64),
+	HMAC_ALG(groestl256, 64),
+	HMAC_ALG(groestl384, 128),
+	HMAC_ALG(groestl512, 128),
+	HMAC_ALG(hamsi224, 64),
+	HMAC_ALG(hamsi256, 64),
+	HMAC_ALG(hamsi384, 64),
+	HMAC_ALG(hamsi512, 64),
+	HMAC_ALG(jh224, 64),
+	HMAC_ALG(jh256, 64),
+	HMAC_ALG(jh384, 64),
+	HMAC_ALG(jh512, 64),
+	HMAC_ALG(keccak224, 144),
+	HMAC_ALG(keccak256, 136),
+	HMAC_ALG(keccak384, 104),
+	HMAC_ALG(keccak512, 72),
+	HMAC_ALG(luffa224, 64),
+	HMAC_ALG(luffa256, 64),
+	HMAC_ALG(luffa384, 64),
+	HMAC_ALG(luffa512, 64),
+	HMAC_ALG(shabal192, 64),
+	HMAC_ALG(shabal224, 64),
+	HMAC_ALG(shabal256, 64),
+	HMAC_ALG(shabal384, 64),
+	HMAC_ALG(shabal512, 64),
+	HMAC_ALG(shavite224, 64),
+	HMAC_ALG(shavite256, 64),
+	HMAC_ALG(shavite384, 128),
+	HMAC_ALG(shavite512, 128),
+	HMAC_ALG(simd224, 64),
+	HMAC_ALG(simd256, 64),
+	HMAC_ALG(simd384, 128),
+	HMAC_ALG(simd512, 128),
+	HMAC_ALG(skein224, 64),
+	HMAC_ALG(skein256, 64),
+	HMAC_ALG(skein384, 64),
+	HMAC_ALG(skein512, 64)
+};
+
+/* see sph_hmac.h */
+size_t
+sph_hmac_block(unsigned alg)
+{
+	if (alg >= SPH_HASH_NUM)
+		return 0;
+	return hmac_algs[alg].block;
+}
+
+/* see sph_hmac.h */
+int
+sph_hmac_init(sph_hmac_key *k, unsigned alg,
+	const void *key, size_t key_len)
+{
+	const hmac_alg *ha;
+	unsigned char kb[HMAC_MAX_BLOCK];
+	size_t u;
+
+	if (alg >= SPH_HASH_NUM)
+		return 0;
+	ha = &hmac_algs[alg];
+	memset(kb, 0, ha->block);
+	if (key_len > ha->block) {
+		ha->init(&k->inner);
+		ha->update(&k->inner, key, key_len);
+		ha->close(&k->inner, kb);
+	} else if (key_len > 0) {
+		memcpy(kb, key, key_len);
+	}
+	for (u = 0; u < ha->block; u ++)
+		kb[u] ^= 0x36;
+	ha->init(&k->inner);
+	ha->update(&k->inner, kb, ha->block);
+	for (u = 0; u < ha->block; u ++)
+		kb[u] ^= 0x36 ^ 0x5C;
+	ha->init(&k->outer);
+	ha->update(&k->outer, kb, ha->block);
+	k->impl = ha;
+	k->out_len = sph_hash_size(alg);
+	return 1;
+}
+
+/*
+ * Complete the MAC from an inner context which has absorbed the
+ * message; the inner context is used as working space.
+ */
+static void
+hmac_finish(const sph_hmac_key *k, sph_hmac_cc_ *cc, void *dst)
+{
+	const hmac_alg *ha;
+	unsigned char tmp[64];
+
+	ha = k->impl;
+	ha->close(cc, tmp);
+	memcpy(cc, &k->outer, ha->cc_size);
+	ha->update(cc, tmp, k->out_len);
+	ha->close(cc, dst);
+}
+
+/* see sph_hmac.h */
+void
+sph_hmac(const sph_hmac_key *k, const void *data, size_t len, void *dst)
+{
+	const hmac_alg *ha;
+	sph_hmac_cc_ cc;
+
+	ha = k->impl;
+	memcpy(&cc, &k->inner, ha->cc_size);
+	ha->update(&cc, data, len);
+	hmac_finish(k, &cc, dst);
+}
+
+/* see sph_hmac.h */
+void
+sph_hmac_batch(const sph_hmac_key *k, const void *const *data,
+	const size_t *len, void *const *dst, size_t num)
+{
+	const hmac_alg *ha;
+	sph_hmac_cc_ cc[HMAC_MAX_LANES];
+	void *cp[HMAC_MAX_LANES];
+	const void *p[HMAC_MAX_LANES];
+	size_t lanes, u;
+
+	ha = k->impl;
+	lanes = ha->lanes == 0 ? 1 : ha->lanes();
+	if (lanes > HMAC_MAX_LANES)
+		lanes = HMAC_MAX_LANES;
+	if (lanes < 2) {
+		for (u = 0; u < num; u ++)
+			sph_hmac(k, data[u], len[u], dst[u]);
+		return;
+	}
+
+	/*
+	 * The inner contexts have absorbed exactly one block (the key
+	 * block), hence hold no buffered data, as required by the
+	 * multi-message code. The full blocks common to all the messages
+	 * of a group go through the lanes; the rest of each message is
+	 * processed with the single-message code.
+	 */
+	while (num > 0) {
+		size_t n, nb, off;
+
+		n = num < lanes ? num : lanes;
+		nb = len[0] / ha->block;
+		for (u = 0; u < n; u ++) {
+			if (len[u] / ha->block < nb)
+				nb = len[u] / ha->block;
+			memcpy(&cc[u], &k->inner, ha->cc_size);
+			cp[u] = &cc[u];
+			p[u] = data[u];
+		}
+		if (nb > 0)
+			ha->blocks(cp, p, nb, n);
+		off = nb * ha->block;
+		for (u = 0; u < n; u ++) {
+			ha->update(&cc[u], (const unsigned char *)data[u] + off,
+				len[u] - off);
+			hmac_finish(k, &cc[u], dst[u]);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+}
+
+#endif
@@ -79,6 +79,7 @@
 #include "sph_shavite.h"
 #include "sph_simd.h"
 #include "sph_skein.h"
+#include "sph_streebog.h"
 #include "sph_tiger.h"
 #include "sph_whirlpool.h"
 
@@ -183,6 +184,10 @@ static union {
 	MAKECC(fugue256);
 	MAKECC(fugue384);
 	MAKECC(fugue512);
+#if SPH_64
+	MAKECC(gost256);
+	MAKECC(gost512);
+#endif
 	MAKECC(groestl224);
 	MAKECC(groestl256);
 	MAKECC(groestl384);
@@ -318,6 +323,12 @@ static struct known_function {
 	MAKEFF(fugue256),
 	MAKEFF(fugue384),
 	MAKEFF(fugue512),
+#if SPH_64
+	MAKEFF(gost256),
+	MAKEFF(gost512),
+	MAKEFFGEN(gost256, streebog256, 32),
+	MAKEFFGEN(gost512, streebog512, 64),
+#endif
 	MAKEFF(groestl224),
 	MAKEFF(groestl256),
 	MAKEFF(groestl384),
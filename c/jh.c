@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_jh.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_JH
 #define SPH_SMALL_FOOTPRINT_JH   1
@@ -903,14 +904,13 @@ jh_init(sph_jh_context *sc, const void *iv)
 static void
 jh_core(sph_jh_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -923,7 +923,12 @@ jh_core(sph_jh_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
@@ -931,6 +936,7 @@ jh_core(sph_jh_context *sc, const void *data, size_t len)
 			INPUT_BUF1;
 			E8;
 			INPUT_BUF2;
+			SPH_STATS_BLOCKS(SPH_STATS_JH, 1);
 #if SPH_64
 			sc->block_count ++;
 #else
@@ -1005,9 +1011,17 @@ sph_jh224_init(void *cc)
 void
 sph_jh224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_JH, len);
 	jh_core(cc, data, len);
 }
 
+/* see sph_jh.h */
+void
+sph_jh224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_jh224, cc, iov, n);
+}
+
 /* see sph_jh.h */
 void
 sph_jh224_close(void *cc, void *dst)
@@ -1015,6 +1029,13 @@ sph_jh224_close(void *cc, void *dst)
 	jh_close(cc, 0, 0, dst, 7, IV224);
 }
 
+/* see sph_jh.h */
+void
+sph_jh224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(jh224, data, len, dst);
+}
+
 /* see sph_jh.h */
 void
 sph_jh224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1033,9 +1054,17 @@ sph_jh256_init(void *cc)
 void
 sph_jh256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_JH, len);
 	jh_core(cc, data, len);
 }
 
+/* see sph_jh.h */
+void
+sph_jh256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_jh256, cc, iov, n);
+}
+
 /* see sph_jh.h */
 void
 sph_jh256_close(void *cc, void *dst)
@@ -1043,6 +1072,13 @@ sph_jh256_close(void *cc, void *dst)
 	jh_close(cc, 0, 0, dst, 8, IV256);
 }
 
+/* see sph_jh.h */
+void
+sph_jh256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(jh256, data, len, dst);
+}
+
 /* see sph_jh.h */
 void
 sph_jh256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1061,9 +1097,17 @@ sph_jh384_init(void *cc)
 void
 sph_jh384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_JH, len);
 	jh_core(cc, data, len);
 }
 
+/* see sph_jh.h */
+void
+sph_jh384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_jh384, cc, iov, n);
+}
+
 /* see sph_jh.h */
 void
 sph_jh384_close(void *cc, void *dst)
@@ -1071,6 +1115,13 @@ sph_jh384_close(void *cc, void *dst)
 	jh_close(cc, 0, 0, dst, 12, IV384);
 }
 
+/* see sph_jh.h */
+void
+sph_jh384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(jh384, data, len, dst);
+}
+
 /* see sph_jh.h */
 void
 sph_jh384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1089,9 +1140,17 @@ sph_jh512_init(void *cc)
 void
 sph_jh512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_JH, len);
 	jh_core(cc, data, len);
 }
 
+/* see sph_jh.h */
+void
+sph_jh512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_jh512, cc, iov, n);
+}
+
 /* see sph_jh.h */
 void
 sph_jh512_close(void *cc, void *dst)
@@ -1099,6 +1158,13 @@ sph_jh512_close(void *cc, void *dst)
 	jh_close(cc, 0, 0, dst, 16, IV512);
 }
 
+/* see sph_jh.h */
+void
+sph_jh512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(jh512, data, len, dst);
+}
+
 /* see sph_jh.h */
 void
 sph_jh512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -0,0 +1,234 @@
+/* $Id$ */
+/*
+ * Multi-buffer job manager for streaming messages.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+
+#include "sph_jobmgr.h"
+
+#if SPH_64
+
+typedef struct {
+	unsigned alg;
+	size_t block;
+	void (*init)(void *cc);
+	void (*update)(void *cc, const void *data, size_t len);
+	void (*close)(void *cc, void *dst);
+	unsigned (*lanes)(void);
+	void (*blocks)(void *const *cc, const void *const *data,
+		size_t nb, size_t num);
+} job_alg;
+
+#define JOB_ALG(id, name, block, lanes, blocks)   { \
+		SPH_HASH_ ## id, block, &sph_ ## name ## _init, \
+		&sph_ ## name, &sph_ ## name ## _close, lanes, blocks \
+	}
+
+/*
+ * Supported algorithms. Those without a lanes function are processed
+ * with their update function as soon as a piece is submitted.
+ */
+static const job_alg job_algs[] = {
+	JOB_ALG(MD5, md5, 64, &sph_md5_multi_lanes, &sph_md5_blocks_multi),
+	JOB_ALG(SHA1, sha1, 64, &sph_sha1_multi_lanes, &sph_sha1_blocks_multi),
+	JOB_ALG(SHA224, sha224, 64, &sph_sha224_multi_lanes, &sph_sha224_blocks_multi),
+	JOB_ALG(SHA256, sha256, 64, &sph_sha256_multi_lanes, &sph_sha256_blocks_multi),
+	JOB_ALG(SHA384, sha384, 128, &sph_sha384_multi_lanes, &sph_sha384_blocks_multi),
+	JOB_ALG(SHA512, sha512, 128, &sph_sha512_multi_lanes, &sph_sha512_blocks_multi),
+	JOB_ALG(BLAKE224, blake224, 64, 0, 0),
+	JOB_ALG(BLAKE256, blake256, 64, 0, 0),
+	JOB_ALG(BLAKE384, blake384, 128, 0, 0),
+	JOB_ALG(BLAKE512, blake512, 128, 0, 0),
+	JOB_ALG(KECCAK224, keccak224, 144, 0, 0),
+	JOB_ALG(KECCAK256, keccak256, 136, 0, 0),
+	JOB_ALG(KECCAK384, keccak384, 104, 0, 0),
+	JOB_ALG(KECCAK512, keccak512, 72, 0, 0)
+};
+
+/* see sph_jobmgr.h */
+int
+sph_jobmgr_init(sph_jobmgr *m, unsigned alg)
+{
+	size_t u;
+
+	for (u = 0; u < (sizeof job_algs) / sizeof job_algs[0]; u ++) {
+		const job_alg *ja;
+
+		ja = &job_algs[u];
+		if (ja->alg != alg)
+			continue;
+		m->impl = ja;
+		m->lanes = ja->lanes == 0 ? 1 : ja->lanes();
+		if (m->lanes > SPH_JOBMGR_MAX_LANES)
+			m->lanes = SPH_JOBMGR_MAX_LANES;
+		m->active = 0;
+		m->done = m->done_tail = NULL;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * A job has consumed its piece: compute the hash value if this was the
+ * last piece, and append the job to the list of completed jobs.
+ */
+static void
+job_done(sph_jobmgr *m, sph_job *job)
+{
+	const job_alg *ja;
+
+	ja = m->impl;
+	if (job->flags & SPH_JOB_LAST)
+		ja->close(&job->cc, job->digest);
+	job->next = NULL;
+	if (m->done == NULL)
+		m->done = job;
+	else
+		m->done_tail->next = job;
+	m->done_tail = job;
+}
+
+/*
+ * Run the busy lanes up to the end of the shortest run of full blocks.
+ * The jobs which reach the end of their full blocks get their remaining
+ * bytes (less than a block) buffered in their context, and are
+ * completed.
+ */
+static void
+job_run(sph_jobmgr *m)
+{
+	const job_alg *ja;
+	void *cc[SPH_JOBMGR_MAX_LANES];
+	const void *p[SPH_JOBMGR_MAX_LANES];
+	size_t k;
+	unsigned l, n;
+
+	ja = m->impl;
+	k = m->lane[0]->nb;
+	for (l = 0; l < m->active; l ++) {
+		sph_job *job;
+
+		job = m->lane[l];
+		cc[l] = &job->cc;
+		p[l] = job->ptr;
+		if (job->nb < k)
+			k = job->nb;
+	}
+	ja->blocks(cc, p, k, m->active);
+	for (l = 0, n = 0; l < m->active; l ++) {
+		sph_job *job;
+
+		job = m->lane[l];
+		job->ptr += k * ja->block;
+		job->nb -= k;
+		if (job->nb == 0) {
+			ja->update(&job->cc, job->ptr, job->tail);
+			job->pending = (unsigned)job->tail;
+			job_done(m, job);
+		} else {
+			m->lane[n ++] = job;
+		}
+	}
+	m->active = n;
+}
+
+/* see sph_jobmgr.h */
+sph_job *
+sph_jobmgr_submit(sph_jobmgr *m, sph_job *job)
+{
+	const job_alg *ja;
+	const unsigned char *p;
+	size_t len;
+
+	ja = m->impl;
+	if (job->flags & SPH_JOB_FIRST) {
+		ja->init(&job->cc);
+		job->pending = 0;
+	}
+	p = job->data;
+	len = job->len;
+	if (m->lanes > 1) {
+		/*
+		 * A block which straddles the previous piece and this one
+		 * is completed with the update function; the full blocks
+		 * which follow go to a lane.
+		 */
+		if (job->pending > 0) {
+			size_t n;
+
+			n = ja->block - job->pending;
+			if (n > len)
+				n = len;
+			ja->update(&job->cc, p, n);
+			p += n;
+			len -= n;
+			job->pending = (unsigned)((job->pending + n)
+				% ja->block);
+		}
+		if (job->pending == 0 && len >= ja->block) {
+			job->ptr = p;
+			job->nb = len / ja->block;
+			job->tail = len % ja->block;
+			m->lane[m->active ++] = job;
+			if (m->active == m->lanes)
+				job_run(m);
+			return sph_jobmgr_get_completed(m);
+		}
+	}
+	ja->update(&job->cc, p, len);
+	job->pending = (unsigned)((job->pending + len) % ja->block);
+	job_done(m, job);
+	return sph_jobmgr_get_completed(m);
+}
+
+/* see sph_jobmgr.h */
+sph_job *
+sph_jobmgr_flush(sph_jobmgr *m)
+{
+	if (m->done == NULL && m->active > 0)
+		job_run(m);
+	return sph_jobmgr_get_completed(m);
+}
+
+/* see sph_jobmgr.h */
+sph_job *
+sph_jobmgr_get_completed(sph_jobmgr *m)
+{
+	sph_job *job;
+
+	job = m->done;
+	if (job != NULL) {
+		m->done = job->next;
+		if (m->done == NULL)
+			m->done_tail = NULL;
+	}
+	return job;
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_keccak.h"
+#include "sph_stats.h"
 
 /*
  * Parameters:
@@ -1564,15 +1565,14 @@ keccak_init(sph_keccak_context *kc, unsigned out_size)
 static void
 keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE
 
-	buf = kc->buf;
 	ptr = kc->ptr;
 
 	if (len < (lim - ptr)) {
-		memcpy(buf + ptr, data, len);
+		memcpy(kc->buf + ptr, data, len);
 		kc->ptr = ptr + len;
 		return;
 	}
@@ -1584,13 +1584,19 @@ keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 		clen = (lim - ptr);
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == lim && SPH_DIRECT_INPUT(data, 8)) {
+			buf = data;
+		} else {
+			memcpy(kc->buf + ptr, data, clen);
+			buf = kc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == lim) {
 			INPUT_BUF(lim);
 			KECCAK_F_1600;
+			SPH_STATS_BLOCKS(SPH_STATS_KECCAK, 1);
 			ptr = 0;
 		}
 	}
@@ -1600,6 +1606,31 @@ keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 
 #if SPH_KECCAK_64
 
+/*
+ * Write out the first d bytes of the state, once the last block has
+ * been processed. The state is modified.
+ */
+static void
+keccak_out(sph_keccak_context *kc, void *dst, size_t d)
+{
+	union {
+		unsigned char tmp[64];
+		sph_u64 dummy;   /* for alignment */
+	} u;
+	size_t j;
+
+	/* Finalize the "lane complement" */
+	kc->u.wide[ 1] = ~kc->u.wide[ 1];
+	kc->u.wide[ 2] = ~kc->u.wide[ 2];
+	kc->u.wide[ 8] = ~kc->u.wide[ 8];
+	kc->u.wide[12] = ~kc->u.wide[12];
+	kc->u.wide[17] = ~kc->u.wide[17];
+	kc->u.wide[20] = ~kc->u.wide[20];
+	for (j = 0; j < d; j += 8)
+		sph_enc64le_aligned(u.tmp + j, kc->u.wide[j >> 3]);
+	memcpy(dst, u.tmp, d);
+}
+
 #define DEFCLOSE(d, lim) \
 	static void keccak_close ## d( \
 		sph_keccak_context *kc, unsigned ub, unsigned n, void *dst) \
@@ -1629,21 +1660,46 @@ keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 			u.tmp[j - 1] = 0x80; \
 		} \
 		keccak_core(kc, u.tmp, j, lim); \
-		/* Finalize the "lane complement" */ \
-		kc->u.wide[ 1] = ~kc->u.wide[ 1]; \
-		kc->u.wide[ 2] = ~kc->u.wide[ 2]; \
-		kc->u.wide[ 8] = ~kc->u.wide[ 8]; \
-		kc->u.wide[12] = ~kc->u.wide[12]; \
-		kc->u.wide[17] = ~kc->u.wide[17]; \
-		kc->u.wide[20] = ~kc->u.wide[20]; \
-		for (j = 0; j < d; j += 8) \
-			sph_enc64le_aligned(u.tmp + j, kc->u.wide[j >> 3]); \
-		memcpy(dst, u.tmp, d); \
+		keccak_out(kc, dst, d); \
 		keccak_init(kc, (unsigned)d << 3); \
 	} \
 
 #else
 
+/*
+ * Write out the first d bytes of the state, once the last block has
+ * been processed. The state is modified.
+ */
+static void
+keccak_out(sph_keccak_context *kc, void *dst, size_t d)
+{
+	union {
+		unsigned char tmp[64];
+		sph_u64 dummy;   /* for alignment */
+	} u;
+	size_t j;
+
+	/* Finalize the "lane complement" */
+	kc->u.narrow[ 2] = ~kc->u.narrow[ 2];
+	kc->u.narrow[ 3] = ~kc->u.narrow[ 3];
+	kc->u.narrow[ 4] = ~kc->u.narrow[ 4];
+	kc->u.narrow[ 5] = ~kc->u.narrow[ 5];
+	kc->u.narrow[16] = ~kc->u.narrow[16];
+	kc->u.narrow[17] = ~kc->u.narrow[17];
+	kc->u.narrow[24] = ~kc->u.narrow[24];
+	kc->u.narrow[25] = ~kc->u.narrow[25];
+	kc->u.narrow[34] = ~kc->u.narrow[34];
+	kc->u.narrow[35] = ~kc->u.narrow[35];
+	kc->u.narrow[40] = ~kc->u.narrow[40];
+	kc->u.narrow[41] = ~kc->u.narrow[41];
+	/* un-interleave */
+	for (j = 0; j < 50; j += 2)
+		UNINTERLEAVE(kc->u.narrow[j], kc->u.narrow[j + 1]);
+	for (j = 0; j < d; j += 4)
+		sph_enc32le_aligned(u.tmp + j, kc->u.narrow[j >> 2]);
+	memcpy(dst, u.tmp, d);
+}
+
 #define DEFCLOSE(d, lim) \
 	static void keccak_close ## d( \
 		sph_keccak_context *kc, unsigned ub, unsigned n, void *dst) \
@@ -1673,25 +1729,7 @@ keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 			u.tmp[j - 1] = 0x80; \
 		} \
 		keccak_core(kc, u.tmp, j, lim); \
-		/* Finalize the "lane complement" */ \
-		kc->u.narrow[ 2] = ~kc->u.narrow[ 2]; \
-		kc->u.narrow[ 3] = ~kc->u.narrow[ 3]; \
-		kc->u.narrow[ 4] = ~kc->u.narrow[ 4]; \
-		kc->u.narrow[ 5] = ~kc->u.narrow[ 5]; \
-		kc->u.narrow[16] = ~kc->u.narrow[16]; \
-		kc->u.narrow[17] = ~kc->u.narrow[17]; \
-		kc->u.narrow[24] = ~kc->u.narrow[24]; \
-		kc->u.narrow[25] = ~kc->u.narrow[25]; \
-		kc->u.narrow[34] = ~kc->u.narrow[34]; \
-		kc->u.narrow[35] = ~kc->u.narrow[35]; \
-		kc->u.narrow[40] = ~kc->u.narrow[40]; \
-		kc->u.narrow[41] = ~kc->u.narrow[41]; \
-		/* un-interleave */ \
-		for (j = 0; j < 50; j += 2) \
-			UNINTERLEAVE(kc->u.narrow[j], kc->u.narrow[j + 1]); \
-		for (j = 0; j < d; j += 4) \
-			sph_enc32le_aligned(u.tmp + j, kc->u.narrow[j >> 2]); \
-		memcpy(dst, u.tmp, d); \
+		keccak_out(kc, dst, d); \
 		keccak_init(kc, (unsigned)d << 3); \
 	} \
 
@@ -1702,6 +1740,41 @@ DEFCLOSE(32, 136)
 DEFCLOSE(48, 104)
 DEFCLOSE(64, 72)
 
+/*
+ * One-shot hashing. A message shorter than the rate is padded into a
+ * full block on the stack, which keccak_core() absorbs in place with a
+ * single permutation; the context buffer is not used.
+ */
+#define DEFONESHOT(d, lim) \
+	static void keccak_oneshot ## d( \
+		const void *data, size_t len, void *dst) \
+	{ \
+		sph_keccak_context kc; \
+		union { \
+			unsigned char tmp[lim]; \
+			sph_u64 dummy;   /* for alignment */ \
+		} u; \
+ \
+		SPH_STATS_INPUT(SPH_STATS_KECCAK, len); \
+		keccak_init(&kc, (unsigned)d << 3); \
+		if (len >= lim) { \
+			keccak_core(&kc, data, len, lim); \
+			keccak_close ## d(&kc, 0, 0, dst); \
+			return; \
+		} \
+		memcpy(u.tmp, data, len); \
+		u.tmp[len] = 0x01; \
+		memset(u.tmp + len + 1, 0, lim - len - 1); \
+		u.tmp[lim - 1] |= 0x80; \
+		keccak_core(&kc, u.tmp, lim, lim); \
+		keccak_out(&kc, dst, d); \
+	} \
+
+DEFONESHOT(28, 144)
+DEFONESHOT(32, 136)
+DEFONESHOT(48, 104)
+DEFONESHOT(64, 72)
+
 /* see sph_keccak.h */
 void
 sph_keccak224_init(void *cc)
@@ -1713,9 +1786,17 @@ sph_keccak224_init(void *cc)
 void
 sph_keccak224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_KECCAK, len);
 	keccak_core(cc, data, len, 144);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_keccak224, cc, iov, n);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak224_close(void *cc, void *dst)
@@ -1730,6 +1811,13 @@ sph_keccak224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	keccak_close28(cc, ub, n, dst);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak224_oneshot(const void *data, size_t len, void *dst)
+{
+	keccak_oneshot28(data, len, dst);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak256_init(void *cc)
@@ -1741,9 +1829,17 @@ sph_keccak256_init(void *cc)
 void
 sph_keccak256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_KECCAK, len);
 	keccak_core(cc, data, len, 136);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_keccak256, cc, iov, n);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak256_close(void *cc, void *dst)
@@ -1758,6 +1854,13 @@ sph_keccak256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	keccak_close32(cc, ub, n, dst);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak256_oneshot(const void *data, size_t len, void *dst)
+{
+	keccak_oneshot32(data, len, dst);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak384_init(void *cc)
@@ -1769,9 +1872,17 @@ sph_keccak384_init(void *cc)
 void
 sph_keccak384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_KECCAK, len);
 	keccak_core(cc, data, len, 104);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_keccak384, cc, iov, n);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak384_close(void *cc, void *dst)
@@ -1786,6 +1897,13 @@ sph_keccak384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	keccak_close48(cc, ub, n, dst);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak384_oneshot(const void *data, size_t len, void *dst)
+{
+	keccak_oneshot48(data, len, dst);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak512_init(void *cc)
@@ -1797,9 +1915,17 @@ sph_keccak512_init(void *cc)
 void
 sph_keccak512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_KECCAK, len);
 	keccak_core(cc, data, len, 72);
 }
 
+/* see sph_keccak.h */
+void
+sph_keccak512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_keccak512, cc, iov, n);
+}
+
 /* see sph_keccak.h */
 void
 sph_keccak512_close(void *cc, void *dst)
@@ -1813,3 +1939,10 @@ sph_keccak512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
 	keccak_close64(cc, ub, n, dst);
 }
+
+/* see sph_keccak.h */
+void
+sph_keccak512_oneshot(const void *data, size_t len, void *dst)
+{
+	keccak_oneshot64(data, len, dst);
+}
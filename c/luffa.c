@@ -35,6 +35,12 @@
 #include <limits.h>
 
 #include "sph_luffa.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+#include <immintrin.h>
+#endif
 
 #if SPH_64_TRUE && !defined SPH_LUFFA_PARALLEL
 #define SPH_LUFFA_PARALLEL   1
@@ -180,6 +186,103 @@ static const sph_u32 RC44[8] = {
 	SPH_C32(0x3f014f0c), SPH_C32(0xfc053c31)
 };
 
+#if SPH_X86_SIMD
+
+/*
+ * Round constants for the vector code: RCV0[r][j] = RCj0[r] and
+ * RCV4[r][j] = RCj4[r] (the lane for sub-permutation j).
+ */
+
+static const sph_u32 RCV0[8][8] = {
+	{
+		SPH_C32(0x303994a6), SPH_C32(0xb6de10ed),
+		SPH_C32(0xfc20d9d2), SPH_C32(0xb213afa5),
+		SPH_C32(0xf0d2e9e3), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0xc0e65299), SPH_C32(0x70f47aae),
+		SPH_C32(0x34552e25), SPH_C32(0xc84ebe95),
+		SPH_C32(0xac11d7fa), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x6cc33a12), SPH_C32(0x0707a3d4),
+		SPH_C32(0x7ad8818f), SPH_C32(0x4e608a22),
+		SPH_C32(0x1bcb66f2), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0xdc56983e), SPH_C32(0x1c1e8f51),
+		SPH_C32(0x8438764a), SPH_C32(0x56d858fe),
+		SPH_C32(0x6f2d9bc9), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x1e00108f), SPH_C32(0x707a3d45),
+		SPH_C32(0xbb6de032), SPH_C32(0x343b138f),
+		SPH_C32(0x78602649), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x7800423d), SPH_C32(0xaeb28562),
+		SPH_C32(0xedb780c8), SPH_C32(0xd0ec4e3d),
+		SPH_C32(0x8edae952), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x8f5b7882), SPH_C32(0xbaca1589),
+		SPH_C32(0xd9847356), SPH_C32(0x2ceb4882),
+		SPH_C32(0x3b6ba548), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x96e1db12), SPH_C32(0x40a46f3e),
+		SPH_C32(0xa2c78434), SPH_C32(0xb3ad2208),
+		SPH_C32(0xedae9520), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}
+};
+
+static const sph_u32 RCV4[8][8] = {
+	{
+		SPH_C32(0xe0337818), SPH_C32(0x01685f3d),
+		SPH_C32(0xe25e72c1), SPH_C32(0xe028c9bf),
+		SPH_C32(0x5090d577), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x441ba90d), SPH_C32(0x05a17cf4),
+		SPH_C32(0xe623bb72), SPH_C32(0x44756f91),
+		SPH_C32(0x2d1925ab), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x7f34d442), SPH_C32(0xbd09caca),
+		SPH_C32(0x5c58a4a4), SPH_C32(0x7e8fce32),
+		SPH_C32(0xb46496ac), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x9389217f), SPH_C32(0xf4272b28),
+		SPH_C32(0x1e38e2e7), SPH_C32(0x956548be),
+		SPH_C32(0xd1925ab0), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0xe5a8bce6), SPH_C32(0x144ae5cc),
+		SPH_C32(0x78e38b9d), SPH_C32(0xfe191be2),
+		SPH_C32(0x29131ab6), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x5274baf4), SPH_C32(0xfaa7ae2b),
+		SPH_C32(0x27586719), SPH_C32(0x3cb226e5),
+		SPH_C32(0x0fc053c3), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x26889ba7), SPH_C32(0x2e48f1c1),
+		SPH_C32(0x36eda57f), SPH_C32(0x5944a28e),
+		SPH_C32(0x3f014f0c), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}, {
+		SPH_C32(0x9a226e9d), SPH_C32(0xb923c704),
+		SPH_C32(0x703aace7), SPH_C32(0xa1c4c355),
+		SPH_C32(0xfc053c31), SPH_C32(0x00000000),
+		SPH_C32(0x00000000), SPH_C32(0x00000000)
+	}
+};
+
+#endif
+
 #define DECL_TMP8(w) \
 	sph_u32 w ## 0, w ## 1, w ## 2, w ## 3, w ## 4, w ## 5, w ## 6, w ## 7;
 
@@ -1051,22 +1154,531 @@ static const sph_u32 RC44[8] = {
 
 #endif
 
+#if SPH_X86_SIMD
+
+/*
+ * Vector implementation. Each sub-permutation is a lane: vector Wi
+ * contains word i of V0, V1... (this is what SPH_LUFFA_PARALLEL does
+ * with two lanes in a 64-bit word). The step function then runs over
+ * all sub-permutations at once, with per-lane tweak rotations and
+ * round constants. In the message injection, the sum of the
+ * sub-permutations and the feedback from one sub-permutation to the
+ * next become lane shuffles (indices are modulo w, the number of
+ * sub-permutations):
+ *
+ *   MI3:  V_j ^= M2(V_0 ^ V_1 ^ V_2)
+ *   MI4:  after the same sum, V_j = M2(V_j) ^ V_(j-1)
+ *   MI5:  after the same sum, U_j = M2(V_j) ^ V_(j+1),
+ *         then V_j = M2(U_j) ^ U_(j-1)
+ *
+ * and, in all cases, V_j ^= M2^j(M). Each message uses a group of G
+ * lanes (4 or 8); with 4-lane groups in 256-bit registers, two
+ * messages are processed in parallel.
+ *
+ * A "run" function processes nb blocks of 32 bytes for each message;
+ * message m has its state at st[m] and its data at p[m].
+ */
+
+typedef void (*luffa_run_fn)(sph_u32 (*const *st)[8],
+	const unsigned char *const *p, size_t nb);
+
+#define M2V(d, s)   do { \
+		tmp = s ## 7; \
+		d ## 7 = s ## 6; \
+		d ## 6 = s ## 5; \
+		d ## 5 = s ## 4; \
+		d ## 4 = s ## 3 ^ tmp; \
+		d ## 3 = s ## 2 ^ tmp; \
+		d ## 2 = s ## 1; \
+		d ## 1 = s ## 0 ^ tmp; \
+		d ## 0 = tmp; \
+	} while (0)
+
+#define MAP8(d, f, s)   do { \
+		d ## 0 = f(s ## 0); \
+		d ## 1 = f(s ## 1); \
+		d ## 2 = f(s ## 2); \
+		d ## 3 = f(s ## 3); \
+		d ## 4 = f(s ## 4); \
+		d ## 5 = f(s ## 5); \
+		d ## 6 = f(s ## 6); \
+		d ## 7 = f(s ## 7); \
+	} while (0)
+
+#define SUB_CRUMBV(a0, a1, a2, a3)   do { \
+		tmp = (a0); \
+		(a0) |= (a1); \
+		(a2) ^= (a3); \
+		(a1) = ~(a1); \
+		(a0) ^= (a3); \
+		(a3) &= tmp; \
+		(a1) ^= (a3); \
+		(a3) ^= (a2); \
+		(a2) &= (a0); \
+		(a0) = ~(a0); \
+		(a2) ^= (a1); \
+		(a1) |= (a3); \
+		tmp ^= (a1); \
+		(a3) ^= (a2); \
+		(a2) &= (a1); \
+		(a1) ^= (a0); \
+		(a0) = tmp; \
+	} while (0)
+
+/*
+ * The kernel body; SUM(), RUP(), RDN(), TWK() and RCL() are defined
+ * for each lane layout: SUM() is the XOR of the (masked) lanes of a
+ * group, broadcast over the group; RUP() moves lane j-1 to lane j and
+ * RDN() lane j+1 to lane j, within a group; TWK() rotates lane j by j
+ * bits; RCL() loads the round constants.
+ */
+#define DECL_LUFFA_RUN(name, vtype, target, w, G, nm) \
+SPH_TARGET(target) static void \
+name(sph_u32 (*const *st)[8], const unsigned char *const *p, size_t nb) \
+{ \
+	vtype S[8], Mv[8], rc0[8], rc4[8], lm, z = { 0 }; \
+	vtype W0, W1, W2, W3, W4, W5, W6, W7; \
+	vtype a0, a1, a2, a3, a4, a5, a6, a7, tmp; \
+	size_t off; \
+	unsigned i, j, m; \
+	int r; \
+ \
+	for (r = 0; r < 8; r ++) { \
+		rc0[r] = RCL(RCV0[r]); \
+		rc4[r] = RCL(RCV4[r]); \
+	} \
+	lm = z; \
+	for (j = 0; j < (G) * (nm); j ++) \
+		if (j % (G) < (w)) \
+			lm[j] = SPH_C32(0xFFFFFFFF); \
+	for (i = 0; i < 8; i ++) { \
+		S[i] = z; \
+		Mv[i] = z; \
+	} \
+	for (m = 0; m < (nm); m ++) \
+		for (j = 0; j < (w); j ++) \
+			for (i = 0; i < 8; i ++) \
+				S[i][m * (G) + j] = st[m][j][i]; \
+	W0 = S[0]; \
+	W1 = S[1]; \
+	W2 = S[2]; \
+	W3 = S[3]; \
+	W4 = S[4]; \
+	W5 = S[5]; \
+	W6 = S[6]; \
+	W7 = S[7]; \
+	for (off = 0; nb -- > 0; off += 32) { \
+		for (m = 0; m < (nm); m ++) { \
+			const unsigned char *buf; \
+			DECL_TMP8(M) \
+ \
+			buf = p[m] + off; \
+			M0 = sph_dec32be(buf +  0); \
+			M1 = sph_dec32be(buf +  4); \
+			M2 = sph_dec32be(buf +  8); \
+			M3 = sph_dec32be(buf + 12); \
+			M4 = sph_dec32be(buf + 16); \
+			M5 = sph_dec32be(buf + 20); \
+			M6 = sph_dec32be(buf + 24); \
+			M7 = sph_dec32be(buf + 28); \
+			for (j = m * (G); j < m * (G) + (w); j ++) { \
+				Mv[0][j] = M0; \
+				Mv[1][j] = M1; \
+				Mv[2][j] = M2; \
+				Mv[3][j] = M3; \
+				Mv[4][j] = M4; \
+				Mv[5][j] = M5; \
+				Mv[6][j] = M6; \
+				Mv[7][j] = M7; \
+				M2(M, M); \
+			} \
+		} \
+		MAP8(a, SUM, W); \
+		M2V(a, a); \
+		XOR(W, W, a); \
+		if ((w) == 4) { \
+			M2V(a, W); \
+			MAP8(W, RUP, W); \
+			XOR(W, W, a); \
+		} else if ((w) == 5) { \
+			M2V(a, W); \
+			MAP8(W, RDN, W); \
+			XOR(a, a, W); \
+			M2V(W, a); \
+			MAP8(a, RUP, a); \
+			XOR(W, W, a); \
+		} \
+		W0 ^= Mv[0]; \
+		W1 ^= Mv[1]; \
+		W2 ^= Mv[2]; \
+		W3 ^= Mv[3]; \
+		W4 = TWK(W4 ^ Mv[4]); \
+		W5 = TWK(W5 ^ Mv[5]); \
+		W6 = TWK(W6 ^ Mv[6]); \
+		W7 = TWK(W7 ^ Mv[7]); \
+		for (r = 0; r < 8; r ++) { \
+			SUB_CRUMBV(W0, W1, W2, W3); \
+			SUB_CRUMBV(W5, W6, W7, W4); \
+			MIX_WORD(W0, W4); \
+			MIX_WORD(W1, W5); \
+			MIX_WORD(W2, W6); \
+			MIX_WORD(W3, W7); \
+			W0 ^= rc0[r]; \
+			W4 ^= rc4[r]; \
+		} \
+	} \
+	S[0] = W0; \
+	S[1] = W1; \
+	S[2] = W2; \
+	S[3] = W3; \
+	S[4] = W4; \
+	S[5] = W5; \
+	S[6] = W6; \
+	S[7] = W7; \
+	for (m = 0; m < (nm); m ++) \
+		for (j = 0; j < (w); j ++) \
+			for (i = 0; i < 8; i ++) \
+				st[m][j][i] = S[i][m * (G) + j]; \
+}
+
+/*
+ * With AVX-512VL, the compiler turns the rotations of MIX_WORD into
+ * single instructions (vprold), which saves about a third of the
+ * instructions of a round; the same kernels are compiled for that
+ * target.
+ */
+#define LUFFA_AVX512   "avx2,avx512f,avx512vl"
+
+/*
+ * One message in a 128-bit register. Without AVX2, the per-lane
+ * rotation uses 32x32->64 multiplications by 2^j: the low and high
+ * halves of the product are the two halves of the rotated word.
+ */
+
+SPH_TARGET("sse2") static SPH_INLINE sph_v32x4
+luffa_sum_x4(sph_v32x4 x)
+{
+	__m128i t;
+
+	t = (__m128i)x;
+	t = _mm_xor_si128(t, _mm_shuffle_epi32(t, 0x4E));
+	return (sph_v32x4)_mm_xor_si128(t, _mm_shuffle_epi32(t, 0xB1));
+}
+
+SPH_TARGET("sse2") static SPH_INLINE sph_v32x4
+luffa_rup_x4(sph_v32x4 x)
+{
+	return (sph_v32x4)_mm_shuffle_epi32((__m128i)x, 0x93);
+}
+
+SPH_TARGET("sse2") static SPH_INLINE sph_v32x4
+luffa_twk_sse2(sph_v32x4 x)
+{
+	__m128i t, e, o;
+
+	t = (__m128i)x;
+	e = _mm_mul_epu32(t, _mm_set_epi32(0, 4, 0, 1));
+	o = _mm_mul_epu32(_mm_srli_epi64(t, 32), _mm_set_epi32(0, 8, 0, 2));
+	e = _mm_or_si128(e, _mm_srli_epi64(e, 32));
+	o = _mm_or_si128(o, _mm_srli_epi64(o, 32));
+	return (sph_v32x4)_mm_or_si128(
+		_mm_and_si128(e, _mm_set_epi32(0, -1, 0, -1)),
+		_mm_slli_epi64(o, 32));
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x4
+luffa_twk_avx2(sph_v32x4 x)
+{
+	__m128i t;
+
+	t = (__m128i)x;
+	return (sph_v32x4)_mm_or_si128(
+		_mm_sllv_epi32(t, _mm_set_epi32(3, 2, 1, 0)),
+		_mm_srlv_epi32(t, _mm_set_epi32(29, 30, 31, 32)));
+}
+
+#define SUM(x)   luffa_sum_x4((x) & lm)
+#define RUP      luffa_rup_x4
+#define RDN      luffa_rup_x4
+#define RCL(t)   ((sph_v32x4)_mm_loadu_si128((const __m128i *)(t)))
+
+#define TWK      luffa_twk_sse2
+DECL_LUFFA_RUN(luffa3_run_sse2, sph_v32x4, "sse2", 3, 4, 1)
+DECL_LUFFA_RUN(luffa4_run_sse2, sph_v32x4, "sse2", 4, 4, 1)
+#undef TWK
+
+#define TWK      luffa_twk_avx2
+DECL_LUFFA_RUN(luffa3_run_avx2, sph_v32x4, "avx2", 3, 4, 1)
+DECL_LUFFA_RUN(luffa4_run_avx2, sph_v32x4, "avx2", 4, 4, 1)
+#if SPH_X86_AVX512
+DECL_LUFFA_RUN(luffa3_run_avx512, sph_v32x4, LUFFA_AVX512, 3, 4, 1)
+DECL_LUFFA_RUN(luffa4_run_avx512, sph_v32x4, LUFFA_AVX512, 4, 4, 1)
+#endif
+#undef TWK
+
+#undef SUM
+#undef RUP
+#undef RDN
+#undef RCL
+
+/*
+ * Two messages, one per 128-bit half of a 256-bit register. The AVX2
+ * in-lane shuffles work on each half independently.
+ */
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_sum_x44(sph_v32x8 x)
+{
+	__m256i t;
+
+	t = (__m256i)x;
+	t = _mm256_xor_si256(t, _mm256_shuffle_epi32(t, 0x4E));
+	return (sph_v32x8)_mm256_xor_si256(t, _mm256_shuffle_epi32(t, 0xB1));
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_rup_x44(sph_v32x8 x)
+{
+	return (sph_v32x8)_mm256_shuffle_epi32((__m256i)x, 0x93);
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_twk_x44(sph_v32x8 x)
+{
+	__m256i t;
+
+	t = (__m256i)x;
+	return (sph_v32x8)_mm256_or_si256(
+		_mm256_sllv_epi32(t, _mm256_set_epi32(3, 2, 1, 0, 3, 2, 1, 0)),
+		_mm256_srlv_epi32(t,
+			_mm256_set_epi32(29, 30, 31, 32, 29, 30, 31, 32)));
+}
+
+#define SUM(x)   luffa_sum_x44((x) & lm)
+#define RUP      luffa_rup_x44
+#define RDN      luffa_rup_x44
+#define TWK      luffa_twk_x44
+#define RCL(t)   ((sph_v32x8)_mm256_broadcastsi128_si256( \
+                 _mm_loadu_si128((const __m128i *)(t))))
+
+DECL_LUFFA_RUN(luffa3_run2_avx2, sph_v32x8, "avx2", 3, 4, 2)
+DECL_LUFFA_RUN(luffa4_run2_avx2, sph_v32x8, "avx2", 4, 4, 2)
+#if SPH_X86_AVX512
+DECL_LUFFA_RUN(luffa3_run2_avx512, sph_v32x8, LUFFA_AVX512, 3, 4, 2)
+DECL_LUFFA_RUN(luffa4_run2_avx512, sph_v32x8, LUFFA_AVX512, 4, 4, 2)
+#endif
+
+#undef SUM
+#undef RUP
+#undef RDN
+#undef TWK
+#undef RCL
+
+/*
+ * Luffa-512: one message over the eight lanes of a 256-bit register,
+ * of which five are used.
+ */
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_sum_x8(sph_v32x8 x)
+{
+	__m256i t;
+
+	t = (__m256i)x;
+	t = _mm256_xor_si256(t, _mm256_permute2x128_si256(t, t, 0x01));
+	t = _mm256_xor_si256(t, _mm256_shuffle_epi32(t, 0x4E));
+	return (sph_v32x8)_mm256_xor_si256(t, _mm256_shuffle_epi32(t, 0xB1));
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_rup_x8(sph_v32x8 x)
+{
+	return (sph_v32x8)_mm256_permutevar8x32_epi32((__m256i)x,
+		_mm256_set_epi32(7, 6, 5, 3, 2, 1, 0, 4));
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_rdn_x8(sph_v32x8 x)
+{
+	return (sph_v32x8)_mm256_permutevar8x32_epi32((__m256i)x,
+		_mm256_set_epi32(7, 6, 5, 0, 4, 3, 2, 1));
+}
+
+SPH_TARGET("avx2") static SPH_INLINE sph_v32x8
+luffa_twk_x8(sph_v32x8 x)
+{
+	__m256i t;
+
+	t = (__m256i)x;
+	return (sph_v32x8)_mm256_or_si256(
+		_mm256_sllv_epi32(t, _mm256_set_epi32(0, 0, 0, 4, 3, 2, 1, 0)),
+		_mm256_srlv_epi32(t,
+			_mm256_set_epi32(32, 32, 32, 28, 29, 30, 31, 32)));
+}
+
+#define SUM(x)   luffa_sum_x8((x) & lm)
+#define RUP      luffa_rup_x8
+#define RDN      luffa_rdn_x8
+#define TWK      luffa_twk_x8
+#define RCL(t)   ((sph_v32x8)_mm256_loadu_si256((const __m256i *)(t)))
+
+DECL_LUFFA_RUN(luffa5_run_avx2, sph_v32x8, "avx2", 5, 8, 1)
+#if SPH_X86_AVX512
+DECL_LUFFA_RUN(luffa5_run_avx512, sph_v32x8, LUFFA_AVX512, 5, 8, 1)
+#endif
+
+#undef SUM
+#undef RUP
+#undef RDN
+#undef TWK
+#undef RCL
+
+/*
+ * Get the single-message kernel for w sub-permutations, or 0 if the
+ * portable code must be used.
+ */
+static luffa_run_fn
+luffa_select(int w)
+{
+	unsigned f;
+
+	f = sph_cpu_features();
+	switch (w) {
+	case 3:
+#if SPH_X86_AVX512
+		if (f & SPH_CPU_AVX512)
+			return luffa3_run_avx512;
+#endif
+		if (f & SPH_CPU_AVX2)
+			return luffa3_run_avx2;
+		if (f & SPH_CPU_SSE2)
+			return luffa3_run_sse2;
+		break;
+	case 4:
+#if SPH_X86_AVX512
+		if (f & SPH_CPU_AVX512)
+			return luffa4_run_avx512;
+#endif
+		if (f & SPH_CPU_AVX2)
+			return luffa4_run_avx2;
+		if (f & SPH_CPU_SSE2)
+			return luffa4_run_sse2;
+		break;
+	case 5:
+#if SPH_X86_AVX512
+		if (f & SPH_CPU_AVX512)
+			return luffa5_run_avx512;
+#endif
+		if (f & SPH_CPU_AVX2)
+			return luffa5_run_avx2;
+		break;
+	}
+	return 0;
+}
+
+/*
+ * Process len bytes with a single-message kernel; the caller has
+ * checked that this completes the current block. Full blocks are read
+ * directly from the input.
+ */
+static void
+luffa_vupdate(luffa_run_fn run, sph_u32 (*V)[8], unsigned char *buf,
+	size_t *pptr, const unsigned char *data, size_t len)
+{
+	const unsigned char *q;
+	size_t ptr, nb;
+
+	ptr = *pptr;
+	if (ptr > 0) {
+		memcpy(buf + ptr, data, 32 - ptr);
+		data += 32 - ptr;
+		len -= 32 - ptr;
+		q = buf;
+		run(&V, &q, 1);
+		SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
+	}
+	nb = len >> 5;
+	if (nb > 0) {
+		run(&V, &data, nb);
+		SPH_STATS_BLOCKS(SPH_STATS_LUFFA, nb);
+		data += nb << 5;
+		len &= 31;
+	}
+	memcpy(buf, data, len);
+	*pptr = len;
+}
+
+/*
+ * Output nw words, XOR of the w sub-permutations.
+ */
+static void
+luffa_out(sph_u32 (*V)[8], int w, unsigned char *out, size_t nw)
+{
+	size_t i;
+	int j;
+
+	for (i = 0; i < nw; i ++) {
+		sph_u32 t;
+
+		t = V[0][i];
+		for (j = 1; j < w; j ++)
+			t ^= V[j][i];
+		sph_enc32be(out + 4 * i, t);
+	}
+}
+
+/*
+ * Padding and blank rounds with a single-message kernel; nw is the
+ * output size, in 32-bit words (an output block is 8 words).
+ */
+static void
+luffa_vclose(luffa_run_fn run, sph_u32 (*V)[8], int w, unsigned char *buf,
+	size_t ptr, unsigned ub, unsigned n, unsigned char *out, size_t nw)
+{
+	const unsigned char *q;
+	unsigned z;
+	size_t k;
+
+	z = 0x80 >> n;
+	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
+	memset(buf + ptr, 0, 32 - ptr);
+	q = buf;
+	run(&V, &q, 1);
+	SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
+	memset(buf, 0, 32);
+	for (k = 0; k < nw; k += 8) {
+		run(&V, &q, 1);
+		luffa_out(V, w, out + 4 * k, nw - k < 8 ? nw - k : 8);
+	}
+}
+
+#endif
+
 static void
 luffa3(sph_luffa224_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE3
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
 	}
 
+#if SPH_X86_SIMD
+	run = luffa_select(3);
+	if (run != 0) {
+		luffa_vupdate(run, sc->V, sc->buf, &sc->ptr, data, len);
+		return;
+	}
+#endif
 	READ_STATE3(sc);
 	while (len > 0) {
 		size_t clen;
@@ -1074,13 +1686,19 @@ luffa3(sph_luffa224_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			MI3;
 			P3;
+			SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 			ptr = 0;
 		}
 	}
@@ -1096,14 +1714,26 @@ luffa3_close(sph_luffa224_context *sc, unsigned ub, unsigned n,
 	size_t ptr;
 	unsigned z;
 	int i;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE3
 
+#if SPH_X86_SIMD
+	run = luffa_select(3);
+	if (run != 0) {
+		luffa_vclose(run, sc->V, 3, sc->buf, sc->ptr,
+			ub, n, dst, out_size_w32);
+		return;
+	}
+#endif
 	buf = sc->buf;
 	ptr = sc->ptr;
 	z = 0x80 >> n;
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	READ_STATE3(sc);
+	SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 	for (i = 0; i < 2; i ++) {
 		MI3;
 		P3;
@@ -1124,19 +1754,28 @@ luffa3_close(sph_luffa224_context *sc, unsigned ub, unsigned n,
 static void
 luffa4(sph_luffa384_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE4
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
 	}
 
+#if SPH_X86_SIMD
+	run = luffa_select(4);
+	if (run != 0) {
+		luffa_vupdate(run, sc->V, sc->buf, &sc->ptr, data, len);
+		return;
+	}
+#endif
 	READ_STATE4(sc);
 	while (len > 0) {
 		size_t clen;
@@ -1144,13 +1783,19 @@ luffa4(sph_luffa384_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			MI4;
 			P4;
+			SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 			ptr = 0;
 		}
 	}
@@ -1165,8 +1810,19 @@ luffa4_close(sph_luffa384_context *sc, unsigned ub, unsigned n, void *dst)
 	size_t ptr;
 	unsigned z;
 	int i;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE4
 
+#if SPH_X86_SIMD
+	run = luffa_select(4);
+	if (run != 0) {
+		luffa_vclose(run, sc->V, 4, sc->buf, sc->ptr,
+			ub, n, dst, 12);
+		return;
+	}
+#endif
 	buf = sc->buf;
 	ptr = sc->ptr;
 	out = dst;
@@ -1174,6 +1830,7 @@ luffa4_close(sph_luffa384_context *sc, unsigned ub, unsigned n, void *dst)
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	READ_STATE4(sc);
+	SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 	for (i = 0; i < 3; i ++) {
 		MI4;
 		P4;
@@ -1204,19 +1861,28 @@ luffa4_close(sph_luffa384_context *sc, unsigned ub, unsigned n, void *dst)
 static void
 luffa5(sph_luffa512_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE5
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
 	}
 
+#if SPH_X86_SIMD
+	run = luffa_select(5);
+	if (run != 0) {
+		luffa_vupdate(run, sc->V, sc->buf, &sc->ptr, data, len);
+		return;
+	}
+#endif
 	READ_STATE5(sc);
 	while (len > 0) {
 		size_t clen;
@@ -1224,13 +1890,19 @@ luffa5(sph_luffa512_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			MI5;
 			P5;
+			SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 			ptr = 0;
 		}
 	}
@@ -1245,8 +1917,19 @@ luffa5_close(sph_luffa512_context *sc, unsigned ub, unsigned n, void *dst)
 	size_t ptr;
 	unsigned z;
 	int i;
+#if SPH_X86_SIMD
+	luffa_run_fn run;
+#endif
 	DECL_STATE5
 
+#if SPH_X86_SIMD
+	run = luffa_select(5);
+	if (run != 0) {
+		luffa_vclose(run, sc->V, 5, sc->buf, sc->ptr,
+			ub, n, dst, 16);
+		return;
+	}
+#endif
 	buf = sc->buf;
 	ptr = sc->ptr;
 	out = dst;
@@ -1254,6 +1937,7 @@ luffa5_close(sph_luffa512_context *sc, unsigned ub, unsigned n, void *dst)
 	buf[ptr ++] = ((ub & -z) | z) & 0xFF;
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	READ_STATE5(sc);
+	SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 1);
 	for (i = 0; i < 3; i ++) {
 		MI5;
 		P5;
@@ -1285,6 +1969,115 @@ luffa5_close(sph_luffa512_context *sc, unsigned ub, unsigned n, void *dst)
 	}
 }
 
+/*
+ * Hash one message of len bytes, starting from state V (after a whole
+ * number of blocks), with the single-message code.
+ */
+static void
+luffa_resume(int w, const void *V, const void *data, size_t len,
+	void *dst, unsigned nw)
+{
+	union {
+		sph_luffa224_context c3;
+		sph_luffa384_context c4;
+		sph_luffa512_context c5;
+	} u;
+
+	switch (w) {
+	case 3:
+		memcpy(u.c3.V, V, sizeof u.c3.V);
+		u.c3.ptr = 0;
+		luffa3(&u.c3, data, len);
+		luffa3_close(&u.c3, 0, 0, dst, nw);
+		break;
+	case 4:
+		memcpy(u.c4.V, V, sizeof u.c4.V);
+		u.c4.ptr = 0;
+		luffa4(&u.c4, data, len);
+		luffa4_close(&u.c4, 0, 0, dst);
+		break;
+	default:
+		memcpy(u.c5.V, V, sizeof u.c5.V);
+		u.c5.ptr = 0;
+		luffa5(&u.c5, data, len);
+		luffa5_close(&u.c5, 0, 0, dst);
+		break;
+	}
+}
+
+static void
+luffa_multi(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, int w, unsigned nw)
+{
+	size_t i;
+#if SPH_X86_SIMD
+	luffa_run_fn run2;
+	unsigned f;
+#endif
+
+	for (i = 0; i < num; i ++)
+		SPH_STATS_INPUT(SPH_STATS_LUFFA, len[i]);
+#if SPH_X86_SIMD
+	run2 = 0;
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		if (w == 3)
+			run2 = luffa3_run2_avx512;
+		else if (w == 4)
+			run2 = luffa4_run2_avx512;
+	} else
+#endif
+	if (f & SPH_CPU_AVX2) {
+		if (w == 3)
+			run2 = luffa3_run2_avx2;
+		else if (w == 4)
+			run2 = luffa4_run2_avx2;
+	}
+	for (; run2 != 0 && num >= 2; data += 2, len += 2, dst += 2, num -= 2) {
+		sph_u32 V[2][5][8];
+		sph_u32 (*st[2])[8];
+		const unsigned char *p[2];
+		unsigned char tail[2][32];
+		size_t nb, rem, k;
+		int u;
+
+		nb = (len[0] < len[1] ? len[0] : len[1]) >> 5;
+		for (u = 0; u < 2; u ++) {
+			memcpy(V[u], V_INIT, sizeof V[u]);
+			st[u] = V[u];
+			p[u] = data[u];
+		}
+		run2(st, p, nb);
+		SPH_STATS_BLOCKS(SPH_STATS_LUFFA, nb << 1);
+		if (len[0] != len[1]) {
+			for (u = 0; u < 2; u ++)
+				luffa_resume(w, V[u], p[u] + (nb << 5),
+					len[u] - (nb << 5), dst[u], nw);
+			continue;
+		}
+		rem = len[0] - (nb << 5);
+		for (u = 0; u < 2; u ++) {
+			memcpy(tail[u], p[u] + (nb << 5), rem);
+			tail[u][rem] = 0x80;
+			memset(tail[u] + rem + 1, 0, 31 - rem);
+			p[u] = tail[u];
+		}
+		run2(st, p, 1);
+		SPH_STATS_BLOCKS(SPH_STATS_LUFFA, 2);
+		memset(tail, 0, sizeof tail);
+		for (k = 0; k < nw; k += 8) {
+			run2(st, p, 1);
+			for (u = 0; u < 2; u ++)
+				luffa_out(V[u], w, (unsigned char *)dst[u] + 4 * k,
+					nw - k < 8 ? nw - k : 8);
+		}
+	}
+#endif
+	for (; num > 0; data ++, len ++, dst ++, num --)
+		luffa_resume(w, V_INIT, *data, *len, *dst, nw);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa224_init(void *cc)
@@ -1300,9 +2093,17 @@ sph_luffa224_init(void *cc)
 void
 sph_luffa224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_LUFFA, len);
 	luffa3(cc, data, len);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_luffa224, cc, iov, n);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa224_close(void *cc, void *dst)
@@ -1310,6 +2111,13 @@ sph_luffa224_close(void *cc, void *dst)
 	sph_luffa224_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(luffa224, data, len, dst);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1318,6 +2126,14 @@ sph_luffa224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_luffa224_init(cc);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	luffa_multi(data, len, dst, num, 3, 7);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa256_init(void *cc)
@@ -1333,9 +2149,17 @@ sph_luffa256_init(void *cc)
 void
 sph_luffa256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_LUFFA, len);
 	luffa3(cc, data, len);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_luffa256, cc, iov, n);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa256_close(void *cc, void *dst)
@@ -1343,6 +2167,13 @@ sph_luffa256_close(void *cc, void *dst)
 	sph_luffa256_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(luffa256, data, len, dst);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1351,6 +2182,14 @@ sph_luffa256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_luffa256_init(cc);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	luffa_multi(data, len, dst, num, 3, 8);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa384_init(void *cc)
@@ -1366,9 +2205,17 @@ sph_luffa384_init(void *cc)
 void
 sph_luffa384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_LUFFA, len);
 	luffa4(cc, data, len);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_luffa384, cc, iov, n);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa384_close(void *cc, void *dst)
@@ -1376,6 +2223,13 @@ sph_luffa384_close(void *cc, void *dst)
 	sph_luffa384_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(luffa384, data, len, dst);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1384,6 +2238,14 @@ sph_luffa384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	sph_luffa384_init(cc);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	luffa_multi(data, len, dst, num, 4, 12);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa512_init(void *cc)
@@ -1399,9 +2261,17 @@ sph_luffa512_init(void *cc)
 void
 sph_luffa512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_LUFFA, len);
 	luffa5(cc, data, len);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_luffa512, cc, iov, n);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa512_close(void *cc, void *dst)
@@ -1409,6 +2279,13 @@ sph_luffa512_close(void *cc, void *dst)
 	sph_luffa512_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_luffa.h */
+void
+sph_luffa512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(luffa512, data, len, dst);
+}
+
 /* see sph_luffa.h */
 void
 sph_luffa512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1416,3 +2293,11 @@ sph_luffa512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	luffa5_close(cc, ub, n, dst);
 	sph_luffa512_init(cc);
 }
+
+/* see sph_luffa.h */
+void
+sph_luffa512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	luffa_multi(data, len, dst, num, 5, 16);
+}
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_md2.h"
+#include "sph_stats.h"
 
 /*
  * The MD2 magic table.
@@ -73,6 +74,7 @@ md2_round(sph_md2_context *mc)
 	int j;
 	unsigned t, L;
 
+	SPH_STATS_BLOCKS(SPH_STATS_MD2, 1);
 	L = mc->L;
 	for (j = 0; j < 16; j ++) {
 		/*
@@ -153,6 +155,7 @@ sph_md2(void *cc, const void *data, size_t len)
 	sph_md2_context *mc;
 	unsigned current;
 
+	SPH_STATS_INPUT(SPH_STATS_MD2, len);
 	mc = cc;
 	current = mc->count;
 	if (current > 0) {
@@ -165,10 +168,11 @@ sph_md2(void *cc, const void *data, size_t len)
 		data = (const unsigned char *)data + clen;
 		current += clen;
 		len -= clen;
-		if (current == 16) {
-			md2_round(mc);
-			current = 0;
+		if (current < 16) {
+			mc->count = current;
+			return;
 		}
+		md2_round(mc);
 	}
 	while (len >= 16) {
 		memcpy(mc->u.X + 16, data, 16);
@@ -180,6 +184,13 @@ sph_md2(void *cc, const void *data, size_t len)
 	mc->count = len;
 }
 
+/* see sph_md2.h */
+void
+sph_md2_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_md2, cc, iov, n);
+}
+
 /* see sph_md2.h */
 void
 sph_md2_close(void *cc, void *dst)
@@ -197,3 +208,10 @@ sph_md2_close(void *cc, void *dst)
 	memcpy(dst, mc->u.X, 16);
 	sph_md2_init(mc);
 }
+
+/* see sph_md2.h */
+void
+sph_md2_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(md2, data, len, dst);
+}
@@ -155,6 +155,7 @@ sph_md4_init(void *cc)
 
 #define RFUN   md4_round
 #define HASH   md4
+#define STATS  SPH_STATS_MD4
 #define LE32   1
 #include "md_helper.c"
 
@@ -166,6 +167,16 @@ sph_md4_close(void *cc, void *dst)
 	sph_md4_init(cc);
 }
 
+/* see sph_md4.h */
+void
+sph_md4_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_md4_context sc;
+
+	sph_md4_init(&sc);
+	md4_oneshot(&sc, data, len, dst, 4);
+}
+
 /* see sph_md4.h */
 void
 sph_md4_comp(const sph_u32 msg[16], sph_u32 val[4])
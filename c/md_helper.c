@@ -17,6 +17,12 @@
  *   PLW1   if defined, length is defined on one 64-bit word only (for Tiger)
  *   PLW4   if defined, length is defined on four 64-bit words (for WHIRLPOOL)
  *   SVAL   if defined, reference to the context state information
+ *   RFUN_BLOCKS  if defined, name for a function processing several
+ *          consecutive blocks; used for the full blocks of long inputs
+ *   MULTI  if defined, also define the multi-message drivers HASH_multi()
+ *          and HASH_multi_ctx()
+ *   STATS  if defined, family identifier for the usage statistics
+ *          (SPH_STATS_*, see sph_stats.h)
  *
  * BLEN is used when a message block is not 16 (32-bit or 64-bit) words:
  * this is used for instance for Tiger, which works on 64-bit words but
@@ -31,6 +37,11 @@
  * improperly hashed (this is unlikely to happen soon: 2 Exabytes is about
  * 2 millions Terabytes, which is huge).
  *
+ * The sph_XXX_updatev() function (scatter-gather input) is defined along
+ * with sph_XXX(). The static XXX_oneshot() function hashes a whole
+ * message from a freshly initialized context, in a single call to RFUN
+ * when the message is short enough.
+ *
  * If CLOSE_ONLY is defined, then this file defines only the sph_XXX_close()
  * function. This is used for Tiger2, which is identical to Tiger except
  * when it comes to the padding (Tiger2 uses the standard 0x80 byte instead
@@ -48,6 +59,11 @@
  * NO_OUTPUT is defined, the third parameter to the "close()" function is
  * ignored.
  *
+ * The RFUN_BLOCKS function, if defined, is invoked with the same first
+ * and last arguments as RFUN, and the number of blocks (a "size_t")
+ * in between. The blocks are aligned as for RFUN. This lets the round
+ * code work on several blocks at a time.
+ *
  * ==========================(LICENSE BEGIN)============================
  *
  * Copyright (c) 2007-2010  Projet RNRT SAPHIR
@@ -109,6 +125,20 @@
 #define SPH_MAXPAD   (SPH_BLEN - (SPH_WLEN << 1))
 #endif
 
+#undef SPH_MD_INPUT
+#undef SPH_MD_BYTES
+#undef SPH_MD_BLOCKS
+#ifdef STATS
+#include "sph_stats.h"
+#define SPH_MD_INPUT(len)   SPH_STATS_INPUT(STATS, len)
+#define SPH_MD_BYTES(len)   SPH_STATS_BYTES(STATS, len)
+#define SPH_MD_BLOCKS(n)    SPH_STATS_BLOCKS(STATS, n)
+#else
+#define SPH_MD_INPUT(len)   ((void)0)
+#define SPH_MD_BYTES(len)   ((void)0)
+#define SPH_MD_BLOCKS(n)    ((void)0)
+#endif
+
 #undef SPH_VAL
 #undef SPH_NO_OUTPUT
 #ifdef SVAL
@@ -131,6 +161,9 @@ SPH_XCAT(sph_, HASH)(void *cc, const void *data, size_t len)
 	SPH_XCAT(sph_, SPH_XCAT(HASH, _context)) *sc;
 	unsigned current;
 
+#ifndef SPH_UPTR
+	SPH_MD_INPUT(len);
+#endif
 	sc = cc;
 #if SPH_64
 	current = (unsigned)sc->count & (SPH_BLEN - 1U);
@@ -152,6 +185,7 @@ SPH_XCAT(sph_, HASH)(void *cc, const void *data, size_t len)
 		len -= clen;
 		if (current == SPH_BLEN) {
 			RFUN(sc->buf, SPH_VAL);
+			SPH_MD_BLOCKS(1);
 			current = 0;
 		}
 #if SPH_64
@@ -177,7 +211,8 @@ SPH_XCAT(sph_, HASH)(void *cc, const void *data, size_t len)
 	sph_u32 clow, clow2;
 #endif
 
-	if (len < (2 * SPH_BLEN)) {
+	SPH_MD_INPUT(len);
+	if (len < SPH_BLEN) {
 		SPH_XCAT(HASH, _short)(cc, data, len);
 		return;
 	}
@@ -195,18 +230,23 @@ SPH_XCAT(sph_, HASH)(void *cc, const void *data, size_t len)
 		data = (const unsigned char *)data + t;
 		len -= t;
 	}
-#if !SPH_UNALIGNED
-	if (((SPH_UPTR)data & (SPH_WLEN - 1U)) != 0) {
+	if (!SPH_DIRECT_INPUT(data, SPH_WLEN)) {
 		SPH_XCAT(HASH, _short)(cc, data, len);
 		return;
 	}
-#endif
 	orig_len = len;
+	SPH_MD_BLOCKS(len / SPH_BLEN);
+#ifdef RFUN_BLOCKS
+	RFUN_BLOCKS(data, len / SPH_BLEN, SPH_VAL);
+	data = (const unsigned char *)data + len - (len % SPH_BLEN);
+	len %= SPH_BLEN;
+#else
 	while (len >= SPH_BLEN) {
 		RFUN(data, SPH_VAL);
 		len -= SPH_BLEN;
 		data = (const unsigned char *)data + SPH_BLEN;
 	}
+#endif
 	if (len > 0)
 		memcpy(sc->buf, data, len);
 #if SPH_64
@@ -229,81 +269,86 @@ SPH_XCAT(sph_, HASH)(void *cc, const void *data, size_t len)
 }
 #endif
 
+void
+SPH_XCAT(SPH_XCAT(sph_, HASH), _updatev)(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(SPH_XCAT(sph_, HASH), cc, iov, n);
+}
+
 #endif
 
 /*
- * Perform padding and produce result. The context is NOT reinitialized
- * by this function.
+ * Perform padding and produce result. The last "current" bytes of the
+ * message are in "buf", which is either the context buffer or a block
+ * provided by the caller (with the same alignment); the message length
+ * is taken from the context. The context is NOT reinitialized by this
+ * function.
  */
 static void
-SPH_XCAT(HASH, _addbits_and_close)(void *cc,
+SPH_XCAT(HASH, _final)(void *cc, unsigned char *buf, unsigned current,
 	unsigned ub, unsigned n, void *dst, unsigned rnum)
 {
 	SPH_XCAT(sph_, SPH_XCAT(HASH, _context)) *sc;
-	unsigned current, u;
+	unsigned u;
 #if !SPH_64
 	sph_u32 low, high;
 #endif
 
 	sc = cc;
-#if SPH_64
-	current = (unsigned)sc->count & (SPH_BLEN - 1U);
-#else
-	current = (unsigned)sc->count_low & (SPH_BLEN - 1U);
-#endif
 #ifdef PW01
-	sc->buf[current ++] = (0x100 | (ub & 0xFF)) >> (8 - n);
+	buf[current ++] = (0x100 | (ub & 0xFF)) >> (8 - n);
 #else
 	{
 		unsigned z;
 
 		z = 0x80 >> n;
-		sc->buf[current ++] = ((ub & -z) | z) & 0xFF;
+		buf[current ++] = ((ub & -z) | z) & 0xFF;
 	}
 #endif
 	if (current > SPH_MAXPAD) {
-		memset(sc->buf + current, 0, SPH_BLEN - current);
-		RFUN(sc->buf, SPH_VAL);
-		memset(sc->buf, 0, SPH_MAXPAD);
+		memset(buf + current, 0, SPH_BLEN - current);
+		RFUN(buf, SPH_VAL);
+		SPH_MD_BLOCKS(1);
+		memset(buf, 0, SPH_MAXPAD);
 	} else {
-		memset(sc->buf + current, 0, SPH_MAXPAD - current);
+		memset(buf + current, 0, SPH_MAXPAD - current);
 	}
 #if defined BE64
 #if defined PLW1
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64be_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #elif defined PLW4
-	memset(sc->buf + SPH_MAXPAD, 0, 2 * SPH_WLEN);
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD + 2 * SPH_WLEN,
+	memset(buf + SPH_MAXPAD, 0, 2 * SPH_WLEN);
+	sph_enc64be_aligned(buf + SPH_MAXPAD + 2 * SPH_WLEN,
 		sc->count >> 61);
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD + 3 * SPH_WLEN,
+	sph_enc64be_aligned(buf + SPH_MAXPAD + 3 * SPH_WLEN,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #else
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD, sc->count >> 61);
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD + SPH_WLEN,
+	sph_enc64be_aligned(buf + SPH_MAXPAD, sc->count >> 61);
+	sph_enc64be_aligned(buf + SPH_MAXPAD + SPH_WLEN,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #endif
 #elif defined LE64
 #if defined PLW1
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64le_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #elif defined PLW1
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64le_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD + SPH_WLEN, sc->count >> 61);
-	memset(sc->buf + SPH_MAXPAD + 2 * SPH_WLEN, 0, 2 * SPH_WLEN);
+	sph_enc64le_aligned(buf + SPH_MAXPAD + SPH_WLEN, sc->count >> 61);
+	memset(buf + SPH_MAXPAD + 2 * SPH_WLEN, 0, 2 * SPH_WLEN);
 #else
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64le_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD + SPH_WLEN, sc->count >> 61);
+	sph_enc64le_aligned(buf + SPH_MAXPAD + SPH_WLEN, sc->count >> 61);
 #endif
 #else
 #if SPH_64
 #ifdef BE32
-	sph_enc64be_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64be_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #else
-	sph_enc64le_aligned(sc->buf + SPH_MAXPAD,
+	sph_enc64le_aligned(buf + SPH_MAXPAD,
 		SPH_T64(sc->count << 3) + (sph_u64)n);
 #endif
 #else
@@ -311,15 +356,16 @@ SPH_XCAT(HASH, _addbits_and_close)(void *cc,
 	high = SPH_T32((sc->count_high << 3) | (low >> 29));
 	low = SPH_T32(low << 3) + (sph_u32)n;
 #ifdef BE32
-	sph_enc32be(sc->buf + SPH_MAXPAD, high);
-	sph_enc32be(sc->buf + SPH_MAXPAD + SPH_WLEN, low);
+	sph_enc32be(buf + SPH_MAXPAD, high);
+	sph_enc32be(buf + SPH_MAXPAD + SPH_WLEN, low);
 #else
-	sph_enc32le(sc->buf + SPH_MAXPAD, low);
-	sph_enc32le(sc->buf + SPH_MAXPAD + SPH_WLEN, high);
+	sph_enc32le(buf + SPH_MAXPAD, low);
+	sph_enc32le(buf + SPH_MAXPAD + SPH_WLEN, high);
 #endif
 #endif
 #endif
-	RFUN(sc->buf, SPH_VAL);
+	RFUN(buf, SPH_VAL);
+	SPH_MD_BLOCKS(1);
 #ifdef SPH_NO_OUTPUT
 	(void)dst;
 	(void)rnum;
@@ -339,8 +385,487 @@ SPH_XCAT(HASH, _addbits_and_close)(void *cc,
 #endif
 }
 
+static void
+SPH_XCAT(HASH, _addbits_and_close)(void *cc,
+	unsigned ub, unsigned n, void *dst, unsigned rnum)
+{
+	SPH_XCAT(sph_, SPH_XCAT(HASH, _context)) *sc;
+	unsigned current;
+
+	sc = cc;
+#if SPH_64
+	current = (unsigned)sc->count & (SPH_BLEN - 1U);
+#else
+	current = (unsigned)sc->count_low & (SPH_BLEN - 1U);
+#endif
+	SPH_XCAT(HASH, _final)(cc, sc->buf, current, ub, n, dst, rnum);
+}
+
 static void
 SPH_XCAT(HASH, _close)(void *cc, void *dst, unsigned rnum)
 {
 	SPH_XCAT(HASH, _addbits_and_close)(cc, 0, 0, dst, rnum);
 }
+
+/*
+ * Hash a complete message, the context having just been initialized.
+ * When the message and its padding fit in a single block, that block
+ * is assembled on the stack and the round function is invoked once;
+ * the context buffer is not used.
+ */
+static void
+SPH_XCAT(HASH, _oneshot)(void *cc,
+	const void *data, size_t len, void *dst, unsigned rnum)
+{
+	SPH_XCAT(sph_, SPH_XCAT(HASH, _context)) *sc;
+	union {
+		unsigned char buf[SPH_BLEN];
+#if SPH_64
+		sph_u64 dummy;
+#else
+		sph_u32 dummy;
+#endif
+	} u;
+
+	if (len >= SPH_MAXPAD) {
+		SPH_XCAT(sph_, HASH)(cc, data, len);
+		SPH_XCAT(HASH, _close)(cc, dst, rnum);
+		return;
+	}
+	SPH_MD_INPUT(len);
+	sc = cc;
+#if SPH_64
+	sc->count = len;
+#else
+	sc->count_low = (sph_u32)len;
+#endif
+	memcpy(u.buf, data, len);
+	SPH_XCAT(HASH, _final)(cc, u.buf, (unsigned)len, 0, 0, dst, rnum);
+}
+
+#ifdef MULTI
+
+#include "sph_cpu.h"
+#if SPH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/*
+ * Multi-message driver. HASH_multi() hashes "num" independent messages
+ * with a "run" function which processes several messages in parallel,
+ * one per lane. The state words are interleaved: word i of lane l is
+ * hs[i * lanes + l]. The run function processes nb blocks in each lane,
+ * the blocks of lane l being consecutive from p[l]; it needs not care
+ * about alignment. Whenever a message is finished, its lane is refilled
+ * with the next message, so that all lanes stay busy even if message
+ * lengths differ. If run is 0, or when only one message remains, RFUN
+ * is used. Only the plain padding is supported (no PW01, PLW1, PLW4 or
+ * BLEN), and RFUN must work on the "val" array (no SVAL).
+ */
+
+#undef SPH_MWORD
+#undef SPH_MLANES
+#if defined BE64 || defined LE64
+#define SPH_MWORD    sph_u64
+#define SPH_MLANES   8
+#else
+#define SPH_MWORD    sph_u32
+#define SPH_MLANES   16
+#endif
+
+/*
+ * Maximum number of state words.
+ */
+#undef SPH_MSTATE
+#define SPH_MSTATE   8
+
+#if SPH_X86_SIMD && !(defined BE64 || defined LE64)
+
+/*
+ * Message loading for the run functions: HASH_multi_load_xN() reads
+ * the blocks at p[l] + off, for l = 0 to N-1, and transposes them so
+ * that the vector at (unsigned char *)m + i * step contains word i for
+ * all N lanes. Each block is read with full vector loads. The byte swap
+ * for big-endian functions (BE32) uses pshufb with AVX2, and shifts
+ * with SSE2, which has no byte shuffle.
+ */
+
+#undef SPH_MBSWAP
+#define SPH_MBSWAP(x)   (((((x) << 8) | ((x) >> 24)) & SPH_C32(0x00FF00FF)) \
+                        | ((((x) >> 8) | ((x) << 24)) & SPH_C32(0xFF00FF00)))
+
+#undef SPH_MTR4
+#define SPH_MTR4(u, x0, x1, x2, x3, y0, y1, y2, y3)   do { \
+		t0 = u ## lo_epi32(x0, x1); \
+		t1 = u ## hi_epi32(x0, x1); \
+		t2 = u ## lo_epi32(x2, x3); \
+		t3 = u ## hi_epi32(x2, x3); \
+		y0 = u ## lo_epi64(t0, t2); \
+		y1 = u ## hi_epi64(t0, t2); \
+		y2 = u ## lo_epi64(t1, t3); \
+		y3 = u ## hi_epi64(t1, t3); \
+	} while (0)
+
+#undef SPH_MOUT
+#define SPH_MOUT(type, i)   ((type *)((unsigned char *)m + (i) * step))
+
+SPH_TARGET("sse2") static SPH_INLINE void
+SPH_XCAT(HASH, _multi_load_x4)(void *m, size_t step,
+	const unsigned char *const *p, size_t off)
+{
+	__m128i a0, a1, a2, a3, t0, t1, t2, t3, b[4];
+	int i, j;
+
+	for (j = 0; j < 4; j ++) {
+		a0 = _mm_loadu_si128((const __m128i *)(p[0] + off) + j);
+		a1 = _mm_loadu_si128((const __m128i *)(p[1] + off) + j);
+		a2 = _mm_loadu_si128((const __m128i *)(p[2] + off) + j);
+		a3 = _mm_loadu_si128((const __m128i *)(p[3] + off) + j);
+		SPH_MTR4(_mm_unpack, a0, a1, a2, a3, b[0], b[1], b[2], b[3]);
+		for (i = 0; i < 4; i ++) {
+#ifdef BE32
+			sph_v32x4 x = (sph_v32x4)b[i];
+
+			b[i] = (__m128i)SPH_MBSWAP(x);
+#endif
+			_mm_storeu_si128(SPH_MOUT(__m128i, 4 * j + i), b[i]);
+		}
+	}
+}
+
+SPH_TARGET("avx2") static SPH_INLINE void
+SPH_XCAT(HASH, _multi_load_x8)(void *m, size_t step,
+	const unsigned char *const *p, size_t off)
+{
+	__m256i a0, a1, a2, a3, a4, a5, a6, a7, t0, t1, t2, t3, b[4], c[4];
+	int i, j;
+
+	for (j = 0; j < 2; j ++) {
+		a0 = _mm256_loadu_si256((const __m256i *)(p[0] + off) + j);
+		a1 = _mm256_loadu_si256((const __m256i *)(p[1] + off) + j);
+		a2 = _mm256_loadu_si256((const __m256i *)(p[2] + off) + j);
+		a3 = _mm256_loadu_si256((const __m256i *)(p[3] + off) + j);
+		a4 = _mm256_loadu_si256((const __m256i *)(p[4] + off) + j);
+		a5 = _mm256_loadu_si256((const __m256i *)(p[5] + off) + j);
+		a6 = _mm256_loadu_si256((const __m256i *)(p[6] + off) + j);
+		a7 = _mm256_loadu_si256((const __m256i *)(p[7] + off) + j);
+		SPH_MTR4(_mm256_unpack, a0, a1, a2, a3, b[0], b[1], b[2], b[3]);
+		SPH_MTR4(_mm256_unpack, a4, a5, a6, a7, c[0], c[1], c[2], c[3]);
+		for (i = 0; i < 4; i ++) {
+			__m256i x, y;
+
+			x = _mm256_permute2x128_si256(b[i], c[i], 0x20);
+			y = _mm256_permute2x128_si256(b[i], c[i], 0x31);
+#ifdef BE32
+			{
+				__m256i bs;
+
+				bs = _mm256_setr_epi8(
+					3, 2, 1, 0, 7, 6, 5, 4,
+					11, 10, 9, 8, 15, 14, 13, 12,
+					3, 2, 1, 0, 7, 6, 5, 4,
+					11, 10, 9, 8, 15, 14, 13, 12);
+				x = _mm256_shuffle_epi8(x, bs);
+				y = _mm256_shuffle_epi8(y, bs);
+			}
+#endif
+			_mm256_storeu_si256(SPH_MOUT(__m256i, 8 * j + i), x);
+			_mm256_storeu_si256(SPH_MOUT(__m256i, 8 * j + i + 4), y);
+		}
+	}
+}
+
+#endif
+
+#if SPH_X86_SIMD && (defined BE64 || defined LE64)
+
+/*
+ * Message loading for 64-bit words (AVX2): same contract as the 32-bit
+ * loaders above, for four lanes.
+ */
+
+SPH_TARGET("avx2") static SPH_INLINE void
+SPH_XCAT(HASH, _multi_load_x4)(void *m, size_t step,
+	const unsigned char *const *p, size_t off)
+{
+	__m256i a0, a1, a2, a3, t0, t1, t2, t3, b[4];
+	int i, j;
+
+	for (j = 0; j < 4; j ++) {
+		a0 = _mm256_loadu_si256((const __m256i *)(p[0] + off) + j);
+		a1 = _mm256_loadu_si256((const __m256i *)(p[1] + off) + j);
+		a2 = _mm256_loadu_si256((const __m256i *)(p[2] + off) + j);
+		a3 = _mm256_loadu_si256((const __m256i *)(p[3] + off) + j);
+		t0 = _mm256_unpacklo_epi64(a0, a1);
+		t1 = _mm256_unpackhi_epi64(a0, a1);
+		t2 = _mm256_unpacklo_epi64(a2, a3);
+		t3 = _mm256_unpackhi_epi64(a2, a3);
+		b[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+		b[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+		b[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+		b[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+		for (i = 0; i < 4; i ++) {
+#ifdef BE64
+			__m256i bs;
+
+			bs = _mm256_setr_epi8(
+				7, 6, 5, 4, 3, 2, 1, 0,
+				15, 14, 13, 12, 11, 10, 9, 8,
+				7, 6, 5, 4, 3, 2, 1, 0,
+				15, 14, 13, 12, 11, 10, 9, 8);
+			b[i] = _mm256_shuffle_epi8(b[i], bs);
+#endif
+			_mm256_storeu_si256((__m256i *)((unsigned char *)m
+				+ (4 * j + i) * step), b[i]);
+		}
+	}
+}
+
+#endif
+
+/*
+ * Build the padding block(s) for a message of "len" bytes whose last
+ * "rem" bytes (less than a block) are at "src". Returned value is the
+ * number of blocks (1 or 2).
+ */
+static size_t
+SPH_XCAT(HASH, _multi_pad)(unsigned char *dst,
+	const unsigned char *src, size_t rem, size_t len)
+{
+	size_t tl;
+
+	tl = rem >= SPH_MAXPAD ? (SPH_BLEN << 1) : SPH_BLEN;
+	memcpy(dst, src, rem);
+	dst[rem] = 0x80;
+	memset(dst + rem + 1, 0, tl - rem - 1 - (SPH_WLEN << 1));
+#if defined BE64
+	sph_enc64be(dst + tl - 16, (sph_u64)len >> 61);
+	sph_enc64be(dst + tl - 8, SPH_T64((sph_u64)len << 3));
+#elif defined LE64
+	sph_enc64le(dst + tl - 16, SPH_T64((sph_u64)len << 3));
+	sph_enc64le(dst + tl - 8, (sph_u64)len >> 61);
+#elif defined BE32
+	sph_enc32be(dst + tl - 8, SPH_T32((sph_u32)(len >> 29)));
+	sph_enc32be(dst + tl - 4, SPH_T32((sph_u32)len << 3));
+#else
+	sph_enc32le(dst + tl - 8, SPH_T32((sph_u32)len << 3));
+	sph_enc32le(dst + tl - 4, SPH_T32((sph_u32)(len >> 29)));
+#endif
+	return tl / SPH_BLEN;
+}
+
+/*
+ * Process nb blocks with RFUN.
+ */
+static void
+SPH_XCAT(HASH, _multi_blocks)(const unsigned char *src, size_t nb,
+	SPH_MWORD *st)
+{
+	SPH_MD_BLOCKS(nb);
+	while (nb -- > 0) {
+#if SPH_UNALIGNED
+		RFUN(src, st);
+#else
+		SPH_MWORD tmp[SPH_BLEN / sizeof(SPH_MWORD)];
+
+		memcpy(tmp, src, SPH_BLEN);
+		RFUN((const unsigned char *)tmp, st);
+#endif
+		src += SPH_BLEN;
+	}
+}
+
+static void
+SPH_XCAT(HASH, _multi_out)(void *dst, const SPH_MWORD *st, size_t step,
+	unsigned rnum)
+{
+	unsigned u;
+
+	for (u = 0; u < rnum; u ++) {
+#if defined BE64
+		sph_enc64be((unsigned char *)dst + 8 * u, st[u * step]);
+#elif defined LE64
+		sph_enc64le((unsigned char *)dst + 8 * u, st[u * step]);
+#elif defined BE32
+		sph_enc32be((unsigned char *)dst + 4 * u, st[u * step]);
+#else
+		sph_enc32le((unsigned char *)dst + 4 * u, st[u * step]);
+#endif
+	}
+}
+
+/*
+ * Process nb full blocks for each of "num" contexts, the blocks of
+ * context i being consecutive from p[i]. The contexts must not have
+ * buffered data (their message length is a multiple of the block size).
+ * Contexts are handled in groups of "lanes" with the run function;
+ * in an incomplete group, the idle lanes hash the data of the first
+ * context of the group, and their results are ignored. This is not an
+ * input call of its own (the callers feed the rest of each message
+ * with the update function), so only the bytes and blocks are counted.
+ */
+static void
+SPH_XCAT(HASH, _multi_ctx)(void *const *cc, const unsigned char *const *p,
+	size_t nb, size_t num, unsigned nw,
+	void (*run)(const unsigned char *const *p, size_t nb, SPH_MWORD *hs),
+	unsigned lanes)
+{
+	SPH_MWORD hs[SPH_MSTATE * SPH_MLANES];
+	const unsigned char *q[SPH_MLANES];
+	size_t u;
+	unsigned l, n, w;
+
+	if (run == 0)
+		lanes = 1;
+	for (u = 0; u < num; u += n) {
+		SPH_XCAT(sph_, SPH_XCAT(HASH, _context)) *sc;
+
+		n = num - u < lanes ? (unsigned)(num - u) : lanes;
+		if (n == 1) {
+			sc = cc[u];
+			SPH_XCAT(HASH, _multi_blocks)(p[u], nb, sc->val);
+		} else {
+			for (l = 0; l < lanes; l ++) {
+				sc = cc[u + (l < n ? l : 0)];
+				q[l] = p[u + (l < n ? l : 0)];
+				for (w = 0; w < nw; w ++)
+					hs[w * lanes + l] = sc->val[w];
+			}
+			run(q, nb, hs);
+			SPH_MD_BLOCKS(nb * n);
+			for (l = 0; l < n; l ++) {
+				sc = cc[u + l];
+				for (w = 0; w < nw; w ++)
+					sc->val[w] = hs[w * lanes + l];
+			}
+		}
+		for (l = 0; l < n; l ++) {
+#if !SPH_64
+			sph_u32 clow, clow2;
+#endif
+
+			sc = cc[u + l];
+#if SPH_64
+			sc->count += (sph_u64)nb * SPH_BLEN;
+#else
+			clow = sc->count_low;
+			clow2 = SPH_T32(clow + (sph_u32)(nb * SPH_BLEN));
+			sc->count_low = clow2;
+			if (clow2 < clow)
+				sc->count_high ++;
+#endif
+		}
+		SPH_MD_BYTES(nb * n * SPH_BLEN);
+	}
+}
+
+static void
+SPH_XCAT(HASH, _multi)(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, const SPH_MWORD *iv,
+	unsigned nw, unsigned rnum,
+	void (*run)(const unsigned char *const *p, size_t nb, SPH_MWORD *hs),
+	unsigned lanes)
+{
+	SPH_MWORD hs[SPH_MSTATE * SPH_MLANES], st[SPH_MSTATE];
+	SPH_MWORD tail[SPH_MLANES][(SPH_BLEN << 1) / sizeof(SPH_MWORD)];
+	const unsigned char *src[SPH_MLANES], *tp[SPH_MLANES];
+	const unsigned char *p[SPH_MLANES];
+	size_t nb[SPH_MLANES], nt[SPH_MLANES];
+	void *out[SPH_MLANES];
+	unsigned active, l, w;
+
+	if (run == 0)
+		lanes = 1;
+	for (l = 0; l < lanes; l ++)
+		out[l] = 0;
+	active = 0;
+	for (;;) {
+		size_t k;
+		unsigned first;
+
+		for (l = 0; l < lanes && num > 0; l ++) {
+			size_t rem;
+
+			if (out[l] != 0)
+				continue;
+			SPH_MD_INPUT(*len);
+			src[l] = *data;
+			nb[l] = *len / SPH_BLEN;
+			rem = *len - nb[l] * SPH_BLEN;
+			tp[l] = (const unsigned char *)tail[l];
+			nt[l] = SPH_XCAT(HASH, _multi_pad)(
+				(unsigned char *)tail[l],
+				src[l] + nb[l] * SPH_BLEN, rem, *len);
+			out[l] = *dst;
+			for (w = 0; w < nw; w ++)
+				hs[w * lanes + l] = iv[w];
+			active ++;
+			data ++;
+			len ++;
+			dst ++;
+			num --;
+		}
+		if (active == 0)
+			return;
+		if (active == 1 && (num == 0 || run == 0)) {
+			for (l = 0; out[l] == 0; l ++);
+			for (w = 0; w < nw; w ++)
+				st[w] = hs[w * lanes + l];
+			SPH_XCAT(HASH, _multi_blocks)(src[l], nb[l], st);
+			SPH_XCAT(HASH, _multi_blocks)(tp[l], nt[l], st);
+			SPH_XCAT(HASH, _multi_out)(out[l], st, 1, rnum);
+			out[l] = 0;
+			active = 0;
+			continue;
+		}
+
+		/*
+		 * Run all lanes up to the next end of a data or padding
+		 * segment. Idle lanes (at the end of the batch) hash the
+		 * data of an active lane, and their results are ignored.
+		 */
+		k = 0;
+		first = lanes;
+		for (l = 0; l < lanes; l ++) {
+			size_t r;
+
+			if (out[l] == 0)
+				continue;
+			if (first == lanes)
+				first = l;
+			if (nb[l] > 0) {
+				r = nb[l];
+				p[l] = src[l];
+			} else {
+				r = nt[l];
+				p[l] = tp[l];
+			}
+			if (k == 0 || r < k)
+				k = r;
+		}
+		for (l = 0; l < lanes; l ++)
+			if (out[l] == 0)
+				p[l] = p[first];
+		run(p, k, hs);
+		SPH_MD_BLOCKS(k * active);
+		for (l = 0; l < lanes; l ++) {
+			if (out[l] == 0)
+				continue;
+			if (nb[l] > 0) {
+				nb[l] -= k;
+				src[l] += k * SPH_BLEN;
+			} else {
+				nt[l] -= k;
+				tp[l] += k * SPH_BLEN;
+			}
+			if (nb[l] == 0 && nt[l] == 0) {
+				SPH_XCAT(HASH, _multi_out)(out[l],
+					hs + l, lanes, rnum);
+				out[l] = 0;
+				active --;
+			}
+		}
+	}
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_panama.h"
+#include "sph_stats.h"
 
 #define LVAR17(b)  sph_u32 \
 	b ## 0, b ## 1, b ## 2, b ## 3, b ## 4, b ## 5, \
@@ -176,6 +177,7 @@ panama_push(sph_panama_context *sc, const unsigned char *pbuf, size_t num)
 #endif
 #define INW2(i)   INW1(i)
 
+	SPH_STATS_BLOCKS(SPH_STATS_PANAMA, num);
 	M17(RSTATE);
 	ptr0 = sc->buffer_ptr;
 	while (num -- > 0) {
@@ -256,6 +258,9 @@ sph_panama(void *cc, const void *data, size_t len)
 	sph_panama_context *sc;
 	unsigned current;
 
+#ifndef SPH_UPTR
+	SPH_STATS_INPUT(SPH_STATS_PANAMA, len);
+#endif
 	sc = cc;
 	current = sc->data_ptr;
 	while (len > 0) {
@@ -285,6 +290,7 @@ sph_panama(void *cc, const void *data, size_t len)
 	unsigned current;
 	size_t rlen;
 
+	SPH_STATS_INPUT(SPH_STATS_PANAMA, len);
 	if (len < (2 * sizeof sc->data)) {
 		panama_short(cc, data, len);
 		return;
@@ -314,6 +320,13 @@ sph_panama(void *cc, const void *data, size_t len)
 }
 #endif
 
+/* see sph_panama.h */
+void
+sph_panama_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_panama, cc, iov, n);
+}
+
 /* see sph_panama.h */
 void
 sph_panama_close(void *cc, void *dst)
@@ -332,3 +345,10 @@ sph_panama_close(void *cc, void *dst)
 		sph_enc32le((unsigned char *)dst + 4 * i, sc->state[i + 9]);
 	sph_panama_init(sc);
 }
+
+/* see sph_panama.h */
+void
+sph_panama_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(panama, data, len, dst);
+}
@@ -0,0 +1,795 @@
+/* $Id$ */
+/*
+ * Thread pool for parallel bulk hashing.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#if defined __linux__ && !defined _GNU_SOURCE
+#define _GNU_SOURCE   1
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sph_pool.h"
+
+#if SPH_64
+
+#if SPH_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#if defined __linux__
+#include <sched.h>
+#endif
+#endif
+
+/*
+ * Per-thread state: the scratch area (first field, for alignment) and
+ * the deque of grains, which is the range lo..hi-1; grain g covers the
+ * items g*grain to (g+1)*grain-1. The owner takes grains at lo, thieves
+ * take the upper half. The slots are spaced by SLOT_STRIDE bytes, so
+ * that all scratch areas are aligned and the deques of distinct threads
+ * do not share cache lines.
+ */
+typedef struct {
+	unsigned char scratch[SPH_POOL_SCRATCH];
+	sph_pool *pool;
+	unsigned id;
+	size_t lo, hi;
+#if SPH_THREADS
+	pthread_mutex_t lock;
+#endif
+} pool_slot;
+
+#define SLOT_STRIDE   ((sizeof(pool_slot) + 63) & ~(size_t)63)
+#define SLOT(p, i) \
+	((pool_slot *)((unsigned char *)(p)->slot + (size_t)(i) * SLOT_STRIDE))
+
+/*
+ * A run. Before processing its first grain, each thread clears the
+ * first "clear" bytes of its scratch area; when all the items have been
+ * processed, the calling thread passes the scratch area of each
+ * participating thread to "merge" (if not NULL).
+ */
+typedef struct {
+	sph_pool_fun fun;
+	void *arg;
+	size_t num, grain;
+	size_t clear;
+	void (*merge)(void *arg, void *scratch);
+} pool_task;
+
+/*
+ * "slots" is the number of allocated and initialized slots; "threads"
+ * may be lower if some workers could not be started.
+ */
+struct sph_pool_ {
+	void *mem;
+	void *slot;
+	unsigned slots, threads;
+	pool_task task;
+#if SPH_THREADS
+	pthread_t *tid;
+	pthread_mutex_t run, lock;
+	pthread_cond_t wake, idle;
+	unsigned long gen;
+	unsigned busy;
+	int stop;
+#else
+	int running;
+#endif
+};
+
+/*
+ * Maximum number of items in one grain for the hashing entry points
+ * (enough to fill the lanes of the multi-message code), and target
+ * number of bytes per grain in tree mode.
+ */
+#define POOL_GRAIN         64
+#define POOL_GRAIN_BYTES   16384
+
+#if SPH_THREADS
+
+#define LOCK(s)     pthread_mutex_lock(&(s)->lock)
+#define UNLOCK(s)   pthread_mutex_unlock(&(s)->lock)
+
+/*
+ * The pool served by the current thread (while it runs work items),
+ * to detect nested runs.
+ */
+static pthread_key_t pool_key;
+static pthread_once_t pool_key_once = PTHREAD_ONCE_INIT;
+
+static void
+pool_key_init(void)
+{
+	pthread_key_create(&pool_key, NULL);
+}
+
+#else
+
+#define LOCK(s)     ((void)0)
+#define UNLOCK(s)   ((void)0)
+
+#endif
+
+#if SPH_THREADS
+
+/*
+ * Number of processors available to the calling thread: its affinity
+ * mask (which reflects taskset and cgroup cpusets) where it can be
+ * read, the number of online processors otherwise.
+ */
+static unsigned
+pool_cpus(void)
+{
+#if defined __linux__ && defined CPU_COUNT
+	cpu_set_t cs;
+#endif
+#if defined _SC_NPROCESSORS_ONLN
+	long n;
+#endif
+
+#if defined __linux__ && defined CPU_COUNT
+	if (sched_getaffinity(0, sizeof cs, &cs) == 0 && CPU_COUNT(&cs) > 0)
+		return (unsigned)CPU_COUNT(&cs);
+#endif
+#if defined _SC_NPROCESSORS_ONLN
+	n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n > 1)
+		return (unsigned)n;
+#endif
+	return 1;
+}
+
+#if defined __linux__ && defined CPU_COUNT
+#define POOL_PIN   1
+#else
+#define POOL_PIN   0
+#endif
+
+#if POOL_PIN
+
+/*
+ * Pin thread t to the processor of rank k (modulo their number) in the
+ * affinity mask "allowed", so that the workers only use the processors
+ * granted to the process.
+ */
+static void
+pool_pin(pthread_t t, const cpu_set_t *allowed, unsigned k)
+{
+	cpu_set_t cs;
+	int c, n;
+
+	n = CPU_COUNT(allowed);
+	if (n <= 0)
+		return;
+	k %= (unsigned)n;
+	for (c = 0; c < CPU_SETSIZE; c ++) {
+		if (!CPU_ISSET(c, allowed))
+			continue;
+		if (k -- == 0) {
+			CPU_ZERO(&cs);
+			CPU_SET(c, &cs);
+			pthread_setaffinity_np(t, sizeof cs, &cs);
+			return;
+		}
+	}
+}
+
+#endif
+
+#endif
+
+/*
+ * Move the upper half of the deque of another thread (the first one,
+ * in order from self, which is not empty) to the deque of thread self.
+ * Returned value is 0 if all the other deques are empty.
+ */
+static int
+pool_steal(sph_pool *p, unsigned self)
+{
+	unsigned k;
+
+	for (k = 1; k < p->threads; k ++) {
+		pool_slot *v;
+		size_t lo, hi;
+
+		v = SLOT(p, (self + k) % p->threads);
+		LOCK(v);
+		lo = v->lo;
+		hi = v->hi;
+		if (lo < hi) {
+			lo += (hi - lo) >> 1;
+			v->hi = lo;
+		}
+		UNLOCK(v);
+		if (lo < hi) {
+			pool_slot *s;
+
+			s = SLOT(p, self);
+			LOCK(s);
+			s->lo = lo;
+			s->hi = hi;
+			UNLOCK(s);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Participate in the current run as thread self, until no grain is
+ * left in any deque.
+ */
+static void
+pool_work(sph_pool *p, unsigned self)
+{
+	const pool_task *t;
+	pool_slot *s;
+
+	t = &p->task;
+	s = SLOT(p, self);
+	if (t->clear > 0)
+		memset(s->scratch, 0, t->clear);
+	for (;;) {
+		size_t g, start, end;
+		int ok;
+
+		LOCK(s);
+		g = s->lo;
+		ok = g < s->hi;
+		if (ok)
+			s->lo = g + 1;
+		UNLOCK(s);
+		if (!ok) {
+			if (pool_steal(p, self))
+				continue;
+			return;
+		}
+		start = g * t->grain;
+		end = t->num - start < t->grain ? t->num : start + t->grain;
+		t->fun(t->arg, start, end, s->scratch);
+	}
+}
+
+#if SPH_THREADS
+
+static void *
+pool_main(void *arg)
+{
+	pool_slot *s;
+	sph_pool *p;
+	unsigned long gen;
+
+	s = arg;
+	p = s->pool;
+	pthread_setspecific(pool_key, p);
+
+	/*
+	 * The first run may have started before this thread, so the
+	 * generation is compared with its value at creation.
+	 */
+	gen = 0;
+	pthread_mutex_lock(&p->lock);
+	for (;;) {
+		while (p->gen == gen && !p->stop)
+			pthread_cond_wait(&p->wake, &p->lock);
+		if (p->stop)
+			break;
+		gen = p->gen;
+		pthread_mutex_unlock(&p->lock);
+		pool_work(p, s->id);
+		pthread_mutex_lock(&p->lock);
+		if (-- p->busy == 0)
+			pthread_cond_signal(&p->idle);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return NULL;
+}
+
+#endif
+
+/* see sph_pool.h */
+sph_pool *
+sph_pool_new(unsigned threads, unsigned flags)
+{
+	sph_pool *p;
+	unsigned i;
+#if SPH_THREADS && POOL_PIN
+	cpu_set_t allowed;
+#endif
+
+#if SPH_THREADS
+	if (threads == 0)
+		threads = pool_cpus();
+	pthread_once(&pool_key_once, &pool_key_init);
+#else
+	threads = 1;
+#endif
+	p = malloc(sizeof *p);
+	if (p == NULL)
+		return NULL;
+	p->mem = malloc(threads * SLOT_STRIDE + 63);
+	if (p->mem == NULL) {
+		free(p);
+		return NULL;
+	}
+#ifdef SPH_UPTR
+	p->slot = (unsigned char *)p->mem
+		+ ((64 - ((SPH_UPTR)p->mem & 63)) & 63);
+#else
+	p->slot = p->mem;
+#endif
+	p->slots = p->threads = threads;
+	for (i = 0; i < threads; i ++) {
+		pool_slot *s;
+
+		s = SLOT(p, i);
+		s->pool = p;
+		s->id = i;
+		s->lo = s->hi = 0;
+#if SPH_THREADS
+		pthread_mutex_init(&s->lock, NULL);
+#endif
+	}
+#if SPH_THREADS
+	p->tid = malloc(threads * sizeof *p->tid);
+	if (p->tid == NULL) {
+		for (i = 0; i < threads; i ++)
+			pthread_mutex_destroy(&SLOT(p, i)->lock);
+		free(p->mem);
+		free(p);
+		return NULL;
+	}
+	pthread_mutex_init(&p->run, NULL);
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->wake, NULL);
+	pthread_cond_init(&p->idle, NULL);
+	p->gen = 0;
+	p->busy = 0;
+	p->stop = 0;
+
+	/*
+	 * If a worker cannot be started, the pool keeps the threads
+	 * which could.
+	 */
+#if POOL_PIN
+	if ((flags & SPH_POOL_PIN) != 0
+		&& sched_getaffinity(0, sizeof allowed, &allowed) != 0)
+		flags &= ~(unsigned)SPH_POOL_PIN;
+#endif
+	for (i = 1; i < threads; i ++) {
+		if (pthread_create(&p->tid[i], NULL,
+			&pool_main, SLOT(p, i)) != 0)
+			break;
+#if POOL_PIN
+		if (flags & SPH_POOL_PIN)
+			pool_pin(p->tid[i], &allowed, i);
+#endif
+	}
+	p->threads = i;
+#else
+	p->running = 0;
+#endif
+	(void)flags;
+	return p;
+}
+
+/* see sph_pool.h */
+void
+sph_pool_free(sph_pool *p)
+{
+#if SPH_THREADS
+	unsigned i;
+#endif
+
+	if (p == NULL)
+		return;
+#if SPH_THREADS
+	pthread_mutex_lock(&p->lock);
+	p->stop = 1;
+	pthread_cond_broadcast(&p->wake);
+	pthread_mutex_unlock(&p->lock);
+	for (i = 1; i < p->threads; i ++)
+		pthread_join(p->tid[i], NULL);
+	for (i = 0; i < p->slots; i ++)
+		pthread_mutex_destroy(&SLOT(p, i)->lock);
+	pthread_mutex_destroy(&p->run);
+	pthread_mutex_destroy(&p->lock);
+	pthread_cond_destroy(&p->wake);
+	pthread_cond_destroy(&p->idle);
+	free(p->tid);
+#endif
+	free(p->mem);
+	free(p);
+}
+
+/*
+ * The process-wide pool, created on first use. It is NULL if it could
+ * not be created, in which case the runs are serial.
+ */
+static sph_pool *pool_default = NULL;
+
+#if SPH_THREADS
+
+static pthread_once_t pool_default_once = PTHREAD_ONCE_INIT;
+
+static void
+pool_default_init(void)
+{
+	pool_default = sph_pool_new(0, 0);
+}
+
+#endif
+
+static sph_pool *
+pool_get(sph_pool *p)
+{
+	if (p != NULL)
+		return p;
+#if SPH_THREADS
+	pthread_once(&pool_default_once, &pool_default_init);
+#else
+	if (pool_default == NULL)
+		pool_default = sph_pool_new(1, 0);
+#endif
+	return pool_default;
+}
+
+/* see sph_pool.h */
+unsigned
+sph_pool_threads(sph_pool *p)
+{
+	p = pool_get(p);
+	return p == NULL ? 1 : p->threads;
+}
+
+/*
+ * Process a run in the calling thread alone, with a scratch area on
+ * the stack (for nested runs, and when no pool is available).
+ */
+static void
+pool_exec_serial(const pool_task *t)
+{
+	union {
+		unsigned char b[SPH_POOL_SCRATCH + 63];
+		sph_u64 align;
+	} buf;
+	unsigned char *scratch;
+	size_t start;
+
+#ifdef SPH_UPTR
+	scratch = buf.b + ((64 - ((SPH_UPTR)buf.b & 63)) & 63);
+#else
+	scratch = buf.b;
+#endif
+	if (t->clear > 0)
+		memset(scratch, 0, t->clear);
+	for (start = 0; start < t->num; start += t->grain) {
+		size_t end;
+
+		end = t->num - start < t->grain ? t->num : start + t->grain;
+		t->fun(t->arg, start, end, scratch);
+	}
+	if (t->merge != 0)
+		t->merge(t->arg, scratch);
+}
+
+static void
+pool_exec(sph_pool *p, pool_task *t)
+{
+	size_t ng, q, r;
+	unsigned i, used;
+#if SPH_THREADS
+	void *outer;
+#endif
+
+	if (t->num == 0)
+		return;
+	if (t->grain == 0)
+		t->grain = 1;
+	p = pool_get(p);
+	if (p == NULL) {
+		pool_exec_serial(t);
+		return;
+	}
+#if SPH_THREADS
+	outer = pthread_getspecific(pool_key);
+	if (outer == p) {
+		pool_exec_serial(t);
+		return;
+	}
+	pthread_mutex_lock(&p->run);
+	pthread_setspecific(pool_key, p);
+#else
+	if (p->running) {
+		pool_exec_serial(t);
+		return;
+	}
+	p->running = 1;
+#endif
+
+	/*
+	 * Each thread starts with an equal share of the grains. The
+	 * workers are idle, so the deques are set without locking.
+	 */
+	p->task = *t;
+	ng = (t->num - 1) / t->grain + 1;
+	q = ng / p->threads;
+	r = ng % p->threads;
+	for (i = 0; i < p->threads; i ++) {
+		pool_slot *s;
+
+		s = SLOT(p, i);
+		s->lo = i * q + (i < r ? i : r);
+		s->hi = s->lo + q + (i < r);
+	}
+	used = ng > 1 ? p->threads : 1;
+#if SPH_THREADS
+	if (used > 1) {
+		pthread_mutex_lock(&p->lock);
+		p->gen ++;
+		p->busy = used - 1;
+		pthread_cond_broadcast(&p->wake);
+		pthread_mutex_unlock(&p->lock);
+	}
+#endif
+	pool_work(p, 0);
+#if SPH_THREADS
+	if (used > 1) {
+		pthread_mutex_lock(&p->lock);
+		while (p->busy > 0)
+			pthread_cond_wait(&p->idle, &p->lock);
+		pthread_mutex_unlock(&p->lock);
+	}
+#endif
+	if (t->merge != 0)
+		for (i = 0; i < used; i ++)
+			t->merge(t->arg, SLOT(p, i)->scratch);
+#if SPH_THREADS
+	pthread_setspecific(pool_key, outer);
+	pthread_mutex_unlock(&p->run);
+#else
+	p->running = 0;
+#endif
+}
+
+/* see sph_pool.h */
+void
+sph_pool_run(sph_pool *p, sph_pool_fun fun, void *arg,
+	size_t num, size_t grain)
+{
+	pool_task t;
+
+	t.fun = fun;
+	t.arg = arg;
+	t.num = num;
+	t.grain = grain;
+	t.clear = 0;
+	t.merge = 0;
+	pool_exec(p, &t);
+}
+
+/*
+ * Grain for num items: about four grains per thread, so that stealing
+ * can even out the load, but no more than max items per grain.
+ */
+static size_t
+pool_grain(sph_pool *p, size_t num, size_t max)
+{
+	size_t g;
+
+	g = num / (4 * (size_t)sph_pool_threads(p));
+	if (g > max)
+		g = max;
+	if (g < 1)
+		g = 1;
+	return g;
+}
+
+typedef struct {
+	unsigned alg;
+	const void *const *data;
+	const size_t *len;
+	void *const *dst;
+} batch_arg;
+
+/*
+ * The messages of a grain go straight to sph_hash_batch(), without any
+ * copy of their descriptors; the scratch area is not needed.
+ */
+static void
+batch_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	const batch_arg *b;
+
+	(void)scratch;
+	b = arg;
+	sph_hash_batch(b->alg, b->data + start, b->len + start,
+		b->dst + start, end - start);
+}
+
+/* see sph_pool.h */
+void
+sph_hash_batch_par(sph_pool *p, unsigned alg,
+	const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	batch_arg b;
+
+	b.alg = alg;
+	b.data = data;
+	b.len = len;
+	b.dst = dst;
+	sph_pool_run(p, &batch_fun, &b, num, pool_grain(p, num, POOL_GRAIN));
+}
+
+/*
+ * In the chains, each thread accumulates its lane occupancy counters
+ * in its scratch area; they are added to the caller's counters at the
+ * end of the run.
+ */
+typedef struct {
+	const void *const *data;
+	const size_t *len;
+	void *const *dst;
+	const unsigned char *order;
+	size_t steps;
+	sph_chain_stats *stats;
+} chain_arg;
+
+static void
+chain_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	const chain_arg *c;
+
+	c = arg;
+	sph_chain_multi(c->data + start, c->len + start, c->dst + start,
+		end - start, c->order + start * c->steps, c->steps,
+		c->stats == NULL ? NULL : (sph_chain_stats *)scratch);
+}
+
+static void
+chain_merge(void *arg, void *scratch)
+{
+	const chain_arg *c;
+	const sph_chain_stats *s;
+	unsigned u;
+
+	c = arg;
+	s = scratch;
+	for (u = 0; u < SPH_CHAIN_NUM; u ++) {
+		c->stats->calls[u] += s->calls[u];
+		c->stats->lanes[u] += s->lanes[u];
+	}
+}
+
+/* see sph_pool.h */
+int
+sph_chain_multi_par(sph_pool *p,
+	const void *const *data, const size_t *len,
+	void *const *dst, size_t num,
+	const unsigned char *order, size_t steps, sph_chain_stats *stats)
+{
+	chain_arg c;
+	pool_task t;
+	size_t u;
+
+	for (u = 0; u < num * steps; u ++)
+		if (order[u] >= SPH_CHAIN_NUM)
+			return 0;
+	c.data = data;
+	c.len = len;
+	c.dst = dst;
+	c.order = order;
+	c.steps = steps;
+	c.stats = stats;
+	t.fun = &chain_fun;
+	t.arg = &c;
+	t.num = num;
+	t.grain = pool_grain(p, num, POOL_GRAIN);
+	t.clear = stats == NULL ? 0 : sizeof(sph_chain_stats);
+	t.merge = stats == NULL ? 0 : &chain_merge;
+	pool_exec(p, &t);
+	return 1;
+}
+
+typedef struct {
+	unsigned alg;
+	const unsigned char *data;
+	size_t len, leaf;
+	unsigned char *out;
+	size_t hlen;
+} tree_arg;
+
+/*
+ * Leaf descriptors of a grain, built in the scratch area of the thread
+ * (1.5 kB on 64-bit systems).
+ */
+typedef struct {
+	const void *data[POOL_GRAIN];
+	size_t len[POOL_GRAIN];
+	void *dst[POOL_GRAIN];
+} tree_work;
+
+static void
+tree_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	const tree_arg *a;
+	tree_work *w;
+	size_t u;
+
+	a = arg;
+	w = scratch;
+	for (u = 0; start + u < end; u ++) {
+		size_t off;
+
+		off = (start + u) * a->leaf;
+		w->data[u] = a->data + off;
+		w->len[u] = a->len - off < a->leaf ? a->len - off : a->leaf;
+		w->dst[u] = a->out + (start + u) * a->hlen;
+	}
+	sph_hash_batch(a->alg, w->data, w->len, w->dst, u);
+}
+
+/* see sph_pool.h */
+int
+sph_hash_tree_par(sph_pool *p, unsigned alg,
+	const void *data, size_t len, size_t leaf, void *dst)
+{
+	tree_arg a;
+	size_t nl, g;
+	const void *root;
+	size_t rlen;
+
+	a.hlen = sph_hash_size(alg);
+	if (a.hlen == 0 || leaf == 0)
+		return 0;
+	nl = len == 0 ? 1 : (len - 1) / leaf + 1;
+	if (nl > ((size_t)-1) / a.hlen)
+		return 0;
+	a.out = malloc(nl * a.hlen);
+	if (a.out == NULL)
+		return 0;
+	a.alg = alg;
+	a.data = data;
+	a.len = len;
+	a.leaf = leaf;
+	g = POOL_GRAIN_BYTES / leaf;
+	if (g > POOL_GRAIN)
+		g = POOL_GRAIN;
+	sph_pool_run(p, &tree_fun, &a, nl, pool_grain(p, nl, g));
+	root = a.out;
+	rlen = nl * a.hlen;
+	sph_hash_batch(alg, &root, &rlen, &dst, 1);
+	free(a.out);
+	return 1;
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_radiogatun.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_RADIOGATUN
 #define SPH_SMALL_FOOTPRINT_RADIOGATUN   1
@@ -776,6 +777,7 @@
 static size_t
 radiogatun32_push13(sph_radiogatun32_context *sc, const void *data, size_t len)
 {
+	SPH_STATS_BLOCKS(SPH_STATS_RADIOGATUN, 13 * (len / sizeof sc->data));
 	PUSH13;
 }
 
@@ -801,6 +803,9 @@ sph_radiogatun32(void *cc, const void *data, size_t len)
 	sph_radiogatun32_context *sc;
 	unsigned ptr;
 
+#ifndef SPH_UPTR
+	SPH_STATS_INPUT(SPH_STATS_RADIOGATUN, len);
+#endif
 	sc = cc;
 	ptr = sc->data_ptr;
 	while (len > 0) {
@@ -830,6 +835,7 @@ sph_radiogatun32(void *cc, const void *data, size_t len)
 	unsigned ptr;
 	size_t rlen;
 
+	SPH_STATS_INPUT(SPH_STATS_RADIOGATUN, len);
 	if (len < (2 * sizeof sc->data)) {
 		radiogatun32_short(cc, data, len);
 		return;
@@ -856,6 +862,13 @@ sph_radiogatun32(void *cc, const void *data, size_t len)
 }
 #endif
 
+/* see sph_radiogatun.h */
+void
+sph_radiogatun32_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_radiogatun32, cc, iov, n);
+}
+
 /* see sph_radiogatun.h */
 void
 sph_radiogatun32_close(void *cc, void *dst)
@@ -866,6 +879,13 @@ sph_radiogatun32_close(void *cc, void *dst)
 	CLOSE(32);
 }
 
+/* see sph_radiogatun.h */
+void
+sph_radiogatun32_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(radiogatun32, data, len, dst);
+}
+
 #endif
 
 /* ======================================================================= */
@@ -908,6 +928,7 @@ sph_radiogatun32_close(void *cc, void *dst)
 static size_t
 radiogatun64_push13(sph_radiogatun64_context *sc, const void *data, size_t len)
 {
+	SPH_STATS_BLOCKS(SPH_STATS_RADIOGATUN, 13 * (len / sizeof sc->data));
 	PUSH13;
 }
 
@@ -933,6 +954,9 @@ sph_radiogatun64(void *cc, const void *data, size_t len)
 	sph_radiogatun64_context *sc;
 	unsigned ptr;
 
+#ifndef SPH_UPTR
+	SPH_STATS_INPUT(SPH_STATS_RADIOGATUN, len);
+#endif
 	sc = cc;
 	ptr = sc->data_ptr;
 	while (len > 0) {
@@ -962,6 +986,7 @@ sph_radiogatun64(void *cc, const void *data, size_t len)
 	unsigned ptr;
 	size_t rlen;
 
+	SPH_STATS_INPUT(SPH_STATS_RADIOGATUN, len);
 	if (len < (2 * sizeof sc->data)) {
 		radiogatun64_short(cc, data, len);
 		return;
@@ -988,6 +1013,13 @@ sph_radiogatun64(void *cc, const void *data, size_t len)
 }
 #endif
 
+/* see sph_radiogatun.h */
+void
+sph_radiogatun64_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_radiogatun64, cc, iov, n);
+}
+
 /* see sph_radiogatun.h */
 void
 sph_radiogatun64_close(void *cc, void *dst)
@@ -998,6 +1030,13 @@ sph_radiogatun64_close(void *cc, void *dst)
 	CLOSE(64);
 }
 
+/* see sph_radiogatun.h */
+void
+sph_radiogatun64_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(radiogatun64, data, len, dst);
+}
+
 #endif
 
 #endif
@@ -349,6 +349,7 @@ sph_sha0_init(void *cc)
 
 #define RFUN   sha0_round
 #define HASH   sha0
+#define STATS  SPH_STATS_SHA0
 #define BE32   1
 #include "md_helper.c"
 
@@ -360,6 +361,16 @@ sph_sha0_close(void *cc, void *dst)
 	sph_sha0_init(cc);
 }
 
+/* see sph_sha0.h */
+void
+sph_sha0_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_sha0_context sc;
+
+	sph_sha0_init(&sc);
+	sha0_oneshot(&sc, data, len, dst, 5);
+}
+
 /* see sph_sha0.h */
 void
 sph_sha0_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_sha1.h"
+#include "sph_cpu.h"
 
 #define F(B, C, D)     ((((C) ^ (D)) & (B)) ^ (D))
 #define G(B, C, D)     ((B) ^ (C) ^ (D))
@@ -55,17 +56,19 @@ static const sph_u32 IV[5] = {
 
 /*
  * This macro defines the body for a SHA-1 compression function
- * implementation. The "in" parameter should evaluate, when applied to a
- * numerical input parameter from 0 to 15, to an expression which yields
- * the corresponding input block. The "r" parameter should evaluate to
- * an array or pointer expression designating the array of 5 words which
- * contains the input and output of the compression function.
+ * implementation. The "type" parameter is the word type (a vector type
+ * for the multi-lane code). The "in" parameter should evaluate, when
+ * applied to a numerical input parameter from 0 to 15, to an expression
+ * which yields the corresponding input block. The "r" parameter should
+ * evaluate to an array or pointer expression designating the array of
+ * 5 words which contains the input and output of the compression
+ * function.
  */
 
-#define SHA1_ROUND_BODY(in, r)   do { \
-		sph_u32 A, B, C, D, E; \
-		sph_u32 W00, W01, W02, W03, W04, W05, W06, W07; \
-		sph_u32 W08, W09, W10, W11, W12, W13, W14, W15; \
+#define SHA1_ROUND_BODY(type, in, r)   do { \
+		type A, B, C, D, E; \
+		type W00, W01, W02, W03, W04, W05, W06, W07; \
+		type W08, W09, W10, W11, W12, W13, W14, W15; \
  \
 		A = (r)[0]; \
 		B = (r)[1]; \
@@ -314,11 +317,11 @@ static const sph_u32 IV[5] = {
 		A = SPH_T32(ROTL(B, 5) + I(C, D, E) + A + W15 + K4); \
 		C = ROTL(C, 30); \
  \
-		(r)[0] = SPH_T32(r[0] + A); \
-		(r)[1] = SPH_T32(r[1] + B); \
-		(r)[2] = SPH_T32(r[2] + C); \
-		(r)[3] = SPH_T32(r[3] + D); \
-		(r)[4] = SPH_T32(r[4] + E); \
+		(r)[0] = SPH_T32((r)[0] + A); \
+		(r)[1] = SPH_T32((r)[1] + B); \
+		(r)[2] = SPH_T32((r)[2] + C); \
+		(r)[3] = SPH_T32((r)[3] + D); \
+		(r)[4] = SPH_T32((r)[4] + E); \
 	} while (0)
 
 /*
@@ -328,7 +331,7 @@ static void
 sha1_round(const unsigned char *data, sph_u32 r[5])
 {
 #define SHA1_IN(x)   sph_dec32be_aligned(data + (4 * (x)))
-	SHA1_ROUND_BODY(SHA1_IN, r);
+	SHA1_ROUND_BODY(sph_u32, SHA1_IN, r);
 #undef SHA1_IN
 }
 
@@ -349,9 +352,50 @@ sph_sha1_init(void *cc)
 
 #define RFUN   sha1_round
 #define HASH   sha1
+#define STATS  SPH_STATS_SHA1
 #define BE32   1
+#define MULTI  1
 #include "md_helper.c"
 
+/*
+ * Multi-lane SHA-1, with the same organization as the multi-lane MD5
+ * code (see md5.c): the vector type is twice as wide as the registers
+ * with SSE2 and AVX2, so that two independent computations are
+ * interleaved.
+ */
+
+#if SPH_X86_SIMD
+
+#define DECL_SHA1_RUN(name, half, vtype, target) \
+SPH_TARGET(target) static void \
+name(const unsigned char *const *p, size_t nb, sph_u32 *hs) \
+{ \
+	vtype r[5], m[16]; \
+	size_t off; \
+ \
+	memcpy(r, hs, sizeof r); \
+	for (off = 0; nb -- > 0; off += 64) { \
+		sha1_multi_load_x ## half(m, sizeof m[0], p, off); \
+		sha1_multi_load_x ## half((unsigned char *)m + 4 * half, \
+			sizeof m[0], p + half, off); \
+		SHA1_ROUND_BODY(vtype, SHA1_MIN, r); \
+	} \
+	memcpy(hs, r, sizeof r); \
+}
+
+#define SHA1_MIN(x)   (m[x])
+
+DECL_SHA1_RUN(sha1_run_sse2, 4, sph_v32x8, "sse2")
+DECL_SHA1_RUN(sha1_run_avx2, 8, sph_v32x16, "avx2")
+
+#if SPH_X86_AVX512
+DECL_SHA1_RUN(sha1_run_avx512, 8, sph_v32x16, "avx2,avx512f,avx512vl")
+#endif
+
+#undef SHA1_MIN
+
+#endif
+
 /* see sph_sha1.h */
 void
 sph_sha1_close(void *cc, void *dst)
@@ -360,6 +404,16 @@ sph_sha1_close(void *cc, void *dst)
 	sph_sha1_init(cc);
 }
 
+/* see sph_sha1.h */
+void
+sph_sha1_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_sha1_context sc;
+
+	sph_sha1_init(&sc);
+	sha1_oneshot(&sc, data, len, dst, 5);
+}
+
 /* see sph_sha1.h */
 void
 sph_sha1_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -373,6 +427,73 @@ void
 sph_sha1_comp(const sph_u32 msg[16], sph_u32 val[5])
 {
 #define SHA1_IN(x)   msg[x]
-	SHA1_ROUND_BODY(SHA1_IN, val);
+	SHA1_ROUND_BODY(sph_u32, SHA1_IN, val);
 #undef SHA1_IN
 }
+
+typedef void (*sha1_run_fun)(const unsigned char *const *p,
+	size_t nb, sph_u32 *hs);
+
+/*
+ * Get the run function for the current CPU (0 if none), and the
+ * number of lanes.
+ */
+static unsigned
+sha1_select(sha1_run_fun *run)
+{
+#if SPH_X86_SIMD
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		*run = sha1_run_avx512;
+		return 16;
+	}
+#endif
+	if (f & SPH_CPU_AVX2) {
+		*run = sha1_run_avx2;
+		return 16;
+	}
+	if (f & SPH_CPU_SSE2) {
+		*run = sha1_run_sse2;
+		return 8;
+	}
+#endif
+	*run = 0;
+	return 1;
+}
+
+/* see sph_sha1.h */
+void
+sph_sha1_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	sha1_run_fun run;
+	unsigned lanes;
+
+	lanes = sha1_select(&run);
+	sha1_multi(data, len, dst, num, IV, 5, 5, run, lanes);
+}
+
+/* see sph_sha1.h */
+unsigned
+sph_sha1_multi_lanes(void)
+{
+	sha1_run_fun run;
+
+	return sha1_select(&run);
+}
+
+/* see sph_sha1.h */
+void
+sph_sha1_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num)
+{
+	sha1_run_fun run;
+	unsigned lanes;
+
+	lanes = sha1_select(&run);
+	sha1_multi_ctx(cc, (const unsigned char *const *)data,
+		nb, num, 5, run, lanes);
+}
@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_sha2.h"
+#include "sph_cpu.h"
 
 #if SPH_64
 
@@ -119,24 +120,22 @@ static const sph_u64 H512[8] = {
  * 64-bit registers are swapped.
  */
 
-#define SHA3_STEP(A, B, C, D, E, F, G, H, i)   do { \
-		sph_u64 T1, T2; \
-		T1 = SPH_T64(H + BSG5_1(E) + CH(E, F, G) + K512[i] + W[i]); \
+#define SHA3_STEP(type, A, B, C, D, E, F, G, H, wk)   do { \
+		type T1, T2; \
+		T1 = SPH_T64(H + BSG5_1(E) + CH(E, F, G) + (wk)); \
 		T2 = SPH_T64(BSG5_0(A) + MAJ(A, B, C)); \
 		D = SPH_T64(D + T1); \
 		H = SPH_T64(T1 + T2); \
 	} while (0)
 
-#define SHA3_ROUND_BODY(in, r)   do { \
+/*
+ * The eighty steps, with "wk(i)" providing the sum of the round constant
+ * and the expanded message word for step i.
+ */
+#define SHA3_STEPS(type, wk, r)   do { \
 		int i; \
-		sph_u64 A, B, C, D, E, F, G, H; \
-		sph_u64 W[80]; \
+		type A, B, C, D, E, F, G, H; \
  \
- 		for (i = 0; i < 16; i ++) \
-			W[i] = in(i); \
-		for (i = 16; i < 80; i ++) \
- 			W[i] = SPH_T64(SSG5_1(W[i - 2]) + W[i - 7] \
-				+ SSG5_0(W[i - 15]) + W[i - 16]); \
 		A = (r)[0]; \
 		B = (r)[1]; \
 		C = (r)[2]; \
@@ -146,14 +145,14 @@ static const sph_u64 H512[8] = {
 		G = (r)[6]; \
 		H = (r)[7]; \
 		for (i = 0; i < 80; i += 8) { \
-			SHA3_STEP(A, B, C, D, E, F, G, H, i + 0); \
-			SHA3_STEP(H, A, B, C, D, E, F, G, i + 1); \
-			SHA3_STEP(G, H, A, B, C, D, E, F, i + 2); \
-			SHA3_STEP(F, G, H, A, B, C, D, E, i + 3); \
-			SHA3_STEP(E, F, G, H, A, B, C, D, i + 4); \
-			SHA3_STEP(D, E, F, G, H, A, B, C, i + 5); \
-			SHA3_STEP(C, D, E, F, G, H, A, B, i + 6); \
-			SHA3_STEP(B, C, D, E, F, G, H, A, i + 7); \
+			SHA3_STEP(type, A, B, C, D, E, F, G, H, wk(i + 0)); \
+			SHA3_STEP(type, H, A, B, C, D, E, F, G, wk(i + 1)); \
+			SHA3_STEP(type, G, H, A, B, C, D, E, F, wk(i + 2)); \
+			SHA3_STEP(type, F, G, H, A, B, C, D, E, wk(i + 3)); \
+			SHA3_STEP(type, E, F, G, H, A, B, C, D, wk(i + 4)); \
+			SHA3_STEP(type, D, E, F, G, H, A, B, C, wk(i + 5)); \
+			SHA3_STEP(type, C, D, E, F, G, H, A, B, wk(i + 6)); \
+			SHA3_STEP(type, B, C, D, E, F, G, H, A, wk(i + 7)); \
 		} \
 		(r)[0] = SPH_T64((r)[0] + A); \
 		(r)[1] = SPH_T64((r)[1] + B); \
@@ -165,6 +164,25 @@ static const sph_u64 H512[8] = {
 		(r)[7] = SPH_T64((r)[7] + H); \
 	} while (0)
 
+#define SHA3_WK(i)   (K512[i] + W[i])
+
+/*
+ * The "type" parameter is the type of the working variables: sph_u64
+ * for plain code, or a vector of 64-bit lanes for the multi-message
+ * code, each lane then computing an independent compression.
+ */
+#define SHA3_ROUND_BODY(type, in, r)   do { \
+		int j; \
+		type W[80]; \
+ \
+ 		for (j = 0; j < 16; j ++) \
+			W[j] = in(j); \
+		for (j = 16; j < 80; j ++) \
+ 			W[j] = SPH_T64(SSG5_1(W[j - 2]) + W[j - 7] \
+				+ SSG5_0(W[j - 15]) + W[j - 16]); \
+		SHA3_STEPS(type, SHA3_WK, r); \
+	} while (0)
+
 /*
  * One round of SHA-384 / SHA-512. The data must be aligned for 64-bit access.
  */
@@ -172,10 +190,160 @@ static void
 sha3_round(const unsigned char *data, sph_u64 r[8])
 {
 #define SHA3_IN(x)   sph_dec64be_aligned(data + (8 * (x)))
-	SHA3_ROUND_BODY(SHA3_IN, r);
+	SHA3_ROUND_BODY(sph_u64, SHA3_IN, r);
 #undef SHA3_IN
 }
 
+#if SPH_X86_SIMD
+
+#include <immintrin.h>
+
+/*
+ * Single-message AVX2 code for long inputs. The message expansion of
+ * two consecutive blocks is computed with vector code, each 128-bit
+ * half holding two words of one block: the expansion recurrence only
+ * reaches back two words, so two words can be produced at once. The
+ * expanded words are added to the round constants and stored; the
+ * steps themselves remain scalar (a single chain does not vectorize).
+ * The expansion of the next two blocks is interleaved with the steps
+ * of the current ones, so that the vector and scalar units work
+ * concurrently.
+ */
+
+#define SHA3_VROTR(x, n) \
+	_mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+
+/*
+ * Compute v[j] (two words for each of the blocks at d1 and d2), and
+ * store the words plus the round constants in wk[0] and wk[1].
+ */
+SPH_TARGET("avx2") static SPH_INLINE void
+sha3_vexpand(__m256i *v, sph_u64 (*wk)[80], int j,
+	const unsigned char *d1, const unsigned char *d2)
+{
+	__m256i bs, x, y, t;
+
+	bs = _mm256_setr_epi8(
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	if (j < 8) {
+		x = _mm256_castsi128_si256(
+			_mm_loadu_si128((const __m128i *)d1 + j));
+		x = _mm256_inserti128_si256(x,
+			_mm_loadu_si128((const __m128i *)d2 + j), 1);
+		t = _mm256_shuffle_epi8(x, bs);
+	} else {
+		__m256i r8;
+
+		r8 = _mm256_setr_epi8(
+			1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8,
+			1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8);
+		x = v[j - 1];
+		y = _mm256_alignr_epi8(v[j - 7], v[j - 8], 8);
+		t = _mm256_add_epi64(v[j - 8],
+			_mm256_alignr_epi8(v[j - 3], v[j - 4], 8));
+		t = _mm256_add_epi64(t, _mm256_xor_si256(
+			_mm256_xor_si256(SHA3_VROTR(x, 19), SHA3_VROTR(x, 61)),
+			_mm256_srli_epi64(x, 6)));
+		t = _mm256_add_epi64(t, _mm256_xor_si256(
+			_mm256_xor_si256(SHA3_VROTR(y, 1),
+			_mm256_shuffle_epi8(y, r8)), _mm256_srli_epi64(y, 7)));
+	}
+	v[j] = t;
+	t = _mm256_add_epi64(t, _mm256_broadcastsi128_si256(
+		_mm_loadu_si128((const __m128i *)K512 + j)));
+	_mm_storeu_si128((__m128i *)wk[0] + j, _mm256_castsi256_si128(t));
+	_mm_storeu_si128((__m128i *)wk[1] + j, _mm256_extracti128_si256(t, 1));
+}
+
+SPH_TARGET("avx2") static void
+sha3_blocks_avx2(const unsigned char *data, size_t num, sph_u64 r[8])
+{
+	__m256i v[40];
+	sph_u64 wk[2][2][80];
+	unsigned cur, b;
+	int i, j;
+
+	/*
+	 * With an odd number of blocks, the last one is expanded
+	 * twice; only the first copy is used.
+	 */
+	for (j = 0; j < 40; j ++)
+		sha3_vexpand(v, wk[0], j, data,
+			num > 1 ? data + 128 : data);
+	for (cur = 0;; cur ^= 1) {
+		const unsigned char *n1, *n2;
+
+		n1 = data + 256;
+		n2 = num > 3 ? n1 + 128 : n1;
+		for (b = 0; b < 2 && b < num; b ++) {
+			sph_u64 A, B, C, D, E, F, G, H;
+			const sph_u64 *w;
+
+			w = wk[cur][b];
+			A = r[0];
+			B = r[1];
+			C = r[2];
+			D = r[3];
+			E = r[4];
+			F = r[5];
+			G = r[6];
+			H = r[7];
+			for (i = 0; i < 80; i += 8) {
+				SHA3_STEP(sph_u64, A, B, C, D, E, F, G, H, w[i + 0]);
+				SHA3_STEP(sph_u64, H, A, B, C, D, E, F, G, w[i + 1]);
+				SHA3_STEP(sph_u64, G, H, A, B, C, D, E, F, w[i + 2]);
+				SHA3_STEP(sph_u64, F, G, H, A, B, C, D, E, w[i + 3]);
+				SHA3_STEP(sph_u64, E, F, G, H, A, B, C, D, w[i + 4]);
+				SHA3_STEP(sph_u64, D, E, F, G, H, A, B, C, w[i + 5]);
+				SHA3_STEP(sph_u64, C, D, E, F, G, H, A, B, w[i + 6]);
+				SHA3_STEP(sph_u64, B, C, D, E, F, G, H, A, w[i + 7]);
+				if (num > 2) {
+					j = 20 * b + (i >> 2);
+					sha3_vexpand(v, wk[cur ^ 1],
+						j, n1, n2);
+					sha3_vexpand(v, wk[cur ^ 1],
+						j + 1, n1, n2);
+				}
+			}
+			r[0] = SPH_T64(r[0] + A);
+			r[1] = SPH_T64(r[1] + B);
+			r[2] = SPH_T64(r[2] + C);
+			r[3] = SPH_T64(r[3] + D);
+			r[4] = SPH_T64(r[4] + E);
+			r[5] = SPH_T64(r[5] + F);
+			r[6] = SPH_T64(r[6] + G);
+			r[7] = SPH_T64(r[7] + H);
+		}
+		if (num <= 2)
+			break;
+		data = n1;
+		num -= 2;
+	}
+}
+
+#undef SHA3_VROTR
+
+#endif
+
+/*
+ * Process "num" consecutive blocks (aligned as for sha3_round()).
+ */
+static void
+sha3_blocks(const unsigned char *data, size_t num, sph_u64 r[8])
+{
+#if SPH_X86_SIMD
+	if (num > 1 && (sph_cpu_features() & SPH_CPU_AVX2) != 0) {
+		sha3_blocks_avx2(data, num, r);
+		return;
+	}
+#endif
+	while (num -- > 0) {
+		sha3_round(data, r);
+		data += 128;
+	}
+}
+
 /* see sph_sha3.h */
 void
 sph_sha384_init(void *cc)
@@ -198,11 +366,97 @@ sph_sha512_init(void *cc)
 	sc->count = 0;
 }
 
-#define RFUN   sha3_round
-#define HASH   sha384
-#define BE64   1
+#define RFUN          sha3_round
+#define RFUN_BLOCKS   sha3_blocks
+#define HASH          sha384
+#define STATS         SPH_STATS_SHA2
+#define BE64          1
+#define MULTI         1
 #include "md_helper.c"
 
+/*
+ * Multi-lane SHA-384 / SHA-512: several independent messages are
+ * hashed in parallel, one per 64-bit vector lane (four with AVX2, eight
+ * with AVX-512, where the compiler uses the rotate and three-input
+ * logic instructions). Unlike MD5, the steps are wide enough to keep
+ * the execution units busy with one register per variable, so no
+ * interleaving is needed. Without AVX2, two lanes of SSE2 would be
+ * slower than the scalar code (no 64-bit rotations), so the messages
+ * are then hashed one by one.
+ */
+
+#if SPH_X86_SIMD
+
+#define DECL_SHA3_RUN(name, vtype, target) \
+SPH_TARGET(target) static void \
+name(const unsigned char *const *p, size_t nb, sph_u64 *hs) \
+{ \
+	vtype r[8], m[16]; \
+	size_t off; \
+	unsigned g; \
+ \
+	memcpy(r, hs, sizeof r); \
+	for (off = 0; nb -- > 0; off += 128) { \
+		for (g = 0; g < sizeof m[0] / 32; g ++) \
+			sha384_multi_load_x4((unsigned char *)m + 32 * g, \
+				sizeof m[0], p + 4 * g, off); \
+		SHA3_ROUND_BODY(vtype, SHA3_MIN, r); \
+	} \
+	memcpy(hs, r, sizeof r); \
+}
+
+#define SHA3_MIN(x)   (m[x])
+
+DECL_SHA3_RUN(sha3_run_avx2, sph_v64x4, "avx2")
+
+#if SPH_X86_AVX512
+DECL_SHA3_RUN(sha3_run_avx512, sph_v64x8, "avx2,avx512f,avx512vl")
+#endif
+
+#undef SHA3_MIN
+
+#endif
+
+typedef void (*sha3_run_fun)(const unsigned char *const *p,
+	size_t nb, sph_u64 *hs);
+
+/*
+ * Get the run function for the current CPU (0 if none), and the
+ * number of lanes.
+ */
+static unsigned
+sha3_select(sha3_run_fun *run)
+{
+#if SPH_X86_SIMD
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		*run = sha3_run_avx512;
+		return 8;
+	}
+#endif
+	if (f & SPH_CPU_AVX2) {
+		*run = sha3_run_avx2;
+		return 4;
+	}
+#endif
+	*run = 0;
+	return 1;
+}
+
+static void
+sha3_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, const sph_u64 *iv, unsigned rnum)
+{
+	sha3_run_fun run;
+	unsigned lanes;
+
+	lanes = sha3_select(&run);
+	sha384_multi(data, len, dst, num, iv, 8, rnum, run, lanes);
+}
+
 /* see sph_sha3.h */
 void
 sph_sha384_close(void *cc, void *dst)
@@ -211,6 +465,16 @@ sph_sha384_close(void *cc, void *dst)
 	sph_sha384_init(cc);
 }
 
+/* see sph_sha3.h */
+void
+sph_sha384_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_sha384_context sc;
+
+	sph_sha384_init(&sc);
+	sha384_oneshot(&sc, data, len, dst, 6);
+}
+
 /* see sph_sha3.h */
 void
 sph_sha384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -227,6 +491,16 @@ sph_sha512_close(void *cc, void *dst)
 	sph_sha512_init(cc);
 }
 
+/* see sph_sha3.h */
+void
+sph_sha512_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_sha512_context sc;
+
+	sph_sha512_init(&sc);
+	sha384_oneshot(&sc, data, len, dst, 8);
+}
+
 /* see sph_sha3.h */
 void
 sph_sha512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -240,8 +514,46 @@ void
 sph_sha384_comp(const sph_u64 msg[16], sph_u64 val[8])
 {
 #define SHA3_IN(x)   msg[x]
-	SHA3_ROUND_BODY(SHA3_IN, val);
+	SHA3_ROUND_BODY(sph_u64, SHA3_IN, val);
 #undef SHA3_IN
 }
 
+/* see sph_sha2.h */
+void
+sph_sha384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	sha3_multi(data, len, dst, num, H384, 6);
+}
+
+/* see sph_sha2.h */
+void
+sph_sha512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	sha3_multi(data, len, dst, num, H512, 8);
+}
+
+/* see sph_sha2.h */
+unsigned
+sph_sha384_multi_lanes(void)
+{
+	sha3_run_fun run;
+
+	return sha3_select(&run);
+}
+
+/* see sph_sha2.h */
+void
+sph_sha384_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num)
+{
+	sha3_run_fun run;
+	unsigned lanes;
+
+	lanes = sha3_select(&run);
+	sha384_multi_ctx(cc, (const unsigned char *const *)data,
+		nb, num, 8, run, lanes);
+}
+
 #endif
@@ -34,6 +34,8 @@
 #include <string.h>
 
 #include "sph_shabal.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
 
 #ifdef _MSC_VER
 #pragma warning (disable: 4146)
@@ -538,12 +540,11 @@ static void
 shabal_core(void *cc, const unsigned char *data, size_t len)
 {
 	sph_shabal_context *sc;
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	DECL_STATE
 
 	sc = cc;
-	buf = sc->buf;
 	ptr = sc->ptr;
 
 	/*
@@ -553,7 +554,7 @@ shabal_core(void *cc, const unsigned char *data, size_t len)
 	 * this method many times for small chunks of data.
 	 */
 	if (len < (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -566,7 +567,12 @@ shabal_core(void *cc, const unsigned char *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		ptr += clen;
 		data += clen;
 		len -= clen;
@@ -578,6 +584,7 @@ shabal_core(void *cc, const unsigned char *data, size_t len)
 			INPUT_BLOCK_SUB;
 			SWAP_BC;
 			INCR_W;
+			SPH_STATS_BLOCKS(SPH_STATS_SHABAL, 1);
 			ptr = 0;
 		}
 	}
@@ -611,6 +618,7 @@ shabal_close(void *cc, unsigned ub, unsigned n, void *dst, unsigned size_words)
 	INPUT_BLOCK_ADD;
 	XOR_W;
 	APPLY_P;
+	SPH_STATS_BLOCKS(SPH_STATS_SHABAL, 1);
 	for (i = 0; i < 3; i ++) {
 		SWAP_BC;
 		XOR_W;
@@ -658,6 +666,230 @@ shabal_close(void *cc, unsigned ub, unsigned n, void *dst, unsigned size_words)
 	shabal_init(sc, size_words << 5);
 }
 
+/*
+ * Multi-lane Shabal: several independent messages are hashed in
+ * parallel, one per vector lane. The round macros only apply C
+ * operators to their operands, so with the GCC vector extensions they
+ * operate on vectors of lanes unchanged; the counter W is the same for
+ * all lanes and remains scalar.
+ *
+ * A "run" function loads the lane states from hs[] (A, B then C words),
+ * processes nb blocks per lane (block i of lane l is at p[l] + i * 64),
+ * and stores back the states. If fin is non-zero, the single block is
+ * the padded final block, processed as in shabal_close(). The generic
+ * driver takes care of grouping messages, building the padding blocks
+ * and completing ragged lanes with the scalar code.
+ */
+
+#if SPH_X86_SIMD
+
+#undef SWAP
+#define SWAP(v1, v2)   do { \
+		__typeof__(v1) tmp = (v1); \
+		(v1) = (v2); \
+		(v2) = tmp; \
+	} while (0)
+
+#define DECL_SHABAL_LANES(lanes, vtype, target) \
+SPH_TARGET(target) static void \
+shabal_run_x ## lanes(const unsigned char *const *p, size_t nb, \
+	sph_u32 (*hs)[44], sph_u32 *w, int fin) \
+{ \
+	struct { \
+		vtype A[12], B[16], C[16]; \
+		sph_u32 Wlow, Whigh; \
+	} vs; \
+	vtype A00, A01, A02, A03, A04, A05, A06, A07, \
+		A08, A09, A0A, A0B; \
+	vtype B0, B1, B2, B3, B4, B5, B6, B7, \
+		B8, B9, BA, BB, BC, BD, BE, BF; \
+	vtype C0, C1, C2, C3, C4, C5, C6, C7, \
+		C8, C9, CA, CB, CC, CD, CE, CF; \
+	vtype M0, M1, M2, M3, M4, M5, M6, M7, \
+		M8, M9, MA, MB, MC, MD, ME, MF; \
+	vtype m[16]; \
+	sph_u32 Wlow, Whigh; \
+	size_t off; \
+	unsigned u, l; \
+ \
+	for (u = 0; u < 12; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			vs.A[u][l] = hs[l][u]; \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) { \
+			vs.B[u][l] = hs[l][12 + u]; \
+			vs.C[u][l] = hs[l][28 + u]; \
+		} \
+	vs.Wlow = w[0]; \
+	vs.Whigh = w[1]; \
+	READ_STATE(&vs); \
+	for (off = 0; nb -- > 0; off += 64) { \
+		for (u = 0; u < 16; u ++) \
+			for (l = 0; l < lanes; l ++) \
+				m[u][l] = sph_dec32le(p[l] + off + 4 * u); \
+		M0 = m[ 0]; M1 = m[ 1]; M2 = m[ 2]; M3 = m[ 3]; \
+		M4 = m[ 4]; M5 = m[ 5]; M6 = m[ 6]; M7 = m[ 7]; \
+		M8 = m[ 8]; M9 = m[ 9]; MA = m[10]; MB = m[11]; \
+		MC = m[12]; MD = m[13]; ME = m[14]; MF = m[15]; \
+		INPUT_BLOCK_ADD; \
+		XOR_W; \
+		APPLY_P; \
+		if (fin) { \
+			for (u = 0; u < 3; u ++) { \
+				SWAP_BC; \
+				XOR_W; \
+				APPLY_P; \
+			} \
+		} else { \
+			INPUT_BLOCK_SUB; \
+			SWAP_BC; \
+			INCR_W; \
+		} \
+	} \
+	WRITE_STATE(&vs); \
+	for (u = 0; u < 12; u ++) \
+		for (l = 0; l < lanes; l ++) \
+			hs[l][u] = vs.A[u][l]; \
+	for (u = 0; u < 16; u ++) \
+		for (l = 0; l < lanes; l ++) { \
+			hs[l][12 + u] = vs.B[u][l]; \
+			hs[l][28 + u] = vs.C[u][l]; \
+		} \
+	w[0] = vs.Wlow; \
+	w[1] = vs.Whigh; \
+}
+
+DECL_SHABAL_LANES(4, sph_v32x4, "sse2")
+DECL_SHABAL_LANES(8, sph_v32x8, "avx2")
+
+#if SPH_X86_AVX512
+DECL_SHABAL_LANES(16, sph_v32x16, "avx2,avx512f,avx512vl")
+#endif
+
+#define MULTI_MAX_LANES   16
+
+#endif
+
+static void
+shabal_multi(const void *const *data, const size_t *len, void *const *dst,
+	size_t num, unsigned size_words)
+{
+	sph_shabal_context sc0;
+	size_t lanes, k;
+#if SPH_X86_SIMD
+	void (*run)(const unsigned char *const *p, size_t nb,
+		sph_u32 (*hs)[44], sph_u32 *w, int fin);
+	unsigned f;
+
+	f = sph_cpu_features();
+#if SPH_X86_AVX512
+	if (f & SPH_CPU_AVX512) {
+		run = shabal_run_x16;
+		lanes = 16;
+	} else
+#endif
+	if (f & SPH_CPU_AVX2) {
+		run = shabal_run_x8;
+		lanes = 8;
+	} else if (f & SPH_CPU_SSE2) {
+		run = shabal_run_x4;
+		lanes = 4;
+	} else {
+		run = 0;
+		lanes = 1;
+	}
+#else
+	lanes = 1;
+#endif
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_SHABAL, len[k]);
+	shabal_init(&sc0, size_words << 5);
+	while (num > 0) {
+		size_t n, u;
+
+		n = num < lanes ? num : lanes;
+#if SPH_X86_SIMD
+		if (n > 1) {
+			const unsigned char *p[MULTI_MAX_LANES];
+			sph_u32 hs[MULTI_MAX_LANES][44];
+			unsigned char tail[MULTI_MAX_LANES][64];
+			sph_u32 w[2];
+			size_t nb, rem, v;
+			int same;
+
+			nb = len[0] >> 6;
+			same = 1;
+			for (u = 1; u < n; u ++) {
+				if ((len[u] >> 6) < nb)
+					nb = len[u] >> 6;
+				if (len[u] != len[0])
+					same = 0;
+			}
+			for (u = 0; u < lanes; u ++) {
+				p[u] = data[u < n ? u : 0];
+				memcpy(hs[u], sc0.A, sizeof sc0.A);
+				memcpy(hs[u] + 12, sc0.B, sizeof sc0.B);
+				memcpy(hs[u] + 28, sc0.C, sizeof sc0.C);
+			}
+			w[0] = sc0.Wlow;
+			w[1] = sc0.Whigh;
+			run(p, nb, hs, w, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_SHABAL, nb * n);
+			if (same) {
+				rem = len[0] & 63;
+				for (u = 0; u < lanes; u ++) {
+					memcpy(tail[u], p[u] + (nb << 6), rem);
+					tail[u][rem] = 0x80;
+					memset(tail[u] + rem + 1, 0, 63 - rem);
+					p[u] = tail[u];
+				}
+				run(p, 1, hs, w, 1);
+				SPH_STATS_BLOCKS(SPH_STATS_SHABAL, n);
+				for (u = 0; u < n; u ++) {
+					unsigned char *out;
+
+					out = dst[u];
+					for (v = 0; v < size_words; v ++)
+						sph_enc32le(out + (v << 2), hs[u]
+							[28 - size_words + v]);
+				}
+			} else {
+				for (u = 0; u < n; u ++) {
+					sph_shabal_context sc;
+
+					memcpy(sc.A, hs[u], sizeof sc.A);
+					memcpy(sc.B, hs[u] + 12, sizeof sc.B);
+					memcpy(sc.C, hs[u] + 28, sizeof sc.C);
+					sc.Wlow = w[0];
+					sc.Whigh = w[1];
+					sc.ptr = 0;
+					shabal_core(&sc, p[u] + (nb << 6),
+						len[u] - (nb << 6));
+					shabal_close(&sc, 0, 0,
+						dst[u], size_words);
+				}
+			}
+			data += n;
+			len += n;
+			dst += n;
+			num -= n;
+			continue;
+		}
+#endif
+		for (u = 0; u < n; u ++) {
+			sph_shabal_context sc;
+
+			sc = sc0;
+			shabal_core(&sc, data[u], len[u]);
+			shabal_close(&sc, 0, 0, dst[u], size_words);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal192_init(void *cc)
@@ -669,9 +901,17 @@ sph_shabal192_init(void *cc)
 void
 sph_shabal192(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHABAL, len);
 	shabal_core(cc, data, len);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal192_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shabal192, cc, iov, n);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal192_close(void *cc, void *dst)
@@ -679,6 +919,13 @@ sph_shabal192_close(void *cc, void *dst)
 	shabal_close(cc, 0, 0, dst, 6);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal192_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shabal192, data, len, dst);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal192_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -686,6 +933,14 @@ sph_shabal192_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shabal_close(cc, ub, n, dst, 6);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal192_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shabal_multi(data, len, dst, num, 6);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal224_init(void *cc)
@@ -697,9 +952,17 @@ sph_shabal224_init(void *cc)
 void
 sph_shabal224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHABAL, len);
 	shabal_core(cc, data, len);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shabal224, cc, iov, n);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal224_close(void *cc, void *dst)
@@ -707,6 +970,13 @@ sph_shabal224_close(void *cc, void *dst)
 	shabal_close(cc, 0, 0, dst, 7);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shabal224, data, len, dst);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -714,6 +984,14 @@ sph_shabal224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shabal_close(cc, ub, n, dst, 7);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shabal_multi(data, len, dst, num, 7);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal256_init(void *cc)
@@ -725,9 +1003,17 @@ sph_shabal256_init(void *cc)
 void
 sph_shabal256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHABAL, len);
 	shabal_core(cc, data, len);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shabal256, cc, iov, n);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal256_close(void *cc, void *dst)
@@ -735,6 +1021,13 @@ sph_shabal256_close(void *cc, void *dst)
 	shabal_close(cc, 0, 0, dst, 8);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shabal256, data, len, dst);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -742,6 +1035,14 @@ sph_shabal256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shabal_close(cc, ub, n, dst, 8);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shabal_multi(data, len, dst, num, 8);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal384_init(void *cc)
@@ -753,9 +1054,17 @@ sph_shabal384_init(void *cc)
 void
 sph_shabal384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHABAL, len);
 	shabal_core(cc, data, len);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shabal384, cc, iov, n);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal384_close(void *cc, void *dst)
@@ -763,6 +1072,13 @@ sph_shabal384_close(void *cc, void *dst)
 	shabal_close(cc, 0, 0, dst, 12);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shabal384, data, len, dst);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -770,6 +1086,14 @@ sph_shabal384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shabal_close(cc, ub, n, dst, 12);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shabal_multi(data, len, dst, num, 12);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal512_init(void *cc)
@@ -781,9 +1105,17 @@ sph_shabal512_init(void *cc)
 void
 sph_shabal512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHABAL, len);
 	shabal_core(cc, data, len);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shabal512, cc, iov, n);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal512_close(void *cc, void *dst)
@@ -791,9 +1123,24 @@ sph_shabal512_close(void *cc, void *dst)
 	shabal_close(cc, 0, 0, dst, 16);
 }
 
+/* see sph_shabal.h */
+void
+sph_shabal512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shabal512, data, len, dst);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
 	shabal_close(cc, ub, n, dst, 16);
 }
+
+/* see sph_shabal.h */
+void
+sph_shabal512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shabal_multi(data, len, dst, num, 16);
+}
@@ -34,6 +34,8 @@
 #include <string.h>
 
 #include "sph_shavite.h"
+#include "sph_stats.h"
+#include "sph_cpu.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_SHAVITE
 #define SPH_SMALL_FOOTPRINT_SHAVITE   1
@@ -59,6 +61,8 @@
 
 #define AES_BIG_ENDIAN   0
 #include "aes_helper.c"
+#include "aes_vperm_helper.c"
+#include "vaes_helper.c"
 
 static const sph_u32 IV224[] = {
 	C32(0x6774F31C), C32(0x990AE210), C32(0xC87D4274), C32(0xC9546371),
@@ -1471,6 +1475,211 @@ c512(sph_shavite_big_context *sc, const void *msg)
 
 #endif
 
+#if SPH_X86_SIMD
+
+/*
+ * Vector implementation. With the little-endian word order used by
+ * SHAvite-3, a 128-bit block is directly an AES state, AES_ROUND_NOKEY
+ * is an aesenc with a zero key, and the key schedule works on whole
+ * 128-bit words: the nonlinear step is an aesenc of a rotated word
+ * with the previous word as key, and the linear step is a shift (c256)
+ * or byte alignment (c512) followed by XORs. The round keys are all
+ * computed first, as in the small footprint code.
+ */
+typedef void (*shavite_c256_fn)(sph_shavite_small_context *sc,
+	const void *msg);
+typedef void (*shavite_c512_fn)(sph_shavite_big_context *sc,
+	const void *msg);
+
+#define DECL_SHAVITE_C256(name, target, aesenc) \
+SPH_TARGET(target) static void \
+name(sph_shavite_small_context *sc, const void *msg) \
+{ \
+	__m128i rk[36], p0, p1, x, t, zero; \
+	const __m128i *mp; \
+	int j, r; \
+ \
+	mp = (const __m128i *)msg; \
+	for (j = 0; j < 4; j ++) \
+		rk[j] = _mm_loadu_si128(mp + j); \
+	for (j = 4; j < 36; j ++) { \
+		if ((j & 7) >= 4) { \
+			rk[j] = aesenc(_mm_shuffle_epi32(rk[j - 4], 0x39), \
+				rk[j - 1]); \
+			switch (j) { \
+			case 4: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					0, 0, (int)~sc->count1, \
+					(int)sc->count0)); \
+				break; \
+			case 14: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					0, (int)~sc->count0, \
+					(int)sc->count1, 0)); \
+				break; \
+			case 21: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count0, \
+					(int)sc->count1, 0, 0)); \
+				break; \
+			case 31: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count1, 0, 0, \
+					(int)sc->count0)); \
+				break; \
+			} \
+		} else { \
+			t = _mm_xor_si128(rk[j - 4], \
+				_mm_srli_si128(rk[j - 1], 4)); \
+			rk[j] = _mm_xor_si128(t, _mm_slli_si128(t, 12)); \
+		} \
+	} \
+	p0 = _mm_loadu_si128((const __m128i *)sc->h + 0); \
+	p1 = _mm_loadu_si128((const __m128i *)sc->h + 1); \
+	zero = _mm_setzero_si128(); \
+	for (r = 0, j = 0; r < 6; r ++, j += 6) { \
+		x = _mm_xor_si128(p1, rk[j + 0]); \
+		x = aesenc(x, rk[j + 1]); \
+		x = aesenc(x, rk[j + 2]); \
+		p0 = _mm_xor_si128(p0, aesenc(x, zero)); \
+		x = _mm_xor_si128(p0, rk[j + 3]); \
+		x = aesenc(x, rk[j + 4]); \
+		x = aesenc(x, rk[j + 5]); \
+		p1 = _mm_xor_si128(p1, aesenc(x, zero)); \
+	} \
+	_mm_storeu_si128((__m128i *)sc->h + 0, _mm_xor_si128(p0, \
+		_mm_loadu_si128((const __m128i *)sc->h + 0))); \
+	_mm_storeu_si128((__m128i *)sc->h + 1, _mm_xor_si128(p1, \
+		_mm_loadu_si128((const __m128i *)sc->h + 1))); \
+}
+
+#define DECL_SHAVITE_C512(name, target, aesenc) \
+SPH_TARGET(target) static void \
+name(sph_shavite_big_context *sc, const void *msg) \
+{ \
+	__m128i rk[112], p0, p1, p2, p3, x, t, zero; \
+	const __m128i *mp; \
+	int j, r; \
+ \
+	mp = (const __m128i *)msg; \
+	for (j = 0; j < 8; j ++) \
+		rk[j] = _mm_loadu_si128(mp + j); \
+	for (j = 8; j < 112; j ++) { \
+		if ((j & 15) >= 8) { \
+			rk[j] = aesenc(_mm_shuffle_epi32(rk[j - 8], 0x39), \
+				rk[j - 1]); \
+			switch (j) { \
+			case 8: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count3, (int)sc->count2, \
+					(int)sc->count1, (int)sc->count0)); \
+				break; \
+			case 41: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count0, (int)sc->count1, \
+					(int)sc->count2, (int)sc->count3)); \
+				break; \
+			case 79: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count1, (int)sc->count0, \
+					(int)sc->count3, (int)sc->count2)); \
+				break; \
+			case 110: \
+				rk[j] = _mm_xor_si128(rk[j], _mm_set_epi32( \
+					(int)~sc->count2, (int)sc->count3, \
+					(int)sc->count0, (int)sc->count1)); \
+				break; \
+			} \
+		} else { \
+			rk[j] = _mm_xor_si128(rk[j - 8], \
+				_mm_alignr_epi8(rk[j - 1], rk[j - 2], 4)); \
+		} \
+	} \
+	p0 = _mm_loadu_si128((const __m128i *)sc->h + 0); \
+	p1 = _mm_loadu_si128((const __m128i *)sc->h + 1); \
+	p2 = _mm_loadu_si128((const __m128i *)sc->h + 2); \
+	p3 = _mm_loadu_si128((const __m128i *)sc->h + 3); \
+	zero = _mm_setzero_si128(); \
+	for (r = 0, j = 0; r < 14; r ++, j += 8) { \
+		x = _mm_xor_si128(p1, rk[j + 0]); \
+		x = aesenc(x, rk[j + 1]); \
+		x = aesenc(x, rk[j + 2]); \
+		x = aesenc(x, rk[j + 3]); \
+		p0 = _mm_xor_si128(p0, aesenc(x, zero)); \
+		x = _mm_xor_si128(p3, rk[j + 4]); \
+		x = aesenc(x, rk[j + 5]); \
+		x = aesenc(x, rk[j + 6]); \
+		x = aesenc(x, rk[j + 7]); \
+		p2 = _mm_xor_si128(p2, aesenc(x, zero)); \
+		t = p3; \
+		p3 = p2; \
+		p2 = p1; \
+		p1 = p0; \
+		p0 = t; \
+	} \
+	_mm_storeu_si128((__m128i *)sc->h + 0, _mm_xor_si128(p0, \
+		_mm_loadu_si128((const __m128i *)sc->h + 0))); \
+	_mm_storeu_si128((__m128i *)sc->h + 1, _mm_xor_si128(p1, \
+		_mm_loadu_si128((const __m128i *)sc->h + 1))); \
+	_mm_storeu_si128((__m128i *)sc->h + 2, _mm_xor_si128(p2, \
+		_mm_loadu_si128((const __m128i *)sc->h + 2))); \
+	_mm_storeu_si128((__m128i *)sc->h + 3, _mm_xor_si128(p3, \
+		_mm_loadu_si128((const __m128i *)sc->h + 3))); \
+}
+
+DECL_SHAVITE_C256(c256_aes, "ssse3,aes", _mm_aesenc_si128)
+DECL_SHAVITE_C256(c256_vperm, "ssse3", aes_vperm_enc)
+DECL_SHAVITE_C512(c512_aes, "ssse3,aes", _mm_aesenc_si128)
+DECL_SHAVITE_C512(c512_vperm, "ssse3", aes_vperm_enc)
+
+#endif
+
+/*
+ * Compression function entry points: the vector code is used when the
+ * processor supports it (AES-NI, or at least SSSE3).
+ */
+static void
+shavite_c256(sph_shavite_small_context *sc, const void *msg)
+{
+#if SPH_X86_SIMD
+	unsigned f;
+#endif
+
+	SPH_STATS_BLOCKS(SPH_STATS_SHAVITE, 1);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	if (f & SPH_CPU_SSSE3) {
+		if (f & SPH_CPU_AESNI)
+			c256_aes(sc, msg);
+		else
+			c256_vperm(sc, msg);
+		return;
+	}
+#endif
+	c256(sc, msg);
+}
+
+static void
+shavite_c512(sph_shavite_big_context *sc, const void *msg)
+{
+#if SPH_X86_SIMD
+	unsigned f;
+#endif
+
+	SPH_STATS_BLOCKS(SPH_STATS_SHAVITE, 1);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	if (f & SPH_CPU_SSSE3) {
+		if (f & SPH_CPU_AESNI)
+			c512_aes(sc, msg);
+		else
+			c512_vperm(sc, msg);
+		return;
+	}
+#endif
+	c512(sc, msg);
+}
+
 static void
 shavite_small_init(sph_shavite_small_context *sc, const sph_u32 *iv)
 {
@@ -1483,10 +1692,9 @@ shavite_small_init(sph_shavite_small_context *sc, const sph_u32 *iv)
 static void
 shavite_small_core(sph_shavite_small_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	while (len > 0) {
 		size_t clen;
@@ -1494,14 +1702,19 @@ shavite_small_core(sph_shavite_small_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		ptr += clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
 			if ((sc->count0 = SPH_T32(sc->count0 + 512)) == 0)
 				sc->count1 = SPH_T32(sc->count1 + 1);
-			c256(sc, buf);
+			shavite_c256(sc, buf);
 			ptr = 0;
 		}
 	}
@@ -1533,7 +1746,7 @@ shavite_small_close(sph_shavite_small_context *sc,
 	} else {
 		buf[ptr ++] = z;
 		memset(buf + ptr, 0, 64 - ptr);
-		c256(sc, buf);
+		shavite_c256(sc, buf);
 		memset(buf, 0, 54);
 		sc->count0 = sc->count1 = 0;
 	}
@@ -1541,7 +1754,7 @@ shavite_small_close(sph_shavite_small_context *sc,
 	sph_enc32le(buf + 58, count1);
 	buf[62] = out_size_w32 << 5;
 	buf[63] = out_size_w32 >> 3;
-	c256(sc, buf);
+	shavite_c256(sc, buf);
 	for (u = 0; u < out_size_w32; u ++)
 		sph_enc32le((unsigned char *)dst + (u << 2), sc->h[u]);
 }
@@ -1560,10 +1773,9 @@ shavite_big_init(sph_shavite_big_context *sc, const sph_u32 *iv)
 static void
 shavite_big_core(sph_shavite_big_context *sc, const void *data, size_t len)
 {
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	while (len > 0) {
 		size_t clen;
@@ -1571,7 +1783,12 @@ shavite_big_core(sph_shavite_big_context *sc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		ptr += clen;
 		len -= clen;
@@ -1586,7 +1803,7 @@ shavite_big_core(sph_shavite_big_context *sc, const void *data, size_t len)
 					}
 				}
 			}
-			c512(sc, buf);
+			shavite_c512(sc, buf);
 			ptr = 0;
 		}
 	}
@@ -1620,7 +1837,7 @@ shavite_big_close(sph_shavite_big_context *sc,
 	} else {
 		buf[ptr ++] = z;
 		memset(buf + ptr, 0, 128 - ptr);
-		c512(sc, buf);
+		shavite_c512(sc, buf);
 		memset(buf, 0, 110);
 		sc->count0 = sc->count1 = sc->count2 = sc->count3 = 0;
 	}
@@ -1630,11 +1847,267 @@ shavite_big_close(sph_shavite_big_context *sc,
 	sph_enc32le(buf + 122, count3);
 	buf[126] = out_size_w32 << 5;
 	buf[127] = out_size_w32 >> 3;
-	c512(sc, buf);
+	shavite_c512(sc, buf);
 	for (u = 0; u < out_size_w32; u ++)
 		sph_enc32le((unsigned char *)dst + (u << 2), sc->h[u]);
 }
 
+/*
+ * Multi-message SHAvite-384/512. The padded final blocks of each
+ * message are built beforehand, so that all blocks can be processed
+ * in the same way; with VAES, the blocks common to a group of messages
+ * are processed with one message per 128-bit lane (2 or 4 lanes), and
+ * the remaining blocks of the longer messages are then processed one
+ * by one.
+ */
+
+#if SPH_X86_SIMD
+
+/*
+ * Set C[] to the 128-bit encoding of a length of "len" bytes, in bits.
+ */
+static void
+shavite_bitlen(sph_u32 *C, size_t len)
+{
+	C[0] = SPH_T32((sph_u32)len << 3);
+	C[1] = SPH_T32((sph_u32)(len >> 29));
+	C[2] = SPH_T32((sph_u32)(len >> 31 >> 30));
+	C[3] = 0;
+}
+
+/*
+ * Build the padded final block(s) of a message of "len" bytes at
+ * "data" into "tail" (which must have room for two blocks). Returned
+ * value is the number of final blocks (1 or 2).
+ */
+static size_t
+shavite_big_tail(unsigned char *tail, const unsigned char *data, size_t len,
+	size_t out_size_w32)
+{
+	size_t rem, tlen;
+	sph_u32 C[4];
+
+	rem = len & 127;
+	tlen = rem < 110 ? 128 : 256;
+	memcpy(tail, data + len - rem, rem);
+	tail[rem] = 0x80;
+	memset(tail + rem + 1, 0, tlen - rem - 1);
+	shavite_bitlen(C, len);
+	sph_enc32le(tail + tlen - 18, C[0]);
+	sph_enc32le(tail + tlen - 14, C[1]);
+	sph_enc32le(tail + tlen - 10, C[2]);
+	sph_enc32le(tail + tlen - 6, C[3]);
+	tail[tlen - 2] = out_size_w32 << 5;
+	tail[tlen - 1] = out_size_w32 >> 3;
+	return tlen >> 7;
+}
+
+/*
+ * Get the counter for block "i" of a message of "len" bytes, which
+ * has "nb" full blocks: the number of message bits up to the end of
+ * the block, or zero for a final block with no message bit.
+ */
+static void
+shavite_big_counter(sph_u32 *C, size_t len, size_t nb, size_t i)
+{
+	if (i < nb)
+		shavite_bitlen(C, (i + 1) << 7);
+	else if (i == nb && (len & 127) != 0)
+		shavite_bitlen(C, len);
+	else
+		C[0] = C[1] = C[2] = C[3] = 0;
+}
+
+/*
+ * VAES engine: one block for each lane. st[i] is the chaining value of
+ * lane i (64 bytes, updated), blk[i] its message block and ctr[i] its
+ * counter (16 bytes). The four counter insertions are word permutations
+ * of the counter, with the last word complemented.
+ */
+typedef void (*shavite_big_run_fn)(unsigned char *const *st,
+	const unsigned char *const *blk, const unsigned char *const *ctr);
+
+#define DECL_SHAVITE_BIG_X(name, VX) \
+SPH_TARGET(VX ## _TARGET) static void \
+name(unsigned char *const *st, const unsigned char *const *blk, \
+	const unsigned char *const *ctr) \
+{ \
+	VX ## _T rk[112], p0, p1, p2, p3, x, t, c, nm, zero; \
+	int j, r; \
+ \
+	for (j = 0; j < 8; j ++) \
+		rk[j] = VX ## _LOAD(blk, j << 4); \
+	c = VX ## _LOAD(ctr, 0); \
+	nm = VX ## _BCAST(_mm_set_epi32(-1, 0, 0, 0)); \
+	for (j = 8; j < 112; j ++) { \
+		if ((j & 15) >= 8) { \
+			rk[j] = VX ## _AESENC( \
+				VX ## _SHUF32(rk[j - 8], 0x39), rk[j - 1]); \
+			switch (j) { \
+			case 8: \
+				rk[j] = VX ## _XOR(rk[j], VX ## _XOR(c, nm)); \
+				break; \
+			case 41: \
+				rk[j] = VX ## _XOR(rk[j], VX ## _XOR( \
+					VX ## _SHUF32(c, 0x1B), nm)); \
+				break; \
+			case 79: \
+				rk[j] = VX ## _XOR(rk[j], VX ## _XOR( \
+					VX ## _SHUF32(c, 0x4E), nm)); \
+				break; \
+			case 110: \
+				rk[j] = VX ## _XOR(rk[j], VX ## _XOR( \
+					VX ## _SHUF32(c, 0xB1), nm)); \
+				break; \
+			} \
+		} else { \
+			rk[j] = VX ## _XOR(rk[j - 8], \
+				VX ## _ALIGNR(rk[j - 1], rk[j - 2], 4)); \
+		} \
+	} \
+	p0 = VX ## _LOAD(st, 0); \
+	p1 = VX ## _LOAD(st, 16); \
+	p2 = VX ## _LOAD(st, 32); \
+	p3 = VX ## _LOAD(st, 48); \
+	zero = VX ## _ZERO; \
+	for (r = 0, j = 0; r < 14; r ++, j += 8) { \
+		x = VX ## _XOR(p1, rk[j + 0]); \
+		x = VX ## _AESENC(x, rk[j + 1]); \
+		x = VX ## _AESENC(x, rk[j + 2]); \
+		x = VX ## _AESENC(x, rk[j + 3]); \
+		p0 = VX ## _XOR(p0, VX ## _AESENC(x, zero)); \
+		x = VX ## _XOR(p3, rk[j + 4]); \
+		x = VX ## _AESENC(x, rk[j + 5]); \
+		x = VX ## _AESENC(x, rk[j + 6]); \
+		x = VX ## _AESENC(x, rk[j + 7]); \
+		p2 = VX ## _XOR(p2, VX ## _AESENC(x, zero)); \
+		t = p3; \
+		p3 = p2; \
+		p2 = p1; \
+		p1 = p0; \
+		p0 = t; \
+	} \
+	VX ## _STORE(st, 0, VX ## _XOR(p0, VX ## _LOAD(st, 0))); \
+	VX ## _STORE(st, 16, VX ## _XOR(p1, VX ## _LOAD(st, 16))); \
+	VX ## _STORE(st, 32, VX ## _XOR(p2, VX ## _LOAD(st, 32))); \
+	VX ## _STORE(st, 48, VX ## _XOR(p3, VX ## _LOAD(st, 48))); \
+}
+
+DECL_SHAVITE_BIG_X(shavite_big_run_x2, VX2)
+#if SPH_X86_AVX512
+DECL_SHAVITE_BIG_X(shavite_big_run_x4, VX4)
+#endif
+
+#endif
+
+static void
+shavite_big_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num, const sph_u32 *iv, size_t out_size_w32)
+{
+	size_t k;
+#if SPH_X86_SIMD
+	shavite_big_run_fn run;
+	size_t lanes;
+	unsigned f;
+#endif
+
+	for (k = 0; k < num; k ++)
+		SPH_STATS_INPUT(SPH_STATS_SHAVITE, len[k]);
+#if SPH_X86_SIMD
+	f = sph_cpu_features();
+	run = 0;
+	lanes = 1;
+#if SPH_X86_AVX512
+	if ((f & (SPH_CPU_AVX512 | SPH_CPU_VAES))
+		== (SPH_CPU_AVX512 | SPH_CPU_VAES))
+	{
+		run = &shavite_big_run_x4;
+		lanes = 4;
+	} else
+#endif
+	if (f & SPH_CPU_VAES) {
+		run = &shavite_big_run_x2;
+		lanes = 2;
+	}
+	while (run != 0 && num >= 2) {
+		unsigned char st[VX_MAX_LANES][64];
+		unsigned char tail[VX_MAX_LANES][256];
+		unsigned char ctr[VX_MAX_LANES][16];
+		unsigned char *sp[VX_MAX_LANES];
+		const unsigned char *d[VX_MAX_LANES];
+		const unsigned char *bp[VX_MAX_LANES], *cp[VX_MAX_LANES];
+		size_t ln[VX_MAX_LANES], nb[VX_MAX_LANES], nt[VX_MAX_LANES];
+		size_t n, u, i, c;
+		sph_u32 C[4];
+
+		/*
+		 * With fewer messages than lanes, the extra lanes hash
+		 * the first message again.
+		 */
+		n = num < lanes ? num : lanes;
+		c = (size_t)-1;
+		for (u = 0; u < lanes; u ++) {
+			d[u] = data[u < n ? u : 0];
+			ln[u] = len[u < n ? u : 0];
+			nb[u] = ln[u] >> 7;
+			nt[u] = nb[u] + shavite_big_tail(tail[u],
+				d[u], ln[u], out_size_w32);
+			if (nt[u] < c)
+				c = nt[u];
+			for (i = 0; i < 16; i ++)
+				sph_enc32le(st[u] + (i << 2), iv[i]);
+			sp[u] = st[u];
+			cp[u] = ctr[u];
+		}
+		for (i = 0; i < c; i ++) {
+			for (u = 0; u < lanes; u ++) {
+				bp[u] = i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7);
+				shavite_big_counter(C, ln[u], nb[u], i);
+				sph_enc32le(ctr[u], C[0]);
+				sph_enc32le(ctr[u] + 4, C[1]);
+				sph_enc32le(ctr[u] + 8, C[2]);
+				sph_enc32le(ctr[u] + 12, C[3]);
+			}
+			run(sp, bp, cp);
+			SPH_STATS_BLOCKS(SPH_STATS_SHAVITE, n);
+		}
+		for (u = 0; u < n; u ++) {
+			sph_shavite_big_context sc;
+
+			for (i = c; i < nt[u]; i ++) {
+				memcpy(sc.h, st[u], sizeof st[u]);
+				memcpy(sc.buf, i < nb[u] ? d[u] + (i << 7)
+					: tail[u] + ((i - nb[u]) << 7), 128);
+				shavite_big_counter(C, ln[u], nb[u], i);
+				sc.count0 = C[0];
+				sc.count1 = C[1];
+				sc.count2 = C[2];
+				sc.count3 = C[3];
+				shavite_c512(&sc, sc.buf);
+				memcpy(st[u], sc.h, sizeof st[u]);
+			}
+			memcpy(dst[u], st[u], out_size_w32 << 2);
+		}
+		data += n;
+		len += n;
+		dst += n;
+		num -= n;
+	}
+#endif
+	while (num > 0) {
+		sph_shavite_big_context sc;
+
+		shavite_big_init(&sc, iv);
+		shavite_big_core(&sc, data[0], len[0]);
+		shavite_big_close(&sc, 0, 0, dst[0], out_size_w32);
+		data ++;
+		len ++;
+		dst ++;
+		num --;
+	}
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite224_init(void *cc)
@@ -1646,9 +2119,17 @@ sph_shavite224_init(void *cc)
 void
 sph_shavite224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHAVITE, len);
 	shavite_small_core(cc, data, len);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shavite224, cc, iov, n);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite224_close(void *cc, void *dst)
@@ -1657,6 +2138,13 @@ sph_shavite224_close(void *cc, void *dst)
 	shavite_small_init(cc, IV224);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shavite224, data, len, dst);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1676,9 +2164,17 @@ sph_shavite256_init(void *cc)
 void
 sph_shavite256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHAVITE, len);
 	shavite_small_core(cc, data, len);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shavite256, cc, iov, n);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite256_close(void *cc, void *dst)
@@ -1687,6 +2183,13 @@ sph_shavite256_close(void *cc, void *dst)
 	shavite_small_init(cc, IV256);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shavite256, data, len, dst);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1706,9 +2209,17 @@ sph_shavite384_init(void *cc)
 void
 sph_shavite384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHAVITE, len);
 	shavite_big_core(cc, data, len);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shavite384, cc, iov, n);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite384_close(void *cc, void *dst)
@@ -1717,6 +2228,13 @@ sph_shavite384_close(void *cc, void *dst)
 	shavite_big_init(cc, IV384);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shavite384, data, len, dst);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1725,6 +2243,14 @@ sph_shavite384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shavite_big_init(cc, IV384);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shavite_big_multi(data, len, dst, num, IV384, 12);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite512_init(void *cc)
@@ -1736,9 +2262,17 @@ sph_shavite512_init(void *cc)
 void
 sph_shavite512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SHAVITE, len);
 	shavite_big_core(cc, data, len);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_shavite512, cc, iov, n);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite512_close(void *cc, void *dst)
@@ -1747,6 +2281,13 @@ sph_shavite512_close(void *cc, void *dst)
 	shavite_big_init(cc, IV512);
 }
 
+/* see sph_shavite.h */
+void
+sph_shavite512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(shavite512, data, len, dst);
+}
+
 /* see sph_shavite.h */
 void
 sph_shavite512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1754,3 +2295,11 @@ sph_shavite512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shavite_big_close(cc, ub, n, dst, 16);
 	shavite_big_init(cc, IV512);
 }
+
+/* see sph_shavite.h */
+void
+sph_shavite512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num)
+{
+	shavite_big_multi(data, len, dst, num, IV512, 16);
+}
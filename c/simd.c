@@ -35,6 +35,7 @@
 #include <limits.h>
 
 #include "sph_simd.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_SIMD
 #define SPH_SMALL_FOOTPRINT_SIMD   1
@@ -213,7 +214,7 @@ static const s32 alpha_tab[] = {
 #if SPH_SMALL_FOOTPRINT_SIMD
 
 static void
-fft32(unsigned char *x, size_t xs, s32 *q)
+fft32(const unsigned char *x, size_t xs, s32 *q)
 {
 	size_t xd;
 
@@ -253,7 +254,7 @@ fft32(unsigned char *x, size_t xs, s32 *q)
  */
 
 static void
-fft64(unsigned char *x, size_t xs, s32 *q)
+fft64(const unsigned char *x, size_t xs, s32 *q)
 {
 	size_t xd;
 
@@ -858,9 +859,8 @@ one_round_small(u32 *state, u32 *w, int isp, int p0, int p1, int p2, int p3)
 }
 
 static void
-compress_small(sph_simd_small_context *sc, int last)
+compress_small(sph_simd_small_context *sc, const unsigned char *x, int last)
 {
-	unsigned char *x;
 	s32 q[128];
 	int i;
 	u32 w[32];
@@ -878,7 +878,6 @@ compress_small(sph_simd_small_context *sc, int last)
 		27 << 3, 29 << 3, 28 << 3, 26 << 3
 	};
 
-	x = sc->buf;
 	FFT128(0, 1, 0, ll);
 	if (last) {
 		for (i = 0; i < 128; i ++) {
@@ -989,9 +988,8 @@ compress_small(sph_simd_small_context *sc, int last)
 #endif
 
 static void
-compress_small(sph_simd_small_context *sc, int last)
+compress_small(sph_simd_small_context *sc, const unsigned char *x, int last)
 {
-	unsigned char *x;
 	s32 q[128];
 	int i;
 	DECL_STATE_SMALL
@@ -1002,7 +1000,6 @@ compress_small(sph_simd_small_context *sc, int last)
 #if SPH_SIMD_NOCOPY
 	memcpy(saved, sc->state, sizeof saved);
 #endif
-	x = sc->buf;
 	FFT128(0, 1, 0, ll);
 	if (last) {
 		for (i = 0; i < 128; i ++) {
@@ -1180,9 +1177,8 @@ one_round_big(u32 *state, u32 *w, int isp, int p0, int p1, int p2, int p3)
 }
 
 static void
-compress_big(sph_simd_big_context *sc, int last)
+compress_big(sph_simd_big_context *sc, const unsigned char *x, int last)
 {
-	unsigned char *x;
 	s32 q[256];
 	int i;
 	u32 w[64];
@@ -1200,7 +1196,6 @@ compress_big(sph_simd_big_context *sc, int last)
 		27 << 4, 29 << 4, 28 << 4, 26 << 4
 	};
 
-	x = sc->buf;
 	FFT256(0, 1, 0, ll);
 	if (last) {
 		for (i = 0; i < 256; i ++) {
@@ -1367,9 +1362,8 @@ compress_big(sph_simd_big_context *sc, int last)
 #endif
 
 static void
-compress_big(sph_simd_big_context *sc, int last)
+compress_big(sph_simd_big_context *sc, const unsigned char *x, int last)
 {
-	unsigned char *x;
 	s32 q[256];
 	int i;
 	DECL_STATE_BIG
@@ -1381,7 +1375,6 @@ compress_big(sph_simd_big_context *sc, int last)
 	memcpy(saved, sc->state, sizeof saved);
 #endif
 
-	x = sc->buf;
 	FFT256(0, 1, 0, ll);
 	if (last) {
 		for (i = 0; i < 256; i ++) {
@@ -1579,6 +1572,7 @@ static void
 update_small(void *cc, const void *data, size_t len)
 {
 	sph_simd_small_context *sc;
+	const unsigned char *buf;
 
 	sc = cc;
 	while (len > 0) {
@@ -1587,11 +1581,17 @@ update_small(void *cc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - sc->ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(sc->buf + sc->ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + sc->ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if ((sc->ptr += clen) == sizeof sc->buf) {
-			compress_small(sc, 0);
+			compress_small(sc, buf, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 			sc->ptr = 0;
 			sc->count_low = T32(sc->count_low + 1);
 			if (sc->count_low == 0)
@@ -1604,6 +1604,7 @@ static void
 update_big(void *cc, const void *data, size_t len)
 {
 	sph_simd_big_context *sc;
+	const unsigned char *buf;
 
 	sc = cc;
 	while (len > 0) {
@@ -1612,11 +1613,17 @@ update_big(void *cc, const void *data, size_t len)
 		clen = (sizeof sc->buf) - sc->ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(sc->buf + sc->ptr, data, clen);
+		if (clen == sizeof sc->buf && SPH_DIRECT_INPUT(data, 4)) {
+			buf = data;
+		} else {
+			memcpy(sc->buf + sc->ptr, data, clen);
+			buf = sc->buf;
+		}
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if ((sc->ptr += clen) == sizeof sc->buf) {
-			compress_big(sc, 0);
+			compress_big(sc, buf, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 			sc->ptr = 0;
 			sc->count_low = T32(sc->count_low + 1);
 			if (sc->count_low == 0)
@@ -1659,11 +1666,13 @@ finalize_small(void *cc, unsigned ub, unsigned n, void *dst, size_t dst_len)
 		memset(sc->buf + sc->ptr, 0,
 			(sizeof sc->buf) - sc->ptr);
 		sc->buf[sc->ptr] = ub & (0xFF << (8 - n));
-		compress_small(sc, 0);
+		compress_small(sc, sc->buf, 0);
+		SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 	}
 	memset(sc->buf, 0, sizeof sc->buf);
 	encode_count_small(sc->buf, sc->count_low, sc->count_high, sc->ptr, n);
-	compress_small(sc, 1);
+	compress_small(sc, sc->buf, 1);
+	SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 	d = dst;
 	for (d = dst, u = 0; u < dst_len; u ++)
 		sph_enc32le(d + (u << 2), sc->state[u]);
@@ -1681,11 +1690,13 @@ finalize_big(void *cc, unsigned ub, unsigned n, void *dst, size_t dst_len)
 		memset(sc->buf + sc->ptr, 0,
 			(sizeof sc->buf) - sc->ptr);
 		sc->buf[sc->ptr] = ub & (0xFF << (8 - n));
-		compress_big(sc, 0);
+		compress_big(sc, sc->buf, 0);
+		SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 	}
 	memset(sc->buf, 0, sizeof sc->buf);
 	encode_count_big(sc->buf, sc->count_low, sc->count_high, sc->ptr, n);
-	compress_big(sc, 1);
+	compress_big(sc, sc->buf, 1);
+	SPH_STATS_BLOCKS(SPH_STATS_SIMD, 1);
 	d = dst;
 	for (d = dst, u = 0; u < dst_len; u ++)
 		sph_enc32le(d + (u << 2), sc->state[u]);
@@ -1700,15 +1711,28 @@ sph_simd224_init(void *cc)
 void
 sph_simd224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SIMD, len);
 	update_small(cc, data, len);
 }
 
+void
+sph_simd224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_simd224, cc, iov, n);
+}
+
 void
 sph_simd224_close(void *cc, void *dst)
 {
 	sph_simd224_addbits_and_close(cc, 0, 0, dst);
 }
 
+void
+sph_simd224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(simd224, data, len, dst);
+}
+
 void
 sph_simd224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
@@ -1725,15 +1749,28 @@ sph_simd256_init(void *cc)
 void
 sph_simd256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SIMD, len);
 	update_small(cc, data, len);
 }
 
+void
+sph_simd256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_simd256, cc, iov, n);
+}
+
 void
 sph_simd256_close(void *cc, void *dst)
 {
 	sph_simd256_addbits_and_close(cc, 0, 0, dst);
 }
 
+void
+sph_simd256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(simd256, data, len, dst);
+}
+
 void
 sph_simd256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
@@ -1750,15 +1787,28 @@ sph_simd384_init(void *cc)
 void
 sph_simd384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SIMD, len);
 	update_big(cc, data, len);
 }
 
+void
+sph_simd384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_simd384, cc, iov, n);
+}
+
 void
 sph_simd384_close(void *cc, void *dst)
 {
 	sph_simd384_addbits_and_close(cc, 0, 0, dst);
 }
 
+void
+sph_simd384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(simd384, data, len, dst);
+}
+
 void
 sph_simd384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
@@ -1775,15 +1825,28 @@ sph_simd512_init(void *cc)
 void
 sph_simd512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SIMD, len);
 	update_big(cc, data, len);
 }
 
+void
+sph_simd512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_simd512, cc, iov, n);
+}
+
 void
 sph_simd512_close(void *cc, void *dst)
 {
 	sph_simd512_addbits_and_close(cc, 0, 0, dst);
 }
 
+void
+sph_simd512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(simd512, data, len, dst);
+}
+
 void
 sph_simd512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
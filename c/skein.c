@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_skein.h"
+#include "sph_stats.h"
 
 #if SPH_SMALL_FOOTPRINT && !defined SPH_SMALL_FOOTPRINT_SKEIN
 #define SPH_SMALL_FOOTPRINT_SKEIN   1
@@ -861,17 +862,17 @@ skein_big_core(sph_skein_big_context *sc, const void *data, size_t len)
 	 * Skein can be reduced to no extra bit at all). However, this
 	 * function cannot know whether it processes the last chunks of
 	 * the message or not. Hence we may keep a full block of buffered
-	 * data (64 bytes).
+	 * data (64 bytes). Full blocks which are followed by more input
+	 * data are processed directly from the input.
 	 */
-	unsigned char *buf;
+	const unsigned char *buf;
 	size_t ptr;
 	unsigned first;
 	DECL_STATE_BIG
 
-	buf = sc->buf;
 	ptr = sc->ptr;
 	if (len <= (sizeof sc->buf) - ptr) {
-		memcpy(buf + ptr, data, len);
+		memcpy(sc->buf + ptr, data, len);
 		ptr += len;
 		sc->ptr = ptr;
 		return;
@@ -883,15 +884,29 @@ skein_big_core(sph_skein_big_context *sc, const void *data, size_t len)
 		size_t clen;
 
 		if (ptr == sizeof sc->buf) {
+			buf = sc->buf;
 			bcount ++;
 			UBI_BIG(96 + first, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_SKEIN, 1);
 			first = 0;
 			ptr = 0;
 		}
+		if (ptr == 0 && len > sizeof sc->buf
+			&& SPH_DIRECT_INPUT(data, 8))
+		{
+			buf = data;
+			bcount ++;
+			UBI_BIG(96 + first, 0);
+			SPH_STATS_BLOCKS(SPH_STATS_SKEIN, 1);
+			first = 0;
+			data = buf + sizeof sc->buf;
+			len -= sizeof sc->buf;
+			continue;
+		}
 		clen = (sizeof sc->buf) - ptr;
 		if (clen > len)
 			clen = len;
-		memcpy(buf + ptr, data, clen);
+		memcpy(sc->buf + ptr, data, clen);
 		ptr += clen;
 		data = (const unsigned char *)data + clen;
 		len -= clen;
@@ -987,6 +1002,7 @@ skein_big_close(sph_skein_big_context *sc, unsigned ub, unsigned n,
 	READ_STATE_BIG(sc);
 	memset(buf + ptr, 0, (sizeof sc->buf) - ptr);
 	et = 352 + ((bcount == 0) << 7) + (n != 0);
+	SPH_STATS_BLOCKS(SPH_STATS_SKEIN, 1);
 	for (i = 0; i < 2; i ++) {
 		UBI_BIG(et, ptr);
 		if (i == 0) {
@@ -1136,9 +1152,17 @@ sph_skein224_init(void *cc)
 void
 sph_skein224(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SKEIN, len);
 	skein_big_core(cc, data, len);
 }
 
+/* see sph_skein.h */
+void
+sph_skein224_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_skein224, cc, iov, n);
+}
+
 /* see sph_skein.h */
 void
 sph_skein224_close(void *cc, void *dst)
@@ -1146,6 +1170,13 @@ sph_skein224_close(void *cc, void *dst)
 	sph_skein224_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_skein.h */
+void
+sph_skein224_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(skein224, data, len, dst);
+}
+
 /* see sph_skein.h */
 void
 sph_skein224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1165,9 +1196,17 @@ sph_skein256_init(void *cc)
 void
 sph_skein256(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SKEIN, len);
 	skein_big_core(cc, data, len);
 }
 
+/* see sph_skein.h */
+void
+sph_skein256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_skein256, cc, iov, n);
+}
+
 /* see sph_skein.h */
 void
 sph_skein256_close(void *cc, void *dst)
@@ -1175,6 +1214,13 @@ sph_skein256_close(void *cc, void *dst)
 	sph_skein256_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_skein.h */
+void
+sph_skein256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(skein256, data, len, dst);
+}
+
 /* see sph_skein.h */
 void
 sph_skein256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1194,9 +1240,17 @@ sph_skein384_init(void *cc)
 void
 sph_skein384(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SKEIN, len);
 	skein_big_core(cc, data, len);
 }
 
+/* see sph_skein.h */
+void
+sph_skein384_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_skein384, cc, iov, n);
+}
+
 /* see sph_skein.h */
 void
 sph_skein384_close(void *cc, void *dst)
@@ -1204,6 +1258,13 @@ sph_skein384_close(void *cc, void *dst)
 	sph_skein384_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_skein.h */
+void
+sph_skein384_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(skein384, data, len, dst);
+}
+
 /* see sph_skein.h */
 void
 sph_skein384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -1223,9 +1284,17 @@ sph_skein512_init(void *cc)
 void
 sph_skein512(void *cc, const void *data, size_t len)
 {
+	SPH_STATS_INPUT(SPH_STATS_SKEIN, len);
 	skein_big_core(cc, data, len);
 }
 
+/* see sph_skein.h */
+void
+sph_skein512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_skein512, cc, iov, n);
+}
+
 /* see sph_skein.h */
 void
 sph_skein512_close(void *cc, void *dst)
@@ -1233,6 +1302,13 @@ sph_skein512_close(void *cc, void *dst)
 	sph_skein512_addbits_and_close(cc, 0, 0, dst);
 }
 
+/* see sph_skein.h */
+void
+sph_skein512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(skein512, data, len, dst);
+}
+
 /* see sph_skein.h */
 void
 sph_skein512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
@@ -66,9 +66,11 @@
 #include "sph_sha2.h"
 #include "sph_shabal.h"
 #include "sph_shavite.h"
+#include "sph_streebog.h"
 #include "sph_simd.h"
 #include "sph_skein.h"
 #include "sph_tiger.h"
+#include "sph_tune.h"
 #include "sph_whirlpool.h"
 
 #define DATA_LEN   8192
@@ -158,6 +160,77 @@ speed_ ## cname(void) \
 	} \
 }
 
+/*
+ * Speed test for the multi-message functions: messages are hashed by
+ * batches of MULTI_NUM, all of the same length. Reported speed is the
+ * aggregate over all messages of a batch.
+ */
+#define MULTI_NUM   64
+
+static unsigned char multi_res[MULTI_NUM][64];
+
+#define SPEED_MULTI_TEST(Name, cname) \
+static double \
+speed_ ## cname ## _multi_unit(size_t clen, size_t num) \
+{ \
+	clock_t orig, end; \
+	const void *src[MULTI_NUM]; \
+	size_t len[MULTI_NUM]; \
+	void *dst[MULTI_NUM]; \
+	size_t u; \
+ \
+	for (u = 0; u < MULTI_NUM; u ++) { \
+		src[u] = data; \
+		len[u] = clen; \
+		dst[u] = multi_res[u]; \
+	} \
+	orig = clock(); \
+	while (num -- > 0) \
+		sph_ ## cname ## _multi(src, len, dst, MULTI_NUM); \
+	end = clock(); \
+	return (end - orig) / (double)CLOCKS_PER_SEC; \
+} \
+ \
+static void \
+speed_ ## cname ## _multi(void) \
+{ \
+	size_t clen, num; \
+ \
+	printf("Speed test: %s (%d messages per call)\n", \
+		Name, MULTI_NUM); \
+	fflush(stdout); \
+	num = 2; \
+	for (clen = 16;; clen <<= 2) { \
+		double tt; \
+ \
+ 		if (clen == 4096) { \
+			clen = DATA_LEN; \
+			if (num > 1) \
+				num >>= 1; \
+		} \
+		for (;;) { \
+			tt = speed_ ## cname ## _multi_unit(clen, num); \
+			if (tt > 6.0) { \
+				if (num <= 1) \
+					break; \
+				num >>= 1; \
+			} else if (tt < 2.0) { \
+				num += num; \
+			} else { \
+				break; \
+			} \
+		} \
+		printf("message length = %5lu -> %7.2f MBytes/s\n", \
+			(unsigned long)clen, ((double)clen * (double)num \
+			* MULTI_NUM) / (1000000.0 * tt)); \
+		fflush(stdout); \
+		if (clen == DATA_LEN) \
+			break; \
+		if (num > 4) \
+			num >>= 2; \
+	} \
+}
+
 SPEED_TEST("MD2", md2)
 SPEED_TEST("MD4", md4)
 SPEED_TEST("MD5", md5)
@@ -249,6 +322,36 @@ SPEED_TEST("SHAvite-224", shavite224)
 SPEED_TEST("SHAvite-256", shavite256)
 SPEED_TEST("SHAvite-384", shavite384)
 SPEED_TEST("SHAvite-512", shavite512)
+#if SPH_64
+SPEED_TEST("Streebog-256", gost256)
+SPEED_TEST("Streebog-512", gost512)
+#endif
+
+SPEED_MULTI_TEST("BMW-256", bmw256)
+#if SPH_64
+SPEED_MULTI_TEST("BMW-512", bmw512)
+#endif
+SPEED_MULTI_TEST("Luffa-256", luffa256)
+SPEED_MULTI_TEST("Luffa-512", luffa512)
+SPEED_MULTI_TEST("CubeHash-256", cubehash256)
+SPEED_MULTI_TEST("CubeHash-512", cubehash512)
+SPEED_MULTI_TEST("Hamsi-256", hamsi256)
+SPEED_MULTI_TEST("Hamsi-512", hamsi512)
+SPEED_MULTI_TEST("Shabal-256", shabal256)
+SPEED_MULTI_TEST("Shabal-512", shabal512)
+SPEED_MULTI_TEST("WHIRLPOOL", whirlpool)
+SPEED_MULTI_TEST("MD5", md5)
+SPEED_MULTI_TEST("SHA-1", sha1)
+SPEED_MULTI_TEST("SHA-224", sha224)
+SPEED_MULTI_TEST("SHA-256", sha256)
+SPEED_MULTI_TEST("RIPEMD-160", ripemd160)
+SPEED_MULTI_TEST("ECHO-512", echo512)
+SPEED_MULTI_TEST("SHAvite-512", shavite512)
+SPEED_MULTI_TEST("Groestl-512", groestl512)
+#if SPH_64
+SPEED_MULTI_TEST("SHA-384", sha384)
+SPEED_MULTI_TEST("SHA-512", sha512)
+#endif
 
 #define DO_MD2             0x00000001UL
 #define DO_MD4             0x00000002UL
@@ -335,153 +438,209 @@ SPEED_TEST("SHAvite-512", shavite512)
 #define DO3_SHAVITE256     0x00002000UL
 #define DO3_SHAVITE384     0x00004000UL
 #define DO3_SHAVITE512     0x00008000UL
+#if SPH_64
+#define DO3_STREEBOG256    0x00010000UL
+#define DO3_STREEBOG512    0x00020000UL
+#endif
+
+#define DO4_BMW256_MULTI   0x00000001UL
+#define DO4_BMW512_MULTI   0x00000002UL
+#define DO4_LUFFA256_MULTI 0x00000004UL
+#define DO4_LUFFA512_MULTI 0x00000008UL
+#define DO4_CUBEHASH256_MULTI   0x00000010UL
+#define DO4_CUBEHASH512_MULTI   0x00000020UL
+#define DO4_HAMSI256_MULTI      0x00000040UL
+#define DO4_HAMSI512_MULTI      0x00000080UL
+#define DO4_SHABAL256_MULTI     0x00000100UL
+#define DO4_SHABAL512_MULTI     0x00000200UL
+#define DO4_WHIRLPOOL_MULTI     0x00000400UL
+#define DO4_MD5_MULTI           0x00000800UL
+#define DO4_SHA1_MULTI          0x00001000UL
+#define DO4_SHA384_MULTI        0x00002000UL
+#define DO4_SHA512_MULTI        0x00004000UL
+#define DO4_SHA224_MULTI        0x00008000UL
+#define DO4_SHA256_MULTI        0x00010000UL
+#define DO4_RIPEMD160_MULTI     0x00020000UL
+#define DO4_ECHO512_MULTI       0x00040000UL
+#define DO4_SHAVITE512_MULTI    0x00080000UL
+#define DO4_GROESTL512_MULTI    0x00100000UL
 
 static struct {
 	char *name;
-	unsigned long flags, flags2, flags3;
+	unsigned long flags, flags2, flags3, flags4;
 } function_names[] = {
-	{ "MD2",         DO_MD2, 0, 0              },
-	{ "MD4",         DO_MD4, 0, 0              },
-	{ "MD5",         DO_MD5, 0, 0              },
-	{ "SHA-0",       DO_SHA0, 0, 0             },
-	{ "SHA-1",       DO_SHA1, 0, 0             },
-	{ "SHA-224",     DO_SHA224, 0, 0           },
-	{ "SHA-256",     DO_SHA256, 0, 0           },
+	{ "MD2",         DO_MD2, 0, 0, 0           },
+	{ "MD4",         DO_MD4, 0, 0, 0           },
+	{ "MD5",         DO_MD5, 0, 0, 0           },
+	{ "SHA-0",       DO_SHA0, 0, 0, 0          },
+	{ "SHA-1",       DO_SHA1, 0, 0, 0          },
+	{ "SHA-224",     DO_SHA224, 0, 0, 0        },
+	{ "SHA-256",     DO_SHA256, 0, 0, 0        },
 #if SPH_64
-	{ "SHA-384",     DO_SHA384, 0, 0           },
-	{ "SHA-512",     DO_SHA512, 0, 0           },
+	{ "SHA-384",     DO_SHA384, 0, 0, 0        },
+	{ "SHA-512",     DO_SHA512, 0, 0, 0        },
 #endif
 	{ "SHA2",        DO_SHA224 | DO_SHA256
 #if SPH_64
 	                 | DO_SHA384 | DO_SHA512
 #endif
-	                 , 0, 0  },
-	{ "RMD",         DO_RIPEMD, 0, 0           },
-	{ "RIPEMD",      DO_RIPEMD, 0, 0           },
-	{ "RMD-128",     DO_RIPEMD128, 0, 0        },
-	{ "RIPEMD-128",  DO_RIPEMD128, 0, 0        },
-	{ "RMD-160",     DO_RIPEMD160, 0, 0        },
-	{ "RIPEMD-160",  DO_RIPEMD160, 0, 0        },
-#if SPH_64
-	{ "Tiger",       DO_TIGER, 0, 0            },
-	{ "Tiger2",      DO_TIGER2, 0, 0           },
-#endif
-	{ "Panama",      DO_PANAMA, 0, 0           },
-	{ "HAVAL/3",     DO_HAVAL3, 0, 0           },
-	{ "HAVAL/4",     DO_HAVAL4, 0, 0           },
-	{ "HAVAL/5",     DO_HAVAL5, 0, 0           },
-	{ "HAVAL",       DO_HAVAL3 | DO_HAVAL4 | DO_HAVAL5, 0, 0  },
-#if SPH_64
-	{ "Whirlpool",   DO_WHIRLPOOL, 0, 0        },
-#endif
-	{ "Shabal-224",  DO_SHABAL224, 0, 0        },
-	{ "Shabal-256",  DO_SHABAL256, 0, 0        },
-	{ "Shabal-384",  DO_SHABAL384, 0, 0        },
-	{ "Shabal-512",  DO_SHABAL512, 0, 0        },
+	                 , 0, 0, 0 },
+	{ "RMD",         DO_RIPEMD, 0, 0, 0        },
+	{ "RIPEMD",      DO_RIPEMD, 0, 0, 0        },
+	{ "RMD-128",     DO_RIPEMD128, 0, 0, 0     },
+	{ "RIPEMD-128",  DO_RIPEMD128, 0, 0, 0     },
+	{ "RMD-160",     DO_RIPEMD160, 0, 0, 0     },
+	{ "RIPEMD-160",  DO_RIPEMD160, 0, 0, 0     },
+#if SPH_64
+	{ "Tiger",       DO_TIGER, 0, 0, 0         },
+	{ "Tiger2",      DO_TIGER2, 0, 0, 0        },
+#endif
+	{ "Panama",      DO_PANAMA, 0, 0, 0        },
+	{ "HAVAL/3",     DO_HAVAL3, 0, 0, 0        },
+	{ "HAVAL/4",     DO_HAVAL4, 0, 0, 0        },
+	{ "HAVAL/5",     DO_HAVAL5, 0, 0, 0        },
+	{ "HAVAL",       DO_HAVAL3 | DO_HAVAL4 | DO_HAVAL5, 0, 0, 0 },
+#if SPH_64
+	{ "Whirlpool",   DO_WHIRLPOOL, 0, 0, 0     },
+#endif
+	{ "Shabal-224",  DO_SHABAL224, 0, 0, 0     },
+	{ "Shabal-256",  DO_SHABAL256, 0, 0, 0     },
+	{ "Shabal-384",  DO_SHABAL384, 0, 0, 0     },
+	{ "Shabal-512",  DO_SHABAL512, 0, 0, 0     },
 	{ "Shabal",      DO_SHABAL224 | DO_SHABAL256
-	                 | DO_SHABAL384 | DO_SHABAL512, 0, 0  },
-	{ "RadioGatun-32",  DO_RADIOGATUN32, 0, 0  },
+	                 | DO_SHABAL384 | DO_SHABAL512, 0, 0, 0 },
+	{ "RadioGatun-32",  DO_RADIOGATUN32, 0, 0, 0 },
 #if SPH_64
-	{ "RadioGatun-64",  DO_RADIOGATUN64, 0, 0  },
+	{ "RadioGatun-64",  DO_RADIOGATUN64, 0, 0, 0 },
 #endif
-	{ "RadioGatun",     DO_RADIOGATUN32 | DO_RADIOGATUN64, 0, 0  },
-	{ "ECHO-224",    DO_ECHO224, 0, 0          },
-	{ "ECHO-256",    DO_ECHO256, 0, 0          },
-	{ "ECHO-384",    DO_ECHO384, 0, 0          },
-	{ "ECHO-512",    DO_ECHO512, 0, 0          },
+	{ "RadioGatun",     DO_RADIOGATUN32 | DO_RADIOGATUN64, 0, 0, 0 },
+	{ "ECHO-224",    DO_ECHO224, 0, 0, 0       },
+	{ "ECHO-256",    DO_ECHO256, 0, 0, 0       },
+	{ "ECHO-384",    DO_ECHO384, 0, 0, 0       },
+	{ "ECHO-512",    DO_ECHO512, 0, 0, 0       },
 	{ "ECHO",        DO_ECHO224 | DO_ECHO256
-	                 | DO_ECHO384 | DO_ECHO512, 0, 0 },
+	                 | DO_ECHO384 | DO_ECHO512, 0, 0, 0 },
 
-	{ "SIMD-224",    0, DO2_SIMD224, 0      },
-	{ "SIMD-256",    0, DO2_SIMD256, 0      },
-	{ "SIMD-384",    0, DO2_SIMD384, 0      },
-	{ "SIMD-512",    0, DO2_SIMD512, 0      },
+	{ "SIMD-224",    0, DO2_SIMD224, 0, 0   },
+	{ "SIMD-256",    0, DO2_SIMD256, 0, 0   },
+	{ "SIMD-384",    0, DO2_SIMD384, 0, 0   },
+	{ "SIMD-512",    0, DO2_SIMD512, 0, 0   },
 	{ "SIMD",        0, DO2_SIMD224 | DO2_SIMD256
-	                    | DO2_SIMD384 | DO2_SIMD512, 0 },
-	{ "Luffa-224",   0, DO2_LUFFA224, 0     },
-	{ "Luffa-256",   0, DO2_LUFFA256, 0     },
-	{ "Luffa-384",   0, DO2_LUFFA384, 0     },
-	{ "Luffa-512",   0, DO2_LUFFA512, 0     },
+	                    | DO2_SIMD384 | DO2_SIMD512, 0, 0 },
+	{ "Luffa-224",   0, DO2_LUFFA224, 0, 0  },
+	{ "Luffa-256",   0, DO2_LUFFA256, 0, 0  },
+	{ "Luffa-384",   0, DO2_LUFFA384, 0, 0  },
+	{ "Luffa-512",   0, DO2_LUFFA512, 0, 0  },
 	{ "Luffa",       0, DO2_LUFFA224 | DO2_LUFFA256
-	                    | DO2_LUFFA384 | DO2_LUFFA512, 0 },
-	{ "BLAKE-224",   0, DO2_BLAKE224, 0     },
-	{ "BLAKE-256",   0, DO2_BLAKE256, 0     },
+	                    | DO2_LUFFA384 | DO2_LUFFA512, 0, 0 },
+	{ "BLAKE-224",   0, DO2_BLAKE224, 0, 0  },
+	{ "BLAKE-256",   0, DO2_BLAKE256, 0, 0  },
 #if SPH_64
-	{ "BLAKE-384",   0, DO2_BLAKE384, 0     },
-	{ "BLAKE-512",   0, DO2_BLAKE512, 0     },
+	{ "BLAKE-384",   0, DO2_BLAKE384, 0, 0  },
+	{ "BLAKE-512",   0, DO2_BLAKE512, 0, 0  },
 #endif
 	{ "BLAKE",       0, DO2_BLAKE224 | DO2_BLAKE256
 #if SPH_64
 	                    | DO2_BLAKE384 | DO2_BLAKE512
 #endif
-	                    , 0 },
+	                    , 0, 0 },
 
 #if SPH_64
-	{ "Skein-224",   0, DO2_SKEIN224, 0     },
-	{ "Skein-256",   0, DO2_SKEIN256, 0     },
-	{ "Skein-384",   0, DO2_SKEIN384, 0     },
-	{ "Skein-512",   0, DO2_SKEIN512, 0     },
+	{ "Skein-224",   0, DO2_SKEIN224, 0, 0  },
+	{ "Skein-256",   0, DO2_SKEIN256, 0, 0  },
+	{ "Skein-384",   0, DO2_SKEIN384, 0, 0  },
+	{ "Skein-512",   0, DO2_SKEIN512, 0, 0  },
 	{ "Skein",       0, DO2_SKEIN224 | DO2_SKEIN256
-	                    | DO2_SKEIN384 | DO2_SKEIN512, 0 },
+	                    | DO2_SKEIN384 | DO2_SKEIN512, 0, 0 },
 #endif
-	{ "JH-224",      0, DO2_JH224, 0        },
-	{ "JH-256",      0, DO2_JH256, 0        },
-	{ "JH-384",      0, DO2_JH384, 0        },
-	{ "JH-512",      0, DO2_JH512, 0        },
+	{ "JH-224",      0, DO2_JH224, 0, 0     },
+	{ "JH-256",      0, DO2_JH256, 0, 0     },
+	{ "JH-384",      0, DO2_JH384, 0, 0     },
+	{ "JH-512",      0, DO2_JH512, 0, 0     },
 	{ "JH",          0, DO2_JH224 | DO2_JH256
-	                    | DO2_JH384 | DO2_JH512, 0 },
-	{ "Fugue-224",   0, DO2_FUGUE224, 0     },
-	{ "Fugue-256",   0, DO2_FUGUE256, 0     },
-	{ "Fugue-384",   0, DO2_FUGUE384, 0     },
-	{ "Fugue-512",   0, DO2_FUGUE512, 0     },
+	                    | DO2_JH384 | DO2_JH512, 0, 0 },
+	{ "Fugue-224",   0, DO2_FUGUE224, 0, 0  },
+	{ "Fugue-256",   0, DO2_FUGUE256, 0, 0  },
+	{ "Fugue-384",   0, DO2_FUGUE384, 0, 0  },
+	{ "Fugue-512",   0, DO2_FUGUE512, 0, 0  },
 	{ "Fugue",       0, DO2_FUGUE224 | DO2_FUGUE256
-	                    | DO2_FUGUE384 | DO2_FUGUE512, 0 },
-	{ "BMW-224",     0, DO2_BMW224, 0       },
-	{ "BMW-256",     0, DO2_BMW256, 0       },
+	                    | DO2_FUGUE384 | DO2_FUGUE512, 0, 0 },
+	{ "BMW-224",     0, DO2_BMW224, 0, 0    },
+	{ "BMW-256",     0, DO2_BMW256, 0, 0    },
 #if SPH_64
-	{ "BMW-384",     0, DO2_BMW384, 0       },
-	{ "BMW-512",     0, DO2_BMW512, 0       },
+	{ "BMW-384",     0, DO2_BMW384, 0, 0    },
+	{ "BMW-512",     0, DO2_BMW512, 0, 0    },
 #endif
 	{ "BMW",         0, DO2_BMW224 | DO2_BMW256
 #if SPH_64
 	                    | DO2_BMW384 | DO2_BMW512
 #endif
-			    , 0 },
-	{ "CubeHash-224",   0, DO2_CUBEHASH224, 0       },
-	{ "CubeHash-256",   0, DO2_CUBEHASH256, 0       },
-	{ "CubeHash-384",   0, DO2_CUBEHASH384, 0       },
-	{ "CubeHash-512",   0, DO2_CUBEHASH512, 0       },
+			    , 0, 0 },
+	{ "CubeHash-224",   0, DO2_CUBEHASH224, 0, 0    },
+	{ "CubeHash-256",   0, DO2_CUBEHASH256, 0, 0    },
+	{ "CubeHash-384",   0, DO2_CUBEHASH384, 0, 0    },
+	{ "CubeHash-512",   0, DO2_CUBEHASH512, 0, 0    },
 	{ "CubeHash",       0, DO2_CUBEHASH224 | DO2_CUBEHASH256
-	                       | DO2_CUBEHASH384 | DO2_CUBEHASH512, 0 },
+	                       | DO2_CUBEHASH384 | DO2_CUBEHASH512, 0, 0 },
 
-	{ "Keccak-224",     0, 0, DO3_KECCAK224  },
-	{ "Keccak-256",     0, 0, DO3_KECCAK256  },
-	{ "Keccak-384",     0, 0, DO3_KECCAK384  },
-	{ "Keccak-512",     0, 0, DO3_KECCAK512  },
+	{ "Keccak-224",     0, 0, DO3_KECCAK224, 0 },
+	{ "Keccak-256",     0, 0, DO3_KECCAK256, 0 },
+	{ "Keccak-384",     0, 0, DO3_KECCAK384, 0 },
+	{ "Keccak-512",     0, 0, DO3_KECCAK512, 0 },
 	{ "Keccak",         0, 0, DO3_KECCAK224 | DO3_KECCAK256
-	                       | DO3_KECCAK384 | DO3_KECCAK512 },
-	{ "Groestl-224",    0, 0, DO3_GROESTL224  },
-	{ "Groestl-256",    0, 0, DO3_GROESTL256  },
-	{ "Groestl-384",    0, 0, DO3_GROESTL384  },
-	{ "Groestl-512",    0, 0, DO3_GROESTL512  },
+	                       | DO3_KECCAK384 | DO3_KECCAK512, 0 },
+	{ "Groestl-224",    0, 0, DO3_GROESTL224, 0 },
+	{ "Groestl-256",    0, 0, DO3_GROESTL256, 0 },
+	{ "Groestl-384",    0, 0, DO3_GROESTL384, 0 },
+	{ "Groestl-512",    0, 0, DO3_GROESTL512, 0 },
 	{ "Groestl",        0, 0, DO3_GROESTL224 | DO3_GROESTL256
-	                       | DO3_GROESTL384 | DO3_GROESTL512 },
-	{ "Hamsi-224",      0, 0, DO3_HAMSI224  },
-	{ "Hamsi-256",      0, 0, DO3_HAMSI256  },
-	{ "Hamsi-384",      0, 0, DO3_HAMSI384  },
-	{ "Hamsi-512",      0, 0, DO3_HAMSI512  },
+	                       | DO3_GROESTL384 | DO3_GROESTL512, 0 },
+	{ "Hamsi-224",      0, 0, DO3_HAMSI224, 0 },
+	{ "Hamsi-256",      0, 0, DO3_HAMSI256, 0 },
+	{ "Hamsi-384",      0, 0, DO3_HAMSI384, 0 },
+	{ "Hamsi-512",      0, 0, DO3_HAMSI512, 0 },
 	{ "Hamsi",          0, 0, DO3_HAMSI224 | DO3_HAMSI256
-	                       | DO3_HAMSI384 | DO3_HAMSI512 },
-	{ "SHAvite-224",    0, 0, DO3_SHAVITE224  },
-	{ "SHAvite-256",    0, 0, DO3_SHAVITE256  },
-	{ "SHAvite-384",    0, 0, DO3_SHAVITE384  },
-	{ "SHAvite-512",    0, 0, DO3_SHAVITE512  },
+	                       | DO3_HAMSI384 | DO3_HAMSI512, 0 },
+	{ "SHAvite-224",    0, 0, DO3_SHAVITE224, 0 },
+	{ "SHAvite-256",    0, 0, DO3_SHAVITE256, 0 },
+	{ "SHAvite-384",    0, 0, DO3_SHAVITE384, 0 },
+	{ "SHAvite-512",    0, 0, DO3_SHAVITE512, 0 },
 	{ "SHAvite",        0, 0, DO3_SHAVITE224 | DO3_SHAVITE256
-	                       | DO3_SHAVITE384 | DO3_SHAVITE512 },
+	                       | DO3_SHAVITE384 | DO3_SHAVITE512, 0 },
 	{ "SHAvite-3",      0, 0, DO3_SHAVITE224 | DO3_SHAVITE256
-	                       | DO3_SHAVITE384 | DO3_SHAVITE512 },
+	                       | DO3_SHAVITE384 | DO3_SHAVITE512, 0 },
+#if SPH_64
+	{ "Streebog-256",   0, 0, DO3_STREEBOG256, 0 },
+	{ "Streebog-512",   0, 0, DO3_STREEBOG512, 0 },
+	{ "Streebog",       0, 0, DO3_STREEBOG256 | DO3_STREEBOG512, 0 },
+	{ "GOST-2012",      0, 0, DO3_STREEBOG256 | DO3_STREEBOG512, 0 },
+#endif
+
+	{ "BMW-256-multi",  0, 0, 0, DO4_BMW256_MULTI  },
+#if SPH_64
+	{ "BMW-512-multi",  0, 0, 0, DO4_BMW512_MULTI  },
+#endif
+	{ "Luffa-256-multi", 0, 0, 0, DO4_LUFFA256_MULTI },
+	{ "Luffa-512-multi", 0, 0, 0, DO4_LUFFA512_MULTI },
+	{ "CubeHash-256-multi", 0, 0, 0, DO4_CUBEHASH256_MULTI },
+	{ "CubeHash-512-multi", 0, 0, 0, DO4_CUBEHASH512_MULTI },
+	{ "Hamsi-256-multi", 0, 0, 0, DO4_HAMSI256_MULTI },
+	{ "Hamsi-512-multi", 0, 0, 0, DO4_HAMSI512_MULTI },
+	{ "Shabal-256-multi", 0, 0, 0, DO4_SHABAL256_MULTI },
+	{ "Shabal-512-multi", 0, 0, 0, DO4_SHABAL512_MULTI },
+	{ "Whirlpool-multi", 0, 0, 0, DO4_WHIRLPOOL_MULTI },
+	{ "MD5-multi", 0, 0, 0, DO4_MD5_MULTI },
+	{ "SHA-1-multi", 0, 0, 0, DO4_SHA1_MULTI },
+	{ "SHA-384-multi", 0, 0, 0, DO4_SHA384_MULTI },
+	{ "SHA-512-multi", 0, 0, 0, DO4_SHA512_MULTI },
+	{ "SHA-224-multi", 0, 0, 0, DO4_SHA224_MULTI },
+	{ "SHA-256-multi", 0, 0, 0, DO4_SHA256_MULTI },
+	{ "RIPEMD-160-multi", 0, 0, 0, DO4_RIPEMD160_MULTI },
+	{ "ECHO-512-multi", 0, 0, 0, DO4_ECHO512_MULTI },
+	{ "SHAvite-512-multi", 0, 0, 0, DO4_SHAVITE512_MULTI },
+	{ "Groestl-512-multi", 0, 0, 0, DO4_GROESTL512_MULTI },
 
-	{ NULL, 0, 0, 0 }
+	{ NULL, 0, 0, 0, 0 }
 };
 
 static void
@@ -498,7 +657,9 @@ fail_unknown(char *name)
 			|| function_names[u].flags2
 				!= function_names[u - 1].flags2
 			|| function_names[u].flags3
-				!= function_names[u - 1].flags3))) {
+				!= function_names[u - 1].flags3
+			|| function_names[u].flags4
+				!= function_names[u - 1].flags4))) {
 			fprintf(stderr, "\n   ");
 		} else {
 			fprintf(stderr, " ");
@@ -559,6 +720,10 @@ fail_unknown(char *name)
 		" Hamsi-384 and Hamsi-512.\n");
 	fprintf(stderr, "'SHAvite' and 'SHAvite-3' stand for SHAvite-224,"
 		" SHAvite-256, SHAvite-384 and SHAvite-512.\n");
+	fprintf(stderr, "'Streebog' and 'GOST-2012' stand for Streebog-256"
+		" and Streebog-512.\n");
+	fprintf(stderr, "'-multi' names benchmark the multi-message"
+		" functions.\n");
 	exit(EXIT_FAILURE);
 }
 
@@ -593,31 +758,91 @@ match_names(char *s1, char *s2)
 	}
 }
 
+#if SPH_64
+static const char *const tune_names[] = {
+	"echo224", "echo256", "echo384", "echo512",
+	"groestl224", "groestl256", "groestl384", "groestl512",
+	"hamsi224", "hamsi256", "hamsi384", "hamsi512",
+	"jh224", "jh256", "jh384", "jh512",
+	"keccak224", "keccak256", "keccak384", "keccak512"
+};
+
+static const unsigned tune_algs[] = {
+	SPH_HASH_ECHO224, SPH_HASH_ECHO256, SPH_HASH_ECHO384, SPH_HASH_ECHO512,
+	SPH_HASH_GROESTL224, SPH_HASH_GROESTL256,
+	SPH_HASH_GROESTL384, SPH_HASH_GROESTL512,
+	SPH_HASH_HAMSI224, SPH_HASH_HAMSI256,
+	SPH_HASH_HAMSI384, SPH_HASH_HAMSI512,
+	SPH_HASH_JH224, SPH_HASH_JH256, SPH_HASH_JH384, SPH_HASH_JH512,
+	SPH_HASH_KECCAK224, SPH_HASH_KECCAK256,
+	SPH_HASH_KECCAK384, SPH_HASH_KECCAK512
+};
+
+/*
+ * Run the auto-tuner, print the selected variants (one column per
+ * message size class) and optionally save the profile.
+ */
+static void
+speed_tune(const char *path)
+{
+	static const size_t class_len[SPH_TUNE_CLASSES] = {
+		64, 1024, 16384, 65536
+	};
+	size_t u;
+	int c;
+
+	sph_tune_run();
+	printf("%-12s %-8s %-8s %-8s %-8s\n",
+		"function", "<=64", "<=1k", "<=16k", "larger");
+	for (u = 0; u < (sizeof tune_algs) / sizeof tune_algs[0]; u ++) {
+		printf("%-12s", tune_names[u]);
+		for (c = 0; c < SPH_TUNE_CLASSES; c ++)
+			printf(" %-8s",
+				sph_tune_variant(tune_algs[u], class_len[c]));
+		printf("\n");
+	}
+	if (path != NULL) {
+		if (!sph_tune_save(path)) {
+			fprintf(stderr, "could not write profile: %s\n", path);
+			exit(EXIT_FAILURE);
+		}
+		printf("profile saved to: %s\n", path);
+	}
+}
+#endif
+
 int
 main(int argc, char *argv[])
 {
-	unsigned long todo, todo2, todo3;
+	unsigned long todo, todo2, todo3, todo4;
 	int i;
 
-	todo = todo2 = todo3 = 0;
+	todo = todo2 = todo3 = todo4 = 0;
 	for (i = 1; i < argc; i ++) {
 		char *name;
 		size_t u;
 
 		name = argv[i];
+#if SPH_64
+		if (strcmp(name, "-tune") == 0) {
+			speed_tune(i + 1 < argc ? argv[i + 1] : NULL);
+			return 0;
+		}
+#endif
 		for (u = 0; function_names[u].name != NULL; u ++) {
 			if (match_names(name, function_names[u].name)) {
 				todo |= function_names[u].flags;
 				todo2 |= function_names[u].flags2;
 				todo3 |= function_names[u].flags3;
+				todo4 |= function_names[u].flags4;
 				break;
 			}
 		}
 		if (function_names[u].name == NULL)
 			fail_unknown(name);
 	}
-	if (todo == 0 && todo2 == 0 && todo3 == 0)
-		todo = todo2 = todo3 = ~(unsigned long)0;
+	if (todo == 0 && todo2 == 0 && todo3 == 0 && todo4 == 0)
+		todo = todo2 = todo3 = todo4 = ~(unsigned long)0;
 	data = malloc(DATA_LEN);
 	if (data == NULL) {
 		fprintf(stderr, "could not allocate input buffer\n");
@@ -794,5 +1019,58 @@ main(int argc, char *argv[])
 		speed_shavite384();
 	if (todo3 & DO3_SHAVITE512)
 		speed_shavite512();
+#if SPH_64
+	if (todo3 & DO3_STREEBOG256)
+		speed_gost256();
+	if (todo3 & DO3_STREEBOG512)
+		speed_gost512();
+#endif
+
+	if (todo4 & DO4_BMW256_MULTI)
+		speed_bmw256_multi();
+#if SPH_64
+	if (todo4 & DO4_BMW512_MULTI)
+		speed_bmw512_multi();
+#endif
+	if (todo4 & DO4_LUFFA256_MULTI)
+		speed_luffa256_multi();
+	if (todo4 & DO4_LUFFA512_MULTI)
+		speed_luffa512_multi();
+	if (todo4 & DO4_CUBEHASH256_MULTI)
+		speed_cubehash256_multi();
+	if (todo4 & DO4_CUBEHASH512_MULTI)
+		speed_cubehash512_multi();
+	if (todo4 & DO4_HAMSI256_MULTI)
+		speed_hamsi256_multi();
+	if (todo4 & DO4_HAMSI512_MULTI)
+		speed_hamsi512_multi();
+	if (todo4 & DO4_SHABAL256_MULTI)
+		speed_shabal256_multi();
+	if (todo4 & DO4_SHABAL512_MULTI)
+		speed_shabal512_multi();
+	if (todo4 & DO4_WHIRLPOOL_MULTI)
+		speed_whirlpool_multi();
+	if (todo4 & DO4_MD5_MULTI)
+		speed_md5_multi();
+	if (todo4 & DO4_SHA1_MULTI)
+		speed_sha1_multi();
+#if SPH_64
+	if (todo4 & DO4_SHA384_MULTI)
+		speed_sha384_multi();
+	if (todo4 & DO4_SHA512_MULTI)
+		speed_sha512_multi();
+#endif
+	if (todo4 & DO4_SHA224_MULTI)
+		speed_sha224_multi();
+	if (todo4 & DO4_SHA256_MULTI)
+		speed_sha256_multi();
+	if (todo4 & DO4_RIPEMD160_MULTI)
+		speed_ripemd160_multi();
+	if (todo4 & DO4_ECHO512_MULTI)
+		speed_echo512_multi();
+	if (todo4 & DO4_SHAVITE512_MULTI)
+		speed_shavite512_multi();
+	if (todo4 & DO4_GROESTL512_MULTI)
+		speed_groestl512_multi();
 	return 0;
 }
@@ -0,0 +1,573 @@
+/* $Id$ */
+/**
+ * Batched hashing of independent messages.
+ *
+ * Several hash functions have a multi-message implementation
+ * (<code>sph_XXX_multi()</code>) which hashes one message per vector
+ * lane. Such a function is most efficient when the messages of each
+ * group of lanes have the same length: the lanes then run for the same
+ * number of blocks and finish together. The function of this module
+ * takes a batch of messages for a given algorithm, identified by one of
+ * the <code>SPH_HASH_*</code> constants, regroups the messages by length
+ * and hands them over to the multi-message function; that function
+ * selects the widest vector code that the processor supports, and
+ * handles the final partial blocks of each lane. For algorithms without
+ * a multi-message implementation, the messages are hashed one at a time
+ * with <code>sph_XXX_oneshot()</code>. The caller thus needs not know
+ * which algorithms have vector code.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_batch.h
+ */
+
+#ifndef SPH_BATCH_H__
+#define SPH_BATCH_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+/**
+ * Algorithm identifier: MD2.
+ */
+#define SPH_HASH_MD2             0
+
+/**
+ * Algorithm identifier: MD4.
+ */
+#define SPH_HASH_MD4             1
+
+/**
+ * Algorithm identifier: MD5.
+ */
+#define SPH_HASH_MD5             2
+
+/**
+ * Algorithm identifier: PANAMA.
+ */
+#define SPH_HASH_PANAMA          3
+
+/**
+ * Algorithm identifier: RadioGatun[32].
+ */
+#define SPH_HASH_RADIOGATUN32    4
+
+/**
+ * Algorithm identifier: RadioGatun[64].
+ */
+#define SPH_HASH_RADIOGATUN64    5
+
+/**
+ * Algorithm identifier: RIPEMD.
+ */
+#define SPH_HASH_RIPEMD          6
+
+/**
+ * Algorithm identifier: RIPEMD-128.
+ */
+#define SPH_HASH_RIPEMD128       7
+
+/**
+ * Algorithm identifier: RIPEMD-160.
+ */
+#define SPH_HASH_RIPEMD160       8
+
+/**
+ * Algorithm identifier: SHA-0.
+ */
+#define SPH_HASH_SHA0            9
+
+/**
+ * Algorithm identifier: SHA-1.
+ */
+#define SPH_HASH_SHA1           10
+
+/**
+ * Algorithm identifier: SHA-224.
+ */
+#define SPH_HASH_SHA224         11
+
+/**
+ * Algorithm identifier: SHA-256.
+ */
+#define SPH_HASH_SHA256         12
+
+/**
+ * Algorithm identifier: SHA-384.
+ */
+#define SPH_HASH_SHA384         13
+
+/**
+ * Algorithm identifier: SHA-512.
+ */
+#define SPH_HASH_SHA512         14
+
+/**
+ * Algorithm identifier: Tiger.
+ */
+#define SPH_HASH_TIGER          15
+
+/**
+ * Algorithm identifier: Tiger2.
+ */
+#define SPH_HASH_TIGER2         16
+
+/**
+ * Algorithm identifier: WHIRLPOOL.
+ */
+#define SPH_HASH_WHIRLPOOL      17
+
+/**
+ * Algorithm identifier: WHIRLPOOL-0.
+ */
+#define SPH_HASH_WHIRLPOOL0     18
+
+/**
+ * Algorithm identifier: WHIRLPOOL-1.
+ */
+#define SPH_HASH_WHIRLPOOL1     19
+
+/**
+ * Algorithm identifier: GOST R 34.11-94.
+ */
+#define SPH_HASH_GOST           20
+
+/**
+ * Algorithm identifier: Streebog-256.
+ */
+#define SPH_HASH_STREEBOG256    21
+
+/**
+ * Algorithm identifier: Streebog-512.
+ */
+#define SPH_HASH_STREEBOG512    22
+
+/**
+ * Algorithm identifier: HAVAL-128/3.
+ */
+#define SPH_HASH_HAVAL128_3     23
+
+/**
+ * Algorithm identifier: HAVAL-128/4.
+ */
+#define SPH_HASH_HAVAL128_4     24
+
+/**
+ * Algorithm identifier: HAVAL-128/5.
+ */
+#define SPH_HASH_HAVAL128_5     25
+
+/**
+ * Algorithm identifier: HAVAL-160/3.
+ */
+#define SPH_HASH_HAVAL160_3     26
+
+/**
+ * Algorithm identifier: HAVAL-160/4.
+ */
+#define SPH_HASH_HAVAL160_4     27
+
+/**
+ * Algorithm identifier: HAVAL-160/5.
+ */
+#define SPH_HASH_HAVAL160_5     28
+
+/**
+ * Algorithm identifier: HAVAL-192/3.
+ */
+#define SPH_HASH_HAVAL192_3     29
+
+/**
+ * Algorithm identifier: HAVAL-192/4.
+ */
+#define SPH_HASH_HAVAL192_4     30
+
+/**
+ * Algorithm identifier: HAVAL-192/5.
+ */
+#define SPH_HASH_HAVAL192_5     31
+
+/**
+ * Algorithm identifier: HAVAL-224/3.
+ */
+#define SPH_HASH_HAVAL224_3     32
+
+/**
+ * Algorithm identifier: HAVAL-224/4.
+ */
+#define SPH_HASH_HAVAL224_4     33
+
+/**
+ * Algorithm identifier: HAVAL-224/5.
+ */
+#define SPH_HASH_HAVAL224_5     34
+
+/**
+ * Algorithm identifier: HAVAL-256/3.
+ */
+#define SPH_HASH_HAVAL256_3     35
+
+/**
+ * Algorithm identifier: HAVAL-256/4.
+ */
+#define SPH_HASH_HAVAL256_4     36
+
+/**
+ * Algorithm identifier: HAVAL-256/5.
+ */
+#define SPH_HASH_HAVAL256_5     37
+
+/**
+ * Algorithm identifier: BLAKE-224.
+ */
+#define SPH_HASH_BLAKE224       38
+
+/**
+ * Algorithm identifier: BLAKE-256.
+ */
+#define SPH_HASH_BLAKE256       39
+
+/**
+ * Algorithm identifier: BLAKE-384.
+ */
+#define SPH_HASH_BLAKE384       40
+
+/**
+ * Algorithm identifier: BLAKE-512.
+ */
+#define SPH_HASH_BLAKE512       41
+
+/**
+ * Algorithm identifier: BMW-224.
+ */
+#define SPH_HASH_BMW224         42
+
+/**
+ * Algorithm identifier: BMW-256.
+ */
+#define SPH_HASH_BMW256         43
+
+/**
+ * Algorithm identifier: BMW-384.
+ */
+#define SPH_HASH_BMW384         44
+
+/**
+ * Algorithm identifier: BMW-512.
+ */
+#define SPH_HASH_BMW512         45
+
+/**
+ * Algorithm identifier: CubeHash-224.
+ */
+#define SPH_HASH_CUBEHASH224    46
+
+/**
+ * Algorithm identifier: CubeHash-256.
+ */
+#define SPH_HASH_CUBEHASH256    47
+
+/**
+ * Algorithm identifier: CubeHash-384.
+ */
+#define SPH_HASH_CUBEHASH384    48
+
+/**
+ * Algorithm identifier: CubeHash-512.
+ */
+#define SPH_HASH_CUBEHASH512    49
+
+/**
+ * Algorithm identifier: ECHO-224.
+ */
+#define SPH_HASH_ECHO224        50
+
+/**
+ * Algorithm identifier: ECHO-256.
+ */
+#define SPH_HASH_ECHO256        51
+
+/**
+ * Algorithm identifier: ECHO-384.
+ */
+#define SPH_HASH_ECHO384        52
+
+/**
+ * Algorithm identifier: ECHO-512.
+ */
+#define SPH_HASH_ECHO512        53
+
+/**
+ * Algorithm identifier: Fugue-224.
+ */
+#define SPH_HASH_FUGUE224       54
+
+/**
+ * Algorithm identifier: Fugue-256.
+ */
+#define SPH_HASH_FUGUE256       55
+
+/**
+ * Algorithm identifier: Fugue-384.
+ */
+#define SPH_HASH_FUGUE384       56
+
+/**
+ * Algorithm identifier: Fugue-512.
+ */
+#define SPH_HASH_FUGUE512       57
+
+/**
+ * Algorithm identifier: Groestl-224.
+ */
+#define SPH_HASH_GROESTL224     58
+
+/**
+ * Algorithm identifier: Groestl-256.
+ */
+#define SPH_HASH_GROESTL256     59
+
+/**
+ * Algorithm identifier: Groestl-384.
+ */
+#define SPH_HASH_GROESTL384     60
+
+/**
+ * Algorithm identifier: Groestl-512.
+ */
+#define SPH_HASH_GROESTL512     61
+
+/**
+ * Algorithm identifier: Hamsi-224.
+ */
+#define SPH_HASH_HAMSI224       62
+
+/**
+ * Algorithm identifier: Hamsi-256.
+ */
+#define SPH_HASH_HAMSI256       63
+
+/**
+ * Algorithm identifier: Hamsi-384.
+ */
+#define SPH_HASH_HAMSI384       64
+
+/**
+ * Algorithm identifier: Hamsi-512.
+ */
+#define SPH_HASH_HAMSI512       65
+
+/**
+ * Algorithm identifier: JH-224.
+ */
+#define SPH_HASH_JH224          66
+
+/**
+ * Algorithm identifier: JH-256.
+ */
+#define SPH_HASH_JH256          67
+
+/**
+ * Algorithm identifier: JH-384.
+ */
+#define SPH_HASH_JH384          68
+
+/**
+ * Algorithm identifier: JH-512.
+ */
+#define SPH_HASH_JH512          69
+
+/**
+ * Algorithm identifier: Keccak-224.
+ */
+#define SPH_HASH_KECCAK224      70
+
+/**
+ * Algorithm identifier: Keccak-256.
+ */
+#define SPH_HASH_KECCAK256      71
+
+/**
+ * Algorithm identifier: Keccak-384.
+ */
+#define SPH_HASH_KECCAK384      72
+
+/**
+ * Algorithm identifier: Keccak-512.
+ */
+#define SPH_HASH_KECCAK512      73
+
+/**
+ * Algorithm identifier: Luffa-224.
+ */
+#define SPH_HASH_LUFFA224       74
+
+/**
+ * Algorithm identifier: Luffa-256.
+ */
+#define SPH_HASH_LUFFA256       75
+
+/**
+ * Algorithm identifier: Luffa-384.
+ */
+#define SPH_HASH_LUFFA384       76
+
+/**
+ * Algorithm identifier: Luffa-512.
+ */
+#define SPH_HASH_LUFFA512       77
+
+/**
+ * Algorithm identifier: Shabal-192.
+ */
+#define SPH_HASH_SHABAL192      78
+
+/**
+ * Algorithm identifier: Shabal-224.
+ */
+#define SPH_HASH_SHABAL224      79
+
+/**
+ * Algorithm identifier: Shabal-256.
+ */
+#define SPH_HASH_SHABAL256      80
+
+/**
+ * Algorithm identifier: Shabal-384.
+ */
+#define SPH_HASH_SHABAL384      81
+
+/**
+ * Algorithm identifier: Shabal-512.
+ */
+#define SPH_HASH_SHABAL512      82
+
+/**
+ * Algorithm identifier: SHAvite-224.
+ */
+#define SPH_HASH_SHAVITE224     83
+
+/**
+ * Algorithm identifier: SHAvite-256.
+ */
+#define SPH_HASH_SHAVITE256     84
+
+/**
+ * Algorithm identifier: SHAvite-384.
+ */
+#define SPH_HASH_SHAVITE384     85
+
+/**
+ * Algorithm identifier: SHAvite-512.
+ */
+#define SPH_HASH_SHAVITE512     86
+
+/**
+ * Algorithm identifier: SIMD-224.
+ */
+#define SPH_HASH_SIMD224        87
+
+/**
+ * Algorithm identifier: SIMD-256.
+ */
+#define SPH_HASH_SIMD256        88
+
+/**
+ * Algorithm identifier: SIMD-384.
+ */
+#define SPH_HASH_SIMD384        89
+
+/**
+ * Algorithm identifier: SIMD-512.
+ */
+#define SPH_HASH_SIMD512        90
+
+/**
+ * Algorithm identifier: Skein-224.
+ */
+#define SPH_HASH_SKEIN224       91
+
+/**
+ * Algorithm identifier: Skein-256.
+ */
+#define SPH_HASH_SKEIN256       92
+
+/**
+ * Algorithm identifier: Skein-384.
+ */
+#define SPH_HASH_SKEIN384       93
+
+/**
+ * Algorithm identifier: Skein-512.
+ */
+#define SPH_HASH_SKEIN512       94
+
+/**
+ * Number of algorithm identifiers.
+ */
+#define SPH_HASH_NUM            95
+
+/**
+ * Get the output length of an algorithm.
+ *
+ * @param alg   the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @return  the output length (in bytes), or 0 if <code>alg</code> is
+ *          not a valid identifier
+ */
+size_t sph_hash_size(unsigned alg);
+
+/**
+ * Hash <code>num</code> independent messages with the algorithm
+ * <code>alg</code>. Message <code>i</code> is <code>len[i]</code> bytes
+ * at <code>data[i]</code>; its hash value is written at
+ * <code>dst[i]</code> (<code>sph_hash_size(alg)</code> bytes). The
+ * output is identical to what <code>sph_XXX_oneshot()</code> computes
+ * for each message. The destination buffers must not overlap with the
+ * messages. If <code>alg</code> is not a valid identifier, nothing is
+ * written. This function performs no memory allocation.
+ *
+ * @param alg    the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hash_batch(unsigned alg, const void *const *data,
+	const size_t *len, void *const *dst, size_t num);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
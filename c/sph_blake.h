@@ -154,6 +154,18 @@ void sph_blake224_init(void *cc);
  */
 void sph_blake224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_blake224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BLAKE-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_blake224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BLAKE-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -165,6 +177,20 @@ void sph_blake224(void *cc, const void *data, size_t len);
  */
 void sph_blake224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BLAKE-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_blake224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -199,6 +225,18 @@ void sph_blake256_init(void *cc);
  */
 void sph_blake256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_blake256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BLAKE-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_blake256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BLAKE-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -210,6 +248,20 @@ void sph_blake256(void *cc, const void *data, size_t len);
  */
 void sph_blake256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BLAKE-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_blake256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -246,6 +298,18 @@ void sph_blake384_init(void *cc);
  */
 void sph_blake384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_blake384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BLAKE-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_blake384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BLAKE-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -257,6 +321,20 @@ void sph_blake384(void *cc, const void *data, size_t len);
  */
 void sph_blake384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BLAKE-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_blake384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -291,6 +369,18 @@ void sph_blake512_init(void *cc);
  */
 void sph_blake512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_blake512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BLAKE-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_blake512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BLAKE-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -302,6 +392,20 @@ void sph_blake512(void *cc, const void *data, size_t len);
  */
 void sph_blake512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BLAKE-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_blake512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
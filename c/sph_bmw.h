@@ -155,6 +155,18 @@ void sph_bmw224_init(void *cc);
  */
 void sph_bmw224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_bmw224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BMW-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_bmw224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BMW-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -166,6 +178,17 @@ void sph_bmw224(void *cc, const void *data, size_t len);
  */
 void sph_bmw224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BMW-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_bmw224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -182,6 +205,30 @@ void sph_bmw224_close(void *cc, void *dst);
 void sph_bmw224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute BMW-224 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (28 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_bmw224_init()</code>,
+ * <code>sph_bmw224()</code> and <code>sph_bmw224_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * Messages are processed in groups of lanes: 8 lanes with AVX2,
+ * 4 lanes with SSE2. Within a group, the full blocks common to all
+ * messages are hashed in parallel; when all messages of the group have
+ * the same length, the padding and the final compression are also
+ * performed in parallel (this is the fast path for batches of
+ * fixed-size inputs). Otherwise, each message is completed with the
+ * portable code. Without vector support, messages are hashed in turn.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_bmw224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a BMW-256 context. This process performs no memory allocation.
  *
@@ -200,6 +247,18 @@ void sph_bmw256_init(void *cc);
  */
 void sph_bmw256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_bmw256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BMW-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_bmw256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BMW-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -211,6 +270,17 @@ void sph_bmw256(void *cc, const void *data, size_t len);
  */
 void sph_bmw256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BMW-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_bmw256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -227,6 +297,22 @@ void sph_bmw256_close(void *cc, void *dst);
 void sph_bmw256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute BMW-256 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (32 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_bmw256_init()</code>,
+ * <code>sph_bmw256()</code> and <code>sph_bmw256_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_bmw256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #if SPH_64
 
 /**
@@ -247,6 +333,18 @@ void sph_bmw384_init(void *cc);
  */
 void sph_bmw384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_bmw384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BMW-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_bmw384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BMW-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -258,6 +356,17 @@ void sph_bmw384(void *cc, const void *data, size_t len);
  */
 void sph_bmw384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BMW-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_bmw384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -274,6 +383,30 @@ void sph_bmw384_close(void *cc, void *dst);
 void sph_bmw384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute BMW-384 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (48 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_bmw384_init()</code>,
+ * <code>sph_bmw384()</code> and <code>sph_bmw384_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * Messages are processed in groups of lanes: 4 lanes with AVX2,
+ * 2 lanes with SSE2. Within a group, the full blocks common to all
+ * messages are hashed in parallel; when all messages of the group have
+ * the same length, the padding and the final compression are also
+ * performed in parallel (this is the fast path for batches of
+ * fixed-size inputs). Otherwise, each message is completed with the
+ * portable code. Without vector support, messages are hashed in turn.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_bmw384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a BMW-512 context. This process performs no memory allocation.
  *
@@ -292,6 +425,18 @@ void sph_bmw512_init(void *cc);
  */
 void sph_bmw512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_bmw512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the BMW-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_bmw512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current BMW-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -303,6 +448,17 @@ void sph_bmw512(void *cc, const void *data, size_t len);
  */
 void sph_bmw512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with BMW-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_bmw512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -319,6 +475,22 @@ void sph_bmw512_close(void *cc, void *dst);
 void sph_bmw512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute BMW-512 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (64 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_bmw512_init()</code>,
+ * <code>sph_bmw512()</code> and <code>sph_bmw512_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_bmw512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #endif
 
 #ifdef __cplusplus
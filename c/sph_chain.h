@@ -0,0 +1,208 @@
+/* $Id$ */
+/**
+ * Chained hashing with a per-message order of algorithms.
+ *
+ * Some constructions hash a message with a sequence of sixteen 512-bit
+ * hash functions, each step hashing the 64-byte output of the previous
+ * one; the order of the functions is derived from some data (e.g. the
+ * bytes of a previous digest), so that distinct messages may use
+ * distinct functions at the same step. The functions of this module
+ * process many such chains at once: at each step, the messages are
+ * regrouped by algorithm, and each group is sent as one batch to the
+ * multi-message function of that algorithm (for the algorithms which
+ * have one), so that the vector lanes of the multi-message code are
+ * filled even though the order varies from one message to another.
+ *
+ * The order itself is provided by the caller, as one algorithm
+ * identifier (<code>SPH_CHAIN_*</code>) per message and step.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_chain.h
+ */
+
+#ifndef SPH_CHAIN_H__
+#define SPH_CHAIN_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+/**
+ * Algorithm identifier: BLAKE-512.
+ */
+#define SPH_CHAIN_BLAKE       0
+
+/**
+ * Algorithm identifier: BMW-512.
+ */
+#define SPH_CHAIN_BMW         1
+
+/**
+ * Algorithm identifier: Groestl-512.
+ */
+#define SPH_CHAIN_GROESTL     2
+
+/**
+ * Algorithm identifier: JH-512.
+ */
+#define SPH_CHAIN_JH          3
+
+/**
+ * Algorithm identifier: Keccak-512.
+ */
+#define SPH_CHAIN_KECCAK      4
+
+/**
+ * Algorithm identifier: Skein-512 (512-bit output).
+ */
+#define SPH_CHAIN_SKEIN       5
+
+/**
+ * Algorithm identifier: Luffa-512.
+ */
+#define SPH_CHAIN_LUFFA       6
+
+/**
+ * Algorithm identifier: CubeHash-512.
+ */
+#define SPH_CHAIN_CUBEHASH    7
+
+/**
+ * Algorithm identifier: SHAvite-512.
+ */
+#define SPH_CHAIN_SHAVITE     8
+
+/**
+ * Algorithm identifier: SIMD-512.
+ */
+#define SPH_CHAIN_SIMD        9
+
+/**
+ * Algorithm identifier: ECHO-512.
+ */
+#define SPH_CHAIN_ECHO       10
+
+/**
+ * Algorithm identifier: Hamsi-512.
+ */
+#define SPH_CHAIN_HAMSI      11
+
+/**
+ * Algorithm identifier: Fugue-512.
+ */
+#define SPH_CHAIN_FUGUE      12
+
+/**
+ * Algorithm identifier: Shabal-512.
+ */
+#define SPH_CHAIN_SHABAL     13
+
+/**
+ * Algorithm identifier: WHIRLPOOL.
+ */
+#define SPH_CHAIN_WHIRLPOOL  14
+
+/**
+ * Algorithm identifier: SHA-512.
+ */
+#define SPH_CHAIN_SHA512     15
+
+/**
+ * Number of algorithm identifiers.
+ */
+#define SPH_CHAIN_NUM        16
+
+/**
+ * Lane occupancy counters. For each algorithm, <code>calls</code> is
+ * the number of batches sent to the algorithm, and <code>lanes</code>
+ * the total number of messages in those batches; the ratio is the
+ * average batch size, to be compared with the number of lanes of the
+ * multi-message code of the algorithm. Algorithms without such code
+ * process their batches one message at a time, and <code>calls</code>
+ * then counts the groups nonetheless. The counters are only ever
+ * incremented, so that a structure may accumulate over several calls;
+ * it must be cleared by the caller.
+ */
+typedef struct {
+	unsigned long calls[SPH_CHAIN_NUM];
+	unsigned long lanes[SPH_CHAIN_NUM];
+} sph_chain_stats;
+
+/**
+ * Compute <code>num</code> hash chains. Message <code>i</code> is
+ * <code>len[i]</code> bytes at <code>data[i]</code>. Step
+ * <code>s</code> (from 0 to <code>steps-1</code>) of that chain
+ * applies the algorithm <code>order[i * steps + s]</code> (one of the
+ * <code>SPH_CHAIN_*</code> identifiers) to the output of step
+ * <code>s-1</code> (64 bytes), or to the message itself for step 0.
+ * The output of the last step (64 bytes) is written at
+ * <code>dst[i]</code>; it may overlap with the message. If
+ * <code>steps</code> is zero, nothing is written. If any byte of
+ * <code>order</code> is not a valid identifier, nothing is written and
+ * 0 is returned. This function performs no memory allocation.
+ *
+ * @param data    the input messages
+ * @param len     the input message lengths (in bytes)
+ * @param dst     the destination buffers
+ * @param num     the number of messages
+ * @param order   the algorithm identifiers (<code>num * steps</code>)
+ * @param steps   the number of steps in each chain
+ * @param stats   the lane occupancy counters to update (or
+ *                <code>NULL</code>)
+ * @return  1 on success, 0 on an invalid algorithm identifier
+ */
+int sph_chain_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num,
+	const unsigned char *order, size_t steps, sph_chain_stats *stats);
+
+/**
+ * Compute one hash chain, with the same conventions as
+ * <code>sph_chain_multi()</code> for a single message. This is the
+ * one-message reference for the batched function.
+ *
+ * @param data    the input message
+ * @param len     the input message length (in bytes)
+ * @param dst     the destination buffer (64 bytes)
+ * @param order   the algorithm identifiers (<code>steps</code>)
+ * @param steps   the number of steps in the chain
+ * @return  1 on success, 0 on an invalid algorithm identifier
+ */
+int sph_chain(const void *data, size_t len, void *dst,
+	const unsigned char *order, size_t steps);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,500 @@
+/* $Id$ */
+/**
+ * C++ interface: compile-time SHA-256, Keccak-256 and BLAKE-256.
+ *
+ * The functions in <code>sph::cx</code> are <code>constexpr</code>
+ * implementations of SHA-256, Keccak-256 and BLAKE-256 which produce
+ * the same output as <code>sph_sha256()</code>,
+ * <code>sph_keccak256()</code> and <code>sph_blake256()</code>. Applied
+ * to constant strings (message tags, selectors, domain separators),
+ * they are evaluated by the compiler, and the digests are embedded as
+ * constants; <code>sph::cx::prefix32()</code> turns a digest into a
+ * value usable as a <code>case</code> label. They also work at runtime,
+ * but are much slower than the C code and are not meant for that.
+ *
+ * The round constants and initial values of the three functions are
+ * kept in a single table (<code>sph::cx::tables</code>); BLAKE-256
+ * shares its initial value with SHA-256. The table is checked at compile
+ * time against known answers, and at runtime against the C code by the
+ * unit tests. This header requires C++17.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_constexpr.hpp
+ */
+
+#ifndef SPH_CONSTEXPR_HPP__
+#define SPH_CONSTEXPR_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace sph {
+namespace cx {
+
+/**
+ * Digest type of the compile-time functions.
+ */
+typedef std::array<unsigned char, 32> digest;
+
+/**
+ * Round constants and initial values.
+ */
+struct tables {
+	/** SHA-256 (and BLAKE-256) initial value. */
+	static constexpr std::uint32_t iv256[8] = {
+		0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+		0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+	};
+
+	/** SHA-256 round constants. */
+	static constexpr std::uint32_t sha256_k[64] = {
+		0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+		0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+		0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+		0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+		0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+		0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+		0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+		0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+		0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+		0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+		0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+		0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+		0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+		0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+		0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+		0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+	};
+
+	/** BLAKE-256 constants (digits of pi). */
+	static constexpr std::uint32_t blake_c[16] = {
+		0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344,
+		0xA4093822, 0x299F31D0, 0x082EFA98, 0xEC4E6C89,
+		0x452821E6, 0x38D01377, 0xBE5466CF, 0x34E90C6C,
+		0xC0AC29B7, 0xC97C50DD, 0x3F84D5B5, 0xB5470917
+	};
+
+	/** BLAKE message permutations. */
+	static constexpr unsigned char blake_sigma[10][16] = {
+		{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+		{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+		{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+		{  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+		{  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+		{  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+		{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+		{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+		{  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+		{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+	};
+
+	/** Keccak-f[1600] round constants. */
+	static constexpr std::uint64_t keccak_rc[24] = {
+		0x0000000000000001, 0x0000000000008082,
+		0x800000000000808A, 0x8000000080008000,
+		0x000000000000808B, 0x0000000080000001,
+		0x8000000080008081, 0x8000000000008009,
+		0x000000000000008A, 0x0000000000000088,
+		0x0000000080008009, 0x000000008000000A,
+		0x000000008000808B, 0x800000000000008B,
+		0x8000000000008089, 0x8000000000008003,
+		0x8000000000008002, 0x8000000000000080,
+		0x000000000000800A, 0x800000008000000A,
+		0x8000000080008081, 0x8000000000008080,
+		0x0000000080000001, 0x8000000080008008
+	};
+
+	/** Keccak rotation counts, for lane x + 5 * y. */
+	static constexpr unsigned char keccak_rot[25] = {
+		 0,  1, 62, 28, 27,
+		36, 44,  6, 55, 20,
+		 3, 10, 43, 25, 39,
+		41, 45, 15, 21,  8,
+		18,  2, 61, 56, 14
+	};
+};
+
+#ifndef DOXYGEN_IGNORE
+
+namespace detail {
+
+constexpr std::uint32_t
+rotr32(std::uint32_t x, unsigned n)
+{
+	return (x >> n) | (x << (32 - n));
+}
+
+constexpr std::uint64_t
+rotl64(std::uint64_t x, unsigned n)
+{
+	return n == 0 ? x : (x << n) | (x >> (64 - n));
+}
+
+/*
+ * Byte i of the input, for a string view or an array of bytes.
+ */
+template <class S>
+constexpr unsigned
+byte_at(const S &s, std::size_t i)
+{
+	return static_cast<unsigned char>(s[i]);
+}
+
+/*
+ * Padded stream of the MD-strengthened functions: the message, a 0x80
+ * byte, zeros, and the length in bits over 8 bytes (big-endian). If
+ * blake is true, the byte just before the length also has its low bit
+ * set. The padded length is plen.
+ */
+template <class S>
+constexpr unsigned
+md_byte(const S &s, std::size_t len, std::size_t plen, std::size_t i,
+	bool blake)
+{
+	unsigned b = 0;
+
+	if (i < len)
+		return byte_at(s, i);
+	if (i >= plen - 8)
+		return static_cast<unsigned>(
+			(static_cast<std::uint64_t>(len) << 3)
+			>> (8 * (plen - 1 - i))) & 0xFF;
+	if (i == len)
+		b |= 0x80;
+	if (blake && i == plen - 9)
+		b |= 0x01;
+	return b;
+}
+
+template <class S>
+constexpr std::uint32_t
+md_word(const S &s, std::size_t len, std::size_t plen, std::size_t i,
+	bool blake)
+{
+	return (static_cast<std::uint32_t>(md_byte(s, len, plen, i, blake))
+		<< 24)
+		| (static_cast<std::uint32_t>(
+			md_byte(s, len, plen, i + 1, blake)) << 16)
+		| (static_cast<std::uint32_t>(
+			md_byte(s, len, plen, i + 2, blake)) << 8)
+		| static_cast<std::uint32_t>(
+			md_byte(s, len, plen, i + 3, blake));
+}
+
+constexpr digest
+out_be32(const std::uint32_t *h)
+{
+	digest d{};
+
+	for (unsigned i = 0; i < 32; i ++)
+		d[i] = static_cast<unsigned char>(h[i >> 2]
+			>> (24 - 8 * (i & 3)));
+	return d;
+}
+
+template <class S>
+constexpr digest
+sha256(const S &s, std::size_t len)
+{
+	std::uint32_t h[8] = {};
+	std::size_t plen = (len + 9 + 63) & ~static_cast<std::size_t>(63);
+
+	for (unsigned i = 0; i < 8; i ++)
+		h[i] = tables::iv256[i];
+	for (std::size_t off = 0; off < plen; off += 64) {
+		std::uint32_t w[64] = {};
+		std::uint32_t v[8] = {};
+
+		for (unsigned i = 0; i < 16; i ++)
+			w[i] = md_word(s, len, plen, off + 4 * i, false);
+		for (unsigned i = 16; i < 64; i ++) {
+			std::uint32_t s0 = rotr32(w[i - 15], 7)
+				^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			std::uint32_t s1 = rotr32(w[i - 2], 17)
+				^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+		for (unsigned i = 0; i < 8; i ++)
+			v[i] = h[i];
+		for (unsigned i = 0; i < 64; i ++) {
+			std::uint32_t t1 = v[7]
+				+ (rotr32(v[4], 6) ^ rotr32(v[4], 11)
+					^ rotr32(v[4], 25))
+				+ ((v[4] & v[5]) ^ (~v[4] & v[6]))
+				+ tables::sha256_k[i] + w[i];
+			std::uint32_t t2 = (rotr32(v[0], 2) ^ rotr32(v[0], 13)
+					^ rotr32(v[0], 22))
+				+ ((v[0] & v[1]) ^ (v[0] & v[2])
+					^ (v[1] & v[2]));
+
+			v[7] = v[6];
+			v[6] = v[5];
+			v[5] = v[4];
+			v[4] = v[3] + t1;
+			v[3] = v[2];
+			v[2] = v[1];
+			v[1] = v[0];
+			v[0] = t1 + t2;
+		}
+		for (unsigned i = 0; i < 8; i ++)
+			h[i] += v[i];
+	}
+	return out_be32(h);
+}
+
+constexpr void
+blake_g(std::uint32_t *v, const std::uint32_t *m, const unsigned char *z,
+	unsigned a, unsigned b, unsigned c, unsigned d, unsigned i)
+{
+	v[a] += v[b] + (m[z[2 * i]] ^ tables::blake_c[z[2 * i + 1]]);
+	v[d] = rotr32(v[d] ^ v[a], 16);
+	v[c] += v[d];
+	v[b] = rotr32(v[b] ^ v[c], 12);
+	v[a] += v[b] + (m[z[2 * i + 1]] ^ tables::blake_c[z[2 * i]]);
+	v[d] = rotr32(v[d] ^ v[a], 8);
+	v[c] += v[d];
+	v[b] = rotr32(v[b] ^ v[c], 7);
+}
+
+/*
+ * BLAKE-256 (14 rounds, zero salt). The counter of a block is the
+ * number of message bits up to the end of that block, or zero for a
+ * block made only of padding.
+ */
+template <class S>
+constexpr digest
+blake256(const S &s, std::size_t len)
+{
+	std::uint32_t h[8] = {};
+	std::size_t plen = (len + 9 + 63) & ~static_cast<std::size_t>(63);
+
+	for (unsigned i = 0; i < 8; i ++)
+		h[i] = tables::iv256[i];
+	for (std::size_t off = 0; off < plen; off += 64) {
+		std::uint32_t m[16] = {};
+		std::uint32_t v[16] = {};
+		std::uint64_t t = 0;
+
+		for (unsigned i = 0; i < 16; i ++)
+			m[i] = md_word(s, len, plen, off + 4 * i, true);
+		if (off < len)
+			t = static_cast<std::uint64_t>(
+				len - off < 64 ? len : off + 64) << 3;
+		for (unsigned i = 0; i < 8; i ++) {
+			v[i] = h[i];
+			v[i + 8] = tables::blake_c[i];
+		}
+		v[12] ^= static_cast<std::uint32_t>(t);
+		v[13] ^= static_cast<std::uint32_t>(t);
+		v[14] ^= static_cast<std::uint32_t>(t >> 32);
+		v[15] ^= static_cast<std::uint32_t>(t >> 32);
+		for (unsigned r = 0; r < 14; r ++) {
+			const unsigned char *z = tables::blake_sigma[r % 10];
+
+			blake_g(v, m, z, 0, 4,  8, 12, 0);
+			blake_g(v, m, z, 1, 5,  9, 13, 1);
+			blake_g(v, m, z, 2, 6, 10, 14, 2);
+			blake_g(v, m, z, 3, 7, 11, 15, 3);
+			blake_g(v, m, z, 0, 5, 10, 15, 4);
+			blake_g(v, m, z, 1, 6, 11, 12, 5);
+			blake_g(v, m, z, 2, 7,  8, 13, 6);
+			blake_g(v, m, z, 3, 4,  9, 14, 7);
+		}
+		for (unsigned i = 0; i < 8; i ++)
+			h[i] ^= v[i] ^ v[i + 8];
+	}
+	return out_be32(h);
+}
+
+/*
+ * Keccak-256 as in sphlib: rate 136 bytes, padding with a 0x01 byte,
+ * zeros and a final 0x80 bit (the original Keccak padding, not the
+ * SHA-3 one).
+ */
+template <class S>
+constexpr digest
+keccak256(const S &s, std::size_t len)
+{
+	std::uint64_t a[25] = {};
+	std::size_t plen = (len / 136 + 1) * 136;
+	digest d{};
+
+	for (std::size_t off = 0; off < plen; off += 136) {
+		for (unsigned i = 0; i < 136; i ++) {
+			std::size_t j = off + i;
+			std::uint64_t b = 0;
+
+			if (j < len)
+				b = byte_at(s, j);
+			else
+				b = (j == len ? 0x01 : 0x00)
+					| (j == plen - 1 ? 0x80 : 0x00);
+			a[i >> 3] ^= b << (8 * (i & 7));
+		}
+		for (unsigned r = 0; r < 24; r ++) {
+			std::uint64_t c[5] = {};
+			std::uint64_t t[25] = {};
+
+			for (unsigned x = 0; x < 5; x ++)
+				c[x] = a[x] ^ a[x + 5] ^ a[x + 10]
+					^ a[x + 15] ^ a[x + 20];
+			for (unsigned x = 0; x < 5; x ++) {
+				std::uint64_t e = c[(x + 4) % 5]
+					^ rotl64(c[(x + 1) % 5], 1);
+
+				for (unsigned y = 0; y < 25; y += 5)
+					a[x + y] ^= e;
+			}
+			for (unsigned x = 0; x < 5; x ++)
+				for (unsigned y = 0; y < 5; y ++)
+					t[y + 5 * ((2 * x + 3 * y) % 5)] =
+						rotl64(a[x + 5 * y],
+						tables::keccak_rot[x + 5 * y]);
+			for (unsigned y = 0; y < 25; y += 5)
+				for (unsigned x = 0; x < 5; x ++)
+					a[x + y] = t[x + y]
+						^ (~t[(x + 1) % 5 + y]
+						& t[(x + 2) % 5 + y]);
+			a[0] ^= tables::keccak_rc[r];
+		}
+	}
+	for (unsigned i = 0; i < 32; i ++)
+		d[i] = static_cast<unsigned char>(a[i >> 3] >> (8 * (i & 7)));
+	return d;
+}
+
+}
+
+#endif
+
+/**
+ * SHA-256 of a string (without a terminating zero).
+ *
+ * @param s   the input string
+ * @return  the digest
+ */
+constexpr digest
+sha256(std::string_view s)
+{
+	return detail::sha256(s, s.size());
+}
+
+/**
+ * SHA-256 of an array of bytes.
+ *
+ * @param a   the input bytes
+ * @return  the digest
+ */
+template <std::size_t N>
+constexpr digest
+sha256(const std::array<unsigned char, N> &a)
+{
+	return detail::sha256(a, N);
+}
+
+/**
+ * Keccak-256 of a string (without a terminating zero).
+ *
+ * @param s   the input string
+ * @return  the digest
+ */
+constexpr digest
+keccak256(std::string_view s)
+{
+	return detail::keccak256(s, s.size());
+}
+
+/**
+ * Keccak-256 of an array of bytes.
+ *
+ * @param a   the input bytes
+ * @return  the digest
+ */
+template <std::size_t N>
+constexpr digest
+keccak256(const std::array<unsigned char, N> &a)
+{
+	return detail::keccak256(a, N);
+}
+
+/**
+ * BLAKE-256 of a string (without a terminating zero).
+ *
+ * @param s   the input string
+ * @return  the digest
+ */
+constexpr digest
+blake256(std::string_view s)
+{
+	return detail::blake256(s, s.size());
+}
+
+/**
+ * BLAKE-256 of an array of bytes.
+ *
+ * @param a   the input bytes
+ * @return  the digest
+ */
+template <std::size_t N>
+constexpr digest
+blake256(const std::array<unsigned char, N> &a)
+{
+	return detail::blake256(a, N);
+}
+
+/**
+ * The first four bytes of a digest, as a big-endian integer (e.g. to
+ * use a digest as a <code>case</code> label).
+ *
+ * @param d   the digest
+ * @return  the 32-bit prefix
+ */
+constexpr std::uint32_t
+prefix32(const digest &d)
+{
+	return (static_cast<std::uint32_t>(d[0]) << 24)
+		| (static_cast<std::uint32_t>(d[1]) << 16)
+		| (static_cast<std::uint32_t>(d[2]) << 8)
+		| static_cast<std::uint32_t>(d[3]);
+}
+
+#ifndef DOXYGEN_IGNORE
+static_assert(prefix32(sha256("")) == 0xE3B0C442,
+	"SHA-256 tables mismatch");
+static_assert(prefix32(keccak256("")) == 0xC5D24601,
+	"Keccak-256 tables mismatch");
+static_assert(prefix32(blake256("")) == 0x716F6E86,
+	"BLAKE-256 tables mismatch");
+#endif
+
+}
+}
+
+#endif
@@ -0,0 +1,160 @@
+/* $Id$ */
+/**
+ * Runtime CPU feature detection.
+ *
+ * Some hash function implementations in sphlib provide, next to the
+ * portable code, variants which use the vector units of x86 processors
+ * (SSE2, AVX2...). Those variants are compiled in only when the
+ * compiler knows how to emit such code for individual functions (the
+ * <code>SPH_X86_SIMD</code> macro is then defined to 1), and they are
+ * used only if the processor on which the code runs actually supports
+ * the corresponding instructions. This header provides the detection
+ * function which is used for that runtime selection.
+ *
+ * Defining the <code>SPH_NO_SIMD</code> macro to a non-zero value at
+ * compilation time disables all vector code; only the portable
+ * implementations are then compiled.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_cpu.h
+ */
+
+#ifndef SPH_CPU_H__
+#define SPH_CPU_H__
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "sph_types.h"
+
+/**
+ * Feature flag: SSE2 instructions.
+ */
+#define SPH_CPU_SSE2     0x0001
+
+/**
+ * Feature flag: SSSE3 instructions (<code>pshufb</code>).
+ */
+#define SPH_CPU_SSSE3    0x0002
+
+/**
+ * Feature flag: SSE4.1 instructions.
+ */
+#define SPH_CPU_SSE41    0x0004
+
+/**
+ * Feature flag: AES-NI instructions (on 128-bit registers).
+ */
+#define SPH_CPU_AESNI    0x0008
+
+/**
+ * Feature flag: AVX2 instructions, with operating system support for
+ * the 256-bit registers.
+ */
+#define SPH_CPU_AVX2     0x0010
+
+/**
+ * Feature flag: AVX-512 instructions (foundation, byte/word and
+ * vector-length extensions), with operating system support for the
+ * 512-bit registers.
+ */
+#define SPH_CPU_AVX512   0x0020
+
+/**
+ * Feature flag: VAES instructions (AES rounds on 256-bit registers;
+ * 512-bit registers are usable if <code>SPH_CPU_AVX512</code> is also
+ * set).
+ */
+#define SPH_CPU_VAES     0x0040
+
+#ifndef DOXYGEN_IGNORE
+
+#if !SPH_NO_SIMD && (SPH_I386_GCC || SPH_AMD64_GCC) \
+	&& (defined __clang__ || __GNUC__ > 4 \
+	|| (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+
+/*
+ * The vector code relies on the per-function "target" attribute, so
+ * that the rest of the library is still compiled for the baseline
+ * architecture, and on the GCC vector extensions, which let the
+ * scalar round macros operate on vectors of lanes.
+ */
+#define SPH_X86_SIMD   1
+
+#define SPH_TARGET(x)   __attribute__((target(x)))
+
+/*
+ * AVX-512 code (used when SPH_CPU_AVX512 is detected) needs a compiler
+ * which knows the AVX-512BW and AVX-512VL extensions.
+ */
+#if defined __clang__ || __GNUC__ >= 5
+#define SPH_X86_AVX512   1
+#endif
+
+typedef sph_u32 sph_v32x4 __attribute__((vector_size(16)));
+typedef sph_u32 sph_v32x8 __attribute__((vector_size(32)));
+typedef sph_u32 sph_v32x16 __attribute__((vector_size(64)));
+#if SPH_64
+typedef sph_u64 sph_v64x2 __attribute__((vector_size(16)));
+typedef sph_u64 sph_v64x4 __attribute__((vector_size(32)));
+typedef sph_u64 sph_v64x8 __attribute__((vector_size(64)));
+#endif
+
+#endif
+
+#endif
+
+/**
+ * Get the vector features which are supported by the current processor
+ * and operating system, as a combination of the <code>SPH_CPU_*</code>
+ * flags. Detection is performed on the first call only; the result is
+ * then cached. When the library was compiled without vector code
+ * (<code>SPH_X86_SIMD</code> not defined), this function returns 0.
+ *
+ * @return  the supported features
+ */
+unsigned sph_cpu_features(void);
+
+/**
+ * Restrict the set of features that the library will use. The value
+ * subsequently returned by <code>sph_cpu_features()</code> is the
+ * bitwise AND of the detected features and the provided mask. Passing
+ * <code>0</code> forces all functions to use their portable code;
+ * passing <code>~0U</code> restores the default behaviour. This is
+ * meant for tests and benchmarks; it should not be called while other
+ * threads are hashing data.
+ *
+ * @param mask   the allowed features
+ */
+void sph_cpu_set_mask(unsigned mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -121,6 +121,18 @@ void sph_cubehash224_init(void *cc);
  */
 void sph_cubehash224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_cubehash224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the CubeHash-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_cubehash224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current CubeHash-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -132,6 +144,17 @@ void sph_cubehash224(void *cc, const void *data, size_t len);
  */
 void sph_cubehash224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with CubeHash-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_cubehash224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -148,6 +171,31 @@ void sph_cubehash224_close(void *cc, void *dst);
 void sph_cubehash224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute CubeHash-224 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (28 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_cubehash224_init()</code>, <code>sph_cubehash224()</code> and
+ * <code>sph_cubehash224_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * Messages are processed in groups: four at a time with AVX-512, two
+ * with AVX2. Within a group, the full blocks common to all messages
+ * are hashed in parallel; when all messages of the group have the same
+ * length, the padding and the final rounds (which dominate the cost
+ * for short messages) are also performed in parallel. Otherwise, and
+ * for the remaining messages, the single-message code is used (it also
+ * uses the vector units when available).
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_cubehash224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a CubeHash-256 context. This process performs no memory
  * allocation.
@@ -167,6 +215,18 @@ void sph_cubehash256_init(void *cc);
  */
 void sph_cubehash256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_cubehash256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the CubeHash-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_cubehash256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current CubeHash-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -178,6 +238,17 @@ void sph_cubehash256(void *cc, const void *data, size_t len);
  */
 void sph_cubehash256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with CubeHash-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_cubehash256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -194,6 +265,23 @@ void sph_cubehash256_close(void *cc, void *dst);
 void sph_cubehash256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute CubeHash-256 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (32 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_cubehash256_init()</code>, <code>sph_cubehash256()</code> and
+ * <code>sph_cubehash256_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_cubehash256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a CubeHash-384 context. This process performs no memory
  * allocation.
@@ -213,6 +301,18 @@ void sph_cubehash384_init(void *cc);
  */
 void sph_cubehash384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_cubehash384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the CubeHash-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_cubehash384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current CubeHash-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -224,6 +324,17 @@ void sph_cubehash384(void *cc, const void *data, size_t len);
  */
 void sph_cubehash384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with CubeHash-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_cubehash384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -240,6 +351,23 @@ void sph_cubehash384_close(void *cc, void *dst);
 void sph_cubehash384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute CubeHash-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_cubehash384_init()</code>, <code>sph_cubehash384()</code> and
+ * <code>sph_cubehash384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_cubehash384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a CubeHash-512 context. This process performs no memory
  * allocation.
@@ -259,6 +387,18 @@ void sph_cubehash512_init(void *cc);
  */
 void sph_cubehash512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_cubehash512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the CubeHash-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_cubehash512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current CubeHash-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -270,6 +410,17 @@ void sph_cubehash512(void *cc, const void *data, size_t len);
  */
 void sph_cubehash512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with CubeHash-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_cubehash512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -285,6 +436,23 @@ void sph_cubehash512_close(void *cc, void *dst);
  */
 void sph_cubehash512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
+
+/**
+ * Compute CubeHash-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_cubehash512_init()</code>, <code>sph_cubehash512()</code> and
+ * <code>sph_cubehash512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_cubehash512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
 #ifdef __cplusplus
 }
 #endif
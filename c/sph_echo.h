@@ -151,6 +151,18 @@ void sph_echo224_init(void *cc);
  */
 void sph_echo224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_echo224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the ECHO-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_echo224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current ECHO-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -162,6 +174,17 @@ void sph_echo224(void *cc, const void *data, size_t len);
  */
 void sph_echo224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with ECHO-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_echo224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -196,6 +219,18 @@ void sph_echo256_init(void *cc);
  */
 void sph_echo256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_echo256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the ECHO-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_echo256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current ECHO-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -207,6 +242,17 @@ void sph_echo256(void *cc, const void *data, size_t len);
  */
 void sph_echo256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with ECHO-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_echo256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -241,6 +287,18 @@ void sph_echo384_init(void *cc);
  */
 void sph_echo384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_echo384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the ECHO-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_echo384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current ECHO-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -252,6 +310,17 @@ void sph_echo384(void *cc, const void *data, size_t len);
  */
 void sph_echo384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with ECHO-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_echo384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -268,6 +337,29 @@ void sph_echo384_close(void *cc, void *dst);
 void sph_echo384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute ECHO-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_echo384_init()</code>, <code>sph_echo384()</code> and
+ * <code>sph_echo384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_echo384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize an ECHO-512 context. This process performs no memory allocation.
  *
@@ -286,6 +378,18 @@ void sph_echo512_init(void *cc);
  */
 void sph_echo512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_echo512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the ECHO-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_echo512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current ECHO-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -297,6 +401,17 @@ void sph_echo512(void *cc, const void *data, size_t len);
  */
 void sph_echo512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with ECHO-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_echo512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -312,6 +427,29 @@ void sph_echo512_close(void *cc, void *dst);
  */
 void sph_echo512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
+
+/**
+ * Compute ECHO-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_echo512_init()</code>, <code>sph_echo512()</code> and
+ * <code>sph_echo512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_echo512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
 	
 #ifdef __cplusplus
 }
@@ -42,8 +42,12 @@ void sph_fugue224_init(void *cc);
 
 void sph_fugue224(void *cc, const void *data, size_t len);
 
+void sph_fugue224_updatev(void *cc, const sph_iovec *iov, int n);
+
 void sph_fugue224_close(void *cc, void *dst);
 
+void sph_fugue224_oneshot(const void *data, size_t len, void *dst);
+
 void sph_fugue224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
@@ -51,8 +55,12 @@ void sph_fugue256_init(void *cc);
 
 void sph_fugue256(void *cc, const void *data, size_t len);
 
+void sph_fugue256_updatev(void *cc, const sph_iovec *iov, int n);
+
 void sph_fugue256_close(void *cc, void *dst);
 
+void sph_fugue256_oneshot(const void *data, size_t len, void *dst);
+
 void sph_fugue256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
@@ -60,8 +68,12 @@ void sph_fugue384_init(void *cc);
 
 void sph_fugue384(void *cc, const void *data, size_t len);
 
+void sph_fugue384_updatev(void *cc, const sph_iovec *iov, int n);
+
 void sph_fugue384_close(void *cc, void *dst);
 
+void sph_fugue384_oneshot(const void *data, size_t len, void *dst);
+
 void sph_fugue384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
@@ -69,8 +81,12 @@ void sph_fugue512_init(void *cc);
 
 void sph_fugue512(void *cc, const void *data, size_t len);
 
+void sph_fugue512_updatev(void *cc, const sph_iovec *iov, int n);
+
 void sph_fugue512_close(void *cc, void *dst);
 
+void sph_fugue512_oneshot(const void *data, size_t len, void *dst);
+
 void sph_fugue512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
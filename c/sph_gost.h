@@ -3,6 +3,7 @@
 #define SPH_GOST_H__
 
 #include <stddef.h>
+#include "sph_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,27 +24,17 @@ extern "C" {
     /* Function prototypes */
     void sph_gost_init(void *cc);
     void sph_gost(void *cc, const void *data, size_t len);
+    void sph_gost_updatev(void *cc, const sph_iovec *iov, int n);
     void sph_gost_close(void *cc, void *dst);
+    void sph_gost_oneshot(const void *data, size_t len, void *dst);
     void sph_gost_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
 
-    /* ================ INIZIO MODIFICHE PER COMPATIBILITÀ RAVENCOIN ================ */
-
     /*
-     * Definizione di alias per la compatibilità con il codice esistente.
-     * Il tipo `sph_gost512_context` era utilizzato nelle versioni precedenti
-     * ed è funzionalmente identico a `sph_gost_context` in questa implementazione.
+     * The sph_gost512_* names designate GOST R 34.11-2012 (Streebog),
+     * which is implemented in streebog.c; they are not aliases for the
+     * GOST R 34.11-94 functions above.
      */
-    typedef sph_gost_context sph_gost512_context;
-
-    /*
-     * Dichiarazioni delle funzioni compatibili per GOST-512.
-     * Queste funzioni sono wrapper per le funzioni esistenti.
-     */
-    void sph_gost512_init(void *cc);
-    void sph_gost512(void *cc, const void *data, size_t len);
-    void sph_gost512_close(void *cc, void *dst);
-
-    /* ================ FINE MODIFICHE PER COMPATIBILITÀ RAVENCOIN ================ */
+#include "sph_streebog.h"
 
     #ifdef __cplusplus
 }
@@ -160,6 +160,18 @@ void sph_groestl224_init(void *cc);
  */
 void sph_groestl224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_groestl224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Groestl-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_groestl224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Groestl-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -171,6 +183,17 @@ void sph_groestl224(void *cc, const void *data, size_t len);
  */
 void sph_groestl224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Groestl-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_groestl224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -205,6 +228,18 @@ void sph_groestl256_init(void *cc);
  */
 void sph_groestl256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_groestl256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Groestl-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_groestl256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Groestl-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -216,6 +251,17 @@ void sph_groestl256(void *cc, const void *data, size_t len);
  */
 void sph_groestl256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Groestl-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_groestl256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -250,6 +296,18 @@ void sph_groestl384_init(void *cc);
  */
 void sph_groestl384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_groestl384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Groestl-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_groestl384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Groestl-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -261,6 +319,17 @@ void sph_groestl384(void *cc, const void *data, size_t len);
  */
 void sph_groestl384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Groestl-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_groestl384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -277,6 +346,29 @@ void sph_groestl384_close(void *cc, void *dst);
 void sph_groestl384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Groestl-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_groestl384_init()</code>, <code>sph_groestl384()</code> and
+ * <code>sph_groestl384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_groestl384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Groestl-512 context. This process performs no memory allocation.
  *
@@ -295,6 +387,18 @@ void sph_groestl512_init(void *cc);
  */
 void sph_groestl512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_groestl512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Groestl-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_groestl512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Groestl-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -306,6 +410,17 @@ void sph_groestl512(void *cc, const void *data, size_t len);
  */
 void sph_groestl512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Groestl-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_groestl512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -322,6 +437,29 @@ void sph_groestl512_close(void *cc, void *dst);
 void sph_groestl512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Groestl-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_groestl512_init()</code>, <code>sph_groestl512()</code> and
+ * <code>sph_groestl512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_groestl512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -150,6 +150,18 @@ void sph_hamsi224_init(void *cc);
  */
 void sph_hamsi224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_hamsi224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Hamsi-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_hamsi224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Hamsi-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -161,6 +173,17 @@ void sph_hamsi224(void *cc, const void *data, size_t len);
  */
 void sph_hamsi224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Hamsi-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_hamsi224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -177,6 +200,30 @@ void sph_hamsi224_close(void *cc, void *dst);
 void sph_hamsi224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Hamsi-224 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (28 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_hamsi224_init()</code>, <code>sph_hamsi224()</code> and
+ * <code>sph_hamsi224_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * Messages are processed in groups of sixteen (AVX-512), eight (AVX2)
+ * or four (SSE2), one message per vector lane. Within a group, the
+ * blocks common to all messages are hashed in parallel; when all
+ * messages of the group have the same length, the padding and the
+ * final rounds are also performed in parallel. Otherwise, each message
+ * is completed with the single-message code.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hamsi224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Hamsi-256 context. This process performs no memory allocation.
  *
@@ -195,6 +242,18 @@ void sph_hamsi256_init(void *cc);
  */
 void sph_hamsi256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_hamsi256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Hamsi-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_hamsi256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Hamsi-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -206,6 +265,17 @@ void sph_hamsi256(void *cc, const void *data, size_t len);
  */
 void sph_hamsi256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Hamsi-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_hamsi256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -222,6 +292,23 @@ void sph_hamsi256_close(void *cc, void *dst);
 void sph_hamsi256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Hamsi-256 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (32 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_hamsi256_init()</code>, <code>sph_hamsi256()</code> and
+ * <code>sph_hamsi256_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hamsi256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Hamsi-384 context. This process performs no memory allocation.
  *
@@ -240,6 +327,18 @@ void sph_hamsi384_init(void *cc);
  */
 void sph_hamsi384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_hamsi384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Hamsi-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_hamsi384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Hamsi-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -251,6 +350,17 @@ void sph_hamsi384(void *cc, const void *data, size_t len);
  */
 void sph_hamsi384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Hamsi-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_hamsi384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -267,6 +377,23 @@ void sph_hamsi384_close(void *cc, void *dst);
 void sph_hamsi384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Hamsi-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_hamsi384_init()</code>, <code>sph_hamsi384()</code> and
+ * <code>sph_hamsi384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hamsi384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Hamsi-512 context. This process performs no memory allocation.
  *
@@ -285,6 +412,18 @@ void sph_hamsi512_init(void *cc);
  */
 void sph_hamsi512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_hamsi512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Hamsi-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_hamsi512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Hamsi-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -296,6 +435,17 @@ void sph_hamsi512(void *cc, const void *data, size_t len);
  */
 void sph_hamsi512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Hamsi-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_hamsi512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -312,6 +462,23 @@ void sph_hamsi512_close(void *cc, void *dst);
 void sph_hamsi512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Hamsi-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_hamsi512_init()</code>, <code>sph_hamsi512()</code> and
+ * <code>sph_hamsi512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hamsi512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 
 
 #ifdef __cplusplus
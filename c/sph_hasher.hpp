@@ -0,0 +1,892 @@
+/* $Id$ */
+/**
+ * C++ interface: typed hash function objects.
+ *
+ * The C API passes contexts as <code>void *</code>, so generic code
+ * must go through function pointers and cannot check buffer sizes. The
+ * <code>sph::hasher&lt;Algo, Bits&gt;</code> template below resolves the
+ * algorithm at compile time: the context has its exact C type, the
+ * digest and block sizes are <code>constexpr</code>, outputs are
+ * fixed-size <code>std::array</code> values, and each call is a direct
+ * call to the C function of that algorithm (which link-time
+ * optimization may then inline). Hashers own their context and are
+ * move-only; an explicit <code>clone()</code> copies a running
+ * computation. <code>sph::chain&lt;H...&gt;</code> composes hashers at
+ * compile time, each one hashing the digest of the previous one.
+ *
+ * Inputs are contiguous ranges of trivially copyable elements
+ * (<code>std::span</code>, <code>std::array</code>,
+ * <code>std::vector</code>, <code>std::string</code>...), strings
+ * (<code>std::string_view</code>, or a string literal, which is hashed
+ * without its terminating NUL), or a pointer and a length in bytes.
+ * Arrays of characters are strings, not ranges. This header requires
+ * C++17; <code>std::span</code> outputs are accepted in C++20.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_hasher.hpp
+ */
+
+#ifndef SPH_HASHER_HPP__
+#define SPH_HASHER_HPP__
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && defined __has_include
+#if __has_include(<span>)
+#include <span>
+#define SPH_HASHER_SPAN   1
+#endif
+#endif
+
+#include "sph_types.h"
+
+/*
+ * Some of the C headers do not declare their functions with C linkage
+ * for C++ code.
+ */
+extern "C" {
+#include "sph_blake.h"
+#include "sph_bmw.h"
+#include "sph_cubehash.h"
+#include "sph_echo.h"
+#include "sph_fugue.h"
+#include "sph_gost.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_haval.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_luffa.h"
+#include "sph_md2.h"
+#include "sph_md4.h"
+#include "sph_md5.h"
+#include "sph_panama.h"
+#include "sph_radiogatun.h"
+#include "sph_ripemd.h"
+#include "sph_sha0.h"
+#include "sph_sha1.h"
+#include "sph_sha2.h"
+#include "sph_shabal.h"
+#include "sph_shavite.h"
+#include "sph_simd.h"
+#include "sph_skein.h"
+#include "sph_streebog.h"
+#include "sph_tiger.h"
+#include "sph_whirlpool.h"
+}
+
+namespace sph {
+
+/**
+ * Algorithm tag: MD2.
+ */
+struct md2 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 128;
+};
+
+/**
+ * Algorithm tag: MD4.
+ */
+struct md4 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 128;
+};
+
+/**
+ * Algorithm tag: MD5.
+ */
+struct md5 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 128;
+};
+
+/**
+ * Algorithm tag: PANAMA.
+ */
+struct panama {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: RadioGatun[32].
+ */
+struct radiogatun32 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: RadioGatun[64].
+ */
+struct radiogatun64 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: RIPEMD (original function).
+ */
+struct ripemd {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 128;
+};
+
+/**
+ * Algorithm tag: RIPEMD-128.
+ */
+struct ripemd128 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 128;
+};
+
+/**
+ * Algorithm tag: RIPEMD-160.
+ */
+struct ripemd160 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 160;
+};
+
+/**
+ * Algorithm tag: SHA-0.
+ */
+struct sha0 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 160;
+};
+
+/**
+ * Algorithm tag: SHA-1.
+ */
+struct sha1 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 160;
+};
+
+/**
+ * Algorithm tag: SHA-2 (224, 256, 384 and 512 bits).
+ */
+struct sha2 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: Tiger.
+ */
+struct tiger {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 192;
+};
+
+/**
+ * Algorithm tag: Tiger2.
+ */
+struct tiger2 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 192;
+};
+
+/**
+ * Algorithm tag: WHIRLPOOL.
+ */
+struct whirlpool {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: WHIRLPOOL-0.
+ */
+struct whirlpool0 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: WHIRLPOOL-1.
+ */
+struct whirlpool1 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: GOST R 34.11-94.
+ */
+struct gost {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: Streebog (GOST R 34.11-2012, 256 and 512 bits).
+ */
+struct streebog {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: HAVAL, 3 passes (128 to 256 bits).
+ */
+struct haval3 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: HAVAL, 4 passes (128 to 256 bits).
+ */
+struct haval4 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: HAVAL, 5 passes (128 to 256 bits).
+ */
+struct haval5 {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 256;
+};
+
+/**
+ * Algorithm tag: BLAKE (224, 256, 384 and 512 bits).
+ */
+struct blake {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: BMW (224, 256, 384 and 512 bits).
+ */
+struct bmw {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: CubeHash (224, 256, 384 and 512 bits).
+ */
+struct cubehash {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: ECHO (224, 256, 384 and 512 bits).
+ */
+struct echo {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Fugue (224, 256, 384 and 512 bits).
+ */
+struct fugue {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Groestl (224, 256, 384 and 512 bits).
+ */
+struct groestl {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Hamsi (224, 256, 384 and 512 bits).
+ */
+struct hamsi {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: JH (224, 256, 384 and 512 bits).
+ */
+struct jh {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Keccak (224, 256, 384 and 512 bits).
+ */
+struct keccak {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Luffa (224, 256, 384 and 512 bits).
+ */
+struct luffa {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Shabal (192 to 512 bits).
+ */
+struct shabal {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: SHAvite-3 (224, 256, 384 and 512 bits).
+ */
+struct shavite {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: SIMD (224, 256, 384 and 512 bits).
+ */
+struct simd {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+/**
+ * Algorithm tag: Skein (Skein-512, 224 to 512 bits).
+ */
+struct skein {
+	/** Default output size (in bits). */
+	static constexpr unsigned default_bits = 512;
+};
+
+#ifndef DOXYGEN_IGNORE
+
+namespace detail {
+
+/*
+ * impl<Algo, Bits> binds a tag and an output size to the C context type
+ * and functions. Unsupported combinations fail at compile time.
+ */
+template <class Algo, unsigned Bits>
+struct impl {
+	static_assert(Bits != Bits, "unsupported algorithm or output size");
+};
+
+#define SPH_HASHER_IMPL(tag, bits, name, block) \
+	template <> struct impl<tag, bits> { \
+		typedef sph_ ## name ## _context context; \
+		static constexpr std::size_t block_size = block; \
+		static void init(context *cc) noexcept \
+		{ \
+			sph_ ## name ## _init(cc); \
+		} \
+		static void update(context *cc, \
+			const void *data, std::size_t len) noexcept \
+		{ \
+			sph_ ## name(cc, data, len); \
+		} \
+		static void close(context *cc, void *dst) noexcept \
+		{ \
+			sph_ ## name ## _close(cc, dst); \
+		} \
+		static void oneshot(const void *data, std::size_t len, \
+			void *dst) noexcept \
+		{ \
+			sph_ ## name ## _oneshot(data, len, dst); \
+		} \
+	};
+
+SPH_HASHER_IMPL(md2, 128, md2, 16)
+SPH_HASHER_IMPL(md4, 128, md4, 64)
+SPH_HASHER_IMPL(md5, 128, md5, 64)
+SPH_HASHER_IMPL(panama, 256, panama, 32)
+SPH_HASHER_IMPL(radiogatun32, 256, radiogatun32, 12)
+#if SPH_64
+SPH_HASHER_IMPL(radiogatun64, 256, radiogatun64, 24)
+#endif
+SPH_HASHER_IMPL(ripemd, 128, ripemd, 64)
+SPH_HASHER_IMPL(ripemd128, 128, ripemd128, 64)
+SPH_HASHER_IMPL(ripemd160, 160, ripemd160, 64)
+SPH_HASHER_IMPL(sha0, 160, sha0, 64)
+SPH_HASHER_IMPL(sha1, 160, sha1, 64)
+SPH_HASHER_IMPL(sha2, 224, sha224, 64)
+SPH_HASHER_IMPL(sha2, 256, sha256, 64)
+#if SPH_64
+SPH_HASHER_IMPL(sha2, 384, sha384, 128)
+SPH_HASHER_IMPL(sha2, 512, sha512, 128)
+SPH_HASHER_IMPL(tiger, 192, tiger, 64)
+SPH_HASHER_IMPL(tiger2, 192, tiger2, 64)
+SPH_HASHER_IMPL(whirlpool, 512, whirlpool, 64)
+SPH_HASHER_IMPL(whirlpool0, 512, whirlpool0, 64)
+SPH_HASHER_IMPL(whirlpool1, 512, whirlpool1, 64)
+#endif
+SPH_HASHER_IMPL(gost, 256, gost, 32)
+#if SPH_64
+SPH_HASHER_IMPL(streebog, 256, gost256, 64)
+SPH_HASHER_IMPL(streebog, 512, gost512, 64)
+#endif
+SPH_HASHER_IMPL(haval3, 128, haval128_3, 128)
+SPH_HASHER_IMPL(haval3, 160, haval160_3, 128)
+SPH_HASHER_IMPL(haval3, 192, haval192_3, 128)
+SPH_HASHER_IMPL(haval3, 224, haval224_3, 128)
+SPH_HASHER_IMPL(haval3, 256, haval256_3, 128)
+SPH_HASHER_IMPL(haval4, 128, haval128_4, 128)
+SPH_HASHER_IMPL(haval4, 160, haval160_4, 128)
+SPH_HASHER_IMPL(haval4, 192, haval192_4, 128)
+SPH_HASHER_IMPL(haval4, 224, haval224_4, 128)
+SPH_HASHER_IMPL(haval4, 256, haval256_4, 128)
+SPH_HASHER_IMPL(haval5, 128, haval128_5, 128)
+SPH_HASHER_IMPL(haval5, 160, haval160_5, 128)
+SPH_HASHER_IMPL(haval5, 192, haval192_5, 128)
+SPH_HASHER_IMPL(haval5, 224, haval224_5, 128)
+SPH_HASHER_IMPL(haval5, 256, haval256_5, 128)
+SPH_HASHER_IMPL(blake, 224, blake224, 64)
+SPH_HASHER_IMPL(blake, 256, blake256, 64)
+#if SPH_64
+SPH_HASHER_IMPL(blake, 384, blake384, 128)
+SPH_HASHER_IMPL(blake, 512, blake512, 128)
+#endif
+SPH_HASHER_IMPL(bmw, 224, bmw224, 64)
+SPH_HASHER_IMPL(bmw, 256, bmw256, 64)
+#if SPH_64
+SPH_HASHER_IMPL(bmw, 384, bmw384, 128)
+SPH_HASHER_IMPL(bmw, 512, bmw512, 128)
+#endif
+SPH_HASHER_IMPL(cubehash, 224, cubehash224, 32)
+SPH_HASHER_IMPL(cubehash, 256, cubehash256, 32)
+SPH_HASHER_IMPL(cubehash, 384, cubehash384, 32)
+SPH_HASHER_IMPL(cubehash, 512, cubehash512, 32)
+SPH_HASHER_IMPL(echo, 224, echo224, 192)
+SPH_HASHER_IMPL(echo, 256, echo256, 192)
+SPH_HASHER_IMPL(echo, 384, echo384, 128)
+SPH_HASHER_IMPL(echo, 512, echo512, 128)
+SPH_HASHER_IMPL(fugue, 224, fugue224, 4)
+SPH_HASHER_IMPL(fugue, 256, fugue256, 4)
+SPH_HASHER_IMPL(fugue, 384, fugue384, 4)
+SPH_HASHER_IMPL(fugue, 512, fugue512, 4)
+SPH_HASHER_IMPL(groestl, 224, groestl224, 64)
+SPH_HASHER_IMPL(groestl, 256, groestl256, 64)
+SPH_HASHER_IMPL(groestl, 384, groestl384, 128)
+SPH_HASHER_IMPL(groestl, 512, groestl512, 128)
+SPH_HASHER_IMPL(hamsi, 224, hamsi224, 4)
+SPH_HASHER_IMPL(hamsi, 256, hamsi256, 4)
+SPH_HASHER_IMPL(hamsi, 384, hamsi384, 8)
+SPH_HASHER_IMPL(hamsi, 512, hamsi512, 8)
+SPH_HASHER_IMPL(jh, 224, jh224, 64)
+SPH_HASHER_IMPL(jh, 256, jh256, 64)
+SPH_HASHER_IMPL(jh, 384, jh384, 64)
+SPH_HASHER_IMPL(jh, 512, jh512, 64)
+SPH_HASHER_IMPL(keccak, 224, keccak224, 144)
+SPH_HASHER_IMPL(keccak, 256, keccak256, 136)
+SPH_HASHER_IMPL(keccak, 384, keccak384, 104)
+SPH_HASHER_IMPL(keccak, 512, keccak512, 72)
+SPH_HASHER_IMPL(luffa, 224, luffa224, 32)
+SPH_HASHER_IMPL(luffa, 256, luffa256, 32)
+SPH_HASHER_IMPL(luffa, 384, luffa384, 32)
+SPH_HASHER_IMPL(luffa, 512, luffa512, 32)
+SPH_HASHER_IMPL(shabal, 192, shabal192, 64)
+SPH_HASHER_IMPL(shabal, 224, shabal224, 64)
+SPH_HASHER_IMPL(shabal, 256, shabal256, 64)
+SPH_HASHER_IMPL(shabal, 384, shabal384, 64)
+SPH_HASHER_IMPL(shabal, 512, shabal512, 64)
+SPH_HASHER_IMPL(shavite, 224, shavite224, 64)
+SPH_HASHER_IMPL(shavite, 256, shavite256, 64)
+SPH_HASHER_IMPL(shavite, 384, shavite384, 128)
+SPH_HASHER_IMPL(shavite, 512, shavite512, 128)
+SPH_HASHER_IMPL(simd, 224, simd224, 64)
+SPH_HASHER_IMPL(simd, 256, simd256, 64)
+SPH_HASHER_IMPL(simd, 384, simd384, 128)
+SPH_HASHER_IMPL(simd, 512, simd512, 128)
+#if SPH_64
+SPH_HASHER_IMPL(skein, 224, skein224, 64)
+SPH_HASHER_IMPL(skein, 256, skein256, 64)
+SPH_HASHER_IMPL(skein, 384, skein384, 64)
+SPH_HASHER_IMPL(skein, 512, skein512, 64)
+#endif
+
+#undef SPH_HASHER_IMPL
+
+/*
+ * A contiguous range of trivially copyable elements, hashed as its
+ * in-memory bytes. Arrays of characters are excluded: a string literal
+ * would otherwise be hashed with its terminating NUL. They go to the
+ * std::string_view overloads instead.
+ */
+template <class T>
+struct is_char : std::false_type {
+};
+
+template <> struct is_char<char> : std::true_type { };
+template <> struct is_char<signed char> : std::true_type { };
+template <> struct is_char<wchar_t> : std::true_type { };
+template <> struct is_char<char16_t> : std::true_type { };
+template <> struct is_char<char32_t> : std::true_type { };
+#if defined __cpp_char8_t
+template <> struct is_char<char8_t> : std::true_type { };
+#endif
+
+template <class R, class = void>
+struct is_byte_range : std::false_type {
+};
+
+template <class R>
+struct is_byte_range<R, std::void_t<
+	decltype(std::data(std::declval<const R &>())),
+	decltype(std::size(std::declval<const R &>()))>>
+	: std::bool_constant<std::is_trivially_copyable_v<std::remove_pointer_t<
+		decltype(std::data(std::declval<const R &>()))>>
+		&& !(std::is_array_v<R> && is_char<std::remove_cv_t<
+		std::remove_extent_t<R>>>::value)> {
+};
+
+template <class R>
+inline std::size_t
+range_bytes(const R &r) noexcept
+{
+	return std::size(r) * sizeof *std::data(r);
+}
+
+}
+
+#endif
+
+/**
+ * Hash function object for algorithm <code>Algo</code> (one of the tags
+ * above) with an output of <code>Bits</code> bits. Constructing a hasher
+ * initializes its context; <code>finish()</code> outputs the digest and
+ * reinitializes the context, so that the object can be reused.
+ */
+template <class Algo, unsigned Bits = Algo::default_bits>
+class hasher {
+	typedef detail::impl<Algo, Bits> impl;
+
+public:
+	/** The algorithm tag. */
+	typedef Algo algorithm;
+
+	/** Output size (in bytes). */
+	static constexpr std::size_t digest_size = Bits / 8;
+
+	/** Input block size (in bytes). */
+	static constexpr std::size_t block_size = impl::block_size;
+
+	/** The digest type. */
+	typedef std::array<unsigned char, digest_size> digest_type;
+
+	/** Create a hasher, with an initialized context. */
+	hasher() noexcept
+	{
+		impl::init(&cc);
+	}
+
+	hasher(const hasher &) = delete;
+	hasher &operator=(const hasher &) = delete;
+
+	/**
+	 * Move a running computation; the source hasher is reinitialized.
+	 *
+	 * @param h   the source hasher
+	 */
+	hasher(hasher &&h) noexcept
+		: cc(h.cc)
+	{
+		impl::init(&h.cc);
+	}
+
+	/**
+	 * Move a running computation; the source hasher is reinitialized.
+	 *
+	 * @param h   the source hasher
+	 * @return  this hasher
+	 */
+	hasher &
+	operator=(hasher &&h) noexcept
+	{
+		cc = h.cc;
+		impl::init(&h.cc);
+		return *this;
+	}
+
+	/**
+	 * Copy the running computation, e.g. to hash several messages with
+	 * a common prefix.
+	 *
+	 * @return  a hasher in the same state
+	 */
+	hasher
+	clone() const noexcept
+	{
+		return hasher(cc);
+	}
+
+	/** Abandon the current computation and reinitialize the context. */
+	void
+	reset() noexcept
+	{
+		impl::init(&cc);
+	}
+
+	/**
+	 * Process some data bytes.
+	 *
+	 * @param data   the input data
+	 * @param len    the input data length (in bytes)
+	 * @return  this hasher
+	 */
+	hasher &
+	update(const void *data, std::size_t len) noexcept
+	{
+		impl::update(&cc, data, len);
+		return *this;
+	}
+
+	/**
+	 * Process a contiguous range of trivially copyable elements.
+	 *
+	 * @param r   the input range
+	 * @return  this hasher
+	 */
+	template <class R, std::enable_if_t<
+		detail::is_byte_range<R>::value, int> = 0>
+	hasher &
+	update(const R &r) noexcept
+	{
+		impl::update(&cc, std::data(r), detail::range_bytes(r));
+		return *this;
+	}
+
+	/**
+	 * Process the characters of a string (for a string literal, the
+	 * terminating NUL is not included).
+	 *
+	 * @param s   the input string
+	 * @return  this hasher
+	 */
+	hasher &
+	update(std::string_view s) noexcept
+	{
+		impl::update(&cc, s.data(), s.size());
+		return *this;
+	}
+
+	/**
+	 * Terminate the computation and return the digest. The context is
+	 * reinitialized.
+	 *
+	 * @return  the digest
+	 */
+	digest_type
+	finish() noexcept
+	{
+		digest_type d;
+
+		impl::close(&cc, d.data());
+		return d;
+	}
+
+	/**
+	 * Terminate the computation and write the digest into
+	 * <code>dst</code>. The context is reinitialized.
+	 *
+	 * @param dst   the destination buffer
+	 */
+	void
+	finish(digest_type &dst) noexcept
+	{
+		impl::close(&cc, dst.data());
+	}
+
+#if defined SPH_HASHER_SPAN || defined DOXYGEN_IGNORE
+	/**
+	 * Terminate the computation and write the digest into
+	 * <code>dst</code>, whose size is checked at compile time
+	 * (C++20 only). The context is reinitialized.
+	 *
+	 * @param dst   the destination buffer
+	 */
+	template <std::size_t N>
+	void
+	finish(std::span<unsigned char, N> dst) noexcept
+	{
+		static_assert(N != std::dynamic_extent && N >= digest_size,
+			"destination span is too small");
+		impl::close(&cc, dst.data());
+	}
+#endif
+
+	/**
+	 * Hash a complete message.
+	 *
+	 * @param data   the input data
+	 * @param len    the input data length (in bytes)
+	 * @return  the digest
+	 */
+	static digest_type
+	hash(const void *data, std::size_t len) noexcept
+	{
+		digest_type d;
+
+		impl::oneshot(data, len, d.data());
+		return d;
+	}
+
+	/**
+	 * Hash a complete message given as a contiguous range of trivially
+	 * copyable elements.
+	 *
+	 * @param r   the input range
+	 * @return  the digest
+	 */
+	template <class R, std::enable_if_t<
+		detail::is_byte_range<R>::value, int> = 0>
+	static digest_type
+	hash(const R &r) noexcept
+	{
+		return hash(std::data(r), detail::range_bytes(r));
+	}
+
+	/**
+	 * Hash the characters of a string (for a string literal, the
+	 * terminating NUL is not included).
+	 *
+	 * @param s   the input string
+	 * @return  the digest
+	 */
+	static digest_type
+	hash(std::string_view s) noexcept
+	{
+		return hash(s.data(), s.size());
+	}
+
+private:
+	typename impl::context cc;
+
+	explicit hasher(const typename impl::context &c) noexcept
+		: cc(c)
+	{
+	}
+};
+
+/**
+ * Composition of hashers, resolved at compile time: the first hasher
+ * processes the message, and each following one hashes the digest of
+ * the previous one. The digest of the chain is that of the last
+ * hasher.
+ */
+template <class H, class... Rest>
+struct chain {
+	/** Output size (in bytes). */
+	static constexpr std::size_t digest_size =
+		chain<Rest...>::digest_size;
+
+	/** The digest type. */
+	typedef typename chain<Rest...>::digest_type digest_type;
+
+	/**
+	 * Hash a complete message.
+	 *
+	 * @param data   the input data
+	 * @param len    the input data length (in bytes)
+	 * @return  the digest
+	 */
+	static digest_type
+	hash(const void *data, std::size_t len) noexcept
+	{
+		return chain<Rest...>::hash(H::hash(data, len));
+	}
+
+	/**
+	 * Hash a complete message given as a contiguous range of trivially
+	 * copyable elements.
+	 *
+	 * @param r   the input range
+	 * @return  the digest
+	 */
+	template <class R, std::enable_if_t<
+		detail::is_byte_range<R>::value, int> = 0>
+	static digest_type
+	hash(const R &r) noexcept
+	{
+		return hash(std::data(r), detail::range_bytes(r));
+	}
+
+	/**
+	 * Hash the characters of a string (for a string literal, the
+	 * terminating NUL is not included).
+	 *
+	 * @param s   the input string
+	 * @return  the digest
+	 */
+	static digest_type
+	hash(std::string_view s) noexcept
+	{
+		return hash(s.data(), s.size());
+	}
+};
+
+#ifndef DOXYGEN_IGNORE
+template <class H>
+struct chain<H> {
+	static constexpr std::size_t digest_size = H::digest_size;
+	typedef typename H::digest_type digest_type;
+
+	static digest_type
+	hash(const void *data, std::size_t len) noexcept
+	{
+		return H::hash(data, len);
+	}
+
+	template <class R, std::enable_if_t<
+		detail::is_byte_range<R>::value, int> = 0>
+	static digest_type
+	hash(const R &r) noexcept
+	{
+		return H::hash(r);
+	}
+
+	static digest_type
+	hash(std::string_view s) noexcept
+	{
+		return H::hash(s.data(), s.size());
+	}
+};
+#endif
+
+}
+
+#endif
@@ -255,6 +255,18 @@ void sph_haval128_3_init(void *cc);
  */
 void sph_haval128_3(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval128_3()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-128/3 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval128_3_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-128/3 computation. The output buffer must be wide
  * enough to accomodate the result (16 bytes). The context is automatically
@@ -265,6 +277,17 @@ void sph_haval128_3(void *cc, const void *data, size_t len);
  */
 void sph_haval128_3_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-128/3 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval128_3_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-128/3 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -301,6 +324,18 @@ void sph_haval128_4_init(void *cc);
  */
 void sph_haval128_4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval128_4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-128/4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval128_4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-128/4 computation. The output buffer must be wide
  * enough to accomodate the result (16 bytes). The context is automatically
@@ -311,6 +346,17 @@ void sph_haval128_4(void *cc, const void *data, size_t len);
  */
 void sph_haval128_4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-128/4 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval128_4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-128/4 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -347,6 +393,18 @@ void sph_haval128_5_init(void *cc);
  */
 void sph_haval128_5(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval128_5()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-128/5 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval128_5_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-128/5 computation. The output buffer must be wide
  * enough to accomodate the result (16 bytes). The context is automatically
@@ -357,6 +415,17 @@ void sph_haval128_5(void *cc, const void *data, size_t len);
  */
 void sph_haval128_5_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-128/5 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval128_5_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-128/5 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -393,6 +462,18 @@ void sph_haval160_3_init(void *cc);
  */
 void sph_haval160_3(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval160_3()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-160/3 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval160_3_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-160/3 computation. The output buffer must be wide
  * enough to accomodate the result (20 bytes). The context is automatically
@@ -403,6 +484,17 @@ void sph_haval160_3(void *cc, const void *data, size_t len);
  */
 void sph_haval160_3_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-160/3 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval160_3_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-160/3 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -439,6 +531,18 @@ void sph_haval160_4_init(void *cc);
  */
 void sph_haval160_4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval160_4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-160/4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval160_4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-160/4 computation. The output buffer must be wide
  * enough to accomodate the result (20 bytes). The context is automatically
@@ -449,6 +553,17 @@ void sph_haval160_4(void *cc, const void *data, size_t len);
  */
 void sph_haval160_4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-160/4 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval160_4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-160/4 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -485,6 +600,18 @@ void sph_haval160_5_init(void *cc);
  */
 void sph_haval160_5(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval160_5()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-160/5 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval160_5_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-160/5 computation. The output buffer must be wide
  * enough to accomodate the result (20 bytes). The context is automatically
@@ -495,6 +622,17 @@ void sph_haval160_5(void *cc, const void *data, size_t len);
  */
 void sph_haval160_5_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-160/5 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval160_5_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-160/5 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -531,6 +669,18 @@ void sph_haval192_3_init(void *cc);
  */
 void sph_haval192_3(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval192_3()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-192/3 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval192_3_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-192/3 computation. The output buffer must be wide
  * enough to accomodate the result (24 bytes). The context is automatically
@@ -541,6 +691,17 @@ void sph_haval192_3(void *cc, const void *data, size_t len);
  */
 void sph_haval192_3_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-192/3 and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval192_3_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-192/3 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -577,6 +738,18 @@ void sph_haval192_4_init(void *cc);
  */
 void sph_haval192_4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval192_4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-192/4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval192_4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-192/4 computation. The output buffer must be wide
  * enough to accomodate the result (24 bytes). The context is automatically
@@ -587,6 +760,17 @@ void sph_haval192_4(void *cc, const void *data, size_t len);
  */
 void sph_haval192_4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-192/4 and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval192_4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-192/4 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -623,6 +807,18 @@ void sph_haval192_5_init(void *cc);
  */
 void sph_haval192_5(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval192_5()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-192/5 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval192_5_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-192/5 computation. The output buffer must be wide
  * enough to accomodate the result (24 bytes). The context is automatically
@@ -633,6 +829,17 @@ void sph_haval192_5(void *cc, const void *data, size_t len);
  */
 void sph_haval192_5_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-192/5 and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval192_5_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-192/5 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -669,6 +876,18 @@ void sph_haval224_3_init(void *cc);
  */
 void sph_haval224_3(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval224_3()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-224/3 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval224_3_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-224/3 computation. The output buffer must be wide
  * enough to accomodate the result (28 bytes). The context is automatically
@@ -679,6 +898,17 @@ void sph_haval224_3(void *cc, const void *data, size_t len);
  */
 void sph_haval224_3_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-224/3 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval224_3_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-224/3 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -715,6 +945,18 @@ void sph_haval224_4_init(void *cc);
  */
 void sph_haval224_4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval224_4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-224/4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval224_4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-224/4 computation. The output buffer must be wide
  * enough to accomodate the result (28 bytes). The context is automatically
@@ -725,6 +967,17 @@ void sph_haval224_4(void *cc, const void *data, size_t len);
  */
 void sph_haval224_4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-224/4 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval224_4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-224/4 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -761,6 +1014,18 @@ void sph_haval224_5_init(void *cc);
  */
 void sph_haval224_5(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval224_5()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-224/5 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval224_5_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-224/5 computation. The output buffer must be wide
  * enough to accomodate the result (28 bytes). The context is automatically
@@ -771,6 +1036,17 @@ void sph_haval224_5(void *cc, const void *data, size_t len);
  */
 void sph_haval224_5_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-224/5 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval224_5_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-224/5 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -807,6 +1083,18 @@ void sph_haval256_3_init(void *cc);
  */
 void sph_haval256_3(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval256_3()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-256/3 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval256_3_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-256/3 computation. The output buffer must be wide
  * enough to accomodate the result (32 bytes). The context is automatically
@@ -817,6 +1105,17 @@ void sph_haval256_3(void *cc, const void *data, size_t len);
  */
 void sph_haval256_3_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-256/3 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval256_3_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-256/3 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -853,6 +1152,18 @@ void sph_haval256_4_init(void *cc);
  */
 void sph_haval256_4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval256_4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-256/4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval256_4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-256/4 computation. The output buffer must be wide
  * enough to accomodate the result (32 bytes). The context is automatically
@@ -863,6 +1174,17 @@ void sph_haval256_4(void *cc, const void *data, size_t len);
  */
 void sph_haval256_4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-256/4 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval256_4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-256/4 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -899,6 +1221,18 @@ void sph_haval256_5_init(void *cc);
  */
 void sph_haval256_5(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_haval256_5()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the HAVAL-256/5 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_haval256_5_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Close a HAVAL-256/5 computation. The output buffer must be wide
  * enough to accomodate the result (32 bytes). The context is automatically
@@ -909,6 +1243,17 @@ void sph_haval256_5(void *cc, const void *data, size_t len);
  */
 void sph_haval256_5_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with HAVAL-256/5 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_haval256_5_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Close a HAVAL-256/5 computation. Up to 7 extra input bits may be added
  * to the input message; these are the <code>n</code> upper bits of
@@ -0,0 +1,212 @@
+/* $Id$ */
+/**
+ * HMAC over any of the hash functions of the batch module.
+ *
+ * HMAC (RFC 2104) hashes the key, padded to a block and XORed with a
+ * constant, before the message in the inner hash, and again before the
+ * inner hash value in the outer hash. Both key blocks depend only on
+ * the key. An HMAC key object (<code>sph_hmac_key</code>) holds the
+ * hash contexts as they are right after these two blocks; each MAC
+ * computation copies them, so that a short message costs only its own
+ * blocks plus the outer final block, instead of two extra key blocks
+ * per message. The algorithms are identified by the
+ * <code>SPH_HASH_*</code> constants of <code>sph_batch.h</code>.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_hmac.h
+ */
+
+#ifndef SPH_HMAC_H__
+#define SPH_HMAC_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+#include "sph_batch.h"
+#include "sph_blake.h"
+#include "sph_bmw.h"
+#include "sph_cubehash.h"
+#include "sph_echo.h"
+#include "sph_fugue.h"
+#include "sph_gost.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_haval.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_luffa.h"
+#include "sph_md2.h"
+#include "sph_md4.h"
+#include "sph_md5.h"
+#include "sph_panama.h"
+#include "sph_radiogatun.h"
+#include "sph_ripemd.h"
+#include "sph_sha0.h"
+#include "sph_sha1.h"
+#include "sph_sha2.h"
+#include "sph_shabal.h"
+#include "sph_shavite.h"
+#include "sph_simd.h"
+#include "sph_skein.h"
+#include "sph_streebog.h"
+#include "sph_tiger.h"
+#include "sph_whirlpool.h"
+
+#ifndef DOXYGEN_IGNORE
+typedef union {
+	sph_md2_context md2;
+	sph_md4_context md4;
+	sph_md5_context md5;
+	sph_panama_context panama;
+	sph_radiogatun32_context radiogatun32;
+	sph_radiogatun64_context radiogatun64;
+	sph_ripemd_context ripemd;
+	sph_ripemd128_context ripemd128;
+	sph_ripemd160_context ripemd160;
+	sph_sha0_context sha0;
+	sph_sha1_context sha1;
+	sph_sha224_context sha224;
+	sph_sha384_context sha384;
+	sph_tiger_context tiger;
+	sph_whirlpool_context whirlpool;
+	sph_gost_context gost;
+	sph_gost512_context streebog;
+	sph_haval_context haval;
+	sph_blake_small_context blake_small;
+	sph_blake_big_context blake_big;
+	sph_bmw_small_context bmw_small;
+	sph_bmw_big_context bmw_big;
+	sph_cubehash_context cubehash;
+	sph_echo_small_context echo_small;
+	sph_echo_big_context echo_big;
+	sph_fugue_context fugue;
+	sph_groestl_small_context groestl_small;
+	sph_groestl_big_context groestl_big;
+	sph_hamsi_small_context hamsi_small;
+	sph_hamsi_big_context hamsi_big;
+	sph_jh_context jh;
+	sph_keccak_context keccak;
+	sph_luffa224_context luffa224;
+	sph_luffa384_context luffa384;
+	sph_luffa512_context luffa512;
+	sph_shabal_context shabal;
+	sph_shavite_small_context shavite_small;
+	sph_shavite_big_context shavite_big;
+	sph_simd_small_context simd_small;
+	sph_simd_big_context simd_big;
+	sph_skein_big_context skein;
+} sph_hmac_cc_;
+#endif
+
+/**
+ * An HMAC key object: the algorithm and the precomputed inner and
+ * outer hash contexts. Its contents are private. It is not modified
+ * by the MAC computations, and may thus be used by several threads at
+ * the same time; it may be copied with <code>memcpy()</code>. It
+ * contains secret data derived from the key.
+ */
+typedef struct {
+#ifndef DOXYGEN_IGNORE
+	const void *impl;
+	size_t out_len;
+	sph_hmac_cc_ inner, outer;
+#endif
+} sph_hmac_key;
+
+/**
+ * Get the HMAC block length of an algorithm, i.e. the length to which
+ * the key is padded. It is the input block length of the compression
+ * function (the rate for Keccak), except for RadioGatun, CubeHash,
+ * Fugue, Hamsi and Luffa, which absorb their input in units shorter
+ * than their output; these use 64 bytes.
+ *
+ * @param alg   the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @return  the block length (in bytes), or 0 if <code>alg</code> is
+ *          not a valid identifier
+ */
+size_t sph_hmac_block(unsigned alg);
+
+/**
+ * Initialize an HMAC key object for the algorithm <code>alg</code>.
+ * A key longer than the block length (<code>sph_hmac_block()</code>)
+ * is first hashed, as specified by HMAC. The output length of the MAC
+ * is <code>sph_hash_size(alg)</code>.
+ *
+ * @param k         the key object
+ * @param alg       the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @param key       the key
+ * @param key_len   the key length (in bytes)
+ * @return  1 on success, 0 if <code>alg</code> is not a valid identifier
+ */
+int sph_hmac_init(sph_hmac_key *k, unsigned alg,
+	const void *key, size_t key_len);
+
+/**
+ * Compute the HMAC of a message and write it into <code>dst</code>
+ * (<code>sph_hash_size(alg)</code> bytes).
+ *
+ * @param k      the key object
+ * @param data   the message
+ * @param len    the message length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_hmac(const sph_hmac_key *k, const void *data, size_t len,
+	void *dst);
+
+/**
+ * Compute the HMAC of <code>num</code> messages under the same key.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its MAC is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_hmac()</code> computes for each
+ * message. For MD5, SHA-1, RIPEMD-160 and SHA-2, the full blocks of the
+ * messages are processed several messages at a time, starting from the
+ * precomputed inner context, with the multi-message code of the hash
+ * function; this is most efficient when the messages of the batch have
+ * similar lengths. Other algorithms process the messages one at a time.
+ *
+ * @param k      the key object
+ * @param data   the messages
+ * @param len    the message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hmac_batch(const sph_hmac_key *k, const void *const *data,
+	const size_t *len, void *const *dst, size_t num);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -129,6 +129,18 @@ void sph_jh224_init(void *cc);
  */
 void sph_jh224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_jh224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the JH-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_jh224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current JH-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -140,6 +152,17 @@ void sph_jh224(void *cc, const void *data, size_t len);
  */
 void sph_jh224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with JH-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_jh224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -174,6 +197,18 @@ void sph_jh256_init(void *cc);
  */
 void sph_jh256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_jh256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the JH-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_jh256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current JH-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -185,6 +220,17 @@ void sph_jh256(void *cc, const void *data, size_t len);
  */
 void sph_jh256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with JH-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_jh256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -219,6 +265,18 @@ void sph_jh384_init(void *cc);
  */
 void sph_jh384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_jh384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the JH-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_jh384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current JH-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -230,6 +288,17 @@ void sph_jh384(void *cc, const void *data, size_t len);
  */
 void sph_jh384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with JH-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_jh384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -264,6 +333,18 @@ void sph_jh512_init(void *cc);
  */
 void sph_jh512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_jh512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the JH-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_jh512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current JH-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -275,6 +356,17 @@ void sph_jh512(void *cc, const void *data, size_t len);
  */
 void sph_jh512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with JH-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_jh512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -0,0 +1,211 @@
+/* $Id$ */
+/**
+ * Multi-buffer job manager for streaming messages.
+ *
+ * The batch functions (<code>sph_hash_batch()</code>) need all the
+ * messages at once. For messages which arrive in pieces, the job
+ * manager keeps a small set of in-flight messages ("jobs") for one
+ * algorithm, each with its own context. When a piece is submitted, the
+ * full blocks it contains are assigned to a lane; as soon as all the
+ * lanes of the multi-message code are busy, they are processed
+ * together, up to the end of the shortest piece. Jobs are returned to
+ * the caller as their pieces are consumed; the caller then submits the
+ * next piece of the message, or reads the hash value if the piece was
+ * the last one. <code>sph_jobmgr_flush()</code> processes the pending
+ * pieces when no more submissions are coming.
+ *
+ * The lane code is used for MD5, SHA-1, SHA-224, SHA-256, SHA-384 and
+ * SHA-512 (on processors where it exists). BLAKE and Keccak, which have
+ * no multi-message code, are also accepted: their pieces are processed
+ * when submitted, with the scalar code.
+ *
+ * A job must not be modified while it is in flight (between its
+ * submission and its return by the manager). A job manager and its jobs
+ * must not be used concurrently by several threads; distinct managers
+ * are independent of each other.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_jobmgr.h
+ */
+
+#ifndef SPH_JOBMGR_H__
+#define SPH_JOBMGR_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+#include "sph_batch.h"
+#include "sph_blake.h"
+#include "sph_keccak.h"
+#include "sph_md5.h"
+#include "sph_sha1.h"
+#include "sph_sha2.h"
+
+/**
+ * Job flag: the piece is the first one of the message (the context is
+ * initialized).
+ */
+#define SPH_JOB_FIRST   1
+
+/**
+ * Job flag: the piece is the last one of the message (the hash value
+ * is computed when the piece is consumed).
+ */
+#define SPH_JOB_LAST    2
+
+/**
+ * Maximum number of in-flight jobs in a manager.
+ */
+#define SPH_JOBMGR_MAX_LANES   16
+
+/**
+ * A job: one message being hashed. The caller sets the public fields
+ * before each submission; the other fields are managed by the job
+ * manager.
+ */
+typedef struct sph_job_ {
+	/**
+	 * The piece of message to process.
+	 */
+	const void *data;
+
+	/**
+	 * The length of the piece (in bytes); it may be zero.
+	 */
+	size_t len;
+
+	/**
+	 * A combination of <code>SPH_JOB_FIRST</code> and
+	 * <code>SPH_JOB_LAST</code>.
+	 */
+	unsigned flags;
+
+	/**
+	 * Free for use by the caller; not used by the manager.
+	 */
+	void *user;
+
+	/**
+	 * The hash value, set when the last piece has been consumed.
+	 */
+	unsigned char digest[64];
+
+#ifndef DOXYGEN_IGNORE
+	struct sph_job_ *next;
+	const unsigned char *ptr;
+	size_t nb, tail;
+	unsigned pending;
+	union {
+		sph_md5_context md5;
+		sph_sha1_context sha1;
+		sph_sha224_context sha224;
+		sph_sha384_context sha384;
+		sph_blake_small_context blake_small;
+		sph_blake_big_context blake_big;
+		sph_keccak_context keccak;
+	} cc;
+#endif
+} sph_job;
+
+/**
+ * A job manager, for one algorithm. Its contents are private.
+ */
+typedef struct {
+#ifndef DOXYGEN_IGNORE
+	const void *impl;
+	unsigned lanes, active;
+	sph_job *lane[SPH_JOBMGR_MAX_LANES];
+	sph_job *done, *done_tail;
+#endif
+} sph_jobmgr;
+
+/**
+ * Initialize a job manager for the algorithm <code>alg</code>, which is
+ * one of <code>SPH_HASH_MD5</code>, <code>SPH_HASH_SHA1</code>,
+ * <code>SPH_HASH_SHA224</code>, <code>SPH_HASH_SHA256</code>,
+ * <code>SPH_HASH_SHA384</code>, <code>SPH_HASH_SHA512</code>,
+ * <code>SPH_HASH_BLAKE*</code> and <code>SPH_HASH_KECCAK*</code>. The
+ * number of in-flight jobs is the number of lanes of the multi-message
+ * code for the current processor.
+ *
+ * @param m     the job manager
+ * @param alg   the algorithm identifier
+ * @return  1 on success, 0 if the algorithm is not supported
+ */
+int sph_jobmgr_init(sph_jobmgr *m, unsigned alg);
+
+/**
+ * Submit a piece of message. The job fields <code>data</code>,
+ * <code>len</code> and <code>flags</code> must be set; the first piece
+ * of a message must have the <code>SPH_JOB_FIRST</code> flag. The job
+ * belongs to the manager until it is returned by this function,
+ * <code>sph_jobmgr_flush()</code> or
+ * <code>sph_jobmgr_get_completed()</code>; the piece of data must stay
+ * available until then. This function returns one completed job (not
+ * necessarily the submitted one), or <code>NULL</code> if no job is
+ * completed yet.
+ *
+ * @param m     the job manager
+ * @param job   the job to submit
+ * @return  a completed job, or <code>NULL</code>
+ */
+sph_job *sph_jobmgr_submit(sph_jobmgr *m, sph_job *job);
+
+/**
+ * Process the in-flight jobs without waiting for more submissions,
+ * until at least one job is completed, and return a completed job.
+ * <code>NULL</code> is returned when no job is held by the manager;
+ * calling this function until it returns <code>NULL</code> thus
+ * completes all submitted jobs.
+ *
+ * @param m   the job manager
+ * @return  a completed job, or <code>NULL</code>
+ */
+sph_job *sph_jobmgr_flush(sph_jobmgr *m);
+
+/**
+ * Return a completed job, if any, without processing data. Completed
+ * jobs are returned in completion order.
+ *
+ * @param m   the job manager
+ * @return  a completed job, or <code>NULL</code>
+ */
+sph_job *sph_jobmgr_get_completed(sph_jobmgr *m);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
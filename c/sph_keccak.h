@@ -124,6 +124,18 @@ void sph_keccak224_init(void *cc);
  */
 void sph_keccak224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_keccak224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Keccak-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_keccak224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Keccak-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -135,6 +147,20 @@ void sph_keccak224(void *cc, const void *data, size_t len);
  */
 void sph_keccak224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Keccak-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_keccak224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -169,6 +195,18 @@ void sph_keccak256_init(void *cc);
  */
 void sph_keccak256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_keccak256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Keccak-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_keccak256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Keccak-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -180,6 +218,20 @@ void sph_keccak256(void *cc, const void *data, size_t len);
  */
 void sph_keccak256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Keccak-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_keccak256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -214,6 +266,18 @@ void sph_keccak384_init(void *cc);
  */
 void sph_keccak384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_keccak384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Keccak-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_keccak384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Keccak-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -225,6 +289,20 @@ void sph_keccak384(void *cc, const void *data, size_t len);
  */
 void sph_keccak384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Keccak-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_keccak384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -259,6 +337,18 @@ void sph_keccak512_init(void *cc);
  */
 void sph_keccak512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_keccak512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Keccak-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_keccak512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Keccak-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -270,6 +360,20 @@ void sph_keccak512(void *cc, const void *data, size_t len);
  */
 void sph_keccak512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Keccak-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_keccak512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
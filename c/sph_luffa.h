@@ -127,6 +127,18 @@ void sph_luffa224_init(void *cc);
  */
 void sph_luffa224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_luffa224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Luffa-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_luffa224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Luffa-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -138,6 +150,17 @@ void sph_luffa224(void *cc, const void *data, size_t len);
  */
 void sph_luffa224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Luffa-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_luffa224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -154,6 +177,29 @@ void sph_luffa224_close(void *cc, void *dst);
 void sph_luffa224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Luffa-224 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (28 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_luffa224_init()</code>,
+ * <code>sph_luffa224()</code> and <code>sph_luffa224_close()</code>
+ * compute for each message; no context is needed.
+ *
+ * With AVX2, messages are processed two at a time (one per 128-bit
+ * half of the registers); the full blocks common to both messages are
+ * hashed in parallel, and so are the padding and the final rounds when
+ * both messages have the same length. Otherwise, and for a message
+ * left alone, the single-message code is used; it also uses the vector
+ * units (SSE2 or AVX2) when available.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_luffa224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Luffa-256 context. This process performs no memory allocation.
  *
@@ -172,6 +218,18 @@ void sph_luffa256_init(void *cc);
  */
 void sph_luffa256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_luffa256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Luffa-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_luffa256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Luffa-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -183,6 +241,17 @@ void sph_luffa256(void *cc, const void *data, size_t len);
  */
 void sph_luffa256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Luffa-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_luffa256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -199,6 +268,22 @@ void sph_luffa256_close(void *cc, void *dst);
 void sph_luffa256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Luffa-256 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (32 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_luffa256_init()</code>,
+ * <code>sph_luffa256()</code> and <code>sph_luffa256_close()</code>
+ * compute for each message; no context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_luffa256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Luffa-384 context. This process performs no memory allocation.
  *
@@ -217,6 +302,18 @@ void sph_luffa384_init(void *cc);
  */
 void sph_luffa384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_luffa384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Luffa-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_luffa384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Luffa-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -228,6 +325,17 @@ void sph_luffa384(void *cc, const void *data, size_t len);
  */
 void sph_luffa384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Luffa-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_luffa384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -244,6 +352,22 @@ void sph_luffa384_close(void *cc, void *dst);
 void sph_luffa384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Luffa-384 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (48 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_luffa384_init()</code>,
+ * <code>sph_luffa384()</code> and <code>sph_luffa384_close()</code>
+ * compute for each message; no context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_luffa384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Luffa-512 context. This process performs no memory allocation.
  *
@@ -262,6 +386,18 @@ void sph_luffa512_init(void *cc);
  */
 void sph_luffa512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_luffa512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Luffa-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_luffa512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Luffa-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -273,6 +409,17 @@ void sph_luffa512(void *cc, const void *data, size_t len);
  */
 void sph_luffa512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Luffa-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_luffa512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -288,6 +435,26 @@ void sph_luffa512_close(void *cc, void *dst);
  */
 void sph_luffa512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
+
+/**
+ * Compute Luffa-512 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (64 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_luffa512_init()</code>,
+ * <code>sph_luffa512()</code> and <code>sph_luffa512_close()</code>
+ * compute for each message; no context is needed.
+ *
+ * Luffa-512 uses five sub-permutations, which fill a 256-bit register
+ * on their own; hence, messages are hashed in turn with the
+ * single-message code (which uses AVX2 when available).
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_luffa512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
 	
 #ifdef __cplusplus
 }
@@ -92,6 +92,18 @@ void sph_md2_init(void *cc);
  */
 void sph_md2(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_md2()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the MD2 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_md2_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current MD2 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -103,4 +115,15 @@ void sph_md2(void *cc, const void *data, size_t len);
  */
 void sph_md2_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with MD2 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_md2_oneshot(const void *data, size_t len, void *dst);
+
 #endif
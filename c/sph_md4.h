@@ -88,6 +88,18 @@ void sph_md4_init(void *cc);
  */
 void sph_md4(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_md4()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the MD4 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_md4_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current MD4 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -99,6 +111,20 @@ void sph_md4(void *cc, const void *data, size_t len);
  */
 void sph_md4_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with MD4 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_md4_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Apply the MD4 compression function on the provided data. The
  * <code>msg</code> parameter contains the 16 32-bit input blocks,
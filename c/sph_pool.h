@@ -0,0 +1,231 @@
+/* $Id$ */
+/**
+ * Thread pool for parallel bulk hashing.
+ *
+ * A pool is a set of worker threads which, together with the calling
+ * thread, process a range of work items. The range is split evenly
+ * among the threads, each holding its part in its own deque; a thread
+ * takes its items one grain at a time from the front of its deque, and
+ * a thread whose deque is empty steals the back half of the deque of
+ * another thread. Each thread owns an aligned scratch area, which is
+ * kept from one run to the next; the parallel hashing functions below
+ * use it for their per-thread working data (lane counters of the
+ * chains, leaf descriptors in tree mode).
+ *
+ * Runs on a pool are serialized: a run which starts while another one
+ * is in progress waits for it. A single process-wide pool (obtained by
+ * passing <code>NULL</code> as the pool) may then be shared by all the
+ * components of an application without oversubscribing the cores. A
+ * run started from within a work item is processed by the calling
+ * thread alone.
+ *
+ * Threads are used on POSIX systems, unless <code>SPH_NO_THREADS</code>
+ * is defined to a non-zero value; otherwise, the pool functions are
+ * still provided, but all the work is done by the calling thread.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_pool.h
+ */
+
+#ifndef SPH_POOL_H__
+#define SPH_POOL_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+#include "sph_batch.h"
+#include "sph_chain.h"
+
+#ifndef DOXYGEN_IGNORE
+#if !SPH_NO_THREADS && (defined __unix__ || defined __unix \
+	|| (defined __APPLE__ && defined __MACH__))
+#define SPH_THREADS   1
+#else
+#define SPH_THREADS   0
+#endif
+#endif
+
+/**
+ * Size (in bytes) of the per-thread scratch area. The area is aligned
+ * on 64 bytes if pointers can be converted to integers
+ * (<code>SPH_UPTR</code>), with the <code>malloc()</code> alignment
+ * otherwise.
+ */
+#define SPH_POOL_SCRATCH   4096
+
+/**
+ * Pool flag: pin each worker thread to one processor (on Linux only;
+ * the flag is ignored elsewhere). The processors are those of the
+ * affinity mask of the thread which creates the pool (as set with
+ * <code>taskset</code> or a cgroup cpuset), in increasing order:
+ * worker <code>i</code> (from 1) runs on the processor of rank
+ * <code>i</code> in that mask, modulo the number of processors.
+ */
+#define SPH_POOL_PIN   1
+
+/**
+ * A thread pool. Its contents are private.
+ */
+typedef struct sph_pool_ sph_pool;
+
+/**
+ * Type of the work functions for <code>sph_pool_run()</code>: process
+ * the items <code>start</code> to <code>end-1</code>, with the scratch
+ * area of the running thread.
+ *
+ * @param arg       the opaque argument given to <code>sph_pool_run()</code>
+ * @param start     the first item
+ * @param end       the item after the last one
+ * @param scratch   the scratch area (<code>SPH_POOL_SCRATCH</code> bytes)
+ */
+typedef void (*sph_pool_fun)(void *arg, size_t start, size_t end,
+	void *scratch);
+
+/**
+ * Create a pool. The number of threads includes the calling thread, so
+ * that <code>threads - 1</code> worker threads are started; if
+ * <code>threads</code> is zero, the number of processors available to
+ * the calling thread (its affinity mask, on Linux) is used.
+ * <code>NULL</code> is returned if the pool could not be created.
+ *
+ * @param threads   the number of threads (0 for one per processor)
+ * @param flags     a combination of <code>SPH_POOL_*</code> flags
+ * @return  the new pool, or <code>NULL</code>
+ */
+sph_pool *sph_pool_new(unsigned threads, unsigned flags);
+
+/**
+ * Stop the worker threads of a pool and release it. No run may be in
+ * progress. <code>NULL</code> is ignored; the process-wide pool must
+ * not be released.
+ *
+ * @param p   the pool
+ */
+void sph_pool_free(sph_pool *p);
+
+/**
+ * Get the number of threads of a pool, including the calling thread.
+ *
+ * @param p   the pool (<code>NULL</code> for the process-wide pool)
+ * @return  the number of threads
+ */
+unsigned sph_pool_threads(sph_pool *p);
+
+/**
+ * Process the items 0 to <code>num-1</code> with the pool threads:
+ * <code>fun</code> is called on ranges of at most <code>grain</code>
+ * consecutive items (a zero grain counts as 1), each item being
+ * processed exactly once. This function returns when all the items
+ * have been processed. The scratch area given to <code>fun</code>
+ * is shared by all the ranges processed by the same thread; its
+ * initial contents are unspecified.
+ *
+ * @param p       the pool (<code>NULL</code> for the process-wide pool)
+ * @param fun     the work function
+ * @param arg     the opaque argument for <code>fun</code>
+ * @param num     the number of items
+ * @param grain   the maximum number of items in one call
+ */
+void sph_pool_run(sph_pool *p, sph_pool_fun fun, void *arg,
+	size_t num, size_t grain);
+
+/**
+ * Parallel version of <code>sph_hash_batch()</code>: the messages are
+ * hashed in groups of consecutive messages by the pool threads, each
+ * group going through the multi-message code of the algorithm.
+ *
+ * @param p      the pool (<code>NULL</code> for the process-wide pool)
+ * @param alg    the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hash_batch_par(sph_pool *p, unsigned alg,
+	const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+/**
+ * Parallel version of <code>sph_chain_multi()</code>: the chains are
+ * computed in groups of consecutive messages by the pool threads. The
+ * <code>lanes</code> counters are the same as with
+ * <code>sph_chain_multi()</code>, but <code>calls</code> counts the
+ * batches of each group separately. The order bytes are checked
+ * before any chain is computed.
+ *
+ * @param p       the pool (<code>NULL</code> for the process-wide pool)
+ * @param data    the input messages
+ * @param len     the input message lengths (in bytes)
+ * @param dst     the destination buffers
+ * @param num     the number of messages
+ * @param order   the algorithm identifiers (<code>num * steps</code>)
+ * @param steps   the number of steps in each chain
+ * @param stats   the lane occupancy counters to update (or
+ *                <code>NULL</code>)
+ * @return  1 on success, 0 on an invalid algorithm identifier
+ */
+int sph_chain_multi_par(sph_pool *p,
+	const void *const *data, const size_t *len,
+	void *const *dst, size_t num,
+	const unsigned char *order, size_t steps, sph_chain_stats *stats);
+
+/**
+ * Hash a message in tree mode: the message is cut into leaves of
+ * <code>leaf</code> bytes (the last leaf may be shorter; an empty
+ * message has a single, empty leaf), the leaves are hashed in parallel
+ * by the pool threads, and the result is the hash of the concatenation
+ * of the leaf hash values, in order. All hashes use the algorithm
+ * <code>alg</code>. This is a sphlib-specific construction, not a
+ * standard tree hash mode. The leaf hash values are stored in a
+ * temporary allocated buffer; 0 is returned (and nothing is written)
+ * if the allocation fails, the algorithm is unknown or the leaf length
+ * is zero, 1 otherwise.
+ *
+ * @param p      the pool (<code>NULL</code> for the process-wide pool)
+ * @param alg    the algorithm identifier (<code>SPH_HASH_*</code>)
+ * @param data   the input message
+ * @param len    the input message length (in bytes)
+ * @param leaf   the leaf length (in bytes, non-zero)
+ * @param dst    the destination buffer
+ * @return  1 on success, 0 on error (including a zero leaf length)
+ */
+int sph_hash_tree_par(sph_pool *p, unsigned alg,
+	const void *data, size_t len, size_t leaf, void *dst);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -115,6 +115,18 @@ void sph_radiogatun32_init(void *cc);
  */
 void sph_radiogatun32(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_radiogatun32()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the RadioGatun[32] context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_radiogatun32_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current RadioGatun[32] computation and output the
  * result into the provided buffer. The destination buffer must be wide
@@ -126,6 +138,17 @@ void sph_radiogatun32(void *cc, const void *data, size_t len);
  */
 void sph_radiogatun32_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with RadioGatun[32] and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_radiogatun32_oneshot(const void *data, size_t len, void *dst);
+
 #if SPH_64
 
 /**
@@ -170,6 +193,18 @@ void sph_radiogatun64_init(void *cc);
  */
 void sph_radiogatun64(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_radiogatun64()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the RadioGatun[64] context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_radiogatun64_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current RadioGatun[64] computation and output the
  * result into the provided buffer. The destination buffer must be wide
@@ -181,6 +216,17 @@ void sph_radiogatun64(void *cc, const void *data, size_t len);
  */
 void sph_radiogatun64_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with RadioGatun[64] and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_radiogatun64_oneshot(const void *data, size_t len, void *dst);
+
 #endif
 
 #endif
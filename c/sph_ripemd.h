@@ -114,6 +114,18 @@ void sph_ripemd_init(void *cc);
  */
 void sph_ripemd(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_ripemd()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the RIPEMD context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_ripemd_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current RIPEMD computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -125,6 +137,20 @@ void sph_ripemd(void *cc, const void *data, size_t len);
  */
 void sph_ripemd_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with RIPEMD and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_ripemd_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Apply the RIPEMD compression function on the provided data. The
  * <code>msg</code> parameter contains the 16 32-bit input blocks,
@@ -180,6 +206,18 @@ void sph_ripemd128_init(void *cc);
  */
 void sph_ripemd128(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_ripemd128()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the RIPEMD-128 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_ripemd128_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current RIPEMD-128 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -191,6 +229,20 @@ void sph_ripemd128(void *cc, const void *data, size_t len);
  */
 void sph_ripemd128_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with RIPEMD-128 and write the result (16 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_ripemd128_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Apply the RIPEMD-128 compression function on the provided data. The
  * <code>msg</code> parameter contains the 16 32-bit input blocks,
@@ -246,6 +298,18 @@ void sph_ripemd160_init(void *cc);
  */
 void sph_ripemd160(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_ripemd160()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the RIPEMD-160 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_ripemd160_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current RIPEMD-160 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -257,6 +321,20 @@ void sph_ripemd160(void *cc, const void *data, size_t len);
  */
 void sph_ripemd160_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with RIPEMD-160 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_ripemd160_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Apply the RIPEMD-160 compression function on the provided data. The
  * <code>msg</code> parameter contains the 16 32-bit input blocks,
@@ -270,4 +348,71 @@ void sph_ripemd160_close(void *cc, void *dst);
  */
 void sph_ripemd160_comp(const sph_u32 msg[16], sph_u32 val[5]);
 
+/**
+ * Compute RIPEMD-160 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (20 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_ripemd160_init()</code>, <code>sph_ripemd160()</code> and
+ * <code>sph_ripemd160_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * Messages are processed sixteen (AVX2, AVX-512) or eight (SSE2) at a
+ * time, one message per vector lane, including the padding blocks.
+ * When a message is finished, its lane takes the next message, so that
+ * messages of distinct lengths keep all lanes busy.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_ripemd160_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+/**
+ * Get the number of lanes of the multi-message code of RIPEMD-160 for the
+ * current processor (1 if there is no such code). This is the number
+ * of contexts that <code>sph_ripemd160_blocks_multi()</code> processes
+ * together.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_ripemd160_multi_lanes(void);
+
+/**
+ * Process <code>nb</code> full blocks (64 bytes each) for each of
+ * <code>num</code> RIPEMD-160 contexts. The blocks for context
+ * <code>cc[i]</code> are consecutive from <code>data[i]</code>, with no
+ * alignment requirement. The contexts must not hold any buffered data,
+ * i.e. the amount of data processed so far by each context must be a
+ * multiple of the block size. The contexts are updated as if
+ * <code>sph_ripemd160()</code> had been called on each, but the blocks of
+ * distinct contexts are processed in parallel, one context per lane.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_ripemd160_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+
+/**
+ * Compute HASH160 (RIPEMD-160 of the SHA-256 of the message, as used
+ * for Bitcoin addresses) over <code>num</code> independent messages;
+ * the 20-byte results are written at <code>dst[i]</code>. Arguments
+ * are as for <code>sph_ripemd160_multi()</code>. Both stages use the
+ * multi-lane code; the SHA-256 outputs are padded in place and hashed
+ * as single RIPEMD-160 blocks. Messages of 33 or 65 bytes (public
+ * keys) need one or two SHA-256 blocks; other lengths are supported.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_hash160_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #endif
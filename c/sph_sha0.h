@@ -97,6 +97,18 @@ void sph_sha0_init(void *cc);
  */
 void sph_sha0(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha0()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-0 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha0_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHA-0 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -108,6 +120,20 @@ void sph_sha0(void *cc, const void *data, size_t len);
  */
 void sph_sha0_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-0 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha0_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -89,6 +89,18 @@ void sph_sha1_init(void *cc);
  */
 void sph_sha1(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha1()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-1 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha1_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHA-1 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -100,6 +112,20 @@ void sph_sha1(void *cc, const void *data, size_t len);
  */
 void sph_sha1_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-1 and write the result (20 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha1_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -115,6 +141,55 @@ void sph_sha1_close(void *cc, void *dst);
  */
 void sph_sha1_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute SHA-1 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (20 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_sha1_init()</code>,
+ * <code>sph_sha1()</code> and <code>sph_sha1_close()</code> compute for
+ * each message; no context is needed.
+ *
+ * Messages are processed sixteen (AVX2, AVX-512) or eight (SSE2) at a
+ * time, one message per vector lane, including the padding blocks.
+ * When a message is finished, its lane takes the next message, so that
+ * messages of distinct lengths keep all lanes busy.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_sha1_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+/**
+ * Get the number of lanes of the multi-message code of SHA-1 for the
+ * current processor (1 if there is no such code). This is the number
+ * of contexts that <code>sph_sha1_blocks_multi()</code> processes
+ * together.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_sha1_multi_lanes(void);
+
+/**
+ * Process <code>nb</code> full blocks (64 bytes each) for each of
+ * <code>num</code> SHA-1 contexts. The blocks for context
+ * <code>cc[i]</code> are consecutive from <code>data[i]</code>, with no
+ * alignment requirement. The contexts must not hold any buffered data,
+ * i.e. the amount of data processed so far by each context must be a
+ * multiple of the block size. The contexts are updated as if
+ * <code>sph_sha1()</code> had been called on each, but the blocks of
+ * distinct contexts are processed in parallel, one context per lane.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_sha1_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+
 /**
  * Apply the SHA-1 compression function on the provided data. The
  * <code>msg</code> parameter contains the 16 32-bit input blocks,
@@ -105,6 +105,18 @@ void sph_sha224_init(void *cc);
  */
 void sph_sha224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHA-224 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -116,6 +128,20 @@ void sph_sha224(void *cc, const void *data, size_t len);
  */
 void sph_sha224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -144,6 +170,55 @@ void sph_sha224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
  */
 void sph_sha224_comp(const sph_u32 msg[16], sph_u32 val[8]);
 
+/**
+ * Compute SHA-224 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (28 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_sha224_init()</code>,
+ * <code>sph_sha224()</code> and <code>sph_sha224_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * Messages are processed sixteen (AVX-512), eight (AVX2) or four (SSE2)
+ * at a time, one message per vector lane, including the padding blocks.
+ * When a message is finished, its lane takes the next message, so that
+ * messages of distinct lengths keep all lanes busy.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_sha224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+/**
+ * Get the number of lanes of the multi-message code of SHA-224 for the
+ * current processor (1 if there is no such code). This is the number
+ * of contexts that <code>sph_sha224_blocks_multi()</code> processes
+ * together.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_sha224_multi_lanes(void);
+
+/**
+ * Process <code>nb</code> full blocks (64 bytes each) for each of
+ * <code>num</code> SHA-224 contexts. The blocks for context
+ * <code>cc[i]</code> are consecutive from <code>data[i]</code>, with no
+ * alignment requirement. The contexts must not hold any buffered data,
+ * i.e. the amount of data processed so far by each context must be a
+ * multiple of the block size. The contexts are updated as if
+ * <code>sph_sha224()</code> had been called on each, but the blocks of
+ * distinct contexts are processed in parallel, one context per lane.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_sha224_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+
 /**
  * Initialize a SHA-256 context. This process performs no memory allocation.
  *
@@ -162,10 +237,23 @@ void sph_sha256_init(void *cc);
  * @param len    the input data length (in bytes)
  */
 void sph_sha256(void *cc, const void *data, size_t len);
+
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha256_updatev(void *cc, const sph_iovec *iov, int n);
 #endif
 
 #ifndef DOXYGEN_IGNORE
 #define sph_sha256   sph_sha224
+#define sph_sha256_updatev   sph_sha224_updatev
 #endif
 
 /**
@@ -179,6 +267,20 @@ void sph_sha256(void *cc, const void *data, size_t len);
  */
 void sph_sha256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -194,6 +296,19 @@ void sph_sha256_close(void *cc, void *dst);
  */
 void sph_sha256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute SHA-256 over <code>num</code> independent messages (32-byte
+ * outputs). This function is the SHA-256 counterpart of
+ * <code>sph_sha224_multi()</code>.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_sha256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #ifdef DOXYGEN_IGNORE
 /**
  * Apply the SHA-256 compression function on the provided data. This
@@ -209,6 +324,33 @@ void sph_sha256_comp(const sph_u32 msg[16], sph_u32 val[8]);
 #define sph_sha256_comp   sph_sha224_comp
 #endif
 
+#ifdef DOXYGEN_IGNORE
+/**
+ * Get the number of lanes of the multi-message code of SHA-256. This
+ * function is identical to <code>sph_sha224_multi_lanes()</code>.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_sha256_multi_lanes(void);
+
+/**
+ * Process full blocks for several SHA-256 contexts in parallel. This
+ * function is identical to <code>sph_sha224_blocks_multi()</code>.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_sha256_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+#endif
+
+#ifndef DOXYGEN_IGNORE
+#define sph_sha256_multi_lanes     sph_sha224_multi_lanes
+#define sph_sha256_blocks_multi   sph_sha224_blocks_multi
+#endif
+
 #if SPH_64
 
 /**
@@ -257,6 +399,18 @@ void sph_sha384_init(void *cc);
  */
 void sph_sha384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHA-384 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -268,6 +422,20 @@ void sph_sha384(void *cc, const void *data, size_t len);
  */
 void sph_sha384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -296,6 +464,56 @@ void sph_sha384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
  */
 void sph_sha384_comp(const sph_u64 msg[16], sph_u64 val[8]);
 
+/**
+ * Compute SHA-384 over <code>num</code> independent messages. Message
+ * <code>i</code> is <code>len[i]</code> bytes at <code>data[i]</code>;
+ * its hash value (48 bytes) is written at <code>dst[i]</code>. The
+ * output is identical to what <code>sph_sha384_init()</code>,
+ * <code>sph_sha384()</code> and <code>sph_sha384_close()</code> compute
+ * for each message; no context is needed.
+ *
+ * Messages are processed eight (AVX-512) or four (AVX2) at a time, one
+ * message per vector lane, including the padding blocks. When a message
+ * is finished, its lane takes the next message, so that messages of
+ * distinct lengths keep all lanes busy. Without AVX2, the messages are
+ * hashed one after the other.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_sha384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
+/**
+ * Get the number of lanes of the multi-message code of SHA-384 for the
+ * current processor (1 if there is no such code). This is the number
+ * of contexts that <code>sph_sha384_blocks_multi()</code> processes
+ * together.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_sha384_multi_lanes(void);
+
+/**
+ * Process <code>nb</code> full blocks (128 bytes each) for each of
+ * <code>num</code> SHA-384 contexts. The blocks for context
+ * <code>cc[i]</code> are consecutive from <code>data[i]</code>, with no
+ * alignment requirement. The contexts must not hold any buffered data,
+ * i.e. the amount of data processed so far by each context must be a
+ * multiple of the block size. The contexts are updated as if
+ * <code>sph_sha384()</code> had been called on each, but the blocks of
+ * distinct contexts are processed in parallel, one context per lane.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_sha384_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+
 /**
  * This structure is a context for SHA-512 computations. It is identical
  * to the SHA-384 context. However, a context is initialized for SHA-384
@@ -322,10 +540,23 @@ void sph_sha512_init(void *cc);
  * @param len    the input data length (in bytes)
  */
 void sph_sha512(void *cc, const void *data, size_t len);
+
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_sha512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHA-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_sha512_updatev(void *cc, const sph_iovec *iov, int n);
 #endif
 
 #ifndef DOXYGEN_IGNORE
 #define sph_sha512   sph_sha384
+#define sph_sha512_updatev   sph_sha384_updatev
 #endif
 
 /**
@@ -339,6 +570,20 @@ void sph_sha512(void *cc, const void *data, size_t len);
  */
 void sph_sha512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHA-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_sha512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -354,6 +599,19 @@ void sph_sha512_close(void *cc, void *dst);
  */
 void sph_sha512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute SHA-512 over <code>num</code> independent messages (64-byte
+ * outputs). This function is the SHA-512 counterpart of
+ * <code>sph_sha384_multi()</code>.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_sha512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #ifdef DOXYGEN_IGNORE
 /**
  * Apply the SHA-512 compression function. This function is identical to
@@ -369,6 +627,33 @@ void sph_sha512_comp(const sph_u64 msg[16], sph_u64 val[8]);
 #define sph_sha512_comp   sph_sha384_comp
 #endif
 
+#ifdef DOXYGEN_IGNORE
+/**
+ * Get the number of lanes of the multi-message code of SHA-512. This
+ * function is identical to <code>sph_sha384_multi_lanes()</code>.
+ *
+ * @return  the number of lanes
+ */
+unsigned sph_sha512_multi_lanes(void);
+
+/**
+ * Process full blocks for several SHA-512 contexts in parallel. This
+ * function is identical to <code>sph_sha384_blocks_multi()</code>.
+ *
+ * @param cc     the contexts
+ * @param data   the input blocks
+ * @param nb     the number of blocks for each context
+ * @param num    the number of contexts
+ */
+void sph_sha512_blocks_multi(void *const *cc, const void *const *data,
+	size_t nb, size_t num);
+#endif
+
+#ifndef DOXYGEN_IGNORE
+#define sph_sha512_multi_lanes     sph_sha384_multi_lanes
+#define sph_sha512_blocks_multi   sph_sha384_blocks_multi
+#endif
+
 #endif
 
 #endif
@@ -129,6 +129,18 @@ void sph_shabal192_init(void *cc);
  */
 void sph_shabal192(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shabal192()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Shabal-192 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shabal192_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Shabal-192 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -140,6 +152,17 @@ void sph_shabal192(void *cc, const void *data, size_t len);
  */
 void sph_shabal192_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Shabal-192 and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shabal192_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -156,6 +179,30 @@ void sph_shabal192_close(void *cc, void *dst);
 void sph_shabal192_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-192 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (24 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shabal192_init()</code>, <code>sph_shabal192()</code> and
+ * <code>sph_shabal192_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * Messages are processed in groups of sixteen (AVX-512), eight (AVX2)
+ * or four (SSE2), one message per vector lane. Within a group, the
+ * blocks common to all messages are hashed in parallel; when all
+ * messages of the group have the same length, the final block is also
+ * processed in parallel. Otherwise, each message is completed with the
+ * single-message code.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shabal192_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Shabal-224 context. This process performs no memory allocation.
  *
@@ -174,6 +221,18 @@ void sph_shabal224_init(void *cc);
  */
 void sph_shabal224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shabal224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Shabal-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shabal224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Shabal-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -185,6 +244,17 @@ void sph_shabal224(void *cc, const void *data, size_t len);
  */
 void sph_shabal224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Shabal-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shabal224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -201,6 +271,23 @@ void sph_shabal224_close(void *cc, void *dst);
 void sph_shabal224_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-224 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (28 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shabal224_init()</code>, <code>sph_shabal224()</code> and
+ * <code>sph_shabal224_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shabal224_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Shabal-256 context. This process performs no memory allocation.
  *
@@ -219,6 +306,18 @@ void sph_shabal256_init(void *cc);
  */
 void sph_shabal256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shabal256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Shabal-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shabal256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Shabal-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -230,6 +329,17 @@ void sph_shabal256(void *cc, const void *data, size_t len);
  */
 void sph_shabal256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Shabal-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shabal256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -246,6 +356,23 @@ void sph_shabal256_close(void *cc, void *dst);
 void sph_shabal256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-256 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (32 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shabal256_init()</code>, <code>sph_shabal256()</code> and
+ * <code>sph_shabal256_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shabal256_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Shabal-384 context. This process performs no memory allocation.
  *
@@ -264,6 +391,18 @@ void sph_shabal384_init(void *cc);
  */
 void sph_shabal384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shabal384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Shabal-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shabal384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Shabal-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -275,6 +414,17 @@ void sph_shabal384(void *cc, const void *data, size_t len);
  */
 void sph_shabal384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Shabal-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shabal384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -291,6 +441,23 @@ void sph_shabal384_close(void *cc, void *dst);
 void sph_shabal384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shabal384_init()</code>, <code>sph_shabal384()</code> and
+ * <code>sph_shabal384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shabal384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a Shabal-512 context. This process performs no memory allocation.
  *
@@ -309,6 +476,18 @@ void sph_shabal512_init(void *cc);
  */
 void sph_shabal512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shabal512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Shabal-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shabal512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Shabal-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -320,6 +499,17 @@ void sph_shabal512(void *cc, const void *data, size_t len);
  */
 void sph_shabal512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Shabal-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shabal512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -336,6 +526,23 @@ void sph_shabal512_close(void *cc, void *dst);
 void sph_shabal512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shabal512_init()</code>, <code>sph_shabal512()</code> and
+ * <code>sph_shabal512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shabal512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -145,6 +145,18 @@ void sph_shavite224_init(void *cc);
  */
 void sph_shavite224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shavite224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHAvite-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shavite224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHAvite-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -156,6 +168,17 @@ void sph_shavite224(void *cc, const void *data, size_t len);
  */
 void sph_shavite224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHAvite-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shavite224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -190,6 +213,18 @@ void sph_shavite256_init(void *cc);
  */
 void sph_shavite256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shavite256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHAvite-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shavite256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHAvite-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -201,6 +236,17 @@ void sph_shavite256(void *cc, const void *data, size_t len);
  */
 void sph_shavite256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHAvite-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shavite256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -235,6 +281,18 @@ void sph_shavite384_init(void *cc);
  */
 void sph_shavite384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shavite384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHAvite-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shavite384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHAvite-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -246,6 +304,17 @@ void sph_shavite384(void *cc, const void *data, size_t len);
  */
 void sph_shavite384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHAvite-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shavite384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -262,6 +331,29 @@ void sph_shavite384_close(void *cc, void *dst);
 void sph_shavite384_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute SHAvite-384 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (48 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shavite384_init()</code>, <code>sph_shavite384()</code> and
+ * <code>sph_shavite384_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shavite384_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * Initialize a SHAvite-512 context. This process performs no memory allocation.
  *
@@ -280,6 +372,18 @@ void sph_shavite512_init(void *cc);
  */
 void sph_shavite512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_shavite512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SHAvite-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_shavite512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SHAvite-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -291,6 +395,17 @@ void sph_shavite512(void *cc, const void *data, size_t len);
  */
 void sph_shavite512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SHAvite-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_shavite512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -306,6 +421,29 @@ void sph_shavite512_close(void *cc, void *dst);
  */
 void sph_shavite512_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
+
+/**
+ * Compute SHAvite-512 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_shavite512_init()</code>, <code>sph_shavite512()</code> and
+ * <code>sph_shavite512_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With VAES, messages are processed in groups of four (AVX-512) or
+ * two (AVX2), one message in each 128-bit lane of the vector
+ * registers; the blocks beyond the length of the shortest message of
+ * a group are processed one message at a time. Otherwise, the
+ * messages are simply hashed in sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_shavite512_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
 	
 #ifdef __cplusplus
 }
@@ -141,6 +141,18 @@ void sph_simd224_init(void *cc);
  */
 void sph_simd224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_simd224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SIMD-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_simd224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SIMD-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -152,6 +164,17 @@ void sph_simd224(void *cc, const void *data, size_t len);
  */
 void sph_simd224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SIMD-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_simd224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -186,6 +209,18 @@ void sph_simd256_init(void *cc);
  */
 void sph_simd256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_simd256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SIMD-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_simd256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SIMD-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -197,6 +232,17 @@ void sph_simd256(void *cc, const void *data, size_t len);
  */
 void sph_simd256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SIMD-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_simd256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -231,6 +277,18 @@ void sph_simd384_init(void *cc);
  */
 void sph_simd384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_simd384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SIMD-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_simd384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SIMD-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -242,6 +300,17 @@ void sph_simd384(void *cc, const void *data, size_t len);
  */
 void sph_simd384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SIMD-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_simd384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -276,6 +345,18 @@ void sph_simd512_init(void *cc);
  */
 void sph_simd512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_simd512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the SIMD-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_simd512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current SIMD-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -287,6 +368,17 @@ void sph_simd512(void *cc, const void *data, size_t len);
  */
 void sph_simd512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with SIMD-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_simd512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -127,6 +127,18 @@ void sph_skein224_init(void *cc);
  */
 void sph_skein224(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_skein224()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Skein-224 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_skein224_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Skein-224 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -138,6 +150,17 @@ void sph_skein224(void *cc, const void *data, size_t len);
  */
 void sph_skein224_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Skein-224 and write the result (28 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_skein224_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -172,6 +195,18 @@ void sph_skein256_init(void *cc);
  */
 void sph_skein256(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_skein256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Skein-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_skein256_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Skein-256 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -183,6 +218,17 @@ void sph_skein256(void *cc, const void *data, size_t len);
  */
 void sph_skein256_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Skein-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_skein256_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -217,6 +263,18 @@ void sph_skein384_init(void *cc);
  */
 void sph_skein384(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_skein384()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Skein-384 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_skein384_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Skein-384 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -228,6 +286,17 @@ void sph_skein384(void *cc, const void *data, size_t len);
  */
 void sph_skein384_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Skein-384 and write the result (48 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_skein384_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -262,6 +331,18 @@ void sph_skein512_init(void *cc);
  */
 void sph_skein512(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_skein512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Skein-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_skein512_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Skein-512 computation and output the result into
  * the provided buffer. The destination buffer must be wide enough to
@@ -273,6 +354,17 @@ void sph_skein512(void *cc, const void *data, size_t len);
  */
 void sph_skein512_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Skein-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_skein512_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Add a few additional bits (0 to 7) to the current computation, then
  * terminate it and output the result in the provided buffer, which must
@@ -0,0 +1,236 @@
+/* $Id$ */
+/**
+ * Usage statistics per hash function family.
+ *
+ * When enabled with <code>sph_stats_enable()</code>, the hash functions
+ * count, for each family (all the output sizes of an algorithm, e.g.
+ * SHA-224 to SHA-512 for SHA-2), the number of input calls (update and
+ * one-shot), the number of input bytes, the number of blocks processed
+ * by the compression function, and a histogram of the input lengths per
+ * call, by power of two. For one-shot and batch hashing, the input
+ * lengths are the message lengths.
+ *
+ * Counters are kept per thread, in cache-line-aligned areas, so that
+ * threads never write to a shared line; <code>sph_stats_get()</code>
+ * sums them on demand. The counts of a thread which has exited are kept.
+ * Counters are read while other threads may update them, so a total
+ * obtained while hashing is in progress is only a snapshot.
+ *
+ * Statistics are disabled by default; the cost is then a test on a
+ * global flag per input call and per compressed block (or group of
+ * blocks). They are compiled in when a 64-bit type and thread-local
+ * storage are available, unless <code>SPH_NO_STATS</code> is defined to
+ * a non-zero value, in which case the functions below are still
+ * provided, but all counters remain at zero.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_stats.h
+ */
+
+#ifndef SPH_STATS_H__
+#define SPH_STATS_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+#ifndef DOXYGEN_IGNORE
+#if SPH_NO_STATS
+#define SPH_STATS   0
+#elif defined __GNUC__ || defined __clang__
+#define SPH_STATS   1
+#define SPH_STATS_TLS   __thread
+#elif defined _MSC_VER
+#define SPH_STATS   1
+#define SPH_STATS_TLS   __declspec(thread)
+#elif defined __STDC_VERSION__ && __STDC_VERSION__ >= 201112L \
+	&& !defined __STDC_NO_THREADS__
+#define SPH_STATS   1
+#define SPH_STATS_TLS   _Thread_local
+#else
+#define SPH_STATS   0
+#endif
+#endif
+
+/**
+ * Number of histogram buckets. Bucket 0 counts the empty inputs; bucket
+ * <code>k</code> (1 to 27) counts the inputs of length 2<sup>k-1</sup>
+ * to 2<sup>k</sup>-1 bytes; bucket 28 counts the inputs of 128 MB and
+ * more.
+ */
+#define SPH_STATS_HIST   29
+
+/**
+ * Counters for one family. The structure is 256 bytes long.
+ */
+typedef struct {
+	/** Number of input calls (the <code>*_blocks_multi()</code>
+	    functions only count bytes and blocks). */
+	sph_u64 calls;
+	/** Number of input bytes. */
+	sph_u64 bytes;
+	/** Number of compressed blocks. */
+	sph_u64 blocks;
+	/** Histogram of the input lengths. */
+	sph_u64 hist[SPH_STATS_HIST];
+} sph_stats_counters;
+
+/*
+ * Family identifiers.
+ */
+
+#define SPH_STATS_BLAKE        0
+#define SPH_STATS_BMW          1
+#define SPH_STATS_CUBEHASH     2
+#define SPH_STATS_ECHO         3
+#define SPH_STATS_FUGUE        4
+#define SPH_STATS_GOST         5
+#define SPH_STATS_GROESTL      6
+#define SPH_STATS_HAMSI        7
+#define SPH_STATS_HAVAL        8
+#define SPH_STATS_JH           9
+#define SPH_STATS_KECCAK      10
+#define SPH_STATS_LUFFA       11
+#define SPH_STATS_MD2         12
+#define SPH_STATS_MD4         13
+#define SPH_STATS_MD5         14
+#define SPH_STATS_PANAMA      15
+#define SPH_STATS_RADIOGATUN  16
+#define SPH_STATS_RIPEMD      17
+#define SPH_STATS_SHA0        18
+#define SPH_STATS_SHA1        19
+#define SPH_STATS_SHA2        20
+#define SPH_STATS_SHABAL      21
+#define SPH_STATS_SHAVITE     22
+#define SPH_STATS_SIMD        23
+#define SPH_STATS_SKEIN       24
+#define SPH_STATS_STREEBOG    25
+#define SPH_STATS_TIGER       26
+#define SPH_STATS_WHIRLPOOL   27
+
+/**
+ * Number of families.
+ */
+#define SPH_STATS_NUM         28
+
+/**
+ * Enable or disable the statistics for all threads. Counting stops or
+ * starts at the next call of a hash function; counters are kept.
+ *
+ * @param on   non-zero to enable the statistics
+ */
+void sph_stats_enable(int on);
+
+/**
+ * Test whether the statistics are enabled (and compiled in).
+ *
+ * @return  non-zero if enabled
+ */
+int sph_stats_enabled(void);
+
+/**
+ * Get the counters for a family, summed over all threads (including
+ * the threads which have exited). Counters of an invalid family are
+ * all zero. Each counter is read atomically, but counts made by other
+ * threads during the call may or may not be included, so the result
+ * is not a consistent snapshot while other threads are hashing.
+ *
+ * @param fam   the family (<code>SPH_STATS_*</code>)
+ * @param dst   the destination structure
+ */
+void sph_stats_get(unsigned fam, sph_stats_counters *dst);
+
+/**
+ * Reset all the counters of all threads to zero. Counts made by other
+ * threads during the reset may be lost.
+ */
+void sph_stats_reset(void);
+
+/**
+ * Get the name of a family (e.g. <code>"sha2"</code>), or
+ * <code>NULL</code> for an invalid family.
+ *
+ * @param fam   the family (<code>SPH_STATS_*</code>)
+ * @return  the family name
+ */
+const char *sph_stats_name(unsigned fam);
+
+#ifndef DOXYGEN_IGNORE
+
+#if SPH_STATS
+
+extern volatile int sph_stats_on;
+
+void sph_stats_input(unsigned fam, size_t len);
+void sph_stats_bytes(unsigned fam, size_t len);
+void sph_stats_blocks(unsigned fam, size_t num);
+
+/*
+ * Hooks for the hash function implementations: one input call of
+ * len bytes, len bytes processed outside of an input call (they are
+ * not counted as a call nor in the histogram), and num blocks
+ * compressed.
+ */
+#define SPH_STATS_INPUT(fam, len)   do { \
+		if (sph_stats_on) \
+			sph_stats_input(fam, len); \
+	} while (0)
+
+#define SPH_STATS_BYTES(fam, len)   do { \
+		if (sph_stats_on) \
+			sph_stats_bytes(fam, len); \
+	} while (0)
+
+#define SPH_STATS_BLOCKS(fam, num)   do { \
+		if (sph_stats_on) \
+			sph_stats_blocks(fam, num); \
+	} while (0)
+
+#endif
+
+#endif
+
+#endif
+
+#ifndef DOXYGEN_IGNORE
+#ifndef SPH_STATS_INPUT
+#define SPH_STATS_INPUT(fam, len)    ((void)0)
+#define SPH_STATS_BYTES(fam, len)    ((void)0)
+#define SPH_STATS_BLOCKS(fam, num)   ((void)0)
+#endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
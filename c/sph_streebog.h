@@ -0,0 +1,222 @@
+/* $Id$ */
+/**
+ * Streebog interface. Streebog is the hash function standardized as
+ * GOST R 34.11-2012 (and RFC 6986); it has two variants, with 256-bit
+ * and 512-bit outputs, which differ only by their initial value and
+ * the output truncation. The functions are named "gost256" and
+ * "gost512", as in other code which uses sphlib-style interfaces.
+ *
+ * This implementation uses the little-endian byte order of RFC 6986:
+ * the message is processed from its first byte, and hash values are
+ * written least significant byte first.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_streebog.h
+ */
+
+#ifndef SPH_STREEBOG_H__
+#define SPH_STREEBOG_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+/**
+ * Output size (in bits) for Streebog-256.
+ */
+#define SPH_SIZE_gost256   256
+
+/**
+ * Output size (in bits) for Streebog-512.
+ */
+#define SPH_SIZE_gost512   512
+
+/**
+ * This structure is a context for Streebog computations: it contains
+ * the intermediate values and some data from the last entered block.
+ * Once a Streebog computation has been performed, the context can be
+ * reused for another computation.
+ *
+ * The contents of this structure are private. A running Streebog
+ * computation can be cloned by copying the context (e.g. with a simple
+ * <code>memcpy()</code>).
+ */
+typedef struct {
+#ifndef DOXYGEN_IGNORE
+	unsigned char buf[64];    /* first field, for alignment */
+	size_t ptr;
+	sph_u64 h[8];             /* chaining value */
+	sph_u64 N[8];             /* number of processed bits */
+	sph_u64 S[8];             /* sum of the message blocks */
+#endif
+} sph_gost512_context;
+
+/**
+ * Streebog-256 uses the same structure as Streebog-512.
+ */
+typedef sph_gost512_context sph_gost256_context;
+
+/**
+ * Initialize a Streebog-256 context. This process performs no memory
+ * allocation.
+ *
+ * @param cc   the Streebog-256 context (pointer to a
+ *             <code>sph_gost256_context</code>)
+ */
+void sph_gost256_init(void *cc);
+
+/**
+ * Process some data bytes. It is acceptable that <code>len</code> is zero
+ * (in which case this function does nothing).
+ *
+ * @param cc     the Streebog-256 context
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ */
+void sph_gost256(void *cc, const void *data, size_t len);
+
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_gost256()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Streebog-256 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_gost256_updatev(void *cc, const sph_iovec *iov, int n);
+
+/**
+ * Terminate the current Streebog-256 computation and output the result
+ * into the provided buffer. The destination buffer must be wide enough
+ * to accomodate the result (32 bytes). The context is automatically
+ * reinitialized.
+ *
+ * @param cc    the Streebog-256 context
+ * @param dst   the destination buffer
+ */
+void sph_gost256_close(void *cc, void *dst);
+
+/**
+ * Hash a complete message with Streebog-256 and write the result (32 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_gost256_oneshot(const void *data, size_t len, void *dst);
+
+/**
+ * Compute Streebog-256 over exactly 64 bytes of input (a common case
+ * for chained hash constructions, where the input is the output of a
+ * 512-bit hash function). The result is the same as with
+ * <code>sph_gost256_init()</code>, <code>sph_gost256()</code> and
+ * <code>sph_gost256_close()</code>, but no context is needed, and the
+ * processing of the first block starts from a precomputed key schedule.
+ *
+ * @param data   the input data (64 bytes)
+ * @param dst    the destination buffer (32 bytes)
+ */
+void sph_gost256_hash64(const void *data, void *dst);
+
+/**
+ * Initialize a Streebog-512 context. This process performs no memory
+ * allocation.
+ *
+ * @param cc   the Streebog-512 context (pointer to a
+ *             <code>sph_gost512_context</code>)
+ */
+void sph_gost512_init(void *cc);
+
+/**
+ * Process some data bytes. It is acceptable that <code>len</code> is zero
+ * (in which case this function does nothing).
+ *
+ * @param cc     the Streebog-512 context
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ */
+void sph_gost512(void *cc, const void *data, size_t len);
+
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_gost512()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Streebog-512 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_gost512_updatev(void *cc, const sph_iovec *iov, int n);
+
+/**
+ * Terminate the current Streebog-512 computation and output the result
+ * into the provided buffer. The destination buffer must be wide enough
+ * to accomodate the result (64 bytes). The context is automatically
+ * reinitialized.
+ *
+ * @param cc    the Streebog-512 context
+ * @param dst   the destination buffer
+ */
+void sph_gost512_close(void *cc, void *dst);
+
+/**
+ * Hash a complete message with Streebog-512 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_gost512_oneshot(const void *data, size_t len, void *dst);
+
+/**
+ * Compute Streebog-512 over exactly 64 bytes of input. This is the
+ * Streebog-512 counterpart of <code>sph_gost256_hash64()</code>.
+ *
+ * @param data   the input data (64 bytes)
+ * @param dst    the destination buffer (64 bytes)
+ */
+void sph_gost512_hash64(const void *data, void *dst);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
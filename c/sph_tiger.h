@@ -95,6 +95,18 @@ void sph_tiger_init(void *cc);
  */
 void sph_tiger(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_tiger()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Tiger context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_tiger_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current Tiger computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -106,6 +118,20 @@ void sph_tiger(void *cc, const void *data, size_t len);
  */
 void sph_tiger_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Tiger and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_tiger_oneshot(const void *data, size_t len, void *dst);
+
 /**
  * Apply the Tiger compression function on the provided data. The
  * <code>msg</code> parameter contains the 8 64-bit input blocks,
@@ -152,10 +178,23 @@ void sph_tiger2_init(void *cc);
  * @param len    the input data length (in bytes)
  */
 void sph_tiger2(void *cc, const void *data, size_t len);
+
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_tiger2()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the Tiger2 context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_tiger2_updatev(void *cc, const sph_iovec *iov, int n);
 #endif
 
 #ifndef DOXYGEN_IGNORE
 #define sph_tiger2   sph_tiger
+#define sph_tiger2_updatev   sph_tiger_updatev
 #endif
 
 /**
@@ -171,6 +210,20 @@ void sph_tiger2(void *cc, const void *data, size_t len);
  */
 void sph_tiger2_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with Tiger2 and write the result (24 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_tiger2_oneshot(const void *data, size_t len, void *dst);
+
 #ifdef DOXYGEN_IGNORE
 /**
  * Apply the Tiger2 compression function, which is identical to the Tiger
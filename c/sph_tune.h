@@ -0,0 +1,151 @@
+/* $Id$ */
+/**
+ * Auto-tuning of implementation variants.
+ *
+ * Some implementations have build macros which select between code
+ * variants (table sizes, 32-bit or 64-bit words, unrolling), and the
+ * fastest choice depends on the processor and on the cache situation.
+ * For ECHO, Groestl, Hamsi, JH and Keccak, the library contains the
+ * default code and, under suffixed names, the alternative variants
+ * (compiled from the <code>variant_*.c</code> files):
+ *
+ *  - ECHO: <code>32</code> (<code>SPH_ECHO_64 = 0</code>)
+ *  - Groestl: <code>small</code>, <code>32</code> and
+ *    <code>small32</code> (<code>SPH_SMALL_FOOTPRINT_GROESTL</code>
+ *    and <code>SPH_GROESTL_64</code>)
+ *  - Hamsi: <code>small</code> (<code>SPH_SMALL_FOOTPRINT_HAMSI</code>)
+ *  - JH: <code>32</code> and <code>small</code> (<code>SPH_JH_64</code>,
+ *    <code>SPH_SMALL_FOOTPRINT_JH</code>)
+ *  - Keccak: <code>u2</code>, <code>full</code>, <code>copy</code> and
+ *    <code>32</code> (<code>SPH_KECCAK_UNROLL</code>,
+ *    <code>SPH_KECCAK_NOCOPY</code>, <code>SPH_KECCAK_64</code>)
+ *
+ * The variants are built from the portable code only: the vector
+ * kernels, which the default code selects at runtime, ignore these
+ * macros. On x86 processors, the tuner thus weighs the default vector
+ * code (where there is some) against the portable variants.
+ *
+ * The tuner measures all the variants of each function for each
+ * message size class, and binds the fastest one to
+ * <code>sph_tune_hash()</code>. The result may be saved as a per-host
+ * profile and loaded later. The streaming functions
+ * (<code>sph_keccak256()</code>...) always use the default code, since
+ * a context must be processed by the variant which initialized it.
+ *
+ * The <code>speed</code> tool runs the tuner with its
+ * <code>-tune</code> option.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ *
+ * @file     sph_tune.h
+ */
+
+#ifndef SPH_TUNE_H__
+#define SPH_TUNE_H__
+
+#include <stddef.h>
+#include "sph_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if SPH_64
+
+#include "sph_batch.h"
+
+/**
+ * Number of message size classes: up to 64 bytes, up to 1 kB, up to
+ * 16 kB, and longer messages.
+ */
+#define SPH_TUNE_CLASSES   4
+
+/**
+ * Measure all the variants of the tunable functions, for each message
+ * size class, and bind the fastest ones. This takes a few seconds (the
+ * CPU time of the calling thread is measured, where the platform
+ * offers it). It should not run concurrently with <code>sph_tune_hash()</code>
+ * (which then uses either the old or the new choice).
+ */
+void sph_tune_run(void);
+
+/**
+ * Save the current choices as a profile file for this host (identified
+ * by its name and the detected processor features).
+ *
+ * @param path   the profile file name
+ * @return  1 on success, 0 on error
+ */
+int sph_tune_save(const char *path);
+
+/**
+ * Load the choices from a profile file. Nothing is changed, and 0 is
+ * returned, if the file cannot be read or was written on another host
+ * (or with other processor features); unknown entries are ignored.
+ *
+ * @param path   the profile file name
+ * @return  1 on success, 0 on error
+ */
+int sph_tune_load(const char *path);
+
+/**
+ * Hash a message with the variant bound to the function and to the
+ * length of the message. The function is one of the
+ * <code>SPH_HASH_*</code> identifiers; functions without variants use
+ * their default code. On the first call, if no choice has been made
+ * yet, the profile named by the <code>SPH_TUNE_PROFILE</code>
+ * environment variable is loaded; if there is none, or it does not
+ * match the host, the tuner runs, and its result is saved to that file
+ * (if the variable is set). That first call thus may take a few
+ * seconds; applications which care about latency should call
+ * <code>sph_tune_load()</code> or <code>sph_tune_run()</code>
+ * beforehand, e.g. at startup.
+ *
+ * @param alg    the function identifier
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_tune_hash(unsigned alg, const void *data, size_t len, void *dst);
+
+/**
+ * Get the name of the variant bound to a function for a message length
+ * (<code>"default"</code> for the default code), or <code>NULL</code>
+ * if the function has no variants.
+ *
+ * @param alg   the function identifier
+ * @param len   the message length (in bytes)
+ * @return  the variant name, or <code>NULL</code>
+ */
+const char *sph_tune_variant(unsigned alg, size_t len);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1177,6 +1177,23 @@ typedef long long sph_s64;
 #error SPH_UPTR defined, but endianness is not known.
 #endif
 
+/*
+ * SPH_DIRECT_INPUT(p, w) is non-zero when the input bytes at address p
+ * may be decoded in place with the sph_dec*_aligned() functions for
+ * w-byte words (w is 4 or 8). The update functions use it to compress
+ * full blocks straight from the caller's buffer; only partial blocks
+ * are copied into the context. When the endianness is unknown, the
+ * "aligned" decoding functions read bytes one by one and accept any
+ * address.
+ */
+#if SPH_UNALIGNED || !(SPH_LITTLE_ENDIAN || SPH_BIG_ENDIAN)
+#define SPH_DIRECT_INPUT(p, w)   1
+#elif defined SPH_UPTR
+#define SPH_DIRECT_INPUT(p, w)   (((SPH_UPTR)(p) & ((w) - 1)) == 0)
+#else
+#define SPH_DIRECT_INPUT(p, w)   0
+#endif
+
 #if SPH_I386_GCC && !SPH_NO_ASM
 
 /*
@@ -1973,4 +1990,61 @@ sph_dec64le_aligned(const void *src)
 
 #endif /* Doxygen excluded block */
 
+/* ============ Scatter-gather input ============ */
+
+#include <stddef.h>
+
+#if !defined SPH_NO_IOVEC && (defined __unix__ || defined __unix \
+	|| (defined __APPLE__ && defined __MACH__))
+#include <sys/uio.h>
+
+/**
+ * One fragment of input data for the <code>sph_*_updatev()</code>
+ * functions: <code>iov_len</code> bytes at <code>iov_base</code>. On
+ * POSIX systems this is the <code>struct iovec</code> type from
+ * <code>&lt;sys/uio.h&gt;</code>, so that the buffer chains used with
+ * <code>readv()</code> and <code>writev()</code> can be hashed
+ * directly; elsewhere, it is a structure with the same field names.
+ */
+typedef struct iovec sph_iovec;
+
+#else
+
+typedef struct {
+	void *iov_base;
+	size_t iov_len;
+} sph_iovec;
+
+#endif
+
+#ifndef DOXYGEN_IGNORE
+
+/*
+ * Body of the sph_*_updatev() functions: the fragments are fed in
+ * order to the update function of the family. The update functions
+ * compress the full blocks of each fragment in place, so only the
+ * blocks which straddle a fragment boundary are assembled in the
+ * context buffer.
+ */
+#define SPH_UPDATEV(update, cc, iov, n)   do { \
+		const sph_iovec *sph_v = (iov); \
+		int sph_k; \
+		for (sph_k = (n); sph_k > 0; sph_k --, sph_v ++) \
+			if (sph_v->iov_len > 0) \
+				update(cc, sph_v->iov_base, sph_v->iov_len); \
+	} while (0)
+
+/*
+ * Body of the sph_*_oneshot() functions which have no dedicated short
+ * message path: a context is used for the duration of the call.
+ */
+#define SPH_ONESHOT(name, data, len, dst)   do { \
+		sph_ ## name ## _context sph_cc; \
+		sph_ ## name ## _init(&sph_cc); \
+		sph_ ## name(&sph_cc, data, len); \
+		sph_ ## name ## _close(&sph_cc, dst); \
+	} while (0)
+
+#endif
+
 #endif
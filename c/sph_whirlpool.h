@@ -113,6 +113,18 @@ void sph_whirlpool_init(void *cc);
  */
 void sph_whirlpool(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_whirlpool()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the WHIRLPOOL context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_whirlpool_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current WHIRLPOOL computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -124,6 +136,42 @@ void sph_whirlpool(void *cc, const void *data, size_t len);
  */
 void sph_whirlpool_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with WHIRLPOOL and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_whirlpool_oneshot(const void *data, size_t len, void *dst);
+
+/**
+ * Compute WHIRLPOOL over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_whirlpool_init()</code>, <code>sph_whirlpool()</code> and
+ * <code>sph_whirlpool_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * With AVX2, messages are processed by pairs, one in each 128-bit
+ * half of the vector registers; this is faster than hashing the
+ * messages one by one. Otherwise, the messages are simply hashed in
+ * sequence.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_whirlpool_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * WHIRLPOOL-0 uses the same structure than plain WHIRLPOOL.
  */
@@ -155,6 +203,18 @@ void sph_whirlpool0_init(void *cc);
  */
 void sph_whirlpool0(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_whirlpool0()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the WHIRLPOOL context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_whirlpool0_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current WHIRLPOOL-0 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -166,6 +226,37 @@ void sph_whirlpool0(void *cc, const void *data, size_t len);
  */
 void sph_whirlpool0_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with WHIRLPOOL-0 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_whirlpool0_oneshot(const void *data, size_t len, void *dst);
+
+/**
+ * Compute WHIRLPOOL-0 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_whirlpool0_init()</code>, <code>sph_whirlpool0()</code> and
+ * <code>sph_whirlpool0_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_whirlpool0_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 /**
  * WHIRLPOOL-1 uses the same structure than plain WHIRLPOOL.
  */
@@ -197,6 +288,18 @@ void sph_whirlpool1_init(void *cc);
  */
 void sph_whirlpool1(void *cc, const void *data, size_t len);
 
+/**
+ * Process data given as <code>n</code> fragments, in order. This is
+ * equivalent to calling <code>sph_whirlpool1()</code> on each fragment, but
+ * full blocks are read in place and only the blocks which straddle
+ * fragment boundaries are assembled in the context buffer.
+ *
+ * @param cc    the WHIRLPOOL context
+ * @param iov   the input fragments
+ * @param n     the number of fragments
+ */
+void sph_whirlpool1_updatev(void *cc, const sph_iovec *iov, int n);
+
 /**
  * Terminate the current WHIRLPOOL-1 computation and output the result into the
  * provided buffer. The destination buffer must be wide enough to
@@ -208,6 +311,37 @@ void sph_whirlpool1(void *cc, const void *data, size_t len);
  */
 void sph_whirlpool1_close(void *cc, void *dst);
 
+/**
+ * Hash a complete message with WHIRLPOOL-1 and write the result (64 bytes)
+ * into <code>dst</code>. This is equivalent to the init, update and close
+ * sequence on a context, without requiring one from the caller. A
+ * message which fits in a single block along with its padding is
+ * processed with one call to the compression function, the padded
+ * block being built on the stack.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer
+ */
+void sph_whirlpool1_oneshot(const void *data, size_t len, void *dst);
+
+/**
+ * Compute WHIRLPOOL-1 over <code>num</code> independent messages.
+ * Message <code>i</code> is <code>len[i]</code> bytes at
+ * <code>data[i]</code>; its hash value (64 bytes) is written at
+ * <code>dst[i]</code>. The output is identical to what
+ * <code>sph_whirlpool1_init()</code>, <code>sph_whirlpool1()</code> and
+ * <code>sph_whirlpool1_close()</code> compute for each message; no
+ * context is needed.
+ *
+ * @param data   the input messages
+ * @param len    the input message lengths (in bytes)
+ * @param dst    the destination buffers
+ * @param num    the number of messages
+ */
+void sph_whirlpool1_multi(const void *const *data, const size_t *len,
+	void *const *dst, size_t num);
+
 #endif
 
 #endif
@@ -0,0 +1,364 @@
+/* $Id$ */
+/*
+ * Usage statistics per hash function family.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sph_stats.h"
+
+#if SPH_64
+
+static const char *const stats_names[SPH_STATS_NUM] = {
+	"blake", "bmw", "cubehash", "echo", "fugue", "gost", "groestl",
+	"hamsi", "haval", "jh", "keccak", "luffa", "md2", "md4", "md5",
+	"panama", "radiogatun", "ripemd", "sha0", "sha1", "sha2",
+	"shabal", "shavite", "simd", "skein", "streebog", "tiger",
+	"whirlpool"
+};
+
+/* see sph_stats.h */
+const char *
+sph_stats_name(unsigned fam)
+{
+	return fam < SPH_STATS_NUM ? stats_names[fam] : NULL;
+}
+
+#if SPH_STATS
+
+#if !SPH_NO_THREADS && (defined __unix__ || defined __unix \
+	|| (defined __APPLE__ && defined __MACH__))
+#define STATS_THREADS   1
+#include <pthread.h>
+#else
+#define STATS_THREADS   0
+#endif
+
+/*
+ * Counters of one thread. Each area is allocated on its own and
+ * aligned on 64 bytes (the counters for a family fill four cache
+ * lines), so that no two threads write to the same line. Areas of
+ * running threads are linked from stats_list; when a thread exits,
+ * its counts are added to stats_retired and its area is released.
+ * Without threads, a single static area is used.
+ */
+typedef struct stats_area_ stats_area;
+
+struct stats_area_ {
+	sph_stats_counters c[SPH_STATS_NUM];
+	stats_area *next;
+	void *mem;
+};
+
+/*
+ * Each counter is written by its own thread only (and cleared by
+ * sph_stats_reset()), and read by sph_stats_get() from any thread.
+ * Relaxed atomic accesses make these reads well-defined (no torn
+ * values) at no cost on common platforms; a plain read-modify-write
+ * is enough for the single writer.
+ */
+#if defined __ATOMIC_RELAXED
+#define STATS_LOAD(x)       __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STATS_STORE(x, v)   __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define STATS_LOAD(x)       (x)
+#define STATS_STORE(x, v)   ((x) = (v))
+#endif
+#define STATS_ADD(x, v)     STATS_STORE(x, STATS_LOAD(x) + (v))
+
+volatile int sph_stats_on = 0;
+
+static SPH_STATS_TLS stats_area *stats_self;
+static stats_area *stats_list;
+static stats_area stats_retired;
+
+#if STATS_THREADS
+
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t stats_key;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+
+#define LOCK()     pthread_mutex_lock(&stats_lock)
+#define UNLOCK()   pthread_mutex_unlock(&stats_lock)
+
+static void
+stats_add(stats_area *dst, const stats_area *src)
+{
+	unsigned f, k;
+
+	for (f = 0; f < SPH_STATS_NUM; f ++) {
+		sph_stats_counters *d;
+		const sph_stats_counters *s;
+
+		d = &dst->c[f];
+		s = &src->c[f];
+		STATS_ADD(d->calls, s->calls);
+		STATS_ADD(d->bytes, s->bytes);
+		STATS_ADD(d->blocks, s->blocks);
+		for (k = 0; k < SPH_STATS_HIST; k ++)
+			STATS_ADD(d->hist[k], s->hist[k]);
+	}
+}
+
+/*
+ * Thread exit: keep the counts and release the area. Hash functions may
+ * still run on this thread (e.g. in destructors of keys which come
+ * after this one); their counts go to the retired area, as if the
+ * allocation had failed.
+ */
+static void
+stats_detach(void *arg)
+{
+	stats_area *a, **pp;
+
+	a = arg;
+	LOCK();
+	for (pp = &stats_list; *pp != NULL; pp = &(*pp)->next) {
+		if (*pp == a) {
+			*pp = a->next;
+			break;
+		}
+	}
+	stats_add(&stats_retired, a);
+	UNLOCK();
+	stats_self = &stats_retired;
+	free(a->mem);
+}
+
+static void
+stats_key_init(void)
+{
+	pthread_key_create(&stats_key, &stats_detach);
+}
+
+/*
+ * First count made by the current thread: allocate its area. If the
+ * allocation fails, the counts of the thread go to the retired area
+ * (they are then not protected against concurrent updates).
+ */
+static stats_area *
+stats_attach(void)
+{
+	void *mem;
+	stats_area *a;
+
+	pthread_once(&stats_once, &stats_key_init);
+	mem = malloc(sizeof(stats_area) + 63);
+	if (mem == NULL) {
+		stats_self = &stats_retired;
+		return stats_self;
+	}
+#ifdef SPH_UPTR
+	a = (stats_area *)((unsigned char *)mem
+		+ ((64 - ((SPH_UPTR)mem & 63)) & 63));
+#else
+	a = mem;
+#endif
+	memset(a, 0, sizeof *a);
+	a->mem = mem;
+	LOCK();
+	a->next = stats_list;
+	stats_list = a;
+	UNLOCK();
+	pthread_setspecific(stats_key, a);
+	stats_self = a;
+	return a;
+}
+
+#else
+
+#define LOCK()     ((void)0)
+#define UNLOCK()   ((void)0)
+
+static stats_area *
+stats_attach(void)
+{
+	stats_self = &stats_retired;
+	return stats_self;
+}
+
+#endif
+
+/*
+ * Histogram bucket for an input length.
+ */
+static unsigned
+stats_bucket(size_t len)
+{
+	unsigned k;
+
+	for (k = 0; len != 0 && k < SPH_STATS_HIST - 1; k ++)
+		len >>= 1;
+	return k;
+}
+
+/* see sph_stats.h */
+void
+sph_stats_input(unsigned fam, size_t len)
+{
+	stats_area *a;
+	sph_stats_counters *c;
+
+	a = stats_self;
+	if (a == NULL)
+		a = stats_attach();
+	c = &a->c[fam];
+	STATS_ADD(c->calls, 1);
+	STATS_ADD(c->bytes, len);
+	STATS_ADD(c->hist[stats_bucket(len)], 1);
+}
+
+/* see sph_stats.h */
+void
+sph_stats_bytes(unsigned fam, size_t len)
+{
+	stats_area *a;
+
+	a = stats_self;
+	if (a == NULL)
+		a = stats_attach();
+	STATS_ADD(a->c[fam].bytes, len);
+}
+
+/* see sph_stats.h */
+void
+sph_stats_blocks(unsigned fam, size_t num)
+{
+	stats_area *a;
+
+	a = stats_self;
+	if (a == NULL)
+		a = stats_attach();
+	STATS_ADD(a->c[fam].blocks, num);
+}
+
+/* see sph_stats.h */
+void
+sph_stats_enable(int on)
+{
+	sph_stats_on = (on != 0);
+}
+
+/* see sph_stats.h */
+int
+sph_stats_enabled(void)
+{
+	return sph_stats_on;
+}
+
+/* see sph_stats.h */
+void
+sph_stats_get(unsigned fam, sph_stats_counters *dst)
+{
+	stats_area *a;
+	unsigned k;
+
+	memset(dst, 0, sizeof *dst);
+	if (fam >= SPH_STATS_NUM)
+		return;
+	LOCK();
+	for (a = &stats_retired; a != NULL;
+		a = (a == &stats_retired) ? stats_list : a->next)
+	{
+		const sph_stats_counters *c;
+
+		c = &a->c[fam];
+		dst->calls += STATS_LOAD(c->calls);
+		dst->bytes += STATS_LOAD(c->bytes);
+		dst->blocks += STATS_LOAD(c->blocks);
+		for (k = 0; k < SPH_STATS_HIST; k ++)
+			dst->hist[k] += STATS_LOAD(c->hist[k]);
+	}
+	UNLOCK();
+}
+
+static void
+stats_clear(stats_area *a)
+{
+	unsigned f, k;
+
+	for (f = 0; f < SPH_STATS_NUM; f ++) {
+		sph_stats_counters *c;
+
+		c = &a->c[f];
+		STATS_STORE(c->calls, 0);
+		STATS_STORE(c->bytes, 0);
+		STATS_STORE(c->blocks, 0);
+		for (k = 0; k < SPH_STATS_HIST; k ++)
+			STATS_STORE(c->hist[k], 0);
+	}
+}
+
+/* see sph_stats.h */
+void
+sph_stats_reset(void)
+{
+	stats_area *a;
+
+	LOCK();
+	stats_clear(&stats_retired);
+	for (a = stats_list; a != NULL; a = a->next)
+		stats_clear(a);
+	UNLOCK();
+}
+
+#else
+
+/* see sph_stats.h */
+void
+sph_stats_enable(int on)
+{
+	(void)on;
+}
+
+/* see sph_stats.h */
+int
+sph_stats_enabled(void)
+{
+	return 0;
+}
+
+/* see sph_stats.h */
+void
+sph_stats_get(unsigned fam, sph_stats_counters *dst)
+{
+	(void)fam;
+	memset(dst, 0, sizeof *dst);
+}
+
+/* see sph_stats.h */
+void
+sph_stats_reset(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,1662 @@
+/* $Id$ */
+/*
+ * Streebog implementation (GOST R 34.11-2012).
+ *
+ * The LPS transform (byte substitution, transposition and linear map)
+ * is computed with eight 256-entry tables of 64-bit words, each table
+ * combining all three steps for one input row. The 16 kB of tables
+ * must stay in L1 cache for good performance.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sph_streebog.h"
+#include "sph_stats.h"
+
+#if SPH_64
+
+/*
+ * Iteration constants C_1 to C_12 of the key schedule.
+ */
+static const sph_u64 streebog_C[12][8] = {
+	{
+		SPH_C64(0xDD806559F2A64507), SPH_C64(0x05767436CC744D23),
+		SPH_C64(0xA2422A08A460D315), SPH_C64(0x4B7CE09192676901),
+		SPH_C64(0x714EB88D7585C4FC), SPH_C64(0x2F6A76432E45D016),
+		SPH_C64(0xEBCB2F81C0657C1F), SPH_C64(0xB1085BDA1ECADAE9)
+	},
+	{
+		SPH_C64(0xE679047021B19BB7), SPH_C64(0x55DDA21BD7CBCD56),
+		SPH_C64(0x5CB561C2DB0AA7CA), SPH_C64(0x9AB5176B12D69958),
+		SPH_C64(0x61D55E0F16B50131), SPH_C64(0xF3FEEA720A232B98),
+		SPH_C64(0x4FE39D460F70B5D7), SPH_C64(0x6FA3B58AA99D2F1A)
+	},
+	{
+		SPH_C64(0x991E96F50ABA0AB2), SPH_C64(0xC2B6F443867ADB31),
+		SPH_C64(0xC1C93A376062DB09), SPH_C64(0xD3E20FE490359EB1),
+		SPH_C64(0xF2EA7514B1297B7B), SPH_C64(0x06F15E5F529C1F8B),
+		SPH_C64(0x0A39FC286A3D8435), SPH_C64(0xF574DCAC2BCE2FC7)
+	},
+	{
+		SPH_C64(0x220CBEBC84E3D12E), SPH_C64(0x3453EAA193E837F1),
+		SPH_C64(0xD8B71333935203BE), SPH_C64(0xA9D72C82ED03D675),
+		SPH_C64(0x9D721CAD685E353F), SPH_C64(0x488E857E335C3C7D),
+		SPH_C64(0xF948E1A05D71E4DD), SPH_C64(0xEF1FDFB3E81566D2)
+	},
+	{
+		SPH_C64(0x601758FD7C6CFE57), SPH_C64(0x7A56A27EA9EA63F5),
+		SPH_C64(0xDFFF00B723271A16), SPH_C64(0xBFCD1747253AF5A3),
+		SPH_C64(0x359E35D7800FFFBD), SPH_C64(0x7F151C1F1686104A),
+		SPH_C64(0x9A3F410C6CA92363), SPH_C64(0x4BEA6BACAD474799)
+	},
+	{
+		SPH_C64(0xFA68407A46647D6E), SPH_C64(0xBF71C57236904F35),
+		SPH_C64(0x0AF21F66C2BEC6B6), SPH_C64(0xCFFAA6B71C9AB7B4),
+		SPH_C64(0x187F9AB49AF08EC6), SPH_C64(0x2D66C4F95142A46C),
+		SPH_C64(0x6FA4C33B7A3039C0), SPH_C64(0xAE4FAEAE1D3AD3D9)
+	},
+	{
+		SPH_C64(0x8886564D3A14D493), SPH_C64(0x3517454CA23C4AF3),
+		SPH_C64(0x06476983284A0504), SPH_C64(0x0992ABC52D822C37),
+		SPH_C64(0xD3473E33197A93C9), SPH_C64(0x399EC6C7E6BF87C9),
+		SPH_C64(0x51AC86FEBF240954), SPH_C64(0xF4C70E16EEAAC5EC)
+	},
+	{
+		SPH_C64(0xA47F0DD4BF02E71E), SPH_C64(0x36ACC2355951A8D9),
+		SPH_C64(0x69D18D2BD1A5C42F), SPH_C64(0xF4892BCB929B0690),
+		SPH_C64(0x89B4443B4DDBC49A), SPH_C64(0x4EB7F8719C36DE1E),
+		SPH_C64(0x03E7AA020C6E4141), SPH_C64(0x9B1F5B424D93C9A7)
+	},
+	{
+		SPH_C64(0x7261445183235ADB), SPH_C64(0x0E38DC92CB1F2A60),
+		SPH_C64(0x7B2B8A9AA6079C54), SPH_C64(0x800A440BDBB2CEB1),
+		SPH_C64(0x3CD955B7E00D0984), SPH_C64(0x3A7D3A1B25894224),
+		SPH_C64(0x944C9AD8EC165FDE), SPH_C64(0x378F5A541631229B)
+	},
+	{
+		SPH_C64(0x74B4C7FB98459CED), SPH_C64(0x3698FAD1153BB6C3),
+		SPH_C64(0x7A1E6C303B7652F4), SPH_C64(0x9FE76702AF69334B),
+		SPH_C64(0x1FFFE18A1B336103), SPH_C64(0x8941E71CFF8A78DB),
+		SPH_C64(0x382AE548B2E4F3F3), SPH_C64(0xABBEDEA680056F52)
+	},
+	{
+		SPH_C64(0x6BCAA4CD81F32D1B), SPH_C64(0xDEA2594AC06FD85D),
+		SPH_C64(0xEFBACD1D7D476E98), SPH_C64(0x8A1D71EFEA48B9CA),
+		SPH_C64(0x2001802114846679), SPH_C64(0xD8FA6BBBEBAB0761),
+		SPH_C64(0x3002C6CD635AFE94), SPH_C64(0x7BCD9ED0EFC889FB)
+	},
+	{
+		SPH_C64(0x48BC924AF11BD720), SPH_C64(0xFAF417D5D9B21B99),
+		SPH_C64(0xE71DA4AA88E12852), SPH_C64(0x5D80EF9D1891CC86),
+		SPH_C64(0xF82012D430219F9B), SPH_C64(0xCDA43C32BCDF1D77),
+		SPH_C64(0xD21380B00449B17A), SPH_C64(0x378EE767F11631BA)
+	}
+};
+
+/*
+ * LPS tables: LPS(x) word i is the XOR of T[j][byte i of word j of x],
+ * for j = 0 to 7.
+ */
+static const sph_u64 streebog_T[8][256] = {
+	{
+		SPH_C64(0xD01F715B5C7EF8E6), SPH_C64(0x16FA240980778325),
+		SPH_C64(0xA8A42E857EE049C8), SPH_C64(0x6AC1068FA186465B),
+		SPH_C64(0x6E417BD7A2E9320B), SPH_C64(0x665C8167A437DAAB),
+		SPH_C64(0x7666681AA89617F6), SPH_C64(0x4B959163700BDCF5),
+		SPH_C64(0xF14BE6B78DF36248), SPH_C64(0xC585BD689A625CFF),
+		SPH_C64(0x9557D7FCA67D82CB), SPH_C64(0x89F0B969AF6DD366),
+		SPH_C64(0xB0833D48749F6C35), SPH_C64(0xA1998C23B1ECBC7C),
+		SPH_C64(0x8D70C431AC02A736), SPH_C64(0xD6DFBC2FD0A8B69E),
+		SPH_C64(0x37AEB3E551FA198B), SPH_C64(0x0B7D128A40B5CF9C),
+		SPH_C64(0x5A8F2008B5780CBC), SPH_C64(0xEDEC882284E333E5),
+		SPH_C64(0xD25FC177D3C7C2CE), SPH_C64(0x5E0F5D50B61778EC),
+		SPH_C64(0x1D873683C0C24CB9), SPH_C64(0xAD040BCBB45D208C),
+		SPH_C64(0x2F89A0285B853C76), SPH_C64(0x5732FFF6791B8D58),
+		SPH_C64(0x3E9311439EF6EC3F), SPH_C64(0xC9183A809FD3C00F),
+		SPH_C64(0x83ADF3F5260A01EE), SPH_C64(0xA6791941F4E8EF10),
+		SPH_C64(0x103AE97D0CA1CD5D), SPH_C64(0x2CE948121DEE1B4A),
+		SPH_C64(0x39738421DBF2BF53), SPH_C64(0x093DA2A6CF0CF5B4),
+		SPH_C64(0xCD9847D89CBCB45F), SPH_C64(0xF9561C078B2D8AE8),
+		SPH_C64(0x9C6A755A6971777F), SPH_C64(0xBC1EBAA0712EF0C5),
+		SPH_C64(0x72E61542ABF963A6), SPH_C64(0x78BB5FDE229EB12E),
+		SPH_C64(0x14BA94250FCEB90D), SPH_C64(0x844D6697630E5282),
+		SPH_C64(0x98EA08026A1E032F), SPH_C64(0xF06BBEA144217F5C),
+		SPH_C64(0xDB6263D11CCB377A), SPH_C64(0x641C314B2B8EE083),
+		SPH_C64(0x320E96AB9B4770CF), SPH_C64(0x1EE7DEB986A96B85),
+		SPH_C64(0xE96CF57A878C47B5), SPH_C64(0xFDD6615F8842FEB8),
+		SPH_C64(0xC83862965601DD1B), SPH_C64(0x2EA9F83E92572162),
+		SPH_C64(0xF876441142FF97FC), SPH_C64(0xEB2C455608357D9D),
+		SPH_C64(0x5612A7E0B0C9904C), SPH_C64(0x6C01CBFB2D500823),
+		SPH_C64(0x4548A6A7FA037A2D), SPH_C64(0xABC4C6BF388B6EF4),
+		SPH_C64(0xBADE77D4FDF8BEBD), SPH_C64(0x799B07C8EB4CAC3A),
+		SPH_C64(0x0C9D87E805B19CF0), SPH_C64(0xCB588AAC106AFA27),
+		SPH_C64(0xEA0C1D40C1E76089), SPH_C64(0x2869354A1E816F1A),
+		SPH_C64(0xFF96D17307FBC490), SPH_C64(0x9F0A9D602F1A5043),
+		SPH_C64(0x96373FC6E016A5F7), SPH_C64(0x5292DAB8B3A6E41C),
+		SPH_C64(0x9B8AE0382C752413), SPH_C64(0x4F15EC3B7364A8A5),
+		SPH_C64(0x3FB349555724F12B), SPH_C64(0xC7C50D4415DB66D7),
+		SPH_C64(0x92B7429EE379D1A7), SPH_C64(0xD37F99611A15DFDA),
+		SPH_C64(0x231427C05E34A086), SPH_C64(0xA439A96D7B51D538),
+		SPH_C64(0xB403401077F01865), SPH_C64(0xDDA2AEA5901D7902),
+		SPH_C64(0x0A5D4A9C8967D288), SPH_C64(0xC265280ADF660F93),
+		SPH_C64(0x8BB0094520D4E94E), SPH_C64(0x2A29856691385532),
+		SPH_C64(0x42A833C5BF072941), SPH_C64(0x73C64D54622B7EB2),
+		SPH_C64(0x07E095624504536C), SPH_C64(0x8A905153E906F45A),
+		SPH_C64(0x6F6123C16B3B2F1F), SPH_C64(0xC6E55552DC097BC3),
+		SPH_C64(0x4468FEB133D16739), SPH_C64(0xE211E7F0C7398829),
+		SPH_C64(0xA2F96419F7879B40), SPH_C64(0x19074BDBC3AD38E9),
+		SPH_C64(0xF4EBC3F9474E0B0C), SPH_C64(0x43886BD376D53455),
+		SPH_C64(0xD8028BEB5AA01046), SPH_C64(0x51F23282F5CDC320),
+		SPH_C64(0xE7B1C2BE0D84E16D), SPH_C64(0x081DFAB006DEE8A0),
+		SPH_C64(0x3B33340D544B857B), SPH_C64(0x7F5BCABC679AE242),
+		SPH_C64(0x0EDD37C48A08A6D8), SPH_C64(0x81ED43D9A9B33BC6),
+		SPH_C64(0xB1A3655EBD4D7121), SPH_C64(0x69A1EEB5E7ED6167),
+		SPH_C64(0xF6AB73D5C8F73124), SPH_C64(0x1A67A3E185C61FD5),
+		SPH_C64(0x2DC91004D43C065E), SPH_C64(0x0240B02C8FB93A28),
+		SPH_C64(0x90F7F2B26CC0EB8F), SPH_C64(0x3CD3A16F114FD617),
+		SPH_C64(0xAAE49EA9F15973E0), SPH_C64(0x06C0CD748CD64E78),
+		SPH_C64(0xDA423BC7D5192A6E), SPH_C64(0xC345701C16B41287),
+		SPH_C64(0x6D2193EDE4821537), SPH_C64(0xFCF639494190E3AC),
+		SPH_C64(0x7C3B228621F1C57E), SPH_C64(0xFB16AC2B0494B0C0),
+		SPH_C64(0xBF7E529A3745D7F9), SPH_C64(0x6881B6A32E3F7C73),
+		SPH_C64(0xCA78D2BAD9B8E733), SPH_C64(0xBBFE2FC2342AA3A9),
+		SPH_C64(0x0DBDDFFECC6381E4), SPH_C64(0x70A6A56E2440598E),
+		SPH_C64(0xE4D12A844BEFC651), SPH_C64(0x8C509C2765D0BA22),
+		SPH_C64(0xEE8C6018C28814D9), SPH_C64(0x17DA7C1F49A59E31),
+		SPH_C64(0x609C4C1328E194D3), SPH_C64(0xB3E3D57232F44B09),
+		SPH_C64(0x91D7AAA4A512F69B), SPH_C64(0x0FFD6FD243DABBCC),
+		SPH_C64(0x50D26A943C1FDE34), SPH_C64(0x6BE15E9968545B4F),
+		SPH_C64(0x94778FEA6FAF9FDF), SPH_C64(0x2B09DD7058EA4826),
+		SPH_C64(0x677CD9716DE5C7BF), SPH_C64(0x49D5214FFFB2E6DD),
+		SPH_C64(0x0360E83A466B273C), SPH_C64(0x1FC786AF4F7B7691),
+		SPH_C64(0xA0B9D435783EA168), SPH_C64(0xD49F0C035F118CB6),
+		SPH_C64(0x01205816C9D21D14), SPH_C64(0xAC2453DD7D8F3D98),
+		SPH_C64(0x545217CC3F70AA64), SPH_C64(0x26B4028E9489C9C2),
+		SPH_C64(0xDEC2469FD6765E3E), SPH_C64(0x04807D58036F7450),
+		SPH_C64(0xE5F17292823DDB45), SPH_C64(0xF30B569B024A5860),
+		SPH_C64(0x62DCFC3FA758AEFB), SPH_C64(0xE84CAD6C4E5E5AA1),
+		SPH_C64(0xCCB81FCE556EA94B), SPH_C64(0x53B282AE7A74F908),
+		SPH_C64(0x1B47FBF74C1402C1), SPH_C64(0x368EEBF39828049F),
+		SPH_C64(0x7AFBEFF2AD278B06), SPH_C64(0xBE5E0A8CFE97CAED),
+		SPH_C64(0xCFD8F7F413058E77), SPH_C64(0xF78B2BC301252C30),
+		SPH_C64(0x4D555C17FCDD928D), SPH_C64(0x5F2F05467FC565F8),
+		SPH_C64(0x24F4B2A21B30F3EA), SPH_C64(0x860DD6BBECB768AA),
+		SPH_C64(0x4C750401350F8F99), SPH_C64(0x0000000000000000),
+		SPH_C64(0xECCCD0344D312EF1), SPH_C64(0xB5231806BE220571),
+		SPH_C64(0xC105C030990D28AF), SPH_C64(0x653C695DE25CFD97),
+		SPH_C64(0x159ACC33C61CA419), SPH_C64(0xB89EC7F872418495),
+		SPH_C64(0xA9847693B73254DC), SPH_C64(0x58CF90243AC13694),
+		SPH_C64(0x59EFC832F3132B80), SPH_C64(0x5C4FED7C39AE42C4),
+		SPH_C64(0x828DABE3EFD81CFA), SPH_C64(0xD13F294D95ACE5F2),
+		SPH_C64(0x7D1B7A90E823D86A), SPH_C64(0xB643F03CF849224D),
+		SPH_C64(0x3DF3F979D89DCB03), SPH_C64(0x7426D836272F2DDE),
+		SPH_C64(0xDFE21E891FA4432A), SPH_C64(0x3A136C1B9D99986F),
+		SPH_C64(0xFA36F43DCD46ADD4), SPH_C64(0xC025982650DF35BB),
+		SPH_C64(0x856D3E81AADC4F96), SPH_C64(0xC4A5E57E53B041EB),
+		SPH_C64(0x4708168B75BA4005), SPH_C64(0xAF44BBE73BE41AA4),
+		SPH_C64(0x971767D029C4B8E3), SPH_C64(0xB9BE9FEEBB939981),
+		SPH_C64(0x215497ECD18D9AAE), SPH_C64(0x316E7E91DD2C57F3),
+		SPH_C64(0xCEF8AFE2DAD79363), SPH_C64(0x3853DC371220A247),
+		SPH_C64(0x35EE03C9DE4323A3), SPH_C64(0xE6919AA8C456FC79),
+		SPH_C64(0xE05157DC4880B201), SPH_C64(0x7BDBB7E464F59612),
+		SPH_C64(0x127A59518318F775), SPH_C64(0x332ECEBD52956DDB),
+		SPH_C64(0x8F30741D23BB9D1E), SPH_C64(0xD922D3FD93720D52),
+		SPH_C64(0x7746300C61440AE2), SPH_C64(0x25D4EAB4D2E2EEFE),
+		SPH_C64(0x75068020EEFD30CA), SPH_C64(0x135A01474ACAEA61),
+		SPH_C64(0x304E268714FE4AE7), SPH_C64(0xA519F17BB283C82C),
+		SPH_C64(0xDC82F6B359CF6416), SPH_C64(0x5BAF781E7CAA11A8),
+		SPH_C64(0xB2C38D64FB26561D), SPH_C64(0x34CE5BDF17913EB7),
+		SPH_C64(0x5D6FB56AF07C5FD0), SPH_C64(0x182713CD0A7F25FD),
+		SPH_C64(0x9E2AC576E6C84D57), SPH_C64(0x9AAAB82EE5A73907),
+		SPH_C64(0xA3D93C0F3E558654), SPH_C64(0x7E7B92AAAE48FF56),
+		SPH_C64(0x872D8EAD256575BE), SPH_C64(0x41C8DBFFF96C0E7D),
+		SPH_C64(0x99CA5014A3CC1E3B), SPH_C64(0x40E883E930BE1369),
+		SPH_C64(0x1CA76E95091051AD), SPH_C64(0x4E35B42DBAB6B5B1),
+		SPH_C64(0x05A0254ECABD6944), SPH_C64(0xE1710FCA8152AF15),
+		SPH_C64(0xF22B0E8DCB984574), SPH_C64(0xB763A82A319B3F59),
+		SPH_C64(0x63FCA4296E8AB3EF), SPH_C64(0x9D4A2D4CA0A36A6B),
+		SPH_C64(0xE331BFE60EEB953D), SPH_C64(0xD5BF541596C391A2),
+		SPH_C64(0xF5CB9BEF8E9C1618), SPH_C64(0x46284E9DBC685D11),
+		SPH_C64(0x2074CFFA185F87BA), SPH_C64(0xBD3EE2B6B8FCEDD1),
+		SPH_C64(0xAE64E3F1F23607B0), SPH_C64(0xFEB68965CE29D984),
+		SPH_C64(0x55724FDAF6A2B770), SPH_C64(0x29496D5CD753720E),
+		SPH_C64(0xA75941573D3AF204), SPH_C64(0x8E102C0BEA69800A),
+		SPH_C64(0x111AB16BC573D049), SPH_C64(0xD7FFE439197AAB8A),
+		SPH_C64(0xEFAC380E0B5A09CD), SPH_C64(0x48F579593660FBC9),
+		SPH_C64(0x22347FD697E6BD92), SPH_C64(0x61BC1405E13389C7),
+		SPH_C64(0x4AB5C975B9D9C1E1), SPH_C64(0x80CD1BCF606126D2),
+		SPH_C64(0x7186FD78ED92449A), SPH_C64(0x93971A882AABCCB3),
+		SPH_C64(0x88D0E17F66BFCE72), SPH_C64(0x27945A985D5BD4D6)
+	},
+	{
+		SPH_C64(0xDE553F8C05A811C8), SPH_C64(0x1906B59631B4F565),
+		SPH_C64(0x436E70D6B1964FF7), SPH_C64(0x36D343CB8B1E9D85),
+		SPH_C64(0x843DFACC858AAB5A), SPH_C64(0xFDFC95C299BFC7F9),
+		SPH_C64(0x0F634BDEA1D51FA2), SPH_C64(0x6D458B3B76EFB3CD),
+		SPH_C64(0x85C3F77CF8593F80), SPH_C64(0x3C91315FBE737CB2),
+		SPH_C64(0x2148B03366ACE398), SPH_C64(0x18F8B8264C6761BF),
+		SPH_C64(0xC830C1C495C9FB0F), SPH_C64(0x981A76102086A0AA),
+		SPH_C64(0xAA16012142F35760), SPH_C64(0x35CC54060C763CF6),
+		SPH_C64(0x42907D66CC45DB2D), SPH_C64(0x8203D44B965AF4BC),
+		SPH_C64(0x3D6F3CEFC3A0E868), SPH_C64(0xBC73FF69D292BDA7),
+		SPH_C64(0x8722ED0102E20A29), SPH_C64(0x8F8185E8CD34DEB7),
+		SPH_C64(0x9B0561DDA7EE01D9), SPH_C64(0x5335A0193227FAD6),
+		SPH_C64(0xC9CECC74E81A6FD5), SPH_C64(0x54F5832E5C2431EA),
+		SPH_C64(0x99E47BA05D553470), SPH_C64(0xF7BEE756ACD226CE),
+		SPH_C64(0x384E05A5571816FD), SPH_C64(0xD1367452A47D0E6A),
+		SPH_C64(0xF29FDE1C386AD85B), SPH_C64(0x320C77316275F7CA),
+		SPH_C64(0xD0C879E2D9AE9AB0), SPH_C64(0xDB7406C69110EF5D),
+		SPH_C64(0x45505E51A2461011), SPH_C64(0xFC029872E46C5323),
+		SPH_C64(0xFA3CB6F5F7BC0CC5), SPH_C64(0x031F17CD8768A173),
+		SPH_C64(0xBD8DF2D9AF41297D), SPH_C64(0x9D3B4F5AB43E5E3F),
+		SPH_C64(0x4071671B36FEEE84), SPH_C64(0x716207E7D3E3B83D),
+		SPH_C64(0x48D20FF2F9283A1A), SPH_C64(0x27769EB4757CBC7E),
+		SPH_C64(0x5C56EBC793F2E574), SPH_C64(0xA48B474F9EF5DC18),
+		SPH_C64(0x52CBADA94FF46E0C), SPH_C64(0x60C7DA982D8199C6),
+		SPH_C64(0x0E9D466EDC068B78), SPH_C64(0x4EEC2175EAF865FC),
+		SPH_C64(0x550B8E9E21F7A530), SPH_C64(0x6B7BA5BC653FEC2B),
+		SPH_C64(0x5EB7F1BA6949D0DD), SPH_C64(0x57EA94E3DB4C9099),
+		SPH_C64(0xF640EAE6D101B214), SPH_C64(0xDD4A284182C0B0BB),
+		SPH_C64(0xFF1D8FBF6304F250), SPH_C64(0xB8ACCB933BF9D7E8),
+		SPH_C64(0xE8867C478EB68C4D), SPH_C64(0x3F8E2692391BDDC1),
+		SPH_C64(0xCB2FD60912A15A7C), SPH_C64(0xAEC935DBAB983D2F),
+		SPH_C64(0xF55FFD2B56691367), SPH_C64(0x80E2CE366CE1C115),
+		SPH_C64(0x179BF3F8EDB27E1D), SPH_C64(0x01FE0DB07DD394DA),
+		SPH_C64(0xDA8A0B76ECC37B87), SPH_C64(0x44AE53E1DF9584CB),
+		SPH_C64(0xB310B4B77347A205), SPH_C64(0xDFAB323C787B8512),
+		SPH_C64(0x3B511268D070B78E), SPH_C64(0x65E6E3D2B9396753),
+		SPH_C64(0x6864B271E2574D58), SPH_C64(0x259784C98FC789D7),
+		SPH_C64(0x02E11A7DFABB35A9), SPH_C64(0x8841A6DFA337158B),
+		SPH_C64(0x7ADE78C39B5DCDD0), SPH_C64(0xB7CF804D9A2CC84A),
+		SPH_C64(0x20B6BD831B7F7742), SPH_C64(0x75BD331D3A88D272),
+		SPH_C64(0x418F6AAB4B2D7A5E), SPH_C64(0xD9951CBB6BABDAF4),
+		SPH_C64(0xB6318DFDE7FF5C90), SPH_C64(0x1F389B112264AA83),
+		SPH_C64(0x492C024284FBAEC0), SPH_C64(0xE33A0363C608F9A0),
+		SPH_C64(0x2688930408AF28A4), SPH_C64(0xC7538A1A341CE4AD),
+		SPH_C64(0x5DA8E677EE2171AE), SPH_C64(0x8C9E92254A5C7FC4),
+		SPH_C64(0x63D8CD55AAE938B5), SPH_C64(0x29EBD8DAA97A3706),
+		SPH_C64(0x959827B37BE88AA1), SPH_C64(0x1484E4356ADADF6E),
+		SPH_C64(0xA7945082199D7D6B), SPH_C64(0xBF6CE8A455FA1CD4),
+		SPH_C64(0x9CC542EAC9EDCAE5), SPH_C64(0x79C16F0E1C356CA3),
+		SPH_C64(0x89BFAB6FDEE48151), SPH_C64(0xD4174D1830C5F0FF),
+		SPH_C64(0x9258048415EB419D), SPH_C64(0x6139D72850520D1C),
+		SPH_C64(0x6A85A80C18EC78F1), SPH_C64(0xCD11F88E0171059A),
+		SPH_C64(0xCCEFF53E7CA29140), SPH_C64(0xD229639F2315AF19),
+		SPH_C64(0x90B91EF9EF507434), SPH_C64(0x5977D28D074A1BE1),
+		SPH_C64(0x311360FCE51D56B9), SPH_C64(0xC093A92D5A1F2F91),
+		SPH_C64(0x1A19A25BB6DC5416), SPH_C64(0xEB996B8A09DE2D3E),
+		SPH_C64(0xFEE3820F1ED7668A), SPH_C64(0xD7085AD5B7AD518C),
+		SPH_C64(0x7FFF41890FE53345), SPH_C64(0xEC5948BD67DDE602),
+		SPH_C64(0x2FD5F65DBAAA68E0), SPH_C64(0xA5754AFFE32648C2),
+		SPH_C64(0xF8DDAC880D07396C), SPH_C64(0x6FA491468C548664),
+		SPH_C64(0x0C7C5C1326BDBED1), SPH_C64(0x4A33158F03930FB3),
+		SPH_C64(0x699ABFC19F84D982), SPH_C64(0xE4FA2054A80B329C),
+		SPH_C64(0x6707F9AF438252FA), SPH_C64(0x08A368E9CFD6D49E),
+		SPH_C64(0x47B1442C58FD25B8), SPH_C64(0xBBB3DC5EBC91769B),
+		SPH_C64(0x1665FE489061EAC7), SPH_C64(0x33F27A811FA66310),
+		SPH_C64(0x93A609346838D547), SPH_C64(0x30ED6D4C98CEC263),
+		SPH_C64(0x1DD9816CD8DF9F2A), SPH_C64(0x94662A03063B1E7B),
+		SPH_C64(0x83FDD9FBEB896066), SPH_C64(0x7B207573E68E590A),
+		SPH_C64(0x5F49FC0A149A4407), SPH_C64(0x343259B671A5A82C),
+		SPH_C64(0xFBC2BB458A6F981F), SPH_C64(0xC272B350A0A41A38),
+		SPH_C64(0x3AAF1FD8ADA32354), SPH_C64(0x6CBB868B0B3C2717),
+		SPH_C64(0xA2B569C88D2583FE), SPH_C64(0xF180C9D1BF027928),
+		SPH_C64(0xAF37386BD64BA9F5), SPH_C64(0x12BACAB2790A8088),
+		SPH_C64(0x4C0D3B0810435055), SPH_C64(0xB2EEB9070E9436DF),
+		SPH_C64(0xC5B29067CEA7D104), SPH_C64(0xDCB425F1FF132461),
+		SPH_C64(0x4F122CC5972BF126), SPH_C64(0xAC282FA651230886),
+		SPH_C64(0xE7E537992F6393EF), SPH_C64(0xE61B3A2952B00735),
+		SPH_C64(0x709C0A57AE302CE7), SPH_C64(0xE02514AE416058D3),
+		SPH_C64(0xC44C9DD7B37445DE), SPH_C64(0x5A68C5408022BA92),
+		SPH_C64(0x1C278CDCA50C0BF0), SPH_C64(0x6E5A9CF6F18712BE),
+		SPH_C64(0x86DCE0B17F319EF3), SPH_C64(0x2D34EC2040115D49),
+		SPH_C64(0x4BCD183F7E409B69), SPH_C64(0x2815D56AD4A9A3DC),
+		SPH_C64(0x24698979F2141D0D), SPH_C64(0x0000000000000000),
+		SPH_C64(0x1EC696A15FB73E59), SPH_C64(0xD86B110B16784E2E),
+		SPH_C64(0x8E7F8858B0E74A6D), SPH_C64(0x063E2E8713D05FE6),
+		SPH_C64(0xE2C40ED3BBDB6D7A), SPH_C64(0xB1F1AECA89FC97AC),
+		SPH_C64(0xE1DB191E3CB3CC09), SPH_C64(0x6418EE62C4EAF389),
+		SPH_C64(0xC6AD87AA49CF7077), SPH_C64(0xD6F65765CA7EC556),
+		SPH_C64(0x9AFB6C6DDA3D9503), SPH_C64(0x7CE05644888D9236),
+		SPH_C64(0x8D609F95378FEB1E), SPH_C64(0x23A9AA4E9C17D631),
+		SPH_C64(0x6226C0E5D73AAC6F), SPH_C64(0x56149953A69F0443),
+		SPH_C64(0xEEB852C09D66D3AB), SPH_C64(0x2B0AC2A753C102AF),
+		SPH_C64(0x07C023376E03CB3C), SPH_C64(0x2CCAE1903DC2C993),
+		SPH_C64(0xD3D76E2F5EC63BC3), SPH_C64(0x9E2458973356FF4C),
+		SPH_C64(0xA66A5D32644EE9B1), SPH_C64(0x0A427294356DE137),
+		SPH_C64(0x783F62BE61E6F879), SPH_C64(0x1344C70204D91452),
+		SPH_C64(0x5B96C8F0FDF12E48), SPH_C64(0xA90916ECC59BF613),
+		SPH_C64(0xBE92E5142829880E), SPH_C64(0x727D102A548B194E),
+		SPH_C64(0x1BE7AFEBCB0FC0CC), SPH_C64(0x3E702B2244C8491B),
+		SPH_C64(0xD5E940A84D166425), SPH_C64(0x66F9F41F3E51C620),
+		SPH_C64(0xABE80C913F20C3BA), SPH_C64(0xF07EC461C2D1EDF2),
+		SPH_C64(0xF361D3AC45B94C81), SPH_C64(0x0521394A94B8FE95),
+		SPH_C64(0xADD622162CF09C5C), SPH_C64(0xE97871F7F3651897),
+		SPH_C64(0xF4A1F09B2BBA87BD), SPH_C64(0x095D6559B2054044),
+		SPH_C64(0x0BBC7F2448BE75ED), SPH_C64(0x2AF4CF172E129675),
+		SPH_C64(0x157AE98517094BB4), SPH_C64(0x9FDA55274E856B96),
+		SPH_C64(0x914713499283E0EE), SPH_C64(0xB952C623462A4332),
+		SPH_C64(0x74433EAD475B46A8), SPH_C64(0x8B5EB112245FB4F8),
+		SPH_C64(0xA34B6478F0F61724), SPH_C64(0x11A5DD7FFE6221FB),
+		SPH_C64(0xC16DA49D27CCBB4B), SPH_C64(0x76A224D0BDE07301),
+		SPH_C64(0x8AA0BCA2598C2022), SPH_C64(0x4DF336B86D90C48F),
+		SPH_C64(0xEA67663A740DB9E4), SPH_C64(0xEF465F70E0B54771),
+		SPH_C64(0x39B008152ACB8227), SPH_C64(0x7D1E5BF4F55E06EC),
+		SPH_C64(0x105BD0CF83B1B521), SPH_C64(0x775C2960C033E7DB),
+		SPH_C64(0x7E014C397236A79F), SPH_C64(0x811CC386113255CF),
+		SPH_C64(0xEDA7450D1A0E72D8), SPH_C64(0x5889DF3D7A998F3B),
+		SPH_C64(0x2E2BFBEDC779FC3A), SPH_C64(0xCE0EEF438619A4E9),
+		SPH_C64(0x372D4E7BF6CD095F), SPH_C64(0x04DF34FAE96B6A4F),
+		SPH_C64(0xF923A13870D4ADB6), SPH_C64(0xA1AA7E050A4D228D),
+		SPH_C64(0xA8F71B5CB84862C9), SPH_C64(0xB52E9A306097FDE3),
+		SPH_C64(0x0D8251A35B6E2A0B), SPH_C64(0x2257A7FEE1C442EB),
+		SPH_C64(0x73831D9A29588D94), SPH_C64(0x51D4BA64C89CCF7F),
+		SPH_C64(0x502AB7D4B54F5BA5), SPH_C64(0x97793DCE8153BF08),
+		SPH_C64(0xE5042DE4D5D8A646), SPH_C64(0x9687307EFC802BD2),
+		SPH_C64(0xA05473B5779EB657), SPH_C64(0xB4D097801D446939),
+		SPH_C64(0xCFF0E2F3FBCA3033), SPH_C64(0xC38CBEE0DD778EE2),
+		SPH_C64(0x464F499C252EB162), SPH_C64(0xCAD1DBB96F72CEA6),
+		SPH_C64(0xBA4DD1EEC142E241), SPH_C64(0xB00FA37AF42F0376)
+	},
+	{
+		SPH_C64(0xCCE4CD3AA968B245), SPH_C64(0x089D5484E80B7FAF),
+		SPH_C64(0x638246C1B3548304), SPH_C64(0xD2FE0EC8C2355492),
+		SPH_C64(0xA7FBDF7FF2374EEE), SPH_C64(0x4DF1600C92337A16),
+		SPH_C64(0x84E503EA523B12FB), SPH_C64(0x0790BBFD53AB0C4A),
+		SPH_C64(0x198A780F38F6EA9D), SPH_C64(0x2AB30C8F55EC48CB),
+		SPH_C64(0xE0F7FED6B2C49DB5), SPH_C64(0xB6ECF3F422CADBDC),
+		SPH_C64(0x409C9A541358DF11), SPH_C64(0xD3CE8A56DFDE3FE3),
+		SPH_C64(0xC3E9224312C8C1A0), SPH_C64(0x0D6DFA58816BA507),
+		SPH_C64(0xDDF3E1B179952777), SPH_C64(0x04C02A42748BB1D9),
+		SPH_C64(0x94C2ABFF9F2DECB8), SPH_C64(0x4F91752DA8F8ACF4),
+		SPH_C64(0x78682BEFB169BF7B), SPH_C64(0xE1C77A48AF2FF6C4),
+		SPH_C64(0x0C5D7EC69C80CE76), SPH_C64(0x4CC1E4928FD81167),
+		SPH_C64(0xFEED3D24D9997B62), SPH_C64(0x518BB6DFC3A54A23),
+		SPH_C64(0x6DBF2D26151F9B90), SPH_C64(0xB5BC624B05EA664F),
+		SPH_C64(0xE86AAA525ACFE21A), SPH_C64(0x4801CED0FB53A0BE),
+		SPH_C64(0xC91463E6C00868ED), SPH_C64(0x1027A815CD16FE43),
+		SPH_C64(0xF67069A0319204CD), SPH_C64(0xB04CCC976C8ABCE7),
+		SPH_C64(0xC0B9B3FC35E87C33), SPH_C64(0xF380C77C58F2DE65),
+		SPH_C64(0x50BB3241DE4E2152), SPH_C64(0xDF93F490435EF195),
+		SPH_C64(0xF1E0D25D62390887), SPH_C64(0xAF668BFB1A3C3141),
+		SPH_C64(0xBC11B251F00A7291), SPH_C64(0x73A5EED47E427D47),
+		SPH_C64(0x25BEE3F6EE4C3B2E), SPH_C64(0x43CC0BEB34786282),
+		SPH_C64(0xC824E778DDE3039C), SPH_C64(0xF97D86D98A327728),
+		SPH_C64(0xF2B043E24519B514), SPH_C64(0xE297EBF7880F4B57),
+		SPH_C64(0x3A94A49A98FAB688), SPH_C64(0x868516CB68F0C419),
+		SPH_C64(0xEFFA11AF0964EE50), SPH_C64(0xA4AB4EC0D517F37D),
+		SPH_C64(0xA9C6B498547C567A), SPH_C64(0x8E18424F80FBBBB6),
+		SPH_C64(0x0BCDC53BCF2BC23C), SPH_C64(0x137739AAEA3643D0),
+		SPH_C64(0x2C1333EC1BAC2FF0), SPH_C64(0x8D48D3F0A7DB0625),
+		SPH_C64(0x1E1AC3F26B5DE6D7), SPH_C64(0xF520F81F16B2B95E),
+		SPH_C64(0x9F0F6EC450062E84), SPH_C64(0x0130849E1DEB6B71),
+		SPH_C64(0xD45E31AB8C7533A9), SPH_C64(0x652279A2FD14E43F),
+		SPH_C64(0x3209F01E70F1C927), SPH_C64(0xBE71A770CAC1A473),
+		SPH_C64(0x0E3D6BE7A64B1894), SPH_C64(0x7EC8148CFF29D840),
+		SPH_C64(0xCB7476C7FAC3BE0F), SPH_C64(0x72956A4A63A91636),
+		SPH_C64(0x37F95EC21991138F), SPH_C64(0x9E3FEA5A4DED45F5),
+		SPH_C64(0x7B38BA50964902E8), SPH_C64(0x222E580BBDE73764),
+		SPH_C64(0x61E253E0899F55E6), SPH_C64(0xFC8D2805E352AD80),
+		SPH_C64(0x35994BE3235AC56D), SPH_C64(0x09ADD01AF5E014DE),
+		SPH_C64(0x5E8659A6780539C6), SPH_C64(0xB17C48097161D796),
+		SPH_C64(0x026015213ACBD6E2), SPH_C64(0xD1AE9F77E515E901),
+		SPH_C64(0xB7DC776A3F21B0AD), SPH_C64(0xABA6A1B96EB78098),
+		SPH_C64(0x9BCF4486248D9F5D), SPH_C64(0x582666C536455EFD),
+		SPH_C64(0xFDBDAC9BFEB9C6F1), SPH_C64(0xC47999BE4163CDEA),
+		SPH_C64(0x765540081722A7EF), SPH_C64(0x3E548ED8EC710751),
+		SPH_C64(0x3D041F67CB51BAC2), SPH_C64(0x7958AF71AC82D40A),
+		SPH_C64(0x36C9DA5C047A78FE), SPH_C64(0xED9A048E33AF38B2),
+		SPH_C64(0x26EE7249C96C86BD), SPH_C64(0x900281BDEBA65D61),
+		SPH_C64(0x11172C8BD0FD9532), SPH_C64(0xEA0ABF73600434F8),
+		SPH_C64(0x42FC8F75299309F3), SPH_C64(0x34A9CF7D3EB1AE1C),
+		SPH_C64(0x2B838811480723BA), SPH_C64(0x5CE64C8742CEEF24),
+		SPH_C64(0x1ADAE9B01FD6570E), SPH_C64(0x3C349BF9D6BAD1B3),
+		SPH_C64(0x82453C891C7B75C0), SPH_C64(0x97923A40B80D512B),
+		SPH_C64(0x4A61DBF1C198765C), SPH_C64(0xB48CE6D518010D3E),
+		SPH_C64(0xCFB45C858E480FD6), SPH_C64(0xD933CBF30D1E96AE),
+		SPH_C64(0xD70EA014AB558E3A), SPH_C64(0xC189376228031742),
+		SPH_C64(0x9262949CD16D8B83), SPH_C64(0xEB3A3BED7DEF5F89),
+		SPH_C64(0x49314A4EE6B8CBCF), SPH_C64(0xDCC3652F647E4C06),
+		SPH_C64(0xDA635A4C2A3E2B3D), SPH_C64(0x470C21A940F3D35B),
+		SPH_C64(0x315961A157D174B4), SPH_C64(0x6672E81DDA3459AC),
+		SPH_C64(0x5B76F77A1165E36E), SPH_C64(0x445CB01667D36EC8),
+		SPH_C64(0xC5491D205C88A69B), SPH_C64(0x456C34887A3805B9),
+		SPH_C64(0xFFDDB9BAC4721013), SPH_C64(0x99AF51A71E4649BF),
+		SPH_C64(0xA15BE01CBC7729D5), SPH_C64(0x52DB2760E485F7B0),
+		SPH_C64(0x8C78576EBA306D54), SPH_C64(0xAE560F6507D75A30),
+		SPH_C64(0x95F22F6182C687C9), SPH_C64(0x71C5FBF54489ABA5),
+		SPH_C64(0xCA44F259E728D57E), SPH_C64(0x88B87D2CCEBBDC8D),
+		SPH_C64(0xBAB18D32BE4A15AA), SPH_C64(0x8BE8EC93E99B611E),
+		SPH_C64(0x17B713E89EBDF209), SPH_C64(0xB31C5D284BAA0174),
+		SPH_C64(0xEECA9531148F8521), SPH_C64(0xB8D198138481C348),
+		SPH_C64(0x8988F9B2D350B7FC), SPH_C64(0xB9E11C8D996AA839),
+		SPH_C64(0x5A4673E40C8E881F), SPH_C64(0x1687977683569978),
+		SPH_C64(0xBF4123EED72ACF02), SPH_C64(0x4EA1F1B3B513C785),
+		SPH_C64(0xE767452BE16F91FF), SPH_C64(0x7505D1B730021A7C),
+		SPH_C64(0xA59BCA5EC8FC980C), SPH_C64(0xAD069EDA20F7E7A3),
+		SPH_C64(0x38F4B1BBA231606A), SPH_C64(0x60D2D77E94743E97),
+		SPH_C64(0x9AFFC0183966F42C), SPH_C64(0x248E6768F3A7505F),
+		SPH_C64(0xCDD449A4B483D934), SPH_C64(0x87B59255751BAF68),
+		SPH_C64(0x1BEA6D2E023D3C7F), SPH_C64(0x6B1F12455B5FFCAB),
+		SPH_C64(0x743555292DE9710D), SPH_C64(0xD8034F6D10F5FDDF),
+		SPH_C64(0xC6198C9F7BA81B08), SPH_C64(0xBB8109ACA3A17EDB),
+		SPH_C64(0xFA2D1766AD12CABB), SPH_C64(0xC729080166437079),
+		SPH_C64(0x9C5FFF7B77269317), SPH_C64(0x0000000000000000),
+		SPH_C64(0x15D706C9A47624EB), SPH_C64(0x6FDF38072FD44D72),
+		SPH_C64(0x5FB6DD3865EE52B7), SPH_C64(0xA33BF53D86BCFF37),
+		SPH_C64(0xE657C1B5FC84FA8E), SPH_C64(0xAA962527735CEBE9),
+		SPH_C64(0x39C43525BFDA0B1B), SPH_C64(0x204E4D2A872CE186),
+		SPH_C64(0x7A083ECE8BA26999), SPH_C64(0x554B9C9DB72EFBFA),
+		SPH_C64(0xB22CD9B656416A05), SPH_C64(0x96A2BEDEA5E63A5A),
+		SPH_C64(0x802529A826B0A322), SPH_C64(0x8115AD363B5BC853),
+		SPH_C64(0x8375B81701901EB1), SPH_C64(0x3069E53F4A3A1FC5),
+		SPH_C64(0xBD2136CFEDE119E0), SPH_C64(0x18BAFC91251D81EC),
+		SPH_C64(0x1D4A524D4C7D5B44), SPH_C64(0x05F0AEDC6960DAA8),
+		SPH_C64(0x29E39D3072CCF558), SPH_C64(0x70F57F6B5962C0D4),
+		SPH_C64(0x989FD53903AD22CE), SPH_C64(0xF84D024797D91C59),
+		SPH_C64(0x547B1803AAC5908B), SPH_C64(0xF0D056C37FD263F6),
+		SPH_C64(0xD56EB535919E58D8), SPH_C64(0x1C7AD6D351963035),
+		SPH_C64(0x2E7326CD2167F912), SPH_C64(0xAC361A443D1C8CD2),
+		SPH_C64(0x697F076461942A49), SPH_C64(0x4B515F6FDC731D2D),
+		SPH_C64(0x8AD8680DF4700A6F), SPH_C64(0x41AC1ECA0EB3B460),
+		SPH_C64(0x7D988533D80965D3), SPH_C64(0xA8F6300649973D0B),
+		SPH_C64(0x7765C4960AC9CC9E), SPH_C64(0x7CA801ADC5E20EA2),
+		SPH_C64(0xDEA3700E5EB59AE4), SPH_C64(0xA06B6482A19C42A4),
+		SPH_C64(0x6A2F96DB46B497DA), SPH_C64(0x27DEF6D7D487EDCC),
+		SPH_C64(0x463CA5375D18B82A), SPH_C64(0xA6CB5BE1EFDC259F),
+		SPH_C64(0x53EBA3FEF96E9CC1), SPH_C64(0xCE84D81B93A364A7),
+		SPH_C64(0xF4107C810B59D22F), SPH_C64(0x333974806D1AA256),
+		SPH_C64(0x0F0DEF79BBA073E5), SPH_C64(0x231EDC95A00C5C15),
+		SPH_C64(0xE437D494C64F2C6C), SPH_C64(0x91320523F64D3610),
+		SPH_C64(0x67426C83C7DF32DD), SPH_C64(0x6EEFBC99323F2603),
+		SPH_C64(0x9D6F7BE56ACDF866), SPH_C64(0x5916E25B2BAE358C),
+		SPH_C64(0x7FF89012E2C2B331), SPH_C64(0x035091BF2720BD93),
+		SPH_C64(0x561B0D22900E4669), SPH_C64(0x28D319AE6F279E29),
+		SPH_C64(0x2F43A2533C8C9263), SPH_C64(0xD09E1BE9F8FE8270),
+		SPH_C64(0xF740ED3E2C796FBC), SPH_C64(0xDB53DED237D5404C),
+		SPH_C64(0x62B2C25FAEBFE875), SPH_C64(0x0AFD41A5D2C0A94D),
+		SPH_C64(0x6412FD3CE0FF8F4E), SPH_C64(0xE3A76F6995E42026),
+		SPH_C64(0x6C8FA9B808F4F0E1), SPH_C64(0xC2D9A6DD0F23AAD1),
+		SPH_C64(0x8F28C6D19D10D0C7), SPH_C64(0x85D587744FD0798A),
+		SPH_C64(0xA20B71A39B579446), SPH_C64(0x684F83FA7C7F4138),
+		SPH_C64(0xE507500ADBA4471D), SPH_C64(0x3F640A46F19A6C20),
+		SPH_C64(0x1247BD34F7DD28A1), SPH_C64(0x2D23B77206474481),
+		SPH_C64(0x93521002CC86E0F2), SPH_C64(0x572B89BC8DE52D18),
+		SPH_C64(0xFB1D93F8B0F9A1CA), SPH_C64(0xE95A2ECC4724896B),
+		SPH_C64(0x3BA420048511DDF9), SPH_C64(0xD63E248AB6BEE54B),
+		SPH_C64(0x5DD6C8195F258455), SPH_C64(0x06A03F634E40673B),
+		SPH_C64(0x1F2A476C76B68DA6), SPH_C64(0x217EC9B49AC78AF7),
+		SPH_C64(0xECAA80102E4453C3), SPH_C64(0x14E78257B99D4F9A)
+	},
+	{
+		SPH_C64(0x20329B2CC87BBA05), SPH_C64(0x4F5EB6F86546A531),
+		SPH_C64(0xD4F44775F751B6B1), SPH_C64(0x8266A47B850DFA8B),
+		SPH_C64(0xBB986AA15A6CA985), SPH_C64(0xC979EB08F9AE0F99),
+		SPH_C64(0x2DA6F447A2375EA1), SPH_C64(0x1E74275DCD7D8576),
+		SPH_C64(0xBC20180A800BC5F8), SPH_C64(0xB4A2F701B2DC65BE),
+		SPH_C64(0xE726946F981B6D66), SPH_C64(0x48E6C453BF21C94C),
+		SPH_C64(0x42CAD9930F0A4195), SPH_C64(0xEFA47B64AACCCD20),
+		SPH_C64(0x71180A8960409A42), SPH_C64(0x8BB3329BF6A44E0C),
+		SPH_C64(0xD34C35DE2D36DACC), SPH_C64(0xA92F5B7CBC23DC96),
+		SPH_C64(0xB31A85AA68BB09C3), SPH_C64(0x13E04836A73161D2),
+		SPH_C64(0xB24DFC4129C51D02), SPH_C64(0x8AE44B70B7DA5ACD),
+		SPH_C64(0xE671ED84D96579A7), SPH_C64(0xA4BB3417D66F3832),
+		SPH_C64(0x4572AB38D56D2DE8), SPH_C64(0xB1B47761EA47215C),
+		SPH_C64(0xE81C09CF70ABA15D), SPH_C64(0xFFBDB872CE7F90AC),
+		SPH_C64(0xA8782297FD5DC857), SPH_C64(0x0D946F6B6A4CE4A4),
+		SPH_C64(0xE4DF1F4F5B995138), SPH_C64(0x9EBC71EDCA8C5762),
+		SPH_C64(0x0A2C1DC0B02B88D9), SPH_C64(0x3B503C115D9D7B91),
+		SPH_C64(0xC64376A8111EC3A2), SPH_C64(0xCEC199A323C963E4),
+		SPH_C64(0xDC76A87EC58616F7), SPH_C64(0x09D596E073A9B487),
+		SPH_C64(0x14583A9D7D560DAF), SPH_C64(0xF4C6DC593F2A0CB4),
+		SPH_C64(0xDD21D19584F80236), SPH_C64(0x4A4836983DDDE1D3),
+		SPH_C64(0xE58866A41AE745F9), SPH_C64(0xF591A5B27E541875),
+		SPH_C64(0x891DC05074586693), SPH_C64(0x5B068C651810A89E),
+		SPH_C64(0xA30346BC0C08544F), SPH_C64(0x3DBF3751C684032D),
+		SPH_C64(0x2A1E86EC785032DC), SPH_C64(0xF73F5779FCA830EA),
+		SPH_C64(0xB60C05CA30204D21), SPH_C64(0x0CC316802B32F065),
+		SPH_C64(0x8770241BDD96BE69), SPH_C64(0xB861E18199EE95DB),
+		SPH_C64(0xF805CAD91418FCD1), SPH_C64(0x29E70DCCBBD20E82),
+		SPH_C64(0xC7140F435060D763), SPH_C64(0x0F3A9DA0E8B0CC3B),
+		SPH_C64(0xA2543F574D76408E), SPH_C64(0xBD7761E1C175D139),
+		SPH_C64(0x4B1F4F737CA3F512), SPH_C64(0x6DC2DF1F2FC137AB),
+		SPH_C64(0xF1D05C3967B14856), SPH_C64(0xA742BF3715ED046C),
+		SPH_C64(0x654030141D1697ED), SPH_C64(0x07B872ABDA676C7D),
+		SPH_C64(0x3CE84EBA87FA17EC), SPH_C64(0xC1FB0403CB79AFDF),
+		SPH_C64(0x3E46BC7105063F73), SPH_C64(0x278AE987121CD678),
+		SPH_C64(0xA1ADB4778EF47CD0), SPH_C64(0x26DD906C5362C2B9),
+		SPH_C64(0x05168060589B44E2), SPH_C64(0xFBFC41F9D79AC08F),
+		SPH_C64(0x0E6DE44BA9CED8FA), SPH_C64(0x9FEB08068BF243A3),
+		SPH_C64(0x7B341749D06B129B), SPH_C64(0x229C69E74A87929A),
+		SPH_C64(0xE09EE6C4427C011B), SPH_C64(0x5692E30E725C4C3A),
+		SPH_C64(0xDA99A33E5E9F6E4B), SPH_C64(0x353DD85AF453A36B),
+		SPH_C64(0x25241B4C90E0FEE7), SPH_C64(0x5DE987258309D022),
+		SPH_C64(0xE230140FC0802984), SPH_C64(0x93281E86A0C0B3C6),
+		SPH_C64(0xF229D719A4337408), SPH_C64(0x6F6C2DD4AD3D1F34),
+		SPH_C64(0x8EA5B2FBAE3F0AEE), SPH_C64(0x8331DD90C473EE4A),
+		SPH_C64(0x346AA1B1B52DB7AA), SPH_C64(0xDF8F235E06042AA9),
+		SPH_C64(0xCC6F6B68A1354B7B), SPH_C64(0x6C95A6F46EBF236A),
+		SPH_C64(0x52D31A856BB91C19), SPH_C64(0x1A35DED6D498D555),
+		SPH_C64(0xF37EAEF2E54D60C9), SPH_C64(0x72E181A9A3C2A61C),
+		SPH_C64(0x98537AAD51952FDE), SPH_C64(0x16F6C856FFAA2530),
+		SPH_C64(0xD960281E9D1D5215), SPH_C64(0x3A0745FA1CE36F50),
+		SPH_C64(0x0B7B642BF1559C18), SPH_C64(0x59A87EAE9AEC8001),
+		SPH_C64(0x5E100C05408BEC7C), SPH_C64(0x0441F98B19E55023),
+		SPH_C64(0xD70DCC5534D38AEF), SPH_C64(0x927F676DE1BEA707),
+		SPH_C64(0x9769E70DB925E3E5), SPH_C64(0x7A636EA29115065A),
+		SPH_C64(0x468B201816EF11B6), SPH_C64(0xAB81A9B73EDFF409),
+		SPH_C64(0xC0AC7DE88A07BB1E), SPH_C64(0x1F235EB68C0391B7),
+		SPH_C64(0x6056B074458DD30F), SPH_C64(0xBE8EEAC102F7ED67),
+		SPH_C64(0xCD381283E04B5FBA), SPH_C64(0x5CBEFECEC277C4E3),
+		SPH_C64(0xD21B4C356C48CE0D), SPH_C64(0x1019C31664B35D8C),
+		SPH_C64(0x247362A7D19EEA26), SPH_C64(0xEBE582EFB3299D03),
+		SPH_C64(0x02AEF2CB82FC289F), SPH_C64(0x86275DF09CE8AAA8),
+		SPH_C64(0x28B07427FAAC1A43), SPH_C64(0x38A9B7319E1F47CF),
+		SPH_C64(0xC82E92E3B8D01B58), SPH_C64(0x06EF0B409B1978BC),
+		SPH_C64(0x62F842BFC771FB90), SPH_C64(0x9904034610EB3B1F),
+		SPH_C64(0xDED85AB5477A3E68), SPH_C64(0x90D195A663428F98),
+		SPH_C64(0x5384636E2AC708D8), SPH_C64(0xCBD719C37B522706),
+		SPH_C64(0xAE9729D76644B0EB), SPH_C64(0x7C8C65E20A0C7EE6),
+		SPH_C64(0x80C856B007F1D214), SPH_C64(0x8C0B40302CC32271),
+		SPH_C64(0xDBCEDAD51FE17A8A), SPH_C64(0x740E8AE938DBDEA0),
+		SPH_C64(0xA615C6DC549310AD), SPH_C64(0x19CC55F6171AE90B),
+		SPH_C64(0x49B1BDB8FE5FDD8D), SPH_C64(0xED0A89AF2830E5BF),
+		SPH_C64(0x6A7AADB4F5A65BD6), SPH_C64(0x7E22972988F05679),
+		SPH_C64(0xF952B3325566E810), SPH_C64(0x39FECEDADF61530E),
+		SPH_C64(0x6101C99F04F3C7CE), SPH_C64(0x2E5F7F6761B562FF),
+		SPH_C64(0xF08725D226CF5C97), SPH_C64(0x63AF3B54860FEF51),
+		SPH_C64(0x8FF2CB10EF411E2F), SPH_C64(0x884AB9BB35267252),
+		SPH_C64(0x4DF04433E7BA8DAE), SPH_C64(0x9AFD8866D3690741),
+		SPH_C64(0x66B9BB34DE94ABB3), SPH_C64(0x9BAAF18D92171380),
+		SPH_C64(0x543C11C5F0A064A5), SPH_C64(0x17A1B1BDBED431F1),
+		SPH_C64(0xB5F58EEAF3A2717F), SPH_C64(0xC355F6C849858740),
+		SPH_C64(0xEC5DF044694EF17E), SPH_C64(0xD83751F5DC6346D4),
+		SPH_C64(0xFC4433520DFDACF2), SPH_C64(0x0000000000000000),
+		SPH_C64(0x5A51F58E596EBC5F), SPH_C64(0x3285AAF12E34CF16),
+		SPH_C64(0x8D5C39DB6DBD36B0), SPH_C64(0x12B731DDE64F7513),
+		SPH_C64(0x94906C2D7AA7DFBB), SPH_C64(0x302B583AACC8E789),
+		SPH_C64(0x9D45FACD090E6B3C), SPH_C64(0x2165E2C78905AEC4),
+		SPH_C64(0x68D45F7F775A7349), SPH_C64(0x189B2C1D5664FDCA),
+		SPH_C64(0xE1C99F2F030215DA), SPH_C64(0x6983269436246788),
+		SPH_C64(0x8489AF3B1E148237), SPH_C64(0xE94B702431D5B59C),
+		SPH_C64(0x33D2D31A6F4ADBD7), SPH_C64(0xBFD9932A4389F9A6),
+		SPH_C64(0xB0E30E8AAB39359D), SPH_C64(0xD1E2C715AFCAF253),
+		SPH_C64(0x150F43763C28196E), SPH_C64(0xC4ED846393E2EB3D),
+		SPH_C64(0x03F98B20C3823C5E), SPH_C64(0xFD134AB94C83B833),
+		SPH_C64(0x556B682EB1DE7064), SPH_C64(0x36C4537A37D19F35),
+		SPH_C64(0x7559F30279A5CA61), SPH_C64(0x799AE58252973A04),
+		SPH_C64(0x9C12832648707FFD), SPH_C64(0x78CD9C6913E92EC5),
+		SPH_C64(0x1D8DAC7D0EFFB928), SPH_C64(0x439DA0784E745554),
+		SPH_C64(0x413352B3CC887DCB), SPH_C64(0xBACF134A1B12BD44),
+		SPH_C64(0x114EBAFD25CD494D), SPH_C64(0x2F08068C20CB763E),
+		SPH_C64(0x76A07822BA27F63F), SPH_C64(0xEAB2FB04F25789C2),
+		SPH_C64(0xE3676DE481FE3D45), SPH_C64(0x1B62A73D95E6C194),
+		SPH_C64(0x641749FF5C68832C), SPH_C64(0xA5EC4DFC97112CF3),
+		SPH_C64(0xF6682E92BDD6242B), SPH_C64(0x3F11C59A44782BB2),
+		SPH_C64(0x317C21D1EDB6F348), SPH_C64(0xD65AB5BE75AD9E2E),
+		SPH_C64(0x6B2DD45FB4D84F17), SPH_C64(0xFAAB381296E4D44E),
+		SPH_C64(0xD0B5BEFEEEB4E692), SPH_C64(0x0882EF0B32D7A046),
+		SPH_C64(0x512A91A5A83B2047), SPH_C64(0x963E9EE6F85BF724),
+		SPH_C64(0x4E09CF132438B1F0), SPH_C64(0x77F701C9FB59E2FE),
+		SPH_C64(0x7DDB1C094B726A27), SPH_C64(0x5F4775EE01F5F8BD),
+		SPH_C64(0x9186EC4D223C9B59), SPH_C64(0xFEEAC1998F01846D),
+		SPH_C64(0xAC39DB1CE4B89874), SPH_C64(0xB75B7C21715E59E0),
+		SPH_C64(0xAFC0503C273AA42A), SPH_C64(0x6E3B543FEC430BF5),
+		SPH_C64(0x704F7362213E8E83), SPH_C64(0x58FF0745DB9294C0),
+		SPH_C64(0x67EEC2DF9FEABF72), SPH_C64(0xA0FACD9CCF8A6811),
+		SPH_C64(0xB936986AD890811A), SPH_C64(0x95C715C63BD9CB7A),
+		SPH_C64(0xCA8060283A2C33C7), SPH_C64(0x507DE84EE9453486),
+		SPH_C64(0x85DED6D05F6A96F6), SPH_C64(0x1CDAD5964F81ADE9),
+		SPH_C64(0xD5A33E9EB62FA270), SPH_C64(0x40642B588DF6690A),
+		SPH_C64(0x7F75EEC2C98E42B8), SPH_C64(0x2CF18DACE3494A60),
+		SPH_C64(0x23CB100C0BF9865B), SPH_C64(0xEEF3028FEBB2D9E1),
+		SPH_C64(0x4425D2D394133929), SPH_C64(0xAAD6D05C7FA1E0C8),
+		SPH_C64(0xAD6EA2F7A5C68CB5), SPH_C64(0xC2028F2308FB9381),
+		SPH_C64(0x819F2F5B468FC6D5), SPH_C64(0xC5BAFD88D29CFFFC),
+		SPH_C64(0x47DC59F357910577), SPH_C64(0x2B49FF07392E261D),
+		SPH_C64(0x57C59AE5332258FB), SPH_C64(0x73B6F842E2BCB2DD),
+		SPH_C64(0xCF96E04862B77725), SPH_C64(0x4CA73DD8A6C4996F),
+		SPH_C64(0x015779EB417E14C1), SPH_C64(0x37932A9176AF8BF4)
+	},
+	{
+		SPH_C64(0x190A2C9B249DF23E), SPH_C64(0x2F62F8B62263E1E9),
+		SPH_C64(0x7A7F754740993655), SPH_C64(0x330B7BA4D5564D9F),
+		SPH_C64(0x4C17A16A46672582), SPH_C64(0xB22F08EB7D05F5B8),
+		SPH_C64(0x535F47F40BC148CC), SPH_C64(0x3AEC5D27D4883037),
+		SPH_C64(0x10ED0A1825438F96), SPH_C64(0x516101F72C233D17),
+		SPH_C64(0x13CC6F949FD04EAE), SPH_C64(0x739853C441474BFD),
+		SPH_C64(0x653793D90D3F5B1B), SPH_C64(0x5240647B96B0FC2F),
+		SPH_C64(0x0C84890AD27623E0), SPH_C64(0xD7189B32703AAEA3),
+		SPH_C64(0x2685DE3523BD9C41), SPH_C64(0x99317C5B11BFFEFA),
+		SPH_C64(0x0D9BAA854F079703), SPH_C64(0x70B93648FBD48AC5),
+		SPH_C64(0xA80441FCE30BC6BE), SPH_C64(0x7287704BDC36FF1E),
+		SPH_C64(0xB65384ED33DC1F13), SPH_C64(0xD36417343EE34408),
+		SPH_C64(0x39CD38AB6E1BF10F), SPH_C64(0x5AB861770A1F3564),
+		SPH_C64(0x0EBACF09F594563B), SPH_C64(0xD04572B884708530),
+		SPH_C64(0x3CAE9722BDB3AF47), SPH_C64(0x4A556B6F2F5CBAF2),
+		SPH_C64(0xE1704F1F76C4BD74), SPH_C64(0x5EC4ED7144C6DFCF),
+		SPH_C64(0x16AFC01D4C7810E6), SPH_C64(0x283F113CD629CA7A),
+		SPH_C64(0xAF59A8761741ED2D), SPH_C64(0xEED5A3991E215FAC),
+		SPH_C64(0x3BF37EA849F984D4), SPH_C64(0xE413E096A56CE33C),
+		SPH_C64(0x2C439D3A98F020D1), SPH_C64(0x637559DC6404C46B),
+		SPH_C64(0x9E6C95D1E5F5D569), SPH_C64(0x24BB9836045FE99A),
+		SPH_C64(0x44EFA466DAC8ECC9), SPH_C64(0xC6EAB2A5C80895D6),
+		SPH_C64(0x803B50C035220CC4), SPH_C64(0x0321658CBA93C138),
+		SPH_C64(0x8F9EBC465DC7EE1C), SPH_C64(0xD15A5137190131D3),
+		SPH_C64(0x0FA5EC8668E5E2D8), SPH_C64(0x91C979578D1037B1),
+		SPH_C64(0x0642CA05693B9F70), SPH_C64(0xEFCA80168350EB4F),
+		SPH_C64(0x38D21B24F36A45EC), SPH_C64(0xBEAB81E1AF73D658),
+		SPH_C64(0x8CBFD9CAE7542F24), SPH_C64(0xFD19CC0D81F11102),
+		SPH_C64(0x0AC6430FBB4DBC90), SPH_C64(0x1D76A09D6A441895),
+		SPH_C64(0x2A01573FF1CBBFA1), SPH_C64(0xB572E161894FDE2B),
+		SPH_C64(0x8124734FA853B827), SPH_C64(0x614B1FDF43E6B1B0),
+		SPH_C64(0x68AC395C4238CC18), SPH_C64(0x21D837BFD7F7B7D2),
+		SPH_C64(0x20C714304A860331), SPH_C64(0x5CFAAB726324AA14),
+		SPH_C64(0x74C5BA4EB50D606E), SPH_C64(0xF3A3030474654739),
+		SPH_C64(0x23E671BCF015C209), SPH_C64(0x45F087E947B9582A),
+		SPH_C64(0xD8BD77B418DF4C7B), SPH_C64(0xE06F6C90EBB50997),
+		SPH_C64(0x0BD96080263C0873), SPH_C64(0x7E03F9410E40DCFE),
+		SPH_C64(0xB8E94BE4C6484928), SPH_C64(0xFB5B0608E8CA8E72),
+		SPH_C64(0x1A2B49179E0E3306), SPH_C64(0x4E29E76961855059),
+		SPH_C64(0x4F36C4E6FCF4E4BA), SPH_C64(0x49740EE395CF7BCA),
+		SPH_C64(0xC2963EA386D17F7D), SPH_C64(0x90D65AD810618352),
+		SPH_C64(0x12D34C1B02A1FA4D), SPH_C64(0xFA44258775BB3A91),
+		SPH_C64(0x18150F14B9EC46DD), SPH_C64(0x1491861E6B9A653D),
+		SPH_C64(0x9A1019D7AB2C3FC2), SPH_C64(0x3668D42D06FE13D7),
+		SPH_C64(0xDCC1FBB25606A6D0), SPH_C64(0x969490DD795A1C22),
+		SPH_C64(0x3549B1A1BC6DD2EF), SPH_C64(0xC94F5E23A0ED770E),
+		SPH_C64(0xB9F6686B5B39FDCB), SPH_C64(0xC4D4F4A6EFEAE00D),
+		SPH_C64(0xE732851A1FFF2204), SPH_C64(0x94AAD6DE5EB869F9),
+		SPH_C64(0x3F8FF2AE07206E7F), SPH_C64(0xFE38A9813B62D03A),
+		SPH_C64(0xA7A1AD7A8BEE2466), SPH_C64(0x7B6056C8DDE882B6),
+		SPH_C64(0x302A1E286FC58CA7), SPH_C64(0x8DA0FA457A259BC7),
+		SPH_C64(0xB3302B64E074415B), SPH_C64(0x5402AE7EFF8B635F),
+		SPH_C64(0x08F8050C9CAFC94B), SPH_C64(0xAE468BF98A3059CE),
+		SPH_C64(0x88C355CCA98DC58F), SPH_C64(0xB10E6D67C7963480),
+		SPH_C64(0xBAD70DE7E1AA3CF3), SPH_C64(0xBFB4A26E320262BB),
+		SPH_C64(0xCB711820870F02D5), SPH_C64(0xCE12B7A954A75C9D),
+		SPH_C64(0x563CE87DD8691684), SPH_C64(0x9F73B65E7884618A),
+		SPH_C64(0x2B1E74B06CBA0B42), SPH_C64(0x47CEC1EA605B2DF1),
+		SPH_C64(0x1C698312F735AC76), SPH_C64(0x5FDBCEFED9B76B2C),
+		SPH_C64(0x831A354C8FB1CDFC), SPH_C64(0x820516C312C0791F),
+		SPH_C64(0xB74CA762AEADABF0), SPH_C64(0xFC06EF821C80A5E1),
+		SPH_C64(0x5723CBF24518A267), SPH_C64(0x9D4DF05D5F661451),
+		SPH_C64(0x588627742DFD40BF), SPH_C64(0xDA8331B73F3D39A0),
+		SPH_C64(0x17B0E392D109A405), SPH_C64(0xF965400BCF28FBA9),
+		SPH_C64(0x7C3DBF4229A2A925), SPH_C64(0x023E460327E275DB),
+		SPH_C64(0x6CD0B55A0CE126B3), SPH_C64(0xE62DA695828E96E7),
+		SPH_C64(0x42AD6E63B3F373B9), SPH_C64(0xE50CC319381D57DF),
+		SPH_C64(0xC5CBD729729B54EE), SPH_C64(0x46D1E265FD2A9912),
+		SPH_C64(0x6428B056904EEFF8), SPH_C64(0x8BE23040131E04B7),
+		SPH_C64(0x6709D5DA2ADD2EC0), SPH_C64(0x075DE98AF44A2B93),
+		SPH_C64(0x8447DCC67BFBE66F), SPH_C64(0x6616F655B7AC9A23),
+		SPH_C64(0xD607B8BDED4B1A40), SPH_C64(0x0563AF89D3A85E48),
+		SPH_C64(0x3DB1B4AD20C21BA4), SPH_C64(0x11F22997B8323B75),
+		SPH_C64(0x292032B34B587E99), SPH_C64(0x7F1CDACE9331681D),
+		SPH_C64(0x8E819FC9C0B65AFF), SPH_C64(0xA1E3677FE2D5BB16),
+		SPH_C64(0xCD33D225EE349DA5), SPH_C64(0xD9A2543B85AEF898),
+		SPH_C64(0x795E10CBFA0AF76D), SPH_C64(0x25A4BBB9992E5D79),
+		SPH_C64(0x78413344677B438E), SPH_C64(0xF0826688CEF68601),
+		SPH_C64(0xD27B34BBA392F0EB), SPH_C64(0x551D8DF162FAD7BC),
+		SPH_C64(0x1E57C511D0D7D9AD), SPH_C64(0xDEFFBDB171E4D30B),
+		SPH_C64(0xF4FEEA8E802F6CAA), SPH_C64(0xA480C8F6317DE55E),
+		SPH_C64(0xA0FC44F07FA40FF5), SPH_C64(0x95B5F551C3C9DD1A),
+		SPH_C64(0x22F952336D6476EA), SPH_C64(0x0000000000000000),
+		SPH_C64(0xA6BE8EF5169F9085), SPH_C64(0xCC2CF1AA73452946),
+		SPH_C64(0x2E7DDB39BF12550A), SPH_C64(0xD526DD3157D8DB78),
+		SPH_C64(0x486B2D6C08BECF29), SPH_C64(0x9B0F3A58365D8B21),
+		SPH_C64(0xAC78CDFAADD22C15), SPH_C64(0xBC95C7E28891A383),
+		SPH_C64(0x6A927F5F65DAB9C3), SPH_C64(0xC3891D2C1BA0CB9E),
+		SPH_C64(0xEAA92F9F50F8B507), SPH_C64(0xCF0D9426C9D6E87E),
+		SPH_C64(0xCA6E3BAF1A7EB636), SPH_C64(0xAB25247059980786),
+		SPH_C64(0x69B31AD3DF4978FB), SPH_C64(0xE2512A93CC577C4C),
+		SPH_C64(0xFF278A0EA61364D9), SPH_C64(0x71A615C766A53E26),
+		SPH_C64(0x89DC764334FC716C), SPH_C64(0xF87A638452594F4A),
+		SPH_C64(0xF2BC208BE914F3DA), SPH_C64(0x8766B94AC1682757),
+		SPH_C64(0xBBC82E687CDB8810), SPH_C64(0x626A7A53F9757088),
+		SPH_C64(0xA2C202F358467A2E), SPH_C64(0x4D0882E5DB169161),
+		SPH_C64(0x09E7268301DE7DA8), SPH_C64(0xE897699C771AC0DC),
+		SPH_C64(0xC8507DAC3D9CC3ED), SPH_C64(0xC0A878A0A1330AA6),
+		SPH_C64(0x978BB352E42BA8C1), SPH_C64(0xE9884A13EA6B743F),
+		SPH_C64(0x279AFDBABECC28A2), SPH_C64(0x047C8C064ED9EAAB),
+		SPH_C64(0x507E2278B15289F4), SPH_C64(0x599904FBB08CF45C),
+		SPH_C64(0xBD8AE46D15E01760), SPH_C64(0x31353DA7F2B43844),
+		SPH_C64(0x8558FF49E68A528C), SPH_C64(0x76FBFC4D92EF15B5),
+		SPH_C64(0x3456922E211C660C), SPH_C64(0x86799AC55C1993B4),
+		SPH_C64(0x3E90D1219A51DA9C), SPH_C64(0x2D5CBEB505819432),
+		SPH_C64(0x982E5FD48CCE4A19), SPH_C64(0xDB9C1238A24C8D43),
+		SPH_C64(0xD439FEBECAA96F9B), SPH_C64(0x418C0BEF0960B281),
+		SPH_C64(0x158EA591F6EBD1DE), SPH_C64(0x1F48E69E4DA66D4E),
+		SPH_C64(0x8AFD13CF8E6FB054), SPH_C64(0xF5E1C9011D5ED849),
+		SPH_C64(0xE34E091C5126C8AF), SPH_C64(0xAD67EE7530A398F6),
+		SPH_C64(0x43B24DEC2E82C75A), SPH_C64(0x75DA99C1287CD48D),
+		SPH_C64(0x92E81CDB3783F689), SPH_C64(0xA3DD217CC537CECD),
+		SPH_C64(0x60543C50DE970553), SPH_C64(0x93F73F54AAF2426A),
+		SPH_C64(0xA91B62737E7A725D), SPH_C64(0xF19D4507538732E2),
+		SPH_C64(0x77E4DFC20F9EA156), SPH_C64(0x7D229CCDB4D31DC6),
+		SPH_C64(0x1B346A98037F87E5), SPH_C64(0xEDF4C615A4B29E94),
+		SPH_C64(0x4093286094110662), SPH_C64(0xB0114EE85AE78063),
+		SPH_C64(0x6FF1D0D6B672E78B), SPH_C64(0x6DCF96D591909250),
+		SPH_C64(0xDFE09E3EEC9567E8), SPH_C64(0x3214582B4827F97C),
+		SPH_C64(0xB46DC2EE143E6AC8), SPH_C64(0xF6C0AC8DA7CD1971),
+		SPH_C64(0xEBB60C10CD8901E4), SPH_C64(0xF7DF8F023ABCAD92),
+		SPH_C64(0x9C52D3D2C217A0B2), SPH_C64(0x6B8D5CD0F8AB0D20),
+		SPH_C64(0x3777F7A29B8FA734), SPH_C64(0x011F238F9D71B4E3),
+		SPH_C64(0xC1B75B2F3C42BE45), SPH_C64(0x5DE588FDFE551EF7),
+		SPH_C64(0x6EEEF3592B035368), SPH_C64(0xAA3A07FFC4E9B365),
+		SPH_C64(0xECEBE59A39C32A77), SPH_C64(0x5BA742F8976E8187),
+		SPH_C64(0x4B4A48E0B22D0E11), SPH_C64(0xDDDED83DCB771233),
+		SPH_C64(0xA59FEB79AC0C51BD), SPH_C64(0xC7F5912A55792135)
+	},
+	{
+		SPH_C64(0x6D6AE04668A9B08A), SPH_C64(0x3AB3F04B0BE8C743),
+		SPH_C64(0xE51E166B54B3C908), SPH_C64(0xBE90A9EB35C2F139),
+		SPH_C64(0xB2C7066637F2BEC1), SPH_C64(0xAA6945613392202C),
+		SPH_C64(0x9A28C36F3B5201EB), SPH_C64(0xDDCE5A93AB536994),
+		SPH_C64(0x0E34133EF6382827), SPH_C64(0x52A02BA1EC55048B),
+		SPH_C64(0xA2F88F97C4B2A177), SPH_C64(0x8640E513CA2251A5),
+		SPH_C64(0xCDF1D36258137622), SPH_C64(0xFE6CB708DEDF8DDB),
+		SPH_C64(0x8A174A9EC8121E5D), SPH_C64(0x679896036B81560E),
+		SPH_C64(0x59ED033395795FEE), SPH_C64(0x1DD778AB8B74EDAF),
+		SPH_C64(0xEE533EF92D9F926D), SPH_C64(0x2A8C79BAF8A8D8F5),
+		SPH_C64(0x6BCF398E69B119F6), SPH_C64(0xE20491742FAFDD95),
+		SPH_C64(0x276488E0809C2AEC), SPH_C64(0xEA955B82D88F5CCE),
+		SPH_C64(0x7102C63A99D9E0C4), SPH_C64(0xF9763017A5C39946),
+		SPH_C64(0x429FA2501F151B3D), SPH_C64(0x4659C72BEA05D59E),
+		SPH_C64(0x984B7FDCCF5A6634), SPH_C64(0xF742232953FBB161),
+		SPH_C64(0x3041860E08C021C7), SPH_C64(0x747BFD9616CD9386),
+		SPH_C64(0x4BB1367192312787), SPH_C64(0x1B72A1638A6C44D3),
+		SPH_C64(0x4A0E68A6E8359A66), SPH_C64(0x169A5039F258B6CA),
+		SPH_C64(0xB98A2EF44EDEE5A4), SPH_C64(0xD9083FE85E43A737),
+		SPH_C64(0x967F6CE239624E13), SPH_C64(0x8874F62D3C1A7982),
+		SPH_C64(0x3C1629830AF06E3F), SPH_C64(0x9165EBFD427E5A8E),
+		SPH_C64(0xB5DD81794CEEAA5C), SPH_C64(0x0DE8F15A7834F219),
+		SPH_C64(0x70BD98EDE3DD5D25), SPH_C64(0xACCC9CA9328A8950),
+		SPH_C64(0x56664EDA1945CA28), SPH_C64(0x221DB34C0F8859AE),
+		SPH_C64(0x26DBD637FA98970D), SPH_C64(0x1ACDFFB4F068F932),
+		SPH_C64(0x4585254F64090FA0), SPH_C64(0x72DE245E17D53AFA),
+		SPH_C64(0x1546B25D7C546CF4), SPH_C64(0x207E0FFFFB803E71),
+		SPH_C64(0xFAAAD2732BCF4378), SPH_C64(0xB462DFAE36EA17BD),
+		SPH_C64(0xCF926FD1AC1B11FD), SPH_C64(0xE0672DC7DBA7BA4A),
+		SPH_C64(0xD3FA49AD5D6B41B3), SPH_C64(0x8BA81449B216A3BC),
+		SPH_C64(0x14F9EC8A0650D115), SPH_C64(0x40FC1EE3EB1D7CE2),
+		SPH_C64(0x23A2ED9B758CE44F), SPH_C64(0x782C521B14FDDC7E),
+		SPH_C64(0x1C68267CF170504E), SPH_C64(0xBCF31558C1CA96E6),
+		SPH_C64(0xA781B43B4BA6D235), SPH_C64(0xF6FD7DFE29FF0C80),
+		SPH_C64(0xB0A4BAD5C3FAD91E), SPH_C64(0xD199F51EA963266C),
+		SPH_C64(0x414340349119C103), SPH_C64(0x5405F269ED4DADF7),
+		SPH_C64(0xABD61BB649969DCD), SPH_C64(0x6813DBEAE7BDC3C8),
+		SPH_C64(0x65FB2AB09F8931D1), SPH_C64(0xF1E7FAE152E3181D),
+		SPH_C64(0xC1A67CEF5A2339DA), SPH_C64(0x7A4FEEA8E0F5BBA1),
+		SPH_C64(0x1E0B9ACF05783791), SPH_C64(0x5B8EBF8061713831),
+		SPH_C64(0x80E53CDBCB3AF8D9), SPH_C64(0x7E898BD315E57502),
+		SPH_C64(0xC6BCFBF0213F2D47), SPH_C64(0x95A38E86B76E942D),
+		SPH_C64(0x092E94218D243CBA), SPH_C64(0x8339DEBF453622E7),
+		SPH_C64(0xB11BE402B9FE64FF), SPH_C64(0x57D9100D634177C9),
+		SPH_C64(0xCC4E8DB52217CBC3), SPH_C64(0x3B0CAE9C71EC7AA2),
+		SPH_C64(0xFB158CA451CBFE99), SPH_C64(0x2B33276D82AC6514),
+		SPH_C64(0x01BF5ED77A04BDE1), SPH_C64(0xC5601994AF33F779),
+		SPH_C64(0x75C4A3416CC92E67), SPH_C64(0xF3844652A6EB7FC2),
+		SPH_C64(0x3487E375FDD0EF64), SPH_C64(0x18AE430704609EED),
+		SPH_C64(0x4D14EFB993298EFB), SPH_C64(0x815A620CB13E4538),
+		SPH_C64(0x125C354207487869), SPH_C64(0x9EEEA614CE42CF48),
+		SPH_C64(0xCE2D3106D61FAC1C), SPH_C64(0xBBE99247BAD6827B),
+		SPH_C64(0x071A871F7B1C149D), SPH_C64(0x2E4A1CC10DB81656),
+		SPH_C64(0x77A71FF298C149B8), SPH_C64(0x06A5D9C80118A97C),
+		SPH_C64(0xAD73C27E488E34B1), SPH_C64(0x443A7B981E0DB241),
+		SPH_C64(0xE3BBCFA355AB6074), SPH_C64(0x0AF276450328E684),
+		SPH_C64(0x73617A896DD1871B), SPH_C64(0x58525DE4EF7DE20F),
+		SPH_C64(0xB7BE3DCAB8E6CD83), SPH_C64(0x19111DD07E64230C),
+		SPH_C64(0x842359A03E2A367A), SPH_C64(0x103F89F1F3401FB6),
+		SPH_C64(0xDC710444D157D475), SPH_C64(0xB835702334DA5845),
+		SPH_C64(0x4320FC876511A6DC), SPH_C64(0xD026ABC9D3679B8D),
+		SPH_C64(0x17250EEE885C0B2B), SPH_C64(0x90DAB52A387AE76F),
+		SPH_C64(0x31FED8D972C49C26), SPH_C64(0x89CBA8FA461EC463),
+		SPH_C64(0x2FF5421677BCABB7), SPH_C64(0x396F122F85E41D7D),
+		SPH_C64(0xA09B332430BAC6A8), SPH_C64(0xC888E8CED7070560),
+		SPH_C64(0xAEAF201AC682EE8F), SPH_C64(0x1180D7268944A257),
+		SPH_C64(0xF058A43628E7A5FC), SPH_C64(0xBD4C4B8FBBCE2B07),
+		SPH_C64(0xA1246DF34ABE7B49), SPH_C64(0x7D5569B79BE9AF3C),
+		SPH_C64(0xA9B5A705BD9EFA12), SPH_C64(0xDB6B835BAA4BC0E8),
+		SPH_C64(0x05793BAC8F147342), SPH_C64(0x21C1512881848390),
+		SPH_C64(0xFDB0556C50D357E5), SPH_C64(0x613D4FCB6A99FF72),
+		SPH_C64(0x03DCE2648E0CDA3E), SPH_C64(0xE949B9E6568386F0),
+		SPH_C64(0xFC0F0BBB2AD7EA04), SPH_C64(0x6A70675913B5A417),
+		SPH_C64(0x7F36D5046FE1C8E3), SPH_C64(0x0C57AF8D02304FF8),
+		SPH_C64(0x32223ABDFCC84618), SPH_C64(0x0891CAF6F720815B),
+		SPH_C64(0xA63EEAEC31A26FD4), SPH_C64(0x2507345374944D33),
+		SPH_C64(0x49D28AC266394058), SPH_C64(0xF5219F9AA7F3D6BE),
+		SPH_C64(0x2D96FEA583B4CC68), SPH_C64(0x5A31E1571B7585D0),
+		SPH_C64(0x8ED12FE53D02D0FE), SPH_C64(0xDFADE6205F5B0E4B),
+		SPH_C64(0x4CABB16EE92D331A), SPH_C64(0x04C6657BF510CEA3),
+		SPH_C64(0xD73C2CD6A87B8F10), SPH_C64(0xE1D87310A1A307AB),
+		SPH_C64(0x6CD5BE9112AD0D6B), SPH_C64(0x97C032354366F3F2),
+		SPH_C64(0xD4E0CEB22677552E), SPH_C64(0x0000000000000000),
+		SPH_C64(0x29509BDE76A402CB), SPH_C64(0xC27A9E8BD42FE3E4),
+		SPH_C64(0x5EF7842CEE654B73), SPH_C64(0xAF107ECDBC86536E),
+		SPH_C64(0x3FCACBE784FCB401), SPH_C64(0xD55F90655C73E8CF),
+		SPH_C64(0xE6C2F40FDABF1336), SPH_C64(0xE8F6E7312C873B11),
+		SPH_C64(0xEB2A0555A28BE12F), SPH_C64(0xE4A148BC2EB774E9),
+		SPH_C64(0x9B979DB84156BC0A), SPH_C64(0x6EB60222E6A56AB4),
+		SPH_C64(0x87FFBBC4B026EC44), SPH_C64(0xC703A5275B3B90A6),
+		SPH_C64(0x47E699FC9001687F), SPH_C64(0x9C8D1AA73A4AA897),
+		SPH_C64(0x7CEA3760E1ED12DD), SPH_C64(0x4EC80DDD1D2554C5),
+		SPH_C64(0x13E36B957D4CC588), SPH_C64(0x5D2B66486069914D),
+		SPH_C64(0x92B90999CC7280B0), SPH_C64(0x517CC9C56259DEB5),
+		SPH_C64(0xC937B619AD03B881), SPH_C64(0xEC30824AD997F5B2),
+		SPH_C64(0xA45D565FC5AA080B), SPH_C64(0xD6837201D27F32F1),
+		SPH_C64(0x635EF3789E9198AD), SPH_C64(0x531F75769651B96A),
+		SPH_C64(0x4F77530A6721E924), SPH_C64(0x486DD4151C3DFDB9),
+		SPH_C64(0x5F48DAFB9461F692), SPH_C64(0x375B011173DC355A),
+		SPH_C64(0x3DA9775470F4D3DE), SPH_C64(0x8D0DCD81B30E0AC0),
+		SPH_C64(0x36E45FC609D888BB), SPH_C64(0x55BAACBE97491016),
+		SPH_C64(0x8CB29356C90AB721), SPH_C64(0x76184125E2C5F459),
+		SPH_C64(0x99F4210BB55EDBD5), SPH_C64(0x6F095CF59CA1D755),
+		SPH_C64(0x9F51F8C3B44672A9), SPH_C64(0x3538BDA287D45285),
+		SPH_C64(0x50C39712185D6354), SPH_C64(0xF23B1885DCEFC223),
+		SPH_C64(0x79930CCC6EF9619F), SPH_C64(0xED8FDC9DA3934853),
+		SPH_C64(0xCB540AAA590BDF5E), SPH_C64(0x5C94389F1A6D2CAC),
+		SPH_C64(0xE77DAAD8A0BBAED7), SPH_C64(0x28EFC5090CA0BF2A),
+		SPH_C64(0xBF2FF73C4FC64CD8), SPH_C64(0xB37858B14DF60320),
+		SPH_C64(0xF8C96EC0DFC724A7), SPH_C64(0x828680683F329F06),
+		SPH_C64(0x941CD051CD6A29CC), SPH_C64(0xC3C5C05CAE2B5E05),
+		SPH_C64(0xB601631DC2E27062), SPH_C64(0xC01922382027843B),
+		SPH_C64(0x24B86A840E90F0D2), SPH_C64(0xD245177A276FFC52),
+		SPH_C64(0x0F8B4DE98C3C95C6), SPH_C64(0x3E759530FEF809E0),
+		SPH_C64(0x0B4D2892792C5B65), SPH_C64(0xC4DF4743D5374A98),
+		SPH_C64(0xA5E20888BFAEB5EA), SPH_C64(0xBA56CC90C0D23F9A),
+		SPH_C64(0x38D04CF8FFE0A09C), SPH_C64(0x62E1ADAFE495254C),
+		SPH_C64(0x0263BCB3F40867DF), SPH_C64(0xCAEB547D230F62BF),
+		SPH_C64(0x6082111C109D4293), SPH_C64(0xDAD4DD8CD04F7D09),
+		SPH_C64(0xEFEC602E579B2F8C), SPH_C64(0x1FB4C4187F7C8A70),
+		SPH_C64(0xFFD3E9DFA4DB303A), SPH_C64(0x7BF0B07F9AF10640),
+		SPH_C64(0xF49EC14DDDF76B5F), SPH_C64(0x8F6E713247066D1F),
+		SPH_C64(0x339D646A86CCFBF9), SPH_C64(0x64447467E58D8C30),
+		SPH_C64(0x2C29A072F9B07189), SPH_C64(0xD8B7613F24471AD6),
+		SPH_C64(0x6627C8D41185EBEF), SPH_C64(0xA347D140BEB61C96),
+		SPH_C64(0xDE12B8F7255FB3AA), SPH_C64(0x9D324470404E1576),
+		SPH_C64(0x9306574EB6763D51), SPH_C64(0xA80AF9D2C79A47F3),
+		SPH_C64(0x859C0777442E8B9B), SPH_C64(0x69AC853D9DB97E29)
+	},
+	{
+		SPH_C64(0xC3407DFC2DE6377E), SPH_C64(0x5B9E93EEA4256F77),
+		SPH_C64(0xADB58FDD50C845E0), SPH_C64(0x5219FF11A75BED86),
+		SPH_C64(0x356B61CFD90B1DE9), SPH_C64(0xFB8F406E25ABE037),
+		SPH_C64(0x7A5A0231C0F60796), SPH_C64(0x9D3CD216E1F5020B),
+		SPH_C64(0x0C6550FB6B48D8F3), SPH_C64(0xF57508C427FF1C62),
+		SPH_C64(0x4AD35FFA71CB407D), SPH_C64(0x6290A2DA1666AA6D),
+		SPH_C64(0xE284EC2349355F9F), SPH_C64(0xB3C307C53D7C84EC),
+		SPH_C64(0x05E23C0468365A02), SPH_C64(0x190BAC4D6C9EBFA8),
+		SPH_C64(0x94BBBEE9E28B80FA), SPH_C64(0xA34FC777529CB9B5),
+		SPH_C64(0xCC7B39F095BCD978), SPH_C64(0x2426ADDB0CE532E3),
+		SPH_C64(0x7E79329312CE4FC7), SPH_C64(0xAB09A72EEBEC2917),
+		SPH_C64(0xF8D15499F6B9D6C2), SPH_C64(0x1A55B8BABF8C895D),
+		SPH_C64(0xDB8ADD17FB769A85), SPH_C64(0xB57F2F368658E81B),
+		SPH_C64(0x8ACD36F18F3F41F6), SPH_C64(0x5CE3B7BBA50F11D3),
+		SPH_C64(0x114DCC14D5EE2F0A), SPH_C64(0xB91A7FCDED1030E8),
+		SPH_C64(0x81D5425FE55DE7A1), SPH_C64(0xB6213BC1554ADEEE),
+		SPH_C64(0x80144EF95F53F5F2), SPH_C64(0x1E7688186DB4C10C),
+		SPH_C64(0x3B912965DB5FE1BC), SPH_C64(0xC281715A97E8252D),
+		SPH_C64(0x54A5D7E21C7F8171), SPH_C64(0x4B12535CCBC5522E),
+		SPH_C64(0x1D289CEFBEA6F7F9), SPH_C64(0x6EF5F2217D2E729E),
+		SPH_C64(0xE6A7DC819B0D17CE), SPH_C64(0x1B94B41C05829B0E),
+		SPH_C64(0x33D7493C622F711E), SPH_C64(0xDCF7F942FA5CE421),
+		SPH_C64(0x600FBA8B7F7A8ECB), SPH_C64(0x46B60F011A83988E),
+		SPH_C64(0x235B898E0DCF4C47), SPH_C64(0x957AB24F588592A9),
+		SPH_C64(0x4354330572B5C28C), SPH_C64(0xA5F3EF84E9B8D542),
+		SPH_C64(0x8C711E02341B2D01), SPH_C64(0x0B1874AE6A62A657),
+		SPH_C64(0x1213D8E306FC19FF), SPH_C64(0xFE6D7C6A4D9DBA35),
+		SPH_C64(0x65ED868F174CD4C9), SPH_C64(0x88522EA0E6236550),
+		SPH_C64(0x899322065C2D7703), SPH_C64(0xC01E690BFEF4018B),
+		SPH_C64(0x915982ED8ABDDAF8), SPH_C64(0xBE675B98EC3A4E4C),
+		SPH_C64(0xA996BF7F82F00DB1), SPH_C64(0xE1DAF8D49A27696A),
+		SPH_C64(0x2EFFD5D3DC8986E7), SPH_C64(0xD153A51F2B1A2E81),
+		SPH_C64(0x18CAA0EBD690ADFB), SPH_C64(0x390E3134B243C51A),
+		SPH_C64(0x2778B92CDFF70416), SPH_C64(0x029F1851691C24A6),
+		SPH_C64(0x5E7CAFEACC133575), SPH_C64(0xFA4E4CC89FA5F264),
+		SPH_C64(0x5A5F9F481E2B7D24), SPH_C64(0x484C47AB18D764DB),
+		SPH_C64(0x400A27F2A1A7F479), SPH_C64(0xAEEB9B2A83DA7315),
+		SPH_C64(0x721C626879869734), SPH_C64(0x042330A2D2384851),
+		SPH_C64(0x85F672FD3765AFF0), SPH_C64(0xBA446B3A3E02061D),
+		SPH_C64(0x73DD6ECEC3888567), SPH_C64(0xFFAC70CCF793A866),
+		SPH_C64(0xDFA9EDB5294ED2D4), SPH_C64(0x6C6AEA7014325638),
+		SPH_C64(0x834A5A0E8C41C307), SPH_C64(0xCDBA35562FB2CB2B),
+		SPH_C64(0x0AD97808D06CB404), SPH_C64(0x0F3B440CB85AEE06),
+		SPH_C64(0xE5F9C876481F213B), SPH_C64(0x98DEEE1289C35809),
+		SPH_C64(0x59018BBFCD394BD1), SPH_C64(0xE01BF47220297B39),
+		SPH_C64(0xDE68E1139340C087), SPH_C64(0x9FA3CA4788E926AD),
+		SPH_C64(0xBB85679C840C144E), SPH_C64(0x53D8F3B71D55FFD5),
+		SPH_C64(0x0DA45C5DD146CAA0), SPH_C64(0x6F34FE87C72060CD),
+		SPH_C64(0x57FBC315CF6DB784), SPH_C64(0xCEE421A1FCA0FDDE),
+		SPH_C64(0x3D2D0196607B8D4B), SPH_C64(0x642C8A29AD42C69A),
+		SPH_C64(0x14AFF010BDD87508), SPH_C64(0xAC74837BEAC657B3),
+		SPH_C64(0x3216459AD821634D), SPH_C64(0x3FB219C70967A9ED),
+		SPH_C64(0x06BC28F3BB246CF7), SPH_C64(0xF2082C9126D562C6),
+		SPH_C64(0x66B39278C45EE23C), SPH_C64(0xBD394F6F3F2878B9),
+		SPH_C64(0xFD33689D9E8F8CC0), SPH_C64(0x37F4799EB017394F),
+		SPH_C64(0x108CC0B26FE03D59), SPH_C64(0xDA4BD1B1417888D6),
+		SPH_C64(0xB09D1332EE6EB219), SPH_C64(0x2F3ED975668794B4),
+		SPH_C64(0x58C0871977375982), SPH_C64(0x7561463D78ACE990),
+		SPH_C64(0x09876CFF037E82F1), SPH_C64(0x7FB83E35A8C05D94),
+		SPH_C64(0x26B9B58A65F91645), SPH_C64(0xEF20B07E9873953F),
+		SPH_C64(0x3148516D0B3355B8), SPH_C64(0x41CB2B541BA9E62A),
+		SPH_C64(0x790416C613E43163), SPH_C64(0xA011D380818E8F40),
+		SPH_C64(0x3A5025C36151F3EF), SPH_C64(0xD57095BDF92266D0),
+		SPH_C64(0x498D4B0DA2D97688), SPH_C64(0x8B0C3A57353153A5),
+		SPH_C64(0x21C491DF64D368E1), SPH_C64(0x8F2F0AF5E7091BF4),
+		SPH_C64(0x2DA1C1240F9BB012), SPH_C64(0xC43D59A92CCC49DA),
+		SPH_C64(0xBFA6573E56345C1F), SPH_C64(0x828B56A8364FD154),
+		SPH_C64(0x9A41F643E0DF7CAF), SPH_C64(0xBCF843C985266AEA),
+		SPH_C64(0x2B1DE9D7B4BFDCE5), SPH_C64(0x20059D79DEDD7AB2),
+		SPH_C64(0x6DABE6D6AE3C446B), SPH_C64(0x45E81BF6C991AE7B),
+		SPH_C64(0x6351AE7CAC68B83E), SPH_C64(0xA432E32253B6C711),
+		SPH_C64(0xD092A9B991143CD2), SPH_C64(0xCAC711032E98B58F),
+		SPH_C64(0xD8D4C9E02864AC70), SPH_C64(0xC5FC550F96C25B89),
+		SPH_C64(0xD7EF8DEC903E4276), SPH_C64(0x67729EDE7E50F06F),
+		SPH_C64(0xEAC28C7AF045CF3D), SPH_C64(0xB15C1F945460A04A),
+		SPH_C64(0x9CFDDEB05BFB1058), SPH_C64(0x93C69ABCE3A1FE5E),
+		SPH_C64(0xEB0380DC4A4BDD6E), SPH_C64(0xD20DB1E8F8081874),
+		SPH_C64(0x229A8528B7C15E14), SPH_C64(0x44291750739FBC28),
+		SPH_C64(0xD3CCBD4E42060A27), SPH_C64(0xF62B1C33F4ED2A97),
+		SPH_C64(0x86A8660AE4779905), SPH_C64(0xD62E814A2A305025),
+		SPH_C64(0x477703A7A08D8ADD), SPH_C64(0x7B9B0E977AF815C5),
+		SPH_C64(0x78C51A60A9EA2330), SPH_C64(0xA6ADFB733AAAE3B7),
+		SPH_C64(0x97E5AA1E3199B60F), SPH_C64(0x0000000000000000),
+		SPH_C64(0xF4B404629DF10E31), SPH_C64(0x5564DB44A6719322),
+		SPH_C64(0x9207961A59AFEC0D), SPH_C64(0x9624A6B88B97A45C),
+		SPH_C64(0x363575380A192B1C), SPH_C64(0x2C60CD82B595A241),
+		SPH_C64(0x7D272664C1DC7932), SPH_C64(0x7142769FAA94A1C1),
+		SPH_C64(0xA1D0DF263B809D13), SPH_C64(0x1630E841D4C451AE),
+		SPH_C64(0xC1DF65AD44FA13D8), SPH_C64(0x13D2D445BCF20BAC),
+		SPH_C64(0xD915C546926ABE23), SPH_C64(0x38CF3D92084DD749),
+		SPH_C64(0xE766D0272103059D), SPH_C64(0xC7634D5EFFDE7F2F),
+		SPH_C64(0x077D2455012A7EA4), SPH_C64(0xEDBFA82FF16FB199),
+		SPH_C64(0xAF2A978C39D46146), SPH_C64(0x42953FA3C8BBD0DF),
+		SPH_C64(0xCB061DA59496A7DC), SPH_C64(0x25E7A17DB6EB20B0),
+		SPH_C64(0x34AA6D6963050FBA), SPH_C64(0xA76CF7D580A4F1E4),
+		SPH_C64(0xF7EA10954EE338C4), SPH_C64(0xFCF2643B24819E93),
+		SPH_C64(0xCF252D0746AEEF8D), SPH_C64(0x4EF06F58A3F3082C),
+		SPH_C64(0x563ACFB37563A5D7), SPH_C64(0x5086E740CE47C920),
+		SPH_C64(0x2982F186DDA3F843), SPH_C64(0x87696AAC5E798B56),
+		SPH_C64(0x5D22BB1D1F010380), SPH_C64(0x035E14F7D31236F5),
+		SPH_C64(0x3CEC0D30DA759F18), SPH_C64(0xF3C920379CDB7095),
+		SPH_C64(0xB8DB736B571E22BB), SPH_C64(0xDD36F5E44052F672),
+		SPH_C64(0xAAC8AB8851E23B44), SPH_C64(0xA857B3D938FE1FE2),
+		SPH_C64(0x17F1E4E76ECA43FD), SPH_C64(0xEC7EA4894B61A3CA),
+		SPH_C64(0x9E62C6E132E734FE), SPH_C64(0xD4B1991B432C7483),
+		SPH_C64(0x6AD6C283AF163ACF), SPH_C64(0x1CE9904904A8E5AA),
+		SPH_C64(0x5FBDA34C761D2726), SPH_C64(0xF910583F4CB7C491),
+		SPH_C64(0xC6A241F845D06D7C), SPH_C64(0x4F3163FE19FD1A7F),
+		SPH_C64(0xE99C988D2357F9C8), SPH_C64(0x8EEE06535D0709A7),
+		SPH_C64(0x0EFA48AA0254FC55), SPH_C64(0xB4BE23903C56FA48),
+		SPH_C64(0x763F52CAABBEDF65), SPH_C64(0xEEE1BCD8227D876C),
+		SPH_C64(0xE345E085F33B4DCC), SPH_C64(0x3E731561B369BBBE),
+		SPH_C64(0x2843FD2067ADEA10), SPH_C64(0x2ADCE5710EB1CEB6),
+		SPH_C64(0xB7E03767EF44CCBD), SPH_C64(0x8DB012A48E153F52),
+		SPH_C64(0x61CEB62DC5749C98), SPH_C64(0xE85D942B9959EB9B),
+		SPH_C64(0x4C6F7709CAEF2C8A), SPH_C64(0x84377E5B8D6BBDA3),
+		SPH_C64(0x30895DCBB13D47EB), SPH_C64(0x74A04A9BC2A2FBC3),
+		SPH_C64(0x6B17CE251518289C), SPH_C64(0xE438C4D0F2113368),
+		SPH_C64(0x1FB784BED7BAD35F), SPH_C64(0x9B80FAE55AD16EFC),
+		SPH_C64(0x77FE5E6C11B0CD36), SPH_C64(0xC858095247849129),
+		SPH_C64(0x08466059B97090A2), SPH_C64(0x01C10CA6BA0E1253),
+		SPH_C64(0x6988D6747C040C3A), SPH_C64(0x6849DAD2C60A1E69),
+		SPH_C64(0x5147EBE67449DB73), SPH_C64(0xC99905F4FD8A837A),
+		SPH_C64(0x991FE2B433CD4A5A), SPH_C64(0xF09734C04FC94660),
+		SPH_C64(0xA28ECBD1E892ABE6), SPH_C64(0xF1563866F5C75433),
+		SPH_C64(0x4DAE7BAF70E13ED9), SPH_C64(0x7CE62AC27BD26B61),
+		SPH_C64(0x70837A39109AB392), SPH_C64(0x90988E4B30B3C8AB),
+		SPH_C64(0xB2020B63877296BF), SPH_C64(0x156EFCB607D6675B)
+	},
+	{
+		SPH_C64(0xE63F55CE97C331D0), SPH_C64(0x25B506B0015BBA16),
+		SPH_C64(0xC8706E29E6AD9BA8), SPH_C64(0x5B43D3775D521F6A),
+		SPH_C64(0x0BFA3D577035106E), SPH_C64(0xAB95FC172AFB0E66),
+		SPH_C64(0xF64B63979E7A3276), SPH_C64(0xF58B4562649DAD4B),
+		SPH_C64(0x48F7C3DBAE0C83F1), SPH_C64(0xFF31916642F5C8C5),
+		SPH_C64(0xCBB048DC1C4A0495), SPH_C64(0x66B8F83CDF622989),
+		SPH_C64(0x35C130E908E2B9B0), SPH_C64(0x7C761A61F0B34FA1),
+		SPH_C64(0x3601161CF205268D), SPH_C64(0x9E54CCFE2219B7D6),
+		SPH_C64(0x8B7D90A538940837), SPH_C64(0x9CD403588EA35D0B),
+		SPH_C64(0xBC3C6FEA9CCC5B5A), SPH_C64(0xE5FF733B6D24AEED),
+		SPH_C64(0xCEED22DE0F7EB8D2), SPH_C64(0xEC8581CAB1AB545E),
+		SPH_C64(0xB96105E88FF8E71D), SPH_C64(0x8CA03501871A5EAD),
+		SPH_C64(0x76CCCE65D6DB2A2F), SPH_C64(0x5883F582A7B58057),
+		SPH_C64(0x3F7BE4ED2E8ADC3E), SPH_C64(0x0FE7BE06355CD9C9),
+		SPH_C64(0xEE054E6C1D11BE83), SPH_C64(0x1074365909B903A6),
+		SPH_C64(0x5DDE9F80B4813C10), SPH_C64(0x4A770C7D02B6692C),
+		SPH_C64(0x5379C8D5D7809039), SPH_C64(0xB4067448161ED409),
+		SPH_C64(0x5F5E5026183BD6CD), SPH_C64(0xE898029BF4C29DF9),
+		SPH_C64(0x7FB63C940A54D09C), SPH_C64(0xC5171F897F4BA8BC),
+		SPH_C64(0xA6F28DB7B31D3D72), SPH_C64(0x2E4F3BE7716EAA78),
+		SPH_C64(0x0D6771A099E63314), SPH_C64(0x82076254E41BF284),
+		SPH_C64(0x2F0FD2B42733DF98), SPH_C64(0x5C9E76D3E2DC49F0),
+		SPH_C64(0x7AEB569619606CDB), SPH_C64(0x83478B07B2468764),
+		SPH_C64(0xCFADCB8D5923CD32), SPH_C64(0x85DAC7F05B95A41E),
+		SPH_C64(0xB5469D1B4043A1E9), SPH_C64(0xB821ECBBD9A592FD),
+		SPH_C64(0x1B8E0B0E798C13C8), SPH_C64(0x62A57B6D9A0BE02E),
+		SPH_C64(0xFCF1B793B81257F8), SPH_C64(0x9D94EA0BD8FE28EB),
+		SPH_C64(0x4CEA408AEB654A56), SPH_C64(0x23284A47E888996C),
+		SPH_C64(0x2D8F1D128B893545), SPH_C64(0xF4CBAC3132C0D8AB),
+		SPH_C64(0xBD7C86B9CA912EBA), SPH_C64(0x3A268EEF3DBE6079),
+		SPH_C64(0xF0D62F6077A9110C), SPH_C64(0x2735C916ADE150CB),
+		SPH_C64(0x89FD5F03942EE2EA), SPH_C64(0x1ACEE25D2FD16628),
+		SPH_C64(0x90F39BAB41181BFF), SPH_C64(0x430DFE8CDE39939F),
+		SPH_C64(0xF70B8AC4C8274796), SPH_C64(0x1C53AEAAC6024552),
+		SPH_C64(0x13B410ACF35E9C9B), SPH_C64(0xA532AB4249FAA24F),
+		SPH_C64(0x2B1251E5625A163F), SPH_C64(0xD7E3E676DA4841C7),
+		SPH_C64(0xA7B264E4E5404892), SPH_C64(0xDA8497D643AE72D3),
+		SPH_C64(0x861AE105A1723B23), SPH_C64(0x38A6414991048AA4),
+		SPH_C64(0x6578DEC92585B6B4), SPH_C64(0x0280CFA6ACBAEADD),
+		SPH_C64(0x88BDB650C273970A), SPH_C64(0x9333BD5EBBFF84C2),
+		SPH_C64(0x4E6A8F2C47DFA08B), SPH_C64(0x321C954DB76CEF2A),
+		SPH_C64(0x418D312A72837942), SPH_C64(0xB29B38BFFFCDF773),
+		SPH_C64(0x6C022C38F90A4C07), SPH_C64(0x5A033A240B0F6A8A),
+		SPH_C64(0x1F93885F3CE5DA6F), SPH_C64(0xC38A537E96988BC6),
+		SPH_C64(0x39E6A81AC759FF44), SPH_C64(0x29929E43CEE0FCE2),
+		SPH_C64(0x40CDD87924DE0CA2), SPH_C64(0xE9D8EBC8A29FE819),
+		SPH_C64(0x0C2798F3CFBB46F4), SPH_C64(0x55E484223E53B343),
+		SPH_C64(0x4650948ECD0D2FD8), SPH_C64(0x20E86CB2126F0651),
+		SPH_C64(0x6D42C56BAF5739E7), SPH_C64(0xA06FC1405ACE1E08),
+		SPH_C64(0x7BABBFC54F3D193B), SPH_C64(0x424D17DF8864E67F),
+		SPH_C64(0xD8045870EF14980E), SPH_C64(0xC6D7397C85AC3781),
+		SPH_C64(0x21A885E1443273B1), SPH_C64(0x67F8116F893F5C69),
+		SPH_C64(0x24F5EFE35706CFF6), SPH_C64(0xD56329D076F2AB1A),
+		SPH_C64(0x5E1EB9754E66A32D), SPH_C64(0x28D2771098BD8902),
+		SPH_C64(0x8F6013F47DFDC190), SPH_C64(0x17A993FDB637553C),
+		SPH_C64(0xE0A219397E1012AA), SPH_C64(0x786B9930B5DA8606),
+		SPH_C64(0x6E82E39E55B0A6DA), SPH_C64(0x875A0856F72F4EC3),
+		SPH_C64(0x3741FF4FA458536D), SPH_C64(0xAC4859B3957558FC),
+		SPH_C64(0x7EF6D5C75C09A57C), SPH_C64(0xC04A758B6C7F14FB),
+		SPH_C64(0xF9ACDD91AB26EBBF), SPH_C64(0x7391A467C5EF9668),
+		SPH_C64(0x335C7C1EE1319ACA), SPH_C64(0xA91533B18641E4BB),
+		SPH_C64(0xE4BF9A683B79DB0D), SPH_C64(0x8E20FAA72BA0B470),
+		SPH_C64(0x51F907737B3A7AE4), SPH_C64(0x2268A314BED5EC8C),
+		SPH_C64(0xD944B123B949EDEE), SPH_C64(0x31DCB3B84D8B7017),
+		SPH_C64(0xD3FE65279F218860), SPH_C64(0x097AF2F1DC8FFAB3),
+		SPH_C64(0x9B09A6FC312D0B91), SPH_C64(0xCC6DED78A3C4520F),
+		SPH_C64(0x3481D9BA5EBFCC50), SPH_C64(0x4F2A667F1182D56B),
+		SPH_C64(0xDFD9FDD4509ACE94), SPH_C64(0x26752045FBBC252B),
+		SPH_C64(0xBFFC491F662BC467), SPH_C64(0xDD593272FC202449),
+		SPH_C64(0x3CBBC218D46D4303), SPH_C64(0x91B372F817456E1F),
+		SPH_C64(0x681FAF69BC6385A0), SPH_C64(0xB686BBEEBAA43ED4),
+		SPH_C64(0x1469B5084CD0CA01), SPH_C64(0x98C98009CBCA94AC),
+		SPH_C64(0x6438379A73D8C354), SPH_C64(0xC2CABA2DC0C5FE26),
+		SPH_C64(0x3E3B0DBE78D7A9DE), SPH_C64(0x50B9EE202D670F04),
+		SPH_C64(0x4590B27B37EAB0E5), SPH_C64(0x6025B4CB36B10AF3),
+		SPH_C64(0xFB2C1237079C0162), SPH_C64(0xA12F28130C936BE8),
+		SPH_C64(0x4B37E52E54EB1CCC), SPH_C64(0x083A1BA28AD28F53),
+		SPH_C64(0xC10A9CD83A22611B), SPH_C64(0x9F1425AD7444C236),
+		SPH_C64(0x069D4CF7E9D3237A), SPH_C64(0xEDC56899E7F621BE),
+		SPH_C64(0x778C273680865FCF), SPH_C64(0x309C5AEB1BD605F7),
+		SPH_C64(0x8DE0DC52D1472B4D), SPH_C64(0xF8EC34C2FD7B9E5F),
+		SPH_C64(0xEA18CD3D58787724), SPH_C64(0xAAD515447CA67B86),
+		SPH_C64(0x9989695A9D97E14C), SPH_C64(0x0000000000000000),
+		SPH_C64(0xF196C63321F464EC), SPH_C64(0x71116BC169557CB5),
+		SPH_C64(0xAF887F466F92C7C1), SPH_C64(0x972E3E0FFE964D65),
+		SPH_C64(0x190EC4A8D536F915), SPH_C64(0x95AEF1A9522CA7B8),
+		SPH_C64(0xDC19DB21AA7D51A9), SPH_C64(0x94EE18FA0471D258),
+		SPH_C64(0x8087ADF248A11859), SPH_C64(0xC457F6DA2916DD5C),
+		SPH_C64(0xFA6CFB6451C17482), SPH_C64(0xF256E0C6DB13FBD1),
+		SPH_C64(0x6A9F60CF10D96F7D), SPH_C64(0x4DAAA9D9BD383FB6),
+		SPH_C64(0x03C026F5FAE79F3D), SPH_C64(0xDE99148706C7BB74),
+		SPH_C64(0x2A52B8B6340763DF), SPH_C64(0x6FC20ACD03EDD33A),
+		SPH_C64(0xD423C08320AFDEFA), SPH_C64(0xBBE1CA4E23420DC0),
+		SPH_C64(0x966ED75CA8CB3885), SPH_C64(0xEB58246E0E2502C4),
+		SPH_C64(0x055D6A021334BC47), SPH_C64(0xA47242111FA7D7AF),
+		SPH_C64(0xE3623FCC84F78D97), SPH_C64(0x81C744A11EFC6DB9),
+		SPH_C64(0xAEC8961539CFB221), SPH_C64(0xF31609958D4E8E31),
+		SPH_C64(0x63E5923ECC5695CE), SPH_C64(0x47107DDD9B505A38),
+		SPH_C64(0xA3AFE7B5A0298135), SPH_C64(0x792B7063E387F3E6),
+		SPH_C64(0x0140E953565D75E0), SPH_C64(0x12F4F9FFA503E97B),
+		SPH_C64(0x750CE8902C3CB512), SPH_C64(0xDBC47E8515F30733),
+		SPH_C64(0x1ED3610C6AB8AF8F), SPH_C64(0x5239218681DDE5D9),
+		SPH_C64(0xE222D69FD2AAF877), SPH_C64(0xFE71783514A8BD25),
+		SPH_C64(0xCAF0A18F4A177175), SPH_C64(0x61655D9860EC7F13),
+		SPH_C64(0xE77FBC9DC19E4430), SPH_C64(0x2CCFF441DDD440A5),
+		SPH_C64(0x16E97AAEE06A20DC), SPH_C64(0xA855DAE2D01C915B),
+		SPH_C64(0x1D1347F9905F30B2), SPH_C64(0xB7C652BDECF94B34),
+		SPH_C64(0xD03E43D265C6175D), SPH_C64(0xFDB15EC0EE4F2218),
+		SPH_C64(0x57644B8492E9599E), SPH_C64(0x07DDA5A4BF8E569A),
+		SPH_C64(0x54A46D71680EC6A3), SPH_C64(0x5624A2D7C4B42C7E),
+		SPH_C64(0xBEBCA04C3076B187), SPH_C64(0x7D36F332A6EE3A41),
+		SPH_C64(0x3B6667BC6BE31599), SPH_C64(0x695F463AEA3EF040),
+		SPH_C64(0xAD08B0E0C3282D1C), SPH_C64(0xB15B1E4A052A684E),
+		SPH_C64(0x44D05B2861B7C505), SPH_C64(0x15295C5B1A8DBFE1),
+		SPH_C64(0x744C01C37A61C0F2), SPH_C64(0x59C31CD1F1E8F5B7),
+		SPH_C64(0xEF45A73F4B4CCB63), SPH_C64(0x6BDF899C46841A9D),
+		SPH_C64(0x3DFB2B4B823036E3), SPH_C64(0xA2EF0EE6F674F4D5),
+		SPH_C64(0x184E2DFB836B8CF5), SPH_C64(0x1134DF0A5FE47646),
+		SPH_C64(0xBAA1231D751F7820), SPH_C64(0xD17EAA81339B62BD),
+		SPH_C64(0xB01BF71953771DAE), SPH_C64(0x849A2EA30DC8D1FE),
+		SPH_C64(0x705182923F080955), SPH_C64(0x0EA757556301AC29),
+		SPH_C64(0x041D83514569C9A7), SPH_C64(0x0ABAD4042668658E),
+		SPH_C64(0x49B72A88F851F611), SPH_C64(0x8A3D79F66EC97DD7),
+		SPH_C64(0xCD2D042BF59927EF), SPH_C64(0xC930877AB0F0EE48),
+		SPH_C64(0x9273540DEDA2F122), SPH_C64(0xC797D02FD3F14261),
+		SPH_C64(0xE1E2F06A284D674A), SPH_C64(0xD2BE8C74C97CFD80),
+		SPH_C64(0x9A494FAF67707E71), SPH_C64(0xB3DBD1ECA9908293),
+		SPH_C64(0x72D14D3493B2E388), SPH_C64(0xD6A30F258C153427)
+	}
+};
+
+/*
+ * Key schedule (K_1 to K_13) for the first block of a message: it only
+ * depends on the initial value (the counter N is then zero).
+ */
+static const sph_u64 streebog_K256[13][8] = {
+	{
+		SPH_C64(0x23C5EE40B07B5F15), SPH_C64(0x23C5EE40B07B5F15),
+		SPH_C64(0x23C5EE40B07B5F15), SPH_C64(0x23C5EE40B07B5F15),
+		SPH_C64(0x23C5EE40B07B5F15), SPH_C64(0x23C5EE40B07B5F15),
+		SPH_C64(0x23C5EE40B07B5F15), SPH_C64(0x23C5EE40B07B5F15)
+	},
+	{
+		SPH_C64(0x0C7D0CC39D4A5EB9), SPH_C64(0xE611D68C8401BFCD),
+		SPH_C64(0x9C7E6B5EEA633511), SPH_C64(0xDA22DE93A66A66B1),
+		SPH_C64(0x451CFAB6A904A549), SPH_C64(0x349769DF88BE26BF),
+		SPH_C64(0x3BD6CB8233694CEA), SPH_C64(0x18EE8F3176B2EBEA)
+	},
+	{
+		SPH_C64(0xFD74AF4101805F2D), SPH_C64(0xC7F68E73BA26FB00),
+		SPH_C64(0x915000CD674BE12C), SPH_C64(0xCE0913F1253E7757),
+		SPH_C64(0x940BBA1A519E9D1F), SPH_C64(0xBF27DEE21164C5E3),
+		SPH_C64(0x57AEC8CE91E7FD46), SPH_C64(0xAAA4CF31A2659591)
+	},
+	{
+		SPH_C64(0x8200311920839286), SPH_C64(0x2067FB5DDD6AC156),
+		SPH_C64(0x98D01EF0602B0E33), SPH_C64(0xCD801EA9DD743A0D),
+		SPH_C64(0xA54228AECA9C4585), SPH_C64(0xA5329A2236747BF8),
+		SPH_C64(0x0235E2AFADDED326), SPH_C64(0x61FE0A65CC177AF5)
+	},
+	{
+		SPH_C64(0x99A5D5309FE73D5A), SPH_C64(0xD595394CC199BF69),
+		SPH_C64(0x0A546ACD63D960BA), SPH_C64(0x169BD540AF75E161),
+		SPH_C64(0xE4693C86C06C7D4E), SPH_C64(0xE2934314AA2ECB3E),
+		SPH_C64(0x1FD5ABB75FBF26A8), SPH_C64(0x9983685F4FD3636F)
+	},
+	{
+		SPH_C64(0xBE297C13C0F7A156), SPH_C64(0xAF98C83C22CDB0E2),
+		SPH_C64(0xD170990A86602088), SPH_C64(0x62615D907EB0551A),
+		SPH_C64(0x922994E52820FFEA), SPH_C64(0xF1E735D613946E32),
+		SPH_C64(0x156C9A7FBCC6B8FD), SPH_C64(0xF05772AE2CE7F025)
+	},
+	{
+		SPH_C64(0xFCF03D9B81CFBB8D), SPH_C64(0x51A9B18CFC8E4098),
+		SPH_C64(0xB7B005A43E5959A6), SPH_C64(0xC89EB6B35167F159),
+		SPH_C64(0x0B2B8D0E6BE2B5AC), SPH_C64(0x7453E9C321197433),
+		SPH_C64(0x46B3E7688829FBB7), SPH_C64(0x5AD144C362546E4E)
+	},
+	{
+		SPH_C64(0xC1F191A539016DAA), SPH_C64(0xB0A0AD5790DFB73F),
+		SPH_C64(0x8D6C746ADCD5426F), SPH_C64(0x018287E5A9F509C7),
+		SPH_C64(0x83332FE0B8EFDAC9), SPH_C64(0x518C638ED530122A),
+		SPH_C64(0xB64FA840B934352B), SPH_C64(0x6A6CEC9A1BA20A8D)
+	},
+	{
+		SPH_C64(0x2B8FB6A8F5DD0409), SPH_C64(0x367D5F9437443538),
+		SPH_C64(0xD82E0E2069FC49ED), SPH_C64(0xBB4C9D580A224E9C),
+		SPH_C64(0xE35FA35FEE9DD8BD), SPH_C64(0xF351531F948F0FC5),
+		SPH_C64(0x8A8D6643F705BD51), SPH_C64(0x99217036737AA9B3)
+	},
+	{
+		SPH_C64(0xD74FE5393CCB05D2), SPH_C64(0xCA8FDF678FCB337B),
+		SPH_C64(0x76F83022F2526791), SPH_C64(0xF0B35D80A7317A7F),
+		SPH_C64(0xD703C35D2E62AEAF), SPH_C64(0x9A7630E8BFD6C3FE),
+		SPH_C64(0xE69288D8EC9E9DDA), SPH_C64(0x906763C0FC89FA1A)
+	},
+	{
+		SPH_C64(0x3D695C0BFC89ADD5), SPH_C64(0x159C8C624C3FE6E1),
+		SPH_C64(0x52CE34AF272F96D3), SPH_C64(0xD6A1DAE9A6DC6DDF),
+		SPH_C64(0xBFF3C29D38DADB6E), SPH_C64(0x4E2AE3EEE68991BB),
+		SPH_C64(0x04A5C8E03EE43385), SPH_C64(0x88CE996C63618E64)
+	},
+	{
+		SPH_C64(0x1D7B5A0F7655F2DB), SPH_C64(0xE75A49C68199112A),
+		SPH_C64(0x628E8365D8798477), SPH_C64(0xB55F30C79982CA45),
+		SPH_C64(0x76B978FCCAA32F38), SPH_C64(0x506AA168CF829157),
+		SPH_C64(0x3EEC550100576F3A), SPH_C64(0x3E0A281EA9BD4606)
+	},
+	{
+		SPH_C64(0xFCF9ECA06500BF03), SPH_C64(0x0EF9F5E03C907FA1),
+		SPH_C64(0x19FF433E76EF6ADB), SPH_C64(0x14B21CFFC51E3FA3),
+		SPH_C64(0x3F6CBAB54ED18B83), SPH_C64(0x62C848422B6A92F9),
+		SPH_C64(0xE432FBAE18672122), SPH_C64(0xF0B273409EB31AEB)
+	}
+};
+
+static const sph_u64 streebog_K512[13][8] = {
+	{
+		SPH_C64(0xB383FC2ECED4A574), SPH_C64(0xB383FC2ECED4A574),
+		SPH_C64(0xB383FC2ECED4A574), SPH_C64(0xB383FC2ECED4A574),
+		SPH_C64(0xB383FC2ECED4A574), SPH_C64(0xB383FC2ECED4A574),
+		SPH_C64(0xB383FC2ECED4A574), SPH_C64(0xB383FC2ECED4A574)
+	},
+	{
+		SPH_C64(0xF4D18AF70C46CF1E), SPH_C64(0x36F728BD1D7EEC33),
+		SPH_C64(0x3569CD2BA0513010), SPH_C64(0x88BE14F0B2DA2797),
+		SPH_C64(0xA73D010807DAE9C1), SPH_C64(0xE0E902D23AEF2EE9),
+		SPH_C64(0x13F2C3EBC774E80D), SPH_C64(0xD0B00807642FD78F)
+	},
+	{
+		SPH_C64(0x816DBAF927B8FCA9), SPH_C64(0xE24E7D636EB1607E),
+		SPH_C64(0x2D61014A1B5C9FC9), SPH_C64(0x1A9387ECC257930E),
+		SPH_C64(0x6681105E2D13712A), SPH_C64(0x44ECF66716D3A0F1),
+		SPH_C64(0xB0E8B7DAC6EF6E6B), SPH_C64(0x9D4475C7899F2D0B)
+	},
+	{
+		SPH_C64(0x782487DEFD83CA0F), SPH_C64(0x3370D0A3D6194AC5),
+		SPH_C64(0xC8CDE3B8BF78F95F), SPH_C64(0xDF9F8055FFE3C004),
+		SPH_C64(0x73E58856BD96A72F), SPH_C64(0xDAE2E40CC4C3219C),
+		SPH_C64(0x3B8C833C48E1C670), SPH_C64(0x5C283DABA5EC1F23)
+	},
+	{
+		SPH_C64(0xEB5FFC818826470C), SPH_C64(0x36FA7CBA93F8239C),
+		SPH_C64(0x046388469AE195C4), SPH_C64(0x2FD97D7493784779),
+		SPH_C64(0x1FAB4E37225292EC), SPH_C64(0xD4D2964FA18D42C4),
+		SPH_C64(0x569CBC9317BAA551), SPH_C64(0x109F33262731F9BD)
+	},
+	{
+		SPH_C64(0x85D30D99F286C5E7), SPH_C64(0x459BC382573AEE2D),
+		SPH_C64(0x37555C676C153D99), SPH_C64(0x3E1135CFBEFE2442),
+		SPH_C64(0xC6B5DA70B1B87474), SPH_C64(0x57E25026CCF41E67),
+		SPH_C64(0x8F8A0877BE9A1707), SPH_C64(0xB32C9B02667911CF)
+	},
+	{
+		SPH_C64(0x1502E634559E32F1), SPH_C64(0xD6B01E17285EB7E6),
+		SPH_C64(0xC9C7AAD694EDC922), SPH_C64(0x6C8207594714E8E9),
+		SPH_C64(0xCE6050FCBABDC234), SPH_C64(0xC7B00E4F3F62765E),
+		SPH_C64(0xAC49989E7D84B08B), SPH_C64(0x8A13C1B195FD0886)
+	},
+	{
+		SPH_C64(0x71DFF8DE5D128CAC), SPH_C64(0x617FF01CC546728E),
+		SPH_C64(0x56C342034773023D), SPH_C64(0x4C47F7A9E13BB1DB),
+		SPH_C64(0xA5ACBFFD323EC376), SPH_C64(0x8730CB9179D6DECE),
+		SPH_C64(0x17D0DDFBC926F2E8), SPH_C64(0x52CEC3B11448BB86)
+	},
+	{
+		SPH_C64(0x1C6088AFA1A1E735), SPH_C64(0xC01FC415E3FB7DC6),
+		SPH_C64(0x91D70103F48FD4D4), SPH_C64(0xD4D7104453896712),
+		SPH_C64(0x38B963BBB7F28E74), SPH_C64(0xB9C243CB82154AA1),
+		SPH_C64(0x502007A05EA64A4E), SPH_C64(0xF38C5B7947E7736D)
+	},
+	{
+		SPH_C64(0xA7EEF99F6068B315), SPH_C64(0xD0687948286CFEFA),
+		SPH_C64(0x1DD30C24C1AB877A), SPH_C64(0xA5E61BB465459958),
+		SPH_C64(0x0617CECBADDD618E), SPH_C64(0x6B6E18E40CDAABD3),
+		SPH_C64(0x257DD6E3DB7C1BF5), SPH_C64(0x0740B3FAA03ED39B)
+	},
+	{
+		SPH_C64(0x1A82164893313116), SPH_C64(0x107BB3AA56441AF1),
+		SPH_C64(0x96E9695CE8957837), SPH_C64(0xE374F088F2E5C294),
+		SPH_C64(0x3AD71E5FCA678E45), SPH_C64(0x47011BF92B95910A),
+		SPH_C64(0xC8CFDFCAE9DBB293), SPH_C64(0x185811CF3C2633AE)
+	},
+	{
+		SPH_C64(0x076451901279EE4C), SPH_C64(0x427052FA345613FD),
+		SPH_C64(0x760B251F4DB5CDEF), SPH_C64(0xC9A1EAB800FB8CC5),
+		SPH_C64(0xD2F206906B5EE00D), SPH_C64(0x0FEDD87189B75B3C),
+		SPH_C64(0x6C3B2120D2A3F15E), SPH_C64(0x9D46BF66234A7ED0)
+	},
+	{
+		SPH_C64(0x0D76B621CB45BE70), SPH_C64(0xA3CBC28FD94F9546),
+		SPH_C64(0x90BF612558B4B60A), SPH_C64(0x7782EF127CD6B982),
+		SPH_C64(0xD2D8565ADA926C3F), SPH_C64(0x61E3C585B3A405A6),
+		SPH_C64(0xD768B6E223484C97), SPH_C64(0x0F79104026B900D8)
+	}
+};
+
+static const sph_u64 streebog_zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+#define STREEBOG_TB(r, j, i) \
+	streebog_T[j][(unsigned)((r)[j] >> (8 * (i))) & 0xFF]
+
+#define STREEBOG_ROW(r, i)   (STREEBOG_TB(r, 0, i) ^ STREEBOG_TB(r, 1, i) \
+	^ STREEBOG_TB(r, 2, i) ^ STREEBOG_TB(r, 3, i) ^ STREEBOG_TB(r, 4, i) \
+	^ STREEBOG_TB(r, 5, i) ^ STREEBOG_TB(r, 6, i) ^ STREEBOG_TB(r, 7, i))
+
+/*
+ * d = LPS(a ^ b); d may be the same array as a or b.
+ */
+static SPH_INLINE void
+streebog_xlps(sph_u64 *d, const sph_u64 *a, const sph_u64 *b)
+{
+	sph_u64 r[8];
+
+	r[0] = a[0] ^ b[0];
+	r[1] = a[1] ^ b[1];
+	r[2] = a[2] ^ b[2];
+	r[3] = a[3] ^ b[3];
+	r[4] = a[4] ^ b[4];
+	r[5] = a[5] ^ b[5];
+	r[6] = a[6] ^ b[6];
+	r[7] = a[7] ^ b[7];
+	d[0] = STREEBOG_ROW(r, 0);
+	d[1] = STREEBOG_ROW(r, 1);
+	d[2] = STREEBOG_ROW(r, 2);
+	d[3] = STREEBOG_ROW(r, 3);
+	d[4] = STREEBOG_ROW(r, 4);
+	d[5] = STREEBOG_ROW(r, 5);
+	d[6] = STREEBOG_ROW(r, 6);
+	d[7] = STREEBOG_ROW(r, 7);
+}
+
+/*
+ * Compression function: h = g_N(h, m). If ks is not NULL, then it
+ * contains the key schedule (K_1 to K_13) for the current h and N,
+ * and N is not used.
+ */
+static void
+streebog_g(sph_u64 h[8], const sph_u64 N[8], const sph_u64 m[8],
+	const sph_u64 (*ks)[8])
+{
+	sph_u64 K[8], t[8];
+	int i;
+
+	if (ks != NULL) {
+		streebog_xlps(t, ks[0], m);
+		for (i = 1; i < 12; i ++)
+			streebog_xlps(t, ks[i], t);
+		for (i = 0; i < 8; i ++)
+			h[i] ^= t[i] ^ ks[12][i] ^ m[i];
+		return;
+	}
+	streebog_xlps(K, h, N);
+	streebog_xlps(t, K, m);
+	for (i = 0; i < 11; i ++) {
+		streebog_xlps(K, K, streebog_C[i]);
+		streebog_xlps(t, K, t);
+	}
+	streebog_xlps(K, K, streebog_C[11]);
+	for (i = 0; i < 8; i ++)
+		h[i] ^= t[i] ^ K[i] ^ m[i];
+}
+
+/*
+ * Addition modulo 2^512 (little-endian words).
+ */
+static void
+streebog_add(sph_u64 s[8], const sph_u64 m[8])
+{
+	sph_u64 c;
+	int i;
+
+	c = 0;
+	for (i = 0; i < 8; i ++) {
+		sph_u64 t, u;
+
+		t = SPH_T64(s[i] + m[i]);
+		u = SPH_T64(t + c);
+		c = (sph_u64)(t < s[i]) | (sph_u64)(u < t);
+		s[i] = u;
+	}
+}
+
+/*
+ * Add a small value (a bit count) modulo 2^512.
+ */
+static void
+streebog_addn(sph_u64 s[8], unsigned n)
+{
+	int i;
+
+	s[0] = SPH_T64(s[0] + n);
+	if (s[0] >= n)
+		return;
+	for (i = 1; i < 8; i ++)
+		if ((s[i] = SPH_T64(s[i] + 1)) != 0)
+			break;
+}
+
+static void
+streebog_init(sph_gost512_context *sc, sph_u64 iv)
+{
+	int i;
+
+	sc->ptr = 0;
+	for (i = 0; i < 8; i ++) {
+		sc->h[i] = iv;
+		sc->N[i] = 0;
+		sc->S[i] = 0;
+	}
+}
+
+/*
+ * Process one block; ks0 is the key schedule for the first block.
+ */
+static void
+streebog_block(sph_gost512_context *sc, const unsigned char *p,
+	const sph_u64 (*ks0)[8])
+{
+	sph_u64 m[8];
+	int i;
+
+	SPH_STATS_BLOCKS(SPH_STATS_STREEBOG, 1);
+	for (i = 0; i < 8; i ++)
+		m[i] = sph_dec64le(p + 8 * i);
+	streebog_g(sc->h, sc->N, m,
+		(sc->N[0] | sc->N[1] | sc->N[2] | sc->N[3] | sc->N[4]
+		| sc->N[5] | sc->N[6] | sc->N[7]) == 0 ? ks0 : NULL);
+	streebog_addn(sc->N, 512);
+	streebog_add(sc->S, m);
+}
+
+static void
+streebog_update(sph_gost512_context *sc, const void *data, size_t len,
+	const sph_u64 (*ks0)[8])
+{
+	const unsigned char *buf;
+
+	buf = data;
+	if (sc->ptr > 0) {
+		size_t clen;
+
+		clen = (sizeof sc->buf) - sc->ptr;
+		if (clen > len)
+			clen = len;
+		memcpy(sc->buf + sc->ptr, buf, clen);
+		sc->ptr += clen;
+		buf += clen;
+		len -= clen;
+		if (sc->ptr < sizeof sc->buf)
+			return;
+		streebog_block(sc, sc->buf, ks0);
+		sc->ptr = 0;
+	}
+	while (len >= sizeof sc->buf) {
+		streebog_block(sc, buf, ks0);
+		buf += sizeof sc->buf;
+		len -= sizeof sc->buf;
+	}
+	memcpy(sc->buf, buf, len);
+	sc->ptr = len;
+}
+
+/*
+ * Write the last "ow" words of h (little-endian).
+ */
+static void
+streebog_out(const sph_u64 h[8], void *dst, unsigned ow)
+{
+	unsigned i;
+
+	for (i = 0; i < ow; i ++)
+		sph_enc64le((unsigned char *)dst + 8 * i, h[8 - ow + i]);
+}
+
+static void
+streebog_close(sph_gost512_context *sc, void *dst,
+	const sph_u64 (*ks0)[8], unsigned ow)
+{
+	sph_u64 m[8];
+	size_t ptr;
+	int i;
+
+	SPH_STATS_BLOCKS(SPH_STATS_STREEBOG, 1);
+	ptr = sc->ptr;
+	sc->buf[ptr] = 0x01;
+	memset(sc->buf + ptr + 1, 0, (sizeof sc->buf) - ptr - 1);
+	for (i = 0; i < 8; i ++)
+		m[i] = sph_dec64le(sc->buf + 8 * i);
+	streebog_g(sc->h, sc->N, m,
+		(sc->N[0] | sc->N[1] | sc->N[2] | sc->N[3] | sc->N[4]
+		| sc->N[5] | sc->N[6] | sc->N[7]) == 0 ? ks0 : NULL);
+	streebog_addn(sc->N, (unsigned)ptr << 3);
+	streebog_add(sc->S, m);
+	streebog_g(sc->h, streebog_zero, sc->N, NULL);
+	streebog_g(sc->h, streebog_zero, sc->S, NULL);
+	streebog_out(sc->h, dst, ow);
+}
+
+/*
+ * Hash exactly one block: the message block is processed with the
+ * precomputed key schedule, then the padding block (0x01 followed by
+ * zeros) with N = 512, and the final values are N = 512 and S = m + 1.
+ */
+static void
+streebog_hash64(const void *data, void *dst, sph_u64 iv,
+	const sph_u64 (*ks0)[8], unsigned ow)
+{
+	sph_u64 h[8], m[8], N[8];
+	int i;
+
+	SPH_STATS_INPUT(SPH_STATS_STREEBOG, 64);
+	for (i = 0; i < 8; i ++) {
+		h[i] = iv;
+		m[i] = sph_dec64le((const unsigned char *)data + 8 * i);
+		N[i] = 0;
+	}
+	streebog_g(h, NULL, m, ks0);
+	SPH_STATS_BLOCKS(SPH_STATS_STREEBOG, 2);
+	N[0] = 512;
+	streebog_addn(m, 1);
+	{
+		sph_u64 pad[8];
+
+		pad[0] = 1;
+		for (i = 1; i < 8; i ++)
+			pad[i] = 0;
+		streebog_g(h, N, pad, NULL);
+	}
+	streebog_g(h, streebog_zero, N, NULL);
+	streebog_g(h, streebog_zero, m, NULL);
+	streebog_out(h, dst, ow);
+}
+
+#define STREEBOG_IV256   SPH_C64(0x0101010101010101)
+#define STREEBOG_IV512   SPH_C64(0x0000000000000000)
+
+/* see sph_streebog.h */
+void
+sph_gost256_init(void *cc)
+{
+	streebog_init(cc, STREEBOG_IV256);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost256(void *cc, const void *data, size_t len)
+{
+	SPH_STATS_INPUT(SPH_STATS_STREEBOG, len);
+	streebog_update(cc, data, len, streebog_K256);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost256_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_gost256, cc, iov, n);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost256_close(void *cc, void *dst)
+{
+	streebog_close(cc, dst, streebog_K256, 4);
+	sph_gost256_init(cc);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost256_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(gost256, data, len, dst);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost256_hash64(const void *data, void *dst)
+{
+	streebog_hash64(data, dst, STREEBOG_IV256, streebog_K256, 4);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512_init(void *cc)
+{
+	streebog_init(cc, STREEBOG_IV512);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512(void *cc, const void *data, size_t len)
+{
+	SPH_STATS_INPUT(SPH_STATS_STREEBOG, len);
+	streebog_update(cc, data, len, streebog_K512);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512_updatev(void *cc, const sph_iovec *iov, int n)
+{
+	SPH_UPDATEV(sph_gost512, cc, iov, n);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512_close(void *cc, void *dst)
+{
+	streebog_close(cc, dst, streebog_K512, 8);
+	sph_gost512_init(cc);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512_oneshot(const void *data, size_t len, void *dst)
+{
+	SPH_ONESHOT(gost512, data, len, dst);
+}
+
+/* see sph_streebog.h */
+void
+sph_gost512_hash64(const void *data, void *dst)
+{
+	streebog_hash64(data, dst, STREEBOG_IV512, streebog_K512, 8);
+}
+#endif
@@ -0,0 +1,114 @@
+/* $Id$ */
+/*
+ * Unit tests for batched hashing.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_batch.h"
+#include "sph_sha2.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+#define NUM   300
+
+/*
+ * Each algorithm hashes NUM messages (more than the internal slice) of
+ * lengths which repeat out of order, so that the messages are reordered,
+ * and are checked against sph_XXX_oneshot() through the SHA-256 case
+ * and against single-message batches for all identifiers.
+ */
+static void
+test_batch(void)
+{
+	static unsigned char msg[NUM + 1][200], res[NUM][64];
+	unsigned char ref[64];
+	const void *data[NUM];
+	size_t len[NUM];
+	void *dst[NUM], *one;
+	size_t u, w;
+	unsigned a;
+
+	for (u = 0; u < NUM; u ++) {
+		for (w = 0; w < 200; w ++)
+			msg[u][w] = (unsigned char)(u * 17 + w * 5 + (w >> 3));
+		data[u] = msg[u] + (u & 3);
+		len[u] = (u * 37) % 197;
+		dst[u] = res[u];
+	}
+	one = msg[NUM];
+
+	ASSERT(sph_hash_size(SPH_HASH_SHA256) == 32);
+	ASSERT(sph_hash_size(SPH_HASH_NUM) == 0);
+	sph_hash_batch(SPH_HASH_SHA256, data, len, dst, NUM);
+	for (u = 0; u < NUM; u ++) {
+		sph_sha256_oneshot(data[u], len[u], ref);
+		if (!utest_byteequal(res[u], ref, 32))
+			fail("batch: SHA-256 mismatch (message %u)",
+				(unsigned)u);
+	}
+
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (a = 0; a < SPH_HASH_NUM; a ++) {
+			size_t hlen;
+
+			hlen = sph_hash_size(a);
+			ASSERT(hlen >= 16 && hlen <= 64);
+			memset(res, 0, sizeof res);
+			sph_hash_batch(a, data, len, dst, NUM);
+			for (u = 0; u < NUM; u ++) {
+				sph_hash_batch(a, data + u, len + u,
+					&one, 1);
+				if (!utest_byteequal(res[u], msg[NUM], hlen))
+					fail("batch: mismatch (mask %x,"
+						" algorithm %u, message %u)",
+						multi_cpu_masks[w], a,
+						(unsigned)u);
+			}
+		}
+	}
+	sph_cpu_set_mask(~0U);
+}
+
+UTEST_MAIN("batched hashing", test_batch)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: batched hashing is not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
@@ -40,6 +40,13 @@ TEST_DIGEST_NIST(BMW-384, bmw384, 48)
 TEST_DIGEST_NIST(BMW-512, bmw512, 64)
 #endif
 
+TEST_DIGEST_MULTI(BMW-224, bmw224, 28)
+TEST_DIGEST_MULTI(BMW-256, bmw256, 32)
+#if SPH_64
+TEST_DIGEST_MULTI(BMW-384, bmw384, 48)
+TEST_DIGEST_MULTI(BMW-512, bmw512, 64)
+#endif
+
 static char *const nist_vec224[] = {
 	"E57C183DA7E2CD3E90258CA04499B222420F9B6797BBAB131B4D286E",
 	"FBFE1125D0A9D15853B66AADAFC3CF073836DAD7E09E5EB80160F7D7",
@@ -8262,6 +8269,12 @@ test_bmw(void)
 		test_bmw384_nist(u, nist_vec384[u]);
 	for (u = 0; u < 2048; u ++)
 		test_bmw512_nist(u, nist_vec512[u]);
+#endif
+	test_bmw224_multi();
+	test_bmw256_multi();
+#if SPH_64
+	test_bmw384_multi();
+	test_bmw512_multi();
 #endif
 }
 
@@ -0,0 +1,188 @@
+/* $Id$ */
+/*
+ * Unit tests for chained hashing.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_chain.h"
+#include "sph_blake.h"
+#include "sph_sha2.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+#define NUM     300
+#define STEPS    16
+
+/*
+ * Internal batch size of sph_chain_multi().
+ */
+#define CHAIN_BATCH   256
+
+static const unsigned char aes_order[] = {
+	SPH_CHAIN_GROESTL, SPH_CHAIN_SHAVITE, SPH_CHAIN_ECHO
+};
+
+/*
+ * Each chain uses an order derived from its own message, so that the
+ * groups differ at every step. NUM exceeds the internal batch size.
+ */
+static void
+test_chain(void)
+{
+	static unsigned char msg[NUM][80], res[NUM][64], ref[64];
+	static unsigned char order[NUM * STEPS], saved[NUM * STEPS];
+	const void *data[NUM];
+	size_t len[NUM];
+	void *dst[NUM];
+	sph_chain_stats st;
+	sph_blake512_context bc;
+	sph_sha512_context sc;
+	unsigned long calls, lanes;
+	size_t u, w;
+	unsigned a;
+
+	for (u = 0; u < NUM; u ++) {
+		for (w = 0; w < 80; w ++)
+			msg[u][w] = (unsigned char)(u * 31 + w * 7 + (u >> 3));
+		for (w = 0; w < STEPS; w ++)
+			order[u * STEPS + w] = (unsigned char)
+				((msg[u][w >> 1] >> ((w & 1) << 2)) & 0x0F);
+		data[u] = msg[u];
+		len[u] = u < 10 ? u : 80;
+		dst[u] = res[u];
+	}
+
+	/*
+	 * Two-step chain against the individual functions.
+	 */
+	order[0] = SPH_CHAIN_BLAKE;
+	order[1] = SPH_CHAIN_SHA512;
+	sph_blake512_init(&bc);
+	sph_blake512(&bc, msg[0], len[0]);
+	sph_blake512_close(&bc, ref);
+	sph_sha512_init(&sc);
+	sph_sha512(&sc, ref, 64);
+	sph_sha512_close(&sc, ref);
+	sph_chain(msg[0], len[0], res[0], order, 2);
+	ASSERT(utest_byteequal(res[0], ref, 64));
+
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		memset(res, 0, sizeof res);
+		memset(&st, 0, sizeof st);
+		sph_chain_multi(data, len, dst, NUM, order, STEPS, &st);
+		for (u = 0; u < NUM; u ++) {
+			sph_chain(msg[u], len[u], ref, order + u * STEPS, STEPS);
+			if (!utest_byteequal(res[u], ref, 64))
+				fail("chain multi: mismatch (mask %x,"
+					" chain %u)", multi_cpu_masks[w],
+					(unsigned)u);
+		}
+		calls = lanes = 0;
+		for (a = 0; a < SPH_CHAIN_NUM; a ++) {
+			calls += st.calls[a];
+			lanes += st.lanes[a];
+		}
+		ASSERT(lanes == (unsigned long)NUM * STEPS);
+		ASSERT(calls <= 2UL * STEPS * SPH_CHAIN_NUM);
+	}
+	sph_cpu_set_mask(~0U);
+
+	/*
+	 * Chains which all use the same AES-based algorithms (Groestl,
+	 * SHAvite and ECHO), so that every step is one full group for the
+	 * multi-message code of the algorithm.
+	 */
+	memcpy(saved, order, sizeof order);
+	for (u = 0; u < NUM; u ++)
+		for (w = 0; w < STEPS; w ++)
+			order[u * STEPS + w] = aes_order[w % 3];
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		memset(res, 0, sizeof res);
+		memset(&st, 0, sizeof st);
+		sph_chain_multi(data, len, dst, NUM, order, STEPS, &st);
+		for (u = 0; u < NUM; u ++) {
+			sph_chain(msg[u], len[u], ref, order + u * STEPS, STEPS);
+			if (!utest_byteequal(res[u], ref, 64))
+				fail("chain multi: AES mismatch (mask %x,"
+					" chain %u)", multi_cpu_masks[w],
+					(unsigned)u);
+		}
+		for (a = 0; a < 3; a ++) {
+			unsigned long n;
+
+			n = (STEPS + 2 - a) / 3;
+			ASSERT(st.lanes[aes_order[a]] == n * NUM);
+			ASSERT(st.calls[aes_order[a]] == n
+				* ((NUM + CHAIN_BATCH - 1) / CHAIN_BATCH));
+		}
+	}
+	sph_cpu_set_mask(~0U);
+	memcpy(order, saved, sizeof order);
+
+	/*
+	 * Output over the input.
+	 */
+	sph_chain(msg[20], 80, ref, order + 20 * STEPS, STEPS);
+	dst[20] = msg[20];
+	sph_chain_multi(data + 20, len + 20, dst + 20, 1,
+		order + 20 * STEPS, STEPS, NULL);
+	ASSERT(utest_byteequal(msg[20], ref, 64));
+
+	/*
+	 * Invalid identifiers are rejected before anything is written.
+	 */
+	memcpy(ref, res[5], 64);
+	order[5 * STEPS + STEPS - 1] = SPH_CHAIN_NUM;
+	ASSERT(!sph_chain(msg[5], 80, res[5], order + 5 * STEPS, STEPS));
+	ASSERT(!sph_chain_multi(data, len, dst, NUM, order, STEPS, NULL));
+	ASSERT(utest_byteequal(res[5], ref, 64));
+	order[5 * STEPS + STEPS - 1] = 0xFF;
+	ASSERT(!sph_chain_multi(data, len, dst, NUM, order, STEPS, NULL));
+	ASSERT(utest_byteequal(res[5], ref, 64));
+}
+
+UTEST_MAIN("chained hashing", test_chain)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: chained hashing is not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
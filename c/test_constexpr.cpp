@@ -0,0 +1,111 @@
+/* $Id$ */
+/*
+ * Unit tests for the compile-time hash functions (C++).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "sph_constexpr.hpp"
+
+extern "C" {
+#include "sph_blake.h"
+#include "sph_keccak.h"
+#include "sph_sha2.h"
+#include "utest.h"
+}
+
+/*
+ * A Solidity function selector: the first four bytes of Keccak-256.
+ */
+static_assert(sph::cx::prefix32(
+	sph::cx::keccak256("transfer(address,uint256)")) == 0xA9059CBB,
+	"Keccak-256 selector");
+
+static_assert(sph::cx::prefix32(sph::cx::sha256("abc")) == 0xBA7816BF,
+	"SHA-256 of abc");
+
+static constexpr std::array<unsigned char, 3> abc = { 'a', 'b', 'c' };
+static_assert(sph::cx::prefix32(sph::cx::sha256(abc)) == 0xBA7816BF,
+	"SHA-256 of abc (bytes)");
+
+/*
+ * Messages of all lengths up to a few blocks of each function (so
+ * that the padding lands at every position) are hashed at runtime with
+ * the constexpr code and compared with the C code.
+ */
+static void
+test_constexpr(void)
+{
+	static char name[] = "constexpr mismatch (%s, length %u)";
+	static char s256[] = "SHA-256", k256[] = "Keccak-256",
+		b256[] = "BLAKE-256";
+	static char msg[300];
+	unsigned char ref[32];
+	sph::cx::digest d;
+	unsigned u;
+
+	for (u = 0; u < sizeof msg; u ++)
+		msg[u] = static_cast<char>(u * 7 + 1);
+	for (u = 0; u <= sizeof msg; u ++) {
+		std::string_view s(msg, u);
+
+		sph_sha256_oneshot(msg, u, ref);
+		d = sph::cx::sha256(s);
+		if (std::memcmp(d.data(), ref, 32) != 0)
+			fail(name, s256, u);
+		sph_keccak256_oneshot(msg, u, ref);
+		d = sph::cx::keccak256(s);
+		if (std::memcmp(d.data(), ref, 32) != 0)
+			fail(name, k256, u);
+		sph_blake256_oneshot(msg, u, ref);
+		d = sph::cx::blake256(s);
+		if (std::memcmp(d.data(), ref, 32) != 0)
+			fail(name, b256, u);
+	}
+
+	/*
+	 * A digest computed by the compiler.
+	 */
+	constexpr sph::cx::digest k = sph::cx::keccak256("sphlib");
+	sph_keccak256_oneshot("sphlib", 6, ref);
+	if (std::memcmp(k.data(), ref, 32) != 0)
+		fail(name, k256, 6);
+}
+
+int
+main(void)
+{
+	static char name[] = "compile-time hashing";
+
+	utest_setname(name);
+	test_constexpr();
+	utest_success();
+	return 0;
+}
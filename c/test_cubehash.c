@@ -38,6 +38,11 @@ TEST_DIGEST_NIST(CubeHash-256, cubehash256, 32)
 TEST_DIGEST_NIST(CubeHash-384, cubehash384, 48)
 TEST_DIGEST_NIST(CubeHash-512, cubehash512, 64)
 
+TEST_DIGEST_MULTI(CubeHash-224, cubehash224, 28)
+TEST_DIGEST_MULTI(CubeHash-256, cubehash256, 32)
+TEST_DIGEST_MULTI(CubeHash-384, cubehash384, 48)
+TEST_DIGEST_MULTI(CubeHash-512, cubehash512, 64)
+
 static char *const nist_vec224[] = {
 	"F9802AA6955F4B7CF3B0F5A378FA0C9F138E0809D250966879C873AB",
 	"BA87946124E457A0A7B99E90275C4DD284A2611107F94F07950821ED",
@@ -8245,16 +8250,29 @@ static char *const nist_vec512[] = {
 static void
 test_cubehash(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_cubehash224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_cubehash256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_cubehash384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_cubehash512_nist(u, nist_vec512[u]);
+	/*
+	 * The single-message code has vector variants, selected at
+	 * runtime; all of them are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_cubehash224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_cubehash256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_cubehash384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_cubehash512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
+	test_cubehash224_multi();
+	test_cubehash256_multi();
+	test_cubehash384_multi();
+	test_cubehash512_multi();
 }
 
 UTEST_MAIN("CubeHash", test_cubehash)
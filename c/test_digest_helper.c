@@ -34,14 +34,33 @@
 #include <stdlib.h>
 #include <string.h>
 #include "utest.h"
+#include "sph_cpu.h"
+
+/*
+ * Feed len bytes at p to the context mc with sph_XXX_updatev(), as
+ * three fragments (the first one covers a third of the data, the second
+ * one a sixth; both may be empty for short data).
+ */
+#define UPDATEV_SPLIT(cname, mc, p, len)   do { \
+		sph_iovec iov[3]; \
+ \
+		iov[0].iov_base = (p); \
+		iov[0].iov_len = (len) / 3; \
+		iov[1].iov_base = (unsigned char *)(p) + (len) / 3; \
+		iov[1].iov_len = (len) / 2 - (len) / 3; \
+		iov[2].iov_base = (unsigned char *)(p) + (len) / 2; \
+		iov[2].iov_len = (len) - (len) / 2; \
+		sph_ ## cname ## _updatev(&(mc), iov, 3); \
+	} while (0)
 
 /*
  * This macro defines a function which verifies a test vector. The input
  * data is an ASCII string; the reference string is the hexadecimal
  * representation of the expected binary output. Hashing is done twice,
  * in order to exercise functions with misaligned input, as well as
- * proper state reinitialization. The announced output length is also
- * checked against the output size macro.
+ * proper state reinitialization, then a third time with the data split
+ * into fragments, and a fourth time with sph_XXX_oneshot(). The
+ * announced output length is also checked against the output size macro.
  */
 #define TEST_DIGEST_INTERNAL(Name, cname, blen) \
 static void \
@@ -71,6 +90,13 @@ test_ ## cname ## _internal(char *data, char *refres) \
 	sph_ ## cname(&mc, dbuf + 1, dbuf_len); \
 	sph_ ## cname ## _close(&mc, res); \
 	ASSERT(utest_byteequal(res, ref, blen)); \
+	memset(res, 0, sizeof res); \
+	UPDATEV_SPLIT(cname, mc, dbuf + 1, dbuf_len); \
+	sph_ ## cname ## _close(&mc, res); \
+	ASSERT(utest_byteequal(res, ref, blen)); \
+	memset(res, 0, sizeof res); \
+	sph_ ## cname ## _oneshot(dbuf + 1, dbuf_len, res); \
+	ASSERT(utest_byteequal(res, ref, blen)); \
 	free(dbuf); \
 }
 
@@ -174,6 +200,21 @@ test_ ## cname ## _nist(unsigned u, char *refres) \
 			dbuf[dbuf_len], extra, res); \
 	} \
 	ASSERT(utest_byteequal(res, ref, blen)); \
+	memset(res, 0, sizeof res); \
+	if (extra == 0) { \
+		UPDATEV_SPLIT(cname, mc, dbuf + 1, dbuf_len); \
+		sph_ ## cname ## _close(&mc, res); \
+	} else { \
+		UPDATEV_SPLIT(cname, mc, dbuf + 1, dbuf_len - 1); \
+		sph_ ## cname ## _addbits_and_close(&mc, \
+			dbuf[dbuf_len], extra, res); \
+	} \
+	ASSERT(utest_byteequal(res, ref, blen)); \
+	if (extra == 0) { \
+		memset(res, 0, sizeof res); \
+		sph_ ## cname ## _oneshot(dbuf + 1, dbuf_len, res); \
+		ASSERT(utest_byteequal(res, ref, blen)); \
+	} \
 }
 
 /*
@@ -224,3 +265,75 @@ test_ ## cname ## _nist(unsigned u, char *refres) \
 		sph_ ## cname ## _close(&sc, res2); \
 		ASSERT(utest_byteequal(res1, res2, blen)); \
 	} while (0)
+
+/*
+ * Feature masks under which the multi-message functions are tested:
+ * everything the CPU supports, then progressively narrower vector
+ * units, down to the portable code. The AES instructions are also
+ * removed on their own, for the code which replaces them with SSSE3.
+ */
+static const unsigned multi_cpu_masks[] = {
+	~0U,
+	~(unsigned)SPH_CPU_AVX512,
+	~(unsigned)(SPH_CPU_AVX2 | SPH_CPU_AVX512 | SPH_CPU_VAES),
+	~(unsigned)(SPH_CPU_AESNI | SPH_CPU_VAES),
+	0
+};
+
+/*
+ * This macro defines a function which checks the multi-message function
+ * sph_XXX_multi() against the one-message API, for batches of equal
+ * lengths (around block boundaries) and for batches of distinct
+ * lengths. The number of messages is chosen so that it is not a
+ * multiple of the number of lanes. Message data is misaligned.
+ */
+#define TEST_DIGEST_MULTI(Name, cname, blen) \
+static void \
+test_ ## cname ## _multi(void) \
+{ \
+	static const size_t lens[] = { \
+		0, 1, 3, 31, 32, 55, 56, 63, 64, 65, 100, 111, 112, \
+		119, 120, 127, 128, 129, 200, 255, 256, 257, 1000 \
+	}; \
+	unsigned char buf[1200 + 16]; \
+	unsigned char res[19][blen], ref[blen]; \
+	const void *data[19]; \
+	size_t len[19]; \
+	void *dst[19]; \
+	size_t u, v, w; \
+ \
+	for (u = 0; u < sizeof buf; u ++) \
+		buf[u] = (unsigned char)(u * 7 + (u >> 8) * 13 + 1); \
+	for (w = 0; w < (sizeof multi_cpu_masks) \
+		/ sizeof multi_cpu_masks[0]; w ++) { \
+		sph_cpu_set_mask(multi_cpu_masks[w]); \
+		for (u = 0; u <= (sizeof lens) / sizeof lens[0]; u ++) { \
+			for (v = 0; v < 19; v ++) { \
+				data[v] = buf + 1 + v; \
+				if (u < (sizeof lens) / sizeof lens[0]) \
+					len[v] = lens[u]; \
+				else \
+					len[v] = lens[(v * 5) % ((sizeof lens) \
+						/ sizeof lens[0])]; \
+				dst[v] = res[v]; \
+			} \
+			memset(res, 0, sizeof res); \
+			sph_ ## cname ## _multi(data, len, dst, 19); \
+			for (v = 0; v < 19; v ++) { \
+				sph_ ## cname ## _context mc; \
+ \
+				sph_ ## cname ## _init(&mc); \
+				sph_ ## cname(&mc, data[v], len[v]); \
+				sph_ ## cname ## _close(&mc, ref); \
+				if (!utest_byteequal(res[v], ref, blen)) \
+					fail("%s multi: mismatch (mask %x," \
+						" message %u, length %u)", \
+						#Name, multi_cpu_masks[w], \
+						(unsigned)v, \
+						(unsigned)len[v]); \
+			} \
+		} \
+	} \
+	sph_cpu_set_mask(~0U); \
+}
+
@@ -37,6 +37,8 @@ TEST_DIGEST_NIST(ECHO-224, echo224, 28)
 TEST_DIGEST_NIST(ECHO-256, echo256, 32)
 TEST_DIGEST_NIST(ECHO-384, echo384, 48)
 TEST_DIGEST_NIST(ECHO-512, echo512, 64)
+TEST_DIGEST_MULTI(ECHO-384, echo384, 48)
+TEST_DIGEST_MULTI(ECHO-512, echo512, 64)
 
 static char *const nist_vec224[] = {
 	"17DA087595166F733FFF7CDB0BCA6438F303D0E00C48B5E7A3075905",
@@ -8245,16 +8247,27 @@ static char *const nist_vec512[] = {
 static void
 test_echo(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_echo224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_echo256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_echo384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_echo512_nist(u, nist_vec512[u]);
+	/*
+	 * The AES-NI and SSSE3 code is selected at runtime; all
+	 * implementations are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_echo224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_echo256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_echo384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_echo512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
+	test_echo384_multi();
+	test_echo512_multi();
 }
 
 UTEST_MAIN("ECHO", test_echo)
@@ -8245,16 +8245,25 @@ static char *const nist_vec512[] = {
 static void
 test_fugue(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_fugue224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_fugue256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_fugue384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_fugue512_nist(u, nist_vec512[u]);
+	/*
+	 * The SSSE3/AES-NI code (with an AVX-512 variant) is selected
+	 * at runtime; all implementations are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_fugue224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_fugue256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_fugue384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_fugue512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
 }
 
 UTEST_MAIN("Fugue", test_fugue)
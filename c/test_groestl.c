@@ -37,6 +37,8 @@ TEST_DIGEST_NIST(Groestl-224, groestl224, 28)
 TEST_DIGEST_NIST(Groestl-256, groestl256, 32)
 TEST_DIGEST_NIST(Groestl-384, groestl384, 48)
 TEST_DIGEST_NIST(Groestl-512, groestl512, 64)
+TEST_DIGEST_MULTI(Groestl-384, groestl384, 48)
+TEST_DIGEST_MULTI(Groestl-512, groestl512, 64)
 
 static char *const nist_vec224[] = {
 	"F2E180FB5947BE964CD584E22E496242C6A329C577FC4CE8C36D34C3",
@@ -8255,6 +8257,8 @@ test_groestl(void)
 		test_groestl384_nist(u, nist_vec384[u]);
 	for (u = 0; u < 2048; u ++)
 		test_groestl512_nist(u, nist_vec512[u]);
+	test_groestl384_multi();
+	test_groestl512_multi();
 }
 
 UTEST_MAIN("Groestl", test_groestl)
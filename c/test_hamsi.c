@@ -37,6 +37,10 @@ TEST_DIGEST_NIST(Hamsi-224, hamsi224, 28)
 TEST_DIGEST_NIST(Hamsi-256, hamsi256, 32)
 TEST_DIGEST_NIST(Hamsi-384, hamsi384, 48)
 TEST_DIGEST_NIST(Hamsi-512, hamsi512, 64)
+TEST_DIGEST_MULTI(Hamsi-224, hamsi224, 28)
+TEST_DIGEST_MULTI(Hamsi-256, hamsi256, 32)
+TEST_DIGEST_MULTI(Hamsi-384, hamsi384, 48)
+TEST_DIGEST_MULTI(Hamsi-512, hamsi512, 64)
 
 static char *const nist_vec224[] = {
 	"B9F6EB1A9B990373F9D2CB125584333C69A3D41AE291845F05DA221F",
@@ -8245,16 +8249,29 @@ static char *const nist_vec512[] = {
 static void
 test_hamsi(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_hamsi224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_hamsi256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_hamsi384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_hamsi512_nist(u, nist_vec512[u]);
+	/*
+	 * The single-message code has vector variants, selected at
+	 * runtime; all of them are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_hamsi224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_hamsi256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_hamsi384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_hamsi512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
+	test_hamsi224_multi();
+	test_hamsi256_multi();
+	test_hamsi384_multi();
+	test_hamsi512_multi();
 }
 
 UTEST_MAIN("Hamsi", test_hamsi)
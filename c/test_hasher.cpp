@@ -0,0 +1,246 @@
+/* $Id$ */
+/*
+ * Unit tests for the C++ hasher and chain templates.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sph_hasher.hpp"
+
+extern "C" {
+#include "utest.h"
+}
+
+#if SPH_64
+
+typedef sph::hasher<sph::sha2, 256> sha256;
+typedef sph::hasher<sph::keccak, 512> keccak512;
+typedef sph::hasher<sph::whirlpool> whirlpool;
+
+static_assert(sha256::digest_size == 32 && sha256::block_size == 64,
+	"SHA-256 sizes");
+static_assert(sph::hasher<sph::echo, 224>::block_size == 192,
+	"ECHO-224 block size");
+static_assert(sph::chain<sha256, keccak512>::digest_size == 64,
+	"chain digest size");
+static_assert(!sph::detail::is_byte_range<char[4]>::value
+	&& !sph::detail::is_byte_range<const char[4]>::value,
+	"character arrays are strings");
+static_assert(sph::detail::is_byte_range<unsigned char[4]>::value
+	&& sph::detail::is_byte_range<std::vector<sph_u32>>::value,
+	"byte ranges");
+
+static char msg[300];
+
+static bool
+same(const void *d, const unsigned char *ref, std::size_t len)
+{
+	return std::memcmp(d, ref, len) == 0;
+}
+
+/*
+ * Check hasher H against the C one-shot function of the same algorithm:
+ * whole messages, messages cut in two updates, clones of a running
+ * computation, and moved hashers (the source is then reinitialized).
+ */
+template <class H>
+static void
+test_algo(char *name, void (*oneshot)(const void *, std::size_t, void *))
+{
+	static char fmt[] = "hasher mismatch (%s, %s, length %u)";
+	static char whole[] = "hash", split[] = "update", cl[] = "clone",
+		mv[] = "move", mva[] = "move assignment", reuse[] = "reuse";
+	unsigned char ref[H::digest_size], ref2[H::digest_size];
+	H h;
+	unsigned u;
+
+	for (u = 0; u <= sizeof msg; u += 1 + (u >> 4)) {
+		typename H::digest_type d;
+		unsigned cut;
+
+		oneshot(msg, u, ref);
+		d = H::hash(msg, u);
+		if (!same(d.data(), ref, sizeof ref))
+			fail(fmt, name, whole, u);
+
+		cut = (u * 5) / 7;
+		h.update(msg, cut).update(msg + cut, u - cut);
+		if (!same(h.finish().data(), ref, sizeof ref))
+			fail(fmt, name, split, u);
+
+		/*
+		 * finish() reinitialized h; a clone taken after the first
+		 * part continues on its own, and h is left unchanged.
+		 */
+		oneshot(msg, cut, ref2);
+		h.update(msg, cut);
+		H c = h.clone();
+		c.update(msg + cut, u - cut);
+		c.finish(d);
+		if (!same(d.data(), ref, sizeof ref))
+			fail(fmt, name, cl, u);
+		if (!same(h.finish().data(), ref2, sizeof ref))
+			fail(fmt, name, cl, u);
+
+		h.update(msg, cut);
+		H m(std::move(h));
+		m.update(msg + cut, u - cut);
+		if (!same(m.finish().data(), ref, sizeof ref))
+			fail(fmt, name, mv, u);
+		h.update(msg, u);
+		if (!same(h.finish().data(), ref, sizeof ref))
+			fail(fmt, name, reuse, u);
+
+		m.update(msg, cut);
+		h = std::move(m);
+		h.update(msg + cut, u - cut);
+		if (!same(h.finish().data(), ref, sizeof ref))
+			fail(fmt, name, mva, u);
+		m.update(msg, u);
+		if (!same(m.finish().data(), ref, sizeof ref))
+			fail(fmt, name, reuse, u);
+	}
+}
+
+static void
+test_hasher(void)
+{
+	static char fmt[] = "hasher mismatch (%s)";
+	static char lit[] = "string literal", rng[] = "ranges",
+		chn[] = "chain", s224[] = "SHA-224", s256[] = "SHA-256",
+		s512[] = "SHA-512", m5[] = "MD5", k512[] = "Keccak-512",
+		b512[] = "BLAKE-512", g256[] = "Groestl-256",
+		e224[] = "ECHO-224", f384[] = "Fugue-384",
+		h160[] = "HAVAL-160/5", sh192[] = "Shabal-192",
+		sk512[] = "Skein-512", st256[] = "Streebog-256",
+		wp[] = "WHIRLPOOL", rg32[] = "RadioGatun[32]";
+	unsigned char ref[64];
+	unsigned u;
+
+	for (u = 0; u < sizeof msg; u ++)
+		msg[u] = static_cast<char>(u * 7 + 1);
+
+	test_algo<sph::hasher<sph::sha2, 224>>(s224, &sph_sha224_oneshot);
+	test_algo<sha256>(s256, &sph_sha256_oneshot);
+	test_algo<sph::hasher<sph::sha2, 512>>(s512, &sph_sha512_oneshot);
+	test_algo<sph::hasher<sph::md5>>(m5, &sph_md5_oneshot);
+	test_algo<keccak512>(k512, &sph_keccak512_oneshot);
+	test_algo<sph::hasher<sph::blake>>(b512, &sph_blake512_oneshot);
+	test_algo<sph::hasher<sph::groestl, 256>>(g256,
+		&sph_groestl256_oneshot);
+	test_algo<sph::hasher<sph::echo, 224>>(e224, &sph_echo224_oneshot);
+	test_algo<sph::hasher<sph::fugue, 384>>(f384, &sph_fugue384_oneshot);
+	test_algo<sph::hasher<sph::haval5, 160>>(h160,
+		&sph_haval160_5_oneshot);
+	test_algo<sph::hasher<sph::shabal, 192>>(sh192,
+		&sph_shabal192_oneshot);
+	test_algo<sph::hasher<sph::skein>>(sk512, &sph_skein512_oneshot);
+	test_algo<sph::hasher<sph::streebog, 256>>(st256,
+		&sph_gost256_oneshot);
+	test_algo<whirlpool>(wp, &sph_whirlpool_oneshot);
+	test_algo<sph::hasher<sph::radiogatun32>>(rg32,
+		&sph_radiogatun32_oneshot);
+
+	/*
+	 * A string literal is hashed without its terminating NUL, as a
+	 * std::string_view or a std::string; arrays of bytes and of wider
+	 * elements are hashed as their in-memory bytes.
+	 */
+	sph_sha256_oneshot("abc", 3, ref);
+	if (!same(sha256::hash("abc").data(), ref, 32)
+		|| !same(sha256::hash(std::string_view("abc")).data(), ref, 32)
+		|| !same(sha256::hash(std::string("abc")).data(), ref, 32)
+		|| !same(sha256().update("ab").update("c").finish().data(),
+		ref, 32)
+		|| !same(sph::chain<sha256>::hash("abc").data(), ref, 32))
+		fail(fmt, lit);
+	{
+		std::array<unsigned char, 3> a = { 'a', 'b', 'c' };
+		std::vector<unsigned char> v(a.begin(), a.end());
+		std::vector<sph_u32> w(20);
+		unsigned char b[3] = { 'a', 'b', 'c' };
+
+		if (!same(sha256::hash(a).data(), ref, 32)
+			|| !same(sha256::hash(v).data(), ref, 32)
+			|| !same(sha256::hash(b).data(), ref, 32)
+			|| !same(sha256().update(v).finish().data(), ref, 32))
+			fail(fmt, rng);
+		for (u = 0; u < w.size(); u ++)
+			w[u] = u * 0x01020304;
+		sph_sha256_oneshot(w.data(), w.size() * sizeof w[0], ref);
+		if (!same(sha256::hash(w).data(), ref, 32))
+			fail(fmt, rng);
+	}
+
+	/*
+	 * Chain: each hasher processes the digest of the previous one.
+	 */
+	for (u = 0; u <= sizeof msg; u += 37) {
+		typedef sph::chain<sha256, keccak512, whirlpool> ch;
+		ch::digest_type d;
+
+		sph_sha256_oneshot(msg, u, ref);
+		sph_keccak512_oneshot(ref, 32, ref);
+		sph_whirlpool_oneshot(ref, 64, ref);
+		d = ch::hash(msg, u);
+		if (!same(d.data(), ref, 64)
+			|| !same(ch::hash(std::string_view(msg, u)).data(),
+			ref, 64))
+			fail(fmt, chn);
+	}
+}
+
+int
+main(void)
+{
+	static char name[] = "C++ hashers";
+
+	utest_setname(name);
+	test_hasher();
+	utest_success();
+	return 0;
+}
+
+#else
+
+#include <cstdio>
+
+int
+main(void)
+{
+	std::fprintf(stderr,
+		"warning: the C++ hashers are not tested (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
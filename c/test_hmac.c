@@ -0,0 +1,282 @@
+/* $Id$ */
+/*
+ * Unit tests for HMAC.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stdio.h>
+
+#include "sph_hmac.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+/*
+ * Test vectors from RFC 2202 (HMAC-MD5, HMAC-SHA-1) and RFC 4231
+ * (HMAC-SHA-256, HMAC-SHA-512). A key with a NULL string is made of
+ * key_len bytes of value key_byte.
+ */
+static const struct {
+	unsigned alg;
+	const char *key;
+	unsigned key_byte;
+	size_t key_len;
+	const char *data;
+	const char *ref;
+} kat[] = {
+	{ SPH_HASH_MD5, NULL, 0x0B, 16, "Hi There",
+	  "9294727a3638bb1c13f48ef8158bfc9d" },
+	{ SPH_HASH_MD5, "Jefe", 0, 4, "what do ya want for nothing?",
+	  "750c783e6ab0b503eaa86e310a5db738" },
+	{ SPH_HASH_MD5, NULL, 0xAA, 80,
+	  "Test Using Larger Than Block-Size Key - Hash Key First",
+	  "6b1ab7fe4bd7bf8f0b62e6ce61b9d0cd" },
+	{ SPH_HASH_SHA1, NULL, 0x0B, 20, "Hi There",
+	  "b617318655057264e28bc0b6fb378c8ef146be00" },
+	{ SPH_HASH_SHA1, "Jefe", 0, 4, "what do ya want for nothing?",
+	  "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79" },
+	{ SPH_HASH_SHA1, NULL, 0xAA, 80,
+	  "Test Using Larger Than Block-Size Key - Hash Key First",
+	  "aa4ae5e15272d00e95705637ce8a3b55ed402112" },
+	{ SPH_HASH_SHA256, NULL, 0x0B, 20, "Hi There",
+	  "b0344c61d8db38535ca8afceaf0bf12b"
+	  "881dc200c9833da726e9376c2e32cff7" },
+	{ SPH_HASH_SHA256, "Jefe", 0, 4, "what do ya want for nothing?",
+	  "5bdcc146bf60754e6a042426089575c7"
+	  "5a003f089d2739839dec58b964ec3843" },
+	{ SPH_HASH_SHA256, NULL, 0xAA, 131,
+	  "Test Using Larger Than Block-Size Key - Hash Key First",
+	  "60e431591ee0b67f0d8a26aacbf5b77f"
+	  "8e0bc6213728c5140546040f0ee37f54" },
+	{ SPH_HASH_SHA512, NULL, 0x0B, 20, "Hi There",
+	  "87aa7cdea5ef619d4ff0b4241a1d6cb0"
+	  "2379f4e2ce4ec2787ad0b30545e17cde"
+	  "daa833b7d6b8a702038b274eaea3f4e4"
+	  "be9d914eeb61f1702e696c203a126854" },
+	{ SPH_HASH_SHA512, "Jefe", 0, 4, "what do ya want for nothing?",
+	  "164b7a7bfcf819e2e395fbe73b56e0a3"
+	  "87bd64222e831fd610270cd7ea250554"
+	  "9758bf75c05a994a6d034f65f8f0e6fd"
+	  "caeab1a34d4a6b4b636e070a38bce737" },
+	{ SPH_HASH_SHA512, NULL, 0xAA, 131,
+	  "Test Using Larger Than Block-Size Key - Hash Key First",
+	  "80b24263c7c1a3ebb71493c1dd7be8b4"
+	  "9b46d1f41b4aeec1121b013783f8f352"
+	  "6b56d037e05f2598bd0fd2215d6a1e52"
+	  "95e64f73f63f0aec8b915a985d786598" }
+};
+
+#define NUM_KAT   ((sizeof kat) / sizeof kat[0])
+
+static unsigned char msg[1000];
+static unsigned char key[300];
+
+static void
+test_hmac_kat(void)
+{
+	size_t u;
+
+	for (u = 0; u < NUM_KAT; u ++) {
+		sph_hmac_key k;
+		unsigned char kb[200], out[64], ref[64];
+		size_t ref_len;
+
+		if (kat[u].key == NULL)
+			memset(kb, kat[u].key_byte, kat[u].key_len);
+		else
+			memcpy(kb, kat[u].key, kat[u].key_len);
+		ref_len = utest_strtobin(ref, (char *)kat[u].ref);
+		ASSERT(sph_hmac_init(&k, kat[u].alg, kb, kat[u].key_len));
+		sph_hmac(&k, kat[u].data, strlen(kat[u].data), out);
+		if (!utest_byteequal(out, ref, ref_len))
+			fail("HMAC test vector %u", (unsigned)u);
+	}
+}
+
+/*
+ * Straightforward HMAC, computed over the concatenated padded key and
+ * data with the batch hashing functions.
+ */
+static void
+naive_hmac(unsigned alg, const void *k, size_t k_len,
+	const void *data, size_t len, void *dst)
+{
+	unsigned char kb[256], buf[256 + sizeof msg];
+	size_t b, h, u;
+	const void *p;
+	void *d;
+
+	b = sph_hmac_block(alg);
+	h = sph_hash_size(alg);
+	memset(kb, 0, b);
+	if (k_len > b) {
+		p = k;
+		d = kb;
+		sph_hash_batch(alg, &p, &k_len, &d, 1);
+	} else {
+		memcpy(kb, k, k_len);
+	}
+	for (u = 0; u < b; u ++)
+		buf[u] = kb[u] ^ 0x36;
+	memcpy(buf + b, data, len);
+	len += b;
+	p = buf;
+	d = buf + b;
+	sph_hash_batch(alg, &p, &len, &d, 1);
+	for (u = 0; u < b; u ++)
+		buf[u] = kb[u] ^ 0x5C;
+	len = b + h;
+	d = dst;
+	sph_hash_batch(alg, &p, &len, &d, 1);
+}
+
+static void
+test_hmac_generic(void)
+{
+	static const size_t msg_lens[] = { 0, 1, 55, 64, 200, 1000 };
+	unsigned alg;
+
+	for (alg = 0; alg < SPH_HASH_NUM; alg ++) {
+		size_t key_lens[5];
+		size_t b, h, u, v;
+
+		b = sph_hmac_block(alg);
+		h = sph_hash_size(alg);
+		ASSERT(b > 0 && b <= 256);
+		key_lens[0] = 0;
+		key_lens[1] = 20;
+		key_lens[2] = b;
+		key_lens[3] = b + 1;
+		key_lens[4] = sizeof key;
+		for (u = 0; u < 5; u ++) {
+			sph_hmac_key k;
+
+			ASSERT(sph_hmac_init(&k, alg, key, key_lens[u]));
+			for (v = 0; v < (sizeof msg_lens) / sizeof msg_lens[0];
+				v ++)
+			{
+				unsigned char out[64], ref[64];
+
+				sph_hmac(&k, msg, msg_lens[v], out);
+				naive_hmac(alg, key, key_lens[u],
+					msg, msg_lens[v], ref);
+				if (!utest_byteequal(out, ref, h))
+					fail("HMAC alg=%u key_len=%u len=%u",
+						alg, (unsigned)key_lens[u],
+						(unsigned)msg_lens[v]);
+			}
+		}
+	}
+}
+
+#define NUM_BATCH   37
+
+static void
+test_hmac_batch(void)
+{
+	static const unsigned algs[] = {
+		SPH_HASH_MD4, SPH_HASH_MD5, SPH_HASH_RIPEMD160, SPH_HASH_SHA1,
+		SPH_HASH_SHA256, SPH_HASH_SHA512, SPH_HASH_KECCAK256
+	};
+	size_t w;
+
+	for (w = 0; w < (sizeof algs) / sizeof algs[0]; w ++) {
+		sph_hmac_key k;
+		const void *data[NUM_BATCH];
+		size_t len[NUM_BATCH];
+		void *dst[NUM_BATCH];
+		unsigned char out[NUM_BATCH][64], ref[64];
+		size_t h, u, pass;
+
+		h = sph_hash_size(algs[w]);
+		ASSERT(sph_hmac_init(&k, algs[w], key, 50));
+
+		/*
+		 * First pass: all messages have the same length, so that
+		 * the whole message goes through the lanes. Second pass:
+		 * varied lengths and offsets.
+		 */
+		for (pass = 0; pass < 2; pass ++) {
+			for (u = 0; u < NUM_BATCH; u ++) {
+				if (pass == 0) {
+					data[u] = msg + u;
+					len[u] = 512;
+				} else {
+					data[u] = msg + (u * 13) % 100;
+					len[u] = (u * 97) % 900;
+				}
+				dst[u] = out[u];
+			}
+			sph_hmac_batch(&k, data, len, dst, NUM_BATCH);
+			for (u = 0; u < NUM_BATCH; u ++) {
+				sph_hmac(&k, data[u], len[u], ref);
+				if (!utest_byteequal(out[u], ref, h))
+					fail("HMAC batch alg=%u pass=%u msg=%u",
+						algs[w], (unsigned)pass,
+						(unsigned)u);
+			}
+		}
+	}
+}
+
+static void
+test_hmac_invalid(void)
+{
+	sph_hmac_key k;
+
+	ASSERT(sph_hmac_block(SPH_HASH_NUM) == 0);
+	ASSERT(!sph_hmac_init(&k, SPH_HASH_NUM, key, 10));
+}
+
+static void
+test_hmac(void)
+{
+	size_t u;
+
+	for (u = 0; u < sizeof msg; u ++)
+		msg[u] = (unsigned char)(u * 7 + 1);
+	for (u = 0; u < sizeof key; u ++)
+		key[u] = (unsigned char)(u * 11 + 3);
+	test_hmac_kat();
+	test_hmac_generic();
+	test_hmac_batch();
+	test_hmac_invalid();
+}
+
+UTEST_MAIN("HMAC", test_hmac)
+
+#else
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: HMAC is not supported (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,164 @@
+/* $Id$ */
+/*
+ * Unit tests for the job manager.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_jobmgr.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+#define NUM   40
+
+static const unsigned job_algs[] = {
+	SPH_HASH_MD5, SPH_HASH_SHA1, SPH_HASH_SHA224, SPH_HASH_SHA256,
+	SPH_HASH_SHA384, SPH_HASH_SHA512,
+	SPH_HASH_BLAKE224, SPH_HASH_BLAKE256,
+	SPH_HASH_BLAKE384, SPH_HASH_BLAKE512,
+	SPH_HASH_KECCAK224, SPH_HASH_KECCAK256,
+	SPH_HASH_KECCAK384, SPH_HASH_KECCAK512
+};
+
+/*
+ * Each message is cut into pieces of varying lengths (some not aligned
+ * on block boundaries, some empty); a piece is submitted as soon as the
+ * job holding the message is returned by the manager. Hash values are
+ * checked against single-message batches.
+ */
+static void
+test_jobmgr_alg(unsigned alg)
+{
+	static unsigned char msg[NUM][1000];
+	unsigned char ref[64];
+	sph_job job[NUM], *j;
+	sph_jobmgr m;
+	size_t off[NUM], mlen[NUM];
+	unsigned np[NUM];
+	int busy[NUM];
+	unsigned u, w, left;
+	size_t hlen;
+
+	hlen = sph_hash_size(alg);
+	for (u = 0; u < NUM; u ++) {
+		for (w = 0; w < sizeof msg[u]; w ++)
+			msg[u][w] = (unsigned char)(u * 13 + w * 7 + (w >> 5));
+		mlen[u] = (u * 97) % 1000;
+		off[u] = 0;
+		np[u] = 0;
+		busy[u] = 0;
+		job[u].user = &msg[u];
+	}
+	ASSERT(sph_jobmgr_init(&m, alg));
+	for (left = NUM; left > 0;) {
+		int sub;
+
+		sub = 0;
+		for (u = 0; u < NUM; u ++) {
+			size_t plen;
+
+			if (busy[u] || off[u] > mlen[u])
+				continue;
+			plen = (np[u] ++ * 61 + u * 29 + 1) % 300;
+			if (plen > mlen[u] - off[u])
+				plen = mlen[u] - off[u];
+			job[u].data = msg[u] + off[u];
+			job[u].len = plen;
+			job[u].flags = 0;
+			if (off[u] == 0)
+				job[u].flags |= SPH_JOB_FIRST;
+			off[u] += plen;
+			if (off[u] == mlen[u]) {
+				job[u].flags |= SPH_JOB_LAST;
+				off[u] = mlen[u] + 1;
+			}
+			busy[u] = 1;
+			sub = 1;
+			j = sph_jobmgr_submit(&m, &job[u]);
+			while (j != NULL) {
+				busy[j - job] = 0;
+				j = sph_jobmgr_get_completed(&m);
+			}
+		}
+		if (!sub) {
+			j = sph_jobmgr_flush(&m);
+			ASSERT(j != NULL);
+			while (j != NULL) {
+				busy[j - job] = 0;
+				j = sph_jobmgr_get_completed(&m);
+			}
+		}
+		for (left = 0, u = 0; u < NUM; u ++)
+			if (busy[u] || off[u] <= mlen[u])
+				left ++;
+	}
+	ASSERT(sph_jobmgr_flush(&m) == NULL);
+	for (u = 0; u < NUM; u ++) {
+		const void *data;
+		void *dst;
+
+		data = msg[u];
+		dst = ref;
+		sph_hash_batch(alg, &data, &mlen[u], &dst, 1);
+		if (!utest_byteequal(job[u].digest, ref, hlen))
+			fail("jobmgr: mismatch (algorithm %u, message %u)",
+				alg, u);
+	}
+}
+
+static void
+test_jobmgr(void)
+{
+	sph_jobmgr m;
+	size_t u, w;
+
+	ASSERT(!sph_jobmgr_init(&m, SPH_HASH_WHIRLPOOL));
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < (sizeof job_algs) / sizeof job_algs[0]; u ++)
+			test_jobmgr_alg(job_algs[u]);
+	}
+	sph_cpu_set_mask(~0U);
+}
+
+UTEST_MAIN("job manager", test_jobmgr)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: the job manager is not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
@@ -38,6 +38,11 @@ TEST_DIGEST_NIST(Luffa-256, luffa256, 32)
 TEST_DIGEST_NIST(Luffa-384, luffa384, 48)
 TEST_DIGEST_NIST(Luffa-512, luffa512, 64)
 
+TEST_DIGEST_MULTI(Luffa-224, luffa224, 28)
+TEST_DIGEST_MULTI(Luffa-256, luffa256, 32)
+TEST_DIGEST_MULTI(Luffa-384, luffa384, 48)
+TEST_DIGEST_MULTI(Luffa-512, luffa512, 64)
+
 static char *const nist_vec224[] = {
 	"DBB8665871F4154D3E4396AEFBBA417CB7837DD683C332BA6BE87E02",
 	"14B20CB4CC4C4BE3D472262F69F43AA87BBDE60F42DB8ABE6A39C2B1",
@@ -8245,16 +8250,29 @@ static char *const nist_vec512[] = {
 static void
 test_luffa(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_luffa224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_luffa256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_luffa384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_luffa512_nist(u, nist_vec512[u]);
+	/*
+	 * The single-message code has vector variants, selected at
+	 * runtime; all of them are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_luffa224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_luffa256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_luffa384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_luffa512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
+	test_luffa224_multi();
+	test_luffa256_multi();
+	test_luffa384_multi();
+	test_luffa512_multi();
 }
 
 UTEST_MAIN("Luffa", test_luffa)
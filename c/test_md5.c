@@ -34,6 +34,7 @@
 #include "test_digest_helper.c"
 
 TEST_DIGEST_INTERNAL(MD5, md5, 16)
+TEST_DIGEST_MULTI(MD5, md5, 16)
 
 static void
 test_md5(void)
@@ -76,6 +77,8 @@ test_md5(void)
 		"7280373c5bd8823e3156348f5bae6dacd436c919c6dd53e23487da03fd0"
 		"2396306d248cda0e99f33420f577ee8ce54b67080280d1ec69821bcb6a8"
 		"839396f965ab6ff72a70");
+
+	test_md5_multi();
 }
 
 UTEST_MAIN("MD5", test_md5)
@@ -0,0 +1,218 @@
+/* $Id$ */
+/*
+ * Unit tests for the thread pool.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_pool.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+#define NUM     500
+#define STEPS   3
+
+static sph_pool *pool;
+static unsigned count[NUM];
+
+static void
+count_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	(void)arg;
+	(void)scratch;
+	while (start < end)
+		count[start ++] ++;
+}
+
+static void
+inner_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	(void)scratch;
+	while (start < end)
+		((unsigned *)arg)[start ++] ++;
+}
+
+/*
+ * Each item of the outer run counts itself through a (serial) run on
+ * the same pool.
+ */
+static void
+nested_fun(void *arg, size_t start, size_t end, void *scratch)
+{
+	(void)arg;
+	(void)scratch;
+	for (; start < end; start ++)
+		sph_pool_run(pool, &inner_fun, count + start, 1, 1);
+}
+
+static void
+check_count(unsigned expected, const char *name)
+{
+	size_t u;
+
+	for (u = 0; u < NUM; u ++)
+		if (count[u] != expected)
+			fail("pool: %s: item %u processed %u times",
+				name, (unsigned)u, count[u]);
+}
+
+static void
+test_pool_run(void)
+{
+	size_t g;
+
+	for (g = 0; g < 600; g = g * 3 + 1) {
+		memset(count, 0, sizeof count);
+		sph_pool_run(pool, &count_fun, NULL, NUM, g);
+		check_count(1, "run");
+	}
+	memset(count, 0, sizeof count);
+	sph_pool_run(pool, &count_fun, NULL, 0, 10);
+	check_count(0, "empty run");
+	memset(count, 0, sizeof count);
+	sph_pool_run(pool, &nested_fun, NULL, NUM, 5);
+	check_count(1, "nested run");
+}
+
+static void
+test_pool_hash(sph_pool *p)
+{
+	static unsigned char msg[NUM][200], res[NUM][64], ref[NUM][64];
+	static unsigned char order[NUM * STEPS];
+	const void *data[NUM];
+	size_t len[NUM];
+	void *dst[NUM], *rdst[NUM];
+	sph_chain_stats st1, st2;
+	size_t u, w;
+
+	for (u = 0; u < NUM; u ++) {
+		for (w = 0; w < sizeof msg[u]; w ++)
+			msg[u][w] = (unsigned char)(u * 11 + w * 3 + (w >> 4));
+		for (w = 0; w < STEPS; w ++)
+			order[u * STEPS + w] = (unsigned char)
+				((u * 7 + w * 5) % SPH_CHAIN_NUM);
+		data[u] = msg[u];
+		len[u] = (u * 53) % 200;
+		dst[u] = res[u];
+		rdst[u] = ref[u];
+	}
+
+	sph_hash_batch(SPH_HASH_SHA256, data, len, rdst, NUM);
+	memset(res, 0, sizeof res);
+	sph_hash_batch_par(p, SPH_HASH_SHA256, data, len, dst, NUM);
+	for (u = 0; u < NUM; u ++)
+		if (!utest_byteequal(res[u], ref[u], 32))
+			fail("pool: parallel batch mismatch (message %u)",
+				(unsigned)u);
+
+	memset(&st1, 0, sizeof st1);
+	memset(&st2, 0, sizeof st2);
+	sph_chain_multi(data, len, rdst, NUM, order, STEPS, &st1);
+	memset(res, 0, sizeof res);
+	ASSERT(sph_chain_multi_par(p, data, len, dst, NUM,
+		order, STEPS, &st2));
+	if (memcmp(res, ref, sizeof res) != 0)
+		fail("pool: parallel chain mismatch");
+	for (u = 0; u < SPH_CHAIN_NUM; u ++)
+		if (st1.lanes[u] != st2.lanes[u])
+			fail("pool: parallel chain lanes mismatch (%u)",
+				(unsigned)u);
+	w = order[NUM * STEPS - 1];
+	order[NUM * STEPS - 1] = SPH_CHAIN_NUM;
+	ASSERT(!sph_chain_multi_par(p, data, len, dst, NUM,
+		order, STEPS, NULL));
+	if (memcmp(res, ref, sizeof res) != 0)
+		fail("pool: invalid chain order wrote outputs");
+	order[NUM * STEPS - 1] = (unsigned char)w;
+
+	/*
+	 * Tree mode on the concatenated messages, against the leaves
+	 * hashed in one batch.
+	 */
+	for (w = 1; w < sizeof msg; w = w * 7 + 3) {
+		size_t nl, total;
+		const void *root;
+		void *rd;
+
+		total = sizeof msg - w;
+		nl = (total - 1) / w + 1;
+		if (nl > NUM)
+			continue;
+		for (u = 0; u < nl; u ++) {
+			data[u] = msg[0] + u * w;
+			len[u] = total - u * w < w ? total - u * w : w;
+			rdst[u] = ref[0] + u * 32;
+		}
+		sph_hash_batch(SPH_HASH_SHA256, data, len, rdst, nl);
+		root = ref;
+		total = nl * 32;
+		rd = ref[NUM - 1];
+		sph_hash_batch(SPH_HASH_SHA256, &root, &total, &rd, 1);
+		ASSERT(sph_hash_tree_par(p, SPH_HASH_SHA256,
+			msg, sizeof msg - w, w, res));
+		if (!utest_byteequal(res, ref[NUM - 1], 32))
+			fail("pool: tree mismatch (leaf %u)", (unsigned)w);
+	}
+	ASSERT(!sph_hash_tree_par(p, SPH_HASH_NUM, msg, 10, 1, res));
+	ASSERT(!sph_hash_tree_par(p, SPH_HASH_SHA256, msg, 10, 0, res));
+}
+
+static void
+test_pool(void)
+{
+	unsigned n;
+
+	for (n = 1; n <= 4; n += 3) {
+		pool = sph_pool_new(n, SPH_POOL_PIN);
+		ASSERT(pool != NULL);
+		ASSERT(sph_pool_threads(pool) == (SPH_THREADS ? n : 1));
+		test_pool_run();
+		test_pool_hash(pool);
+		sph_pool_free(pool);
+	}
+	pool = NULL;
+	ASSERT(sph_pool_threads(NULL) >= 1);
+	test_pool_run();
+	test_pool_hash(NULL);
+}
+
+UTEST_MAIN("thread pool", test_pool)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: the thread pool is not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
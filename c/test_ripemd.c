@@ -32,11 +32,79 @@
  */
 
 #include "sph_ripemd.h"
+#include "sph_sha2.h"
 #include "test_digest_helper.c"
 
 TEST_DIGEST_INTERNAL(RIPEMD, ripemd, 16)
 TEST_DIGEST_INTERNAL(RIPEMD-128, ripemd128, 16)
 TEST_DIGEST_INTERNAL(RIPEMD-160, ripemd160, 20)
+TEST_DIGEST_MULTI(RIPEMD-160, ripemd160, 20)
+
+/*
+ * HASH160 of the compressed and uncompressed encodings of the
+ * secp256k1 generator, then of 40 messages with mixed lengths (at
+ * least one full batch) against the two separate hash functions.
+ */
+static void
+test_hash160_multi(void)
+{
+	static char *const pub[2] = {
+		"0279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798",
+		"0479BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"
+		"483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"
+	};
+	static char *const kat[2] = {
+		"751e76e8199196d454941c45d1b3a323f1433bd6",
+		"91b24bf9f5288532960ac687abb035127b1d28a5"
+	};
+	unsigned char key[2][65], buf[100 * 65];
+	unsigned char res[100][20], ref[20], tmp[32];
+	const void *data[100];
+	size_t len[100];
+	void *dst[100];
+	size_t u, w;
+
+	for (u = 0; u < sizeof buf; u ++)
+		buf[u] = (unsigned char)(u * 11 + (u >> 8) * 3);
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2; u ++) {
+			len[u] = utest_strtobin(key[u], pub[u]);
+			data[u] = key[u];
+			dst[u] = res[u];
+		}
+		sph_hash160_multi(data, len, dst, 2);
+		for (u = 0; u < 2; u ++) {
+			utest_strtobin(ref, kat[u]);
+			ASSERT(utest_byteequal(res[u], ref, 20));
+		}
+		for (u = 0; u < 100; u ++) {
+			len[u] = (u % 3) == 0 ? 33 : (u % 3) == 1 ? 65 : u;
+			data[u] = buf + 65 * u;
+			dst[u] = res[u];
+		}
+		memset(res, 0, sizeof res);
+		sph_hash160_multi(data, len, dst, 100);
+		for (u = 0; u < 100; u ++) {
+			sph_sha256_context sc;
+			sph_ripemd160_context rc;
+
+			sph_sha256_init(&sc);
+			sph_sha256(&sc, data[u], len[u]);
+			sph_sha256_close(&sc, tmp);
+			sph_ripemd160_init(&rc);
+			sph_ripemd160(&rc, tmp, sizeof tmp);
+			sph_ripemd160_close(&rc, ref);
+			if (!utest_byteequal(res[u], ref, 20))
+				fail("HASH160 multi: mismatch (mask %x,"
+					" message %u, length %u)",
+					multi_cpu_masks[w], (unsigned)u,
+					(unsigned)len[u]);
+		}
+	}
+	sph_cpu_set_mask(~0U);
+}
 
 static void
 test_ripemd(void)
@@ -119,6 +187,9 @@ test_ripemd(void)
 
 	KAT_MILLION_A(RIPEMD-160, ripemd160, 20,
 		"52783243c1697bdbe16d37f97f68f08325dc1528");
+
+	test_ripemd160_multi();
+	test_hash160_multi();
 }
 
 UTEST_MAIN("RIPEMD (orignal, -128, -160)", test_ripemd)
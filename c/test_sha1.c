@@ -35,6 +35,7 @@
 
 TEST_DIGEST_INTERNAL(SHA-1, sha1, 20)
 TEST_DIGEST_INTERNAL_BITS(SHA-1, sha1, 20)
+TEST_DIGEST_MULTI(SHA-1, sha1, 20)
 
 static void
 test_sha1(void)
@@ -58,6 +59,8 @@ test_sha1(void)
 		"dd4499cbd7c887a94eaaa101ea5aabc529b4e7e43665a5af2cd03fe67"
 		"8ea6a5005bba3b082204c28b9109f469dac92aaab3aa7c11a1b32ae0", 5,
 		"8c5b2a5ddae5a97fc7f9d85661c672adbf7933d4");
+
+	test_sha1_multi();
 }
 
 UTEST_MAIN("SHA-1", test_sha1)
@@ -37,6 +37,8 @@ TEST_DIGEST_INTERNAL(SHA-224, sha224, 28)
 TEST_DIGEST_INTERNAL_BITS(SHA-224, sha224, 28)
 TEST_DIGEST_INTERNAL(SHA-256, sha256, 32)
 TEST_DIGEST_INTERNAL_BITS(SHA-256, sha256, 32)
+TEST_DIGEST_MULTI(SHA-224, sha224, 28)
+TEST_DIGEST_MULTI(SHA-256, sha256, 32)
 
 static void
 test_sha2(void)
@@ -89,6 +91,9 @@ test_sha2(void)
 		"2bd901e16eb0e05deba014ebff6406a07d54364eff742da779b0b3a0", 5,
 		"3e9ad6468bbbad2ac3c2cdc292e018ba"
 		"5fd70b960cf1679777fce708fdb066e9");
+
+	test_sha224_multi();
+	test_sha256_multi();
 }
 
 UTEST_MAIN("SHA-224 / SHA-256", test_sha2)
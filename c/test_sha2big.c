@@ -39,9 +39,11 @@ TEST_DIGEST_INTERNAL(SHA-384, sha384, 48)
 TEST_DIGEST_INTERNAL_BITS(SHA-384, sha384, 48)
 TEST_DIGEST_INTERNAL(SHA-512, sha512, 64)
 TEST_DIGEST_INTERNAL_BITS(SHA-512, sha512, 64)
+TEST_DIGEST_MULTI(SHA-384, sha384, 48)
+TEST_DIGEST_MULTI(SHA-512, sha512, 64)
 
 static void
-test_sha3(void)
+test_sha3_kat(void)
 {
 	test_sha384_internal("abc",
 		"cb00753f45a35e8bb5a03d699ac65007272c32ab0eded163"
@@ -116,6 +118,21 @@ test_sha3(void)
 		"6b337db2526f8a0a510e5e53cafed4355fe7c2f1");
 }
 
+static void
+test_sha3(void)
+{
+	size_t w;
+
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		test_sha3_kat();
+	}
+	sph_cpu_set_mask(~0U);
+	test_sha384_multi();
+	test_sha512_multi();
+}
+
 UTEST_MAIN("SHA-384 / SHA-512", test_sha3)
 
 #else
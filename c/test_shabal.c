@@ -38,6 +38,11 @@ TEST_DIGEST_NIST(Shabal-224, shabal224, 28)
 TEST_DIGEST_NIST(Shabal-256, shabal256, 32)
 TEST_DIGEST_NIST(Shabal-384, shabal384, 48)
 TEST_DIGEST_NIST(Shabal-512, shabal512, 64)
+TEST_DIGEST_MULTI(Shabal-192, shabal192, 24)
+TEST_DIGEST_MULTI(Shabal-224, shabal224, 28)
+TEST_DIGEST_MULTI(Shabal-256, shabal256, 32)
+TEST_DIGEST_MULTI(Shabal-384, shabal384, 48)
+TEST_DIGEST_MULTI(Shabal-512, shabal512, 64)
 
 static char *const nist_vec224[] = {
 	"562B4FDBE1706247552927F814B66A3D74B465A090AF23E277BF8029",
@@ -8260,6 +8265,11 @@ test_shabal(void)
 		test_shabal384_nist(u, nist_vec384[u]);
 	for (u = 0; u < 2048; u ++)
 		test_shabal512_nist(u, nist_vec512[u]);
+	test_shabal192_multi();
+	test_shabal224_multi();
+	test_shabal256_multi();
+	test_shabal384_multi();
+	test_shabal512_multi();
 }
 
 UTEST_MAIN("Shabal", test_shabal)
@@ -37,6 +37,8 @@ TEST_DIGEST_NIST(SHAvite-224, shavite224, 28)
 TEST_DIGEST_NIST(SHAvite-256, shavite256, 32)
 TEST_DIGEST_NIST(SHAvite-384, shavite384, 48)
 TEST_DIGEST_NIST(SHAvite-512, shavite512, 64)
+TEST_DIGEST_MULTI(SHAvite-384, shavite384, 48)
+TEST_DIGEST_MULTI(SHAvite-512, shavite512, 64)
 
 static char *const nist_vec224[] = {
 	"B33F761F0D3A86BB1051905AEC7A691BD0B5A24C3721F67D8E48D839",
@@ -8245,16 +8247,27 @@ static char *const nist_vec512[] = {
 static void
 test_shavite(void)
 {
-	unsigned u;
+	unsigned u, w;
 
-	for (u = 0; u < 2048; u ++)
-		test_shavite224_nist(u, nist_vec224[u]);
-	for (u = 0; u < 2048; u ++)
-		test_shavite256_nist(u, nist_vec256[u]);
-	for (u = 0; u < 2048; u ++)
-		test_shavite384_nist(u, nist_vec384[u]);
-	for (u = 0; u < 2048; u ++)
-		test_shavite512_nist(u, nist_vec512[u]);
+	/*
+	 * The AES-NI and SSSE3 code is selected at runtime; all
+	 * implementations are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		for (u = 0; u < 2048; u ++)
+			test_shavite224_nist(u, nist_vec224[u]);
+		for (u = 0; u < 2048; u ++)
+			test_shavite256_nist(u, nist_vec256[u]);
+		for (u = 0; u < 2048; u ++)
+			test_shavite384_nist(u, nist_vec384[u]);
+		for (u = 0; u < 2048; u ++)
+			test_shavite512_nist(u, nist_vec512[u]);
+	}
+	sph_cpu_set_mask(~0U);
+	test_shavite384_multi();
+	test_shavite512_multi();
 }
 
 UTEST_MAIN("SHAvite-3", test_shavite)
@@ -0,0 +1,348 @@
+/* $Id$ */
+/*
+ * Unit tests for the usage statistics.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stdio.h>
+
+#include "sph_blake.h"
+#include "sph_bmw.h"
+#include "sph_cubehash.h"
+#include "sph_echo.h"
+#include "sph_fugue.h"
+#include "sph_gost.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_haval.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_luffa.h"
+#include "sph_md2.h"
+#include "sph_md4.h"
+#include "sph_md5.h"
+#include "sph_panama.h"
+#include "sph_radiogatun.h"
+#include "sph_ripemd.h"
+#include "sph_sha0.h"
+#include "sph_sha1.h"
+#include "sph_sha2.h"
+#include "sph_shabal.h"
+#include "sph_shavite.h"
+#include "sph_simd.h"
+#include "sph_skein.h"
+#include "sph_streebog.h"
+#include "sph_tiger.h"
+#include "sph_whirlpool.h"
+#include "sph_batch.h"
+#include "sph_pool.h"
+#include "sph_stats.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+#if SPH_THREADS
+#include <pthread.h>
+#endif
+
+static const struct {
+	unsigned fam;
+	void (*oneshot)(const void *data, size_t len, void *dst);
+} families[] = {
+	{ SPH_STATS_BLAKE, &sph_blake256_oneshot },
+	{ SPH_STATS_BMW, &sph_bmw256_oneshot },
+	{ SPH_STATS_CUBEHASH, &sph_cubehash256_oneshot },
+	{ SPH_STATS_ECHO, &sph_echo256_oneshot },
+	{ SPH_STATS_FUGUE, &sph_fugue256_oneshot },
+	{ SPH_STATS_GOST, &sph_gost_oneshot },
+	{ SPH_STATS_GROESTL, &sph_groestl256_oneshot },
+	{ SPH_STATS_HAMSI, &sph_hamsi256_oneshot },
+	{ SPH_STATS_HAVAL, &sph_haval256_5_oneshot },
+	{ SPH_STATS_JH, &sph_jh256_oneshot },
+	{ SPH_STATS_KECCAK, &sph_keccak256_oneshot },
+	{ SPH_STATS_LUFFA, &sph_luffa256_oneshot },
+	{ SPH_STATS_MD2, &sph_md2_oneshot },
+	{ SPH_STATS_MD4, &sph_md4_oneshot },
+	{ SPH_STATS_MD5, &sph_md5_oneshot },
+	{ SPH_STATS_PANAMA, &sph_panama_oneshot },
+	{ SPH_STATS_RADIOGATUN, &sph_radiogatun32_oneshot },
+	{ SPH_STATS_RIPEMD, &sph_ripemd160_oneshot },
+	{ SPH_STATS_SHA0, &sph_sha0_oneshot },
+	{ SPH_STATS_SHA1, &sph_sha1_oneshot },
+	{ SPH_STATS_SHA2, &sph_sha256_oneshot },
+	{ SPH_STATS_SHABAL, &sph_shabal256_oneshot },
+	{ SPH_STATS_SHAVITE, &sph_shavite256_oneshot },
+	{ SPH_STATS_SIMD, &sph_simd256_oneshot },
+	{ SPH_STATS_SKEIN, &sph_skein256_oneshot },
+	{ SPH_STATS_STREEBOG, &sph_gost256_oneshot },
+	{ SPH_STATS_TIGER, &sph_tiger_oneshot },
+	{ SPH_STATS_WHIRLPOOL, &sph_whirlpool_oneshot }
+};
+
+#define NUM_FAMILIES   ((sizeof families) / sizeof families[0])
+
+#define NUM_PAR   100
+
+static unsigned char msg[1000];
+
+static void
+check(unsigned fam, unsigned calls, unsigned bytes, unsigned blocks)
+{
+	sph_stats_counters c;
+
+	sph_stats_get(fam, &c);
+	if (c.calls != calls || c.bytes != bytes || c.blocks != blocks)
+		fail("%s: calls=%lu bytes=%lu blocks=%lu (exp: %u %u %u)",
+			sph_stats_name(fam), (unsigned long)c.calls,
+			(unsigned long)c.bytes, (unsigned long)c.blocks,
+			calls, bytes, blocks);
+}
+
+static void
+test_stats_names(void)
+{
+	sph_stats_counters c;
+	unsigned u;
+
+	ASSERT(NUM_FAMILIES == SPH_STATS_NUM);
+	for (u = 0; u < NUM_FAMILIES; u ++) {
+		ASSERT(families[u].fam == u);
+		ASSERT(sph_stats_name(u) != NULL);
+	}
+	ASSERT(strcmp(sph_stats_name(SPH_STATS_SHA2), "sha2") == 0);
+	ASSERT(sph_stats_name(SPH_STATS_NUM) == NULL);
+	memset(&c, 0xFF, sizeof c);
+	sph_stats_get(SPH_STATS_NUM, &c);
+	ASSERT(c.calls == 0 && c.bytes == 0 && c.blocks == 0);
+	for (u = 0; u < SPH_STATS_HIST; u ++)
+		ASSERT(c.hist[u] == 0);
+}
+
+/*
+ * SHA-256 with exactly known block counts: 100 bytes are one block
+ * plus the padding block; 10 bytes and 64 bytes take one and two
+ * blocks, respectively.
+ */
+static void
+test_stats_sha256(void)
+{
+	sph_sha256_context sc;
+	sph_sha256_context mc[3];
+	sph_stats_counters c;
+	unsigned char out[32];
+	const void *data[5];
+	void *cc[3];
+	size_t len[5];
+	void *dst[5];
+	unsigned char bout[5][32];
+	size_t u;
+
+	sph_stats_reset();
+	check(SPH_STATS_SHA2, 0, 0, 0);
+	sph_sha256_init(&sc);
+	sph_sha256(&sc, msg, 100);
+	sph_sha256(&sc, msg, 0);
+	sph_sha256_close(&sc, out);
+	check(SPH_STATS_SHA2, 2, 100, 2);
+	sph_stats_get(SPH_STATS_SHA2, &c);
+	ASSERT(c.hist[0] == 1 && c.hist[7] == 1);
+
+	sph_sha256_oneshot(msg, 10, out);
+	check(SPH_STATS_SHA2, 3, 110, 3);
+	sph_stats_get(SPH_STATS_SHA2, &c);
+	ASSERT(c.hist[4] == 1);
+
+	for (u = 0; u < 5; u ++) {
+		data[u] = msg + u;
+		len[u] = 64;
+		dst[u] = bout[u];
+	}
+	sph_hash_batch(SPH_HASH_SHA256, data, len, dst, 5);
+	check(SPH_STATS_SHA2, 8, 430, 13);
+	sph_stats_get(SPH_STATS_SHA2, &c);
+	ASSERT(c.hist[7] == 6);
+
+	/*
+	 * Blocks processed with the multi-message code are not input
+	 * calls; closing adds one padding block per context.
+	 */
+	for (u = 0; u < 3; u ++) {
+		sph_sha256_init(&mc[u]);
+		cc[u] = &mc[u];
+	}
+	sph_sha256_blocks_multi(cc, data, 2, 3);
+	check(SPH_STATS_SHA2, 8, 814, 19);
+	for (u = 0; u < 3; u ++)
+		sph_sha256_close(&mc[u], bout[u]);
+	check(SPH_STATS_SHA2, 8, 814, 22);
+	sph_stats_get(SPH_STATS_SHA2, &c);
+	ASSERT(c.hist[7] == 6 && c.hist[8] == 0);
+
+	sph_stats_enable(0);
+	ASSERT(!sph_stats_enabled());
+	sph_sha256_oneshot(msg, 10, out);
+	sph_hash_batch(SPH_HASH_SHA256, data, len, dst, 5);
+	sph_stats_enable(1);
+	check(SPH_STATS_SHA2, 8, 814, 22);
+	check(SPH_STATS_MD5, 0, 0, 0);
+}
+
+/*
+ * Each family is counted under its own identifier only.
+ */
+static void
+test_stats_families(void)
+{
+	unsigned char out[64];
+	unsigned u, v;
+
+	for (u = 0; u < NUM_FAMILIES; u ++) {
+		sph_stats_counters c;
+
+		sph_stats_reset();
+		families[u].oneshot(msg, sizeof msg, out);
+		sph_stats_get(families[u].fam, &c);
+		if (c.calls != 1 || c.bytes != sizeof msg || c.blocks == 0)
+			fail("%s: calls=%lu bytes=%lu blocks=%lu",
+				sph_stats_name(families[u].fam),
+				(unsigned long)c.calls, (unsigned long)c.bytes,
+				(unsigned long)c.blocks);
+		for (v = 0; v < SPH_STATS_NUM; v ++)
+			if (v != families[u].fam)
+				check(v, 0, 0, 0);
+	}
+}
+
+/*
+ * Counts made by the pool threads are included, also after the
+ * threads have exited.
+ */
+static void
+test_stats_threads(void)
+{
+	static unsigned char bout[NUM_PAR][32];
+	const void *data[NUM_PAR];
+	size_t len[NUM_PAR];
+	void *dst[NUM_PAR];
+	sph_pool *p;
+	size_t u;
+
+	for (u = 0; u < NUM_PAR; u ++) {
+		data[u] = msg;
+		len[u] = 200;
+		dst[u] = bout[u];
+	}
+	sph_stats_reset();
+	p = sph_pool_new(2, 0);
+	ASSERT(p != NULL);
+	sph_hash_batch_par(p, SPH_HASH_SHA256, data, len, dst, NUM_PAR);
+	check(SPH_STATS_SHA2, NUM_PAR, 200 * NUM_PAR, 4 * NUM_PAR);
+	sph_pool_free(p);
+	check(SPH_STATS_SHA2, NUM_PAR, 200 * NUM_PAR, 4 * NUM_PAR);
+	sph_stats_reset();
+	check(SPH_STATS_SHA2, 0, 0, 0);
+}
+
+#if SPH_THREADS
+
+static pthread_key_t late_key;
+
+static void
+late_destructor(void *arg)
+{
+	unsigned char out[32];
+
+	sph_sha256_oneshot(arg, 100, out);
+}
+
+static void *
+late_thread(void *arg)
+{
+	unsigned char out[32];
+
+	sph_sha256_oneshot(msg, 10, out);
+	pthread_setspecific(late_key, arg);
+	return NULL;
+}
+
+/*
+ * Hashing in a key destructor which runs after the one of the
+ * statistics (the key is created after the first count) must still be
+ * counted, after the area of the thread has been released.
+ */
+static void
+test_stats_exit(void)
+{
+	pthread_t t;
+
+	sph_stats_reset();
+	ASSERT(pthread_key_create(&late_key, &late_destructor) == 0);
+	ASSERT(pthread_create(&t, NULL, &late_thread, msg) == 0);
+	ASSERT(pthread_join(t, NULL) == 0);
+	pthread_key_delete(late_key);
+	check(SPH_STATS_SHA2, 2, 110, 3);
+	sph_stats_reset();
+}
+
+#endif
+
+static void
+test_stats(void)
+{
+	size_t u;
+
+	for (u = 0; u < sizeof msg; u ++)
+		msg[u] = (unsigned char)(u * 7 + 1);
+	test_stats_names();
+	sph_stats_enable(1);
+	if (!sph_stats_enabled()) {
+		fprintf(stderr, "warning: statistics are not compiled in\n");
+		return;
+	}
+	test_stats_sha256();
+	test_stats_families();
+	test_stats_threads();
+#if SPH_THREADS
+	test_stats_exit();
+#endif
+	sph_stats_enable(0);
+}
+
+UTEST_MAIN("usage statistics", test_stats)
+
+#else
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: the usage statistics are not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,112 @@
+/* $Id$ */
+/*
+ * Unit tests for the Streebog hash function.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_streebog.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+TEST_DIGEST_INTERNAL(Streebog-256, gost256, 32)
+TEST_DIGEST_INTERNAL(Streebog-512, gost512, 64)
+
+/*
+ * Message M1 from GOST R 34.11-2012 (63 bytes).
+ */
+#define STREEBOG_M1   "012345678901234567890123456789012345678901234567890123456789012"
+
+/*
+ * Compare the 64-byte fast path with the generic functions.
+ */
+static void
+test_streebog_hash64(void)
+{
+	unsigned char data[64], res[64], ref[64];
+	sph_gost512_context sc;
+	int i, j;
+
+	for (i = 0; i < 64; i ++) {
+		for (j = 0; j < 64; j ++)
+			data[j] = (unsigned char)(i * 7 + j * 31);
+		sph_gost256_init(&sc);
+		sph_gost256(&sc, data, sizeof data);
+		sph_gost256_close(&sc, ref);
+		sph_gost256_hash64(data, res);
+		ASSERT(utest_byteequal(res, ref, 32));
+		sph_gost512_init(&sc);
+		sph_gost512(&sc, data, sizeof data);
+		sph_gost512_close(&sc, ref);
+		sph_gost512_hash64(data, res);
+		ASSERT(utest_byteequal(res, ref, 64));
+	}
+}
+
+static void
+test_streebog(void)
+{
+	test_gost256_internal("",
+		"3f539a213e97c802cc229d474c6aa32a825a360b2a933a949fd925208d9ce1bb");
+	test_gost256_internal("abc",
+		"4e2919cf137ed41ec4fb6270c61826cc4fffb660341e0af3688cd0626d23b481");
+	test_gost256_internal(STREEBOG_M1,
+		"9d151eefd8590b89daa6ba6cb74af9275dd051026bb149a452fd84e5e57b5500");
+	KAT_MILLION_A(Streebog-256, gost256, 32,
+		"841af1a0b2f92a800fb1b7e4aabc8e48763153c448a0fc57c90ba830e130f152");
+
+	test_gost512_internal("",
+		"8e945da209aa869f0455928529bcae4679e9873ab707b55315f56ceb98bef0a7"
+		"362f715528356ee83cda5f2aac4c6ad2ba3a715c1bcd81cb8e9f90bf4c1c1a8a");
+	test_gost512_internal("abc",
+		"28156e28317da7c98f4fe2bed6b542d0dab85bb224445fcedaf75d46e26d7eb8"
+		"d5997f3e0915dd6b7f0aab08d9c8beb0d8c64bae2ab8b3c8c6bc53b3bf0db728");
+	test_gost512_internal(STREEBOG_M1,
+		"1b54d01a4af5b9d5cc3d86d68d285462b19abc2475222f35c085122be4ba1ffa"
+		"00ad30f8767b3a82384c6574f024c311e2a481332b08ef7f41797891c1646f48");
+	KAT_MILLION_A(Streebog-512, gost512, 64,
+		"d396a40b126b1f324465bfa7aa159859ab33fac02dcdd4515ad231206396a266"
+		"d0102367e4c544ef47d2294064e1a25342d0cd25ae3d904b45abb1425ae41095");
+
+	test_streebog_hash64();
+}
+
+UTEST_MAIN("Streebog", test_streebog)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: Streebog is not supported (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,237 @@
+/* $Id$ */
+/*
+ * Unit tests for the auto-tuner.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined __unix__ || defined __unix \
+	|| (defined __APPLE__ && defined __MACH__)
+#include <unistd.h>
+#define TEST_PID   1
+#else
+#define TEST_PID   0
+#endif
+
+#include "sph_tune.h"
+#include "test_digest_helper.c"
+
+#if SPH_64
+
+/*
+ * Profile file used by the tests: in TMPDIR if set, and named after
+ * the process identifier where there is one, so that concurrent runs
+ * do not share it.
+ */
+static char profile[1024];
+
+#define PROFILE   profile
+
+static void
+profile_init(void)
+{
+	const char *dir;
+
+	dir = getenv("TMPDIR");
+	if (dir == NULL || *dir == 0)
+		dir = ".";
+#if TEST_PID
+	sprintf(profile, "%.900s/test_tune.%lu.prof",
+		dir, (unsigned long)getpid());
+#else
+	sprintf(profile, "%.900s/test_tune.prof", dir);
+#endif
+}
+
+static const struct {
+	const char *name;
+	unsigned alg224;
+	const char *var[5];
+} families[] = {
+	{ "echo", SPH_HASH_ECHO224, { "default", "32", NULL } },
+	{ "groestl", SPH_HASH_GROESTL224,
+		{ "default", "small", "32", "small32", NULL } },
+	{ "hamsi", SPH_HASH_HAMSI224, { "default", "small", NULL } },
+	{ "jh", SPH_HASH_JH224, { "default", "32", "small", NULL } },
+	{ "keccak", SPH_HASH_KECCAK224,
+		{ "default", "u2", "full", "copy", "32" } }
+};
+
+#define NUM_FAMILIES   ((sizeof families) / sizeof families[0])
+
+static const size_t lengths[] = { 0, 1, 55, 64, 200, 1024, 1500, 20000 };
+
+#define NUM_LENGTHS   ((sizeof lengths) / sizeof lengths[0])
+
+static const unsigned bits[4] = { 224, 256, 384, 512 };
+
+static unsigned char msg[20000];
+
+/*
+ * Write a profile which selects variant v of family f for all sizes
+ * and classes, reusing the header line of a saved profile.
+ */
+static void
+force_variant(unsigned f, const char *v)
+{
+	char host[256];
+	FILE *fp;
+	unsigned s, c;
+
+	ASSERT(sph_tune_save(PROFILE));
+	fp = fopen(PROFILE, "r");
+	ASSERT(fp != NULL);
+	ASSERT(fgets(host, sizeof host, fp) != NULL);
+	ASSERT(fgets(host, sizeof host, fp) != NULL);
+	fclose(fp);
+	fp = fopen(PROFILE, "w");
+	ASSERT(fp != NULL);
+	fprintf(fp, "sphlib-tune 1\n%s", host);
+	for (s = 0; s < 4; s ++)
+		for (c = 0; c < SPH_TUNE_CLASSES; c ++)
+			fprintf(fp, "%s%u %u %s\n", families[f].name,
+				bits[s],
+				c, v);
+	fclose(fp);
+	ASSERT(sph_tune_load(PROFILE));
+}
+
+static void
+test_tune_variants(void)
+{
+	unsigned f, s, v;
+	size_t u;
+
+	remove(PROFILE);
+	for (u = 0; u < sizeof msg; u ++)
+		msg[u] = (unsigned char)(u * 7 + (u >> 5));
+	for (f = 0; f < NUM_FAMILIES; f ++) {
+		for (v = 0; v < 5 && families[f].var[v] != NULL; v ++) {
+			force_variant(f, families[f].var[v]);
+			for (s = 0; s < 4; s ++) {
+				unsigned alg;
+
+				alg = families[f].alg224 + s;
+				for (u = 0; u < NUM_LENGTHS; u ++) {
+					unsigned char ref[64], out[64];
+					const void *data;
+					void *dst;
+					size_t len;
+
+					if (strcmp(sph_tune_variant(alg,
+						lengths[u]),
+						families[f].var[v]) != 0)
+						fail("tune: variant %s%u/%s"
+							" not selected",
+							families[f].name, bits[s],
+							families[f].var[v]);
+					data = msg;
+					len = lengths[u];
+					dst = ref;
+					sph_hash_batch(alg, &data, &len,
+						&dst, 1);
+					sph_tune_hash(alg, msg, len, out);
+					if (!utest_byteequal(out, ref,
+						sph_hash_size(alg)))
+						fail("tune: %s%u/%s mismatch"
+							" (length %u)",
+							families[f].name, bits[s],
+							families[f].var[v],
+							(unsigned)len);
+				}
+			}
+		}
+	}
+	remove(PROFILE);
+}
+
+static void
+test_tune_profile(void)
+{
+	FILE *fp;
+
+	remove(PROFILE);
+	ASSERT(!sph_tune_load(PROFILE));
+	fp = fopen(PROFILE, "w");
+	ASSERT(fp != NULL);
+	fprintf(fp, "sphlib-tune 1\nhost elsewhere 0\n");
+	fclose(fp);
+	ASSERT(!sph_tune_load(PROFILE));
+	remove(PROFILE);
+	ASSERT(sph_tune_variant(SPH_HASH_SHA256, 100) == NULL);
+}
+
+static void
+test_tune_run(void)
+{
+	unsigned char ref[64], out[64];
+	const void *data;
+	void *dst;
+	size_t len;
+
+	sph_tune_run();
+	ASSERT(sph_tune_save(PROFILE));
+	ASSERT(sph_tune_load(PROFILE));
+	remove(PROFILE);
+	data = msg;
+	len = 1000;
+	dst = ref;
+	sph_hash_batch(SPH_HASH_SHA256, &data, &len, &dst, 1);
+	sph_tune_hash(SPH_HASH_SHA256, msg, len, out);
+	ASSERT(utest_byteequal(out, ref, 32));
+	sph_hash_batch(SPH_HASH_KECCAK512, &data, &len, &dst, 1);
+	sph_tune_hash(SPH_HASH_KECCAK512, msg, len, out);
+	ASSERT(utest_byteequal(out, ref, 64));
+}
+
+static void
+test_tune(void)
+{
+	profile_init();
+	test_tune_profile();
+	test_tune_variants();
+	test_tune_run();
+}
+
+UTEST_MAIN("auto-tuner", test_tune)
+
+#else
+
+#include <stdio.h>
+
+int
+main(void)
+{
+	fprintf(stderr,
+		"warning: the auto-tuner is not supported"
+		" (no 64-bit type)\n");
+	return 0;
+}
+
+#endif
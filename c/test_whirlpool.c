@@ -39,9 +39,12 @@
 TEST_DIGEST_INTERNAL(WHIRLPOOL, whirlpool, 64)
 TEST_DIGEST_INTERNAL(WHIRLPOOL, whirlpool0, 64)
 TEST_DIGEST_INTERNAL(WHIRLPOOL, whirlpool1, 64)
+TEST_DIGEST_MULTI(WHIRLPOOL, whirlpool, 64)
+TEST_DIGEST_MULTI(WHIRLPOOL-0, whirlpool0, 64)
+TEST_DIGEST_MULTI(WHIRLPOOL-1, whirlpool1, 64)
 
 static void
-test_whirlpool(void)
+test_whirlpool_kat(void)
 {
 	test_whirlpool_internal("",
     "19FA61D75522A4669B44E39C1D2E1726C530232130D407F89AFEE0964997F7A7"
@@ -95,6 +98,26 @@ test_whirlpool(void)
     "1B8B83C617080D77CB4247B1E964C2959C507AB2DB0F1F3BF3E3B299CA00CAE3");
 }
 
+static void
+test_whirlpool(void)
+{
+	unsigned w;
+
+	/*
+	 * The AVX2 code (with an AVX-512 variant) is selected at runtime;
+	 * all implementations are checked.
+	 */
+	for (w = 0; w < (sizeof multi_cpu_masks)
+		/ sizeof multi_cpu_masks[0]; w ++) {
+		sph_cpu_set_mask(multi_cpu_masks[w]);
+		test_whirlpool_kat();
+	}
+	sph_cpu_set_mask(~0U);
+	test_whirlpool_multi();
+	test_whirlpool0_multi();
+	test_whirlpool1_multi();
+}
+
 UTEST_MAIN("WHIRLPOOL", test_whirlpool)
 
 #else
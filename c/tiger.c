@@ -657,6 +657,7 @@ sph_tiger_init(void *cc)
 
 #define RFUN   tiger_round
 #define HASH   tiger
+#define STATS  SPH_STATS_TIGER
 #define LE64   1
 #define BLEN   64U
 #define PW01   1
@@ -671,6 +672,16 @@ sph_tiger_close(void *cc, void *dst)
 	sph_tiger_init(cc);
 }
 
+/* see sph_tiger.h */
+void
+sph_tiger_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_tiger_context sc;
+
+	sph_tiger_init(&sc);
+	tiger_oneshot(&sc, data, len, dst, 3);
+}
+
 /* see sph_tiger.h */
 void
 sph_tiger_comp(const sph_u64 msg[8], sph_u64 val[3])
@@ -694,4 +705,14 @@ sph_tiger2_close(void *cc, void *dst)
 	sph_tiger2_init(cc);
 }
 
+/* see sph_tiger.h */
+void
+sph_tiger2_oneshot(const void *data, size_t len, void *dst)
+{
+	sph_tiger2_context sc;
+
+	sph_tiger2_init(&sc);
+	tiger2_oneshot(&sc, data, len, dst, 3);
+}
+
 #endif
@@ -0,0 +1,492 @@
+/* $Id$ */
+/*
+ * Auto-tuning of implementation variants.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#if defined __linux__ && !defined _GNU_SOURCE
+#define _GNU_SOURCE   1
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sph_tune.h"
+
+#if SPH_64
+
+#include "sph_cpu.h"
+#include "sph_echo.h"
+#include "sph_groestl.h"
+#include "sph_hamsi.h"
+#include "sph_jh.h"
+#include "sph_keccak.h"
+#include "sph_pool.h"
+
+#if SPH_THREADS
+#include <pthread.h>
+#endif
+
+#if defined __unix__ || defined __unix \
+	|| (defined __APPLE__ && defined __MACH__)
+#include <unistd.h>
+#define TUNE_HOSTNAME   1
+#else
+#define TUNE_HOSTNAME   0
+#endif
+
+typedef void (*tune_fun)(const void *data, size_t len, void *dst);
+
+/*
+ * A variant: its name, and its one-shot functions for the four output
+ * sizes (224, 256, 384 and 512 bits).
+ */
+typedef struct {
+	const char *name;
+	tune_fun fun[4];
+} tune_variant;
+
+/*
+ * The variant functions have hidden visibility (see variant.h).
+ */
+#if defined __GNUC__ && __GNUC__ >= 4 && !defined _WIN32
+#define TUNE_HIDDEN   __attribute__((visibility("hidden")))
+#else
+#define TUNE_HIDDEN
+#endif
+
+#define TUNE_DECL(fam, v) \
+	TUNE_HIDDEN void sph_ ## fam ## 224_oneshot_ ## v( \
+		const void *data, size_t len, void *dst); \
+	TUNE_HIDDEN void sph_ ## fam ## 256_oneshot_ ## v( \
+		const void *data, size_t len, void *dst); \
+	TUNE_HIDDEN void sph_ ## fam ## 384_oneshot_ ## v( \
+		const void *data, size_t len, void *dst); \
+	TUNE_HIDDEN void sph_ ## fam ## 512_oneshot_ ## v( \
+		const void *data, size_t len, void *dst);
+
+#define TUNE_DEFAULT(fam)   { "default", { \
+		&sph_ ## fam ## 224_oneshot, &sph_ ## fam ## 256_oneshot, \
+		&sph_ ## fam ## 384_oneshot, &sph_ ## fam ## 512_oneshot } }
+
+#define TUNE_VARIANT(fam, v)   { #v, { \
+		&sph_ ## fam ## 224_oneshot_ ## v, \
+		&sph_ ## fam ## 256_oneshot_ ## v, \
+		&sph_ ## fam ## 384_oneshot_ ## v, \
+		&sph_ ## fam ## 512_oneshot_ ## v } }
+
+TUNE_DECL(echo, 32)
+TUNE_DECL(groestl, small)
+TUNE_DECL(groestl, 32)
+TUNE_DECL(groestl, small32)
+TUNE_DECL(hamsi, small)
+TUNE_DECL(jh, 32)
+TUNE_DECL(jh, small)
+TUNE_DECL(keccak, u2)
+TUNE_DECL(keccak, full)
+TUNE_DECL(keccak, copy)
+TUNE_DECL(keccak, 32)
+
+static const tune_variant var_echo[] = {
+	TUNE_DEFAULT(echo),
+	TUNE_VARIANT(echo, 32)
+};
+
+static const tune_variant var_groestl[] = {
+	TUNE_DEFAULT(groestl),
+	TUNE_VARIANT(groestl, small),
+	TUNE_VARIANT(groestl, 32),
+	TUNE_VARIANT(groestl, small32)
+};
+
+static const tune_variant var_hamsi[] = {
+	TUNE_DEFAULT(hamsi),
+	TUNE_VARIANT(hamsi, small)
+};
+
+static const tune_variant var_jh[] = {
+	TUNE_DEFAULT(jh),
+	TUNE_VARIANT(jh, 32),
+	TUNE_VARIANT(jh, small)
+};
+
+static const tune_variant var_keccak[] = {
+	TUNE_DEFAULT(keccak),
+	TUNE_VARIANT(keccak, u2),
+	TUNE_VARIANT(keccak, full),
+	TUNE_VARIANT(keccak, copy),
+	TUNE_VARIANT(keccak, 32)
+};
+
+/*
+ * A tunable family: its name, the identifier of its 224-bit function
+ * (the four sizes have consecutive identifiers), and its variants (the
+ * default code first).
+ */
+typedef struct {
+	const char *name;
+	unsigned alg224;
+	const tune_variant *var;
+	unsigned num;
+} tune_family;
+
+#define TUNE_FAMILY(fam, id)   { #fam, SPH_HASH_ ## id ## 224, var_ ## fam, \
+		(sizeof var_ ## fam) / sizeof var_ ## fam[0] }
+
+static const tune_family tune_families[] = {
+	TUNE_FAMILY(echo, ECHO),
+	TUNE_FAMILY(groestl, GROESTL),
+	TUNE_FAMILY(hamsi, HAMSI),
+	TUNE_FAMILY(jh, JH),
+	TUNE_FAMILY(keccak, KECCAK)
+};
+
+#define TUNE_NUM   ((sizeof tune_families) / sizeof tune_families[0])
+
+/*
+ * Current choice (index in the variants of the family) for each
+ * family, output size and size class.
+ */
+static volatile unsigned char tune_choice[TUNE_NUM][4][SPH_TUNE_CLASSES];
+static volatile int tune_done = 0;
+
+/*
+ * Message length used to measure each size class.
+ */
+static const size_t tune_class_len[SPH_TUNE_CLASSES] = {
+	64, 1024, 16384, 65536
+};
+
+static unsigned
+tune_class(size_t len)
+{
+	if (len <= 64)
+		return 0;
+	if (len <= 1024)
+		return 1;
+	if (len <= 16384)
+		return 2;
+	return 3;
+}
+
+/*
+ * Find the family and output size index of a function; returned value
+ * is 0 if the function has no variants.
+ */
+static int
+tune_lookup(unsigned alg, unsigned *f, unsigned *s)
+{
+	unsigned u;
+
+	for (u = 0; u < TUNE_NUM; u ++) {
+		if (alg >= tune_families[u].alg224
+			&& alg < tune_families[u].alg224 + 4)
+		{
+			*f = u;
+			*s = alg - tune_families[u].alg224;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Current time, in seconds, for the measures. The CPU time of the
+ * calling thread is used where available, so that neither the other
+ * threads of the process nor preemption skew the results; clock()
+ * (process CPU time) is the last resort.
+ */
+#if defined CLOCK_THREAD_CPUTIME_ID
+#define TUNE_CLOCK   CLOCK_THREAD_CPUTIME_ID
+#elif defined CLOCK_MONOTONIC
+#define TUNE_CLOCK   CLOCK_MONOTONIC
+#endif
+
+static double
+tune_time(void)
+{
+#ifdef TUNE_CLOCK
+	struct timespec ts;
+
+	if (clock_gettime(TUNE_CLOCK, &ts) == 0)
+		return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+#endif
+	return (double)clock() / (double)CLOCKS_PER_SEC;
+}
+
+/*
+ * Speed of a function on messages of a given length, in hashes per
+ * second. The number of calls is doubled until the measure lasts at
+ * least 2 ms.
+ */
+static double
+tune_speed(tune_fun fun, const unsigned char *buf, size_t len)
+{
+	unsigned char out[64];
+	unsigned long n, k;
+
+	fun(buf, len, out);
+	for (n = 1;; n <<= 1) {
+		double begin, end;
+
+		begin = tune_time();
+		for (k = 0; k < n; k ++)
+			fun(buf, len, out);
+		end = tune_time();
+		if (end - begin >= 0.002)
+			return (double)n / (end - begin);
+	}
+}
+
+/* see sph_tune.h */
+void
+sph_tune_run(void)
+{
+	unsigned char *buf;
+	unsigned f, s, c;
+
+	buf = malloc(tune_class_len[SPH_TUNE_CLASSES - 1]);
+	if (buf == NULL)
+		return;
+	for (c = 0; c < tune_class_len[SPH_TUNE_CLASSES - 1]; c ++)
+		buf[c] = (unsigned char)(c * 31 + (c >> 8));
+	for (f = 0; f < TUNE_NUM; f ++) {
+		const tune_family *tf;
+
+		tf = &tune_families[f];
+		for (s = 0; s < 4; s ++) {
+			for (c = 0; c < SPH_TUNE_CLASSES; c ++) {
+				double best;
+				unsigned v, bv;
+
+				/*
+				 * The default code must be beaten by more
+				 * than 5% so that measure noise does not
+				 * make the choice flip.
+				 */
+				best = 1.05 * tune_speed(tf->var[0].fun[s],
+					buf, tune_class_len[c]);
+				bv = 0;
+				for (v = 1; v < tf->num; v ++) {
+					double r;
+
+					r = tune_speed(tf->var[v].fun[s],
+						buf, tune_class_len[c]);
+					if (r > best) {
+						best = r;
+						bv = v;
+					}
+				}
+				tune_choice[f][s][c] = (unsigned char)bv;
+			}
+		}
+	}
+	free(buf);
+	tune_done = 1;
+}
+
+/*
+ * Host identification line of the profiles.
+ */
+static void
+tune_host(char *dst, size_t len)
+{
+	char name[128];
+
+	strcpy(name, "unknown");
+#if TUNE_HOSTNAME
+	if (gethostname(name, sizeof name) != 0)
+		strcpy(name, "unknown");
+	name[sizeof name - 1] = 0;
+#endif
+	sprintf(dst, "host %.*s %x", (int)(len - 32), name,
+		sph_cpu_features());
+}
+
+static const unsigned tune_bits[4] = { 224, 256, 384, 512 };
+
+#define TUNE_MAGIC   "sphlib-tune 1"
+
+/* see sph_tune.h */
+int
+sph_tune_save(const char *path)
+{
+	FILE *fp;
+	char host[200];
+	unsigned f, s, c;
+	int ok;
+
+	fp = fopen(path, "w");
+	if (fp == NULL)
+		return 0;
+	tune_host(host, sizeof host);
+	fprintf(fp, "%s\n%s\n", TUNE_MAGIC, host);
+	for (f = 0; f < TUNE_NUM; f ++) {
+		const tune_family *tf;
+
+		tf = &tune_families[f];
+		for (s = 0; s < 4; s ++)
+			for (c = 0; c < SPH_TUNE_CLASSES; c ++)
+				fprintf(fp, "%s%u %u %s\n", tf->name,
+					tune_bits[s], c,
+					tf->var[tune_choice[f][s][c]].name);
+	}
+	ok = !ferror(fp);
+	if (fclose(fp) != 0)
+		ok = 0;
+	return ok;
+}
+
+/*
+ * Trim the end-of-line characters of a line read with fgets().
+ */
+static void
+tune_chomp(char *line)
+{
+	size_t n;
+
+	n = strlen(line);
+	while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r'))
+		line[-- n] = 0;
+}
+
+/* see sph_tune.h */
+int
+sph_tune_load(const char *path)
+{
+	unsigned char choice[TUNE_NUM][4][SPH_TUNE_CLASSES];
+	FILE *fp;
+	char line[256], host[200];
+	unsigned f, s, c;
+
+	fp = fopen(path, "r");
+	if (fp == NULL)
+		return 0;
+	tune_host(host, sizeof host);
+	if (fgets(line, sizeof line, fp) == NULL
+		|| (tune_chomp(line), strcmp(line, TUNE_MAGIC) != 0)
+		|| fgets(line, sizeof line, fp) == NULL
+		|| (tune_chomp(line), strcmp(line, host) != 0))
+	{
+		fclose(fp);
+		return 0;
+	}
+	memset(choice, 0, sizeof choice);
+	while (fgets(line, sizeof line, fp) != NULL) {
+		char name[32], var[32];
+		unsigned bits, v;
+
+		if (sscanf(line, "%31s %u %31s", name, &c, var) != 3
+			|| c >= SPH_TUNE_CLASSES)
+			continue;
+		for (f = 0; f < TUNE_NUM; f ++) {
+			size_t n;
+
+			n = strlen(tune_families[f].name);
+			if (strncmp(name, tune_families[f].name, n) == 0
+				&& sscanf(name + n, "%u", &bits) == 1)
+				break;
+		}
+		if (f == TUNE_NUM)
+			continue;
+		for (s = 0; s < 4; s ++)
+			if (tune_bits[s] == bits)
+				break;
+		if (s == 4)
+			continue;
+		for (v = 0; v < tune_families[f].num; v ++)
+			if (strcmp(var, tune_families[f].var[v].name) == 0)
+				choice[f][s][c] = (unsigned char)v;
+	}
+	fclose(fp);
+	for (f = 0; f < TUNE_NUM; f ++)
+		for (s = 0; s < 4; s ++)
+			for (c = 0; c < SPH_TUNE_CLASSES; c ++)
+				tune_choice[f][s][c] = choice[f][s][c];
+	tune_done = 1;
+	return 1;
+}
+
+/*
+ * First use: load the profile named by SPH_TUNE_PROFILE, or tune (and
+ * save the result there).
+ */
+static void
+tune_auto(void)
+{
+	const char *path;
+
+	if (tune_done)
+		return;
+	path = getenv("SPH_TUNE_PROFILE");
+	if (path != NULL && *path != 0 && sph_tune_load(path))
+		return;
+	sph_tune_run();
+	if (path != NULL && *path != 0)
+		sph_tune_save(path);
+}
+
+#if SPH_THREADS
+static pthread_once_t tune_once = PTHREAD_ONCE_INIT;
+#endif
+
+/* see sph_tune.h */
+void
+sph_tune_hash(unsigned alg, const void *data, size_t len, void *dst)
+{
+	unsigned f, s;
+
+	if (!tune_lookup(alg, &f, &s)) {
+		sph_hash_batch(alg, &data, &len, &dst, 1);
+		return;
+	}
+	if (!tune_done) {
+#if SPH_THREADS
+		pthread_once(&tune_once, &tune_auto);
+#else
+		tune_auto();
+#endif
+	}
+	tune_families[f].var[tune_choice[f][s][tune_class(len)]].fun[s](
+		data, len, dst);
+}
+
+/* see sph_tune.h */
+const char *
+sph_tune_variant(unsigned alg, size_t len)
+{
+	unsigned f, s;
+
+	if (!tune_lookup(alg, &f, &s))
+		return NULL;
+	return tune_families[f].var[tune_choice[f][s][tune_class(len)]].name;
+}
+
+#endif
@@ -0,0 +1,137 @@
+/* $Id$ */
+/*
+ * Multi-lane vector macros for the VAES code of the AES-based hash
+ * functions (ECHO, SHAvite-3, Groestl). This file is meant to be
+ * included by their implementations. A "lane" is one 128-bit word of
+ * a 256-bit (VX2_*, AVX2 + VAES) or 512-bit (VX4_*, AVX-512 + VAES)
+ * register, and each lane belongs to a distinct message; all the
+ * operations used by the engines act on each lane independently
+ * (byte shuffles and alignments are within 128-bit lanes, and AES
+ * rounds are applied to each lane with its own round key).
+ *
+ * The engines are written once, as macros which take the prefix
+ * (VX2 or VX4) as parameter, and pasted names select the operations.
+ *
+ *   _T              vector type
+ *   _LANES          number of lanes
+ *   _TARGET         target attribute string
+ *   _LOAD(p, off)   lane i from p[i] + off (16 bytes, unaligned)
+ *   _STORE(p, off, x)   lane i to p[i] + off
+ *   _BCAST(x)       copy of a __m128i in all lanes
+ *   _XTIME(x)       multiplication by 2 in GF(2^8), on each byte
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_cpu.h"
+
+#if SPH_X86_SIMD
+
+#include <immintrin.h>
+
+/*
+ * Maximum number of lanes, for the buffers of the callers.
+ */
+#define VX_MAX_LANES   4
+
+#define VX2_T             __m256i
+#define VX2_LANES         2
+#define VX2_TARGET        "avx2,aes,vaes"
+#define VX2_LOAD(p, off)   _mm256_inserti128_si256(_mm256_castsi128_si256( \
+		_mm_loadu_si128((const __m128i *)((p)[0] + (off)))), \
+		_mm_loadu_si128((const __m128i *)((p)[1] + (off))), 1)
+#define VX2_STORE(p, off, x)   do { \
+		_mm_storeu_si128((__m128i *)((p)[0] + (off)), \
+			_mm256_castsi256_si128(x)); \
+		_mm_storeu_si128((__m128i *)((p)[1] + (off)), \
+			_mm256_extracti128_si256(x, 1)); \
+	} while (0)
+#define VX2_BCAST         _mm256_broadcastsi128_si256
+#define VX2_ZERO          _mm256_setzero_si256()
+#define VX2_ONES          _mm256_set1_epi32(-1)
+#define VX2_SET1_8(x)     _mm256_set1_epi8((char)(x))
+#define VX2_XOR           _mm256_xor_si256
+#define VX2_ADD64         _mm256_add_epi64
+#define VX2_SHUF8         _mm256_shuffle_epi8
+#define VX2_SHUF32        _mm256_shuffle_epi32
+#define VX2_ALIGNR        _mm256_alignr_epi8
+#define VX2_UNPACKLO16    _mm256_unpacklo_epi16
+#define VX2_UNPACKHI16    _mm256_unpackhi_epi16
+#define VX2_UNPACKLO32    _mm256_unpacklo_epi32
+#define VX2_UNPACKHI32    _mm256_unpackhi_epi32
+#define VX2_UNPACKLO64    _mm256_unpacklo_epi64
+#define VX2_UNPACKHI64    _mm256_unpackhi_epi64
+#define VX2_AESENC        _mm256_aesenc_epi128
+#define VX2_AESENCLAST    _mm256_aesenclast_epi128
+#define VX2_XTIME(x)      _mm256_xor_si256(_mm256_add_epi8(x, x), \
+		_mm256_and_si256(_mm256_cmpgt_epi8(_mm256_setzero_si256(), x), \
+		_mm256_set1_epi8(0x1B)))
+
+#if SPH_X86_AVX512
+
+#define VX4_T             __m512i
+#define VX4_LANES         4
+#define VX4_TARGET        "avx2,aes,vaes,avx512f,avx512bw,avx512vl"
+#define VX4_LOAD(p, off)   _mm512_inserti32x4(_mm512_inserti32x4( \
+		_mm512_inserti32x4(_mm512_castsi128_si512( \
+		_mm_loadu_si128((const __m128i *)((p)[0] + (off)))), \
+		_mm_loadu_si128((const __m128i *)((p)[1] + (off))), 1), \
+		_mm_loadu_si128((const __m128i *)((p)[2] + (off))), 2), \
+		_mm_loadu_si128((const __m128i *)((p)[3] + (off))), 3)
+#define VX4_STORE(p, off, x)   do { \
+		_mm_storeu_si128((__m128i *)((p)[0] + (off)), \
+			_mm512_castsi512_si128(x)); \
+		_mm_storeu_si128((__m128i *)((p)[1] + (off)), \
+			_mm512_extracti32x4_epi32(x, 1)); \
+		_mm_storeu_si128((__m128i *)((p)[2] + (off)), \
+			_mm512_extracti32x4_epi32(x, 2)); \
+		_mm_storeu_si128((__m128i *)((p)[3] + (off)), \
+			_mm512_extracti32x4_epi32(x, 3)); \
+	} while (0)
+#define VX4_BCAST         _mm512_broadcast_i32x4
+#define VX4_ZERO          _mm512_setzero_si512()
+#define VX4_ONES          _mm512_set1_epi32(-1)
+#define VX4_SET1_8(x)     _mm512_set1_epi8((char)(x))
+#define VX4_XOR           _mm512_xor_si512
+#define VX4_ADD64         _mm512_add_epi64
+#define VX4_SHUF8         _mm512_shuffle_epi8
+#define VX4_SHUF32(x, n)  _mm512_shuffle_epi32(x, (_MM_PERM_ENUM)(n))
+#define VX4_ALIGNR        _mm512_alignr_epi8
+#define VX4_UNPACKLO16    _mm512_unpacklo_epi16
+#define VX4_UNPACKHI16    _mm512_unpackhi_epi16
+#define VX4_UNPACKLO32    _mm512_unpacklo_epi32
+#define VX4_UNPACKHI32    _mm512_unpackhi_epi32
+#define VX4_UNPACKLO64    _mm512_unpacklo_epi64
+#define VX4_UNPACKHI64    _mm512_unpackhi_epi64
+#define VX4_AESENC        _mm512_aesenc_epi128
+#define VX4_AESENCLAST    _mm512_aesenclast_epi128
+#define VX4_XTIME(x)      _mm512_xor_si512(_mm512_add_epi8(x, x), \
+		_mm512_maskz_mov_epi8(_mm512_movepi8_mask(x), \
+		_mm512_set1_epi8(0x1B)))
+
+#endif
+
+#endif
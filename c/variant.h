@@ -0,0 +1,228 @@
+/* $Id$ */
+/*
+ * Renaming of the public functions of a hash function family, so that
+ * variants of its implementation (compiled with different build macros)
+ * may be linked side by side in the library; see sph_tune.h.
+ *
+ * A variant source file defines the build macros of the variant,
+ * SPH_VARIANT (the suffix) and SPH_VARIANT_<FAMILY>, includes this file,
+ * then the source file of the family: function "sph_jh256_oneshot", for
+ * instance, then becomes "sph_jh256_oneshot_small".
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#ifndef SPH_VARIANT
+#error SPH_VARIANT must be defined
+#endif
+
+/*
+ * A variant is the portable code selected by its build macros. The
+ * vector kernels, which the default code picks at runtime (ECHO with
+ * AES-NI, Hamsi with SSE2 to AVX-512...), ignore these macros. If they
+ * were left in, some variants would run the same code as the default
+ * code.
+ */
+#undef SPH_NO_SIMD
+#define SPH_NO_SIMD   1
+
+#define SPH_VNAME(name)        SPH_VNAME_(name, SPH_VARIANT)
+#define SPH_VNAME_(name, v)    SPH_VNAME__(name, v)
+#define SPH_VNAME__(name, v)   name ## _ ## v
+
+#if SPH_VARIANT_ECHO
+#define sph_echo224                        SPH_VNAME(sph_echo224)
+#define sph_echo224_init                   SPH_VNAME(sph_echo224_init)
+#define sph_echo224_close                  SPH_VNAME(sph_echo224_close)
+#define sph_echo224_addbits_and_close      SPH_VNAME(sph_echo224_addbits_and_close)
+#define sph_echo224_updatev                SPH_VNAME(sph_echo224_updatev)
+#define sph_echo224_oneshot                SPH_VNAME(sph_echo224_oneshot)
+#define sph_echo224_multi                  SPH_VNAME(sph_echo224_multi)
+#define sph_echo256                        SPH_VNAME(sph_echo256)
+#define sph_echo256_init                   SPH_VNAME(sph_echo256_init)
+#define sph_echo256_close                  SPH_VNAME(sph_echo256_close)
+#define sph_echo256_addbits_and_close      SPH_VNAME(sph_echo256_addbits_and_close)
+#define sph_echo256_updatev                SPH_VNAME(sph_echo256_updatev)
+#define sph_echo256_oneshot                SPH_VNAME(sph_echo256_oneshot)
+#define sph_echo256_multi                  SPH_VNAME(sph_echo256_multi)
+#define sph_echo384                        SPH_VNAME(sph_echo384)
+#define sph_echo384_init                   SPH_VNAME(sph_echo384_init)
+#define sph_echo384_close                  SPH_VNAME(sph_echo384_close)
+#define sph_echo384_addbits_and_close      SPH_VNAME(sph_echo384_addbits_and_close)
+#define sph_echo384_updatev                SPH_VNAME(sph_echo384_updatev)
+#define sph_echo384_oneshot                SPH_VNAME(sph_echo384_oneshot)
+#define sph_echo384_multi                  SPH_VNAME(sph_echo384_multi)
+#define sph_echo512                        SPH_VNAME(sph_echo512)
+#define sph_echo512_init                   SPH_VNAME(sph_echo512_init)
+#define sph_echo512_close                  SPH_VNAME(sph_echo512_close)
+#define sph_echo512_addbits_and_close      SPH_VNAME(sph_echo512_addbits_and_close)
+#define sph_echo512_updatev                SPH_VNAME(sph_echo512_updatev)
+#define sph_echo512_oneshot                SPH_VNAME(sph_echo512_oneshot)
+#define sph_echo512_multi                  SPH_VNAME(sph_echo512_multi)
+#endif
+
+#if SPH_VARIANT_GROESTL
+#define sph_groestl224                     SPH_VNAME(sph_groestl224)
+#define sph_groestl224_init                SPH_VNAME(sph_groestl224_init)
+#define sph_groestl224_close               SPH_VNAME(sph_groestl224_close)
+#define sph_groestl224_addbits_and_close   SPH_VNAME(sph_groestl224_addbits_and_close)
+#define sph_groestl224_updatev             SPH_VNAME(sph_groestl224_updatev)
+#define sph_groestl224_oneshot             SPH_VNAME(sph_groestl224_oneshot)
+#define sph_groestl224_multi               SPH_VNAME(sph_groestl224_multi)
+#define sph_groestl256                     SPH_VNAME(sph_groestl256)
+#define sph_groestl256_init                SPH_VNAME(sph_groestl256_init)
+#define sph_groestl256_close               SPH_VNAME(sph_groestl256_close)
+#define sph_groestl256_addbits_and_close   SPH_VNAME(sph_groestl256_addbits_and_close)
+#define sph_groestl256_updatev             SPH_VNAME(sph_groestl256_updatev)
+#define sph_groestl256_oneshot             SPH_VNAME(sph_groestl256_oneshot)
+#define sph_groestl256_multi               SPH_VNAME(sph_groestl256_multi)
+#define sph_groestl384                     SPH_VNAME(sph_groestl384)
+#define sph_groestl384_init                SPH_VNAME(sph_groestl384_init)
+#define sph_groestl384_close               SPH_VNAME(sph_groestl384_close)
+#define sph_groestl384_addbits_and_close   SPH_VNAME(sph_groestl384_addbits_and_close)
+#define sph_groestl384_updatev             SPH_VNAME(sph_groestl384_updatev)
+#define sph_groestl384_oneshot             SPH_VNAME(sph_groestl384_oneshot)
+#define sph_groestl384_multi               SPH_VNAME(sph_groestl384_multi)
+#define sph_groestl512                     SPH_VNAME(sph_groestl512)
+#define sph_groestl512_init                SPH_VNAME(sph_groestl512_init)
+#define sph_groestl512_close               SPH_VNAME(sph_groestl512_close)
+#define sph_groestl512_addbits_and_close   SPH_VNAME(sph_groestl512_addbits_and_close)
+#define sph_groestl512_updatev             SPH_VNAME(sph_groestl512_updatev)
+#define sph_groestl512_oneshot             SPH_VNAME(sph_groestl512_oneshot)
+#define sph_groestl512_multi               SPH_VNAME(sph_groestl512_multi)
+#endif
+
+#if SPH_VARIANT_HAMSI
+#define sph_hamsi224                       SPH_VNAME(sph_hamsi224)
+#define sph_hamsi224_init                  SPH_VNAME(sph_hamsi224_init)
+#define sph_hamsi224_close                 SPH_VNAME(sph_hamsi224_close)
+#define sph_hamsi224_addbits_and_close     SPH_VNAME(sph_hamsi224_addbits_and_close)
+#define sph_hamsi224_updatev               SPH_VNAME(sph_hamsi224_updatev)
+#define sph_hamsi224_oneshot               SPH_VNAME(sph_hamsi224_oneshot)
+#define sph_hamsi224_multi                 SPH_VNAME(sph_hamsi224_multi)
+#define sph_hamsi256                       SPH_VNAME(sph_hamsi256)
+#define sph_hamsi256_init                  SPH_VNAME(sph_hamsi256_init)
+#define sph_hamsi256_close                 SPH_VNAME(sph_hamsi256_close)
+#define sph_hamsi256_addbits_and_close     SPH_VNAME(sph_hamsi256_addbits_and_close)
+#define sph_hamsi256_updatev               SPH_VNAME(sph_hamsi256_updatev)
+#define sph_hamsi256_oneshot               SPH_VNAME(sph_hamsi256_oneshot)
+#define sph_hamsi256_multi                 SPH_VNAME(sph_hamsi256_multi)
+#define sph_hamsi384                       SPH_VNAME(sph_hamsi384)
+#define sph_hamsi384_init                  SPH_VNAME(sph_hamsi384_init)
+#define sph_hamsi384_close                 SPH_VNAME(sph_hamsi384_close)
+#define sph_hamsi384_addbits_and_close     SPH_VNAME(sph_hamsi384_addbits_and_close)
+#define sph_hamsi384_updatev               SPH_VNAME(sph_hamsi384_updatev)
+#define sph_hamsi384_oneshot               SPH_VNAME(sph_hamsi384_oneshot)
+#define sph_hamsi384_multi                 SPH_VNAME(sph_hamsi384_multi)
+#define sph_hamsi512                       SPH_VNAME(sph_hamsi512)
+#define sph_hamsi512_init                  SPH_VNAME(sph_hamsi512_init)
+#define sph_hamsi512_close                 SPH_VNAME(sph_hamsi512_close)
+#define sph_hamsi512_addbits_and_close     SPH_VNAME(sph_hamsi512_addbits_and_close)
+#define sph_hamsi512_updatev               SPH_VNAME(sph_hamsi512_updatev)
+#define sph_hamsi512_oneshot               SPH_VNAME(sph_hamsi512_oneshot)
+#define sph_hamsi512_multi                 SPH_VNAME(sph_hamsi512_multi)
+#endif
+
+#if SPH_VARIANT_JH
+#define sph_jh224                          SPH_VNAME(sph_jh224)
+#define sph_jh224_init                     SPH_VNAME(sph_jh224_init)
+#define sph_jh224_close                    SPH_VNAME(sph_jh224_close)
+#define sph_jh224_addbits_and_close        SPH_VNAME(sph_jh224_addbits_and_close)
+#define sph_jh224_updatev                  SPH_VNAME(sph_jh224_updatev)
+#define sph_jh224_oneshot                  SPH_VNAME(sph_jh224_oneshot)
+#define sph_jh224_multi                    SPH_VNAME(sph_jh224_multi)
+#define sph_jh256                          SPH_VNAME(sph_jh256)
+#define sph_jh256_init                     SPH_VNAME(sph_jh256_init)
+#define sph_jh256_close                    SPH_VNAME(sph_jh256_close)
+#define sph_jh256_addbits_and_close        SPH_VNAME(sph_jh256_addbits_and_close)
+#define sph_jh256_updatev                  SPH_VNAME(sph_jh256_updatev)
+#define sph_jh256_oneshot                  SPH_VNAME(sph_jh256_oneshot)
+#define sph_jh256_multi                    SPH_VNAME(sph_jh256_multi)
+#define sph_jh384                          SPH_VNAME(sph_jh384)
+#define sph_jh384_init                     SPH_VNAME(sph_jh384_init)
+#define sph_jh384_close                    SPH_VNAME(sph_jh384_close)
+#define sph_jh384_addbits_and_close        SPH_VNAME(sph_jh384_addbits_and_close)
+#define sph_jh384_updatev                  SPH_VNAME(sph_jh384_updatev)
+#define sph_jh384_oneshot                  SPH_VNAME(sph_jh384_oneshot)
+#define sph_jh384_multi                    SPH_VNAME(sph_jh384_multi)
+#define sph_jh512                          SPH_VNAME(sph_jh512)
+#define sph_jh512_init                     SPH_VNAME(sph_jh512_init)
+#define sph_jh512_close                    SPH_VNAME(sph_jh512_close)
+#define sph_jh512_addbits_and_close        SPH_VNAME(sph_jh512_addbits_and_close)
+#define sph_jh512_updatev                  SPH_VNAME(sph_jh512_updatev)
+#define sph_jh512_oneshot                  SPH_VNAME(sph_jh512_oneshot)
+#define sph_jh512_multi                    SPH_VNAME(sph_jh512_multi)
+#endif
+
+#if SPH_VARIANT_KECCAK
+#define sph_keccak224                      SPH_VNAME(sph_keccak224)
+#define sph_keccak224_init                 SPH_VNAME(sph_keccak224_init)
+#define sph_keccak224_close                SPH_VNAME(sph_keccak224_close)
+#define sph_keccak224_addbits_and_close    SPH_VNAME(sph_keccak224_addbits_and_close)
+#define sph_keccak224_updatev              SPH_VNAME(sph_keccak224_updatev)
+#define sph_keccak224_oneshot              SPH_VNAME(sph_keccak224_oneshot)
+#define sph_keccak224_multi                SPH_VNAME(sph_keccak224_multi)
+#define sph_keccak256                      SPH_VNAME(sph_keccak256)
+#define sph_keccak256_init                 SPH_VNAME(sph_keccak256_init)
+#define sph_keccak256_close                SPH_VNAME(sph_keccak256_close)
+#define sph_keccak256_addbits_and_close    SPH_VNAME(sph_keccak256_addbits_and_close)
+#define sph_keccak256_updatev              SPH_VNAME(sph_keccak256_updatev)
+#define sph_keccak256_oneshot              SPH_VNAME(sph_keccak256_oneshot)
+#define sph_keccak256_multi                SPH_VNAME(sph_keccak256_multi)
+#define sph_keccak384                      SPH_VNAME(sph_keccak384)
+#define sph_keccak384_init                 SPH_VNAME(sph_keccak384_init)
+#define sph_keccak384_close                SPH_VNAME(sph_keccak384_close)
+#define sph_keccak384_addbits_and_close    SPH_VNAME(sph_keccak384_addbits_and_close)
+#define sph_keccak384_updatev              SPH_VNAME(sph_keccak384_updatev)
+#define sph_keccak384_oneshot              SPH_VNAME(sph_keccak384_oneshot)
+#define sph_keccak384_multi                SPH_VNAME(sph_keccak384_multi)
+#define sph_keccak512                      SPH_VNAME(sph_keccak512)
+#define sph_keccak512_init                 SPH_VNAME(sph_keccak512_init)
+#define sph_keccak512_close                SPH_VNAME(sph_keccak512_close)
+#define sph_keccak512_addbits_and_close    SPH_VNAME(sph_keccak512_addbits_and_close)
+#define sph_keccak512_updatev              SPH_VNAME(sph_keccak512_updatev)
+#define sph_keccak512_oneshot              SPH_VNAME(sph_keccak512_oneshot)
+#define sph_keccak512_multi                SPH_VNAME(sph_keccak512_multi)
+#endif
+
+/*
+ * The variants are only reached through the tuner table (tune.c), so
+ * their symbols are kept out of the interface of a shared library. The
+ * standard headers and the library headers which declare functions
+ * defined elsewhere (processor features, statistics) are included
+ * first, so that these declarations keep the default visibility; the
+ * pragma then applies up to the end of the translation unit.
+ */
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+#include "sph_types.h"
+#include "sph_cpu.h"
+#include "sph_stats.h"
+
+#if defined __GNUC__ && __GNUC__ >= 4 && !defined _WIN32
+#pragma GCC visibility push(hidden)
+#endif